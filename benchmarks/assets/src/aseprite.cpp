@@ -0,0 +1,154 @@
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/assets/aseprite.hpp>
+#include <voxlet/compression/deflate.hpp>
+
+
+namespace {
+	constexpr std::uint16_t SIDE {128u};
+	constexpr std::uint16_t FRAME_COUNT {500u};
+
+	auto append16(std::vector<std::byte>& bytes, const std::uint32_t value) -> void {
+		bytes.push_back(static_cast<std::byte> (value));
+		bytes.push_back(static_cast<std::byte> (value >> 8u));
+	}
+
+	auto append32(std::vector<std::byte>& bytes, const std::uint32_t value) -> void {
+		append16(bytes, value);
+		append16(bytes, value >> 16u);
+	}
+
+	auto appendChunk(std::vector<std::byte>& frame, const std::uint16_t type, const std::vector<std::byte>& data) -> void {
+		append32(frame, static_cast<std::uint32_t> (data.size() + 6uz));
+		append16(frame, type);
+		frame.insert(frame.end(), data.begin(), data.end());
+	}
+
+	struct Layer {
+		const char* name;
+		vx::assets::AsepriteBlendMode blendMode;
+		std::uint8_t opacity;
+	};
+
+	/*
+	 * An opaque backdrop, a character of flat colors inside transparent pixels, a translucent multiplied
+	 * shadow and a few scattered highlights, each moving a little every frame so that no two frames match.
+	 */
+	constexpr Layer LAYERS[] {
+		{"backdrop", vx::assets::AsepriteBlendMode::normal, 255u},
+		{"body", vx::assets::AsepriteBlendMode::normal, 255u},
+		{"shadow", vx::assets::AsepriteBlendMode::multiply, 160u},
+		{"highlights", vx::assets::AsepriteBlendMode::screen, 255u}
+	};
+
+	auto makeCelPixels(const std::size_t layer, const std::uint32_t frame, std::mt19937& random) -> std::vector<std::byte> {
+		std::vector<std::byte> pixels {};
+		for (std::uint32_t y {0u}; y < SIDE; ++y) {
+			for (std::uint32_t x {0u}; x < SIDE; ++x) {
+				const std::uint32_t dx {x > SIDE / 2u ? x - SIDE / 2u : SIDE / 2u - x};
+				const std::uint32_t dy {y > SIDE / 2u ? y - SIDE / 2u : SIDE / 2u - y};
+				std::uint32_t pixel {0u};
+				if (layer == 0uz)
+					pixel = 0xff20'4060u + ((y + frame) / 16u % 2u) * 0x0010'1010u;
+				else if (layer == 1uz && dx + dy < 40u + frame % 8u)
+					pixel = dx < 6u ? 0xff10'1010u : 0xff30'80e0u;
+				else if (layer == 2uz && dy * 3u < 40u && dx < 48u)
+					pixel = 0x8000'0000u | ((dx + frame) % 64u);
+				else if (layer == 3uz && random() % 16u == 0u)
+					pixel = 0xffc0'e0ffu;
+				append32(pixels, pixel);
+			}
+		}
+		return pixels;
+	}
+
+	auto makeFile(const bool isCompressed) -> std::vector<std::byte> {
+		std::vector<std::byte> file {};
+		append32(file, 0u);
+		append16(file, 0xa5e0u);
+		append16(file, FRAME_COUNT);
+		append16(file, SIDE);
+		append16(file, SIDE);
+		append16(file, 32u);
+		append32(file, 1u);
+		file.resize(128uz, std::byte{0});
+
+		std::mt19937 random {3u};
+		for (std::uint32_t frame {0u}; frame < FRAME_COUNT; ++frame) {
+			std::vector<std::byte> chunks {};
+			std::uint32_t chunkCount {0u};
+			for (std::size_t layer {0uz}; frame == 0u && layer < std::size(LAYERS); ++layer, ++chunkCount) {
+				std::vector<std::byte> data {};
+				append16(data, 3u);
+				append16(data, 0u);
+				append16(data, 0u);
+				append32(data, 0u);
+				append16(data, static_cast<std::uint32_t> (LAYERS[layer].blendMode));
+				data.push_back(static_cast<std::byte> (LAYERS[layer].opacity));
+				data.insert(data.end(), 3uz, std::byte{0});
+				const std::string name {LAYERS[layer].name};
+				append16(data, static_cast<std::uint32_t> (name.size()));
+				for (const char character : name)
+					data.push_back(static_cast<std::byte> (character));
+				appendChunk(chunks, 0x2004u, data);
+			}
+			for (std::size_t layer {0uz}; layer < std::size(LAYERS); ++layer, ++chunkCount) {
+				std::vector<std::byte> data {};
+				append16(data, static_cast<std::uint32_t> (layer));
+				append32(data, 0u);
+				data.push_back(std::byte{255});
+				append16(data, isCompressed ? 2u : 0u);
+				append16(data, 0u);
+				data.insert(data.end(), 5uz, std::byte{0});
+				append16(data, SIDE);
+				append16(data, SIDE);
+				std::vector<std::byte> pixels {makeCelPixels(layer, frame, random)};
+				if (isCompressed)
+					pixels = vx::compression::deflate(pixels, vx::compression::DeflateFormat::zlib);
+				data.insert(data.end(), pixels.begin(), pixels.end());
+				appendChunk(chunks, 0x2005u, data);
+			}
+			append32(file, static_cast<std::uint32_t> (chunks.size() + 16uz));
+			append16(file, 0xf1fau);
+			append16(file, chunkCount);
+			append16(file, 100u);
+			append16(file, 0u);
+			append32(file, chunkCount);
+			file.insert(file.end(), chunks.begin(), chunks.end());
+		}
+		return file;
+	}
+}
+
+
+TEST_CASE("aseprite - benchmark", "[assets]") {
+	const bool isCompressed {GENERATE(false, true)};
+	const char* const cels {isCompressed ? "compressed" : "raw"};
+	const std::vector<std::byte> file {makeFile(isCompressed)};
+	const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(file)};
+	REQUIRE(aseprite);
+	REQUIRE(aseprite->getFrames().size() == FRAME_COUNT);
+
+	std::println(
+		stderr,
+		"Benchmarking {} frames of {}x{} with {} layers, {} MB of {} cels, {} million layer pixels composited",
+		FRAME_COUNT,
+		SIDE,
+		SIDE,
+		std::size(LAYERS),
+		file.size() / (1024uz * 1024uz),
+		cels,
+		static_cast<std::size_t> (FRAME_COUNT) * SIDE * SIDE * std::size(LAYERS) / 1'000'000uz
+	);
+
+	BENCHMARK(std::format("[aseprite] load - cels={}", cels)) {
+		return vx::assets::Aseprite::fromBytes(file)->getImageCount();
+	};
+}
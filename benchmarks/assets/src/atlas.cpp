@@ -0,0 +1,132 @@
+#include <print>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/assets/atlas.hpp>
+#include <voxlet/assets/atlasBuilder.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	using vx::testing::toSlice;
+
+	/* sprites of 8 to 64 pixels with a transparent border, like exported animation frames */
+	auto makeSprites(const std::size_t count) noexcept -> std::vector<vx::render::Image> {
+		std::mt19937 random {42u};
+		std::uniform_int_distribution<std::uint32_t> side {8u, 64u};
+		std::vector<vx::render::Image> sprites {};
+		for (std::size_t i {0uz}; i < count; ++i) {
+			const std::uint32_t width {side(random)};
+			const std::uint32_t height {side(random)};
+			vx::render::Image image {width + 4u, height + 4u, 0u};
+			for (std::uint32_t y {0u}; y < height; ++y) {
+				for (std::uint32_t x {0u}; x < width; ++x)
+					image.getRow(y + 2u)[x + 2u] = static_cast<std::uint32_t> (random()) | 0xff00'0000u;
+			}
+			sprites.push_back(std::move(image));
+		}
+		return sprites;
+	}
+}
+
+
+TEST_CASE("atlas-build - benchmark", "[assets]") {
+	const std::size_t spriteCount {GENERATE(100uz, 1000uz)};
+
+	std::println(stderr, "Benchmarking an atlas of {} sprites", spriteCount);
+
+	std::vector<std::string> names {};
+	for (std::size_t i {0uz}; i < spriteCount; ++i)
+		names.push_back("characters/frame_" + std::to_string(i));
+	const std::vector<vx::render::Image> sprites {makeSprites(spriteCount)};
+	vx::assets::AtlasBuilder builder {};
+	for (std::size_t i {0uz}; i < spriteCount; ++i)
+		(void)builder.set(toSlice(names[i]), sprites[i]);
+	const std::vector<std::byte> bytes {builder.write()};
+
+	BENCHMARK(std::format("[build] full pack - count={}", spriteCount)) {
+		vx::assets::AtlasBuilder atlas {};
+		for (std::size_t i {0uz}; i < spriteCount; ++i)
+			(void)atlas.set(toSlice(names[i]), sprites[i]);
+		return atlas.write().size();
+	};
+
+	/* one sprite changed, as when an artist saves a single frame */
+	std::size_t edited {0uz};
+	BENCHMARK(std::format("[build] incremental single sprite - count={}", spriteCount)) {
+		const std::optional<vx::assets::Atlas> previous {vx::assets::Atlas::fromBytes(bytes)};
+		std::optional<vx::assets::AtlasBuilder> atlas {vx::assets::AtlasBuilder::restore(*previous, {})};
+		edited = (edited + 1uz) % spriteCount;
+		(void)atlas->set(toSlice(names[edited]), sprites[(edited + 1uz) % spriteCount]);
+		return atlas->write().size();
+	};
+
+	BENCHMARK(std::format("[build] in memory single sprite - count={}", spriteCount)) {
+		edited = (edited + 1uz) % spriteCount;
+		(void)builder.set(toSlice(names[edited]), sprites[(edited * 7uz) % spriteCount]);
+		return builder.isPageDirty(0u);
+	};
+}
+
+
+TEST_CASE("atlas-lookup - benchmark", "[assets]") {
+	const std::size_t spriteCount {GENERATE(100uz, 10'000uz)};
+
+	std::println(stderr, "Benchmarking lookups in an atlas of {} sprites", spriteCount);
+
+	std::vector<std::string> names {};
+	for (std::size_t i {0uz}; i < spriteCount; ++i)
+		names.push_back("characters/frame_" + std::to_string(i));
+	vx::assets::AtlasBuilder builder {};
+	const vx::render::Image sprite {4u, 4u, 0xffff'ffffu};
+	for (const std::string& name : names)
+		(void)builder.set(toSlice(name), sprite);
+	const std::vector<std::byte> bytes {builder.write()};
+
+	/* what loading a parsed index would build */
+	BENCHMARK(std::format("[load] unordered_map - count={}", spriteCount)) {
+		const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+		std::unordered_map<std::string, vx::assets::AtlasEntry> index {};
+		index.reserve(atlas->getEntries().size());
+		for (const vx::assets::AtlasEntry& entry : atlas->getEntries()) {
+			const vx::StringSlice name {atlas->getName(entry)};
+			index.emplace(std::string{reinterpret_cast<const char*> (std::to_address(name.begin())), name.getSize()}, entry);
+		}
+		return index.size();
+	};
+
+	BENCHMARK(std::format("[load] in place - count={}", spriteCount)) {
+		return vx::assets::Atlas::fromBytes(bytes)->getEntries().size();
+	};
+
+	const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+	std::unordered_map<std::string, vx::assets::AtlasEntry> index {};
+	for (const vx::assets::AtlasEntry& entry : atlas->getEntries()) {
+		const vx::StringSlice name {atlas->getName(entry)};
+		index.emplace(std::string{reinterpret_cast<const char*> (std::to_address(name.begin())), name.getSize()}, entry);
+	}
+	std::mt19937 random {7u};
+	std::vector<std::size_t> queries (4096uz);
+	for (std::size_t& query : queries)
+		query = random() % spriteCount;
+
+	BENCHMARK(std::format("[find] unordered_map - count={}", spriteCount)) {
+		std::uint32_t sum {0u};
+		for (const std::size_t query : queries)
+			sum += index.find(names[query])->second.x;
+		return sum;
+	};
+
+	BENCHMARK(std::format("[find] atlas - count={}", spriteCount)) {
+		std::uint32_t sum {0u};
+		for (const std::size_t query : queries)
+			sum += atlas->find(toSlice(names[query]))->x;
+		return sum;
+	};
+}
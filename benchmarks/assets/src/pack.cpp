@@ -0,0 +1,77 @@
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/assets/pack.hpp>
+#include <voxlet/assets/packBuilder.hpp>
+#include <voxlet/io/mappedFile.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	using vx::testing::toSlice;
+
+	/* small assets of 1 to 16 KB spread over a few directories, what a game loads at startup */
+	struct Assets {
+		std::filesystem::path directory;
+		std::vector<std::string> names;
+		std::vector<std::string> paths;
+		std::string packPath;
+	};
+
+	auto makeAssets(const std::size_t count) -> Assets {
+		Assets assets {std::filesystem::temp_directory_path() / "voxlet-pack-benchmark", {}, {}, {}};
+		std::filesystem::remove_all(assets.directory);
+		vx::assets::PackBuilder builder {};
+		for (std::size_t i {0uz}; i < count; ++i) {
+			const std::string content((i * 4099uz) % (15uz * 1024uz) + 1024uz, static_cast<char> ('a' + i % 26uz));
+			assets.names.push_back(std::format("dir_{}/asset_{}.bin", i % 16uz, i));
+			const auto path {assets.directory / assets.names.back()};
+			std::filesystem::create_directories(path.parent_path());
+			std::ofstream {path, std::ios::binary | std::ios::trunc} << content;
+			assets.paths.push_back(path.string());
+			(void)builder.add(toSlice(assets.names.back()), std::as_bytes(std::span{content}), vx::assets::PackCompression::none);
+		}
+
+		const std::vector<std::byte> bytes {builder.write()};
+		assets.packPath = (assets.directory / "assets.pack").string();
+		std::ofstream {assets.packPath, std::ios::binary | std::ios::trunc}
+			.write(reinterpret_cast<const char*> (bytes.data()), static_cast<std::streamsize> (bytes.size()));
+		return assets;
+	}
+}
+
+
+TEST_CASE("pack-startup - benchmark", "[assets]") {
+	const std::size_t count {GENERATE(100uz, 1000uz, 10'000uz)};
+	const Assets assets {makeAssets(count)};
+
+	std::println(stderr, "Benchmarking the startup load of {} assets", count);
+
+	/* every asset is opened and touched once, the files stay in the page cache across runs */
+	BENCHMARK(std::format("[startup] loose files - count={}", count)) {
+		std::size_t sum {0uz};
+		for (const std::string& path : assets.paths) {
+			const std::optional<vx::io::MappedFile> file {vx::io::MappedFile::open(toSlice(path))};
+			sum += static_cast<std::size_t> (file->getBytes().back());
+		}
+		return sum;
+	};
+
+	BENCHMARK(std::format("[startup] pack - count={}", count)) {
+		const std::optional<vx::assets::Pack> pack {vx::assets::Pack::open(toSlice(assets.packPath))};
+		std::size_t sum {0uz};
+		for (const std::string& name : assets.names)
+			sum += static_cast<std::size_t> (pack->getBlob(*pack->find(toSlice(name))).back());
+		return sum;
+	};
+
+	std::filesystem::remove_all(assets.directory);
+}
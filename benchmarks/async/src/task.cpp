@@ -0,0 +1,83 @@
+#include <print>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/async/executor.hpp>
+#include <voxlet/async/frameClock.hpp>
+#include <voxlet/async/task.hpp>
+#include <voxlet/async/whenAll.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+
+
+namespace {
+	[[gnu::noinline]]
+	auto identity(const int value) noexcept -> int {
+		return value;
+	}
+
+	auto identityTask(const int value) -> vx::async::Task<int> {
+		co_return value;
+	}
+
+	auto chain(const int depth) -> vx::async::Task<int> {
+		int sum {0};
+		for (int i {0}; i < depth; ++i)
+			sum += co_await identityTask(i);
+		co_return sum;
+	}
+
+	auto hops(vx::jobs::Scheduler& scheduler, const int count) -> vx::async::Task<int> {
+		for (int i {0}; i < count; ++i)
+			co_await vx::async::schedule(scheduler);
+		co_return count;
+	}
+
+	auto waitFrames(vx::async::FrameClock& clock, const int count, int& done) -> vx::async::Task<> {
+		for (int i {0}; i < count; ++i)
+			(void)co_await clock.nextFrame();
+		++done;
+	}
+}
+
+
+TEST_CASE("task - benchmark", "[async]") {
+	const int count {GENERATE(1, 16, 256, 4096)};
+	vx::jobs::Scheduler scheduler {{.workerCount = 0uz}};
+
+	std::println(stderr, "Benchmarking {} suspensions", count);
+
+	BENCHMARK(std::format("[create and await] function call - count={}", count)) {
+		int sum {0};
+		for (int i {0}; i < count; ++i)
+			sum += identity(i);
+		return sum;
+	};
+
+	BENCHMARK(std::format("[create and await] vx::async::Task - count={}", count)) {
+		return vx::async::syncWait(scheduler, chain(count));
+	};
+
+	BENCHMARK(std::format("[scheduler hop] vx::async::schedule - count={}", count)) {
+		return vx::async::syncWait(scheduler, hops(scheduler, count));
+	};
+
+	BENCHMARK(std::format("[frame resume] vx::async::FrameClock - count={}", count)) {
+		vx::async::FrameClock clock {};
+		int done {0};
+		for (int i {0}; i < count; ++i)
+			vx::async::spawn(waitFrames(clock, 1, done));
+		clock.tick();
+		return done;
+	};
+
+	BENCHMARK(std::format("[when all] vx::async::whenAll - count={}", count)) {
+		std::vector<vx::async::Task<int>> tasks {};
+		tasks.reserve(static_cast<std::size_t> (count));
+		for (int i {0}; i < count; ++i)
+			tasks.push_back(identityTask(i));
+		return vx::async::syncWait(scheduler, vx::async::whenAll(std::move(tasks))).size();
+	};
+}
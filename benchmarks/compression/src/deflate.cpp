@@ -0,0 +1,94 @@
+#include <cstring>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/assets/atlasBuilder.hpp>
+#include <voxlet/compression/deflate.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	enum class Sheet {
+		/* flat colors and outlines, as pixel art */
+		flat,
+		/* vertical gradients and a little noise, as painted or downscaled sprites */
+		shaded
+	};
+
+	/* the pixels of a 2048x2048 atlas page, 16 MB, the engine has no sprite sheets of its own to read */
+	auto makeSpriteSheet(const Sheet sheet) -> std::vector<std::byte> {
+		vx::assets::AtlasBuilder builder {};
+		std::mt19937 random {42u};
+		std::uniform_int_distribution<std::uint32_t> side {8u, 48u};
+		for (std::size_t i {0uz}; builder.getPages().size() < 2uz; ++i) {
+			const std::uint32_t width {side(random)};
+			const std::uint32_t height {side(random)};
+			vx::render::Image sprite {width, height, 0u};
+			const std::uint32_t color {static_cast<std::uint32_t> (random()) & 0x007f'7f7fu};
+			for (std::uint32_t y {1u}; y + 1u < height; ++y) {
+				for (std::uint32_t x {1u}; x + 1u < width; ++x) {
+					const bool isOutline {x == 1u || y == 1u || x + 2u == width || y + 2u == height};
+					std::uint32_t shade {0u};
+					if (sheet == Sheet::shaded)
+						shade = (y * 2u + static_cast<std::uint32_t> (random() % 4u)) * 0x0001'0101u;
+					sprite.getRow(y)[x] = isOutline ? 0xff00'0000u : (color + shade) | 0xff00'0000u;
+				}
+			}
+			const std::string name {"sprite_" + std::to_string(i)};
+			(void)builder.set(vx::testing::toSlice(name), sprite);
+		}
+		const std::span<const std::byte> pixels {std::as_bytes(builder.getPages()[0].getPixels())};
+		return {pixels.begin(), pixels.end()};
+	}
+}
+
+
+TEST_CASE("deflate - benchmark", "[compression]") {
+	const Sheet sheet {GENERATE(Sheet::flat, Sheet::shaded)};
+	const char* const name {sheet == Sheet::flat ? "flat" : "shaded"};
+	const std::vector<std::byte> input {makeSpriteSheet(sheet)};
+	const std::vector<std::byte> stream {vx::compression::deflate(input, vx::compression::DeflateFormat::zlib)};
+	std::vector<std::byte> output (input.size());
+	REQUIRE(vx::compression::inflate(stream, output, vx::compression::DeflateFormat::zlib) == input.size());
+
+	std::println(
+		stderr,
+		"Benchmarking {} MB of {} sprites, deflated to {:.1f}%",
+		input.size() / (1024uz * 1024uz),
+		name,
+		100.0 * static_cast<double> (stream.size()) / static_cast<double> (input.size())
+	);
+
+	BENCHMARK(std::format("[deflate] memcpy - sheet={}", name)) {
+		(void)std::memcpy(output.data(), input.data(), input.size());
+		return output[output.size() / 2uz];
+	};
+
+	BENCHMARK(std::format("[deflate] adler32 - sheet={}", name)) {
+		return vx::compression::adler32(input);
+	};
+
+	BENCHMARK(std::format("[deflate] deflate - sheet={}", name)) {
+		return vx::compression::deflate(input, vx::compression::DeflateFormat::zlib).size();
+	};
+
+	BENCHMARK(std::format("[deflate] inflate - sheet={}", name)) {
+		return vx::compression::inflate(stream, output, vx::compression::DeflateFormat::zlib);
+	};
+
+	/* through the window of the inflater into a buffer of a few rows, as an importer converting pixels would */
+	BENCHMARK(std::format("[deflate] inflate streaming - sheet={}", name)) {
+		vx::compression::Inflater inflater {stream, vx::compression::DeflateFormat::zlib};
+		std::span<std::byte> rows {output.data(), 16uz * 2048uz * 4uz};
+		std::size_t size {0uz};
+		while (inflater.read(rows) == rows.size())
+			size += rows.size();
+		return size + static_cast<std::size_t> (inflater.isDone());
+	};
+}
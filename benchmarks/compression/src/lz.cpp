@@ -0,0 +1,145 @@
+#include <cstring>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/assets/atlasBuilder.hpp>
+#include <voxlet/compression/lz.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/world/tilemap.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	constexpr std::size_t CORPUS_SIZE {16uz * 1024uz * 1024uz};
+
+	enum class Corpus {
+		atlas,
+		tiles,
+		text,
+		random
+	};
+
+	/* stand-ins for what packs and saves hold, the engine has no asset directory to read from */
+	auto makeCorpus(const Corpus corpus) -> std::vector<std::byte> {
+		std::vector<std::byte> bytes {};
+		std::mt19937 random {42u};
+		switch (corpus) {
+			/* sprites with flat colors, outlines and transparent space between them, packed in atlas pages */
+			case Corpus::atlas: {
+				vx::assets::AtlasBuilder builder {};
+				std::uniform_int_distribution<std::uint32_t> side {8u, 48u};
+				/* until the first 2048x2048 page, 16 MB, is full */
+				for (std::size_t i {0uz}; builder.getPages().size() < 2uz; ++i) {
+					const std::uint32_t width {side(random)};
+					const std::uint32_t height {side(random)};
+					vx::render::Image sprite {width, height, 0u};
+					const std::uint32_t color {static_cast<std::uint32_t> (random()) | 0xff00'0000u};
+					for (std::uint32_t y {1u}; y + 1u < height; ++y) {
+						for (std::uint32_t x {1u}; x + 1u < width; ++x)
+							sprite.getRow(y)[x] = (x == 1u || y == 1u || x + 2u == width || y + 2u == height) ? 0xff00'0000u : color;
+					}
+					const std::string name {"sprite_" + std::to_string(i)};
+					(void)builder.set(vx::testing::toSlice(name), sprite);
+				}
+				const std::vector<std::byte> atlas {builder.write()};
+				bytes.assign(atlas.begin(), atlas.begin() + static_cast<std::ptrdiff_t> (std::min(atlas.size(), CORPUS_SIZE)));
+				break;
+			}
+			/* chunks of terrain in Morton order, as a tilemap save would hold them */
+			case Corpus::tiles: {
+				std::vector<vx::world::TileId> tiles (vx::world::CHUNK_AREA);
+				for (std::int32_t chunk {0}; bytes.size() < CORPUS_SIZE; ++chunk) {
+					for (std::uint32_t y {0u}; y < vx::world::CHUNK_SIZE; ++y) {
+						for (std::uint32_t x {0u}; x < vx::world::CHUNK_SIZE; ++x) {
+							const auto ground {static_cast<std::uint32_t> (chunk * 7 % 13) + y / 4u};
+							const vx::world::TileId tile {static_cast<vx::world::TileId> (random() % 16u == 0u ? random() % 64u : ground)};
+							tiles[vx::world::mortonEncode(x, y)] = tile;
+						}
+					}
+					const std::span<const std::byte> chunkBytes {std::as_bytes(std::span{tiles})};
+					bytes.insert(bytes.end(), chunkBytes.begin(), chunkBytes.end());
+				}
+				break;
+			}
+			/* configuration and level descriptions */
+			case Corpus::text: {
+				const std::string keys[] {"position", "sprite", "layer", "health", "speed", "name", "script"};
+				while (bytes.size() < CORPUS_SIZE) {
+					const std::string line {std::format(
+						"{{\"{}\": {}, \"{}\": \"entity_{}\"}},\n",
+						keys[random() % std::size(keys)],
+						random() % 1000u,
+						keys[random() % std::size(keys)],
+						random() % 200u
+					)};
+					const std::span<const std::byte> lineBytes {std::as_bytes(std::span{line})};
+					bytes.insert(bytes.end(), lineBytes.begin(), lineBytes.end());
+				}
+				break;
+			}
+			case Corpus::random:
+				bytes.resize(CORPUS_SIZE);
+				for (std::byte& byte : bytes)
+					byte = static_cast<std::byte> (random());
+				break;
+		}
+		bytes.resize(CORPUS_SIZE);
+		return bytes;
+	}
+
+	auto getCorpusName(const Corpus corpus) noexcept -> const char* {
+		switch (corpus) {
+			case Corpus::atlas:
+				return "atlas";
+			case Corpus::tiles:
+				return "tiles";
+			case Corpus::text:
+				return "text";
+			case Corpus::random:
+				return "random";
+		}
+		return "";
+	}
+}
+
+
+TEST_CASE("lz - benchmark", "[compression]") {
+	const Corpus corpus {GENERATE(Corpus::atlas, Corpus::tiles, Corpus::text, Corpus::random)};
+	const char* const name {getCorpusName(corpus)};
+	const std::vector<std::byte> input {makeCorpus(corpus)};
+	const std::vector<std::byte> frame {vx::compression::compress(input)};
+	std::vector<std::byte> output (input.size());
+
+	std::println(
+		stderr,
+		"Benchmarking {} MB of {}, compressed to {:.1f}%",
+		input.size() / (1024uz * 1024uz),
+		name,
+		100.0 * static_cast<double> (frame.size()) / static_cast<double> (input.size())
+	);
+
+	vx::jobs::Scheduler scheduler {};
+
+	BENCHMARK(std::format("[lz] memcpy - corpus={}", name)) {
+		(void)std::memcpy(output.data(), input.data(), input.size());
+		return output[output.size() / 2uz];
+	};
+
+	BENCHMARK(std::format("[lz] compress - corpus={}", name)) {
+		return vx::compression::compress(input).size();
+	};
+
+	BENCHMARK(std::format("[lz] decompress - corpus={}", name)) {
+		return vx::compression::decompress(frame, output);
+	};
+
+	BENCHMARK(std::format("[lz] decompress parallel - corpus={}", name)) {
+		return vx::compression::decompress(frame, output, scheduler);
+	};
+}
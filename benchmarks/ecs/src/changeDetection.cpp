@@ -0,0 +1,83 @@
+#include <print>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/ecs/query.hpp>
+#include <voxlet/ecs/world.hpp>
+
+
+namespace {
+	struct Position {
+		float x;
+		float y;
+	};
+
+	struct Health {
+		int value;
+	};
+}
+
+
+TEST_CASE("change-detection - benchmark", "[ecs]") {
+	constexpr std::size_t COUNT {1'000'000uz};
+	const std::size_t percent {GENERATE(1uz, 10uz, 100uz)};
+	const bool scattered {GENERATE(false, true)};
+
+	std::println(stderr, "Benchmarking change detection with {}% of {} entities changed ({})",
+		percent, COUNT, scattered ? "scattered" : "contiguous"
+	);
+
+	vx::ecs::World world {};
+	std::vector<vx::ecs::Entity> entities {};
+	entities.reserve(COUNT);
+	for (std::size_t i {0uz}; i < COUNT; ++i)
+		entities.push_back(world.spawn(Position{0.f, 0.f}, Health{100}));
+
+	/* scattered changes hit every chunk, contiguous ones only the first chunks */
+	std::vector<vx::ecs::Entity> changed {};
+	const std::size_t changedCount {COUNT * percent / 100uz};
+	for (std::size_t i {0uz}; i < changedCount; ++i)
+		changed.push_back(entities[scattered ? i * (100uz / percent) : i]);
+	const auto damage {[&world, &changed] {
+		for (const vx::ecs::Entity entity : changed)
+			--world.get<Health> (entity)->value;
+	}};
+
+	auto fullScan {world.query<const Health> ()};
+	auto filtered {world.query<const Health> ()};
+	(void)filtered.changed<Health> ();
+	filtered.forEach([](const Health&) noexcept {});
+
+	BENCHMARK(std::format("[changed] full scan - percent={}, scattered={}", percent, scattered)) {
+		damage();
+		int sum {0};
+		fullScan.forEach([&sum](const Health& health) noexcept {sum += health.value;});
+		return sum;
+	};
+
+	BENCHMARK(std::format("[changed] vx::ecs::Query::changed forEach - percent={}, scattered={}", percent, scattered)) {
+		damage();
+		int sum {0};
+		filtered.forEach([&sum](const Health& health) noexcept {sum += health.value;});
+		return sum;
+	};
+
+	BENCHMARK(std::format("[changed] vx::ecs::Query::changed forEachChunk - percent={}, scattered={}", percent, scattered)) {
+		damage();
+		int sum {0};
+		filtered.forEachChunk([&sum](const std::span<const Health> healths) noexcept {
+			for (const Health& health : healths)
+				sum += health.value;
+		});
+		return sum;
+	};
+
+	BENCHMARK(std::format("[changed] baseline, writes only - percent={}, scattered={}", percent, scattered)) {
+		damage();
+		return world.get<Health> (entities.front())->value;
+	};
+}
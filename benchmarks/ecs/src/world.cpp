@@ -0,0 +1,117 @@
+#include <memory>
+#include <print>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/ecs/query.hpp>
+#include <voxlet/ecs/world.hpp>
+
+
+namespace {
+	struct Position {
+		float x;
+		float y;
+	};
+
+	struct Velocity {
+		float x;
+		float y;
+	};
+
+	struct Health {
+		int value;
+	};
+
+	/* the pointer-heavy layout we are moving away from */
+	struct GameObject {
+		std::unique_ptr<Position> position;
+		std::unique_ptr<Velocity> velocity;
+		std::unique_ptr<Health> health;
+	};
+}
+
+
+TEST_CASE("world - benchmark", "[ecs]") {
+	const std::size_t count {GENERATE(10'000uz, 1'000'000uz)};
+
+	std::println(stderr, "Benchmarking ECS with {} entities", count);
+
+	std::vector<std::unique_ptr<GameObject>> objects {};
+	objects.reserve(count);
+	for (std::size_t i {0uz}; i < count; ++i) {
+		objects.push_back(std::make_unique<GameObject> (GameObject{
+			std::make_unique<Position> (0.f, 0.f),
+			std::make_unique<Velocity> (1.f, 2.f),
+			std::make_unique<Health> (100)
+		}));
+	}
+
+	vx::ecs::World world {};
+	std::vector<vx::ecs::Entity> entities {};
+	entities.reserve(count);
+	for (std::size_t i {0uz}; i < count; ++i)
+		entities.push_back(world.spawn(Position{0.f, 0.f}, Velocity{1.f, 2.f}, Health{100}));
+	auto query {world.query<Position, const Velocity> ()};
+
+	BENCHMARK(std::format("[iterate] pointer graph - count={}", count)) {
+		for (const auto& object : objects) {
+			object->position->x += object->velocity->x;
+			object->position->y += object->velocity->y;
+		}
+		return objects.front()->position->x;
+	};
+
+	BENCHMARK(std::format("[iterate] vx::ecs::Query::forEach - count={}", count)) {
+		query.forEach([](Position& position, const Velocity& velocity) noexcept {
+			position.x += velocity.x;
+			position.y += velocity.y;
+		});
+		return world.get<Position> (entities.front())->x;
+	};
+
+	BENCHMARK(std::format("[iterate] vx::ecs::Query::forEachChunk - count={}", count)) {
+		query.forEachChunk([](const std::span<Position> positions, const std::span<const Velocity> velocities) noexcept {
+			for (std::size_t i {0uz}; i < positions.size(); ++i) {
+				positions[i].x += velocities[i].x;
+				positions[i].y += velocities[i].y;
+			}
+		});
+		return world.get<Position> (entities.front())->x;
+	};
+
+	BENCHMARK(std::format("[add and remove component] vx::ecs::World - count={}", count)) {
+		for (const vx::ecs::Entity entity : entities)
+			(void)world.remove<Health> (entity);
+		for (const vx::ecs::Entity entity : entities)
+			(void)world.add(entity, Health{100});
+		return world.getEntityCount();
+	};
+
+	BENCHMARK(std::format("[spawn and despawn] pointer graph - count={}", count)) {
+		std::vector<std::unique_ptr<GameObject>> spawned {};
+		spawned.reserve(count);
+		for (std::size_t i {0uz}; i < count; ++i) {
+			spawned.push_back(std::make_unique<GameObject> (GameObject{
+				std::make_unique<Position> (0.f, 0.f),
+				std::make_unique<Velocity> (1.f, 2.f),
+				std::make_unique<Health> (100)
+			}));
+		}
+		spawned.clear();
+		return spawned.capacity();
+	};
+
+	BENCHMARK(std::format("[spawn and despawn] vx::ecs::World - count={}", count)) {
+		std::vector<vx::ecs::Entity> spawned {};
+		spawned.reserve(count);
+		for (std::size_t i {0uz}; i < count; ++i)
+			spawned.push_back(world.spawn(Position{0.f, 0.f}, Velocity{1.f, 2.f}, Health{100}));
+		for (const vx::ecs::Entity entity : spawned)
+			(void)world.despawn(entity);
+		return world.getEntityCount();
+	};
+}
@@ -0,0 +1,58 @@
+#include <cstdint>
+#include <print>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/compression/deflate.hpp>
+#include <voxlet/image/png.hpp>
+#include <voxlet/testing/png.hpp>
+
+
+namespace {
+	enum class Filters {
+		/* `Paeth` on every row, a single run for the parallel decoder */
+		paeth,
+		/* `Sub` every 16 rows and `Paeth` otherwise, as encoders picking the smallest row often end up with */
+		mixed
+	};
+
+	auto getFilters(const Filters filters) -> std::vector<std::uint8_t> {
+		if (filters == Filters::paeth)
+			return {4u};
+		std::vector<std::uint8_t> mixed (16uz, 4u);
+		mixed[0] = 1u;
+		return mixed;
+	}
+}
+
+
+TEST_CASE("png - benchmark", "[image]") {
+	const Filters filters {GENERATE(Filters::paeth, Filters::mixed)};
+	const char* const name {filters == Filters::paeth ? "paeth" : "mixed"};
+	const vx::render::Image sheet {vx::testing::makeSpriteSheet()};
+	const std::vector<std::byte> file {vx::testing::encodePng(sheet, getFilters(filters))};
+	std::vector<std::uint32_t> pixels (sheet.getPixels().size());
+	REQUIRE(vx::image::decodePng(file, pixels));
+	REQUIRE(std::ranges::equal(pixels, sheet.getPixels()));
+	std::vector<std::byte> rows (pixels.size() * 4uz + sheet.getHeight());
+	vx::jobs::Scheduler scheduler {};
+
+	std::println(stderr, "Benchmarking a {}x{} sprite sheet of {} KB", sheet.getWidth(), sheet.getHeight(), file.size() / 1024uz);
+
+	/* the part of the decoding that isn't filters and conversions */
+	BENCHMARK(std::format("[png] inflate - filters={}", name)) {
+		const std::span<const std::byte> stream {file.begin() + 8 + 25 + 8, file.end() - 16};
+		return vx::compression::inflate(stream, rows, vx::compression::DeflateFormat::zlib);
+	};
+
+	BENCHMARK(std::format("[png] decode - filters={}", name)) {
+		return vx::image::decodePng(file, pixels);
+	};
+
+	BENCHMARK(std::format("[png] decode parallel - filters={}", name)) {
+		return vx::image::decodePng(file, pixels, scheduler);
+	};
+}
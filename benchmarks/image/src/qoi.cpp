@@ -0,0 +1,53 @@
+#include <cstdint>
+#include <print>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/image/png.hpp>
+#include <voxlet/image/qoi.hpp>
+#include <voxlet/testing/png.hpp>
+
+
+TEST_CASE("qoi - benchmark", "[image]") {
+	const vx::render::Image sheet {vx::testing::makeSpriteSheet()};
+	/* `Paeth` on every row, what the texture would most likely come from */
+	const std::vector<std::byte> png {vx::testing::encodePng(sheet, std::vector<std::uint8_t> {4u})};
+	const std::vector<std::byte> qoi {*vx::image::encodeQoi(sheet)};
+	std::vector<std::uint32_t> pixels (sheet.getPixels().size());
+	REQUIRE(vx::image::decodeQoi(qoi, pixels));
+	REQUIRE(std::ranges::equal(pixels, sheet.getPixels()));
+	vx::jobs::Scheduler scheduler {};
+
+	std::println(
+		stderr,
+		"Benchmarking a {}x{} sprite sheet of {} MB, {} KB as PNG and {} KB as QOI",
+		sheet.getWidth(),
+		sheet.getHeight(),
+		sheet.getPixels().size_bytes() / (1024uz * 1024uz),
+		png.size() / 1024uz,
+		qoi.size() / 1024uz
+	);
+
+	BENCHMARK("[qoi] encode") {
+		return vx::image::encodeQoi(sheet);
+	};
+
+	BENCHMARK("[qoi] encode parallel") {
+		return vx::image::encodeQoi(sheet, scheduler);
+	};
+
+	BENCHMARK("[qoi] decode") {
+		return vx::image::decodeQoi(qoi, pixels);
+	};
+
+	BENCHMARK("[qoi] decode parallel") {
+		return vx::image::decodeQoi(qoi, pixels, scheduler);
+	};
+
+	/* the path the cache replaces */
+	BENCHMARK("[qoi] png decode") {
+		return vx::image::decodePng(png, pixels);
+	};
+}
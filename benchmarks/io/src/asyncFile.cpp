@@ -0,0 +1,130 @@
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <voxlet/io/asyncFile.hpp>
+#include <voxlet/io/ioContext.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	constexpr std::size_t FILE_SIZE {4096uz};
+
+	auto makeFiles(const std::size_t count) -> std::vector<std::string> {
+		const auto directory {std::filesystem::temp_directory_path() / "voxlet-io-benchmark"};
+		std::filesystem::create_directories(directory);
+		const std::string content(FILE_SIZE, 'x');
+		std::vector<std::string> paths {};
+		paths.reserve(count);
+		for (std::size_t i {0uz}; i < count; ++i) {
+			paths.push_back((directory / std::format("{}.bin", i)).string());
+			std::ofstream {paths.back(), std::ios::binary | std::ios::trunc} << content;
+		}
+		return paths;
+	}
+
+	auto raiseFileLimit() noexcept -> void {
+		rlimit limit {};
+		if (::getrlimit(RLIMIT_NOFILE, &limit) != 0)
+			return;
+		limit.rlim_cur = limit.rlim_max;
+		(void)::setrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	auto readAll(vx::io::IoContext& context, std::span<std::optional<vx::io::AsyncFile>> files, std::span<std::byte> buffer)
+		noexcept
+		-> std::int64_t
+	{
+		std::int64_t total {0};
+		for (std::size_t i {0uz}; i < files.size(); ++i) {
+			files[i]->read({.buffer = buffer.subspan(i * FILE_SIZE, FILE_SIZE)}, [](void* userData, std::int64_t result) noexcept {
+				*static_cast<std::int64_t*> (userData) += result;
+			}, &total);
+		}
+		std::size_t completed {0uz};
+		while (completed != files.size())
+			completed += context.wait(files.size() - completed);
+		return total;
+	}
+}
+
+
+TEST_CASE("async file - benchmark", "[io]") {
+	const std::size_t count {GENERATE(16uz, 1024uz, 10'000uz)};
+	raiseFileLimit();
+	const auto paths {makeFiles(count)};
+	std::vector<std::byte> buffer(count * FILE_SIZE);
+
+	std::println(stderr, "Benchmarking reads of {} files of {} bytes", count, FILE_SIZE);
+
+	const auto openAll {[&](vx::io::IoContext& context) {
+		std::vector<std::optional<vx::io::AsyncFile>> files {};
+		files.reserve(count);
+		for (const auto& path : paths)
+			files.push_back(vx::io::AsyncFile::open(context, vx::testing::toSlice(path)));
+		return files;
+	}};
+
+	std::vector<int> fds {};
+	fds.reserve(count);
+	for (const auto& path : paths)
+		fds.push_back(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+	BENCHMARK(std::format("[read] blocking pread - count={}", count)) {
+		std::int64_t total {0};
+		for (std::size_t i {0uz}; i < count; ++i)
+			total += ::pread(fds[i], buffer.data() + i * FILE_SIZE, FILE_SIZE, 0);
+		return total;
+	};
+	for (const int fd : fds)
+		(void)::close(fd);
+
+	{
+		vx::io::IoContext threadPoolContext {{.backend = vx::io::Backend::threadPool}};
+		auto threadPoolFiles {openAll(threadPoolContext)};
+		BENCHMARK(std::format("[read] vx::io::AsyncFile thread pool - count={}", count)) {
+			return readAll(threadPoolContext, threadPoolFiles, buffer);
+		};
+	}
+
+	vx::io::IoContext uringContext {{.backend = vx::io::Backend::ioUring, .queueDepth = 4096u}};
+	if (!uringContext.isValid()) {
+		std::println(stderr, "io_uring is unavailable, skipping");
+		return;
+	}
+	auto uringFiles {openAll(uringContext)};
+	BENCHMARK(std::format("[read] vx::io::AsyncFile io_uring - count={}", count)) {
+		return readAll(uringContext, uringFiles, buffer);
+	};
+
+	const std::array<std::span<std::byte>, 1uz> registered {buffer};
+	if (uringContext.registerBuffers(registered)) {
+		BENCHMARK(std::format("[read] vx::io::AsyncFile io_uring registered buffer - count={}", count)) {
+			std::int64_t total {0};
+			for (std::size_t i {0uz}; i < count; ++i) {
+				uringFiles[i]->read({
+					.buffer = std::span{buffer}.subspan(i * FILE_SIZE, FILE_SIZE),
+					.registeredBuffer = 0u
+				}, [](void* userData, std::int64_t result) noexcept {
+					*static_cast<std::int64_t*> (userData) += result;
+				}, &total);
+			}
+			std::size_t completed {0uz};
+			while (completed != count)
+				completed += uringContext.wait(count - completed);
+			return total;
+		};
+		uringContext.unregisterBuffers();
+	}
+}
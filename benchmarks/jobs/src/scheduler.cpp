@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <cmath>
+#include <print>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/jobs/parallelFor.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+
+
+TEST_CASE("scheduler - benchmark", "[jobs]") {
+	const std::size_t hardwareThreads {std::max(std::thread::hardware_concurrency(), 1u)};
+	const std::size_t threadCount {GENERATE_COPY(range(1uz, hardwareThreads + 1uz))};
+	const auto pinning {GENERATE(vx::jobs::ThreadPinning::none, vx::jobs::ThreadPinning::pinned)};
+	const char* const pinningName {pinning == vx::jobs::ThreadPinning::pinned ? "pinned" : "unpinned"};
+
+	vx::jobs::Scheduler scheduler {{.workerCount = threadCount - 1uz, .pinning = pinning}};
+	std::vector<float> values(1uz << 22uz, 1.5f);
+
+	std::println(stderr, "Benchmarking scheduler with {} {} threads", threadCount, pinningName);
+
+	if (threadCount == 1uz && pinning == vx::jobs::ThreadPinning::none) {
+		BENCHMARK(std::format("[parallel-for 4M floats] sequential - threads={}", threadCount)) {
+			for (float& value : values)
+				value = std::sqrt(value * value + 1.f);
+			return values.front();
+		};
+	}
+
+	BENCHMARK(std::format("[parallel-for 4M floats] vx::jobs {} - threads={}", pinningName, threadCount)) {
+		vx::jobs::parallelFor(scheduler, values, [](std::span<float> chunk) noexcept {
+			for (float& value : chunk)
+				value = std::sqrt(value * value + 1.f);
+		});
+		return values.front();
+	};
+
+	BENCHMARK(std::format("[4096 empty jobs] vx::jobs {} - threads={}", pinningName, threadCount)) {
+		auto job {[]() noexcept {}};
+		vx::jobs::Counter counter {};
+		for (std::size_t i {0uz}; i < 4096uz; ++i)
+			scheduler.submit(job, counter);
+		scheduler.wait(counter);
+		return counter.getValue();
+	};
+}
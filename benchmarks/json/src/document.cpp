@@ -0,0 +1,101 @@
+#include <print>
+#include <random>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/json/document.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	enum class Level {
+		/* tile layers of a large map, mostly integers */
+		tiles,
+		/* placed objects with properties, mostly keys and strings */
+		objects
+	};
+
+	using vx::testing::toSlice;
+
+	/* shaped like a Tiled `.tmj` map, the engine has no level files of its own yet */
+	auto makeLevel(const Level level) -> std::string {
+		std::mt19937 random {17u};
+		std::string text {"{\"type\": \"map\", \"version\": \"1.10\", \"orientation\": \"orthogonal\", \"tilewidth\": 16, \"tileheight\": 16,\n"};
+		if (level == Level::tiles) {
+			constexpr std::uint32_t SIDE {512u};
+			text += std::format("\"width\": {}, \"height\": {}, \"layers\": [\n", SIDE, SIDE);
+			for (std::uint32_t layer {0u}; layer < 4u; ++layer) {
+				text += std::format("{}{{\"id\": {}, \"name\": \"layer_{}\", \"type\": \"tilelayer\", \"opacity\": 1, \"visible\": true, \"data\": [", layer == 0u ? "" : ",\n", layer, layer);
+				for (std::uint32_t tile {0u}; tile < SIDE * SIDE; ++tile) {
+					const std::uint32_t id {random() % 4u == 0u ? 0u : static_cast<std::uint32_t> (random() % 700u) + 1u};
+					text += std::format("{}{}", tile == 0u ? "" : (tile % SIDE == 0u ? ",\n" : ","), id);
+				}
+				text += "]}";
+			}
+		}
+		else {
+			text += "\"width\": 256, \"height\": 256, \"layers\": [{\"id\": 0, \"name\": \"props\", \"type\": \"objectgroup\", \"objects\": [\n";
+			constexpr const char* TYPES[] {"crate", "barrel", "torch", "spawn", "chest", "door"};
+			for (std::uint32_t object {0u}; object < 24'000u; ++object) {
+				const char* const type {TYPES[random() % std::size(TYPES)]};
+				text += std::format(
+					"{}  {{\"id\": {}, \"name\": \"{}_{}\", \"type\": \"{}\", \"x\": {}.5, \"y\": {}.25, \"rotation\": 0, \"visible\": true,"
+					" \"properties\": [{{\"name\": \"health\", \"type\": \"int\", \"value\": {}}}, {{\"name\": \"loot\", \"type\": \"string\", \"value\": \"table_{}\"}}]}}",
+					object == 0u ? "" : ",\n",
+					object,
+					type,
+					object,
+					type,
+					random() % 4096u,
+					random() % 4096u,
+					random() % 100u,
+					random() % 32u
+				);
+			}
+			text += "]}";
+		}
+		text += "]}\n";
+		return text;
+	}
+
+	/* what a level loader would read, through lookups and iterations on the parsed document */
+	auto readLevel(const vx::json::Document& document, const Level level) noexcept -> std::uint64_t {
+		std::uint64_t sum {0u};
+		for (const vx::json::Value layer : document.getRoot()[vx::StringSlice::from(u8"layers")].getElements()) {
+			if (level == Level::tiles) {
+				for (const vx::json::Value tile : layer[vx::StringSlice::from(u8"data")].getElements())
+					sum += static_cast<std::uint64_t> (tile.asInteger().value_or(0));
+				continue;
+			}
+			for (const vx::json::Value object : layer[vx::StringSlice::from(u8"objects")].getElements()) {
+				sum += static_cast<std::uint64_t> (object[vx::StringSlice::from(u8"x")].asNumber().value_or(0.0));
+				sum += object[vx::StringSlice::from(u8"name")].asString().value_or(vx::containers::views::UncheckedStringSlice{}).getSize();
+				sum += static_cast<std::uint64_t> (object[vx::StringSlice::from(u8"properties")][0uz][vx::StringSlice::from(u8"value")].asInteger().value_or(0));
+			}
+		}
+		return sum;
+	}
+}
+
+
+TEST_CASE("json - benchmark", "[json]") {
+	const Level level {GENERATE(Level::tiles, Level::objects)};
+	const char* const name {level == Level::tiles ? "tiles" : "objects"};
+	const std::string text {makeLevel(level)};
+	const std::optional<vx::json::Document> document {vx::json::Document::parse(toSlice(text))};
+	REQUIRE(document);
+	REQUIRE(readLevel(*document, level) != 0u);
+
+	std::println(stderr, "Benchmarking a level of {} with {} KB of JSON", name, text.size() / 1024uz);
+
+	BENCHMARK(std::format("[json] parse - level={}", name)) {
+		return vx::json::Document::parse(toSlice(text));
+	};
+
+	BENCHMARK(std::format("[json] parse and read - level={}", name)) {
+		return readLevel(*vx::json::Document::parse(toSlice(text)), level);
+	};
+}
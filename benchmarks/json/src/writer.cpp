@@ -0,0 +1,125 @@
+#include <print>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/json/writer.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	struct Object {
+		std::uint32_t id;
+		std::string name;
+		double x;
+		double y;
+		std::uint32_t health;
+	};
+
+	/* what a level save would hold, a tile layer and the objects placed on it */
+	struct Level {
+		std::vector<std::uint32_t> tiles;
+		std::vector<Object> objects;
+	};
+
+	auto makeLevel() -> Level {
+		std::mt19937 random {17u};
+		Level level {};
+		level.tiles.resize(512uz * 512uz);
+		for (std::uint32_t& tile : level.tiles)
+			tile = random() % 4u == 0u ? 0u : static_cast<std::uint32_t> (random() % 700u) + 1u;
+		constexpr const char* TYPES[] {"crate", "barrel", "torch", "spawn \"main\"", "chest", "door"};
+		for (std::uint32_t id {0u}; id < 24'000u; ++id) {
+			level.objects.push_back({
+				.id = id,
+				.name = TYPES[random() % std::size(TYPES)] + std::string{"_"} + std::to_string(id),
+				.x = static_cast<double> (random() % 4096u) * 0.5,
+				.y = static_cast<double> (random() % 4096u) / 3.0,
+				.health = static_cast<std::uint32_t> (random() % 100u)
+			});
+		}
+		return level;
+	}
+
+	using vx::testing::toSlice;
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto writeLevel(const Level& level, vx::json::BasicWriter<bufferSize, hasInnerStorage>& writer) -> void {
+		writer.beginObject();
+		writer.writeKey(u8"tiles");
+		writer.beginArray();
+		for (const std::uint32_t tile : level.tiles)
+			writer.write(tile);
+		writer.endArray();
+		writer.writeKey(u8"objects");
+		writer.beginArray();
+		for (const Object& object : level.objects) {
+			writer.beginObject();
+			writer.writeKey(u8"id");
+			writer.write(object.id);
+			writer.writeKey(u8"name");
+			writer.write(toSlice(object.name));
+			writer.writeKey(u8"x");
+			writer.write(object.x);
+			writer.writeKey(u8"y");
+			writer.write(object.y);
+			writer.writeKey(u8"health");
+			writer.write(object.health);
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.endObject();
+	}
+
+	/* the same text through a stream, names are known to need escaping only for their quotes */
+	auto writeLevel(const Level& level, std::ostringstream& stream) -> void {
+		stream.precision(17);
+		stream << "{\"tiles\":[";
+		for (std::size_t i {0uz}; i < level.tiles.size(); ++i)
+			stream << (i == 0uz ? "" : ",") << level.tiles[i];
+		stream << "],\"objects\":[";
+		for (std::size_t i {0uz}; i < level.objects.size(); ++i) {
+			const Object& object {level.objects[i]};
+			stream << (i == 0uz ? "" : ",") << "{\"id\":" << object.id << ",\"name\":\"";
+			for (const char character : object.name)
+				stream << (character == '"' ? "\\\"" : std::string(1uz, character));
+			stream << "\",\"x\":" << object.x << ",\"y\":" << object.y << ",\"health\":" << object.health << '}';
+		}
+		stream << "]}";
+	}
+}
+
+
+TEST_CASE("json writer - benchmark", "[json]") {
+	const Level level {makeLevel()};
+	vx::containers::BasicStringAccumulator<64uz * 1024uz, false> output {};
+	vx::json::BasicWriter writer {output};
+	writeLevel(level, writer);
+	REQUIRE(writer.isComplete());
+
+	std::println(stderr, "Benchmarking the writing of {} KB of JSON", output.getSize() / 1024uz);
+
+	BENCHMARK("[json] write") {
+		output.clear();
+		vx::json::BasicWriter compact {output};
+		writeLevel(level, compact);
+		return output.getSize();
+	};
+
+	BENCHMARK("[json] write pretty") {
+		output.clear();
+		vx::json::BasicWriter pretty {output, vx::json::Style::pretty};
+		writeLevel(level, pretty);
+		return output.getSize();
+	};
+
+	BENCHMARK("[json] write ostringstream") {
+		std::ostringstream stream {};
+		writeLevel(level, stream);
+		return stream.str().size();
+	};
+}
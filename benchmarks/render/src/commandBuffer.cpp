@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <memory>
+#include <print>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/jobs/parallelFor.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/render/commandBuffer.hpp>
+#include <voxlet/render/glStateCache.hpp>
+#include <voxlet/render/glStub.hpp>
+
+
+namespace {
+	auto makeDraw(const std::size_t index) noexcept -> vx::render::DrawCommand {
+		return vx::render::DrawCommand{
+			.state = vx::render::RenderState{
+				.program = static_cast<GLuint> (1uz + index % 4uz),
+				.vertexArray = 1u,
+				.textures = {{{GL_TEXTURE_2D, static_cast<GLuint> (1uz + index % 16uz)}, {0u, 0u}, {0u, 0u}, {0u, 0u}}},
+				.blendSource = GL_ONE,
+				.blendDestination = GL_ONE_MINUS_SRC_ALPHA,
+				.blend = false,
+				.depthTest = true
+			},
+			.mode = GL_TRIANGLES,
+			.first = 0,
+			.count = 6,
+			.instanceCount = 1,
+			.baseInstance = static_cast<GLuint> (index)
+		};
+	}
+
+	auto makeKey(const std::size_t index) noexcept -> std::uint64_t {
+		return static_cast<std::uint64_t> (index % 4uz) << 40u | static_cast<std::uint64_t> (index % 16uz) << 20u | (index & 0xf'ffffu);
+	}
+}
+
+
+TEST_CASE("render-command-buffer - benchmark", "[render]") {
+	const std::size_t count {GENERATE(10'000uz, 100'000uz)};
+
+	std::println(stderr, "Benchmarking render command recording and submission with {} draws", count);
+
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	stub.setRecording(false);
+	vx::jobs::Scheduler scheduler {};
+	vx::render::GlStateCache state {};
+	vx::render::CommandQueue queue {};
+
+	std::vector<std::unique_ptr<vx::render::CommandBuffer>> buffers {};
+	std::vector<vx::render::CommandBuffer*> pointers {};
+	for (std::size_t i {0uz}; i < scheduler.getThreadCount(); ++i) {
+		buffers.push_back(std::make_unique<vx::render::CommandBuffer> ());
+		pointers.push_back(buffers.back().get());
+	}
+
+	BENCHMARK(std::format("[record] single thread - count={}", count)) {
+		vx::render::CommandBuffer& buffer {*buffers.front()};
+		buffer.clear();
+		for (std::size_t i {0uz}; i < count; ++i)
+			buffer.draw(makeKey(count - i), makeDraw(i));
+		buffer.sort();
+		return buffer.size();
+	};
+
+	const auto record {[&]() noexcept {
+		for (const auto& buffer : buffers)
+			buffer->clear();
+		vx::jobs::parallelFor(scheduler, 0uz, count, [&](const std::size_t first, const std::size_t last) noexcept {
+			vx::render::CommandBuffer& buffer {*buffers[scheduler.getCurrentThreadIndex()]};
+			for (std::size_t i {first}; i < last; ++i)
+				buffer.draw(makeKey(count - i), makeDraw(i));
+		});
+		vx::jobs::parallelFor(scheduler, 0uz, buffers.size(), [&](const std::size_t first, const std::size_t last) noexcept {
+			for (std::size_t i {first}; i < last; ++i)
+				buffers[i]->sort();
+		}, 1uz);
+	}};
+
+	BENCHMARK(std::format("[record] parallel - count={}", count)) {
+		record();
+		return buffers.front()->size();
+	};
+
+	record();
+	BENCHMARK(std::format("[submit] merge - count={}", count)) {
+		queue.merge(pointers);
+		return queue.getEntries().size();
+	};
+
+	BENCHMARK(std::format("[submit] execute - count={}", count)) {
+		state.beginFrame();
+		queue.execute(state);
+		return state.getStats().issuedCount;
+	};
+
+	std::println(
+		stderr,
+		"Issued {} state calls and elided {} per frame",
+		state.getStats().issuedCount,
+		state.getStats().elidedCount
+	);
+}
@@ -0,0 +1,70 @@
+#include <print>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/render/glStateCache.hpp>
+#include <voxlet/render/glStub.hpp>
+
+
+TEST_CASE("gl-state-cache - benchmark", "[render]") {
+	const std::size_t drawCount {GENERATE(1'000uz, 10'000uz)};
+
+	std::println(stderr, "Benchmarking redundant state elision with {} draws", drawCount);
+
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	stub.setRecording(false);
+
+	/* draws sorted by program, as a batcher would emit them */
+	struct Draw {
+		GLuint program;
+		GLuint vertexArray;
+		GLuint texture;
+	};
+	std::mt19937 random {42u};
+	std::vector<Draw> draws {};
+	draws.reserve(drawCount);
+	for (std::size_t i {0uz}; i < drawCount; ++i)
+		draws.push_back(Draw{
+			static_cast<GLuint> (1uz + i * 4uz / drawCount),
+			static_cast<GLuint> (1u + random() % 2u),
+			static_cast<GLuint> (1u + random() % 8u)
+		});
+
+	BENCHMARK(std::format("[state] naive - draws={}", drawCount)) {
+		for (const Draw& draw : draws) {
+			glUseProgram(draw.program);
+			glBindVertexArray(draw.vertexArray);
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, draw.texture);
+			glEnable(GL_BLEND);
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+		}
+		return draws.size();
+	};
+
+	vx::render::GlStateCache cache {};
+	BENCHMARK(std::format("[state] vx::render::GlStateCache - draws={}", drawCount)) {
+		cache.beginFrame();
+		for (const Draw& draw : draws) {
+			cache.useProgram(draw.program);
+			cache.bindVertexArray(draw.vertexArray);
+			cache.activeTexture(GL_TEXTURE0);
+			cache.bindTexture(GL_TEXTURE_2D, draw.texture);
+			cache.setEnabled(GL_BLEND, true);
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+		}
+		return cache.getStats().issuedCount;
+	};
+
+	std::println(
+		stderr,
+		"Issued {} calls and elided {} per frame",
+		cache.getStats().issuedCount,
+		cache.getStats().elidedCount
+	);
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <print>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/render/image.hpp>
+#include <voxlet/render/softwareRenderer.hpp>
+
+
+namespace {
+	struct Resolution {
+		std::uint32_t width;
+		std::uint32_t height;
+	};
+
+	/* one screen of 16x16 tiles scaled to fill the target, and 2000 sprites of 16x16 texels over it */
+	auto submitScene(
+		vx::render::SoftwareRenderer& renderer,
+		const Resolution resolution,
+		const GLuint tileset,
+		const GLuint sprites,
+		const std::vector<std::uint16_t>& tiles
+	) noexcept -> void {
+		const std::uint32_t scale {std::max(resolution.height / 180u, 1u)};
+		renderer.submit(vx::render::TileLayer{
+			.tileset = tileset,
+			.tileSize = 16u,
+			.columns = 20u,
+			.rows = 12u,
+			.tiles = tiles,
+			.x = 0,
+			.y = 0,
+			.scale = scale,
+			.color = 0xffff'ffffu,
+			.layer = 0u
+		});
+
+		std::mt19937 random {42u};
+		for (std::size_t i {0uz}; i < 2000uz; ++i) {
+			const auto size {static_cast<float> (16u * scale)};
+			const auto column {static_cast<float> (random() % 16u)};
+			renderer.submit(vx::render::Sprite{
+				.x = static_cast<float> (random() % resolution.width) - size * 0.5f,
+				.y = static_cast<float> (random() % resolution.height) - size * 0.5f,
+				.width = size,
+				.height = size,
+				.u0 = column / 16.f,
+				.v0 = 0.f,
+				.u1 = (column + 1.f) / 16.f,
+				.v1 = 1.f,
+				.color = i % 4uz == 0uz ? 0xc0ff'ffffu : 0xffff'ffffu,
+				.depth = static_cast<float> (i) / 2000.f,
+				.program = 0u,
+				.texture = sprites,
+				.layer = 1u
+			});
+		}
+	}
+}
+
+
+TEST_CASE("render-software-renderer - benchmark", "[render]") {
+	const Resolution resolution {GENERATE(
+		Resolution{320u, 180u},
+		Resolution{1280u, 720u},
+		Resolution{1920u, 1080u},
+		Resolution{3840u, 2160u}
+	)};
+
+	std::println(stderr, "Benchmarking software rendering at {}x{}", resolution.width, resolution.height);
+
+	/* a 4x4 tileset of 16x16 tiles and an indexed strip of 16 sprites, half of their texels transparent */
+	std::mt19937 random {42u};
+	vx::render::Image tilesetImage {64u, 64u};
+	for (std::uint32_t& pixel : tilesetImage.getPixels())
+		pixel = 0xff00'0000u | static_cast<std::uint32_t> (random() & 0xff'ffffu);
+	vx::render::IndexedImage spriteImage {256u, 16u};
+	for (std::uint8_t& index : spriteImage.getIndices())
+		index = static_cast<std::uint8_t> (random() % 2u == 0u ? 0u : random());
+	vx::render::Palette palette {};
+	for (std::uint32_t& color : palette)
+		color = 0xff00'0000u | static_cast<std::uint32_t> (random() & 0xff'ffffu);
+	palette[0] = 0u;
+	std::vector<std::uint16_t> tiles (20uz * 12uz);
+	for (std::uint16_t& tile : tiles)
+		tile = static_cast<std::uint16_t> (1u + random() % 16u);
+
+	vx::jobs::Scheduler singleThread {{.workerCount = 0uz}};
+	vx::jobs::Scheduler scheduler {};
+	vx::render::Image target {resolution.width, resolution.height};
+
+	vx::render::SoftwareRenderer scalar {singleThread, {.backend = vx::render::RasterBackend::scalar}};
+	vx::render::SoftwareRenderer avx2 {singleThread, {.backend = vx::render::RasterBackend::avx2}};
+	vx::render::SoftwareRenderer parallelScalar {scheduler, {.backend = vx::render::RasterBackend::scalar}};
+	vx::render::SoftwareRenderer parallelAvx2 {scheduler, {.backend = vx::render::RasterBackend::avx2}};
+
+	const auto makeFrame {[&](vx::render::SoftwareRenderer& renderer) noexcept {
+		const GLuint tileset {renderer.registerTexture(tilesetImage)};
+		const GLuint sprites {renderer.registerTexture(spriteImage, palette)};
+		return [&renderer, &target, &tiles, resolution, tileset, sprites]() noexcept {
+			submitScene(renderer, resolution, tileset, sprites, tiles);
+			renderer.build();
+			renderer.draw(target);
+			return target.getPixel(0u, 0u);
+		};
+	}};
+	const auto frameScalar {makeFrame(scalar)};
+	const auto frameAvx2 {makeFrame(avx2)};
+	const auto frameParallelScalar {makeFrame(parallelScalar)};
+	const auto frameParallelAvx2 {makeFrame(parallelAvx2)};
+
+	BENCHMARK(std::format("[scalar] single thread - resolution={}x{}", resolution.width, resolution.height)) {
+		return frameScalar();
+	};
+
+	BENCHMARK(std::format("[avx2] single thread - resolution={}x{}", resolution.width, resolution.height)) {
+		return frameAvx2();
+	};
+
+	BENCHMARK(std::format("[scalar] parallel - resolution={}x{}", resolution.width, resolution.height)) {
+		return frameParallelScalar();
+	};
+
+	BENCHMARK(std::format("[avx2] parallel - resolution={}x{}", resolution.width, resolution.height)) {
+		return frameParallelAvx2();
+	};
+}
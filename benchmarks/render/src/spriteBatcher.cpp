@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <print>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/jobs/parallelFor.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/render/glStub.hpp>
+#include <voxlet/render/sortKey.hpp>
+#include <voxlet/render/spriteBatcher.hpp>
+
+
+TEST_CASE("sprite-batcher - benchmark", "[render]") {
+	const std::size_t count {GENERATE(100'000uz, 1'000'000uz)};
+
+	std::println(stderr, "Benchmarking sprite batching with {} sprites", count);
+
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	stub.setRecording(false);
+	vx::jobs::Scheduler scheduler {};
+
+	/* a typical frame: a few layers, a handful of programs and an atlas per program */
+	std::mt19937 random {42u};
+	std::vector<vx::render::Sprite> sprites {};
+	sprites.reserve(count);
+	for (std::size_t i {0uz}; i < count; ++i) {
+		sprites.push_back(vx::render::Sprite{
+			.x = static_cast<float> (random() % 1920u),
+			.y = static_cast<float> (random() % 1080u),
+			.width = 16.f,
+			.height = 16.f,
+			.u0 = 0.f,
+			.v0 = 0.f,
+			.u1 = 1.f,
+			.v1 = 1.f,
+			.color = 0xffff'ffffu,
+			.depth = static_cast<float> (random() % 1024u) / 1024.f,
+			.program = static_cast<GLuint> (1u + random() % 4u),
+			.texture = static_cast<GLuint> (1u + random() % 16u),
+			.layer = static_cast<std::uint8_t> (random() % 4u)
+		});
+	}
+
+	vx::render::SpriteBatcher batcher {scheduler};
+
+	BENCHMARK(std::format("[sort] std::ranges::sort by key - count={}", count)) {
+		std::vector<vx::render::Sprite> sorted {sprites};
+		std::ranges::sort(sorted, {}, vx::render::makeSpriteKey);
+		return sorted.front().x;
+	};
+
+	BENCHMARK(std::format("[sort] vx::render::radixSort - count={}", count)) {
+		std::vector<vx::render::SortEntry> entries (count);
+		std::vector<vx::render::SortEntry> scratch (count);
+		for (std::size_t i {0uz}; i < count; ++i)
+			entries[i] = vx::render::SortEntry{vx::render::makeSpriteKey(sprites[i]), i};
+		vx::render::radixSort(entries, scratch);
+		return entries.front().value;
+	};
+
+	BENCHMARK(std::format("[frame] vx::render::SpriteBatcher single thread - count={}", count)) {
+		batcher.submit(sprites);
+		batcher.build();
+		const std::size_t batchCount {batcher.getBatches().size()};
+		batcher.draw();
+		return batchCount;
+	};
+
+	BENCHMARK(std::format("[frame] vx::render::SpriteBatcher parallel submit - count={}", count)) {
+		vx::jobs::parallelFor(scheduler, 0uz, count, [&batcher, &sprites](const std::size_t first, const std::size_t last) noexcept {
+			batcher.submit(std::span{sprites}.subspan(first, last - first));
+		});
+		batcher.build();
+		const std::size_t batchCount {batcher.getBatches().size()};
+		batcher.draw();
+		return batchCount;
+	};
+}
@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <cstring>
+#include <print>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/render/glStub.hpp>
+#include <voxlet/render/streamingBuffer.hpp>
+
+
+TEST_CASE("streaming-buffer - benchmark", "[render]") {
+	const std::size_t size {GENERATE(64uz * 1024uz, 1024uz * 1024uz, 4uz * 1024uz * 1024uz)};
+
+	std::println(stderr, "Benchmarking per-frame uploads of {} bytes", size);
+
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	stub.setRecording(false);
+
+	const std::vector<std::byte> data (size, std::byte{0x5a});
+
+	BENCHMARK(std::format("[upload] glBufferData - size={}", size)) {
+		GLuint buffer {0u};
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		for (std::size_t frame {0uz}; frame < 16uz; ++frame)
+			glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr> (size), data.data(), GL_STREAM_DRAW);
+		glDeleteBuffers(1, &buffer);
+		return buffer;
+	};
+
+	auto stream {vx::render::StreamingBuffer::create(vx::render::StreamingBuffer::Config{.frameSize = size})};
+	REQUIRE(stream);
+
+	BENCHMARK(std::format("[upload] vx::render::StreamingBuffer - size={}", size)) {
+		std::size_t offset {0uz};
+		for (std::size_t frame {0uz}; frame < 16uz; ++frame) {
+			stream->beginFrame();
+			const auto allocation {stream->allocate(size)};
+			std::memcpy(allocation->data, data.data(), size);
+			offset += allocation->offset;
+			stream->endFrame();
+		}
+		return offset;
+	};
+}
+
+
+TEST_CASE("streaming-buffer-allocate - benchmark", "[render]") {
+	const std::size_t allocationCount {GENERATE(16uz, 1024uz)};
+
+	std::println(stderr, "Benchmarking streaming buffer frames of {} allocations", allocationCount);
+
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	stub.setRecording(false);
+	auto stream {vx::render::StreamingBuffer::create(vx::render::StreamingBuffer::Config{
+		.frameSize = allocationCount * 256uz
+	})};
+	REQUIRE(stream);
+
+	BENCHMARK(std::format("[allocate] frame with fences - count={}", allocationCount)) {
+		std::size_t offset {0uz};
+		stream->beginFrame();
+		for (std::size_t i {0uz}; i < allocationCount; ++i)
+			offset += stream->allocate(200uz, 40uz)->offset;
+		stream->endFrame();
+		return offset;
+	};
+}
@@ -0,0 +1,143 @@
+#include <cstring>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/json/document.hpp>
+#include <voxlet/json/writer.hpp>
+#include <voxlet/serial/builder.hpp>
+#include <voxlet/serial/document.hpp>
+
+
+namespace {
+	struct Object {
+		std::uint32_t id {0u};
+		vx::String name {};
+		double x {0.0};
+		double y {0.0};
+		std::uint32_t health {0u};
+	};
+
+	/* the level of the JSON writer benchmark, a tile layer and the objects placed on it */
+	struct Level {
+		std::vector<std::uint32_t> tiles {};
+		std::vector<Object> objects {};
+	};
+
+	auto makeLevel() -> Level {
+		std::mt19937 random {17u};
+		Level level {};
+		level.tiles.resize(512uz * 512uz);
+		for (std::uint32_t& tile : level.tiles)
+			tile = random() % 4u == 0u ? 0u : static_cast<std::uint32_t> (random() % 700u) + 1u;
+		constexpr const char* TYPES[] {"crate", "barrel", "torch", "spawn", "chest", "door"};
+		for (std::uint32_t id {0u}; id < 24'000u; ++id) {
+			const std::string name {TYPES[random() % std::size(TYPES)] + std::string{"_"} + std::to_string(id)};
+			level.objects.push_back({
+				.id = id,
+				.name = vx::String::from(reinterpret_cast<const char8_t*> (name.data()), name.size()),
+				.x = static_cast<double> (random() % 4096u) * 0.5,
+				.y = static_cast<double> (random() % 4096u) / 3.0,
+				.health = static_cast<std::uint32_t> (random() % 100u)
+			});
+		}
+		return level;
+	}
+
+	auto toJson(const Level& level) -> vx::String {
+		vx::containers::StringAccumulator output {};
+		vx::json::Writer writer {output};
+		writer.beginObject();
+		writer.writeKey(u8"tiles");
+		writer.beginArray();
+		for (const std::uint32_t tile : level.tiles)
+			writer.write(tile);
+		writer.endArray();
+		writer.writeKey(u8"objects");
+		writer.beginArray();
+		for (const Object& object : level.objects) {
+			writer.beginObject();
+			writer.writeKey(u8"id");
+			writer.write(object.id);
+			writer.writeKey(u8"name");
+			writer.write(object.name.slice());
+			writer.writeKey(u8"x");
+			writer.write(object.x);
+			writer.writeKey(u8"y");
+			writer.write(object.y);
+			writer.writeKey(u8"health");
+			writer.write(object.health);
+			writer.endObject();
+		}
+		writer.endArray();
+		writer.endObject();
+		return output.toString();
+	}
+
+	/* what a level loader would read, the same values from either format */
+	auto readLevel(const vx::json::Document& document) noexcept -> std::uint64_t {
+		std::uint64_t sum {0u};
+		const vx::json::Value root {document.getRoot()};
+		for (const vx::json::Value tile : root[vx::StringSlice::from(u8"tiles")].getElements())
+			sum += static_cast<std::uint64_t> (tile.asInteger().value_or(0));
+		for (const vx::json::Value object : root[vx::StringSlice::from(u8"objects")].getElements()) {
+			sum += static_cast<std::uint64_t> (object[vx::StringSlice::from(u8"x")].asNumber().value_or(0.0));
+			sum += object[vx::StringSlice::from(u8"name")].asString().value_or(vx::containers::views::UncheckedStringSlice{}).getSize();
+			sum += static_cast<std::uint64_t> (object[vx::StringSlice::from(u8"health")].asInteger().value_or(0));
+		}
+		return sum;
+	}
+
+	auto readLevel(const vx::serial::Document<Level>& document) noexcept -> std::uint64_t {
+		std::uint64_t sum {0u};
+		const vx::serial::Table<Level> root {document.getRoot()};
+		for (const std::uint32_t tile : root.get<&Level::tiles> ())
+			sum += tile;
+		for (const vx::serial::Table<Object> object : root.get<&Level::objects> ()) {
+			sum += static_cast<std::uint64_t> (object.get<&Object::x> ());
+			sum += object.get<&Object::name> ().getSize();
+			sum += object.get<&Object::health> ();
+		}
+		return sum;
+	}
+}
+
+
+TEST_CASE("serial - benchmark", "[serial]") {
+	const Level level {makeLevel()};
+	const vx::String text {toJson(level)};
+	const std::optional<std::vector<std::byte>> bytes {vx::serial::serialize(level)};
+	REQUIRE(bytes);
+	/* aligned like a mapping of the file would be */
+	std::vector<std::uint64_t> aligned ((bytes->size() + 7uz) / 8uz);
+	std::memcpy(aligned.data(), bytes->data(), bytes->size());
+	const std::span<const std::byte> buffer {std::as_bytes(std::span{aligned}).first(bytes->size())};
+
+	const std::optional<vx::json::Document> json {vx::json::Document::parse(text.slice())};
+	const std::optional<vx::serial::Document<Level>> document {vx::serial::Document<Level>::fromBytes(buffer)};
+	REQUIRE(json);
+	REQUIRE(document);
+	REQUIRE(readLevel(*json) == readLevel(*document));
+
+	std::println(stderr, "Benchmarking the loading of a level, {} KB of JSON or {} KB serialized", text.getSize() / 1024uz, bytes->size() / 1024uz);
+
+	BENCHMARK("[serial] load json") {
+		return readLevel(*vx::json::Document::parse(text.slice()));
+	};
+
+	BENCHMARK("[serial] load") {
+		return readLevel(*vx::serial::Document<Level>::fromBytes(buffer));
+	};
+
+	BENCHMARK("[serial] load and unpack") {
+		return vx::serial::Document<Level>::fromBytes(buffer)->getRoot().unpack().objects.size();
+	};
+
+	BENCHMARK("[serial] write") {
+		return vx::serial::serialize(level)->size();
+	};
+}
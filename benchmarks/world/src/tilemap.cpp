@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <array>
+#include <print>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/render/spriteBatcher.hpp>
+#include <voxlet/world/tilemap.hpp>
+
+
+namespace {
+	/* a 1024x1024 world */
+	constexpr std::int32_t WORLD_SIZE {1024};
+
+	auto generateTile(const std::int32_t x, const std::int32_t y) noexcept -> vx::world::TileId {
+		return static_cast<vx::world::TileId> (static_cast<std::uint32_t> (x * 31 + y * 17) % 7u);
+	}
+
+	auto makeTilemap() noexcept -> vx::world::Tilemap {
+		vx::world::Tilemap tilemap {};
+		for (std::int32_t y {0}; y < WORLD_SIZE; ++y) {
+			for (std::int32_t x {0}; x < WORLD_SIZE; ++x)
+				tilemap.setTile(x, y, generateTile(x, y));
+		}
+		(void)tilemap.rebuildMeshes();
+		return tilemap;
+	}
+
+	/* the same world as a single row-major grid meshed as a whole, what the tilemap replaces */
+	struct FlatGrid {
+		std::vector<vx::world::TileId> tiles;
+		std::vector<vx::render::SpriteInstance> mesh;
+
+		auto rebuildMesh() noexcept -> void {
+			mesh.clear();
+			for (std::int32_t y {0}; y < WORLD_SIZE; ++y) {
+				for (std::int32_t x {0}; x < WORLD_SIZE; ++x) {
+					const vx::world::TileId tile {tiles[static_cast<std::size_t> (y * WORLD_SIZE + x)]};
+					if (tile == 0u)
+						continue;
+					const float u {static_cast<float> ((tile - 1u) % 16u) / 16.f};
+					const float v {static_cast<float> ((tile - 1u) / 16u) / 16.f};
+					mesh.push_back(vx::render::SpriteInstance{
+						{static_cast<float> (x) * 16.f, static_cast<float> (y) * 16.f, 16.f, 16.f},
+						{u, v, u + 1.f / 16.f, v + 1.f / 16.f},
+						0xffff'ffffu,
+						0.f
+					});
+				}
+			}
+		}
+	};
+
+	auto makeFlatGrid() noexcept -> FlatGrid {
+		FlatGrid grid {std::vector<vx::world::TileId> (static_cast<std::size_t> (WORLD_SIZE * WORLD_SIZE)), {}};
+		for (std::int32_t y {0}; y < WORLD_SIZE; ++y) {
+			for (std::int32_t x {0}; x < WORLD_SIZE; ++x)
+				grid.tiles[static_cast<std::size_t> (y * WORLD_SIZE + x)] = generateTile(x, y);
+		}
+		grid.rebuildMesh();
+		return grid;
+	}
+}
+
+
+TEST_CASE("tilemap-edit - benchmark", "[world]") {
+	const std::size_t editCount {GENERATE(10uz, 1000uz, 100'000uz)};
+
+	std::println(stderr, "Benchmarking {} tile edits per frame in a {}x{} world", editCount, WORLD_SIZE, WORLD_SIZE);
+
+	vx::jobs::Scheduler scheduler {};
+	vx::world::Tilemap tilemap {makeTilemap()};
+	FlatGrid grid {makeFlatGrid()};
+
+	/* edits are clustered around a cursor, like painting or digging */
+	std::mt19937 random {42u};
+	std::normal_distribution<float> spread {0.f, 40.f};
+	std::vector<std::array<std::int32_t, 2>> edits {};
+	for (std::size_t i {0uz}; i < editCount; ++i) {
+		edits.push_back({
+			std::clamp(WORLD_SIZE / 2 + static_cast<std::int32_t> (spread(random)), 0, WORLD_SIZE - 1),
+			std::clamp(WORLD_SIZE / 2 + static_cast<std::int32_t> (spread(random)), 0, WORLD_SIZE - 1)
+		});
+	}
+	vx::world::TileId value {1u};
+
+	BENCHMARK(std::format("[edit] row-major full rebuild - count={}", editCount)) {
+		value = static_cast<vx::world::TileId> (value % 6u + 1u);
+		for (const auto [x, y] : edits)
+			grid.tiles[static_cast<std::size_t> (y * WORLD_SIZE + x)] = value;
+		grid.rebuildMesh();
+		return grid.mesh.size();
+	};
+
+	BENCHMARK(std::format("[edit] dirty chunks - count={}", editCount)) {
+		value = static_cast<vx::world::TileId> (value % 6u + 1u);
+		for (const auto [x, y] : edits)
+			tilemap.setTile(x, y, value);
+		return tilemap.rebuildMeshes();
+	};
+
+	BENCHMARK(std::format("[edit] dirty chunks parallel - count={}", editCount)) {
+		value = static_cast<vx::world::TileId> (value % 6u + 1u);
+		for (const auto [x, y] : edits)
+			tilemap.setTile(x, y, value);
+		return tilemap.rebuildMeshes(scheduler);
+	};
+}
+
+
+TEST_CASE("tilemap-scroll - benchmark", "[world]") {
+	const std::uint32_t speed {GENERATE(1u, 8u, 32u)};
+	constexpr std::uint32_t VIEW_WIDTH {80u};
+	constexpr std::uint32_t VIEW_HEIGHT {45u};
+
+	std::println(stderr, "Benchmarking a {}x{} view scrolling {} tiles per frame", VIEW_WIDTH, VIEW_HEIGHT, speed);
+
+	vx::jobs::Scheduler scheduler {};
+	vx::world::Tilemap tilemap {};
+	/* the window benchmarks read the whole world, loaded up front */
+	const vx::world::Tilemap world {makeTilemap()};
+	FlatGrid grid {makeFlatGrid()};
+	const auto load {[](const vx::world::ChunkCoord coord, const std::span<vx::world::TileId, vx::world::CHUNK_AREA> tiles) noexcept {
+		for (std::uint32_t y {0u}; y < vx::world::CHUNK_SIZE; ++y) {
+			for (std::uint32_t x {0u}; x < vx::world::CHUNK_SIZE; ++x) {
+				tiles[y * vx::world::CHUNK_SIZE + x] = generateTile(
+					coord.x * static_cast<std::int32_t> (vx::world::CHUNK_SIZE) + static_cast<std::int32_t> (x),
+					coord.y * static_cast<std::int32_t> (vx::world::CHUNK_SIZE) + static_cast<std::int32_t> (y)
+				);
+			}
+		}
+	}};
+	const auto evict {[](vx::world::ChunkCoord, std::span<const vx::world::TileId, vx::world::CHUNK_AREA>) noexcept {}};
+
+	/* the camera pans diagonally, wrapping around the world */
+	std::int32_t position {0};
+	const auto nextView {[&position, speed]() noexcept {
+		position = (position + static_cast<std::int32_t> (speed)) % (WORLD_SIZE - static_cast<std::int32_t> (VIEW_WIDTH));
+		return vx::world::TileRect{position, position / 2, VIEW_WIDTH, VIEW_HEIGHT};
+	}};
+
+	BENCHMARK(std::format("[scroll] stream and rebuild - speed={}", speed)) {
+		const vx::world::StreamStats stats {tilemap.stream(nextView(), load, evict)};
+		(void)tilemap.rebuildMeshes(scheduler);
+		return stats.loadedCount;
+	};
+
+	/* visits every visible tile, as culling or picking would */
+	BENCHMARK(std::format("[window] row-major - speed={}", speed)) {
+		const vx::world::TileRect view {nextView()};
+		std::uint64_t sum {0u};
+		for (std::int32_t y {view.y}; y < view.y + static_cast<std::int32_t> (view.height); ++y) {
+			for (std::int32_t x {view.x}; x < view.x + static_cast<std::int32_t> (view.width); ++x)
+				sum += grid.tiles[static_cast<std::size_t> (y * WORLD_SIZE + x)];
+		}
+		return sum;
+	};
+
+	BENCHMARK(std::format("[window] tilemap - speed={}", speed)) {
+		std::uint64_t sum {0u};
+		world.forEachTile(nextView(), [&sum](std::int32_t, std::int32_t, const vx::world::TileId tile) noexcept {sum += tile;});
+		return sum;
+	};
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "voxlet/assets/atlasBuilder.hpp"
+#include "voxlet/containers/string.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/render/image.hpp"
+
+
+namespace vx::assets {
+	enum class AsepriteBlendMode : std::uint16_t {
+		normal,
+		multiply,
+		screen,
+		overlay,
+		darken,
+		lighten,
+		colorDodge,
+		colorBurn,
+		hardLight,
+		softLight,
+		difference,
+		exclusion,
+		hue,
+		saturation,
+		color,
+		luminosity,
+		addition,
+		subtract,
+		divide
+	};
+
+	enum class AsepriteDirection : std::uint8_t {
+		forward,
+		reverse,
+		pingPong,
+		pingPongReverse
+	};
+
+	struct AsepriteFrame {
+		/* the flattened image, shared by every frame that looks the same */
+		std::uint32_t image;
+		/* in milliseconds */
+		std::uint32_t duration;
+	};
+
+	struct AsepriteLayer {
+		vx::String name;
+		AsepriteBlendMode blendMode;
+		std::uint8_t opacity;
+		std::uint16_t childLevel;
+		/* hidden when a group it's in is hidden */
+		bool isVisible;
+		bool isGroup;
+	};
+
+	struct AsepriteTag {
+		vx::String name;
+		std::uint32_t from;
+		std::uint32_t to;
+		AsepriteDirection direction;
+		/* whole cycles played, a ping-pong one going there and back, zero to loop forever */
+		std::uint32_t repeat;
+	};
+
+	struct AsepriteSliceKey {
+		std::uint32_t frame;
+		std::int32_t x;
+		std::int32_t y;
+		std::uint32_t width;
+		std::uint32_t height;
+		/* nine-slice center relative to the slice, when the slice has one */
+		std::int32_t centerX;
+		std::int32_t centerY;
+		std::uint32_t centerWidth;
+		std::uint32_t centerHeight;
+		/* relative to the slice, when the slice has one */
+		std::int32_t pivotX;
+		std::int32_t pivotY;
+	};
+
+	struct AsepriteSlice {
+		vx::String name;
+		bool hasCenter;
+		bool hasPivot;
+		/* the slice from each key's frame until the next key */
+		std::vector<AsepriteSliceKey> keys;
+	};
+
+
+	/*
+	 * A sprite loaded from an `.aseprite` file: the visible layers of every frame are flattened, then frames
+	 * that look the same share one image so that a held pose or a loop that comes back takes one atlas
+	 * region. RGBA cels are composited straight from the file, the others are decoded into a buffer of their
+	 * layer that a linked cel, or one stored again with the same bytes, reuses in the next frames.
+	 * Layers are composited with every separable blend mode of Aseprite, the non-separable ones (hue,
+	 * saturation, color and luminosity) aren't supported and are drawn as normal. The visibility and opacity
+	 * of a group apply to its layers, which are composited onto the frame directly. Tilemap layers aren't
+	 * supported, their cels are skipped.
+	 */
+	class VOXLET_EXPORT Aseprite final {
+		public:
+			Aseprite(const Aseprite&) = delete;
+			auto operator=(const Aseprite&) -> Aseprite& = delete;
+			Aseprite(Aseprite&&) noexcept = default;
+			auto operator=(Aseprite&&) noexcept -> Aseprite& = default;
+			~Aseprite() = default;
+
+			[[nodiscard]]
+			static auto open(const vx::StringSlice& path) noexcept -> std::optional<Aseprite>;
+			[[nodiscard]]
+			static auto fromBytes(std::span<const std::byte> bytes) noexcept -> std::optional<Aseprite>;
+
+			/* `prefix_<image>`, the name `addToAtlas` gives to an image */
+			[[nodiscard]]
+			static auto getSpriteName(const vx::StringSlice& prefix, std::uint32_t image) noexcept -> vx::String;
+			/* adds every image under its sprite name, fails if one doesn't fit in a page */
+			auto addToAtlas(AtlasBuilder& builder, const vx::StringSlice& prefix) const noexcept -> bool;
+
+			[[nodiscard]]
+			auto findTag(const vx::StringSlice& name) const noexcept -> const AsepriteTag*;
+			/* the frame shown `time` milliseconds into the tag, its last one once every cycle has played */
+			[[nodiscard]]
+			auto getFrameAt(const AsepriteTag& tag, std::uint64_t time) const noexcept -> std::uint32_t;
+
+			[[nodiscard]]
+			constexpr auto getWidth() const noexcept -> std::uint32_t {return m_width;}
+			[[nodiscard]]
+			constexpr auto getHeight() const noexcept -> std::uint32_t {return m_height;}
+			[[nodiscard]]
+			constexpr auto getFrames() const noexcept -> std::span<const AsepriteFrame> {return m_frames;}
+			[[nodiscard]]
+			constexpr auto getImageCount() const noexcept -> std::uint32_t {return m_imageCount;}
+			/* RGBA8, red in the lowest byte, `width * height` pixels */
+			[[nodiscard]]
+			constexpr auto getImage(const std::uint32_t image) const noexcept -> std::span<const std::uint32_t> {
+				const std::size_t size {static_cast<std::size_t> (m_width) * m_height};
+				return std::span{m_pixels}.subspan(image * size, size);
+			}
+			[[nodiscard]]
+			constexpr auto getLayers() const noexcept -> std::span<const AsepriteLayer> {return m_layers;}
+			[[nodiscard]]
+			constexpr auto getTags() const noexcept -> std::span<const AsepriteTag> {return m_tags;}
+			[[nodiscard]]
+			constexpr auto getSlices() const noexcept -> std::span<const AsepriteSlice> {return m_slices;}
+			/* the palette of the last frame, opaque black past its colors */
+			[[nodiscard]]
+			constexpr auto getPalette() const noexcept -> const vx::render::Palette& {return m_palette;}
+
+		private:
+			Aseprite() noexcept = default;
+
+			std::uint32_t m_width {0u};
+			std::uint32_t m_height {0u};
+			std::uint32_t m_imageCount {0u};
+			std::vector<std::uint32_t> m_pixels {};
+			std::vector<AsepriteFrame> m_frames {};
+			std::vector<AsepriteLayer> m_layers {};
+			std::vector<AsepriteTag> m_tags {};
+			std::vector<AsepriteSlice> m_slices {};
+			vx::render::Palette m_palette {};
+	};
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/io/mappedFile.hpp"
+
+
+namespace vx::assets {
+	/*
+	 * Layout of an atlas file, in native byte order: the header, the pages, the entries sorted by hash, the
+	 * names, then the pixels of every page aligned to `ATLAS_PAGE_ALIGNMENT` so that they can be uploaded
+	 * straight from the mapping.
+	 */
+	constexpr std::uint32_t ATLAS_MAGIC {0x5441'5856u};
+	constexpr std::uint32_t ATLAS_VERSION {1u};
+	constexpr std::size_t ATLAS_PAGE_ALIGNMENT {4096uz};
+
+	struct AtlasHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t pageCount;
+		std::uint32_t entryCount;
+		std::uint64_t pagesOffset;
+		std::uint64_t entriesOffset;
+		std::uint64_t namesOffset;
+		std::uint64_t namesSize;
+	};
+
+	struct AtlasPage {
+		std::uint32_t width;
+		std::uint32_t height;
+		/* RGBA8 rows, red in the lowest byte */
+		std::uint64_t pixelsOffset;
+	};
+
+	struct AtlasEntry {
+		/* `hashName` of the name */
+		std::uint64_t hash;
+		std::uint32_t nameOffset;
+		std::uint32_t nameSize;
+		std::uint32_t page;
+		/* zero, keeps the entry free of padding bytes */
+		std::uint32_t reserved;
+		/* the trimmed pixels in the page, empty for a fully transparent sprite */
+		std::uint16_t x;
+		std::uint16_t y;
+		std::uint16_t width;
+		std::uint16_t height;
+		/* where the trimmed pixels sit in the sprite as it was added */
+		std::uint16_t offsetX;
+		std::uint16_t offsetY;
+		std::uint16_t sourceWidth;
+		std::uint16_t sourceHeight;
+		float uv[4];
+	};
+
+	static_assert(std::is_trivially_copyable_v<AtlasHeader> && sizeof(AtlasHeader) == 48uz);
+	static_assert(std::is_trivially_copyable_v<AtlasPage> && sizeof(AtlasPage) == 16uz);
+	static_assert(std::is_trivially_copyable_v<AtlasEntry> && sizeof(AtlasEntry) == 56uz);
+
+
+	/*
+	 * Read-only view of an atlas file written by `AtlasBuilder`. Loading only checks the header and the
+	 * page table, entries are used in place: a lookup is a binary search on the name hash.
+	 */
+	class VOXLET_EXPORT Atlas final {
+		public:
+			Atlas(const Atlas&) = delete;
+			auto operator=(const Atlas&) -> Atlas& = delete;
+			Atlas(Atlas&&) noexcept = default;
+			auto operator=(Atlas&&) noexcept -> Atlas& = default;
+			~Atlas() = default;
+
+			[[nodiscard]]
+			static auto open(const vx::StringSlice& path) noexcept -> std::optional<Atlas>;
+			/* `bytes` must outlive the atlas and be aligned to 8 bytes */
+			[[nodiscard]]
+			static auto fromBytes(std::span<const std::byte> bytes) noexcept -> std::optional<Atlas>;
+
+			[[nodiscard]]
+			auto find(const vx::StringSlice& name) const noexcept -> const AtlasEntry*;
+			[[nodiscard]]
+			auto getName(const AtlasEntry& entry) const noexcept -> vx::StringSlice;
+			[[nodiscard]]
+			auto getPagePixels(std::uint32_t page) const noexcept -> std::span<const std::uint32_t>;
+
+			[[nodiscard]]
+			constexpr auto getPages() const noexcept -> std::span<const AtlasPage> {return m_pages;}
+			[[nodiscard]]
+			constexpr auto getEntries() const noexcept -> std::span<const AtlasEntry> {return m_entries;}
+
+		private:
+			Atlas() noexcept = default;
+
+			vx::io::MappedFile m_file {};
+			std::span<const std::byte> m_bytes {};
+			std::span<const AtlasPage> m_pages {};
+			std::span<const AtlasEntry> m_entries {};
+			std::span<const char8_t> m_names {};
+	};
+}
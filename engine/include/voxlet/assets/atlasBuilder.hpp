@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "voxlet/assets/atlas.hpp"
+#include "voxlet/assets/maxRectsPacker.hpp"
+#include "voxlet/containers/string.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/render/image.hpp"
+
+
+namespace vx::assets {
+	/*
+	 * Offline side of `Atlas`: packs named sprites into pages with `MaxRectsPacker` after trimming their
+	 * transparent borders, and writes the atlas file.
+	 * Edits are incremental: a sprite replaced by one that still fits its rectangle is redrawn in place, a
+	 * bigger one only moves itself, and an unchanged one is left alone. Only the pages touched since
+	 * `clearDirtyPages` need to be uploaded or written again, and nothing is repacked as a whole until
+	 * `repack` is called.
+	 */
+	class VOXLET_EXPORT AtlasBuilder final {
+		public:
+			AtlasBuilder(const AtlasBuilder&) = delete;
+			auto operator=(const AtlasBuilder&) -> AtlasBuilder& = delete;
+			AtlasBuilder(AtlasBuilder&&) noexcept = default;
+			auto operator=(AtlasBuilder&&) noexcept -> AtlasBuilder& = default;
+
+			struct Config {
+				std::uint32_t pageWidth {2048u};
+				std::uint32_t pageHeight {2048u};
+				/* transparent pixels kept right and below each sprite, against bleeding when filtering */
+				std::uint32_t padding {1u};
+				bool trim {true};
+			};
+
+			AtlasBuilder() noexcept;
+			explicit AtlasBuilder(const Config& config) noexcept;
+			~AtlasBuilder() = default;
+
+			/* restores the sprites and their placement from a previous build, fails if the page sizes differ */
+			[[nodiscard]]
+			static auto restore(const Atlas& atlas, const Config& config) noexcept -> std::optional<AtlasBuilder>;
+
+			/*
+			 * Adds the sprite, or replaces the one with the same name. Fails if it doesn't fit in a page, or if
+			 * another sprite has a name with the same hash.
+			 */
+			auto set(const vx::StringSlice& name, const vx::render::Image& image) noexcept -> bool;
+			auto remove(const vx::StringSlice& name) noexcept -> bool;
+			/* packs every sprite again from scratch, biggest first */
+			auto repack() noexcept -> void;
+
+			[[nodiscard]]
+			auto write() const noexcept -> std::vector<std::byte>;
+
+			[[nodiscard]]
+			constexpr auto getPages() const noexcept -> std::span<const vx::render::Image> {return m_pageImages;}
+			[[nodiscard]]
+			auto isPageDirty(std::uint32_t page) const noexcept -> bool {return m_dirtyPages[page];}
+			auto clearDirtyPages() noexcept -> void;
+			[[nodiscard]]
+			constexpr auto getSpriteCount() const noexcept -> std::size_t {return m_sprites.size();}
+
+		private:
+			struct Sprite {
+				vx::String name;
+				std::uint64_t hash;
+				/* trimmed pixels */
+				vx::render::Image image;
+				std::uint32_t page;
+				PackedRect rect;
+				std::uint32_t offsetX;
+				std::uint32_t offsetY;
+				std::uint32_t sourceWidth;
+				std::uint32_t sourceHeight;
+			};
+
+			/* finds room for the sprite in any page, adding one if none has room, and draws it */
+			auto place(Sprite& sprite) noexcept -> void;
+			auto draw(const Sprite& sprite) noexcept -> void;
+			auto erase(const Sprite& sprite) noexcept -> void;
+			auto addPage() noexcept -> std::uint32_t;
+
+			Config m_config;
+			std::vector<Sprite> m_sprites;
+			std::unordered_map<std::uint64_t, std::size_t> m_spriteIndices;
+			std::vector<MaxRectsPacker> m_packers;
+			std::vector<vx::render::Image> m_pageImages;
+			std::vector<bool> m_dirtyPages;
+	};
+}
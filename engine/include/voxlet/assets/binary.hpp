@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "voxlet/memory.hpp"
+
+
+namespace vx::assets::internal {
+	/* `count` values of `T` at `offset` in a file read in place, `std::nullopt` if misaligned or out of it */
+	template <typename T>
+	[[nodiscard]]
+	auto getArray(const std::span<const std::byte> bytes, const std::uint64_t offset, const std::uint64_t count) noexcept
+		-> std::optional<std::span<const T>>
+	{
+		if (offset % alignof(T) != 0u || offset > bytes.size() || count > (bytes.size() - offset) / sizeof(T))
+			return std::nullopt;
+		return std::span{reinterpret_cast<const T*> (bytes.data() + offset), static_cast<std::size_t> (count)};
+	}
+
+	/* copies `size` bytes of `data` to `offset` in a file being written, sized for them already */
+	inline auto writeBytes(const std::span<std::byte> bytes, const std::uint64_t offset, const void* const data, const std::size_t size)
+		noexcept -> void
+	{
+		if (size != 0uz)
+			vx::memory::memcpy(bytes.data() + offset, static_cast<const std::byte*> (data), size);
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+#include "voxlet/containers/views/stringSlice.hpp"
+
+
+namespace vx::assets {
+	/* 64-bit FNV-1a of the UTF-8 bytes, the key of names in the binary asset indices */
+	[[nodiscard]]
+	constexpr auto hashName(const vx::StringSlice& name) noexcept -> std::uint64_t {
+		std::uint64_t hash {0xcbf2'9ce4'8422'2325u};
+		for (const char8_t character : name) {
+			hash ^= static_cast<std::uint8_t> (character);
+			hash *= 0x0000'0100'0000'01b3u;
+		}
+		return hash;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::assets {
+	struct PackedRect {
+		std::uint32_t x;
+		std::uint32_t y;
+		std::uint32_t width;
+		std::uint32_t height;
+
+		constexpr auto operator==(const PackedRect&) const noexcept -> bool = default;
+	};
+
+	/*
+	 * Rectangle packer keeping the maximal free rectangles of its area. A rectangle goes to the free
+	 * rectangle it fits best by its shorter leftover side, then every free rectangle it overlaps is split
+	 * around it. A released rectangle is joined with the free rectangles around it into the largest ones
+	 * that cover it, so that the space freed by neighbours is whole again instead of fragmenting the area.
+	 */
+	class VOXLET_EXPORT MaxRectsPacker final {
+		public:
+			MaxRectsPacker(std::uint32_t width, std::uint32_t height) noexcept;
+			~MaxRectsPacker() = default;
+			MaxRectsPacker(const MaxRectsPacker&) = default;
+			auto operator=(const MaxRectsPacker&) -> MaxRectsPacker& = default;
+			MaxRectsPacker(MaxRectsPacker&&) noexcept = default;
+			auto operator=(MaxRectsPacker&&) noexcept -> MaxRectsPacker& = default;
+
+			[[nodiscard]]
+			auto insert(std::uint32_t width, std::uint32_t height) noexcept -> std::optional<PackedRect>;
+			/* marks a rectangle chosen elsewhere as used, e.g. to restore a previous packing */
+			auto occupy(const PackedRect& rect) noexcept -> void;
+			auto release(const PackedRect& rect) noexcept -> void;
+			auto clear() noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getWidth() const noexcept -> std::uint32_t {return m_width;}
+			[[nodiscard]]
+			constexpr auto getHeight() const noexcept -> std::uint32_t {return m_height;}
+			[[nodiscard]]
+			constexpr auto getUsedArea() const noexcept -> std::uint64_t {return m_usedArea;}
+			[[nodiscard]]
+			constexpr auto getFreeRects() const noexcept -> std::span<const PackedRect> {return m_freeRects;}
+
+		private:
+			auto split(const PackedRect& used) noexcept -> void;
+			/* adds every free rectangle made by joining `released` with the free ones, directly or in turn */
+			auto merge(const PackedRect& released) noexcept -> void;
+			/* drops the free rectangles contained in another one */
+			auto prune() noexcept -> void;
+
+			std::uint32_t m_width;
+			std::uint32_t m_height;
+			std::uint64_t m_usedArea;
+			std::vector<PackedRect> m_freeRects;
+	};
+}
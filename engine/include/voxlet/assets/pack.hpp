@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/io/mappedFile.hpp"
+
+
+namespace vx::assets {
+	/*
+	 * Layout of a pack file, in native byte order: the header, the entries sorted by hash, the paths, then
+	 * every blob aligned to `PACK_BLOB_ALIGNMENT` so that each one starts on its own page of the mapping.
+	 */
+	constexpr std::uint32_t PACK_MAGIC {0x4b50'5856u};
+	constexpr std::uint32_t PACK_VERSION {1u};
+	constexpr std::size_t PACK_BLOB_ALIGNMENT {4096uz};
+
+	enum class PackCompression : std::uint32_t {
+		none,
+		/* a `vx::compression` LZ frame */
+		lz
+	};
+
+	struct PackHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t entryCount;
+		std::uint32_t reserved;
+		std::uint64_t entriesOffset;
+		std::uint64_t pathsOffset;
+		std::uint64_t pathsSize;
+	};
+
+	struct PackEntry {
+		/* `hashName` of the path */
+		std::uint64_t hash;
+		std::uint32_t pathOffset;
+		std::uint32_t pathSize;
+		PackCompression compression;
+		/* zero, keeps the entry free of padding bytes */
+		std::uint32_t reserved;
+		/* the blob as stored */
+		std::uint64_t offset;
+		std::uint64_t size;
+		/* the blob once decompressed, equal to `size` when it isn't compressed */
+		std::uint64_t uncompressedSize;
+	};
+
+	static_assert(std::is_trivially_copyable_v<PackHeader> && sizeof(PackHeader) == 40uz);
+	static_assert(std::is_trivially_copyable_v<PackEntry> && sizeof(PackEntry) == 48uz);
+
+
+	/*
+	 * Read-only view of a pack file written by `PackBuilder`, standing in for a directory of loose files
+	 * with one `open` for all of them. Loading only checks the header and the blob bounds, entries are
+	 * used in place: a lookup is a binary search on the path hash, and an uncompressed blob is read
+	 * straight from the mapping.
+	 */
+	class VOXLET_EXPORT Pack final {
+		public:
+			Pack(const Pack&) = delete;
+			auto operator=(const Pack&) -> Pack& = delete;
+			Pack(Pack&&) noexcept = default;
+			auto operator=(Pack&&) noexcept -> Pack& = default;
+			~Pack() = default;
+
+			[[nodiscard]]
+			static auto open(const vx::StringSlice& path) noexcept -> std::optional<Pack>;
+			/* `bytes` must outlive the pack and be aligned to 8 bytes */
+			[[nodiscard]]
+			static auto fromBytes(std::span<const std::byte> bytes) noexcept -> std::optional<Pack>;
+
+			[[nodiscard]]
+			auto find(const vx::StringSlice& path) const noexcept -> const PackEntry*;
+			[[nodiscard]]
+			auto getPath(const PackEntry& entry) const noexcept -> vx::StringSlice;
+			/* the blob as stored, the content itself when `entry.compression` is `none` */
+			[[nodiscard]]
+			auto getBlob(const PackEntry& entry) const noexcept -> std::span<const std::byte>;
+			/* writes the content of the blob to `output`, of `entry.uncompressedSize` bytes */
+			[[nodiscard]]
+			auto read(const PackEntry& entry, std::span<std::byte> output) const noexcept -> bool;
+			/* starts reading the blob from disk in the background, no-op for a pack built from bytes */
+			auto prefetch(const PackEntry& entry) const noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getEntries() const noexcept -> std::span<const PackEntry> {return m_entries;}
+
+		private:
+			Pack() noexcept = default;
+
+			vx::io::MappedFile m_file {};
+			std::span<const std::byte> m_bytes {};
+			std::span<const PackEntry> m_entries {};
+			std::span<const char8_t> m_paths {};
+	};
+}
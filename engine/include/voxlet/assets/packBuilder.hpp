@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include "voxlet/assets/pack.hpp"
+#include "voxlet/containers/string.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+
+
+namespace vx::assets {
+	/* Offline side of `Pack`: collects blobs by path and writes the pack file. */
+	class VOXLET_EXPORT PackBuilder final {
+		public:
+			PackBuilder(const PackBuilder&) = delete;
+			auto operator=(const PackBuilder&) -> PackBuilder& = delete;
+			PackBuilder(PackBuilder&&) noexcept = default;
+			auto operator=(PackBuilder&&) noexcept -> PackBuilder& = default;
+
+			PackBuilder() noexcept = default;
+			~PackBuilder() = default;
+
+			/*
+			 * copies the content, compressed if that makes it smaller, fails if the path or another one with the
+			 * same hash is already in the pack
+			 */
+			auto add(const vx::StringSlice& path, std::span<const std::byte> content, PackCompression compression) noexcept
+				-> bool;
+
+			[[nodiscard]]
+			auto write() const noexcept -> std::vector<std::byte>;
+
+			[[nodiscard]]
+			constexpr auto getBlobCount() const noexcept -> std::size_t {return m_blobs.size();}
+
+		private:
+			struct Blob {
+				vx::String path;
+				std::uint64_t hash;
+				PackCompression compression;
+				/* as stored */
+				std::vector<std::byte> data;
+				std::uint64_t uncompressedSize;
+			};
+
+			std::vector<Blob> m_blobs {};
+			std::unordered_set<std::uint64_t> m_hashes {};
+	};
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+
+
+namespace vx::async {
+	/*
+	 * Manual-reset event which coroutines can `co_await`. Completion sources (file I/O, network, ...) call
+	 * `set`, which resumes every waiter either inline or as scheduler jobs.
+	 */
+	class VOXLET_EXPORT Event final {
+		public:
+			Event(const Event&) = delete;
+			auto operator=(const Event&) -> Event& = delete;
+			Event(Event&&) = delete;
+			auto operator=(Event&&) -> Event& = delete;
+
+			class Awaiter final {
+				friend class Event;
+
+				public:
+					constexpr explicit Awaiter(const Event& event) noexcept : m_event {&event}, m_next {nullptr}, m_handle {} {}
+
+					[[nodiscard]]
+					auto await_ready() const noexcept -> bool {return m_event->isSet();}
+					[[nodiscard]]
+					auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool;
+					constexpr auto await_resume() const noexcept -> void {}
+
+				private:
+					const Event* m_event;
+					Awaiter* m_next;
+					std::coroutine_handle<> m_handle;
+			};
+
+			explicit Event(bool isSet = false) noexcept;
+			~Event() = default;
+
+			auto set() noexcept -> void;
+			auto set(vx::jobs::Scheduler& scheduler) noexcept -> void;
+			auto reset() noexcept -> void;
+			[[nodiscard]]
+			auto isSet() const noexcept -> bool;
+
+			[[nodiscard]]
+			auto operator co_await() const noexcept -> Awaiter {return Awaiter{*this};}
+
+		private:
+			[[nodiscard]]
+			auto takeWaiters() noexcept -> Awaiter*;
+
+			// `this` when set, otherwise the head of the intrusive list of waiters
+			mutable std::atomic<void*> m_state;
+	};
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <coroutine>
+#include <type_traits>
+
+#include "voxlet/async/task.hpp"
+#include "voxlet/jobs/counter.hpp"
+#include "voxlet/jobs/job.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+
+
+namespace vx::async {
+	namespace internal {
+		/*
+		 * Eagerly started, fire-and-forget coroutine which destroys itself once its body completes. Used to
+		 * drive tasks from non-coroutine code and by the combinators.
+		 */
+		struct DetachedTask final {
+			struct promise_type final : PooledPromise {
+				constexpr auto get_return_object() const noexcept -> DetachedTask {return {};}
+				constexpr auto initial_suspend() const noexcept -> std::suspend_never {return {};}
+				constexpr auto final_suspend() const noexcept -> std::suspend_never {return {};}
+				constexpr auto return_void() const noexcept -> void {}
+				[[noreturn]]
+				auto unhandled_exception() const noexcept -> void {std::terminate();}
+			};
+		};
+
+		[[nodiscard]]
+		inline auto makeResumeJob(const std::coroutine_handle<> handle, vx::jobs::Counter* counter = nullptr)
+			noexcept
+			-> vx::jobs::Job
+		{
+			return vx::jobs::Job{
+				.function = [](void* const data) noexcept {std::coroutine_handle<>::from_address(data).resume();},
+				.data = handle.address(),
+				.counter = counter
+			};
+		}
+	}
+
+
+	class ScheduleAwaiter final {
+		public:
+			constexpr explicit ScheduleAwaiter(vx::jobs::Scheduler& scheduler) noexcept : m_scheduler {&scheduler} {}
+
+			[[nodiscard]]
+			constexpr auto await_ready() const noexcept -> bool {return false;}
+			auto await_suspend(const std::coroutine_handle<> handle) const noexcept -> void {
+				m_scheduler->submit(internal::makeResumeJob(handle));
+			}
+			constexpr auto await_resume() const noexcept -> void {}
+
+		private:
+			vx::jobs::Scheduler* m_scheduler;
+	};
+
+	/*
+	 * `co_await vx::async::schedule(scheduler)` resumes the current coroutine on one of the scheduler threads.
+	 */
+	[[nodiscard]]
+	constexpr auto schedule(vx::jobs::Scheduler& scheduler) noexcept -> ScheduleAwaiter {
+		return ScheduleAwaiter{scheduler};
+	}
+
+	/*
+	 * Starts `task` on the calling thread without waiting for it. The task frame is destroyed on completion.
+	 */
+	auto spawn(Task<void>&& task) noexcept -> void;
+
+	/*
+	 * Starts `task` on the calling thread and blocks until it completes, running scheduler jobs meanwhile.
+	 */
+	template <typename T>
+	auto syncWait(vx::jobs::Scheduler& scheduler, Task<T>&& task) noexcept -> T;
+}
+
+#include "voxlet/async/executor.inl"
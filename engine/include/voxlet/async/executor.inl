@@ -0,0 +1,49 @@
+#pragma once
+
+#include "voxlet/async/executor.hpp"
+
+#include <optional>
+#include <utility>
+
+
+namespace vx::async {
+	namespace internal {
+		template <typename T>
+		auto runAndSignal(Task<T> task, std::optional<TaskResult<T>>& result, vx::jobs::Counter& counter) noexcept
+			-> DetachedTask
+		{
+			result.emplace(co_await std::move(task));
+			counter.decrement();
+		}
+
+		inline auto runAndSignal(Task<void> task, vx::jobs::Counter& counter) noexcept -> DetachedTask {
+			co_await std::move(task);
+			counter.decrement();
+		}
+
+		inline auto runDetached(Task<void> task) noexcept -> DetachedTask {
+			co_await std::move(task);
+		}
+	}
+
+
+	inline auto spawn(Task<void>&& task) noexcept -> void {
+		(void)internal::runDetached(std::move(task));
+	}
+
+
+	template <typename T>
+	auto syncWait(vx::jobs::Scheduler& scheduler, Task<T>&& task) noexcept -> T {
+		vx::jobs::Counter counter {1uz};
+		if constexpr (std::is_void_v<T>) {
+			(void)internal::runAndSignal(std::move(task), counter);
+			scheduler.wait(counter);
+		}
+		else {
+			std::optional<internal::TaskResult<T>> result {};
+			(void)internal::runAndSignal(std::move(task), result, counter);
+			scheduler.wait(counter);
+			return std::move(*result);
+		}
+	}
+}
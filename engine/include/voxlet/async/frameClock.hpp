@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+
+
+namespace vx::async {
+	/*
+	 * `co_await clock.nextFrame()` suspends the coroutine until the next call to `tick`, which the main loop
+	 * issues at every frame boundary.
+	 */
+	class VOXLET_EXPORT FrameClock final {
+		public:
+			FrameClock(const FrameClock&) = delete;
+			auto operator=(const FrameClock&) -> FrameClock& = delete;
+			FrameClock(FrameClock&&) = delete;
+			auto operator=(FrameClock&&) -> FrameClock& = delete;
+
+			class Awaiter final {
+				public:
+					constexpr explicit Awaiter(FrameClock& clock) noexcept : m_clock {&clock} {}
+
+					[[nodiscard]]
+					constexpr auto await_ready() const noexcept -> bool {return false;}
+					auto await_suspend(std::coroutine_handle<> handle) const noexcept -> void;
+					[[nodiscard]]
+					auto await_resume() const noexcept -> std::uint64_t;
+
+				private:
+					FrameClock* m_clock;
+			};
+
+			FrameClock() noexcept;
+			~FrameClock() = default;
+
+			[[nodiscard]]
+			auto nextFrame() noexcept -> Awaiter {return Awaiter{*this};}
+
+			auto tick() noexcept -> void;
+			auto tick(vx::jobs::Scheduler& scheduler) noexcept -> void;
+
+			[[nodiscard]]
+			auto getFrameIndex() const noexcept -> std::uint64_t;
+			[[nodiscard]]
+			auto getWaiterCount() const noexcept -> std::size_t;
+
+		private:
+			auto takeWaiters() noexcept -> void;
+
+			mutable std::mutex m_mutex;
+			std::vector<std::coroutine_handle<>> m_waiters;
+			std::vector<std::coroutine_handle<>> m_resumed;
+			std::atomic<std::uint64_t> m_frameIndex;
+	};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::async {
+	/*
+	 * Size-classed pool backing coroutine frames. Every thread keeps its own free lists, which are refilled
+	 * by slabs of blocks, so steady-state frame allocation never reaches the system allocator. A block freed
+	 * by another thread than the one owning its slab is sent back to the owner, and the lists of a thread that
+	 * exits are taken over by the next one started. Frames bigger than `MAX_BLOCK_SIZE` fall back to
+	 * `::operator new`.
+	 */
+	class VOXLET_EXPORT FramePool final {
+		public:
+			FramePool() = delete;
+
+			static constexpr std::size_t BLOCK_GRANULARITY {64uz};
+			static constexpr std::size_t MAX_BLOCK_SIZE {4096uz};
+			static constexpr std::size_t SIZE_CLASS_COUNT {MAX_BLOCK_SIZE / BLOCK_GRANULARITY};
+			static constexpr std::size_t SLAB_SIZE {64uz * 1024uz};
+
+			[[nodiscard]]
+			static auto allocate(std::size_t size) noexcept -> void*;
+			static auto deallocate(void* ptr, std::size_t size) noexcept -> void;
+
+			[[nodiscard]]
+			static auto getSlabCount() noexcept -> std::size_t;
+
+			[[nodiscard]]
+			static constexpr auto getSizeClass(std::size_t size) noexcept -> std::size_t {
+				return (size + BLOCK_GRANULARITY - 1uz) / BLOCK_GRANULARITY - 1uz;
+			}
+	};
+}
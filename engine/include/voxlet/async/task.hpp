@@ -0,0 +1,121 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "voxlet/async/framePool.hpp"
+
+
+namespace vx::async {
+	template <typename T = void>
+	class Task;
+
+	namespace internal {
+		struct PooledPromise {
+			[[nodiscard]]
+			static auto operator new(const std::size_t size) -> void* {return FramePool::allocate(size);}
+			static auto operator delete(void* const ptr, const std::size_t size) noexcept -> void {
+				FramePool::deallocate(ptr, size);
+			}
+		};
+
+		/* a reference result is held by a `std::reference_wrapper`, which unlike the reference fits in an optional */
+		template <typename T>
+		using TaskResult = std::conditional_t<
+			std::is_lvalue_reference_v<T>,
+			std::reference_wrapper<std::remove_reference_t<T>>,
+			T
+		>;
+
+		template <typename T>
+		struct TaskPromiseBase : PooledPromise {
+			struct FinalAwaiter {
+				[[nodiscard]]
+				constexpr auto await_ready() const noexcept -> bool {return false;}
+				template <typename Promise>
+				[[nodiscard]]
+				auto await_suspend(std::coroutine_handle<Promise> handle) const noexcept -> std::coroutine_handle<> {
+					const std::coroutine_handle<> continuation {handle.promise().continuation};
+					if (!continuation)
+						return std::noop_coroutine();
+					return continuation;
+				}
+				constexpr auto await_resume() const noexcept -> void {}
+			};
+
+			[[nodiscard]]
+			constexpr auto initial_suspend() const noexcept -> std::suspend_always {return {};}
+			[[nodiscard]]
+			constexpr auto final_suspend() const noexcept -> FinalAwaiter {return {};}
+			[[noreturn]]
+			auto unhandled_exception() const noexcept -> void {std::terminate();}
+
+			std::coroutine_handle<> continuation {};
+		};
+
+		template <typename T>
+		struct TaskPromise final : TaskPromiseBase<T> {
+			[[nodiscard]]
+			auto get_return_object() noexcept -> Task<T>;
+			template <typename U>
+			requires std::is_convertible_v<U&&, T>
+			auto return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>) -> void {
+				result.emplace(std::forward<U> (value));
+			}
+
+			std::optional<TaskResult<T>> result {};
+		};
+
+		template <>
+		struct TaskPromise<void> final : TaskPromiseBase<void> {
+			[[nodiscard]]
+			auto get_return_object() noexcept -> Task<void>;
+			constexpr auto return_void() const noexcept -> void {}
+		};
+	}
+
+
+	/*
+	 * Lazily started coroutine: the body only runs once the task is awaited, and the awaiter is resumed
+	 * through symmetric transfer when the body completes. Frames are allocated from `FramePool`.
+	 */
+	template <typename T>
+	class [[nodiscard]] Task final {
+		public:
+			Task(const Task&) = delete;
+			auto operator=(const Task&) -> Task& = delete;
+
+			using promise_type = internal::TaskPromise<T>;
+			using Handle = std::coroutine_handle<promise_type>;
+			using value_type = T;
+
+			constexpr Task() noexcept = default;
+			constexpr ~Task();
+			constexpr Task(Task&& other) noexcept;
+			constexpr auto operator=(Task&& other) noexcept -> Task&;
+
+			[[nodiscard]]
+			auto isValid() const noexcept -> bool;
+			[[nodiscard]]
+			auto isDone() const noexcept -> bool;
+
+			[[nodiscard]]
+			auto operator co_await() && noexcept;
+
+			[[nodiscard]]
+			auto release() noexcept -> Handle;
+
+		private:
+			friend promise_type;
+			constexpr explicit Task(Handle handle) noexcept;
+
+			Handle m_handle {};
+	};
+}
+
+#include "voxlet/async/task.inl"
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "voxlet/async/task.hpp"
+
+#include <cassert>
+
+
+namespace vx::async {
+	namespace internal {
+		template <typename T>
+		auto TaskPromise<T>::get_return_object() noexcept -> Task<T> {
+			return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+		}
+
+		inline auto TaskPromise<void>::get_return_object() noexcept -> Task<void> {
+			return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+		}
+	}
+
+
+	template <typename T>
+	constexpr Task<T>::~Task() {
+		if (m_handle)
+			m_handle.destroy();
+	}
+
+	template <typename T>
+	constexpr Task<T>::Task(Task&& other) noexcept :
+		m_handle {std::exchange(other.m_handle, nullptr)}
+	{}
+
+	template <typename T>
+	constexpr auto Task<T>::operator=(Task&& other) noexcept -> Task& {
+		if (this == &other)
+			return *this;
+		if (m_handle)
+			m_handle.destroy();
+		m_handle = std::exchange(other.m_handle, nullptr);
+		return *this;
+	}
+
+
+	template <typename T>
+	auto Task<T>::isValid() const noexcept -> bool {
+		return !!m_handle;
+	}
+
+	template <typename T>
+	auto Task<T>::isDone() const noexcept -> bool {
+		return !m_handle || m_handle.done();
+	}
+
+
+	template <typename T>
+	auto Task<T>::operator co_await() && noexcept {
+		struct Awaiter {
+			Handle handle;
+
+			[[nodiscard]]
+			auto await_ready() const noexcept -> bool {return !handle || handle.done();}
+			[[nodiscard]]
+			auto await_suspend(const std::coroutine_handle<> awaiter) const noexcept -> std::coroutine_handle<> {
+				handle.promise().continuation = awaiter;
+				return handle;
+			}
+			auto await_resume() const noexcept -> T {
+				assert(handle && handle.done());
+				if constexpr (!std::is_void_v<T>) {
+					assert(handle.promise().result.has_value());
+					return std::move(*handle.promise().result);
+				}
+			}
+		};
+		return Awaiter{m_handle};
+	}
+
+
+	template <typename T>
+	auto Task<T>::release() noexcept -> Handle {
+		return std::exchange(m_handle, nullptr);
+	}
+
+
+	template <typename T>
+	constexpr Task<T>::Task(Handle handle) noexcept :
+		m_handle {handle}
+	{}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "voxlet/async/executor.hpp"
+#include "voxlet/async/task.hpp"
+
+
+namespace vx::async {
+	template <typename T>
+	using NonVoid = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+	template <typename T>
+	struct WhenAnyResult {
+		std::size_t index;
+		NonVoid<T> value;
+	};
+
+	/*
+	 * Every task is started at once, and the awaiting coroutine is resumed by the thread completing the
+	 * last one. `void` results are reported as `std::monostate`.
+	 */
+	template <typename ...Ts>
+	auto whenAll(Task<Ts> ...tasks) noexcept -> Task<std::tuple<NonVoid<Ts>...>>;
+	template <typename T>
+	auto whenAll(std::vector<Task<T>> tasks) noexcept -> Task<std::vector<NonVoid<T>>>;
+
+	/*
+	 * Resumes the awaiting coroutine as soon as one task completes. The others keep running to completion
+	 * in the background and their results are dropped.
+	 */
+	template <typename T>
+	auto whenAny(std::vector<Task<T>> tasks) noexcept -> Task<WhenAnyResult<T>>;
+}
+
+#include "voxlet/async/whenAll.inl"
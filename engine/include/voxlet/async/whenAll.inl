@@ -0,0 +1,152 @@
+#pragma once
+
+#include "voxlet/async/whenAll.hpp"
+
+#include <cassert>
+#include <utility>
+
+
+namespace vx::async {
+	namespace internal {
+		/*
+		 * Starts at `count + 1`: the extra arrival belongs to the awaiting coroutine, so that a task completing
+		 * while the others are still being started cannot resume it too early.
+		 */
+		class Latch final {
+			public:
+				constexpr explicit Latch(const std::size_t count) noexcept : m_count {count + 1uz}, m_continuation {} {}
+
+				auto arrive() noexcept -> void {
+					if (m_count.fetch_sub(1uz, std::memory_order::acq_rel) == 1uz)
+						m_continuation.resume();
+				}
+
+				[[nodiscard]]
+				auto suspend(const std::coroutine_handle<> continuation) noexcept -> bool {
+					m_continuation = continuation;
+					return m_count.fetch_sub(1uz, std::memory_order::acq_rel) != 1uz;
+				}
+
+			private:
+				std::atomic<std::size_t> m_count;
+				std::coroutine_handle<> m_continuation;
+		};
+
+		template <typename Launch>
+		struct LatchAwaiter {
+			Latch& latch;
+			Launch launch;
+
+			[[nodiscard]]
+			constexpr auto await_ready() const noexcept -> bool {return false;}
+			[[nodiscard]]
+			auto await_suspend(const std::coroutine_handle<> handle) noexcept -> bool {
+				launch();
+				return latch.suspend(handle);
+			}
+			constexpr auto await_resume() const noexcept -> void {}
+		};
+
+		template <typename T>
+		auto runAndArrive(Task<T> task, std::optional<NonVoid<T>>& result, Latch& latch) noexcept -> DetachedTask {
+			if constexpr (std::is_void_v<T>) {
+				co_await std::move(task);
+				result.emplace();
+			}
+			else
+				result.emplace(co_await std::move(task));
+			latch.arrive();
+		}
+
+
+		template <typename T>
+		struct WhenAnyState {
+			std::atomic<bool> hasWinner {false};
+			std::atomic<std::size_t> pending {2uz};
+			std::coroutine_handle<> continuation {};
+			std::optional<WhenAnyResult<T>> result {};
+		};
+
+		template <typename T>
+		auto runAndRace(Task<T> task, const std::size_t index, std::shared_ptr<WhenAnyState<T>> state)
+			noexcept
+			-> DetachedTask
+		{
+			std::optional<NonVoid<T>> value {};
+			if constexpr (std::is_void_v<T>) {
+				co_await std::move(task);
+				value.emplace();
+			}
+			else
+				value.emplace(co_await std::move(task));
+
+			if (state->hasWinner.exchange(true, std::memory_order::acq_rel))
+				co_return;
+			state->result.emplace(WhenAnyResult<T> {index, std::move(*value)});
+			if (state->pending.fetch_sub(1uz, std::memory_order::acq_rel) == 1uz)
+				state->continuation.resume();
+		}
+	}
+
+
+	template <typename ...Ts>
+	auto whenAll(Task<Ts> ...tasks) noexcept -> Task<std::tuple<NonVoid<Ts>...>> {
+		internal::Latch latch {sizeof...(Ts)};
+		std::tuple<std::optional<NonVoid<Ts>>...> results {};
+		std::tuple<Task<Ts>&...> taskReferences {tasks...};
+
+		const auto launch {[&]() noexcept {
+			[&]<std::size_t ...I>(std::index_sequence<I...>) noexcept {
+				((void)internal::runAndArrive(std::move(std::get<I> (taskReferences)), std::get<I> (results), latch), ...);
+			}(std::index_sequence_for<Ts...> {});
+		}};
+		co_await internal::LatchAwaiter<decltype(launch)> {latch, launch};
+
+		co_return [&]<std::size_t ...I>(std::index_sequence<I...>) noexcept {
+			return std::tuple<NonVoid<Ts>...> {std::move(*std::get<I> (results))...};
+		}(std::index_sequence_for<Ts...> {});
+	}
+
+	template <typename T>
+	auto whenAll(std::vector<Task<T>> tasks) noexcept -> Task<std::vector<NonVoid<T>>> {
+		internal::Latch latch {tasks.size()};
+		std::vector<std::optional<NonVoid<T>>> results(tasks.size());
+
+		const auto launch {[&]() noexcept {
+			for (std::size_t i {0uz}; i < tasks.size(); ++i)
+				(void)internal::runAndArrive(std::move(tasks[i]), results[i], latch);
+		}};
+		co_await internal::LatchAwaiter<decltype(launch)> {latch, launch};
+
+		std::vector<NonVoid<T>> values {};
+		values.reserve(results.size());
+		for (std::optional<NonVoid<T>>& result : results)
+			values.push_back(std::move(*result));
+		co_return values;
+	}
+
+	template <typename T>
+	auto whenAny(std::vector<Task<T>> tasks) noexcept -> Task<WhenAnyResult<T>> {
+		assert(!tasks.empty());
+		const auto state {std::make_shared<internal::WhenAnyState<T>> ()};
+
+		struct Awaiter {
+			std::vector<Task<T>>& tasks;
+			const std::shared_ptr<internal::WhenAnyState<T>>& state;
+
+			[[nodiscard]]
+			constexpr auto await_ready() const noexcept -> bool {return false;}
+			[[nodiscard]]
+			auto await_suspend(const std::coroutine_handle<> handle) noexcept -> bool {
+				state->continuation = handle;
+				for (std::size_t i {0uz}; i < tasks.size(); ++i)
+					(void)internal::runAndRace(std::move(tasks[i]), i, state);
+				return state->pending.fetch_sub(1uz, std::memory_order::acq_rel) != 1uz;
+			}
+			constexpr auto await_resume() const noexcept -> void {}
+		};
+		co_await Awaiter{tasks, state};
+
+		co_return std::move(*state->result);
+	}
+}
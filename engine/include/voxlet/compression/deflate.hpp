@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "voxlet/export.hpp"
+
+
+/*
+ * DEFLATE (RFC 1951) and its zlib wrapper (RFC 1950), the compression of PNG and Aseprite files.
+ * Decoding looks up 12 bits of the literal/length code at once, one lookup yields two literals when both
+ * codes fit in it, and the rare longer codes are decoded canonically. Matches are copied in 32-byte strides
+ * whenever the output has room to be overwritten, and every length and distance is validated so that
+ * decoding is safe on any input.
+ */
+namespace vx::compression {
+	enum class DeflateFormat {
+		raw,
+		/* a two bytes header, the raw stream, then the big-endian Adler-32 of the content */
+		zlib
+	};
+
+	[[nodiscard]]
+	VOXLET_EXPORT auto adler32(std::span<const std::byte> bytes, std::uint32_t checksum = 1u) noexcept -> std::uint32_t;
+	/* the CRC-32 of gzip and PNG, `checksum` being the one of the bytes before */
+	[[nodiscard]]
+	VOXLET_EXPORT auto crc32(std::span<const std::byte> bytes, std::uint32_t checksum = 0u) noexcept -> std::uint32_t;
+
+	/*
+	 * Greedy single-probe encoder writing a dynamic Huffman block per 64 KB of input, or a stored one when
+	 * that's smaller. Meant for tools and tests rather than for the best ratio.
+	 */
+	[[nodiscard]]
+	VOXLET_EXPORT auto deflate(std::span<const std::byte> input, DeflateFormat format) noexcept -> std::vector<std::byte>;
+	/* returns the size written, `nullopt` if the stream is malformed or doesn't fit in `output` */
+	[[nodiscard]]
+	VOXLET_EXPORT auto inflate(std::span<const std::byte> input, std::span<std::byte> output, DeflateFormat format) noexcept
+		-> std::optional<std::size_t>;
+
+
+	namespace internal {
+		struct InflateState;
+	}
+
+	/*
+	 * Decodes a stream whose size isn't known up front into buffers of the caller, one `read` at a time.
+	 * The content is decoded in chunks after the last 32 KB already read, which matches reach back into.
+	 */
+	class VOXLET_EXPORT Inflater final {
+		public:
+			/* `input` must outlive the inflater */
+			Inflater(std::span<const std::byte> input, DeflateFormat format) noexcept;
+			Inflater(const Inflater&) = delete;
+			auto operator=(const Inflater&) -> Inflater& = delete;
+			Inflater(Inflater&&) noexcept;
+			auto operator=(Inflater&&) noexcept -> Inflater&;
+			~Inflater();
+
+			/* returns the size written, less than `output.size()` only once the stream is over or has failed */
+			[[nodiscard]]
+			auto read(std::span<std::byte> output) noexcept -> std::size_t;
+
+			/* the whole content has been read, and its checksum matched for a zlib stream */
+			[[nodiscard]]
+			auto isDone() const noexcept -> bool;
+			[[nodiscard]]
+			auto hasFailed() const noexcept -> bool;
+
+		private:
+			std::unique_ptr<internal::InflateState> m_state;
+			DeflateFormat m_format;
+			std::vector<std::byte> m_buffer;
+			std::size_t m_readOffset;
+			std::size_t m_writeOffset;
+			std::uint32_t m_checksum;
+	};
+}
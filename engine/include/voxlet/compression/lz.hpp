@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "voxlet/containers/stringAccumulator.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+
+
+/*
+ * LZ77 codec in the LZ4 block format: each sequence is a token holding the literal and match lengths,
+ * the literals, then a 16-bit backward offset to a match of at least 4 bytes. Compression is a greedy
+ * single-probe hash search, decompression validates every length and offset so that it's safe on any
+ * input, and copies in 32-byte strides whenever the output has room to be overwritten.
+ */
+namespace vx::compression {
+	constexpr std::uint32_t LZ_FRAME_MAGIC {0x5a4c'5856u};
+	/* blocks are independent, the window never reaches back into the previous one */
+	constexpr std::size_t LZ_BLOCK_SIZE {64uz * 1024uz};
+
+	/* worst case size of `size` bytes compressed as a single block */
+	[[nodiscard]]
+	constexpr auto getBlockBound(const std::size_t size) noexcept -> std::size_t {
+		return size + size / 255uz + 16uz;
+	}
+
+	/* `output` must hold `getBlockBound(input.size())` bytes, returns the size written */
+	[[nodiscard]]
+	VOXLET_EXPORT auto compressBlock(std::span<const std::byte> input, std::span<std::byte> output) noexcept
+		-> std::size_t;
+	/* returns the size written, `nullopt` if the block is malformed or doesn't fit in `output` */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decompressBlock(std::span<const std::byte> input, std::span<std::byte> output) noexcept
+		-> std::optional<std::size_t>;
+
+
+	/*
+	 * A frame is a header, the compressed size of every block of `LZ_BLOCK_SIZE` bytes, then the blocks.
+	 * The highest bit of a size marks a block stored as is because it didn't compress.
+	 */
+	struct LzFrameHeader {
+		std::uint32_t magic;
+		std::uint32_t blockSize;
+		std::uint64_t size;
+	};
+
+	[[nodiscard]]
+	VOXLET_EXPORT auto compress(std::span<const std::byte> input) noexcept -> std::vector<std::byte>;
+	/* the size of the content of the frame, `nullopt` if the frame is malformed */
+	[[nodiscard]]
+	VOXLET_EXPORT auto getDecompressedSize(std::span<const std::byte> frame) noexcept -> std::optional<std::size_t>;
+	/* `output` must be of `getDecompressedSize(frame)` bytes */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decompress(std::span<const std::byte> frame, std::span<std::byte> output) noexcept -> bool;
+	/* same, with the blocks spread over the workers */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decompress(
+		std::span<const std::byte> frame,
+		std::span<std::byte> output,
+		vx::jobs::Scheduler& scheduler
+	) noexcept -> bool;
+	/* decompresses one block at a time and appends it, so that the content is never whole in memory twice */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decompress(std::span<const std::byte> frame, vx::containers::StringAccumulator& output) noexcept
+		-> bool;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+
+namespace vx::containers {
+	template <typename T>
+	struct SlotMapHandle {
+		static constexpr std::uint32_t INVALID_INDEX {std::numeric_limits<std::uint32_t>::max()};
+
+		std::uint32_t index {INVALID_INDEX};
+		std::uint32_t generation {0u};
+
+		[[nodiscard]]
+		constexpr auto isValid() const noexcept -> bool {return index != INVALID_INDEX;}
+		[[nodiscard]]
+		constexpr auto toBits() const noexcept -> std::uint64_t {
+			return static_cast<std::uint64_t> (generation) << 32 | index;
+		}
+		[[nodiscard]]
+		static constexpr auto fromBits(const std::uint64_t bits) noexcept -> SlotMapHandle {
+			return SlotMapHandle{static_cast<std::uint32_t> (bits), static_cast<std::uint32_t> (bits >> 32)};
+		}
+
+		constexpr auto operator==(const SlotMapHandle&) const noexcept -> bool = default;
+	};
+
+
+	/*
+	 * Dense storage addressed through generation-checked handles. Values are kept contiguous, so iterating
+	 * them is a plain array walk, and erasing moves the last value into the hole. Handles go through a slot
+	 * table which maps them to the current position of their value: a slot's generation is odd while it is
+	 * used and is bumped on erase, which invalidates every handle to the old value. A slot whose generation
+	 * wraps around is retired instead of reused.
+	 * Growing and erasing relocate values with `vx::memory::relocate`, so specializing
+	 * `vx::memory::IS_TRIVIALLY_RELOCATABLE` turns those into memcpy.
+	 */
+	template <typename T, typename Allocator = std::allocator<T>>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	class SlotMap final {
+		public:
+			SlotMap(const SlotMap&) = delete;
+			auto operator=(const SlotMap&) -> SlotMap& = delete;
+
+			using value_type = T;
+			using size_type = std::size_t;
+			using allocator_type = Allocator;
+			using Handle = SlotMapHandle<T>;
+			using iterator = T*;
+			using const_iterator = const T*;
+
+			SlotMap() noexcept;
+			explicit SlotMap(const Allocator& allocator) noexcept;
+			~SlotMap();
+			SlotMap(SlotMap&& other) noexcept;
+			auto operator=(SlotMap&& other) noexcept -> SlotMap&;
+
+			template <typename... Args>
+			requires std::is_constructible_v<T, Args...>
+			auto emplace(Args&&... args) noexcept -> Handle;
+			auto insert(T&& value) noexcept -> Handle {return this->emplace(std::move(value));}
+			auto insert(const T& value) noexcept -> Handle requires std::is_copy_constructible_v<T> {
+				return this->emplace(value);
+			}
+			auto erase(Handle handle) noexcept -> bool;
+			/* invalidates every handle */
+			auto clear() noexcept -> void;
+			auto reserve(size_type newCapacity) noexcept -> void;
+
+			[[nodiscard]]
+			auto contains(Handle handle) const noexcept -> bool;
+			[[nodiscard]]
+			auto get(Handle handle) noexcept -> T*;
+			[[nodiscard]]
+			auto get(Handle handle) const noexcept -> const T*;
+			[[nodiscard]]
+			auto operator[](Handle handle) noexcept -> T&;
+			[[nodiscard]]
+			auto operator[](Handle handle) const noexcept -> const T&;
+			/* handle of the value at `index` in iteration order */
+			[[nodiscard]]
+			auto getHandle(size_type index) const noexcept -> Handle;
+
+			[[nodiscard]]
+			constexpr auto getValues() noexcept -> std::span<T> {return {m_values, m_size};}
+			[[nodiscard]]
+			constexpr auto getValues() const noexcept -> std::span<const T> {return {m_values, m_size};}
+			[[nodiscard]]
+			constexpr auto isEmpty() const noexcept -> bool {return m_size == 0uz;}
+			[[nodiscard]]
+			constexpr auto getSize() const noexcept -> size_type {return m_size;}
+			[[nodiscard]]
+			constexpr auto getCapacity() const noexcept -> size_type {return m_capacity;}
+			[[nodiscard]]
+			constexpr auto getAllocator() const noexcept -> const Allocator& {return m_allocator;}
+
+			[[nodiscard]]
+			constexpr auto begin() noexcept -> iterator {return m_values;}
+			[[nodiscard]]
+			constexpr auto end() noexcept -> iterator {return m_values + m_size;}
+			[[nodiscard]]
+			constexpr auto begin() const noexcept -> const_iterator {return m_values;}
+			[[nodiscard]]
+			constexpr auto end() const noexcept -> const_iterator {return m_values + m_size;}
+
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto empty() const noexcept -> bool {return this->isEmpty();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto size() const noexcept -> size_type {return this->getSize();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto capacity() const noexcept -> size_type {return this->getCapacity();}
+
+		private:
+			struct Slot {
+				std::uint32_t generation;
+				/* position of the value while the slot is used, next free slot otherwise */
+				std::uint32_t index;
+			};
+
+			using AllocatorTraits = std::allocator_traits<Allocator>;
+			using SlotAllocator = typename AllocatorTraits::template rebind_alloc<Slot>;
+			using IndexAllocator = typename AllocatorTraits::template rebind_alloc<std::uint32_t>;
+
+			/* relocates the values to `values`, of `capacity` values, and frees the old storage */
+			auto adoptStorage(T* values, size_type capacity) noexcept -> void;
+			[[nodiscard]]
+			auto findSlot(Handle handle) const noexcept -> const Slot*;
+
+			[[no_unique_address]]
+			Allocator m_allocator;
+			T* m_values;
+			size_type m_size;
+			size_type m_capacity;
+			/* slot of each value, used to patch the slot of the value moved by an erase */
+			std::vector<std::uint32_t, IndexAllocator> m_valueSlots;
+			std::vector<Slot, SlotAllocator> m_slots;
+			std::uint32_t m_freeSlot;
+	};
+}
+
+template <typename T>
+struct std::hash<vx::containers::SlotMapHandle<T>> {
+	auto operator()(const vx::containers::SlotMapHandle<T>& handle) const noexcept -> std::size_t {
+		return std::hash<std::uint64_t> {} (handle.toBits());
+	}
+};
+
+#include "voxlet/containers/slotMap.inl"
+
+namespace vx {
+	using ::vx::containers::SlotMap;
+	using ::vx::containers::SlotMapHandle;
+}
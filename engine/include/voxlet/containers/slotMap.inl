@@ -0,0 +1,207 @@
+#pragma once
+
+#include "voxlet/containers/slotMap.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "voxlet/memory.hpp"
+
+
+namespace vx::containers {
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	SlotMap<T, Allocator>::SlotMap() noexcept :
+		SlotMap(Allocator{})
+	{}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	SlotMap<T, Allocator>::SlotMap(const Allocator& allocator) noexcept :
+		m_allocator {allocator},
+		m_values {nullptr},
+		m_size {0uz},
+		m_capacity {0uz},
+		m_valueSlots {IndexAllocator{allocator}},
+		m_slots {SlotAllocator{allocator}},
+		m_freeSlot {Handle::INVALID_INDEX}
+	{}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	SlotMap<T, Allocator>::~SlotMap() {
+		std::destroy_n(m_values, m_size);
+		if (m_values != nullptr)
+			AllocatorTraits::deallocate(m_allocator, m_values, m_capacity);
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	SlotMap<T, Allocator>::SlotMap(SlotMap&& other) noexcept :
+		m_allocator {std::move(other.m_allocator)},
+		m_values {std::exchange(other.m_values, nullptr)},
+		m_size {std::exchange(other.m_size, 0uz)},
+		m_capacity {std::exchange(other.m_capacity, 0uz)},
+		m_valueSlots {std::move(other.m_valueSlots)},
+		m_slots {std::move(other.m_slots)},
+		m_freeSlot {std::exchange(other.m_freeSlot, Handle::INVALID_INDEX)}
+	{}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::operator=(SlotMap&& other) noexcept -> SlotMap& {
+		if (this == &other)
+			return *this;
+		this->~SlotMap();
+		std::construct_at(this, std::move(other));
+		return *this;
+	}
+
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	template <typename... Args>
+	requires std::is_constructible_v<T, Args...>
+	auto SlotMap<T, Allocator>::emplace(Args&&... args) noexcept -> Handle {
+		if (m_size == m_capacity) {
+			/* built before the old storage goes, since `args` may refer to one of its values */
+			const size_type newCapacity {std::max(m_capacity * 2uz, 16uz)};
+			T* const values {AllocatorTraits::allocate(m_allocator, newCapacity)};
+			(void)std::construct_at(values + m_size, std::forward<Args> (args)...);
+			this->adoptStorage(values, newCapacity);
+		}
+		else
+			(void)std::construct_at(m_values + m_size, std::forward<Args> (args)...);
+
+		std::uint32_t slotIndex {m_freeSlot};
+		if (slotIndex == Handle::INVALID_INDEX) {
+			assert(m_slots.size() < Handle::INVALID_INDEX);
+			slotIndex = static_cast<std::uint32_t> (m_slots.size());
+			m_slots.push_back(Slot{0u, 0u});
+		}
+		else
+			m_freeSlot = m_slots[slotIndex].index;
+
+		Slot& slot {m_slots[slotIndex]};
+		++slot.generation;
+		slot.index = static_cast<std::uint32_t> (m_size);
+		m_valueSlots.push_back(slotIndex);
+		++m_size;
+		return Handle{slotIndex, slot.generation};
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::erase(const Handle handle) noexcept -> bool {
+		if (!this->contains(handle))
+			return false;
+		Slot& slot {m_slots[handle.index]};
+		const std::uint32_t index {slot.index};
+		const std::size_t last {m_size - 1uz};
+
+		std::destroy_at(m_values + index);
+		if (index != last) {
+			vx::memory::relocate(m_values + index, m_values + last, 1uz);
+			m_valueSlots[index] = m_valueSlots[last];
+			m_slots[m_valueSlots[index]].index = index;
+		}
+		m_valueSlots.pop_back();
+		--m_size;
+
+		/* an odd generation means the slot is used, the wrapped ones would alias handles to old values */
+		if (++slot.generation == 0u)
+			return true;
+		slot.index = m_freeSlot;
+		m_freeSlot = handle.index;
+		return true;
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::clear() noexcept -> void {
+		std::destroy_n(m_values, m_size);
+		for (const std::uint32_t slotIndex : m_valueSlots) {
+			Slot& slot {m_slots[slotIndex]};
+			if (++slot.generation == 0u)
+				continue;
+			slot.index = m_freeSlot;
+			m_freeSlot = slotIndex;
+		}
+		m_valueSlots.clear();
+		m_size = 0uz;
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::reserve(const size_type newCapacity) noexcept -> void {
+		if (newCapacity <= m_capacity)
+			return;
+		this->adoptStorage(AllocatorTraits::allocate(m_allocator, newCapacity), newCapacity);
+	}
+
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::contains(const Handle handle) const noexcept -> bool {
+		return this->findSlot(handle) != nullptr;
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::get(const Handle handle) noexcept -> T* {
+		const Slot* const slot {this->findSlot(handle)};
+		return slot == nullptr ? nullptr : m_values + slot->index;
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::get(const Handle handle) const noexcept -> const T* {
+		return const_cast<SlotMap&> (*this).get(handle);
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::operator[](const Handle handle) noexcept -> T& {
+		assert(this->contains(handle));
+		return m_values[m_slots[handle.index].index];
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::operator[](const Handle handle) const noexcept -> const T& {
+		return const_cast<SlotMap&> (*this)[handle];
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::getHandle(const size_type index) const noexcept -> Handle {
+		assert(index < m_size);
+		const std::uint32_t slotIndex {m_valueSlots[index]};
+		return Handle{slotIndex, m_slots[slotIndex].generation};
+	}
+
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::adoptStorage(T* const values, const size_type capacity) noexcept -> void {
+		if (m_values != nullptr) {
+			vx::memory::relocate(values, m_values, m_size);
+			AllocatorTraits::deallocate(m_allocator, m_values, m_capacity);
+		}
+		m_values = values;
+		m_capacity = capacity;
+		m_valueSlots.reserve(capacity);
+	}
+
+	template <typename T, typename Allocator>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto SlotMap<T, Allocator>::findSlot(const Handle handle) const noexcept -> const Slot* {
+		if (handle.index >= m_slots.size())
+			return nullptr;
+		const Slot& slot {m_slots[handle.index]};
+		if (slot.generation != handle.generation || (slot.generation & 1u) == 0u)
+			return nullptr;
+		return &slot;
+	}
+}
@@ -11,6 +11,7 @@
 
 #include "voxlet/containers/views/checkedContiguousIterator.hpp"
 #include "voxlet/containers/views/uncheckedStringSlice.hpp"
+#include "voxlet/memory.hpp"
 
 
 namespace vx::containers::views {
@@ -190,6 +191,10 @@ namespace vx::containers {
 	static_assert(std::ranges::contiguous_range<String>);
 }
 
+/* the short buffer is found from `this` and the long one lives on the heap */
+template <>
+constexpr bool vx::memory::IS_TRIVIALLY_RELOCATABLE<vx::containers::String> {true};
+
 #include "voxlet/containers/string.inl"
 
 namespace vx {
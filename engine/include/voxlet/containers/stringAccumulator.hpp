@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <type_traits>
 
 #include "voxlet/containers/string.hpp"
@@ -20,9 +21,9 @@ namespace vx::containers {
 			auto operator=(const BasicStringAccumulator&) -> BasicStringAccumulator& = delete;
 
 			constexpr BasicStringAccumulator() noexcept = default;
-			constexpr ~BasicStringAccumulator() = default;
-			constexpr BasicStringAccumulator(BasicStringAccumulator&&) noexcept = default;
-			constexpr auto operator=(BasicStringAccumulator&&) noexcept -> BasicStringAccumulator& = default;
+			constexpr ~BasicStringAccumulator();
+			constexpr BasicStringAccumulator(BasicStringAccumulator&& other) noexcept;
+			constexpr auto operator=(BasicStringAccumulator&& other) noexcept -> BasicStringAccumulator&;
 
 			[[nodiscard]]
 			constexpr auto getSize() const noexcept -> std::size_t;
@@ -30,9 +31,16 @@ namespace vx::containers {
 			constexpr auto isEmpty() const noexcept -> bool;
 			[[nodiscard]]
 			constexpr auto toString() const noexcept -> vx::String;
+			/* calls `callback` with each filled part of the segments in order, to stream them without a copy */
+			template <typename Callback>
+			requires std::invocable<Callback&, std::span<const char8_t>>
+			constexpr auto forEachSegment(Callback&& callback) const noexcept -> void;
+			/* empties the accumulator but keeps its segments to be filled again */
+			constexpr auto clear() noexcept -> void;
 
 			template <std::size_t N>
 			constexpr auto push(const char8_t (&literal)[N]) noexcept -> void;
+			[[gnu::always_inline]]
 			constexpr auto push(const char8_t* raw, std::size_t size) noexcept -> void;
 			constexpr auto push(const vx::String& string) noexcept -> void;
 			constexpr auto push(const vx::StringSlice& slice) noexcept -> void;
@@ -87,21 +95,27 @@ namespace vx::containers {
 			}
 
 		private:
-			constexpr auto reserveMaxOneSegment() noexcept -> std::pair<char8_t*, std::size_t>;
-			constexpr auto resizeMaxOneSegmentBy(std::size_t size) noexcept -> std::size_t;
-
 			struct Segment {
 				char8_t data[bufferSize];
 				std::unique_ptr<Segment> next;
 			};
 
+			constexpr auto reserveMaxOneSegment() noexcept -> std::pair<char8_t*, std::size_t>;
+			constexpr auto resizeMaxOneSegmentBy(std::size_t size) noexcept -> std::size_t;
+			[[gnu::cold]]
+			constexpr auto pushAcrossSegments(const char8_t* raw, std::size_t size) noexcept -> void;
+			[[nodiscard]]
+			constexpr auto getFirstSegment() const noexcept -> const Segment*;
+			/* frees the segments one after the other, as their destructors would recurse once per segment */
+			constexpr auto release() noexcept -> void;
+
 			[[no_unique_address]]
 			std::conditional_t<hasInnerStorage, Segment, vx::types::Empty> m_innerSegment;
 			[[no_unique_address]]
 			std::conditional_t<!hasInnerStorage, std::unique_ptr<Segment>, vx::types::Empty> m_firstSegment;
-			Segment* m_lastSegment;
-			std::size_t m_segmentCount;
-			std::size_t m_size;
+			Segment* m_lastSegment {nullptr};
+			std::size_t m_segmentCount {0uz};
+			std::size_t m_size {0uz};
 	};
 
 	using StringAccumulator = BasicStringAccumulator<>;
@@ -1,16 +1,59 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
 #include <iterator>
 #include <memory>
 #include <ostream>
 #include <ranges>
+#include <utility>
 
 #include "voxlet/containers/stringAccumulator.hpp"
 #include "voxlet/memory.hpp"
 
 
 namespace vx::containers {
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	constexpr BasicStringAccumulator<bufferSize, hasInnerStorage>::~BasicStringAccumulator() {
+		this->release();
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	constexpr BasicStringAccumulator<bufferSize, hasInnerStorage>::BasicStringAccumulator(BasicStringAccumulator&& other)
+		noexcept :
+		m_innerSegment {std::move(other.m_innerSegment)},
+		m_firstSegment {std::move(other.m_firstSegment)},
+		m_lastSegment {std::exchange(other.m_lastSegment, nullptr)},
+		m_segmentCount {std::exchange(other.m_segmentCount, 0uz)},
+		m_size {std::exchange(other.m_size, 0uz)}
+	{
+		if constexpr (hasInnerStorage) {
+			if (m_lastSegment == &other.m_innerSegment)
+				m_lastSegment = &m_innerSegment;
+		}
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	constexpr auto BasicStringAccumulator<bufferSize, hasInnerStorage>::operator=(BasicStringAccumulator&& other)
+		noexcept
+		-> BasicStringAccumulator&
+	{
+		if (this == &other)
+			return *this;
+		this->release();
+		m_innerSegment = std::move(other.m_innerSegment);
+		m_firstSegment = std::move(other.m_firstSegment);
+		m_lastSegment = std::exchange(other.m_lastSegment, nullptr);
+		m_segmentCount = std::exchange(other.m_segmentCount, 0uz);
+		m_size = std::exchange(other.m_size, 0uz);
+		if constexpr (hasInnerStorage) {
+			if (m_lastSegment == &other.m_innerSegment)
+				m_lastSegment = &m_innerSegment;
+		}
+		return *this;
+	}
+
+
 	template <std::size_t bufferSize, bool hasInnerStorage>
 	constexpr auto BasicStringAccumulator<bufferSize, hasInnerStorage>::getSize() const noexcept -> std::size_t {
 		return m_size;
@@ -28,23 +71,41 @@ namespace vx::containers {
 		vx::String string {};
 		string.resize(m_size);
 		char8_t* stringData {std::to_address(string.begin())};
+		this->forEachSegment([&](const std::span<const char8_t> data) noexcept {
+			vx::memory::memcpy(stringData, data.data(), data.size());
+			stringData += data.size();
+		});
+		return string;
+	}
 
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	template <typename Callback>
+	requires std::invocable<Callback&, std::span<const char8_t>>
+	constexpr auto BasicStringAccumulator<bufferSize, hasInnerStorage>::forEachSegment(Callback&& callback)
+		const noexcept
+		-> void
+	{
 		std::size_t size {m_size};
-		const Segment* segment {};
-		if constexpr (hasInnerStorage)
-			segment = &m_innerSegment;
-		else
-			segment = m_firstSegment.get();
-
+		const Segment* segment {this->getFirstSegment()};
 		while (size != 0uz) {
 			assert(segment != nullptr);
-			const std::size_t sizeWritten {std::min(size, bufferSize)};
-			vx::memory::memcpy(stringData, segment->data, sizeWritten);
-			size -= sizeWritten;
-			stringData += sizeWritten;
+			const std::size_t segmentSize {std::min(size, bufferSize)};
+			callback(std::span<const char8_t> {segment->data, segmentSize});
+			size -= segmentSize;
 			segment = segment->next.get();
 		}
-		return string;
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	constexpr auto BasicStringAccumulator<bufferSize, hasInnerStorage>::clear() noexcept -> void {
+		if (m_lastSegment == nullptr)
+			return;
+		if constexpr (hasInnerStorage)
+			m_lastSegment = &m_innerSegment;
+		else
+			m_lastSegment = m_firstSegment.get();
+		m_segmentCount = 1uz;
+		m_size = 0uz;
 	}
 
 
@@ -54,7 +115,10 @@ namespace vx::containers {
 		noexcept
 		-> void
 	{
-		return this->push(literal, N);
+		if constexpr (N == 0uz)
+			return;
+		else
+			return this->push(literal, literal[N - 1uz] == u8'\0' ? N - 1uz : N);
 	}
 
 	template <std::size_t bufferSize, bool hasInnerStorage>
@@ -62,12 +126,14 @@ namespace vx::containers {
 		noexcept
 		-> void
 	{
-		while (size != 0uz) {
-			const auto [data, dataSize] {this->reserveMaxOneSegment()};
-			vx::memory::memcpy(data, raw, std::min(size, dataSize));
-			raw += dataSize;
-			size = this->resizeMaxOneSegmentBy(size);
+		/* most pushes are small and fit in the last segment, inlined the copy of a known size is a few moves */
+		const std::size_t lastSegmentSize {m_size - (m_segmentCount - 1uz) * bufferSize};
+		if (m_lastSegment != nullptr && lastSegmentSize + size <= bufferSize) [[likely]] {
+			vx::memory::memcpy(m_lastSegment->data + lastSegmentSize, raw, size);
+			m_size += size;
+			return;
 		}
+		this->pushAcrossSegments(raw, size);
 	}
 
 	template <std::size_t bufferSize, bool hasInnerStorage>
@@ -177,9 +243,10 @@ namespace vx::containers {
 		if (remainingSize != 0uz && m_size != m_segmentCount * bufferSize)
 			return std::make_pair(m_lastSegment->data + lastSegmentSize, remainingSize);
 
-		m_lastSegment->next = std::make_unique<Segment> ();
+		/* the segments kept by `clear` are filled again before new ones are allocated */
+		if (m_lastSegment->next == nullptr)
+			m_lastSegment->next = std::make_unique<Segment> ();
 		m_lastSegment = m_lastSegment->next.get();
-		m_lastSegment->next = nullptr;
 		++m_segmentCount;
 		return std::make_pair(m_lastSegment->data, bufferSize);
 	}
@@ -201,4 +268,42 @@ namespace vx::containers {
 		return size - sizeToAdd;
 	}
 
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	constexpr auto BasicStringAccumulator<bufferSize, hasInnerStorage>::pushAcrossSegments(
+		const char8_t* raw,
+		std::size_t size
+	) noexcept -> void {
+		while (size != 0uz) {
+			const auto [data, dataSize] {this->reserveMaxOneSegment()};
+			vx::memory::memcpy(data, raw, std::min(size, dataSize));
+			raw += dataSize;
+			size = this->resizeMaxOneSegmentBy(size);
+		}
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	constexpr auto BasicStringAccumulator<bufferSize, hasInnerStorage>::getFirstSegment()
+		const noexcept
+		-> const Segment*
+	{
+		if constexpr (hasInnerStorage)
+			return &m_innerSegment;
+		else
+			return m_firstSegment.get();
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	constexpr auto BasicStringAccumulator<bufferSize, hasInnerStorage>::release() noexcept -> void {
+		std::unique_ptr<Segment> segment {};
+		if constexpr (hasInnerStorage)
+			segment = std::move(m_innerSegment.next);
+		else
+			segment = std::move(m_firstSegment);
+		while (segment != nullptr)
+			segment = std::move(segment->next);
+		m_lastSegment = nullptr;
+		m_segmentCount = 0uz;
+		m_size = 0uz;
+	}
+
 }
@@ -9,7 +9,10 @@
 namespace vx::containers::views {
 	template <std::size_t N>
 	constexpr auto StringSlice::from(const char8_t (&literal)[N]) noexcept -> StringSlice {
-		return StringSlice::from(literal, N);
+		if constexpr (N == 0uz)
+			return StringSlice::from(literal, N);
+		else
+			return StringSlice::from(literal, literal[N - 1uz] == u8'\0' ? N - 1uz : N);
 	}
 
 	constexpr auto StringSlice::from(const char8_t* const raw, const std::size_t N)
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "voxlet/ecs/component.hpp"
+#include "voxlet/ecs/entity.hpp"
+#include "voxlet/ecs/tick.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/memory/blockPool.hpp"
+
+
+namespace vx::ecs {
+	/*
+	 * Table of every entity owning exactly the same set of components. Rows are stored structure-of-arrays in
+	 * fixed-size chunks: each chunk holds an entity column followed by one column per component. Rows stay
+	 * densely packed, every chunk but the last one is full.
+	 * Every component of a row carries the tick it was added at and the tick it was last changed at. Each
+	 * chunk also keeps the newest of those ticks per column, so whole chunks can be skipped by change
+	 * filters, and a tick at which every row of the column was written at once.
+	 */
+	class VOXLET_EXPORT Archetype final {
+		public:
+			static constexpr std::size_t CHUNK_SIZE {16uz * 1024uz};
+			static constexpr std::size_t npos {static_cast<std::size_t> (-1)};
+
+			Archetype(const Archetype&) = delete;
+			auto operator=(const Archetype&) -> Archetype& = delete;
+			Archetype(Archetype&&) = delete;
+			auto operator=(Archetype&&) -> Archetype& = delete;
+
+			struct Column {
+				ComponentId id;
+				ComponentInfos infos;
+				std::size_t offset;
+				std::size_t addedTicksOffset;
+				std::size_t changedTicksOffset;
+			};
+
+			struct ColumnTicks {
+				Tick added;
+				Tick changed;
+				Tick allChanged;
+			};
+
+			struct Chunk {
+				std::byte* memory;
+				std::uint32_t count;
+			};
+
+			struct Location {
+				std::uint32_t chunk;
+				std::uint32_t row;
+			};
+
+			/* `signature` must be sorted and free of duplicates */
+			Archetype(std::vector<ComponentId>&& signature, vx::memory::BlockPool& chunkPool) noexcept;
+			~Archetype();
+
+			[[nodiscard]]
+			constexpr auto getSignature() const noexcept -> std::span<const ComponentId> {return m_signature;}
+			[[nodiscard]]
+			constexpr auto getColumns() const noexcept -> std::span<const Column> {return m_columns;}
+			[[nodiscard]]
+			constexpr auto getChunks() const noexcept -> std::span<const Chunk> {return m_chunks;}
+			[[nodiscard]]
+			constexpr auto getChunkCapacity() const noexcept -> std::size_t {return m_chunkCapacity;}
+			[[nodiscard]]
+			constexpr auto getEntityCount() const noexcept -> std::size_t {return m_entityCount;}
+
+			[[nodiscard]]
+			auto findColumn(ComponentId id) const noexcept -> std::size_t;
+			[[nodiscard]]
+			auto has(ComponentId id) const noexcept -> bool {return this->findColumn(id) != npos;}
+
+			[[nodiscard]]
+			auto getEntities(std::size_t chunk) const noexcept -> Entity* {
+				return reinterpret_cast<Entity*> (m_chunks[chunk].memory + m_entitiesOffset);
+			}
+			[[nodiscard]]
+			auto getColumn(std::size_t chunk, std::size_t column) const noexcept -> std::byte* {
+				return m_chunks[chunk].memory + m_columns[column].offset;
+			}
+			[[nodiscard]]
+			auto getComponent(Location location, std::size_t column) const noexcept -> std::byte* {
+				return this->getColumn(location.chunk, column) + location.row * m_columns[column].infos.size;
+			}
+
+			[[nodiscard]]
+			auto getColumnTicks(std::size_t chunk, std::size_t column) const noexcept -> ColumnTicks& {
+				return reinterpret_cast<ColumnTicks*> (m_chunks[chunk].memory)[column];
+			}
+			[[nodiscard]]
+			auto getAddedTicks(std::size_t chunk, std::size_t column) const noexcept -> Tick* {
+				return reinterpret_cast<Tick*> (m_chunks[chunk].memory + m_columns[column].addedTicksOffset);
+			}
+			[[nodiscard]]
+			auto getChangedTicks(std::size_t chunk, std::size_t column) const noexcept -> Tick* {
+				return reinterpret_cast<Tick*> (m_chunks[chunk].memory + m_columns[column].changedTicksOffset);
+			}
+			[[nodiscard]]
+			auto getChangedTick(Location location, std::size_t column) const noexcept -> Tick {
+				return getNewest(
+					this->getChangedTicks(location.chunk, column)[location.row],
+					this->getColumnTicks(location.chunk, column).allChanged
+				);
+			}
+
+			auto markAdded(Location location, std::size_t column, Tick tick) noexcept -> void;
+			auto markChanged(Location location, std::size_t column, Tick tick) noexcept -> void;
+			/* marks every row of the chunk as changed without touching the per-row ticks */
+			auto markChunkChanged(std::size_t chunk, std::size_t column, Tick tick) noexcept -> void;
+
+			/* Appends a row for `entity`. Its components are left uninitialized and must be constructed in place */
+			[[nodiscard]]
+			auto allocateRow(Entity entity) noexcept -> Location;
+			/*
+			 * Destroys the components of `location` and fills the hole with the last row. Returns the entity which
+			 * was moved into `location`, or an invalid entity if the last row was removed.
+			 */
+			auto removeRow(Location location) noexcept -> Entity;
+			/*
+			 * Moves the row at `location` to `destination`. Components missing from `destination` are destroyed,
+			 * the ones missing from this archetype are left uninitialized. The hole is filled like in `removeRow`.
+			 */
+			auto moveRow(Location location, Archetype& destination, Location& destinationLocation) noexcept -> Entity;
+
+			[[nodiscard]]
+			auto findAddEdge(ComponentId id) const noexcept -> Archetype*;
+			[[nodiscard]]
+			auto findRemoveEdge(ComponentId id) const noexcept -> Archetype*;
+			auto setAddEdge(ComponentId id, Archetype& archetype) noexcept -> void {m_addEdges[id] = &archetype;}
+			auto setRemoveEdge(ComponentId id, Archetype& archetype) noexcept -> void {m_removeEdges[id] = &archetype;}
+
+		private:
+			/* moves the last row into `location` and shrinks the archetype by one row */
+			auto fillHole(Location location) noexcept -> Entity;
+			auto copyTicks(Location source, std::size_t sourceColumn, Archetype& destination, Location target, std::size_t targetColumn)
+				noexcept
+				-> void;
+
+			vx::memory::BlockPool* m_chunkPool;
+			std::vector<ComponentId> m_signature;
+			std::vector<Column> m_columns;
+			std::vector<Chunk> m_chunks;
+			std::size_t m_chunkCapacity;
+			std::size_t m_entitiesOffset;
+			std::size_t m_entityCount;
+			std::unordered_map<ComponentId, Archetype*> m_addEdges;
+			std::unordered_map<ComponentId, Archetype*> m_removeEdges;
+	};
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "voxlet/ecs/component.hpp"
+#include "voxlet/ecs/entity.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/memory/blockPool.hpp"
+
+
+namespace vx::ecs {
+	class World;
+
+	/*
+	 * Records structural changes to apply later, while the world can't be modified. Commands are stored
+	 * in place in recycled blocks and applied in recording order.
+	 */
+	class VOXLET_EXPORT CommandBuffer final {
+		public:
+			static constexpr std::size_t BLOCK_SIZE {4096uz};
+
+			CommandBuffer(const CommandBuffer&) = delete;
+			auto operator=(const CommandBuffer&) -> CommandBuffer& = delete;
+			CommandBuffer(CommandBuffer&&) = delete;
+			auto operator=(CommandBuffer&&) -> CommandBuffer& = delete;
+
+			CommandBuffer() noexcept;
+			~CommandBuffer();
+
+			template <typename... Ts>
+			requires (Component<std::remove_cvref_t<Ts>> && ...)
+			auto spawn(Ts&&... components) noexcept -> void;
+			auto despawn(Entity entity) noexcept -> void;
+			template <typename T>
+			requires Component<std::remove_cvref_t<T>>
+			auto add(Entity entity, T&& component) noexcept -> void;
+			template <Component T>
+			auto remove(Entity entity) noexcept -> void;
+
+			/* defers an arbitrary `void(World&) noexcept` callable */
+			template <typename Func>
+			requires std::is_nothrow_invocable_v<std::remove_cvref_t<Func>&, World&>
+			auto push(Func&& func) noexcept -> void;
+
+			auto apply(World& world) noexcept -> void;
+			auto clear() noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getCommandCount() const noexcept -> std::size_t {return m_commandCount;}
+			[[nodiscard]]
+			constexpr auto isEmpty() const noexcept -> bool {return m_commandCount == 0uz;}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto size() const noexcept {return this->getCommandCount();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto empty() const noexcept {return this->isEmpty();}
+
+		private:
+			struct Node {
+				using Apply = void(*)(Node& node, World& world) noexcept;
+				using Destroy = void(*)(Node& node) noexcept;
+
+				Apply apply;
+				Destroy destroy;
+				Node* next;
+			};
+
+			template <typename Func>
+			static auto getPayload(Node& node) noexcept -> Func*;
+			[[nodiscard]]
+			auto allocate(std::size_t size, std::size_t alignment) noexcept -> std::byte*;
+			auto append(Node& node) noexcept -> void;
+			auto release() noexcept -> void;
+
+			vx::memory::BlockPool m_blockPool;
+			std::vector<void*> m_blocks;
+			std::byte* m_cursor;
+			std::byte* m_end;
+			Node* m_head;
+			Node* m_tail;
+			std::size_t m_commandCount;
+	};
+}
+
+#include "voxlet/ecs/commandBuffer.inl"
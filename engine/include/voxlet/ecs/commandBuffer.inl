@@ -0,0 +1,62 @@
+#pragma once
+
+#include "voxlet/ecs/commandBuffer.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "voxlet/ecs/world.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::ecs {
+	template <typename... Ts>
+	requires (Component<std::remove_cvref_t<Ts>> && ...)
+	auto CommandBuffer::spawn(Ts&&... components) noexcept -> void {
+		this->push([...components = std::forward<Ts> (components)](World& world) mutable noexcept {
+			(void)world.spawn(std::move(components)...);
+		});
+	}
+
+	template <typename T>
+	requires Component<std::remove_cvref_t<T>>
+	auto CommandBuffer::add(const Entity entity, T&& component) noexcept -> void {
+		this->push([entity, component = std::forward<T> (component)](World& world) mutable noexcept {
+			(void)world.add(entity, std::move(component));
+		});
+	}
+
+	template <Component T>
+	auto CommandBuffer::remove(const Entity entity) noexcept -> void {
+		this->push([entity](World& world) noexcept {
+			(void)world.remove<T> (entity);
+		});
+	}
+
+
+	template <typename Func>
+	requires std::is_nothrow_invocable_v<std::remove_cvref_t<Func>&, World&>
+	auto CommandBuffer::push(Func&& func) noexcept -> void {
+		using Command = std::remove_cvref_t<Func>;
+		constexpr std::size_t PAYLOAD_OFFSET {vx::memory::alignUp(sizeof(Node), alignof(Command))};
+		static_assert(PAYLOAD_OFFSET + sizeof(Command) <= BLOCK_SIZE, "Command is too big for a command buffer block");
+
+		std::byte* const memory {this->allocate(PAYLOAD_OFFSET + sizeof(Command), std::max(alignof(Node), alignof(Command)))};
+		Node* const node {std::construct_at(reinterpret_cast<Node*> (memory), Node{
+			.apply = [](Node& node, World& world) noexcept {(*getPayload<Command> (node))(world);},
+			.destroy = std::is_trivially_destructible_v<Command>
+				? nullptr
+				: +[](Node& node) noexcept {std::destroy_at(getPayload<Command> (node));},
+			.next = nullptr
+		})};
+		(void)std::construct_at(reinterpret_cast<Command*> (memory + PAYLOAD_OFFSET), std::forward<Func> (func));
+		this->append(*node);
+	}
+
+
+	template <typename Func>
+	auto CommandBuffer::getPayload(Node& node) noexcept -> Func* {
+		return reinterpret_cast<Func*> (reinterpret_cast<std::byte*> (&node) + vx::memory::alignUp(sizeof(Node), alignof(Func)));
+	}
+}
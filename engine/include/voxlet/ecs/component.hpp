@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "voxlet/export.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::ecs {
+	using ComponentId = std::uint32_t;
+
+	/*
+	 * Components are stored in chunk columns aligned to `MAX_COMPONENT_ALIGNMENT`, and may be moved to
+	 * another chunk at any structural change, so they must be nothrow movable.
+	 */
+	constexpr std::size_t MAX_COMPONENT_ALIGNMENT {64uz};
+
+	template <typename T>
+	concept Component = std::is_object_v<T>
+		&& !std::is_const_v<T>
+		&& std::is_nothrow_move_constructible_v<T>
+		&& std::is_nothrow_destructible_v<T>
+		&& alignof(T) <= MAX_COMPONENT_ALIGNMENT;
+
+	struct ComponentInfos {
+		using Relocate = void(*)(void* destination, void* source) noexcept;
+		using Destroy = void(*)(void* component) noexcept;
+
+		std::size_t size;
+		std::size_t alignment;
+		// nullptr when the component can be relocated with a plain memcpy
+		Relocate relocate;
+		// nullptr when the component is trivially destructible
+		Destroy destroy;
+	};
+
+	[[nodiscard]]
+	VOXLET_EXPORT auto registerComponent(const ComponentInfos& infos) noexcept -> ComponentId;
+	[[nodiscard]]
+	VOXLET_EXPORT auto getComponentInfos(ComponentId id) noexcept -> ComponentInfos;
+
+	template <Component T>
+	[[nodiscard]]
+	auto getComponentId() noexcept -> ComponentId {
+		static const ComponentId id {registerComponent(ComponentInfos{
+			.size = sizeof(T),
+			.alignment = alignof(T),
+			.relocate = vx::memory::IS_TRIVIALLY_RELOCATABLE<T>
+				? nullptr
+				: +[](void* const destination, void* const source) noexcept {
+					(void)std::construct_at(static_cast<T*> (destination), std::move(*static_cast<T*> (source)));
+					std::destroy_at(static_cast<T*> (source));
+				},
+			.destroy = std::is_trivially_destructible_v<T>
+				? nullptr
+				: +[](void* const component) noexcept {std::destroy_at(static_cast<T*> (component));}
+		})};
+		return id;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+
+namespace vx::ecs {
+	/*
+	 * Generational handle to an entity. The index is recycled once the entity is despawned, the generation
+	 * makes stale handles detectable.
+	 */
+	struct Entity {
+		static constexpr std::uint32_t INVALID_INDEX {static_cast<std::uint32_t> (-1)};
+
+		std::uint32_t index {INVALID_INDEX};
+		std::uint32_t generation {0u};
+
+		[[nodiscard]]
+		constexpr auto isValid() const noexcept -> bool {return index != INVALID_INDEX;}
+		[[nodiscard]]
+		constexpr auto toBits() const noexcept -> std::uint64_t {
+			return (static_cast<std::uint64_t> (generation) << 32u) | index;
+		}
+
+		constexpr auto operator==(const Entity&) const noexcept -> bool = default;
+	};
+}
+
+template <>
+struct std::hash<vx::ecs::Entity> {
+	auto operator()(const vx::ecs::Entity entity) const noexcept -> std::size_t {
+		return std::hash<std::uint64_t> {} (entity.toBits());
+	}
+};
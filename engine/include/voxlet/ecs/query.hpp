@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "voxlet/ecs/archetype.hpp"
+#include "voxlet/ecs/component.hpp"
+#include "voxlet/ecs/entity.hpp"
+#include "voxlet/ecs/tick.hpp"
+#include "voxlet/ecs/world.hpp"
+
+
+namespace vx::ecs {
+	template <typename T>
+	concept QueryTerm = Component<std::remove_const_t<T>>;
+
+	/*
+	 * Iterates every entity owning at least the components `Ts`, a `const` component is only read. Matching
+	 * archetypes are cached and refreshed incrementally when the world creates new ones.
+	 * `forEachChunk` hands out one span per component column so kernels can be vectorized, the callable may
+	 * take a leading `std::span<const Entity>`. `forEach` is the per-entity version, with an optional leading
+	 * `Entity`.
+	 * `changed<T>` and `added<T>` restrict the query to entities whose `T` was changed or added since the
+	 * previous run of the query, the filters of one query must all pass. Chunks where no row passes are
+	 * skipped from their column ticks alone. `forEach` also filters rows, while `forEachChunk` hands out every
+	 * row of a passing chunk. Each run flags the non-const components it visits as changed, per row in a
+	 * filtered `forEach` and per chunk otherwise. A query never sees its own writes.
+	 */
+	template <typename... Ts>
+	class Query final {
+		static_assert((QueryTerm<Ts> && ...));
+
+		public:
+			struct Match {
+				Archetype* archetype;
+				std::array<std::size_t, sizeof...(Ts)> columns;
+			};
+
+			explicit Query(World& world) noexcept;
+
+			template <Component T>
+			auto changed() noexcept -> Query&;
+			template <Component T>
+			auto added() noexcept -> Query&;
+
+			template <typename Func>
+			auto forEachChunk(Func&& func) noexcept -> void;
+			template <typename Func>
+			auto forEach(Func&& func) noexcept -> void;
+			/*
+			 * Splits a run between several threads: `prepare` refreshes the matches, starts the run and returns
+			 * the chunk count, `forEachChunkInRange` visits the chunks `[first, last)` in the order used by
+			 * `forEachChunk` and `finish` ends the run once every range was visited.
+			 */
+			auto prepare() noexcept -> std::size_t;
+			template <typename Func>
+			auto forEachChunkInRange(std::size_t first, std::size_t last, Func&& func) const noexcept -> void;
+			auto finish() noexcept -> void;
+
+			[[nodiscard]]
+			auto getEntityCount() noexcept -> std::size_t;
+			[[nodiscard]]
+			auto getChunkCount() noexcept -> std::size_t;
+			[[nodiscard]]
+			auto getMatches() noexcept -> std::span<const Match>;
+
+		private:
+			struct Filter {
+				ComponentId id;
+				bool added;
+			};
+
+			auto update() noexcept -> void;
+			auto addFilter(ComponentId id, bool added) noexcept -> void;
+			[[nodiscard]]
+			auto passesChunk(std::size_t match, std::size_t chunk) const noexcept -> bool;
+			[[nodiscard]]
+			auto passesRow(std::size_t match, Archetype::Location location) const noexcept -> bool;
+
+			template <std::size_t... Is>
+			auto markChunk(const Match& match, std::size_t chunk, std::index_sequence<Is...>) const noexcept -> void;
+			template <std::size_t... Is>
+			auto markRow(const Match& match, Archetype::Location location, std::index_sequence<Is...>) const noexcept -> void;
+			template <typename Func, std::size_t... Is>
+			static auto invokeChunk(Func& func, const Match& match, std::size_t chunk, std::index_sequence<Is...>) noexcept -> void;
+
+			World* m_world;
+			std::vector<Match> m_matches;
+			std::size_t m_seenArchetypeCount;
+			std::vector<Filter> m_filters;
+			/* `m_filters.size()` columns per match */
+			std::vector<std::size_t> m_filterColumns;
+			Tick m_lastRun;
+			Tick m_runTick;
+	};
+}
+
+#include "voxlet/ecs/query.inl"
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "voxlet/ecs/query.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <utility>
+
+
+namespace vx::ecs {
+	template <typename... Ts>
+	Query<Ts...>::Query(World& world) noexcept :
+		m_world {&world},
+		m_matches {},
+		m_seenArchetypeCount {0uz},
+		m_filters {},
+		m_filterColumns {},
+		m_lastRun {0u},
+		m_runTick {0u}
+	{}
+
+
+	template <typename... Ts>
+	template <Component T>
+	auto Query<Ts...>::changed() noexcept -> Query& {
+		this->addFilter(getComponentId<T> (), false);
+		return *this;
+	}
+
+	template <typename... Ts>
+	template <Component T>
+	auto Query<Ts...>::added() noexcept -> Query& {
+		this->addFilter(getComponentId<T> (), true);
+		return *this;
+	}
+
+
+	template <typename... Ts>
+	template <typename Func>
+	auto Query<Ts...>::forEachChunk(Func&& func) noexcept -> void {
+		const std::size_t chunkCount {this->prepare()};
+		this->forEachChunkInRange(0uz, chunkCount, func);
+		this->finish();
+	}
+
+	template <typename... Ts>
+	template <typename Func>
+	auto Query<Ts...>::forEach(Func&& func) noexcept -> void {
+		(void)this->prepare();
+		for (std::size_t i {0uz}; i < m_matches.size(); ++i) {
+			const Match& match {m_matches[i]};
+			for (std::size_t chunk {0uz}; chunk < match.archetype->getChunks().size(); ++chunk) {
+				if (!this->passesChunk(i, chunk))
+					continue;
+				auto kernel {[this, &func, &match, i, chunk](const std::span<const Entity> entities, const std::span<Ts>... columns) noexcept {
+					for (std::size_t row {0uz}; row < entities.size(); ++row) {
+						const Archetype::Location location {static_cast<std::uint32_t> (chunk), static_cast<std::uint32_t> (row)};
+						if (!m_filters.empty() && !this->passesRow(i, location))
+							continue;
+						if constexpr (std::invocable<Func&, Entity, Ts&...>)
+							func(entities[row], columns[row]...);
+						else
+							func(columns[row]...);
+						if (!m_filters.empty())
+							this->markRow(match, location, std::index_sequence_for<Ts...> {});
+					}
+				}};
+				invokeChunk(kernel, match, chunk, std::index_sequence_for<Ts...> {});
+				if (m_filters.empty())
+					this->markChunk(match, chunk, std::index_sequence_for<Ts...> {});
+			}
+		}
+		this->finish();
+	}
+
+
+	template <typename... Ts>
+	auto Query<Ts...>::prepare() noexcept -> std::size_t {
+		m_runTick = m_world->advanceTick();
+		return this->getChunkCount();
+	}
+
+	template <typename... Ts>
+	template <typename Func>
+	auto Query<Ts...>::forEachChunkInRange(const std::size_t first, const std::size_t last, Func&& func) const
+		noexcept
+		-> void
+	{
+		std::size_t matchFirstChunk {0uz};
+		for (std::size_t i {0uz}; i < m_matches.size(); ++i) {
+			if (matchFirstChunk >= last)
+				return;
+			const Match& match {m_matches[i]};
+			const std::size_t chunkCount {match.archetype->getChunks().size()};
+			const std::size_t begin {std::max(first, matchFirstChunk) - matchFirstChunk};
+			const std::size_t end {std::min(last - matchFirstChunk, chunkCount)};
+			for (std::size_t chunk {begin}; chunk < end; ++chunk) {
+				if (!this->passesChunk(i, chunk))
+					continue;
+				invokeChunk(func, match, chunk, std::index_sequence_for<Ts...> {});
+				this->markChunk(match, chunk, std::index_sequence_for<Ts...> {});
+			}
+			matchFirstChunk += chunkCount;
+		}
+	}
+
+	template <typename... Ts>
+	auto Query<Ts...>::finish() noexcept -> void {
+		m_lastRun = m_runTick;
+	}
+
+
+	template <typename... Ts>
+	auto Query<Ts...>::getEntityCount() noexcept -> std::size_t {
+		this->update();
+		std::size_t count {0uz};
+		for (const Match& match : m_matches)
+			count += match.archetype->getEntityCount();
+		return count;
+	}
+
+	template <typename... Ts>
+	auto Query<Ts...>::getChunkCount() noexcept -> std::size_t {
+		this->update();
+		std::size_t count {0uz};
+		for (const Match& match : m_matches)
+			count += match.archetype->getChunks().size();
+		return count;
+	}
+
+	template <typename... Ts>
+	auto Query<Ts...>::getMatches() noexcept -> std::span<const Match> {
+		this->update();
+		return m_matches;
+	}
+
+
+	template <typename... Ts>
+	auto Query<Ts...>::update() noexcept -> void {
+		const auto archetypes {m_world->getArchetypes()};
+		for (; m_seenArchetypeCount < archetypes.size(); ++m_seenArchetypeCount) {
+			Archetype& archetype {*archetypes[m_seenArchetypeCount]};
+			const Match match {&archetype, {archetype.findColumn(getComponentId<std::remove_const_t<Ts>> ())...}};
+			if (std::ranges::any_of(match.columns, [](const std::size_t column) noexcept {return column == Archetype::npos;}))
+				continue;
+			if (std::ranges::any_of(m_filters, [&archetype](const Filter& filter) noexcept {return !archetype.has(filter.id);}))
+				continue;
+			m_matches.push_back(match);
+			for (const Filter& filter : m_filters)
+				m_filterColumns.push_back(archetype.findColumn(filter.id));
+		}
+	}
+
+	template <typename... Ts>
+	auto Query<Ts...>::addFilter(const ComponentId id, const bool added) noexcept -> void {
+		m_filters.push_back(Filter{id, added});
+		m_matches.clear();
+		m_filterColumns.clear();
+		m_seenArchetypeCount = 0uz;
+	}
+
+	template <typename... Ts>
+	auto Query<Ts...>::passesChunk(const std::size_t match, const std::size_t chunk) const noexcept -> bool {
+		const Archetype& archetype {*m_matches[match].archetype};
+		for (std::size_t i {0uz}; i < m_filters.size(); ++i) {
+			const Archetype::ColumnTicks& ticks {archetype.getColumnTicks(chunk, m_filterColumns[match * m_filters.size() + i])};
+			if (!isNewer(m_filters[i].added ? ticks.added : ticks.changed, m_lastRun))
+				return false;
+		}
+		return true;
+	}
+
+	template <typename... Ts>
+	auto Query<Ts...>::passesRow(const std::size_t match, const Archetype::Location location) const noexcept -> bool {
+		const Archetype& archetype {*m_matches[match].archetype};
+		for (std::size_t i {0uz}; i < m_filters.size(); ++i) {
+			const std::size_t column {m_filterColumns[match * m_filters.size() + i]};
+			const Tick tick {m_filters[i].added
+				? archetype.getAddedTicks(location.chunk, column)[location.row]
+				: archetype.getChangedTick(location, column)
+			};
+			if (!isNewer(tick, m_lastRun))
+				return false;
+		}
+		return true;
+	}
+
+	template <typename... Ts>
+	template <std::size_t... Is>
+	auto Query<Ts...>::markChunk(const Match& match, const std::size_t chunk, std::index_sequence<Is...>) const noexcept -> void {
+		([&] {
+			if constexpr (!std::is_const_v<Ts>)
+				match.archetype->markChunkChanged(chunk, match.columns[Is], m_runTick);
+		}(), ...);
+	}
+
+	template <typename... Ts>
+	template <std::size_t... Is>
+	auto Query<Ts...>::markRow(const Match& match, const Archetype::Location location, std::index_sequence<Is...>) const
+		noexcept
+		-> void
+	{
+		([&] {
+			if constexpr (!std::is_const_v<Ts>)
+				match.archetype->markChanged(location, match.columns[Is], m_runTick);
+		}(), ...);
+	}
+
+	template <typename... Ts>
+	template <typename Func, std::size_t... Is>
+	auto Query<Ts...>::invokeChunk(
+		Func& func,
+		const Match& match,
+		const std::size_t chunk,
+		std::index_sequence<Is...>
+	) noexcept -> void {
+		const std::size_t count {match.archetype->getChunks()[chunk].count};
+		if constexpr (std::invocable<Func&, std::span<const Entity>, std::span<Ts>...>) {
+			func(
+				std::span<const Entity> {match.archetype->getEntities(chunk), count},
+				std::span<Ts> {reinterpret_cast<Ts*> (match.archetype->getColumn(chunk, match.columns[Is])), count}...
+			);
+		}
+		else {
+			func(std::span<Ts> {reinterpret_cast<Ts*> (match.archetype->getColumn(chunk, match.columns[Is])), count}...);
+		}
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/ecs/commandBuffer.hpp"
+#include "voxlet/ecs/component.hpp"
+#include "voxlet/ecs/entity.hpp"
+#include "voxlet/ecs/query.hpp"
+#include "voxlet/ecs/world.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/frameGraph.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+
+
+namespace vx::ecs {
+	namespace internal {
+		template <typename T>
+		struct SpanElement;
+		template <typename T>
+		struct SpanElement<std::span<T>> {using Type = T;};
+
+		template <bool HAS_COMMANDS, bool HAS_ENTITIES, typename... Ts>
+		struct ChunkSignature {};
+
+		template <typename... Args>
+		struct ParseChunkSignature {
+			using Type = ChunkSignature<false, false, typename SpanElement<Args>::Type...>;
+		};
+		template <typename... Args>
+		struct ParseChunkSignature<std::span<const Entity>, Args...> {
+			using Type = ChunkSignature<false, true, typename SpanElement<Args>::Type...>;
+		};
+		template <typename... Args>
+		struct ParseChunkSignature<CommandBuffer&, Args...> {
+			using Type = ChunkSignature<true, false, typename SpanElement<Args>::Type...>;
+		};
+		template <typename... Args>
+		struct ParseChunkSignature<CommandBuffer&, std::span<const Entity>, Args...> {
+			using Type = ChunkSignature<true, true, typename SpanElement<Args>::Type...>;
+		};
+
+		template <typename... Args>
+		struct SystemSignature {
+			static constexpr bool IS_EXCLUSIVE {false};
+			using Chunk = typename ParseChunkSignature<std::remove_const_t<Args>...>::Type;
+		};
+		template <>
+		struct SystemSignature<World&> {
+			static constexpr bool IS_EXCLUSIVE {true};
+		};
+
+		template <typename Func>
+		struct SystemTraits : SystemTraits<decltype(&Func::operator())> {};
+		template <typename Class, typename Return, typename... Args>
+		struct SystemTraits<Return (Class::*)(Args...) const noexcept> : SystemSignature<Args...> {};
+		template <typename Class, typename Return, typename... Args>
+		struct SystemTraits<Return (Class::*)(Args...) noexcept> : SystemSignature<Args...> {};
+		template <typename Return, typename... Args>
+		struct SystemTraits<Return (*)(Args...) noexcept> : SystemSignature<Args...> {};
+	}
+
+
+	/*
+	 * Runs systems on the job scheduler. A system declares its accesses through its parameters:
+	 *   - `World&` makes it exclusive, it runs alone and can change the world directly
+	 *   - otherwise it is called once per matching chunk, with one `std::span<T>` per written component
+	 *     and one `std::span<const T>` per read component, optionally preceded by `CommandBuffer&` and
+	 *     `std::span<const Entity>`
+	 *
+	 * Systems whose accesses don't conflict run in parallel, a conflict is resolved in declaration order.
+	 * Chunk systems are split into chunk-range jobs and may run concurrently with themselves. Their
+	 * structural changes go through per-thread command buffers, which are applied at sync points: before
+	 * each exclusive system and at the end of `run`.
+	 */
+	class VOXLET_EXPORT Schedule final {
+		public:
+			Schedule(const Schedule&) = delete;
+			auto operator=(const Schedule&) -> Schedule& = delete;
+			Schedule(Schedule&&) = delete;
+			auto operator=(Schedule&&) -> Schedule& = delete;
+
+			explicit Schedule(World& world) noexcept;
+			~Schedule();
+
+			template <typename Func>
+			auto addSystem(const vx::StringSlice& name, Func&& func) noexcept -> vx::jobs::FrameGraph::StageId;
+			auto removeSystem(const vx::StringSlice& name) noexcept -> bool;
+
+			auto run(vx::jobs::Scheduler& scheduler) noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getFrameGraph() const noexcept -> const vx::jobs::FrameGraph& {return m_graph;}
+			[[nodiscard]]
+			constexpr auto getWorld() const noexcept -> World& {return *m_world;}
+
+		private:
+			template <typename Func, bool HAS_COMMANDS, bool HAS_ENTITIES, typename... Ts>
+			auto addChunkSystem(
+				const vx::StringSlice& name,
+				Func&& func,
+				internal::ChunkSignature<HAS_COMMANDS, HAS_ENTITIES, Ts...>
+			) noexcept -> vx::jobs::FrameGraph::StageId;
+
+			[[nodiscard]]
+			auto getComponentResource(ComponentId id) noexcept -> vx::jobs::FrameGraph::Resource;
+			[[nodiscard]]
+			auto getCommandBuffer() noexcept -> CommandBuffer&;
+			[[nodiscard]]
+			constexpr auto getScheduler() const noexcept -> vx::jobs::Scheduler& {return *m_scheduler;}
+			auto flushCommands() noexcept -> void;
+
+			World* m_world;
+			vx::jobs::FrameGraph m_graph;
+			vx::jobs::FrameGraph::Resource m_worldResource;
+			std::unordered_map<ComponentId, vx::jobs::FrameGraph::Resource> m_componentResources;
+			std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
+			vx::jobs::Scheduler* m_scheduler;
+	};
+}
+
+#include "voxlet/ecs/schedule.inl"
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "voxlet/ecs/schedule.hpp"
+
+#include <utility>
+
+#include "voxlet/containers/string.hpp"
+#include "voxlet/jobs/parallelFor.hpp"
+
+
+namespace vx::ecs {
+	template <typename Func>
+	auto Schedule::addSystem(const vx::StringSlice& name, Func&& func) noexcept -> vx::jobs::FrameGraph::StageId {
+		using Traits = internal::SystemTraits<std::decay_t<Func>>;
+		if constexpr (Traits::IS_EXCLUSIVE) {
+			return m_graph.addStage(vx::jobs::FrameGraph::StageInfos{
+				.name = vx::String::from(name),
+				.reads = {},
+				.writes = {m_worldResource},
+				.function = [this, func = std::forward<Func> (func)]() mutable noexcept {
+					this->flushCommands();
+					func(*m_world);
+				}
+			});
+		}
+		else
+			return this->addChunkSystem(name, std::forward<Func> (func), typename Traits::Chunk {});
+	}
+
+
+	template <typename Func, bool HAS_COMMANDS, bool HAS_ENTITIES, typename... Ts>
+	auto Schedule::addChunkSystem(
+		const vx::StringSlice& name,
+		Func&& func,
+		internal::ChunkSignature<HAS_COMMANDS, HAS_ENTITIES, Ts...>
+	) noexcept -> vx::jobs::FrameGraph::StageId {
+		std::vector<vx::jobs::FrameGraph::Resource> reads {m_worldResource};
+		std::vector<vx::jobs::FrameGraph::Resource> writes {};
+		((std::is_const_v<Ts> ? reads : writes).push_back(
+			this->getComponentResource(getComponentId<std::remove_const_t<Ts>> ())
+		), ...);
+
+		return m_graph.addStage(vx::jobs::FrameGraph::StageInfos{
+			.name = vx::String::from(name),
+			.reads = std::move(reads),
+			.writes = std::move(writes),
+			.function = [this, func = std::forward<Func> (func), query = m_world->query<Ts...> ()]() mutable noexcept {
+				const auto kernel {[this, &func, &query](const std::size_t first, const std::size_t last) noexcept {
+					CommandBuffer& commands {this->getCommandBuffer()};
+					query.forEachChunkInRange(first, last, [&func, &commands](
+						const std::span<const Entity> entities,
+						const std::span<Ts>... columns
+					) noexcept {
+						if constexpr (HAS_COMMANDS && HAS_ENTITIES)
+							func(commands, entities, columns...);
+						else if constexpr (HAS_COMMANDS)
+							func(commands, columns...);
+						else if constexpr (HAS_ENTITIES)
+							func(entities, columns...);
+						else {
+							(void)commands;
+							func(columns...);
+						}
+					});
+				}};
+				vx::jobs::parallelFor(this->getScheduler(), 0uz, query.prepare(), kernel);
+				query.finish();
+			}
+		});
+	}
+}
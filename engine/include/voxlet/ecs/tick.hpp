@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace vx::ecs {
+	/*
+	 * Monotonic change counter of a world. Ticks wrap around, so they must be compared with `isNewer`,
+	 * which stays correct as long as the two ticks are less than 2^31 apart.
+	 */
+	using Tick = std::uint32_t;
+
+	[[nodiscard]]
+	constexpr auto isNewer(const Tick tick, const Tick since) noexcept -> bool {
+		return static_cast<std::int32_t> (tick - since) > 0;
+	}
+
+	[[nodiscard]]
+	constexpr auto getNewest(const Tick lhs, const Tick rhs) noexcept -> Tick {
+		return isNewer(lhs, rhs) ? lhs : rhs;
+	}
+}
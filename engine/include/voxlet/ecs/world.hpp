@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "voxlet/ecs/archetype.hpp"
+#include "voxlet/ecs/component.hpp"
+#include "voxlet/ecs/entity.hpp"
+#include "voxlet/ecs/tick.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/memory/blockPool.hpp"
+
+
+namespace vx::ecs {
+	template <typename... Ts>
+	class Query;
+
+	/*
+	 * Owns every entity and its components. Entities live in the archetype matching their exact component
+	 * set, so adding or removing a component moves the entity to another archetype. Structural changes
+	 * invalidate component pointers.
+	 * Component writes are stamped with the current change tick, which lets queries filter on what was added
+	 * or changed since their last run. Observers are notified after a component was added to an entity and
+	 * before one is removed from it. They may change the world, but not the structure of the observed entity,
+	 * and can't add or remove observers.
+	 */
+	class VOXLET_EXPORT World final {
+		public:
+			using Observer = std::function<void(World&, Entity)>;
+			using ObserverId = std::uint32_t;
+
+			World(const World&) = delete;
+			auto operator=(const World&) -> World& = delete;
+			World(World&&) = delete;
+			auto operator=(World&&) -> World& = delete;
+
+			World() noexcept;
+			~World();
+
+			template <typename... Ts>
+			requires (Component<std::remove_cvref_t<Ts>> && ...)
+			auto spawn(Ts&&... components) noexcept -> Entity;
+			auto despawn(Entity entity) noexcept -> bool;
+			[[nodiscard]]
+			auto isAlive(Entity entity) const noexcept -> bool;
+
+			/* replaces the component if the entity already has one */
+			template <typename T>
+			requires Component<std::remove_cvref_t<T>>
+			auto add(Entity entity, T&& component) noexcept -> bool;
+			template <Component T>
+			auto remove(Entity entity) noexcept -> bool;
+
+			/* flags the component as changed */
+			template <Component T>
+			[[nodiscard]]
+			auto get(Entity entity) noexcept -> T*;
+			template <Component T>
+			[[nodiscard]]
+			auto get(Entity entity) const noexcept -> const T*;
+			template <Component T>
+			[[nodiscard]]
+			auto has(Entity entity) const noexcept -> bool;
+
+			template <typename... Ts>
+			[[nodiscard]]
+			auto query() noexcept -> Query<Ts...>;
+
+			template <Component T>
+			auto onAdd(Observer&& observer) noexcept -> ObserverId;
+			template <Component T>
+			auto onRemove(Observer&& observer) noexcept -> ObserverId;
+			auto removeObserver(ObserverId id) noexcept -> bool;
+
+			[[nodiscard]]
+			auto getTick() const noexcept -> Tick {return m_tick.load(std::memory_order::relaxed);}
+			/* starts a new change tick and returns it, queries stamp the writes of one run with it */
+			auto advanceTick() noexcept -> Tick {return m_tick.fetch_add(1u, std::memory_order::relaxed) + 1u;}
+
+			[[nodiscard]]
+			constexpr auto getEntityCount() const noexcept -> std::size_t {return m_entityCount;}
+			[[nodiscard]]
+			auto getArchetypes() const noexcept -> std::span<const std::unique_ptr<Archetype>> {return m_archetypes;}
+			[[nodiscard]]
+			constexpr auto getChunkPool() const noexcept -> const vx::memory::BlockPool& {return m_chunkPool;}
+
+		private:
+			struct EntityRecord {
+				std::uint32_t generation;
+				Archetype* archetype;
+				Archetype::Location location;
+			};
+
+			struct ObserverRecord {
+				ObserverId id;
+				Observer callback;
+			};
+			using ObserverList = std::vector<std::vector<ObserverRecord>>;
+
+			/* writes outside of queries belong to the tick the next query run will start */
+			[[nodiscard]]
+			auto getWriteTick() const noexcept -> Tick {return this->getTick() + 1u;}
+
+			[[nodiscard]]
+			auto createEntity(Archetype& archetype) noexcept -> Entity;
+			[[nodiscard]]
+			auto findArchetypeWith(Archetype& archetype, ComponentId id) noexcept -> Archetype&;
+			[[nodiscard]]
+			auto findArchetypeWithout(Archetype& archetype, ComponentId id) noexcept -> Archetype&;
+			[[nodiscard]]
+			auto getOrCreateArchetype(std::vector<ComponentId>&& signature) noexcept -> Archetype&;
+			auto moveEntity(Entity entity, Archetype& destination) noexcept -> void;
+			[[nodiscard]]
+			auto findComponent(Entity entity, ComponentId id) const noexcept -> std::byte*;
+			[[nodiscard]]
+			auto touchComponent(Entity entity, ComponentId id) noexcept -> std::byte*;
+			auto addObserver(ObserverList& observers, ComponentId id, Observer&& observer) noexcept -> ObserverId;
+			auto notify(const ObserverList& observers, ComponentId id, Entity entity) noexcept -> void;
+			[[nodiscard]]
+			auto getRecord(Entity entity) const noexcept -> const EntityRecord* {
+				if (entity.index >= m_entities.size() || m_entities[entity.index].generation != entity.generation)
+					return nullptr;
+				if (m_entities[entity.index].archetype == nullptr)
+					return nullptr;
+				return &m_entities[entity.index];
+			}
+
+			vx::memory::BlockPool m_chunkPool;
+			std::vector<EntityRecord> m_entities;
+			std::vector<std::uint32_t> m_freeEntities;
+			std::size_t m_entityCount;
+			std::vector<std::unique_ptr<Archetype>> m_archetypes;
+			std::map<std::vector<ComponentId>, Archetype*> m_archetypeLookup;
+			Archetype* m_emptyArchetype;
+			std::atomic<Tick> m_tick;
+			ObserverList m_addObservers;
+			ObserverList m_removeObservers;
+			ObserverId m_nextObserverId;
+	};
+}
+
+#include "voxlet/ecs/world.inl"
+
+namespace vx {
+	using ::vx::ecs::Entity;
+	using ::vx::ecs::World;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "voxlet/ecs/world.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "voxlet/ecs/query.hpp"
+
+
+namespace vx::ecs {
+	namespace internal {
+		template <typename T, typename... Ts>
+		constexpr bool ARE_UNIQUE {(!std::is_same_v<T, Ts> && ...) && ARE_UNIQUE<Ts...>};
+		template <typename T>
+		constexpr bool ARE_UNIQUE<T> {true};
+	}
+
+
+	template <typename... Ts>
+	requires (Component<std::remove_cvref_t<Ts>> && ...)
+	auto World::spawn(Ts&&... components) noexcept -> Entity {
+		if constexpr (sizeof...(Ts) == 0uz)
+			return this->createEntity(*m_emptyArchetype);
+		else {
+			static_assert(internal::ARE_UNIQUE<std::remove_cvref_t<Ts>...>, "An entity can't own the same component twice");
+			Archetype* archetype {m_emptyArchetype};
+			((archetype = &this->findArchetypeWith(*archetype, getComponentId<std::remove_cvref_t<Ts>> ())), ...);
+			const Entity entity {this->createEntity(*archetype)};
+			const Archetype::Location location {m_entities[entity.index].location};
+			const Tick tick {this->getWriteTick()};
+			([&] {
+				const std::size_t column {archetype->findColumn(getComponentId<std::remove_cvref_t<Ts>> ())};
+				(void)std::construct_at(
+					reinterpret_cast<std::remove_cvref_t<Ts>*> (archetype->getComponent(location, column)),
+					std::forward<Ts> (components)
+				);
+				archetype->markAdded(location, column, tick);
+			}(), ...);
+			(this->notify(m_addObservers, getComponentId<std::remove_cvref_t<Ts>> (), entity), ...);
+			return entity;
+		}
+	}
+
+
+	template <typename T>
+	requires Component<std::remove_cvref_t<T>>
+	auto World::add(const Entity entity, T&& component) noexcept -> bool {
+		using Type = std::remove_cvref_t<T>;
+		const ComponentId id {getComponentId<Type> ()};
+		const EntityRecord* const record {this->getRecord(entity)};
+		if (record == nullptr)
+			return false;
+
+		/* `component` may be stored in the world, as the one it replaces or one that moving the entity moves */
+		Type value {std::forward<T> (component)};
+		const std::size_t column {record->archetype->findColumn(id)};
+		if (column != Archetype::npos) {
+			auto* const existing {reinterpret_cast<Type*> (record->archetype->getComponent(record->location, column))};
+			std::destroy_at(existing);
+			(void)std::construct_at(existing, std::move(value));
+			record->archetype->markChanged(record->location, column, this->getWriteTick());
+			return true;
+		}
+
+		Archetype& destination {this->findArchetypeWith(*record->archetype, id)};
+		this->moveEntity(entity, destination);
+		const std::size_t destinationColumn {destination.findColumn(id)};
+		(void)std::construct_at(
+			reinterpret_cast<Type*> (destination.getComponent(record->location, destinationColumn)),
+			std::move(value)
+		);
+		destination.markAdded(record->location, destinationColumn, this->getWriteTick());
+		this->notify(m_addObservers, id, entity);
+		return true;
+	}
+
+	template <Component T>
+	auto World::remove(const Entity entity) noexcept -> bool {
+		const ComponentId id {getComponentId<T> ()};
+		const EntityRecord* const record {this->getRecord(entity)};
+		if (record == nullptr || !record->archetype->has(id))
+			return false;
+		this->notify(m_removeObservers, id, entity);
+		/* the observers may have reallocated the records */
+		this->moveEntity(entity, this->findArchetypeWithout(*m_entities[entity.index].archetype, id));
+		return true;
+	}
+
+
+	template <Component T>
+	auto World::get(const Entity entity) noexcept -> T* {
+		return reinterpret_cast<T*> (this->touchComponent(entity, getComponentId<T> ()));
+	}
+
+	template <Component T>
+	auto World::get(const Entity entity) const noexcept -> const T* {
+		return reinterpret_cast<const T*> (this->findComponent(entity, getComponentId<T> ()));
+	}
+
+	template <Component T>
+	auto World::has(const Entity entity) const noexcept -> bool {
+		const EntityRecord* const record {this->getRecord(entity)};
+		return record != nullptr && record->archetype->has(getComponentId<T> ());
+	}
+
+
+	template <typename... Ts>
+	auto World::query() noexcept -> Query<Ts...> {
+		return Query<Ts...> {*this};
+	}
+
+
+	template <Component T>
+	auto World::onAdd(Observer&& observer) noexcept -> ObserverId {
+		return this->addObserver(m_addObservers, getComponentId<T> (), std::move(observer));
+	}
+
+	template <Component T>
+	auto World::onRemove(Observer&& observer) noexcept -> ObserverId {
+		return this->addObserver(m_removeObservers, getComponentId<T> (), std::move(observer));
+	}
+}
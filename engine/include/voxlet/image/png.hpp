@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+#include "voxlet/render/image.hpp"
+
+
+/*
+ * PNG decoding to RGBA8, red in the lowest byte as in `vx::render::Image`. Every color type and bit depth
+ * is supported, 16-bit channels keep their high byte, and a `tRNS` chunk becomes alpha. Interlaced images
+ * aren't supported. The CRCs of the critical chunks and of `tRNS` are checked, an image failing one is rejected.
+ * Filters are undone with one pixel per SIMD register for the 3 and 4 bytes pixels, and whole registers
+ * for `Up`, then palettes are expanded with AVX2 gathers and RGB or gray pixels with byte shuffles.
+ */
+namespace vx::image {
+	enum class PngColorType : std::uint8_t {
+		gray = 0u,
+		rgb = 2u,
+		indexed = 3u,
+		grayAlpha = 4u,
+		rgba = 6u
+	};
+
+	struct PngInfo {
+		std::uint32_t width;
+		std::uint32_t height;
+		PngColorType colorType;
+		std::uint8_t bitDepth;
+	};
+
+	/* reads the header only, `nullopt` if it isn't a PNG this decoder supports or has more than 2^28 pixels */
+	[[nodiscard]]
+	VOXLET_EXPORT auto readPngInfo(std::span<const std::byte> file) noexcept -> std::optional<PngInfo>;
+
+	/*
+	 * Writes the image to `pixels`, of `width * height` pixels, which can be any memory of the caller. Rows
+	 * are inflated and converted a few at a time, so that the filtered image is never whole in memory.
+	 */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decodePng(std::span<const std::byte> file, std::span<std::uint32_t> pixels) noexcept -> bool;
+	/*
+	 * Same, with the rows spread over the workers once inflated. A row filtered with `None` or `Sub`
+	 * doesn't depend on the one above it, so each starts a run of rows that is unfiltered independently of
+	 * the others. An image that only uses the other filters is unfiltered by a single worker.
+	 */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decodePng(
+		std::span<const std::byte> file,
+		std::span<std::uint32_t> pixels,
+		vx::jobs::Scheduler& scheduler
+	) noexcept -> bool;
+	[[nodiscard]]
+	VOXLET_EXPORT auto decodePng(std::span<const std::byte> file) noexcept -> std::optional<vx::render::Image>;
+}
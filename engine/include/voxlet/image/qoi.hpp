@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+#include "voxlet/render/image.hpp"
+
+
+/*
+ * A lossless RGBA8 codec for caching decoded textures, with the operations of QOI (index, difference, luma,
+ * run and literal pixels) in a container of the engine. The image is cut in bands of rows that each start
+ * from the initial state of the encoder, so that they're encoded and decoded independently of each other.
+ * The header gives the size of every band, which is where the parallel functions split the work.
+ *
+ * Layout, little-endian: the `VXQI` magic, the width, the height and the number of rows of a band as
+ * 32-bit integers, then the size in bytes of each band as 32-bit integers, then the bands back to back.
+ */
+namespace vx::image {
+	struct QoiInfo {
+		std::uint32_t width;
+		std::uint32_t height;
+		/* the last band can have fewer */
+		std::uint32_t bandHeight;
+		std::uint32_t bandCount;
+	};
+
+	/* reads the header only, `nullopt` if it's invalid or has more than 2^28 pixels */
+	[[nodiscard]]
+	VOXLET_EXPORT auto readQoiInfo(std::span<const std::byte> file) noexcept -> std::optional<QoiInfo>;
+
+	/* fails when the image is empty or has more than 2^28 pixels */
+	[[nodiscard]]
+	VOXLET_EXPORT auto encodeQoi(const vx::render::Image& image) noexcept -> std::optional<std::vector<std::byte>>;
+	/* same, with the bands spread over the workers, the file is the same */
+	[[nodiscard]]
+	VOXLET_EXPORT auto encodeQoi(const vx::render::Image& image, vx::jobs::Scheduler& scheduler) noexcept
+		-> std::optional<std::vector<std::byte>>;
+
+	/* writes the image to `pixels`, of `width * height` pixels, which can be any memory of the caller */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decodeQoi(std::span<const std::byte> file, std::span<std::uint32_t> pixels) noexcept -> bool;
+	/* same, with the bands spread over the workers */
+	[[nodiscard]]
+	VOXLET_EXPORT auto decodeQoi(
+		std::span<const std::byte> file,
+		std::span<std::uint32_t> pixels,
+		vx::jobs::Scheduler& scheduler
+	) noexcept -> bool;
+	[[nodiscard]]
+	VOXLET_EXPORT auto decodeQoi(std::span<const std::byte> file) noexcept -> std::optional<vx::render::Image>;
+}
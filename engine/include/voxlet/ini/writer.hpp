@@ -0,0 +1,65 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+
+#include "voxlet/containers/stringAccumulator.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+
+
+namespace vx::ini {
+	/*
+	 * Writes `key = value` lines grouped under `[section]` headers, the format of settings files. Section
+	 * names, keys and string values that wouldn't read back the same unquoted, empty, padded with spaces,
+	 * or with quotes, backslashes, `;`, `#` or control characters, are written as JSON strings. So are
+	 * section names with brackets and keys with `=` or `[`, which would end or start a line of another kind.
+	 */
+	template <std::size_t bufferSize = 512uz, bool hasInnerStorage = true>
+	class BasicWriter final {
+		public:
+			using Output = vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>;
+
+			BasicWriter(const BasicWriter&) = delete;
+			auto operator=(const BasicWriter&) -> BasicWriter& = delete;
+			BasicWriter(BasicWriter&&) noexcept = default;
+			auto operator=(BasicWriter&&) noexcept -> BasicWriter& = default;
+			~BasicWriter() = default;
+
+			explicit BasicWriter(vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output) noexcept :
+				m_output {&output}
+			{}
+
+			/* separated from the lines before by an empty one */
+			auto writeSection(const vx::StringSlice& name) noexcept -> void;
+			/* a `;` line for each line of `text` */
+			auto writeComment(const vx::StringSlice& text) noexcept -> void;
+
+			auto write(const vx::StringSlice& key, bool value) noexcept -> void;
+			template <std::integral T>
+			requires (!std::same_as<T, bool>)
+			auto write(const vx::StringSlice& key, T value) noexcept -> void;
+			auto write(const vx::StringSlice& key, double value) noexcept -> void;
+			auto write(const vx::StringSlice& key, const vx::StringSlice& value) noexcept -> void;
+			/* rather than the pointer to it being taken for a boolean */
+			template <std::size_t N>
+			auto write(const vx::StringSlice& key, const char8_t (&literal)[N]) noexcept -> void {
+				this->write(key, vx::StringSlice::from(literal));
+			}
+
+			[[nodiscard]]
+			constexpr auto getOutput() noexcept -> Output& {return *m_output;}
+
+		private:
+			auto pushKey(const vx::StringSlice& key) noexcept -> void;
+			/* `text` as it is, or as a JSON string if it's empty, padded, or has an escape or one of `specials` */
+			auto pushText(const vx::StringSlice& text, std::string_view specials) noexcept -> void;
+
+			Output* m_output;
+			bool m_isEmpty {true};
+	};
+
+	using Writer = BasicWriter<>;
+}
+
+#include "voxlet/ini/writer.inl"
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "voxlet/ini/writer.hpp"
+#include "voxlet/json/writer.hpp"
+
+
+namespace vx::ini {
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::writeSection(const vx::StringSlice& name) noexcept -> void {
+		if (!m_isEmpty)
+			*m_output += u8"\n";
+		*m_output += u8"[";
+		this->pushText(name, "[];#");
+		*m_output += u8"]\n";
+		m_isEmpty = false;
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::writeComment(const vx::StringSlice& text) noexcept -> void {
+		const char8_t* line {std::to_address(text.unchecked().begin())};
+		const char8_t* const end {line + text.getSize()};
+		while (true) {
+			const char8_t* const lineEnd {std::find(line, end, u8'\n')};
+			*m_output += u8"; ";
+			m_output->push(line, static_cast<std::size_t> (lineEnd - line));
+			*m_output += u8"\n";
+			if (lineEnd == end)
+				break;
+			line = lineEnd + 1;
+		}
+		m_isEmpty = false;
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const vx::StringSlice& key, const bool value) noexcept -> void {
+		this->pushKey(key);
+		if (value)
+			*m_output += u8"true\n";
+		else
+			*m_output += u8"false\n";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	template <std::integral T>
+	requires (!std::same_as<T, bool>)
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const vx::StringSlice& key, const T value) noexcept -> void {
+		this->pushKey(key);
+		vx::json::pushNumber(*m_output, value);
+		*m_output += u8"\n";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const vx::StringSlice& key, const double value) noexcept -> void {
+		this->pushKey(key);
+		vx::json::pushNumber(*m_output, value);
+		*m_output += u8"\n";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const vx::StringSlice& key, const vx::StringSlice& value)
+		noexcept
+		-> void
+	{
+		this->pushKey(key);
+		this->pushText(value, ";#");
+		*m_output += u8"\n";
+	}
+
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::pushKey(const vx::StringSlice& key) noexcept -> void {
+		this->pushText(key, "=[;#");
+		*m_output += u8" = ";
+		m_isEmpty = false;
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::pushText(const vx::StringSlice& text, const std::string_view specials)
+		noexcept
+		-> void
+	{
+		const char8_t* const data {std::to_address(text.unchecked().begin())};
+		const std::size_t size {text.getSize()};
+		const bool isQuoted {size == 0uz
+			|| data[0] == u8' '
+			|| data[size - 1uz] == u8' '
+			|| vx::json::internal::findEscape(data, size) != size
+			|| std::ranges::any_of(specials, [&](const char special) {return std::memchr(data, special, size) != nullptr;})
+		};
+		if (isQuoted)
+			vx::json::pushString(*m_output, text);
+		else
+			m_output->push(data, size);
+	}
+}
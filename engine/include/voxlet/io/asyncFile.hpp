@@ -0,0 +1,83 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/io/ioContext.hpp"
+
+
+namespace vx::io {
+	/*
+	 * Read-only file whose reads complete through an `IoContext`. Opening the file is synchronous, only the
+	 * reads are asynchronous. Results are the number of bytes read or a negated `errno` value.
+	 */
+	class VOXLET_EXPORT AsyncFile final {
+		public:
+			AsyncFile(const AsyncFile&) = delete;
+			auto operator=(const AsyncFile&) -> AsyncFile& = delete;
+
+			class ReadAwaiter final {
+				public:
+					ReadAwaiter(const ReadAwaiter&) = delete;
+					auto operator=(const ReadAwaiter&) -> ReadAwaiter& = delete;
+
+					constexpr ReadAwaiter(const AsyncFile& file, const ReadInfos& infos) noexcept :
+						m_operation {},
+						m_file {&file},
+						m_infos {infos},
+						m_handle {}
+					{}
+
+					[[nodiscard]]
+					constexpr auto await_ready() const noexcept -> bool {return false;}
+					auto await_suspend(std::coroutine_handle<> handle) noexcept -> void;
+					[[nodiscard]]
+					constexpr auto await_resume() const noexcept -> std::int64_t {return m_operation.result;}
+
+				private:
+					Operation m_operation;
+					const AsyncFile* m_file;
+					ReadInfos m_infos;
+					std::coroutine_handle<> m_handle;
+			};
+
+			AsyncFile(AsyncFile&& other) noexcept;
+			auto operator=(AsyncFile&& other) noexcept -> AsyncFile&;
+			~AsyncFile();
+
+			[[nodiscard]]
+			static auto open(IoContext& context, const vx::StringSlice& path) noexcept
+				-> std::optional<AsyncFile>;
+
+			auto read(const ReadInfos& infos, Callback callback, void* userData) const noexcept -> void;
+			[[nodiscard]]
+			auto read(const ReadInfos& infos) const noexcept -> ReadAwaiter {return ReadAwaiter{*this, infos};}
+
+			[[nodiscard]]
+			constexpr auto getSize() const noexcept -> std::uint64_t {return m_size;}
+			[[nodiscard]]
+			constexpr auto isRegistered() const noexcept -> bool {return m_fixedFile != NO_FIXED_FILE;}
+			[[gnu::always_inline]]
+			constexpr auto size() const noexcept {return this->getSize();}
+
+		private:
+			constexpr AsyncFile(IoContext& context, const int fd, const std::int32_t fixedFile, const std::uint64_t size)
+				noexcept :
+				m_context {&context},
+				m_fd {fd},
+				m_fixedFile {fixedFile},
+				m_size {size}
+			{}
+
+			auto close() noexcept -> void;
+
+			IoContext* m_context;
+			int m_fd;
+			std::int32_t m_fixedFile;
+			std::uint64_t m_size;
+	};
+}
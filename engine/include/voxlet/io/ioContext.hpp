@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+
+
+namespace vx::io {
+	enum class Backend {
+		/* io_uring when the kernel has it, the thread pool otherwise */
+		automatic,
+		ioUring,
+		threadPool
+	};
+
+	struct Operation {
+		using Completion = void(*)(Operation& operation) noexcept;
+
+		Completion completion;
+		void* userData;
+		std::int64_t result;
+	};
+
+	using Callback = void(*)(void* userData, std::int64_t result) noexcept;
+
+	constexpr std::uint32_t NO_REGISTERED_BUFFER {static_cast<std::uint32_t> (-1)};
+	constexpr std::int32_t NO_FIXED_FILE {-1};
+
+	struct ReadInfos {
+		std::span<std::byte> buffer;
+		std::uint64_t offset {0u};
+		std::uint32_t registeredBuffer {NO_REGISTERED_BUFFER};
+	};
+
+	/*
+	 * Owns the asynchronous I/O backend. Reads are only queued until `submit`, `poll` or `wait` flushes them
+	 * in one batch. Completions are delivered by `poll` and `wait`, which must always be called from the
+	 * same thread, while reads may be queued from any thread. With io_uring, a read of more than 1 GB is
+	 * split in reads of at most 1 GB that each count in the pending and completed reads.
+	 */
+	class VOXLET_EXPORT IoContext final {
+		friend class AsyncFile;
+
+		public:
+			IoContext(const IoContext&) = delete;
+			auto operator=(const IoContext&) -> IoContext& = delete;
+			IoContext(IoContext&&) = delete;
+			auto operator=(IoContext&&) -> IoContext& = delete;
+
+			struct Config {
+				Backend backend {Backend::automatic};
+				std::uint32_t queueDepth {256u};
+				std::uint32_t maxFixedFiles {1024u};
+				std::size_t fallbackThreadCount {4uz};
+				// when set, coroutines awaiting a read are resumed as jobs instead of inline in `poll`
+				vx::jobs::Scheduler* scheduler {nullptr};
+			};
+
+			IoContext() noexcept;
+			explicit IoContext(const Config& config) noexcept;
+			~IoContext();
+
+			/*
+			 * False when `Backend::ioUring` was asked for and io_uring couldn't be set up, an invalid context
+			 * can only be destroyed.
+			 */
+			[[nodiscard]]
+			auto isValid() const noexcept -> bool;
+			[[nodiscard]]
+			auto getBackend() const noexcept -> Backend;
+			[[nodiscard]]
+			auto getScheduler() const noexcept -> vx::jobs::Scheduler*;
+			[[nodiscard]]
+			auto getPendingCount() const noexcept -> std::size_t;
+
+			auto registerBuffers(std::span<const std::span<std::byte>> buffers) noexcept -> bool;
+			auto unregisterBuffers() noexcept -> void;
+
+			auto queueRead(int fd, std::int32_t fixedFile, const ReadInfos& infos, Operation& operation) noexcept -> void;
+			auto queueRead(
+				int fd,
+				std::int32_t fixedFile,
+				const ReadInfos& infos,
+				Callback callback,
+				void* userData
+			) noexcept -> void;
+
+			auto submit() noexcept -> std::size_t;
+			auto poll() noexcept -> std::size_t;
+			auto wait(std::size_t minCompletions = 1uz) noexcept -> std::size_t;
+
+		private:
+			struct UringBackend;
+			struct ThreadPoolBackend;
+
+			struct CallbackOperation {
+				Operation operation;
+				Callback callback;
+				void* userData;
+				CallbackOperation* nextFree;
+			};
+
+			[[nodiscard]]
+			auto registerFile(int fd) noexcept -> std::int32_t;
+			auto unregisterFile(std::int32_t fixedFile) noexcept -> void;
+
+			[[nodiscard]]
+			auto acquireCallbackOperation() noexcept -> CallbackOperation*;
+			auto releaseCallbackOperation(CallbackOperation* operation) noexcept -> void;
+
+			Config m_config;
+			Backend m_backend;
+			std::unique_ptr<UringBackend> m_uring;
+			std::unique_ptr<ThreadPoolBackend> m_threadPool;
+			std::mutex m_callbackMutex;
+			std::deque<CallbackOperation> m_callbackOperations;
+			CallbackOperation* m_freeCallbackOperations;
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/containers/views/uncheckedStringSlice.hpp"
+#include "voxlet/export.hpp"
+
+
+namespace vx::io {
+	enum class AccessPattern {
+		normal,
+		sequential,
+		random
+	};
+
+	/*
+	 * Read-only memory mapping of a whole file. The views point directly into the page cache, so parsers can
+	 * run on file contents without copying them. Views are invalidated when the file is destroyed.
+	 */
+	class VOXLET_EXPORT MappedFile final {
+		public:
+			using size_type = std::size_t;
+			static constexpr size_type npos {static_cast<size_type> (-1)};
+
+			MappedFile(const MappedFile&) = delete;
+			auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+			struct Config {
+				AccessPattern pattern {AccessPattern::sequential};
+				// start reading the whole file in the background right away
+				bool willNeed {false};
+				bool hugePages {false};
+				// fault every page in before `open` returns
+				bool populate {false};
+			};
+
+			constexpr MappedFile() noexcept = default;
+			MappedFile(MappedFile&& other) noexcept;
+			auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+			~MappedFile();
+
+			[[nodiscard]]
+			static auto open(const vx::StringSlice& path) noexcept -> std::optional<MappedFile>;
+			[[nodiscard]]
+			static auto open(const vx::StringSlice& path, const Config& config) noexcept -> std::optional<MappedFile>;
+
+			/*
+			 * Asks the kernel to start reading `path` into the page cache without mapping it, so a later `open`
+			 * of e.g. the next level does not stall on disk.
+			 */
+			static auto prefetch(const vx::StringSlice& path) noexcept -> bool;
+
+			auto prefetch(size_type offset = 0uz, size_type size = npos) const noexcept -> void;
+			auto advise(AccessPattern pattern) const noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getBytes() const noexcept -> std::span<const std::byte> {return {m_data, m_size};}
+			[[nodiscard]]
+			auto getText() const noexcept -> vx::StringSlice;
+			[[nodiscard]]
+			auto getUncheckedText() const noexcept -> vx::containers::views::UncheckedStringSlice;
+
+			[[nodiscard]]
+			constexpr auto getData() const noexcept -> const std::byte* {return m_data;}
+			[[nodiscard]]
+			constexpr auto getSize() const noexcept -> size_type {return m_size;}
+			[[nodiscard]]
+			constexpr auto isEmpty() const noexcept -> bool {return m_size == 0uz;}
+
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto data() const noexcept {return this->getData();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto size() const noexcept {return this->getSize();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto empty() const noexcept {return this->isEmpty();}
+
+		private:
+			constexpr MappedFile(const std::byte* const data, const size_type size) noexcept :
+				m_data {data},
+				m_size {size}
+			{}
+
+			auto unmap() noexcept -> void;
+
+			const std::byte* m_data {nullptr};
+			size_type m_size {0uz};
+	};
+}
+
+namespace vx {
+	using ::vx::io::MappedFile;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+
+namespace vx::jobs {
+	class Counter final {
+		public:
+			Counter(const Counter&) = delete;
+			auto operator=(const Counter&) -> Counter& = delete;
+			Counter(Counter&&) = delete;
+			auto operator=(Counter&&) -> Counter& = delete;
+
+			constexpr Counter() noexcept : m_value {0uz} {}
+			constexpr explicit Counter(std::size_t value) noexcept : m_value {value} {}
+			constexpr ~Counter() = default;
+
+			[[gnu::always_inline]]
+			auto add(std::size_t count) noexcept -> void {
+				(void)m_value.fetch_add(count, std::memory_order::relaxed);
+			}
+			[[gnu::always_inline]]
+			auto decrement() noexcept -> void {
+				(void)m_value.fetch_sub(1uz, std::memory_order::acq_rel);
+			}
+
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			auto isDone() const noexcept -> bool {return this->getValue() == 0uz;}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			auto getValue() const noexcept -> std::size_t {return m_value.load(std::memory_order::acquire);}
+
+		private:
+			std::atomic<std::size_t> m_value;
+	};
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "voxlet/containers/string.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+
+
+namespace vx::jobs {
+	/*
+	 * Stages declare the resources they read and write. Declaration order defines the order of two conflicting
+	 * stages, independent ones run in parallel. The DAG is only rebuilt by `execute` when the graph changed.
+	 */
+	class VOXLET_EXPORT FrameGraph final {
+		public:
+			FrameGraph(const FrameGraph&) = delete;
+			auto operator=(const FrameGraph&) -> FrameGraph& = delete;
+			FrameGraph(FrameGraph&&) = delete;
+			auto operator=(FrameGraph&&) -> FrameGraph& = delete;
+
+			using Resource = std::uint32_t;
+			using StageId = std::size_t;
+			using Duration = std::chrono::nanoseconds;
+			static constexpr StageId npos {std::numeric_limits<StageId>::max()};
+
+			struct StageInfos {
+				vx::String name;
+				std::vector<Resource> reads;
+				std::vector<Resource> writes;
+				std::function<void()> function;
+			};
+
+			struct StageTiming {
+				vx::StringSlice name;
+				Duration start;
+				Duration duration;
+				bool isOnCriticalPath;
+			};
+
+			FrameGraph() noexcept;
+			~FrameGraph();
+
+			[[nodiscard]]
+			auto getResource(const vx::StringSlice& name) noexcept -> Resource;
+			auto addStage(StageInfos&& infos) noexcept -> StageId;
+			auto removeStage(const vx::StringSlice& name) noexcept -> bool;
+			[[nodiscard]]
+			auto findStage(const vx::StringSlice& name) const noexcept -> StageId;
+
+			auto compile() noexcept -> void;
+			auto execute(Scheduler& scheduler) noexcept -> void;
+
+			[[nodiscard]]
+			auto isDirty() const noexcept -> bool;
+			[[nodiscard]]
+			auto getStageCount() const noexcept -> std::size_t;
+			[[nodiscard]]
+			auto getCompilationCount() const noexcept -> std::size_t;
+			[[nodiscard]]
+			auto getDependencies(StageId stage) const noexcept -> std::span<const StageId>;
+			[[nodiscard]]
+			auto getTimings() const noexcept -> std::span<const StageTiming>;
+			[[nodiscard]]
+			auto getCriticalPath() const noexcept -> std::span<const StageId>;
+			[[nodiscard]]
+			auto getFrameDuration() const noexcept -> Duration;
+
+		private:
+			struct Node {
+				std::vector<StageId> dependencies;
+				std::vector<StageId> successors;
+				std::atomic<std::size_t> remainingDependencies;
+			};
+
+			struct StageRunner {
+				FrameGraph* graph;
+				StageId stage;
+
+				auto operator()() noexcept -> void {graph->runStage(stage);}
+			};
+
+			auto runStage(StageId stage) noexcept -> void;
+			auto computeCriticalPath() noexcept -> void;
+
+			std::vector<vx::String> m_resources;
+			std::vector<StageInfos> m_stages;
+			std::unique_ptr<Node[]> m_nodes;
+			std::vector<StageRunner> m_runners;
+			std::vector<StageId> m_roots;
+			std::vector<StageTiming> m_timings;
+			std::vector<StageId> m_criticalPath;
+			std::chrono::steady_clock::time_point m_frameStart;
+			Duration m_frameDuration;
+			Scheduler* m_scheduler;
+			Counter* m_frameCounter;
+			std::size_t m_compilationCount;
+			bool m_isDirty;
+	};
+}
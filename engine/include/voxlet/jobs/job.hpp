@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "voxlet/jobs/counter.hpp"
+
+
+namespace vx::jobs {
+	struct Job {
+		using Function = void(*)(void*) noexcept;
+
+		Function function;
+		void* data;
+		Counter* counter;
+
+		/*
+		 * The callable is referenced, not copied: it must outlive the job, which is usually guaranteed by
+		 * waiting on `counter` before leaving the scope that owns it.
+		 */
+		template <typename Func>
+		requires std::is_nothrow_invocable_v<Func&>
+		[[nodiscard]]
+		static constexpr auto from(Func& func, Counter* counter = nullptr) noexcept -> Job {
+			return Job{
+				.function = [](void* data) noexcept {(*static_cast<Func*> (data))();},
+				.data = const_cast<std::remove_const_t<Func>*> (std::addressof(func)),
+				.counter = counter
+			};
+		}
+
+		[[gnu::always_inline]]
+		auto operator()() const noexcept -> void {
+			function(data);
+			if (counter != nullptr)
+				counter->decrement();
+		}
+	};
+
+	static_assert(std::is_trivially_copyable_v<Job>);
+}
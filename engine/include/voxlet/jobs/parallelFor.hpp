@@ -0,0 +1,43 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "voxlet/jobs/scheduler.hpp"
+
+
+namespace vx::jobs {
+	constexpr std::size_t AUTOMATIC_GRAIN_SIZE {0uz};
+
+	template <typename Range>
+	using ContiguousElement = std::remove_reference_t<std::ranges::range_reference_t<Range>>;
+
+	/*
+	 * `func` either takes a `std::span` over a chunk of the range, which lets the loop body vectorize, or a
+	 * single element. The call returns once every chunk has been processed.
+	 */
+	template <std::ranges::contiguous_range Range, typename Func>
+	requires std::ranges::sized_range<Range>
+		&& (std::is_nothrow_invocable_v<Func&, std::span<ContiguousElement<Range>>>
+			|| std::is_nothrow_invocable_v<Func&, ContiguousElement<Range>&>
+		)
+	auto parallelFor(Scheduler& scheduler, Range&& range, Func&& func, std::size_t grainSize = AUTOMATIC_GRAIN_SIZE)
+		noexcept
+		-> void;
+
+	template <std::integral Index, typename Func>
+	requires std::is_nothrow_invocable_v<Func&, Index, Index>
+	auto parallelFor(Scheduler& scheduler, Index begin, Index end, Func&& func, std::size_t grainSize = AUTOMATIC_GRAIN_SIZE)
+		noexcept
+		-> void;
+
+	[[nodiscard]]
+	constexpr auto computeGrainSize(std::size_t size, std::size_t threadCount, std::size_t minimumGrainSize = 1uz)
+		noexcept
+		-> std::size_t;
+}
+
+#include "voxlet/jobs/parallelFor.inl"
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "voxlet/jobs/parallelFor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "voxlet/jobs/counter.hpp"
+#include "voxlet/jobs/job.hpp"
+
+
+namespace vx::jobs {
+	namespace internal {
+		constexpr std::size_t MIN_CHUNK_BYTES {4096uz};
+		constexpr std::size_t CHUNKS_PER_THREAD {4uz};
+
+		template <typename Index, typename Func>
+		struct ParallelForState {
+			Func* func;
+			Index begin;
+			std::size_t size;
+			std::size_t grainSize;
+			alignas(64) std::atomic<std::size_t> cursor;
+
+			auto operator()() noexcept -> void {
+				while (true) {
+					const std::size_t start {cursor.fetch_add(grainSize, std::memory_order::relaxed)};
+					if (start >= size)
+						return;
+					const std::size_t end {std::min(start + grainSize, size)};
+					(*func)(
+						static_cast<Index> (begin + static_cast<Index> (start)),
+						static_cast<Index> (begin + static_cast<Index> (end))
+					);
+				}
+			}
+		};
+	}
+
+
+	template <std::ranges::contiguous_range Range, typename Func>
+	requires std::ranges::sized_range<Range>
+		&& (std::is_nothrow_invocable_v<Func&, std::span<ContiguousElement<Range>>>
+			|| std::is_nothrow_invocable_v<Func&, ContiguousElement<Range>&>
+		)
+	auto parallelFor(Scheduler& scheduler, Range&& range, Func&& func, std::size_t grainSize) noexcept -> void {
+		using Element = ContiguousElement<Range>;
+		Element* const data {std::to_address(std::ranges::begin(range))};
+		const auto size {static_cast<std::size_t> (std::ranges::size(range))};
+		if (grainSize == AUTOMATIC_GRAIN_SIZE) {
+			grainSize = computeGrainSize(size,
+				scheduler.getThreadCount(),
+				std::max(1uz, internal::MIN_CHUNK_BYTES / sizeof(Element))
+			);
+		}
+
+		auto kernel {[&func, data](const std::size_t begin, const std::size_t end) noexcept {
+			if constexpr (std::is_nothrow_invocable_v<Func&, std::span<Element>>)
+				func(std::span<Element> {data + begin, end - begin});
+			else {
+				for (Element& element : std::span<Element> {data + begin, end - begin})
+					func(element);
+			}
+		}};
+		parallelFor(scheduler, 0uz, size, kernel, grainSize);
+	}
+
+	template <std::integral Index, typename Func>
+	requires std::is_nothrow_invocable_v<Func&, Index, Index>
+	auto parallelFor(Scheduler& scheduler, const Index begin, const Index end, Func&& func, std::size_t grainSize)
+		noexcept
+		-> void
+	{
+		if (end <= begin)
+			return;
+		const auto size {static_cast<std::size_t> (end - begin)};
+		if (grainSize == AUTOMATIC_GRAIN_SIZE)
+			grainSize = computeGrainSize(size, scheduler.getThreadCount());
+		if (size <= grainSize) {
+			func(begin, end);
+			return;
+		}
+
+		using Kernel = std::remove_reference_t<Func>;
+		internal::ParallelForState<Index, Kernel> state {
+			.func = std::addressof(func),
+			.begin = begin,
+			.size = size,
+			.grainSize = grainSize,
+			.cursor {0uz}
+		};
+		const std::size_t chunkCount {(size + grainSize - 1uz) / grainSize};
+		const std::size_t jobCount {std::min(chunkCount, scheduler.getThreadCount()) - 1uz};
+
+		Counter counter {};
+		for (std::size_t i {0uz}; i < jobCount; ++i)
+			scheduler.submit(state, counter);
+		state();
+		scheduler.wait(counter);
+	}
+
+
+	constexpr auto computeGrainSize(
+		const std::size_t size,
+		const std::size_t threadCount,
+		const std::size_t minimumGrainSize
+	) noexcept -> std::size_t {
+		const std::size_t chunkCount {std::max(threadCount, 1uz) * internal::CHUNKS_PER_THREAD};
+		return std::max((size + chunkCount - 1uz) / chunkCount, std::max(minimumGrainSize, 1uz));
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/counter.hpp"
+#include "voxlet/jobs/job.hpp"
+#include "voxlet/jobs/workStealingDeque.hpp"
+
+
+namespace vx::jobs {
+	enum class ThreadPinning {
+		none,
+		pinned
+	};
+
+	enum class SleepPolicy {
+		spin,
+		yield,
+		sleep
+	};
+
+	class VOXLET_EXPORT Scheduler final {
+		public:
+			Scheduler(const Scheduler&) = delete;
+			auto operator=(const Scheduler&) -> Scheduler& = delete;
+			Scheduler(Scheduler&&) = delete;
+			auto operator=(Scheduler&&) -> Scheduler& = delete;
+
+			static constexpr std::size_t npos {static_cast<std::size_t> (-1)};
+
+			struct Config {
+				std::size_t workerCount {npos};
+				ThreadPinning pinning {ThreadPinning::none};
+				SleepPolicy sleepPolicy {SleepPolicy::sleep};
+				std::size_t spinCount {64uz};
+			};
+
+			Scheduler() noexcept;
+			explicit Scheduler(const Config& config) noexcept;
+			~Scheduler();
+
+			auto submit(const Job& job) noexcept -> void;
+			auto submit(std::span<const Job> jobs) noexcept -> void;
+			template <typename Func>
+			requires std::is_nothrow_invocable_v<Func&>
+			[[gnu::always_inline]]
+			auto submit(Func& func, Counter& counter) noexcept -> void {
+				counter.add(1uz);
+				this->submit(Job::from(func, &counter));
+			}
+
+			auto wait(const Counter& counter) noexcept -> void;
+			[[nodiscard]]
+			auto tryRunOne() noexcept -> bool;
+
+			/*
+			 * Worker threads are indexed from 1, index 0 is shared by every thread not owned by the scheduler.
+			 * This is meant to address per-thread storage of `getThreadCount()` slots.
+			 */
+			[[nodiscard]]
+			auto getCurrentThreadIndex() const noexcept -> std::size_t;
+			[[nodiscard]]
+			auto getWorkerCount() const noexcept -> std::size_t;
+			[[nodiscard]]
+			auto getThreadCount() const noexcept -> std::size_t;
+			[[nodiscard]]
+			auto getConfig() const noexcept -> const Config&;
+
+		private:
+			struct Worker {
+				WorkStealingDeque<Job> deque;
+				std::jthread thread;
+			};
+
+			auto workerLoop(std::size_t index) noexcept -> void;
+			[[nodiscard]]
+			auto findJob(std::size_t index) noexcept -> std::optional<Job>;
+			auto idle(std::size_t& failedAttempts) noexcept -> void;
+			auto wakeUp(std::size_t count) noexcept -> void;
+
+			Config m_config;
+			std::vector<std::unique_ptr<Worker>> m_workers;
+			std::mutex m_injectionMutex;
+			std::deque<Job> m_injectionQueue;
+			std::atomic<std::size_t> m_injectionSize;
+			alignas(64) std::atomic<std::uint32_t> m_wakeEpoch;
+			std::atomic<std::size_t> m_sleepingCount;
+			std::atomic<bool> m_running;
+	};
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+
+namespace vx::jobs {
+	/*
+	 * Chase-Lev work-stealing deque, following the weak memory model formulation of Lê et al. (2013).
+	 * Only the owning thread may call `push` and `pop`, any thread may call `steal`.
+	 */
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	class WorkStealingDeque final {
+		public:
+			WorkStealingDeque(const WorkStealingDeque&) = delete;
+			auto operator=(const WorkStealingDeque&) -> WorkStealingDeque& = delete;
+			WorkStealingDeque(WorkStealingDeque&&) = delete;
+			auto operator=(WorkStealingDeque&&) -> WorkStealingDeque& = delete;
+
+			using value_type = T;
+			using size_type = std::size_t;
+
+			explicit WorkStealingDeque(size_type capacity = 1024uz) noexcept;
+			~WorkStealingDeque() = default;
+
+			auto push(const value_type& value) noexcept -> void;
+			[[nodiscard]]
+			auto pop() noexcept -> std::optional<value_type>;
+			[[nodiscard]]
+			auto steal() noexcept -> std::optional<value_type>;
+
+			[[nodiscard]]
+			auto isEmpty() const noexcept -> bool;
+			[[nodiscard]]
+			auto getSize() const noexcept -> size_type;
+			[[nodiscard]]
+			auto getCapacity() const noexcept -> size_type;
+
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			auto empty() const noexcept -> bool {return this->isEmpty();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			auto size() const noexcept -> size_type {return this->getSize();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			auto capacity() const noexcept -> size_type {return this->getCapacity();}
+
+		private:
+			struct Buffer {
+				std::int64_t mask;
+				std::unique_ptr<value_type[]> data;
+
+				[[nodiscard]]
+				[[gnu::always_inline]]
+				auto get(std::int64_t index) const noexcept -> value_type {return data[index & mask];}
+				[[gnu::always_inline]]
+				auto put(std::int64_t index, const value_type& value) noexcept -> void {data[index & mask] = value;}
+			};
+
+			auto grow(Buffer* buffer, std::int64_t top, std::int64_t bottom) noexcept -> Buffer*;
+
+			static constexpr std::size_t CACHE_LINE_SIZE {64uz};
+
+			alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_top;
+			alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_bottom;
+			alignas(CACHE_LINE_SIZE) std::atomic<Buffer*> m_buffer;
+			// thieves may still read from a retired buffer, so they are only freed with the deque
+			std::vector<std::unique_ptr<Buffer>> m_buffers;
+	};
+}
+
+#include "voxlet/jobs/workStealingDeque.inl"
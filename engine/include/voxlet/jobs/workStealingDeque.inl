@@ -0,0 +1,123 @@
+#pragma once
+
+#include "voxlet/jobs/workStealingDeque.hpp"
+
+#include <algorithm>
+#include <bit>
+
+
+namespace vx::jobs {
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	WorkStealingDeque<T>::WorkStealingDeque(size_type capacity) noexcept :
+		m_top {0},
+		m_bottom {0},
+		m_buffer {nullptr},
+		m_buffers {}
+	{
+		capacity = std::bit_ceil(std::max(capacity, 2uz));
+		m_buffers.push_back(std::make_unique<Buffer> (
+			static_cast<std::int64_t> (capacity) - 1,
+			std::make_unique_for_overwrite<value_type[]> (capacity)
+		));
+		m_buffer.store(m_buffers.back().get(), std::memory_order::relaxed);
+	}
+
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto WorkStealingDeque<T>::push(const value_type& value) noexcept -> void {
+		const std::int64_t bottom {m_bottom.load(std::memory_order::relaxed)};
+		const std::int64_t top {m_top.load(std::memory_order::acquire)};
+		Buffer* buffer {m_buffer.load(std::memory_order::relaxed)};
+		if (bottom - top > buffer->mask)
+			buffer = this->grow(buffer, top, bottom);
+		buffer->put(bottom, value);
+		std::atomic_thread_fence(std::memory_order::release);
+		m_bottom.store(bottom + 1, std::memory_order::relaxed);
+	}
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto WorkStealingDeque<T>::pop() noexcept -> std::optional<value_type> {
+		const std::int64_t bottom {m_bottom.load(std::memory_order::relaxed) - 1};
+		Buffer* const buffer {m_buffer.load(std::memory_order::relaxed)};
+		m_bottom.store(bottom, std::memory_order::relaxed);
+		std::atomic_thread_fence(std::memory_order::seq_cst);
+		std::int64_t top {m_top.load(std::memory_order::relaxed)};
+
+		if (top > bottom) {
+			m_bottom.store(bottom + 1, std::memory_order::relaxed);
+			return std::nullopt;
+		}
+
+		const value_type value {buffer->get(bottom)};
+		if (top != bottom)
+			return value;
+
+		const bool won {m_top.compare_exchange_strong(top, top + 1,
+			std::memory_order::seq_cst,
+			std::memory_order::relaxed
+		)};
+		m_bottom.store(bottom + 1, std::memory_order::relaxed);
+		if (!won)
+			return std::nullopt;
+		return value;
+	}
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto WorkStealingDeque<T>::steal() noexcept -> std::optional<value_type> {
+		std::int64_t top {m_top.load(std::memory_order::acquire)};
+		std::atomic_thread_fence(std::memory_order::seq_cst);
+		const std::int64_t bottom {m_bottom.load(std::memory_order::acquire)};
+		if (top >= bottom)
+			return std::nullopt;
+
+		const Buffer* const buffer {m_buffer.load(std::memory_order::acquire)};
+		const value_type value {buffer->get(top)};
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order::seq_cst, std::memory_order::relaxed))
+			return std::nullopt;
+		return value;
+	}
+
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto WorkStealingDeque<T>::isEmpty() const noexcept -> bool {
+		return this->getSize() == 0uz;
+	}
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto WorkStealingDeque<T>::getSize() const noexcept -> size_type {
+		const std::int64_t bottom {m_bottom.load(std::memory_order::relaxed)};
+		const std::int64_t top {m_top.load(std::memory_order::relaxed)};
+		return bottom > top ? static_cast<size_type> (bottom - top) : 0uz;
+	}
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto WorkStealingDeque<T>::getCapacity() const noexcept -> size_type {
+		return static_cast<size_type> (m_buffer.load(std::memory_order::relaxed)->mask + 1);
+	}
+
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto WorkStealingDeque<T>::grow(Buffer* const buffer, const std::int64_t top, const std::int64_t bottom)
+		noexcept
+		-> Buffer*
+	{
+		const auto capacity {static_cast<std::size_t> (buffer->mask + 1) * 2uz};
+		m_buffers.push_back(std::make_unique<Buffer> (
+			static_cast<std::int64_t> (capacity) - 1,
+			std::make_unique_for_overwrite<value_type[]> (capacity)
+		));
+		Buffer* const newBuffer {m_buffers.back().get()};
+		for (std::int64_t i {top}; i != bottom; ++i)
+			newBuffer->put(i, buffer->get(i));
+		m_buffer.store(newBuffer, std::memory_order::release);
+		return newBuffer;
+	}
+}
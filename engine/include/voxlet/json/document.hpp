@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+#include "voxlet/containers/string.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/containers/views/uncheckedStringSlice.hpp"
+#include "voxlet/export.hpp"
+
+
+namespace vx::json {
+	enum class Type : std::uint8_t {
+		null,
+		boolean,
+		number,
+		string,
+		array,
+		object
+	};
+
+	namespace internal {
+		/* a value of the tape, containers are followed by their values and object members by their key */
+		struct Node {
+			/*
+			 * The offset of the first character in the text for a string, the index of the node after the last
+			 * value for a container, the bits of the `std::int64_t` or `double` for a number, 0 or 1 for a boolean.
+			 */
+			std::uint64_t payload;
+			/* the size of a string in bytes, the number of values or members of a container */
+			std::uint32_t size;
+			Type type;
+			/* a string with escape sequences, a number written as an integer that fits in `std::int64_t` */
+			bool flag;
+		};
+	}
+
+	class Document;
+	struct Member;
+	class Elements;
+	class Members;
+
+	/*
+	 * A value of a document, valid as long as the document stays where it is and its text too. A lookup
+	 * that fails gives an invalid value, on which every lookup fails too, so that a path can be followed
+	 * without a check at each step.
+	 */
+	class VOXLET_EXPORT Value final {
+		friend class Document;
+		friend class Elements;
+		friend class Members;
+
+		public:
+			constexpr Value() noexcept = default;
+
+			[[nodiscard]]
+			constexpr auto isValid() const noexcept -> bool {return m_document != nullptr;}
+			/* `null` for an invalid value */
+			[[nodiscard]]
+			auto getType() const noexcept -> Type;
+
+			[[nodiscard]]
+			auto asBoolean() const noexcept -> std::optional<bool>;
+			[[nodiscard]]
+			auto asNumber() const noexcept -> std::optional<double>;
+			/* only for a number written without fraction nor exponent that fits */
+			[[nodiscard]]
+			auto asInteger() const noexcept -> std::optional<std::int64_t>;
+			/* the characters between the quotes in the text, escape sequences included */
+			[[nodiscard]]
+			auto asString() const noexcept -> std::optional<vx::containers::views::UncheckedStringSlice>;
+			[[nodiscard]]
+			auto hasEscapes() const noexcept -> bool;
+			/* a copy of the string with its escape sequences decoded, only needed when it has some */
+			[[nodiscard]]
+			auto unescape() const noexcept -> std::optional<vx::String>;
+
+			/* the number of values of an array or members of an object, zero otherwise */
+			[[nodiscard]]
+			auto getSize() const noexcept -> std::size_t;
+			/* walks the members, skipping over their values without looking into them */
+			[[nodiscard]]
+			auto operator[](const vx::StringSlice& key) const noexcept -> Value;
+			[[nodiscard]]
+			auto operator[](std::size_t index) const noexcept -> Value;
+			/* empty when it's not an array */
+			[[nodiscard]]
+			auto getElements() const noexcept -> Elements;
+			/* empty when it's not an object */
+			[[nodiscard]]
+			auto getMembers() const noexcept -> Members;
+
+		private:
+			constexpr Value(const Document* document, const std::uint32_t node) noexcept :
+				m_document {document},
+				m_node {node}
+			{}
+
+			[[nodiscard]]
+			auto getNode() const noexcept -> const internal::Node*;
+
+			const Document* m_document {nullptr};
+			std::uint32_t m_node {0u};
+	};
+
+	struct Member {
+		/* as `Value::asString` gives it */
+		vx::containers::views::UncheckedStringSlice key;
+		Value value;
+	};
+
+	class VOXLET_EXPORT Elements final {
+		friend class Value;
+
+		public:
+			class Iterator final {
+				friend class Elements;
+
+				public:
+					using iterator_concept = std::forward_iterator_tag;
+					using value_type = Value;
+					using difference_type = std::ptrdiff_t;
+
+					constexpr Iterator() noexcept = default;
+
+					[[nodiscard]]
+					auto operator*() const noexcept -> Value;
+					auto operator++() noexcept -> Iterator&;
+					auto operator++(int) noexcept -> Iterator;
+					[[nodiscard]]
+					constexpr auto operator==(const Iterator& other) const noexcept -> bool {return m_node == other.m_node;}
+
+				private:
+					constexpr Iterator(const Document* document, const std::uint32_t node) noexcept :
+						m_document {document},
+						m_node {node}
+					{}
+
+					const Document* m_document {nullptr};
+					std::uint32_t m_node {0u};
+			};
+
+			[[nodiscard]]
+			constexpr auto begin() const noexcept -> Iterator {return {m_document, m_first};}
+			[[nodiscard]]
+			constexpr auto end() const noexcept -> Iterator {return {m_document, m_last};}
+
+		private:
+			constexpr Elements(const Document* document, const std::uint32_t first, const std::uint32_t last) noexcept :
+				m_document {document},
+				m_first {first},
+				m_last {last}
+			{}
+
+			const Document* m_document;
+			std::uint32_t m_first;
+			std::uint32_t m_last;
+	};
+
+	class VOXLET_EXPORT Members final {
+		friend class Value;
+
+		public:
+			class Iterator final {
+				friend class Members;
+
+				public:
+					using iterator_concept = std::forward_iterator_tag;
+					using value_type = Member;
+					using difference_type = std::ptrdiff_t;
+
+					constexpr Iterator() noexcept = default;
+
+					[[nodiscard]]
+					auto operator*() const noexcept -> Member;
+					auto operator++() noexcept -> Iterator&;
+					auto operator++(int) noexcept -> Iterator;
+					[[nodiscard]]
+					constexpr auto operator==(const Iterator& other) const noexcept -> bool {return m_node == other.m_node;}
+
+				private:
+					constexpr Iterator(const Document* document, const std::uint32_t node) noexcept :
+						m_document {document},
+						m_node {node}
+					{}
+
+					const Document* m_document {nullptr};
+					/* the key of the member */
+					std::uint32_t m_node {0u};
+			};
+
+			[[nodiscard]]
+			constexpr auto begin() const noexcept -> Iterator {return {m_document, m_first};}
+			[[nodiscard]]
+			constexpr auto end() const noexcept -> Iterator {return {m_document, m_last};}
+
+		private:
+			constexpr Members(const Document* document, const std::uint32_t first, const std::uint32_t last) noexcept :
+				m_document {document},
+				m_first {first},
+				m_last {last}
+			{}
+
+			const Document* m_document;
+			std::uint32_t m_first;
+			std::uint32_t m_last;
+	};
+
+	static_assert(std::forward_iterator<Elements::Iterator>);
+	static_assert(std::forward_iterator<Members::Iterator>);
+
+
+	/*
+	 * A JSON text parsed in two passes in the way of simdjson. The first one classifies 64 bytes at a time
+	 * with AVX2, finds which ones are inside strings from the unescaped quotes, and keeps the offsets of
+	 * the structural characters, of the quotes and of the first character of the other values. The second
+	 * one walks those offsets alone to check the grammar and write a tape of 16 bytes per value, where a
+	 * container knows where it ends so that lookups skip whole values. Strings aren't copied, they're
+	 * slices of the text that is kept by the caller, and numbers are converted once while parsing.
+	 * Escape sequences and numbers are validated, UTF-8 isn't.
+	 */
+	class VOXLET_EXPORT Document final {
+		friend class Value;
+		friend class Elements;
+		friend class Members;
+
+		public:
+			Document(const Document&) = delete;
+			auto operator=(const Document&) -> Document& = delete;
+			Document(Document&&) noexcept = default;
+			auto operator=(Document&&) noexcept -> Document& = default;
+			~Document() = default;
+
+			/* `text` must outlive the document, `nullopt` if it isn't valid JSON or is 4 GB or more */
+			[[nodiscard]]
+			static auto parse(const vx::StringSlice& text) noexcept -> std::optional<Document>;
+
+			[[nodiscard]]
+			auto getRoot() const noexcept -> Value;
+
+		private:
+			Document() noexcept = default;
+
+			/* the node after `node` and the values it contains */
+			[[nodiscard]]
+			auto getNext(std::uint32_t node) const noexcept -> std::uint32_t;
+
+			vx::containers::views::UncheckedStringSlice m_text {};
+			std::vector<internal::Node> m_nodes {};
+	};
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "voxlet/containers/stringAccumulator.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+
+
+namespace vx::json {
+	enum class Style : std::uint8_t {
+		compact,
+		/* a value or member per line, indented with a tab per level */
+		pretty
+	};
+
+	namespace internal {
+		/* the offset of the first quote, backslash or control character of `text`, `size` if there's none */
+		[[nodiscard]]
+		VOXLET_EXPORT auto findEscape(const char8_t* text, std::size_t size) noexcept -> std::size_t;
+	}
+
+	/* `string` between quotes, with its quotes, backslashes and control characters escaped */
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto pushString(
+		vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output,
+		const vx::StringSlice& string
+	) noexcept -> void;
+	/* the shortest text that reads back to the same value, `nan` and `inf` aren't JSON */
+	template <std::size_t bufferSize, bool hasInnerStorage, typename T>
+	requires ((std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>)
+	auto pushNumber(vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output, T value) noexcept
+		-> void;
+
+
+	/*
+	 * Writes a JSON text to an accumulator as its values are given, without building a tree first. The
+	 * accumulator can be streamed and cleared at any point, the writer only keeps the containers it is in.
+	 * Each value of an object must follow its key, and misuses are only caught by assertions.
+	 */
+	template <std::size_t bufferSize = 512uz, bool hasInnerStorage = true>
+	class BasicWriter final {
+		public:
+			using Output = vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>;
+
+			BasicWriter(const BasicWriter&) = delete;
+			auto operator=(const BasicWriter&) -> BasicWriter& = delete;
+			BasicWriter(BasicWriter&&) noexcept = default;
+			auto operator=(BasicWriter&&) noexcept -> BasicWriter& = default;
+			~BasicWriter() = default;
+
+			/* spelled out rather than `Output` for the template arguments to be deduced from it */
+			explicit BasicWriter(vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output, const Style style = Style::compact)
+				noexcept :
+				m_output {&output},
+				m_style {style}
+			{}
+
+			auto beginObject() noexcept -> void;
+			auto endObject() noexcept -> void;
+			auto beginArray() noexcept -> void;
+			auto endArray() noexcept -> void;
+
+			/* the key of the next value, inside an object */
+			auto writeKey(const vx::StringSlice& key) noexcept -> void;
+			template <std::size_t N>
+			auto writeKey(const char8_t (&literal)[N]) noexcept -> void {
+				this->writeKey(vx::StringSlice::from(literal));
+			}
+
+			auto writeNull() noexcept -> void;
+			auto write(bool value) noexcept -> void;
+			template <std::integral T>
+			requires (!std::same_as<T, bool>)
+			auto write(T value) noexcept -> void;
+			/* `nan` and infinities are written as `null` */
+			auto write(double value) noexcept -> void;
+			auto write(const vx::StringSlice& value) noexcept -> void;
+			/* rather than the pointer to it being taken for a boolean */
+			template <std::size_t N>
+			auto write(const char8_t (&literal)[N]) noexcept -> void {
+				this->write(vx::StringSlice::from(literal));
+			}
+
+			/* whether a root value was written and every container it opened is closed */
+			[[nodiscard]]
+			auto isComplete() const noexcept -> bool;
+			[[nodiscard]]
+			constexpr auto getOutput() noexcept -> Output& {return *m_output;}
+
+		private:
+			struct Container {
+				bool isObject;
+				bool isEmpty;
+			};
+
+			/* what separates a value from the one before it */
+			auto beginValue() noexcept -> void;
+			auto beginContainer(bool isObject) noexcept -> void;
+			auto endContainer(bool isObject) noexcept -> void;
+			auto pushLineBreak() noexcept -> void;
+
+			Output* m_output;
+			Style m_style;
+			std::vector<Container> m_containers {};
+			bool m_isAfterKey {false};
+			bool m_hasRoot {false};
+	};
+
+	using Writer = BasicWriter<>;
+}
+
+#include "voxlet/json/writer.inl"
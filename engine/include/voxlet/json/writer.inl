@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+#include "voxlet/json/writer.hpp"
+
+
+namespace vx::json {
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto pushString(
+		vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output,
+		const vx::StringSlice& string
+	) noexcept -> void {
+		constexpr char8_t HEX_DIGITS[] {u8"0123456789abcdef"};
+		output += u8"\"";
+		const char8_t* position {std::to_address(string.unchecked().begin())};
+		std::size_t size {string.getSize()};
+		while (true) {
+			/* the characters between two escapes are pushed at once */
+			const std::size_t unescapedSize {internal::findEscape(position, size)};
+			output.push(position, unescapedSize);
+			if (unescapedSize == size)
+				break;
+			const char8_t character {position[unescapedSize]};
+			position += unescapedSize + 1uz;
+			size -= unescapedSize + 1uz;
+			switch (character) {
+				case u8'"': output += u8"\\\""; break;
+				case u8'\\': output += u8"\\\\"; break;
+				case u8'\n': output += u8"\\n"; break;
+				case u8'\r': output += u8"\\r"; break;
+				case u8'\t': output += u8"\\t"; break;
+				case u8'\b': output += u8"\\b"; break;
+				case u8'\f': output += u8"\\f"; break;
+				default: {
+					const char8_t escape[] {u8'\\', u8'u', u8'0', u8'0', HEX_DIGITS[character >> 4u], HEX_DIGITS[character & 0xfu]};
+					output.push(escape, sizeof(escape));
+					break;
+				}
+			}
+		}
+		output += u8"\"";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage, typename T>
+	requires ((std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>)
+	auto pushNumber(vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output, const T value) noexcept
+		-> void
+	{
+		/* the sign, the digits and for floating points `e-308` and a dot */
+		char buffer[std::numeric_limits<T>::max_digits10 + std::numeric_limits<T>::digits10 + 16] {};
+		const std::to_chars_result result {std::to_chars(std::begin(buffer), std::end(buffer), value)};
+		assert(result.ec == std::errc{});
+		output.push(reinterpret_cast<const char8_t*> (buffer), static_cast<std::size_t> (result.ptr - buffer));
+	}
+
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::beginObject() noexcept -> void {
+		this->beginContainer(true);
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::endObject() noexcept -> void {
+		this->endContainer(true);
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::beginArray() noexcept -> void {
+		this->beginContainer(false);
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::endArray() noexcept -> void {
+		this->endContainer(false);
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::writeKey(const vx::StringSlice& key) noexcept -> void {
+		assert(!m_containers.empty() && m_containers.back().isObject && !m_isAfterKey);
+		Container& container {m_containers.back()};
+		if (!container.isEmpty)
+			*m_output += u8",";
+		container.isEmpty = false;
+		this->pushLineBreak();
+		pushString(*m_output, key);
+		if (m_style == Style::pretty)
+			*m_output += u8": ";
+		else
+			*m_output += u8":";
+		m_isAfterKey = true;
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::writeNull() noexcept -> void {
+		this->beginValue();
+		*m_output += u8"null";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const bool value) noexcept -> void {
+		this->beginValue();
+		if (value)
+			*m_output += u8"true";
+		else
+			*m_output += u8"false";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	template <std::integral T>
+	requires (!std::same_as<T, bool>)
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const T value) noexcept -> void {
+		this->beginValue();
+		pushNumber(*m_output, value);
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const double value) noexcept -> void {
+		this->beginValue();
+		if (std::isfinite(value))
+			pushNumber(*m_output, value);
+		else
+			*m_output += u8"null";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::write(const vx::StringSlice& value) noexcept -> void {
+		this->beginValue();
+		pushString(*m_output, value);
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::isComplete() const noexcept -> bool {
+		return m_hasRoot && m_containers.empty();
+	}
+
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::beginValue() noexcept -> void {
+		if (m_containers.empty()) {
+			assert(!m_hasRoot);
+			m_hasRoot = true;
+			return;
+		}
+		Container& container {m_containers.back()};
+		if (container.isObject) {
+			assert(m_isAfterKey);
+			m_isAfterKey = false;
+			return;
+		}
+		if (!container.isEmpty)
+			*m_output += u8",";
+		container.isEmpty = false;
+		this->pushLineBreak();
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::beginContainer(const bool isObject) noexcept -> void {
+		this->beginValue();
+		if (isObject)
+			*m_output += u8"{";
+		else
+			*m_output += u8"[";
+		m_containers.push_back({.isObject = isObject, .isEmpty = true});
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::endContainer(const bool isObject) noexcept -> void {
+		assert(!m_containers.empty() && m_containers.back().isObject == isObject && !m_isAfterKey);
+		const bool isEmpty {m_containers.back().isEmpty};
+		m_containers.pop_back();
+		/* empty containers stay on the line they were opened */
+		if (!isEmpty)
+			this->pushLineBreak();
+		if (isObject)
+			*m_output += u8"}";
+		else
+			*m_output += u8"]";
+	}
+
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto BasicWriter<bufferSize, hasInnerStorage>::pushLineBreak() noexcept -> void {
+		if (m_style != Style::pretty)
+			return;
+		constexpr char8_t TABS[] {u8"\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"};
+		*m_output += u8"\n";
+		for (std::size_t tabs {m_containers.size()}; tabs != 0uz;) {
+			const std::size_t pushedTabs {std::min(tabs, sizeof(TABS) - 1uz)};
+			m_output->push(TABS, pushedTabs);
+			tabs -= pushedTabs;
+		}
+	}
+}
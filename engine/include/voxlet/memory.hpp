@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstring>
+#include <memory>
 #include <span>
 #include <type_traits>
 #include <vector>
@@ -46,4 +47,32 @@ namespace vx::memory {
 			(void)std::memset(mem, 0, size * sizeof(T));
 		}
 	}
+
+	[[nodiscard]]
+	constexpr auto alignUp(const std::size_t value, const std::size_t alignment) noexcept -> std::size_t {
+		return (value + alignment - 1uz) & ~(alignment - 1uz);
+	}
+
+	/*
+	 * Whether a `T` can be moved to another address with a plain memcpy, skipping its move constructor and
+	 * the destructor of the source. Specialize it for types which don't point into themselves.
+	 */
+	template <typename T>
+	constexpr bool IS_TRIVIALLY_RELOCATABLE {std::is_trivially_copyable_v<T>};
+
+	/* moves `size` objects to uninitialized memory and ends the lifetime of the sources */
+	template <typename T>
+	requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+	auto relocate(T* __restrict dst, T* __restrict src, const std::size_t size) noexcept -> void {
+		if constexpr (IS_TRIVIALLY_RELOCATABLE<T>) {
+			if (size != 0uz)
+				(void)std::memcpy(static_cast<void*> (dst), static_cast<const void*> (src), size * sizeof(T));
+		}
+		else {
+			for (std::size_t i {0uz}; i < size; ++i) {
+				(void)std::construct_at(dst + i, std::move(src[i]));
+				std::destroy_at(src + i);
+			}
+		}
+	}
 }
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::memory {
+	/*
+	 * Pool of fixed-size blocks, each aligned to its own size, carved out of slabs of `blocksPerSlab` blocks.
+	 * Freed blocks are recycled and slabs are only returned to the system when the pool is destroyed. The
+	 * pool is not thread-safe.
+	 */
+	class VOXLET_EXPORT BlockPool final {
+		public:
+			BlockPool(const BlockPool&) = delete;
+			auto operator=(const BlockPool&) -> BlockPool& = delete;
+			BlockPool(BlockPool&&) = delete;
+			auto operator=(BlockPool&&) -> BlockPool& = delete;
+
+			explicit BlockPool(std::size_t blockSize, std::size_t blocksPerSlab = 64uz) noexcept;
+			~BlockPool();
+
+			[[nodiscard]]
+			auto allocate() noexcept -> void*;
+			auto deallocate(void* block) noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getBlockSize() const noexcept -> std::size_t {return m_blockSize;}
+			[[nodiscard]]
+			constexpr auto getUsedCount() const noexcept -> std::size_t {return m_usedCount;}
+			[[nodiscard]]
+			auto getSlabCount() const noexcept -> std::size_t {return m_slabs.size();}
+
+		private:
+			struct FreeBlock {
+				FreeBlock* next;
+			};
+
+			std::size_t m_blockSize;
+			std::size_t m_blocksPerSlab;
+			std::size_t m_usedCount;
+			FreeBlock* m_freeBlocks;
+			std::vector<void*> m_slabs;
+	};
+}
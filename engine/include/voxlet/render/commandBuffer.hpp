@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "voxlet/export.hpp"
+#include "voxlet/memory/blockPool.hpp"
+#include "voxlet/render/glStateCache.hpp"
+#include "voxlet/render/sortKey.hpp"
+
+
+namespace vx::render {
+	enum class CommandType : std::uint8_t {
+		draw,
+		drawIndexed,
+		clear,
+		viewport
+	};
+
+	struct TextureBinding {
+		/* 0 leaves the unit as it is */
+		GLenum target;
+		GLuint texture;
+	};
+
+	/* everything a draw depends on, so that draws don't depend on the order they are executed in */
+	struct RenderState {
+		static constexpr std::size_t TEXTURE_COUNT {4uz};
+
+		GLuint program;
+		GLuint vertexArray;
+		/* bound to the unit of their index */
+		std::array<TextureBinding, TEXTURE_COUNT> textures;
+		GLenum blendSource;
+		GLenum blendDestination;
+		bool blend;
+		bool depthTest;
+	};
+
+	struct DrawCommand {
+		RenderState state;
+		GLenum mode;
+		GLint first;
+		GLsizei count;
+		GLsizei instanceCount;
+		GLuint baseInstance;
+	};
+
+	struct DrawIndexedCommand {
+		RenderState state;
+		GLenum mode;
+		GLsizei count;
+		GLenum indexType;
+		/* in bytes, into the element array buffer of the vertex array */
+		std::size_t indexOffset;
+		GLsizei instanceCount;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	struct ClearCommand {
+		std::array<float, 4> color;
+		float depth;
+		GLbitfield mask;
+	};
+
+	struct ViewportCommand {
+		GLint x;
+		GLint y;
+		GLsizei width;
+		GLsizei height;
+	};
+
+
+	/*
+	 * Render commands recorded by one thread, without touching GL. Commands are plain structs copied in
+	 * place in recycled blocks, each with a 64-bit sort key which decides when it executes relative to every
+	 * other command of the frame, smaller keys first. `sort` orders the keys on the recording thread so that
+	 * the render thread only merges sorted runs, see `CommandQueue`. Commands with the same key keep their
+	 * recording order.
+	 */
+	class VOXLET_EXPORT CommandBuffer final {
+		friend class CommandQueue;
+
+		public:
+			static constexpr std::size_t BLOCK_SIZE {16384uz};
+
+			CommandBuffer(const CommandBuffer&) = delete;
+			auto operator=(const CommandBuffer&) -> CommandBuffer& = delete;
+			CommandBuffer(CommandBuffer&&) = delete;
+			auto operator=(CommandBuffer&&) -> CommandBuffer& = delete;
+
+			CommandBuffer() noexcept;
+			~CommandBuffer();
+
+			auto draw(std::uint64_t key, const DrawCommand& command) noexcept -> void;
+			auto drawIndexed(std::uint64_t key, const DrawIndexedCommand& command) noexcept -> void;
+			auto clearFramebuffer(std::uint64_t key, const ClearCommand& command) noexcept -> void;
+			auto setViewport(std::uint64_t key, const ViewportCommand& command) noexcept -> void;
+
+			/* sorts the commands by key, required before submitting them */
+			auto sort() noexcept -> void;
+			/* drops every command, once they were executed */
+			auto clear() noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto isSorted() const noexcept -> bool {return m_sorted;}
+			[[nodiscard]]
+			constexpr auto getEntries() const noexcept -> std::span<const SortEntry> {return m_entries;}
+			[[nodiscard]]
+			constexpr auto getCommandCount() const noexcept -> std::size_t {return m_entries.size();}
+			[[nodiscard]]
+			constexpr auto isEmpty() const noexcept -> bool {return m_entries.empty();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto size() const noexcept {return this->getCommandCount();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto empty() const noexcept {return this->isEmpty();}
+
+		private:
+			/* the value of an entry points to the header, followed by the command */
+			struct Header {
+				CommandType type;
+			};
+
+			template <typename T>
+			requires std::is_trivially_copyable_v<T>
+			auto record(std::uint64_t key, CommandType type, const T& command) noexcept -> void;
+			template <typename T>
+			[[nodiscard]]
+			static auto getPayload(const Header& header) noexcept -> const T&;
+			[[nodiscard]]
+			auto allocate(std::size_t size, std::size_t alignment) noexcept -> std::byte*;
+
+			vx::memory::BlockPool m_blockPool;
+			std::vector<void*> m_blocks;
+			std::byte* m_cursor;
+			std::byte* m_end;
+			std::vector<SortEntry> m_entries;
+			std::vector<SortEntry> m_scratch;
+			bool m_sorted;
+	};
+
+
+	/*
+	 * Merges the sorted command buffers of a frame into one flat array, then walks it on the thread owning
+	 * the GL context and translates each command, binding through a `GlStateCache`. Buffers are merged in
+	 * the order they are given, which breaks ties between equal keys, and must outlive `execute`.
+	 */
+	class VOXLET_EXPORT CommandQueue final {
+		public:
+			CommandQueue(const CommandQueue&) = delete;
+			auto operator=(const CommandQueue&) -> CommandQueue& = delete;
+			CommandQueue(CommandQueue&&) noexcept = default;
+			auto operator=(CommandQueue&&) noexcept -> CommandQueue& = default;
+
+			CommandQueue() noexcept;
+			~CommandQueue() = default;
+
+			auto merge(std::span<CommandBuffer* const> buffers) noexcept -> void;
+			auto execute(GlStateCache& state) noexcept -> void;
+			auto submit(std::span<CommandBuffer* const> buffers, GlStateCache& state) noexcept -> void;
+
+			/* the merged commands, values point to their header */
+			[[nodiscard]]
+			constexpr auto getEntries() const noexcept -> std::span<const SortEntry> {return m_entries;}
+
+		private:
+			struct Run {
+				const SortEntry* current;
+				const SortEntry* end;
+				std::size_t index;
+			};
+
+			std::vector<SortEntry> m_entries;
+			std::vector<Run> m_runs;
+	};
+}
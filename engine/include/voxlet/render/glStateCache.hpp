@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::render {
+	/*
+	 * Shadow of the GL binding state of one context, which forwards a call to glad only when it changes
+	 * something. Every value starts unknown, so the first call of each kind is always issued. Code changing
+	 * the state behind the cache, including deleting bound objects without `forget*`, must call `invalidate`.
+	 * Targets and capabilities the cache doesn't track are always issued.
+	 */
+	class VOXLET_EXPORT GlStateCache final {
+		public:
+			GlStateCache(const GlStateCache&) = delete;
+			auto operator=(const GlStateCache&) -> GlStateCache& = delete;
+			GlStateCache(GlStateCache&&) noexcept = default;
+			auto operator=(GlStateCache&&) noexcept -> GlStateCache& = default;
+
+			struct Stats {
+				std::size_t issuedCount;
+				std::size_t elidedCount;
+			};
+
+			static constexpr std::size_t TEXTURE_UNIT_COUNT {32uz};
+
+			GlStateCache() noexcept;
+			~GlStateCache() = default;
+
+			auto useProgram(GLuint program) noexcept -> void;
+			auto bindVertexArray(GLuint array) noexcept -> void;
+			auto bindBuffer(GLenum target, GLuint buffer) noexcept -> void;
+			auto activeTexture(GLenum unit) noexcept -> void;
+			/* binds to the active unit */
+			auto bindTexture(GLenum target, GLuint texture) noexcept -> void;
+			/* binds to `GL_TEXTURE0 + unit`, which only becomes the active unit if the binding changes */
+			auto bindTextureUnit(GLuint unit, GLenum target, GLuint texture) noexcept -> void;
+			auto setEnabled(GLenum capability, bool enabled) noexcept -> void;
+			auto blendFunc(GLenum source, GLenum destination) noexcept -> void;
+			auto viewport(GLint x, GLint y, GLsizei width, GLsizei height) noexcept -> void;
+
+			/* GL unbinds deleted objects, these mirror it once they are deleted */
+			auto forgetProgram(GLuint program) noexcept -> void;
+			auto forgetVertexArray(GLuint array) noexcept -> void;
+			auto forgetBuffer(GLuint buffer) noexcept -> void;
+			auto forgetTexture(GLuint texture) noexcept -> void;
+			/* makes every value unknown */
+			auto invalidate() noexcept -> void;
+
+			/* resets the counters */
+			auto beginFrame() noexcept -> void {m_stats = Stats{0uz, 0uz};}
+			/* calls forwarded to and skipped since `beginFrame` */
+			[[nodiscard]]
+			constexpr auto getStats() const noexcept -> const Stats& {return m_stats;}
+
+		private:
+			static constexpr std::array<GLenum, 13> BUFFER_TARGETS {
+				GL_ARRAY_BUFFER,
+				GL_ELEMENT_ARRAY_BUFFER,
+				GL_COPY_READ_BUFFER,
+				GL_COPY_WRITE_BUFFER,
+				GL_PIXEL_PACK_BUFFER,
+				GL_PIXEL_UNPACK_BUFFER,
+				GL_UNIFORM_BUFFER,
+				GL_SHADER_STORAGE_BUFFER,
+				GL_DRAW_INDIRECT_BUFFER,
+				GL_DISPATCH_INDIRECT_BUFFER,
+				GL_TEXTURE_BUFFER,
+				GL_QUERY_BUFFER,
+				GL_ATOMIC_COUNTER_BUFFER,
+			};
+			static constexpr std::array<GLenum, 8> TEXTURE_TARGETS {
+				GL_TEXTURE_1D,
+				GL_TEXTURE_2D,
+				GL_TEXTURE_3D,
+				GL_TEXTURE_1D_ARRAY,
+				GL_TEXTURE_2D_ARRAY,
+				GL_TEXTURE_RECTANGLE,
+				GL_TEXTURE_CUBE_MAP,
+				GL_TEXTURE_2D_MULTISAMPLE,
+			};
+			static constexpr std::array<GLenum, 8> CAPABILITIES {
+				GL_BLEND,
+				GL_CULL_FACE,
+				GL_DEPTH_TEST,
+				GL_STENCIL_TEST,
+				GL_SCISSOR_TEST,
+				GL_FRAMEBUFFER_SRGB,
+				GL_MULTISAMPLE,
+				GL_PRIMITIVE_RESTART_FIXED_INDEX,
+			};
+			/* no valid name nor enum, and a capability is either 0 or 1 */
+			static constexpr GLuint UNKNOWN {~GLuint{0u}};
+
+			/* counts the call and updates `current`, returns whether it must be forwarded */
+			template <typename T>
+			auto update(T& current, const T& value) noexcept -> bool;
+
+			Stats m_stats;
+			GLuint m_program;
+			GLuint m_vertexArray;
+			GLuint m_activeTexture;
+			std::array<GLuint, BUFFER_TARGETS.size()> m_buffers;
+			std::array<std::array<GLuint, TEXTURE_TARGETS.size()>, TEXTURE_UNIT_COUNT> m_textures;
+			std::array<GLuint, CAPABILITIES.size()> m_capabilities;
+			std::array<GLenum, 2> m_blendFunc;
+			std::array<GLint, 4> m_viewport;
+	};
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::render {
+	/*
+	 * Headless stand-in for a GL 4.6 driver. Loading glad through `getLoadProc` points the functions the engine
+	 * uses at stubs which record every call, and emulate just enough state for the engine to run: object
+	 * names, buffer contents, bindings and mappings, and fences. Functions without a stub are left null.
+	 * Fences model a GPU running `fenceLatency` fences behind the CPU: a fence signals once that many fences
+	 * were inserted after it, and a blocking wait on an unsignaled fence counts as a stall.
+	 * Only one stub can exist at a time, and glad must be reloaded once it is destroyed.
+	 */
+	class VOXLET_EXPORT GlStub final {
+		friend struct GlStubFunctions;
+
+		public:
+			GlStub(const GlStub&) = delete;
+			auto operator=(const GlStub&) -> GlStub& = delete;
+			GlStub(GlStub&&) = delete;
+			auto operator=(GlStub&&) -> GlStub& = delete;
+
+			struct Call {
+				std::string_view name;
+				/* integers as is, pointers as addresses and floats as their bits */
+				std::array<std::uint64_t, 8> arguments;
+			};
+
+			GlStub() noexcept;
+			~GlStub();
+
+			[[nodiscard]]
+			static auto getLoadProc() noexcept -> GLADloadproc;
+			/* loads glad with the stubs */
+			[[nodiscard]]
+			auto load() noexcept -> bool;
+
+			/* recording can be turned off when only the emulated state matters */
+			auto setRecording(bool recording) noexcept -> void {m_recording = recording;}
+			auto setFenceLatency(std::size_t latency) noexcept -> void {m_fenceLatency = latency;}
+			auto clearCalls() noexcept -> void {m_calls.clear();}
+			[[nodiscard]]
+			constexpr auto getCalls() const noexcept -> std::span<const Call> {return m_calls;}
+			[[nodiscard]]
+			auto getCallCount(std::string_view name) const noexcept -> std::size_t;
+
+			[[nodiscard]]
+			auto getBufferData(GLuint buffer) const noexcept -> std::span<const std::byte>;
+			[[nodiscard]]
+			auto getBoundBuffer(GLenum target) const noexcept -> GLuint;
+			[[nodiscard]]
+			constexpr auto getStallCount() const noexcept -> std::size_t {return m_stallCount;}
+			[[nodiscard]]
+			auto getLiveFenceCount() const noexcept -> std::size_t {return m_fences.size();}
+
+		private:
+			auto record(std::string_view name, std::span<const std::uint64_t> arguments) noexcept -> void;
+			[[nodiscard]]
+			auto createName() noexcept -> GLuint {return m_nextName++;}
+
+			std::vector<Call> m_calls;
+			bool m_recording;
+			GLuint m_nextName;
+			std::unordered_map<GLuint, std::vector<std::byte>> m_buffers;
+			std::unordered_map<GLenum, GLuint> m_boundBuffers;
+			/* index of each live fence in insertion order */
+			std::unordered_map<std::uintptr_t, std::size_t> m_fences;
+			std::size_t m_fenceCount;
+			std::size_t m_fenceLatency;
+			std::size_t m_stallCount;
+	};
+}
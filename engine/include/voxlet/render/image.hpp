@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::render {
+	/* RGBA8, red in the lowest byte */
+	using Palette = std::array<std::uint32_t, 256>;
+
+	/* RGBA8 pixels, red in the lowest byte, rows top to bottom without padding */
+	class VOXLET_EXPORT Image final {
+		public:
+			Image(const Image&) = delete;
+			auto operator=(const Image&) -> Image& = delete;
+			Image(Image&&) noexcept = default;
+			auto operator=(Image&&) noexcept -> Image& = default;
+
+			Image() noexcept;
+			Image(std::uint32_t width, std::uint32_t height, std::uint32_t color = 0u) noexcept;
+			~Image() = default;
+
+			auto fill(std::uint32_t color) noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getWidth() const noexcept -> std::uint32_t {return m_width;}
+			[[nodiscard]]
+			constexpr auto getHeight() const noexcept -> std::uint32_t {return m_height;}
+			[[nodiscard]]
+			constexpr auto getPixels() noexcept -> std::span<std::uint32_t> {return m_pixels;}
+			[[nodiscard]]
+			constexpr auto getPixels() const noexcept -> std::span<const std::uint32_t> {return m_pixels;}
+			[[nodiscard]]
+			constexpr auto getRow(const std::uint32_t y) noexcept -> std::uint32_t* {
+				return m_pixels.data() + static_cast<std::size_t> (y) * m_width;
+			}
+			[[nodiscard]]
+			constexpr auto getRow(const std::uint32_t y) const noexcept -> const std::uint32_t* {
+				return m_pixels.data() + static_cast<std::size_t> (y) * m_width;
+			}
+			[[nodiscard]]
+			constexpr auto getPixel(const std::uint32_t x, const std::uint32_t y) const noexcept -> std::uint32_t {
+				return this->getRow(y)[x];
+			}
+
+		private:
+			std::uint32_t m_width;
+			std::uint32_t m_height;
+			std::vector<std::uint32_t> m_pixels;
+	};
+
+	/*
+	 * 8-bit palette indices, rows top to bottom without padding. The storage is padded past the last index so
+	 * that SIMD kernels can fetch indices with 32-bit gathers.
+	 */
+	class VOXLET_EXPORT IndexedImage final {
+		public:
+			static constexpr std::size_t PADDING {3uz};
+
+			IndexedImage(const IndexedImage&) = delete;
+			auto operator=(const IndexedImage&) -> IndexedImage& = delete;
+			IndexedImage(IndexedImage&&) noexcept = default;
+			auto operator=(IndexedImage&&) noexcept -> IndexedImage& = default;
+
+			IndexedImage() noexcept;
+			IndexedImage(std::uint32_t width, std::uint32_t height, std::uint8_t index = 0u) noexcept;
+			~IndexedImage() = default;
+
+			[[nodiscard]]
+			constexpr auto getWidth() const noexcept -> std::uint32_t {return m_width;}
+			[[nodiscard]]
+			constexpr auto getHeight() const noexcept -> std::uint32_t {return m_height;}
+			[[nodiscard]]
+			constexpr auto getIndices() noexcept -> std::span<std::uint8_t> {
+				return std::span{m_indices}.first(m_indices.size() - PADDING);
+			}
+			[[nodiscard]]
+			constexpr auto getIndices() const noexcept -> std::span<const std::uint8_t> {
+				return std::span{m_indices}.first(m_indices.size() - PADDING);
+			}
+			[[nodiscard]]
+			constexpr auto getRow(const std::uint32_t y) const noexcept -> const std::uint8_t* {
+				return m_indices.data() + static_cast<std::size_t> (y) * m_width;
+			}
+
+		private:
+			std::uint32_t m_width;
+			std::uint32_t m_height;
+			std::vector<std::uint8_t> m_indices;
+	};
+}
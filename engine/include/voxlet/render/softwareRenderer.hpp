@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+#include "voxlet/render/image.hpp"
+#include "voxlet/render/sortKey.hpp"
+#include "voxlet/render/spriteBatcher.hpp"
+
+
+namespace vx::render {
+	enum class RasterBackend {
+		scalar,
+		avx2
+	};
+
+	/*
+	 * Grid of tiles taken from a tileset texture, in which tiles are laid out row-major. Tile `n` of the
+	 * tileset is referenced as `n + 1`, 0 leaves the cell empty.
+	 */
+	struct TileLayer {
+		GLuint tileset;
+		/* in texels */
+		std::uint32_t tileSize;
+		std::uint32_t columns;
+		std::uint32_t rows;
+		/* `columns * rows` cells, must stay alive until `draw` */
+		std::span<const std::uint16_t> tiles;
+		/* position of the top-left corner in pixels */
+		std::int32_t x;
+		std::int32_t y;
+		/* pixels per texel */
+		std::uint32_t scale;
+		std::uint32_t color;
+		std::uint8_t layer;
+	};
+
+
+	/*
+	 * CPU counterpart of `SpriteBatcher` for machines without a GPU: takes the same sprites, sorted by the
+	 * same key, and draws them into an `Image`. Textures are registered images, and the texture of a sprite
+	 * is the name `registerTexture` returned, 0 fills the sprite with its color. Sampling is nearest, which is
+	 * exact for integer scales. Colors are multiplied by the sprite color and blended by their alpha, the
+	 * alpha of the target accumulates as with "over". A tile layer draws before the sprites of
+	 * its layer. Any thread can submit, as with `SpriteBatcher`. The target is split in square tiles rasterized in parallel by the scheduler, each tile
+	 * drawing everything overlapping it in order, so the result doesn't depend on the thread count.
+	 */
+	class VOXLET_EXPORT SoftwareRenderer final {
+		public:
+			SoftwareRenderer(const SoftwareRenderer&) = delete;
+			auto operator=(const SoftwareRenderer&) -> SoftwareRenderer& = delete;
+			SoftwareRenderer(SoftwareRenderer&&) = delete;
+			auto operator=(SoftwareRenderer&&) -> SoftwareRenderer& = delete;
+
+			struct Config {
+				RasterBackend backend {RasterBackend::avx2};
+				std::uint32_t tileSize {64u};
+			};
+
+			explicit SoftwareRenderer(vx::jobs::Scheduler& scheduler) noexcept;
+			SoftwareRenderer(vx::jobs::Scheduler& scheduler, const Config& config) noexcept;
+			~SoftwareRenderer() = default;
+
+			/* the image must outlive the renderer, as must the palette of an indexed image */
+			[[nodiscard]]
+			auto registerTexture(const Image& image) noexcept -> GLuint;
+			[[nodiscard]]
+			auto registerTexture(const IndexedImage& image, const Palette& palette) noexcept -> GLuint;
+
+			auto submit(const Sprite& sprite) noexcept -> void;
+			auto submit(std::span<const Sprite> sprites) noexcept -> void;
+			auto submit(const TileLayer& layer) noexcept -> void;
+
+			/* sorts what was submitted, must not race with `submit` */
+			auto build() noexcept -> void;
+			/* rasterizes what `build` prepared over `target` and starts a new frame */
+			auto draw(Image& target) noexcept -> void;
+			/* drops the submitted sprites and layers without drawing them */
+			auto clear() noexcept -> void;
+
+			[[nodiscard]]
+			auto getSubmittedCount() const noexcept -> std::size_t;
+
+		private:
+			struct Texture {
+				const std::uint32_t* pixels;
+				const std::uint8_t* indices;
+				const std::uint32_t* palette;
+				std::uint32_t width;
+				std::uint32_t height;
+			};
+
+			/* a textured rectangle, texture coordinates are 16.16 fixed point at the center of the first pixel */
+			struct Quad {
+				std::int32_t x0;
+				std::int32_t y0;
+				std::int32_t x1;
+				std::int32_t y1;
+				std::int32_t u;
+				std::int32_t v;
+				std::int32_t du;
+				std::int32_t dv;
+				std::uint32_t color;
+				GLuint texture;
+			};
+
+			struct alignas(64) ThreadBuffer {
+				/* only locked for the buffer shared by the threads the scheduler doesn\'t own */
+				std::mutex mutex;
+				std::vector<SortEntry> keys;
+				std::vector<Sprite> sprites;
+				std::vector<TileLayer> layers;
+			};
+
+			/* the buffer of the calling thread, locked when it's the one shared by the threads outside the scheduler */
+			[[nodiscard]]
+			auto acquireBuffer() noexcept -> std::pair<ThreadBuffer&, std::unique_lock<std::mutex>>;
+			auto addSprite(const Sprite& sprite) noexcept -> void;
+			auto addTileLayer(const TileLayer& layer, std::int32_t width, std::int32_t height) noexcept -> void;
+			auto drawTile(Image& target, std::size_t tile, std::uint32_t tileColumns) const noexcept -> void;
+
+			vx::jobs::Scheduler* m_scheduler;
+			Config m_config;
+			std::vector<Texture> m_textures;
+			std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+			std::vector<SortEntry> m_entries;
+			std::vector<SortEntry> m_scratch;
+			std::vector<Quad> m_quads;
+			std::vector<std::vector<std::uint32_t>> m_bins;
+	};
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::render {
+	/* a 64-bit sort key and the index of what it sorts */
+	struct SortEntry {
+		std::uint64_t key;
+		std::uint64_t value;
+	};
+
+	/*
+	 * Stable LSD radix sort on the keys, one byte per pass. Passes where every key has the same byte are
+	 * skipped, so keys which only use a few bits only pay for those. `scratch` must be as large as `entries`,
+	 * the result always ends up in `entries`.
+	 */
+	VOXLET_EXPORT auto radixSort(std::span<SortEntry> entries, std::span<SortEntry> scratch) noexcept -> void;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+#include "voxlet/render/glStateCache.hpp"
+#include "voxlet/render/sortKey.hpp"
+#include "voxlet/render/streamingBuffer.hpp"
+
+
+namespace vx::render {
+	struct Sprite {
+		float x;
+		float y;
+		float width;
+		float height;
+		float u0;
+		float v0;
+		float u1;
+		float v1;
+		/* RGBA8, red in the lowest byte */
+		std::uint32_t color;
+		/* in [0, 1], sprites of a layer drawn with the same state are drawn by increasing depth */
+		float depth;
+		GLuint program;
+		GLuint texture;
+		std::uint8_t layer;
+	};
+
+	/* per-instance vertex data, one quad per sprite */
+	struct SpriteInstance {
+		float rect[4];
+		float uv[4];
+		std::uint32_t color;
+		float depth;
+	};
+
+	/*
+	 * Draw order of a sprite: layer (8 bits), then program (12 bits), texture (20 bits) and depth (24 bits).
+	 * Names wider than their field are truncated, which only costs batching since batches compare the full
+	 * names.
+	 */
+	[[nodiscard]]
+	VOXLET_EXPORT auto makeSpriteKey(const Sprite& sprite) noexcept -> std::uint64_t;
+
+
+	/*
+	 * Collects the sprites of a frame and draws them with as few draw calls as the state allows. Any thread can
+	 * submit, the workers of the scheduler each into their own buffer and the other threads into one they
+	 * share behind a lock. `build` sorts everything by `makeSpriteKey` and
+	 * fills the instance data, then `draw` copies it to a persistently mapped streaming buffer and issues one
+	 * instanced draw per run of sprites sharing a program and a texture, on the thread owning the GL context.
+	 * Instances are read by the vertex shader from attributes 0 (vec4 rect), 1 (vec4 uv), 2 (normalized
+	 * color) and 3 (float depth), and expand to a 4 vertices triangle strip from `gl_VertexID`. The GL
+	 * objects are created at the first draw and the batcher must be destroyed while their context is current.
+	 */
+	class VOXLET_EXPORT SpriteBatcher final {
+		public:
+			SpriteBatcher(const SpriteBatcher&) = delete;
+			auto operator=(const SpriteBatcher&) -> SpriteBatcher& = delete;
+			SpriteBatcher(SpriteBatcher&&) = delete;
+			auto operator=(SpriteBatcher&&) -> SpriteBatcher& = delete;
+
+			struct Batch {
+				GLuint program;
+				GLuint texture;
+				std::uint32_t first;
+				std::uint32_t count;
+			};
+
+			explicit SpriteBatcher(vx::jobs::Scheduler& scheduler) noexcept;
+			~SpriteBatcher();
+
+			auto submit(const Sprite& sprite) noexcept -> void;
+			auto submit(std::span<const Sprite> sprites) noexcept -> void;
+
+			/* sorts the submitted sprites and builds the instances and batches, must not race with `submit` */
+			auto build() noexcept -> void;
+			/* draws what `build` prepared and starts a new frame */
+			auto draw() noexcept -> void;
+			/* same, binding through `state` so that the bindings it shares with other passes are skipped */
+			auto draw(GlStateCache& state) noexcept -> void;
+			/* drops the submitted sprites without drawing them */
+			auto clear() noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getInstances() const noexcept -> std::span<const SpriteInstance> {return m_instances;}
+			[[nodiscard]]
+			constexpr auto getBatches() const noexcept -> std::span<const Batch> {return m_batches;}
+			[[nodiscard]]
+			auto getSubmittedCount() const noexcept -> std::size_t;
+
+		private:
+			struct alignas(64) ThreadBuffer {
+				/* only locked for the buffer shared by the threads the scheduler doesn\'t own */
+				std::mutex mutex;
+				std::vector<SortEntry> keys;
+				std::vector<Sprite> sprites;
+			};
+
+			/* the buffer of the calling thread, locked when it's the one shared by the threads outside the scheduler */
+			[[nodiscard]]
+			auto acquireBuffer() noexcept -> std::pair<ThreadBuffer&, std::unique_lock<std::mutex>>;
+			/* (re)creates the streaming buffer so that a frame holds `instanceCount` instances */
+			auto createObjects(std::size_t instanceCount, GlStateCache& state) noexcept -> bool;
+
+			vx::jobs::Scheduler* m_scheduler;
+			std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+			std::vector<SortEntry> m_entries;
+			std::vector<SortEntry> m_scratch;
+			std::vector<SpriteInstance> m_instances;
+			std::vector<Batch> m_batches;
+			GLuint m_vertexArray;
+			std::optional<StreamingBuffer> m_stream;
+	};
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "voxlet/export.hpp"
+
+
+namespace vx::render {
+	/*
+	 * Ring of per-frame regions in one persistently and coherently mapped buffer, for data rewritten every
+	 * frame. Writes go straight to the mapped memory, no upload call and no orphaning. Each region is guarded
+	 * by a fence inserted at the end of its frame, and `beginFrame` only waits on it when the GPU is still
+	 * reading the region, which with the default 3 regions means it lags more than 2 frames behind.
+	 * Requires GL 4.4 for `glBufferStorage`.
+	 */
+	class VOXLET_EXPORT StreamingBuffer final {
+		public:
+			StreamingBuffer(const StreamingBuffer&) = delete;
+			auto operator=(const StreamingBuffer&) -> StreamingBuffer& = delete;
+
+			struct Config {
+				std::size_t frameSize;
+				std::size_t frameCount {3uz};
+				GLenum target {GL_ARRAY_BUFFER};
+			};
+
+			struct Allocation {
+				std::byte* data;
+				/* from the start of the buffer, as expected by GL */
+				std::size_t offset;
+				std::size_t size;
+			};
+
+			StreamingBuffer(StreamingBuffer&& other) noexcept;
+			auto operator=(StreamingBuffer&& other) noexcept -> StreamingBuffer&;
+			~StreamingBuffer();
+
+			/* leaves the buffer bound to `config.target` */
+			[[nodiscard]]
+			static auto create(const Config& config) noexcept -> std::optional<StreamingBuffer>;
+
+			/* waits until the GPU is done with the next region */
+			auto beginFrame() noexcept -> void;
+			/*
+			 * Sub-allocates from the region of the frame, `offset` is a multiple of `alignment`, which doesn't
+			 * have to be a power of two so that vertex data can be addressed by instance. Returns nothing once
+			 * the region is full.
+			 */
+			[[nodiscard]]
+			auto allocate(std::size_t size, std::size_t alignment = 1uz) noexcept -> std::optional<Allocation>;
+			/* fences the region of the frame */
+			auto endFrame() noexcept -> void;
+
+			[[nodiscard]]
+			constexpr auto getBuffer() const noexcept -> GLuint {return m_buffer;}
+			[[nodiscard]]
+			constexpr auto getFrameSize() const noexcept -> std::size_t {return m_config.frameSize;}
+			[[nodiscard]]
+			constexpr auto getFrameCount() const noexcept -> std::size_t {return m_config.frameCount;}
+			[[nodiscard]]
+			constexpr auto getFrameIndex() const noexcept -> std::size_t {return m_frame;}
+			[[nodiscard]]
+			constexpr auto getUsedSize() const noexcept -> std::size_t {return m_cursor;}
+			/* number of `beginFrame` which had to block on the GPU */
+			[[nodiscard]]
+			constexpr auto getStallCount() const noexcept -> std::size_t {return m_stallCount;}
+
+		private:
+			StreamingBuffer(const Config& config, GLuint buffer, std::byte* mapping) noexcept;
+			/* deletes the fences and the buffer, leaving an empty one */
+			auto release() noexcept -> void;
+
+			Config m_config;
+			GLuint m_buffer;
+			std::byte* m_mapping;
+			std::vector<GLsync> m_fences;
+			std::size_t m_frame;
+			std::size_t m_cursor;
+			std::size_t m_stallCount;
+	};
+}
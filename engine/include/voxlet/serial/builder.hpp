@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "voxlet/export.hpp"
+#include "voxlet/serial/table.hpp"
+
+
+namespace vx::serial {
+	namespace internal {
+		/* appends the parts of a buffer at positions from its start, `serialize` decides what goes where */
+		class VOXLET_EXPORT Builder final {
+			public:
+				Builder(const Builder&) = delete;
+				auto operator=(const Builder&) -> Builder& = delete;
+				Builder(Builder&&) noexcept = default;
+				auto operator=(Builder&&) noexcept -> Builder& = default;
+				~Builder() = default;
+
+				Builder() noexcept;
+
+				/*
+				 * Writes the vtable giving `offsets` unless an equal one was written already, then a table of `size`
+				 * bytes zeroed but for its offset to the vtable, and gives where the table starts.
+				 */
+				auto beginTable(std::span<const std::uint16_t> offsets, std::uint16_t size) noexcept -> std::size_t;
+				/* over bytes appended already */
+				auto write(std::size_t position, const void* data, std::size_t size) noexcept -> void;
+				auto writeString(const char8_t* data, std::size_t size) noexcept -> std::size_t;
+				auto writeScalars(const void* data, std::size_t count, std::size_t elementSize, std::size_t alignment) noexcept
+					-> std::size_t;
+				/* a vector of `count` references, each to be linked to its element once written */
+				auto writeReferences(std::size_t count) noexcept -> std::size_t;
+				auto link(std::size_t reference, std::size_t target) noexcept -> void;
+				/* the buffer with its header pointing to `root`, `std::nullopt` if it doesn't fit in 4 GB */
+				[[nodiscard]]
+				auto finish(std::size_t root) noexcept -> std::optional<std::vector<std::byte>>;
+
+			private:
+				auto align(std::size_t alignment) noexcept -> void;
+
+				std::vector<std::byte> m_bytes {};
+				std::vector<std::size_t> m_vtables {};
+		};
+	}
+
+	/* `root` as a buffer to load with a `Document`, `std::nullopt` if it doesn't fit in 4 GB */
+	template <Schema T>
+	[[nodiscard]]
+	auto serialize(const T& root) noexcept -> std::optional<std::vector<std::byte>>;
+}
+
+#include "voxlet/serial/builder.inl"
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "voxlet/serial/builder.hpp"
+
+
+namespace vx::serial {
+	namespace internal {
+		template <typename T>
+		consteval auto getInlineSize() noexcept -> std::size_t {
+			if constexpr (FieldTraits<T>::IS_REFERENCE)
+				return REFERENCE_SIZE;
+			else
+				return sizeof(T);
+		}
+
+		template <typename T>
+		consteval auto getInlineAlignment() noexcept -> std::size_t {
+			if constexpr (FieldTraits<T>::IS_REFERENCE)
+				return alignof(std::uint32_t);
+			else
+				return alignof(T);
+		}
+
+		/* the size of a table of `T` with every field written, padding included */
+		template <Schema T>
+		consteval auto getMaxTableSize() noexcept -> std::size_t {
+			return [] <std::size_t... I> (std::index_sequence<I...>) {
+				return sizeof(std::int32_t) + ((getInlineSize<FieldType<T, I>> () + getInlineAlignment<FieldType<T, I>> ()) + ... + 0uz);
+			}(std::make_index_sequence<FIELD_COUNT<T>> {});
+		}
+
+		/* defaults and empty strings and vectors are left for the reader to fill in, tables are always written */
+		template <Schema T, std::size_t index>
+		auto isWritten(const FieldType<T, index>& value) noexcept -> bool {
+			using Field = FieldType<T, index>;
+			if constexpr (Scalar<Field>) {
+				/* bitwise, for a negative zero not to be taken for a zero */
+				constexpr Field DEFAULT {getDefault<T, index> ()};
+				return std::memcmp(&value, &DEFAULT, sizeof(Field)) != 0;
+			}
+			else if constexpr (Schema<Field>)
+				return true;
+			else
+				return !value.empty();
+		}
+
+		template <Schema T>
+		auto writeTable(Builder& builder, const T& object) noexcept -> std::size_t;
+
+		/* writes what a reference field points to, and gives where it starts */
+		template <typename T>
+		auto writeValue(Builder& builder, const T& value) noexcept -> std::size_t {
+			if constexpr (std::same_as<T, vx::String>)
+				return builder.writeString(std::to_address(value.slice().unchecked().begin()), value.getSize());
+			else if constexpr (std::same_as<T, std::u8string>)
+				return builder.writeString(value.data(), value.size());
+			else if constexpr (Schema<T>)
+				return writeTable(builder, value);
+			else {
+				using Element = typename T::value_type;
+				if constexpr (Scalar<Element>)
+					return builder.writeScalars(value.data(), value.size(), sizeof(Element), alignof(Element));
+				else {
+					const std::size_t vector {builder.writeReferences(value.size())};
+					for (std::size_t i {0uz}; i < value.size(); ++i) {
+						const std::size_t reference {vector + REFERENCE_SIZE + i * REFERENCE_SIZE};
+						builder.link(reference, writeValue(builder, value[i]));
+					}
+					return vector;
+				}
+			}
+		}
+
+		template <Schema T>
+		auto writeTable(Builder& builder, const T& object) noexcept -> std::size_t {
+			static_assert(getMaxTableSize<T> () <= 0xffffuz, "the fields of a table must fit in 64 KB");
+			constexpr std::size_t COUNT {FIELD_COUNT<T>};
+			const auto fields {getFields(object)};
+
+			/* fields are laid out by decreasing alignment, which leaves padding only after the vtable offset */
+			std::array<std::uint16_t, COUNT> offsets {};
+			std::size_t size {sizeof(std::int32_t)};
+			for (const std::size_t alignment : {8uz, 4uz, 2uz, 1uz}) {
+				[&] <std::size_t... I> (std::index_sequence<I...>) {
+					([&] {
+						using Field = FieldType<T, I>;
+						if (getInlineAlignment<Field> () != alignment || !isWritten<T, I> (std::get<I> (fields)))
+							return;
+						size = (size + alignment - 1uz) & ~(alignment - 1uz);
+						offsets[I] = static_cast<std::uint16_t> (size);
+						size += getInlineSize<Field> ();
+					}(), ...);
+				}(std::make_index_sequence<COUNT> {});
+			}
+
+			const std::size_t table {builder.beginTable(offsets, static_cast<std::uint16_t> (size))};
+			[&] <std::size_t... I> (std::index_sequence<I...>) {
+				([&] {
+					using Field = FieldType<T, I>;
+					if (offsets[I] == 0u)
+						return;
+					if constexpr (FieldTraits<Field>::IS_REFERENCE)
+						builder.link(table + offsets[I], writeValue(builder, std::get<I> (fields)));
+					else
+						builder.write(table + offsets[I], &std::get<I> (fields), sizeof(Field));
+				}(), ...);
+			}(std::make_index_sequence<COUNT> {});
+			return table;
+		}
+	}
+
+
+	template <Schema T>
+	auto serialize(const T& root) noexcept -> std::optional<std::vector<std::byte>> {
+		internal::Builder builder {};
+		const std::size_t table {internal::writeTable(builder, root)};
+		return builder.finish(table);
+	}
+}
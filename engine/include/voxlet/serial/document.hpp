@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/io/mappedFile.hpp"
+#include "voxlet/serial/table.hpp"
+
+
+namespace vx::serial {
+	namespace internal {
+		/* how deep tables can be nested in a buffer before it's turned down, to bound the stack */
+		constexpr std::size_t MAX_DEPTH {64uz};
+
+		/* the position of the root table after checking the header, `bytes` must be aligned to 8 bytes */
+		[[nodiscard]]
+		VOXLET_EXPORT auto findRoot(std::span<const std::byte> bytes) noexcept -> std::optional<std::size_t>;
+
+		/*
+		 * Checks the parts of a buffer before they're read in place, `Document` decides which from the schema.
+		 * Positions are from the start of the buffer. Every table, vector element and boolean checked is charged
+		 * its bytes against a budget of twice the buffer, what a written buffer takes at most with its booleans
+		 * charged once more, so that tables or vectors referred to more than once can't make the check take
+		 * longer than a couple of passes over a buffer of that size.
+		 */
+		class VOXLET_EXPORT Verifier final {
+			public:
+				explicit Verifier(const std::span<const std::byte> bytes) noexcept :
+					m_bytes {bytes},
+					m_budget {2uz * bytes.size()}
+				{}
+
+				/* whether the table and its vtable are in bounds, it has to be left once its fields are checked */
+				[[nodiscard]]
+				auto enterTable(std::size_t table) noexcept -> bool;
+				auto leaveTable() noexcept -> void;
+				/* the position of the field `index` of an entered table, 0 if it wasn't written */
+				[[nodiscard]]
+				auto checkField(std::size_t table, std::size_t index, std::size_t size) const noexcept
+					-> std::optional<std::size_t>;
+				/* whether each byte from `position` is a boolean */
+				[[nodiscard]]
+				auto checkBooleans(std::size_t position, std::size_t count) noexcept -> bool;
+				/* the position the reference stored at `reference` points to */
+				[[nodiscard]]
+				auto follow(std::size_t reference) const noexcept -> std::optional<std::size_t>;
+				[[nodiscard]]
+				auto checkString(std::size_t string) noexcept -> bool;
+				/* the size of the vector, whose elements take `elementSize` bytes aligned to `alignment` */
+				[[nodiscard]]
+				auto checkVector(std::size_t vector, std::size_t elementSize, std::size_t alignment) noexcept
+					-> std::optional<std::size_t>;
+
+			private:
+				/* whether `size` bytes were left in the budget, which they're taken from */
+				[[nodiscard]]
+				auto charge(std::size_t size) noexcept -> bool;
+
+				std::span<const std::byte> m_bytes;
+				std::size_t m_budget;
+				std::size_t m_depth {0uz};
+		};
+	}
+
+
+	/*
+	 * A buffer written by `serialize`, read in place from a mapping of its file or from bytes given. Loading
+	 * checks every table, string and vector that the schema reaches once, so that reads never go out of the
+	 * buffer, and copies nothing. Buffers written with fewer fields, or more, than `T` has are read the same.
+	 */
+	template <Schema T>
+	class Document final {
+		public:
+			Document(const Document&) = delete;
+			auto operator=(const Document&) -> Document& = delete;
+			Document(Document&&) noexcept = default;
+			auto operator=(Document&&) noexcept -> Document& = default;
+			~Document() = default;
+
+			[[nodiscard]]
+			static auto open(const vx::StringSlice& path) noexcept -> std::optional<Document>;
+			/* `bytes` must outlive the document and be aligned to 8 bytes */
+			[[nodiscard]]
+			static auto fromBytes(std::span<const std::byte> bytes) noexcept -> std::optional<Document>;
+
+			[[nodiscard]]
+			auto getRoot() const noexcept -> Table<T> {return Table<T>{m_bytes.data() + m_root};}
+			[[nodiscard]]
+			constexpr auto getBytes() const noexcept -> std::span<const std::byte> {return m_bytes;}
+
+		private:
+			Document() noexcept = default;
+
+			vx::io::MappedFile m_file {};
+			std::span<const std::byte> m_bytes {};
+			std::size_t m_root {0uz};
+	};
+}
+
+#include "voxlet/serial/document.inl"
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "voxlet/serial/document.hpp"
+
+
+namespace vx::serial {
+	namespace internal {
+		template <Schema T>
+		auto verifyTable(Verifier& verifier, std::size_t table) noexcept -> bool;
+
+		/* checks what a reference field points to */
+		template <typename T>
+		auto verifyValue(Verifier& verifier, const std::size_t position) noexcept -> bool {
+			if constexpr (Text<T>)
+				return verifier.checkString(position);
+			else if constexpr (Schema<T>)
+				return verifyTable<T> (verifier, position);
+			else {
+				using Element = typename T::value_type;
+				if constexpr (Scalar<Element>) {
+					const std::optional<std::size_t> count {verifier.checkVector(position, sizeof(Element), alignof(Element))};
+					if constexpr (HAS_BOOLEANS<Element>)
+						return count && verifier.checkBooleans(position + REFERENCE_SIZE, *count * sizeof(Element));
+					else
+						return count.has_value();
+				}
+				else {
+					const std::optional<std::size_t> count {verifier.checkVector(position, REFERENCE_SIZE, 1uz)};
+					if (!count)
+						return false;
+					for (std::size_t i {0uz}; i < *count; ++i) {
+						const std::optional<std::size_t> element {verifier.follow(position + REFERENCE_SIZE + i * REFERENCE_SIZE)};
+						if (!element || !verifyValue<Element> (verifier, *element))
+							return false;
+					}
+					return true;
+				}
+			}
+		}
+
+		template <Schema T, std::size_t index>
+		auto verifyField(Verifier& verifier, const std::size_t table) noexcept -> bool {
+			using Field = FieldType<T, index>;
+			const std::optional<std::size_t> field {verifier.checkField(
+				table,
+				index,
+				FieldTraits<Field>::IS_REFERENCE ? REFERENCE_SIZE : sizeof(Field)
+			)};
+			if (!field)
+				return false;
+			if (*field == 0uz)
+				return true;
+			if constexpr (!FieldTraits<Field>::IS_REFERENCE) {
+				if constexpr (HAS_BOOLEANS<Field>)
+					return verifier.checkBooleans(*field, sizeof(Field));
+				else
+					return true;
+			}
+			else {
+				const std::optional<std::size_t> target {verifier.follow(*field)};
+				return target && verifyValue<Field> (verifier, *target);
+			}
+		}
+
+		template <Schema T>
+		auto verifyTable(Verifier& verifier, const std::size_t table) noexcept -> bool {
+			if (!verifier.enterTable(table))
+				return false;
+			const bool isValid {[&] <std::size_t... I> (std::index_sequence<I...>) {
+				return (verifyField<T, I> (verifier, table) && ...);
+			}(std::make_index_sequence<FIELD_COUNT<T>> {})};
+			verifier.leaveTable();
+			return isValid;
+		}
+	}
+
+
+	template <Schema T>
+	auto Document<T>::open(const vx::StringSlice& path) noexcept -> std::optional<Document> {
+		std::optional<vx::io::MappedFile> file {vx::io::MappedFile::open(path)};
+		if (!file)
+			return std::nullopt;
+		std::optional<Document> document {Document::fromBytes(file->getBytes())};
+		if (document)
+			document->m_file = std::move(*file);
+		return document;
+	}
+
+	template <Schema T>
+	auto Document<T>::fromBytes(const std::span<const std::byte> bytes) noexcept -> std::optional<Document> {
+		const std::optional<std::size_t> root {internal::findRoot(bytes)};
+		if (!root)
+			return std::nullopt;
+		internal::Verifier verifier {bytes};
+		if (!internal::verifyTable<T> (verifier, *root))
+			return std::nullopt;
+
+		Document document {};
+		document.m_bytes = bytes;
+		document.m_root = *root;
+		return document;
+	}
+}
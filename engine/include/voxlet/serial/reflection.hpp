@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace vx::serial {
+	/* the number of fields up to which an aggregate can be reflected */
+	constexpr std::size_t MAX_FIELD_COUNT {16uz};
+
+	namespace internal {
+		/* converts to the type of any field, to find how many initializers an aggregate takes */
+		struct AnyField {
+			template <typename T>
+			operator T() const noexcept;
+		};
+
+		template <typename T, typename... Fields>
+		consteval auto countFields() noexcept -> std::size_t {
+			if constexpr (sizeof...(Fields) <= MAX_FIELD_COUNT && requires {T{Fields{}..., AnyField{}};})
+				return countFields<T, Fields..., AnyField>();
+			else
+				return sizeof...(Fields);
+		}
+
+		template <typename T>
+		struct MemberTraits;
+
+		template <typename Class, typename Field>
+		struct MemberTraits<Field Class::*> {
+			using ClassType = Class;
+			using FieldType = Field;
+		};
+	}
+
+	/*
+	 * Aggregates whose fields are all direct members, without base classes nor arrays in C style, which can
+	 * then be walked in declaration order through structured bindings instead of a description of their own.
+	 */
+	template <typename T>
+	concept Reflectable = std::is_class_v<T> && std::is_aggregate_v<T> && !std::is_union_v<T>
+		&& std::is_default_constructible_v<T>;
+
+	template <Reflectable T>
+	constexpr std::size_t FIELD_COUNT {internal::countFields<T>()};
+
+	/* references to the fields of `object` in declaration order, as a tuple */
+	template <typename T>
+	requires Reflectable<std::remove_const_t<T>>
+	constexpr auto getFields(T& object) noexcept {
+		constexpr std::size_t count {FIELD_COUNT<std::remove_const_t<T>>};
+		static_assert(count <= MAX_FIELD_COUNT, "too many fields to be reflected");
+
+		if constexpr (count == 0uz)
+			return std::tie();
+		else if constexpr (count == 1uz) {
+			auto& [f0] = object;
+			return std::tie(f0);
+		}
+		else if constexpr (count == 2uz) {
+			auto& [f0, f1] = object;
+			return std::tie(f0, f1);
+		}
+		else if constexpr (count == 3uz) {
+			auto& [f0, f1, f2] = object;
+			return std::tie(f0, f1, f2);
+		}
+		else if constexpr (count == 4uz) {
+			auto& [f0, f1, f2, f3] = object;
+			return std::tie(f0, f1, f2, f3);
+		}
+		else if constexpr (count == 5uz) {
+			auto& [f0, f1, f2, f3, f4] = object;
+			return std::tie(f0, f1, f2, f3, f4);
+		}
+		else if constexpr (count == 6uz) {
+			auto& [f0, f1, f2, f3, f4, f5] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5);
+		}
+		else if constexpr (count == 7uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6);
+		}
+		else if constexpr (count == 8uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+		}
+		else if constexpr (count == 9uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+		}
+		else if constexpr (count == 10uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+		}
+		else if constexpr (count == 11uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+		}
+		else if constexpr (count == 12uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+		}
+		else if constexpr (count == 13uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+		}
+		else if constexpr (count == 14uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+		}
+		else if constexpr (count == 15uz) {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+		}
+		else {
+			auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = object;
+			return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+		}
+	}
+
+	/* the type of the field `index` of `T` */
+	template <Reflectable T, std::size_t index>
+	using FieldType = std::remove_cvref_t<std::tuple_element_t<index, decltype(getFields(std::declval<T&> ()))>>;
+
+	/* the class a pointer to member belongs to */
+	template <auto member>
+	using MemberClass = typename internal::MemberTraits<decltype(member)>::ClassType;
+	template <auto member>
+	using MemberField = typename internal::MemberTraits<decltype(member)>::FieldType;
+
+	/* the position of `member` among the fields of its class, found on an object built at compile time */
+	template <auto member>
+	requires Reflectable<MemberClass<member>>
+	consteval auto getFieldIndex() noexcept -> std::size_t {
+		using Class = MemberClass<member>;
+		Class object {};
+		const auto fields {getFields(object)};
+		const void* const address {&(object.*member)};
+		return [&]<std::size_t... I> (std::index_sequence<I...>) {
+			std::size_t index {FIELD_COUNT<Class>};
+			((static_cast<const void*> (&std::get<I> (fields)) == address ? (void)(index = I) : (void)0), ...);
+			return index;
+		}(std::make_index_sequence<FIELD_COUNT<Class>> {});
+	}
+}
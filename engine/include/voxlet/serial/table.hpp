@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "voxlet/containers/string.hpp"
+#include "voxlet/containers/views/stringSlice.hpp"
+#include "voxlet/serial/reflection.hpp"
+
+
+namespace vx::serial {
+	/*
+	 * Layout of a serialized buffer, in native byte order: the header, then the tables, vtables, strings and
+	 * vectors that the root table reaches. A table starts with the signed offset from it to its vtable, then
+	 * holds its fields at the offsets the vtable gives. A vtable is its own size and the size of its tables
+	 * as `std::uint16_t`, then an offset per field in declaration order, zero for a field that wasn't written
+	 * and reads as its default. Fields missing from the end of a vtable weren't known to the writer, which is
+	 * what lets fields be appended to a schema without breaking buffers written before. Strings, vectors and
+	 * tables are referred to by `std::uint32_t` offsets from the reference forward to them. Strings and vectors
+	 * start with their size as `std::uint32_t`, strings end with a zero and scalar elements are aligned to
+	 * their type, nested strings and tables are stored as references.
+	 */
+	constexpr std::uint32_t SERIAL_MAGIC {0x4553'5856u};
+	constexpr std::uint32_t SERIAL_VERSION {1u};
+
+	struct SerialHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		/* the offset of the root table from the start of the buffer */
+		std::uint32_t root;
+		/* of the whole buffer, header included */
+		std::uint32_t size;
+	};
+
+	static_assert(std::is_trivially_copyable_v<SerialHeader> && sizeof(SerialHeader) == 16uz);
+
+
+	namespace internal {
+		template <typename T>
+		constexpr bool IS_SCALAR {std::is_arithmetic_v<T> || std::is_enum_v<T>};
+		template <typename T, std::size_t N>
+		constexpr bool IS_SCALAR<std::array<T, N>> {IS_SCALAR<T>};
+
+		template <typename T>
+		constexpr bool HAS_BOOLEANS {std::same_as<T, bool>};
+		template <typename T, std::size_t N>
+		constexpr bool HAS_BOOLEANS<std::array<T, N>> {HAS_BOOLEANS<T>};
+
+		template <typename T>
+		constexpr bool IS_VECTOR {false};
+		template <typename T>
+		constexpr bool IS_VECTOR<std::vector<T>> {true};
+	}
+
+	/* stored inline in their table, or packed one after the other in a vector */
+	template <typename T>
+	concept Scalar = internal::IS_SCALAR<T> && alignof(T) <= 8uz;
+	/* read back as a `vx::StringSlice` */
+	template <typename T>
+	concept Text = std::same_as<T, vx::String> || std::same_as<T, std::u8string>;
+	/*
+	 * An aggregate stored as a table. Its fields can be scalars, texts, other schemas, and vectors of either,
+	 * and are identified by their position: a schema evolves by appending fields, never by reordering them.
+	 */
+	template <typename T>
+	concept Schema = Reflectable<T> && !Scalar<T> && !Text<T> && !internal::IS_VECTOR<T>;
+
+
+	template <Schema T>
+	class Table;
+	template <typename T>
+	class Vector;
+	template <Schema T>
+	class Document;
+
+	namespace internal {
+		/* the size of a vtable before its field offsets */
+		constexpr std::size_t VTABLE_HEADER_SIZE {2uz * sizeof(std::uint16_t)};
+		/* the size of a reference, and of the size before a string or a vector */
+		constexpr std::size_t REFERENCE_SIZE {sizeof(std::uint32_t)};
+
+		/* buffers are only aligned to their largest scalar, hence the copies */
+		template <typename T>
+		[[nodiscard]]
+		auto load(const std::byte* const data) noexcept -> T {
+			T value;
+			std::memcpy(&value, data, sizeof(T));
+			return value;
+		}
+
+		/* follows the reference stored at `reference` */
+		[[nodiscard]]
+		inline auto follow(const std::byte* const reference) noexcept -> const std::byte* {
+			return reference + load<std::uint32_t> (reference);
+		}
+
+		/* where the field `index` of `table` is stored, `nullptr` for a field that wasn't written */
+		[[nodiscard]]
+		inline auto findField(const std::byte* const table, const std::size_t index) noexcept -> const std::byte* {
+			if (table == nullptr)
+				return nullptr;
+			const std::byte* const vtable {table + load<std::int32_t> (table)};
+			const std::size_t slot {VTABLE_HEADER_SIZE + index * sizeof(std::uint16_t)};
+			if (slot >= load<std::uint16_t> (vtable))
+				return nullptr;
+			const std::uint16_t offset {load<std::uint16_t> (vtable + slot)};
+			return offset == 0u ? nullptr : table + offset;
+		}
+
+		/* how a field of type `T` is stored and read, for the types that `Schema` allows */
+		template <typename T>
+		struct FieldTraits {
+			static_assert(sizeof(T) == 0uz, "unsupported field type, see vx::serial::Schema");
+		};
+
+		template <Scalar T>
+		struct FieldTraits<T> {
+			using View = T;
+			static constexpr bool IS_REFERENCE {false};
+
+			[[nodiscard]]
+			static auto read(const std::byte* const field) noexcept -> View {return load<T> (field);}
+		};
+
+		template <Text T>
+		struct FieldTraits<T> {
+			using View = vx::StringSlice;
+			static constexpr bool IS_REFERENCE {true};
+
+			[[nodiscard]]
+			static auto read(const std::byte* const field) noexcept -> View {
+				const std::byte* const string {follow(field)};
+				return vx::StringSlice::from(
+					reinterpret_cast<const char8_t*> (string + REFERENCE_SIZE),
+					load<std::uint32_t> (string)
+				);
+			}
+		};
+
+		template <Schema T>
+		struct FieldTraits<T> {
+			using View = Table<T>;
+			static constexpr bool IS_REFERENCE {true};
+
+			[[nodiscard]]
+			static auto read(const std::byte* const field) noexcept -> View {return View{follow(field)};}
+		};
+
+		/* `std::vector<bool>` doesn't store its elements as an array */
+		template <Scalar T>
+		requires (!std::same_as<T, bool>)
+		struct FieldTraits<std::vector<T>> {
+			using View = std::span<const T>;
+			static constexpr bool IS_REFERENCE {true};
+
+			[[nodiscard]]
+			static auto read(const std::byte* const field) noexcept -> View {
+				const std::byte* const vector {follow(field)};
+				return {reinterpret_cast<const T*> (vector + REFERENCE_SIZE), load<std::uint32_t> (vector)};
+			}
+		};
+
+		template <typename T>
+		requires (Text<T> || Schema<T>)
+		struct FieldTraits<std::vector<T>> {
+			using View = Vector<T>;
+			static constexpr bool IS_REFERENCE {true};
+
+			[[nodiscard]]
+			static auto read(const std::byte* const field) noexcept -> View {
+				const std::byte* const vector {follow(field)};
+				return View{vector + REFERENCE_SIZE, load<std::uint32_t> (vector)};
+			}
+		};
+
+		/* what the scalar field `index` is when it wasn't written, taken from a default constructed object */
+		template <Schema T, std::size_t index>
+		consteval auto getDefault() noexcept -> FieldType<T, index> {
+			T object {};
+			return std::get<index> (getFields(object));
+		}
+	}
+
+	/* what reading a field of type `T` gives */
+	template <typename T>
+	using FieldView = typename internal::FieldTraits<T>::View;
+
+
+	/*
+	 * A table of a buffer, valid as long as the buffer is. Fields are read in place, without the buffer being
+	 * unpacked first. A table that wasn't written is invalid and reads the defaults of `T`, like a field that
+	 * wasn't written reads the default of its member.
+	 */
+	template <Schema T>
+	class Table final {
+		template <typename>
+		friend struct internal::FieldTraits;
+		template <Schema>
+		friend class Document;
+
+		public:
+			constexpr Table() noexcept = default;
+
+			[[nodiscard]]
+			constexpr auto isValid() const noexcept -> bool {return m_table != nullptr;}
+
+			/* whether `member` was written, defaults and empty strings and vectors aren't */
+			template <auto member>
+			requires std::same_as<MemberClass<member>, T>
+			[[nodiscard]]
+			auto has() const noexcept -> bool;
+			template <auto member>
+			requires std::same_as<MemberClass<member>, T>
+			[[nodiscard]]
+			auto get() const noexcept -> FieldView<MemberField<member>>;
+
+			/* a copy of the whole table and what it refers to */
+			[[nodiscard]]
+			auto unpack() const noexcept -> T;
+
+		private:
+			explicit constexpr Table(const std::byte* const table) noexcept :
+				m_table {table}
+			{}
+
+			template <std::size_t index, typename Field>
+			auto unpackField(Field& value) const noexcept -> void;
+
+			const std::byte* m_table {nullptr};
+	};
+
+
+	/* a vector of strings or tables, whose elements are read as they're accessed */
+	template <typename T>
+	class Vector final {
+		template <typename>
+		friend struct internal::FieldTraits;
+
+		public:
+			using value_type = FieldView<T>;
+
+			class Iterator final {
+				friend class Vector;
+
+				public:
+					using iterator_concept = std::forward_iterator_tag;
+					using value_type = FieldView<T>;
+					using difference_type = std::ptrdiff_t;
+
+					constexpr Iterator() noexcept = default;
+
+					[[nodiscard]]
+					auto operator*() const noexcept -> value_type {return internal::FieldTraits<T>::read(m_reference);}
+					auto operator++() noexcept -> Iterator& {
+						m_reference += internal::REFERENCE_SIZE;
+						return *this;
+					}
+					auto operator++(int) noexcept -> Iterator {
+						const Iterator previous {*this};
+						++*this;
+						return previous;
+					}
+					[[nodiscard]]
+					constexpr auto operator==(const Iterator& other) const noexcept -> bool {
+						return m_reference == other.m_reference;
+					}
+
+				private:
+					explicit constexpr Iterator(const std::byte* const reference) noexcept :
+						m_reference {reference}
+					{}
+
+					const std::byte* m_reference {nullptr};
+			};
+
+			constexpr Vector() noexcept = default;
+
+			[[nodiscard]]
+			auto operator[](std::size_t index) const noexcept -> value_type;
+
+			[[nodiscard]]
+			constexpr auto isEmpty() const noexcept -> bool {return m_size == 0uz;}
+			[[nodiscard]]
+			constexpr auto getSize() const noexcept -> std::size_t {return m_size;}
+
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto empty() const noexcept -> bool {return this->isEmpty();}
+			[[nodiscard]]
+			[[gnu::always_inline]]
+			constexpr auto size() const noexcept -> std::size_t {return this->getSize();}
+
+			[[nodiscard]]
+			constexpr auto begin() const noexcept -> Iterator {return Iterator{m_references};}
+			[[nodiscard]]
+			constexpr auto end() const noexcept -> Iterator {return Iterator{m_references + m_size * internal::REFERENCE_SIZE};}
+
+		private:
+			constexpr Vector(const std::byte* const references, const std::size_t size) noexcept :
+				m_references {references},
+				m_size {size}
+			{}
+
+			const std::byte* m_references {nullptr};
+			std::size_t m_size {0uz};
+	};
+}
+
+#include "voxlet/serial/table.inl"
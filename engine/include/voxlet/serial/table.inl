@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "voxlet/serial/table.hpp"
+
+
+namespace vx::serial {
+	template <Schema T>
+	template <auto member>
+	requires std::same_as<MemberClass<member>, T>
+	auto Table<T>::has() const noexcept -> bool {
+		return internal::findField(m_table, getFieldIndex<member> ()) != nullptr;
+	}
+
+	template <Schema T>
+	template <auto member>
+	requires std::same_as<MemberClass<member>, T>
+	auto Table<T>::get() const noexcept -> FieldView<MemberField<member>> {
+		using Field = MemberField<member>;
+		const std::byte* const field {internal::findField(m_table, getFieldIndex<member> ())};
+		if (field == nullptr) {
+			if constexpr (Scalar<Field>)
+				return internal::getDefault<T, getFieldIndex<member> ()> ();
+			else
+				return {};
+		}
+		return internal::FieldTraits<Field>::read(field);
+	}
+
+	template <Schema T>
+	auto Table<T>::unpack() const noexcept -> T {
+		T object {};
+		auto fields {getFields(object)};
+		[&]<std::size_t... I> (std::index_sequence<I...>) {
+			(this->unpackField<I> (std::get<I> (fields)), ...);
+		}(std::make_index_sequence<FIELD_COUNT<T>> {});
+		return object;
+	}
+
+	template <Schema T>
+	template <std::size_t index, typename Field>
+	auto Table<T>::unpackField(Field& value) const noexcept -> void {
+		/* a field that wasn't written keeps the default the object was built with */
+		const std::byte* const field {internal::findField(m_table, index)};
+		if (field == nullptr)
+			return;
+		const FieldView<Field> view {internal::FieldTraits<Field>::read(field)};
+		const auto toText = []<typename String> (const vx::StringSlice& slice) noexcept -> String {
+			if constexpr (std::same_as<String, vx::String>)
+				return vx::String::from(slice.unchecked());
+			else
+				return String{std::to_address(slice.unchecked().begin()), slice.getSize()};
+		};
+
+		if constexpr (Scalar<Field>)
+			value = view;
+		else if constexpr (Text<Field>)
+			value = toText.template operator()<Field> (view);
+		else if constexpr (Schema<Field>)
+			value = view.unpack();
+		else {
+			using Element = typename Field::value_type;
+			value.clear();
+			value.reserve(view.size());
+			if constexpr (Scalar<Element>)
+				value.assign(view.begin(), view.end());
+			else if constexpr (Text<Element>) {
+				for (const vx::StringSlice& element : view)
+					value.push_back(toText.template operator()<Element> (element));
+			}
+			else {
+				for (const Table<Element>& element : view)
+					value.push_back(element.unpack());
+			}
+		}
+	}
+
+
+	template <typename T>
+	auto Vector<T>::operator[](const std::size_t index) const noexcept -> value_type {
+		assert(index < m_size);
+		return internal::FieldTraits<T>::read(m_references + index * internal::REFERENCE_SIZE);
+	}
+}
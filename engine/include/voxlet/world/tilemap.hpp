@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "voxlet/containers/slotMap.hpp"
+#include "voxlet/export.hpp"
+#include "voxlet/jobs/scheduler.hpp"
+#include "voxlet/render/spriteBatcher.hpp"
+
+
+namespace vx::world {
+	/* index of a tile in the tileset plus one, 0 is an empty cell */
+	using TileId = std::uint16_t;
+
+	constexpr std::uint32_t CHUNK_SHIFT {5u};
+	constexpr std::uint32_t CHUNK_SIZE {1u << CHUNK_SHIFT};
+	constexpr std::uint32_t CHUNK_AREA {CHUNK_SIZE * CHUNK_SIZE};
+
+	/* interleaves the bits of the coordinates of a tile in its chunk, x in the even bits */
+	[[nodiscard]]
+	constexpr auto mortonEncode(std::uint32_t x, std::uint32_t y) noexcept -> std::uint32_t {
+		const auto spread {[](std::uint32_t value) noexcept {
+			value &= 0xffffu;
+			value = (value | value << 8u) & 0x00ff'00ffu;
+			value = (value | value << 4u) & 0x0f0f'0f0fu;
+			value = (value | value << 2u) & 0x3333'3333u;
+			return (value | value << 1u) & 0x5555'5555u;
+		}};
+		return spread(x) | spread(y) << 1u;
+	}
+
+	struct ChunkCoord {
+		std::int32_t x;
+		std::int32_t y;
+
+		constexpr auto operator==(const ChunkCoord&) const noexcept -> bool = default;
+	};
+
+	/* a rectangle of tiles, typically what the camera sees */
+	struct TileRect {
+		std::int32_t x;
+		std::int32_t y;
+		std::uint32_t width;
+		std::uint32_t height;
+	};
+
+	struct Chunk {
+		ChunkCoord coord;
+		/* in Z-order, see `mortonEncode` */
+		std::array<TileId, CHUNK_AREA> tiles;
+		/* one instance per non-empty tile, valid while the chunk isn't dirty */
+		std::vector<vx::render::SpriteInstance> mesh;
+		bool dirty;
+	};
+
+	using ChunkHandle = vx::containers::SlotMapHandle<Chunk>;
+
+	struct StreamStats {
+		std::size_t loadedCount;
+		std::size_t evictedCount;
+	};
+}
+
+template <>
+struct std::hash<vx::world::ChunkCoord> {
+	auto operator()(const vx::world::ChunkCoord& coord) const noexcept -> std::size_t {
+		return std::hash<std::uint64_t> {} (
+			static_cast<std::uint64_t> (static_cast<std::uint32_t> (coord.y)) << 32u | static_cast<std::uint32_t> (coord.x)
+		);
+	}
+};
+
+
+namespace vx::world {
+	/*
+	 * Unbounded tile grid stored as square chunks of `CHUNK_SIZE` tiles. Tiles of a chunk are laid out in
+	 * Z-order, so a neighbourhood or a window of a chunk touches few cache lines whatever its orientation.
+	 * Each chunk caches the sprite instances drawing its non-empty tiles; editing a tile flags its chunk dirty
+	 * and `rebuildMeshes` only rebuilds the dirty ones.
+	 * Chunks are created by writing to them or by `stream`, which loads the chunks around a view and evicts
+	 * those that got far enough from it. Reading a tile of a chunk that isn't loaded gives an empty tile.
+	 * Loading and evicting invalidate pointers to chunks.
+	 */
+	class VOXLET_EXPORT Tilemap final {
+		public:
+			Tilemap(const Tilemap&) = delete;
+			auto operator=(const Tilemap&) -> Tilemap& = delete;
+
+			struct Config {
+				/* size of a tile in world units */
+				float tileSize {16.f};
+				std::uint32_t tilesetColumns {16u};
+				std::uint32_t tilesetRows {16u};
+				float depth {0.f};
+				/* chunks loaded around the view by `stream` */
+				std::uint32_t loadMargin {1u};
+				/* chunks further than this from the view are evicted, larger than `loadMargin` to avoid thrashing */
+				std::uint32_t evictMargin {2u};
+			};
+
+			Tilemap() noexcept;
+			explicit Tilemap(const Config& config) noexcept;
+			~Tilemap() = default;
+			Tilemap(Tilemap&&) noexcept = default;
+			auto operator=(Tilemap&&) noexcept -> Tilemap& = default;
+
+			[[nodiscard]]
+			auto getTile(std::int32_t x, std::int32_t y) const noexcept -> TileId;
+			/* loads an empty chunk if the tile's chunk isn't loaded */
+			auto setTile(std::int32_t x, std::int32_t y, TileId tile) noexcept -> void;
+			/* calls `func(x, y, tile)` for every tile of the loaded chunks overlapping `rect`, chunk by chunk */
+			template <typename Func>
+			requires std::is_nothrow_invocable_v<Func&, std::int32_t, std::int32_t, TileId>
+			auto forEachTile(const TileRect& rect, Func&& func) const noexcept -> void;
+
+			/* returns the existing chunk if it is already loaded */
+			auto loadChunk(ChunkCoord coord) noexcept -> Chunk&;
+			/* `tiles` is row-major, they replace those of the chunk if it is already loaded */
+			auto loadChunk(ChunkCoord coord, std::span<const TileId, CHUNK_AREA> tiles) noexcept -> Chunk&;
+			auto evictChunk(ChunkCoord coord) noexcept -> bool;
+			/*
+			 * Loads the missing chunks within `loadMargin` chunks of `view`, calling `load(coord, tiles)` to fill
+			 * them, then evicts the chunks further than `evictMargin`, calling `evict(coord, tiles)` first. Tiles
+			 * passed to both are row-major.
+			 */
+			template <typename Load, typename Evict>
+			requires std::is_nothrow_invocable_v<Load&, ChunkCoord, std::span<TileId, CHUNK_AREA>>
+				&& std::is_nothrow_invocable_v<Evict&, ChunkCoord, std::span<const TileId, CHUNK_AREA>>
+			auto stream(const TileRect& view, Load&& load, Evict&& evict) noexcept -> StreamStats;
+
+			/* returns the number of rebuilt chunks */
+			auto rebuildMeshes() noexcept -> std::size_t;
+			auto rebuildMeshes(vx::jobs::Scheduler& scheduler) noexcept -> std::size_t;
+
+			[[nodiscard]]
+			auto getChunk(ChunkCoord coord) noexcept -> Chunk*;
+			[[nodiscard]]
+			auto getChunk(ChunkCoord coord) const noexcept -> const Chunk*;
+			[[nodiscard]]
+			constexpr auto getChunks() const noexcept -> std::span<const Chunk> {return m_chunks.getValues();}
+			[[nodiscard]]
+			constexpr auto getDirtyCount() const noexcept -> std::size_t {return m_dirtyChunks.size();}
+			[[nodiscard]]
+			constexpr auto getConfig() const noexcept -> const Config& {return m_config;}
+
+			[[nodiscard]]
+			static constexpr auto getChunkCoord(const std::int32_t x, const std::int32_t y) noexcept -> ChunkCoord {
+				return ChunkCoord{x >> CHUNK_SHIFT, y >> CHUNK_SHIFT};
+			}
+
+		private:
+			auto findOrLoad(ChunkCoord coord) noexcept -> ChunkHandle;
+			auto markDirty(Chunk& chunk, ChunkHandle handle) noexcept -> void;
+			auto rebuildMesh(Chunk& chunk) const noexcept -> void;
+			/* chunks overlapping `view` grown by `margin` chunks, as [first, last] */
+			static auto getChunkRange(const TileRect& view, std::uint32_t margin) noexcept -> std::array<ChunkCoord, 2>;
+			static auto toRowMajor(const Chunk& chunk, std::span<TileId, CHUNK_AREA> tiles) noexcept -> void;
+
+			Config m_config;
+			vx::containers::SlotMap<Chunk> m_chunks;
+			std::unordered_map<ChunkCoord, ChunkHandle> m_chunkHandles;
+			std::vector<ChunkHandle> m_dirtyChunks;
+	};
+}
+
+#include "voxlet/world/tilemap.inl"
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "voxlet/world/tilemap.hpp"
+
+#include <algorithm>
+
+
+namespace vx::world {
+	template <typename Func>
+	requires std::is_nothrow_invocable_v<Func&, std::int32_t, std::int32_t, TileId>
+	auto Tilemap::forEachTile(const TileRect& rect, Func&& func) const noexcept -> void {
+		if (rect.width == 0u || rect.height == 0u)
+			return;
+		const auto [first, last] {getChunkRange(rect, 0u)};
+		const std::int64_t right {static_cast<std::int64_t> (rect.x) + rect.width};
+		const std::int64_t bottom {static_cast<std::int64_t> (rect.y) + rect.height};
+		for (std::int32_t chunkY {first.y}; chunkY <= last.y; ++chunkY) {
+			for (std::int32_t chunkX {first.x}; chunkX <= last.x; ++chunkX) {
+				const Chunk* const chunk {this->getChunk(ChunkCoord{chunkX, chunkY})};
+				if (chunk == nullptr)
+					continue;
+				const std::int32_t originX {chunkX * static_cast<std::int32_t> (CHUNK_SIZE)};
+				const std::int32_t originY {chunkY * static_cast<std::int32_t> (CHUNK_SIZE)};
+				const std::int32_t x0 {std::max(rect.x, originX)};
+				const std::int32_t y0 {std::max(rect.y, originY)};
+				const auto x1 {static_cast<std::int32_t> (std::min<std::int64_t> (right, originX + CHUNK_SIZE))};
+				const auto y1 {static_cast<std::int32_t> (std::min<std::int64_t> (bottom, originY + CHUNK_SIZE))};
+				for (std::int32_t y {y0}; y < y1; ++y) {
+					const auto localY {static_cast<std::uint32_t> (y - originY)};
+					for (std::int32_t x {x0}; x < x1; ++x)
+						func(x, y, chunk->tiles[mortonEncode(static_cast<std::uint32_t> (x - originX), localY)]);
+				}
+			}
+		}
+	}
+
+
+	template <typename Load, typename Evict>
+	requires std::is_nothrow_invocable_v<Load&, ChunkCoord, std::span<TileId, CHUNK_AREA>>
+		&& std::is_nothrow_invocable_v<Evict&, ChunkCoord, std::span<const TileId, CHUNK_AREA>>
+	auto Tilemap::stream(const TileRect& view, Load&& load, Evict&& evict) noexcept -> StreamStats {
+		StreamStats stats {0uz, 0uz};
+		std::array<TileId, CHUNK_AREA> tiles;
+
+		const auto [first, last] {getChunkRange(view, m_config.loadMargin)};
+		for (std::int32_t chunkY {first.y}; chunkY <= last.y; ++chunkY) {
+			for (std::int32_t chunkX {first.x}; chunkX <= last.x; ++chunkX) {
+				const ChunkCoord coord {chunkX, chunkY};
+				if (m_chunkHandles.contains(coord))
+					continue;
+				tiles.fill(0u);
+				load(coord, std::span<TileId, CHUNK_AREA> {tiles});
+				this->loadChunk(coord, tiles);
+				++stats.loadedCount;
+			}
+		}
+
+		/* backwards, as erasing moves the last chunk into the hole */
+		const auto [keepFirst, keepLast] {getChunkRange(view, m_config.evictMargin)};
+		for (std::size_t i {m_chunks.size()}; i-- > 0uz;) {
+			const Chunk& chunk {m_chunks.getValues()[i]};
+			if (chunk.coord.x >= keepFirst.x && chunk.coord.x <= keepLast.x
+				&& chunk.coord.y >= keepFirst.y && chunk.coord.y <= keepLast.y
+			) {
+				continue;
+			}
+			const ChunkCoord coord {chunk.coord};
+			toRowMajor(chunk, tiles);
+			evict(coord, std::span<const TileId, CHUNK_AREA> {tiles});
+			this->evictChunk(coord);
+			++stats.evictedCount;
+		}
+		return stats;
+	}
+}
@@ -0,0 +1,852 @@
+#include "voxlet/assets/aseprite.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+#include <immintrin.h>
+
+#include "voxlet/compression/deflate.hpp"
+#include "voxlet/io/mappedFile.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::assets {
+	namespace {
+		constexpr std::uint16_t FILE_MAGIC {0xa5e0u};
+		constexpr std::uint16_t FRAME_MAGIC {0xf1fau};
+		constexpr std::size_t HEADER_SIZE {128uz};
+		constexpr std::size_t FRAME_HEADER_SIZE {16uz};
+		constexpr std::size_t CHUNK_HEADER_SIZE {6uz};
+		constexpr std::uint32_t OPAQUE {0xff00'0000u};
+
+		constexpr std::uint32_t HEADER_FLAG_LAYER_OPACITY {1u};
+		constexpr std::uint16_t LAYER_FLAG_VISIBLE {1u};
+		constexpr std::uint16_t LAYER_FLAG_BACKGROUND {8u};
+		constexpr std::uint16_t PALETTE_FLAG_NAME {1u};
+		constexpr std::uint32_t SLICE_FLAG_CENTER {1u};
+		constexpr std::uint32_t SLICE_FLAG_PIVOT {2u};
+
+		enum class ChunkType : std::uint16_t {
+			oldPalette = 0x0004u,
+			layer = 0x2004u,
+			cel = 0x2005u,
+			tags = 0x2018u,
+			palette = 0x2019u,
+			slice = 0x2022u
+		};
+
+		enum class LayerType : std::uint16_t {
+			normal,
+			group,
+			tilemap
+		};
+
+		enum class CelType : std::uint16_t {
+			raw,
+			linked,
+			compressed,
+			compressedTilemap
+		};
+
+		/* little-endian fields of a chunk, reading past its end only sets `hasFailed` and yields zeros */
+		class ByteReader final {
+			public:
+				explicit ByteReader(const std::span<const std::byte> bytes) noexcept : m_bytes {bytes} {}
+
+				auto readBytes(const std::size_t size) noexcept -> std::span<const std::byte> {
+					if (size > m_bytes.size() - m_offset) {
+						m_hasFailed = true;
+						m_offset = m_bytes.size();
+						return {};
+					}
+					m_offset += size;
+					return m_bytes.subspan(m_offset - size, size);
+				}
+
+				auto read8() noexcept -> std::uint8_t {
+					const std::span<const std::byte> bytes {this->readBytes(1uz)};
+					return bytes.empty() ? std::uint8_t{0u} : static_cast<std::uint8_t> (bytes[0]);
+				}
+
+				auto read16() noexcept -> std::uint16_t {
+					const std::uint32_t low {this->read8()};
+					return static_cast<std::uint16_t> (low | (static_cast<std::uint32_t> (this->read8()) << 8u));
+				}
+
+				auto read32() noexcept -> std::uint32_t {
+					const std::uint32_t low {this->read16()};
+					return low | (static_cast<std::uint32_t> (this->read16()) << 16u);
+				}
+
+				auto readSigned16() noexcept -> std::int16_t {return static_cast<std::int16_t> (this->read16());}
+				auto readSigned32() noexcept -> std::int32_t {return static_cast<std::int32_t> (this->read32());}
+
+				auto readString() noexcept -> vx::String {
+					const std::span<const std::byte> bytes {this->readBytes(this->read16())};
+					return vx::String::from(reinterpret_cast<const char8_t*> (bytes.data()), bytes.size());
+				}
+
+				auto skip(const std::size_t size) noexcept -> void {(void)this->readBytes(size);}
+
+				[[nodiscard]]
+				constexpr auto getRemaining() const noexcept -> std::span<const std::byte> {return m_bytes.subspan(m_offset);}
+				[[nodiscard]]
+				constexpr auto hasFailed() const noexcept -> bool {return m_hasFailed;}
+
+			private:
+				std::span<const std::byte> m_bytes;
+				std::size_t m_offset {0uz};
+				bool m_hasFailed {false};
+		};
+
+		struct LayerState {
+			/* visible, and neither a group nor a tilemap */
+			bool isDrawn;
+			bool isBackground;
+			/* with the one of the groups it's in */
+			std::uint8_t opacity;
+			/* the last cel decoded on the layer, kept while the next frames link to it */
+			std::vector<std::uint32_t> pixels;
+			const std::byte* decodedData;
+			std::uint32_t decodedPalette;
+		};
+
+		struct Cel {
+			std::uint32_t layer;
+			std::int32_t x;
+			std::int32_t y;
+			std::uint32_t width;
+			std::uint32_t height;
+			std::uint8_t opacity;
+			std::int16_t zIndex;
+			/* in the file, the same bytes for every cel that stores the same content */
+			std::span<const std::byte> data;
+			bool isCompressed;
+		};
+
+		/* the `MUL_UN8` of Aseprite, `a * b / 255` rounded */
+		constexpr auto multiply(const std::uint32_t a, const std::uint32_t b) noexcept -> std::uint8_t {
+			const std::uint32_t product {a * b + 0x80u};
+			return static_cast<std::uint8_t> (((product >> 8u) + product) >> 8u);
+		}
+
+		constexpr auto mix(const std::uint64_t hash, const std::uint64_t value) noexcept -> std::uint64_t {
+			const std::uint64_t mixed {(hash ^ value) * 0xff51'afd7'ed55'8ccdu};
+			return mixed ^ (mixed >> 32u);
+		}
+
+		/* four lanes of 8 bytes, so that their multiplications overlap */
+		auto hashBytes(const std::span<const std::byte> bytes) noexcept -> std::uint64_t {
+			std::array<std::uint64_t, 4uz> lanes {0x9e37'79b9'7f4a'7c15u, 0xbf58'476d'1ce4'e5b9u, 0x94d0'49bb'1331'11ebu, 0x2545'f491'4f6c'dd1du};
+			std::size_t i {0uz};
+			for (; i + 32uz <= bytes.size(); i += 32uz) {
+				for (std::size_t lane {0uz}; lane < lanes.size(); ++lane) {
+					std::uint64_t value;
+					(void)std::memcpy(&value, bytes.data() + i + lane * 8uz, sizeof(value));
+					lanes[lane] = mix(lanes[lane], value);
+				}
+			}
+			std::uint64_t hash {bytes.size()};
+			for (const std::uint64_t lane : lanes)
+				hash = mix(hash, lane);
+			for (; i < bytes.size(); ++i)
+				hash = mix(hash, static_cast<std::uint64_t> (bytes[i]));
+			return hash;
+		}
+
+
+		struct Channels {
+			__m256 red;
+			__m256 green;
+			__m256 blue;
+			__m256 alpha;
+		};
+
+		[[gnu::always_inline]]
+		inline auto loadChannels(const __m256i pixels) noexcept -> Channels {
+			const __m256i mask {_mm256_set1_epi32(0xff)};
+			return {
+				.red = _mm256_cvtepi32_ps(_mm256_and_si256(pixels, mask)),
+				.green = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask)),
+				.blue = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask)),
+				.alpha = _mm256_cvtepi32_ps(_mm256_srli_epi32(pixels, 24))
+			};
+		}
+
+		[[gnu::always_inline]]
+		inline auto storeChannels(const Channels& channels) noexcept -> __m256i {
+			return _mm256_or_si256(
+				_mm256_or_si256(_mm256_cvtps_epi32(channels.red), _mm256_slli_epi32(_mm256_cvtps_epi32(channels.green), 8)),
+				_mm256_or_si256(
+					_mm256_slli_epi32(_mm256_cvtps_epi32(channels.blue), 16),
+					_mm256_slli_epi32(_mm256_cvtps_epi32(channels.alpha), 24)
+				)
+			);
+		}
+
+		/* `B(backdrop, source)` of the separable blend modes, on 0 to 255 */
+		template <AsepriteBlendMode MODE>
+		[[gnu::always_inline]]
+		inline auto blendChannel(const __m256 backdrop, const __m256 source) noexcept -> __m256 {
+			const __m256 inverse {_mm256_set1_ps(1.f / 255.f)};
+			const __m256 zero {_mm256_setzero_ps()};
+			const __m256 full {_mm256_set1_ps(255.f)};
+			/* keeps the divisions finite, the lanes where they would not be are replaced afterwards */
+			const __m256 epsilon {_mm256_set1_ps(1e-3f)};
+			const auto screen {[&](const __m256 left, const __m256 right) noexcept -> __m256 {
+				return _mm256_sub_ps(_mm256_add_ps(left, right), _mm256_mul_ps(_mm256_mul_ps(left, right), inverse));
+			}};
+			/* multiplies by twice the top when it's dark, screens by twice its excess over half when it's light */
+			const auto hardLight {[&](const __m256 bottom, const __m256 top) noexcept -> __m256 {
+				const __m256 doubled {_mm256_add_ps(top, top)};
+				const __m256 dark {_mm256_mul_ps(_mm256_mul_ps(bottom, doubled), inverse)};
+				const __m256 light {screen(bottom, _mm256_sub_ps(doubled, full))};
+				return _mm256_blendv_ps(dark, light, _mm256_cmp_ps(top, _mm256_set1_ps(127.5f), _CMP_GT_OQ));
+			}};
+			if constexpr (MODE == AsepriteBlendMode::multiply)
+				return _mm256_mul_ps(_mm256_mul_ps(backdrop, source), inverse);
+			else if constexpr (MODE == AsepriteBlendMode::screen)
+				return screen(backdrop, source);
+			else if constexpr (MODE == AsepriteBlendMode::overlay)
+				return hardLight(source, backdrop);
+			else if constexpr (MODE == AsepriteBlendMode::darken)
+				return _mm256_min_ps(backdrop, source);
+			else if constexpr (MODE == AsepriteBlendMode::lighten)
+				return _mm256_max_ps(backdrop, source);
+			else if constexpr (MODE == AsepriteBlendMode::colorDodge) {
+				const __m256 dodged {_mm256_min_ps(
+					_mm256_div_ps(_mm256_mul_ps(backdrop, full), _mm256_max_ps(_mm256_sub_ps(full, source), epsilon)),
+					full
+				)};
+				return _mm256_and_ps(dodged, _mm256_cmp_ps(backdrop, zero, _CMP_GT_OQ));
+			}
+			else if constexpr (MODE == AsepriteBlendMode::colorBurn) {
+				const __m256 burnt {_mm256_max_ps(
+					_mm256_sub_ps(full, _mm256_div_ps(_mm256_mul_ps(_mm256_sub_ps(full, backdrop), full), _mm256_max_ps(source, epsilon))),
+					zero
+				)};
+				return _mm256_blendv_ps(burnt, full, _mm256_cmp_ps(backdrop, full, _CMP_GE_OQ));
+			}
+			else if constexpr (MODE == AsepriteBlendMode::hardLight)
+				return hardLight(backdrop, source);
+			else if constexpr (MODE == AsepriteBlendMode::softLight) {
+				/* the W3C one, on 0 to 1 */
+				const __m256 one {_mm256_set1_ps(1.f)};
+				const __m256 bottom {_mm256_mul_ps(backdrop, inverse)};
+				const __m256 top {_mm256_mul_ps(source, inverse)};
+				const __m256 doubled {_mm256_sub_ps(_mm256_add_ps(top, top), one)};
+				const __m256 polynomial {_mm256_mul_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(16.f), bottom), _mm256_set1_ps(12.f)), bottom), _mm256_set1_ps(4.f)),
+					bottom
+				)};
+				const __m256 curve {_mm256_blendv_ps(
+					_mm256_sqrt_ps(bottom),
+					polynomial,
+					_mm256_cmp_ps(bottom, _mm256_set1_ps(.25f), _CMP_LE_OQ)
+				)};
+				const __m256 dark {_mm256_add_ps(bottom, _mm256_mul_ps(doubled, _mm256_mul_ps(bottom, _mm256_sub_ps(one, bottom))))};
+				const __m256 light {_mm256_add_ps(bottom, _mm256_mul_ps(doubled, _mm256_sub_ps(curve, bottom)))};
+				return _mm256_mul_ps(_mm256_blendv_ps(dark, light, _mm256_cmp_ps(top, _mm256_set1_ps(.5f), _CMP_GT_OQ)), full);
+			}
+			else if constexpr (MODE == AsepriteBlendMode::difference)
+				return _mm256_max_ps(_mm256_sub_ps(backdrop, source), _mm256_sub_ps(source, backdrop));
+			else if constexpr (MODE == AsepriteBlendMode::exclusion) {
+				const __m256 product {_mm256_mul_ps(_mm256_mul_ps(backdrop, source), inverse)};
+				return _mm256_sub_ps(_mm256_add_ps(backdrop, source), _mm256_add_ps(product, product));
+			}
+			else if constexpr (MODE == AsepriteBlendMode::addition)
+				return _mm256_min_ps(_mm256_add_ps(backdrop, source), full);
+			else if constexpr (MODE == AsepriteBlendMode::subtract)
+				return _mm256_max_ps(_mm256_sub_ps(backdrop, source), zero);
+			else if constexpr (MODE == AsepriteBlendMode::divide) {
+				/* white where the backdrop is at least the source, black where it's black */
+				const __m256 divided {_mm256_div_ps(_mm256_mul_ps(backdrop, full), _mm256_max_ps(source, epsilon))};
+				const __m256 clamped {_mm256_blendv_ps(divided, full, _mm256_cmp_ps(backdrop, source, _CMP_GE_OQ))};
+				return _mm256_and_ps(clamped, _mm256_cmp_ps(backdrop, zero, _CMP_GT_OQ));
+			}
+			else
+				return source;
+		}
+
+		/*
+		 * Source over backdrop on 8 pixels, in floats since the backdrop may be translucent and the result
+		 * divided by its alpha. The blend mode only weighs as much as the backdrop is opaque, the source color
+		 * being `(1 - Ab) * Cs + Ab * B(Cb, Cs)`.
+		 */
+		template <AsepriteBlendMode MODE>
+		[[gnu::always_inline]]
+		inline auto blendPixels(const __m256i backdropPixels, const __m256i sourcePixels, const __m256 opacity) noexcept -> __m256i {
+			const Channels backdrop {loadChannels(backdropPixels)};
+			Channels source {loadChannels(sourcePixels)};
+			const __m256 inverse {_mm256_set1_ps(1.f / 255.f)};
+			if constexpr (MODE != AsepriteBlendMode::normal) {
+				const __m256 coverage {_mm256_mul_ps(backdrop.alpha, inverse)};
+				const auto mix {[&](const __m256 backdropColor, const __m256 sourceColor) noexcept -> __m256 {
+					const __m256 blended {blendChannel<MODE> (backdropColor, sourceColor)};
+					return _mm256_add_ps(sourceColor, _mm256_mul_ps(_mm256_sub_ps(blended, sourceColor), coverage));
+				}};
+				source.red = mix(backdrop.red, source.red);
+				source.green = mix(backdrop.green, source.green);
+				source.blue = mix(backdrop.blue, source.blue);
+			}
+
+			const __m256 sourceAlpha {_mm256_mul_ps(source.alpha, opacity)};
+			const __m256 alpha {_mm256_sub_ps(
+				_mm256_add_ps(sourceAlpha, backdrop.alpha),
+				_mm256_mul_ps(_mm256_mul_ps(backdrop.alpha, sourceAlpha), inverse)
+			)};
+			/* the alpha is only zero where the source one is */
+			const __m256 weight {_mm256_div_ps(sourceAlpha, _mm256_max_ps(alpha, _mm256_set1_ps(1e-3f)))};
+			const auto lerp {[weight](const __m256 from, const __m256 to) noexcept -> __m256 {
+				return _mm256_add_ps(from, _mm256_mul_ps(_mm256_sub_ps(to, from), weight));
+			}};
+			return storeChannels({
+				.red = lerp(backdrop.red, source.red),
+				.green = lerp(backdrop.green, source.green),
+				.blue = lerp(backdrop.blue, source.blue),
+				.alpha = alpha
+			});
+		}
+
+		/* skips the runs of transparent pixels of the cel, and copies the opaque ones when nothing blends */
+		template <AsepriteBlendMode MODE>
+		auto compositeRow(std::uint32_t* const destination, const std::byte* const source, const std::size_t count, const std::uint8_t opacity)
+			noexcept
+			-> void
+		{
+			const __m256 normalizedOpacity {_mm256_set1_ps(static_cast<float> (opacity) / 255.f)};
+			const __m256i alphaMask {_mm256_set1_epi32(static_cast<int> (OPAQUE))};
+			const bool canCopy {MODE == AsepriteBlendMode::normal && opacity == 0xffu};
+			const auto blend {[&](std::uint32_t* const backdrop, const void* const pixels) noexcept {
+				const __m256i sourcePixels {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (pixels))};
+				const __m256i alpha {_mm256_and_si256(sourcePixels, alphaMask)};
+				if (_mm256_testz_si256(alpha, alpha))
+					return;
+				if (canCopy && _mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, alphaMask)) == -1) {
+					_mm256_storeu_si256(reinterpret_cast<__m256i*> (backdrop), sourcePixels);
+					return;
+				}
+				const __m256i backdropPixels {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (backdrop))};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*> (backdrop), blendPixels<MODE> (backdropPixels, sourcePixels, normalizedOpacity));
+			}};
+
+			std::size_t x {0uz};
+			for (; x + 8uz <= count; x += 8uz)
+				blend(destination + x, source + x * 4uz);
+			if (x == count)
+				return;
+			/* through a full register so that the last pixels round the same as the others */
+			std::array<std::uint32_t, 8uz> backdrop {};
+			std::array<std::uint32_t, 8uz> pixels {};
+			vx::memory::memcpy(backdrop.data(), destination + x, count - x);
+			(void)std::memcpy(pixels.data(), source + x * 4uz, (count - x) * 4uz);
+			blend(backdrop.data(), pixels.data());
+			vx::memory::memcpy(destination + x, backdrop.data(), count - x);
+		}
+
+		using CompositeRow = auto (*)(std::uint32_t*, const std::byte*, std::size_t, std::uint8_t) noexcept -> void;
+
+		/* the non-separable modes, hue, saturation, color and luminosity, are drawn as normal */
+		auto getCompositeRow(const AsepriteBlendMode mode) noexcept -> CompositeRow {
+			switch (mode) {
+				case AsepriteBlendMode::multiply:
+					return compositeRow<AsepriteBlendMode::multiply>;
+				case AsepriteBlendMode::screen:
+					return compositeRow<AsepriteBlendMode::screen>;
+				case AsepriteBlendMode::overlay:
+					return compositeRow<AsepriteBlendMode::overlay>;
+				case AsepriteBlendMode::darken:
+					return compositeRow<AsepriteBlendMode::darken>;
+				case AsepriteBlendMode::lighten:
+					return compositeRow<AsepriteBlendMode::lighten>;
+				case AsepriteBlendMode::colorDodge:
+					return compositeRow<AsepriteBlendMode::colorDodge>;
+				case AsepriteBlendMode::colorBurn:
+					return compositeRow<AsepriteBlendMode::colorBurn>;
+				case AsepriteBlendMode::hardLight:
+					return compositeRow<AsepriteBlendMode::hardLight>;
+				case AsepriteBlendMode::softLight:
+					return compositeRow<AsepriteBlendMode::softLight>;
+				case AsepriteBlendMode::difference:
+					return compositeRow<AsepriteBlendMode::difference>;
+				case AsepriteBlendMode::exclusion:
+					return compositeRow<AsepriteBlendMode::exclusion>;
+				case AsepriteBlendMode::addition:
+					return compositeRow<AsepriteBlendMode::addition>;
+				case AsepriteBlendMode::subtract:
+					return compositeRow<AsepriteBlendMode::subtract>;
+				case AsepriteBlendMode::divide:
+					return compositeRow<AsepriteBlendMode::divide>;
+				default:
+					return compositeRow<AsepriteBlendMode::normal>;
+			}
+		}
+
+
+		/* to RGBA8, `data` holds `count` pixels of `colorDepth` bits */
+		auto convertCelPixels(
+			const std::span<const std::byte> data,
+			const std::uint32_t colorDepth,
+			const vx::render::Palette& palette,
+			const std::optional<std::uint8_t> transparentIndex,
+			std::uint32_t* const pixels,
+			const std::size_t count
+		) noexcept -> void {
+			const auto* const bytes {reinterpret_cast<const std::uint8_t*> (data.data())};
+			if (colorDepth == 32u) {
+				if (count != 0uz)
+					vx::memory::memcpy(reinterpret_cast<std::uint8_t*> (pixels), bytes, count * 4uz);
+				return;
+			}
+			if (colorDepth == 16u) {
+				for (std::size_t i {0uz}; i < count; ++i)
+					pixels[i] = (bytes[i * 2uz] * 0x01'0101u) | (static_cast<std::uint32_t> (bytes[i * 2uz + 1uz]) << 24u);
+				return;
+			}
+			for (std::size_t i {0uz}; i < count; ++i)
+				pixels[i] = bytes[i] == transparentIndex ? 0u : palette[bytes[i]];
+		}
+
+		auto readLayer(ByteReader& reader, const bool hasLayerOpacity, std::vector<AsepriteLayer>& layers, std::vector<LayerState>& states)
+			noexcept
+			-> bool
+		{
+			const std::uint16_t flags {reader.read16()};
+			const auto type {static_cast<LayerType> (reader.read16())};
+			const std::uint16_t childLevel {reader.read16()};
+			reader.skip(4uz);
+			const auto blendMode {static_cast<AsepriteBlendMode> (reader.read16())};
+			const std::uint8_t opacity {reader.read8()};
+			reader.skip(3uz);
+			vx::String name {reader.readString()};
+			if (reader.hasFailed() || blendMode > AsepriteBlendMode::divide)
+				return false;
+
+			AsepriteLayer layer {
+				.name = std::move(name),
+				.blendMode = blendMode,
+				.opacity = hasLayerOpacity ? opacity : std::uint8_t{0xffu},
+				.childLevel = childLevel,
+				.isVisible = (flags & LAYER_FLAG_VISIBLE) != 0u,
+				.isGroup = type == LayerType::group
+			};
+			/* a group is written right before its layers */
+			std::uint8_t groupOpacity {0xffu};
+			if (childLevel != 0u) {
+				const auto parent {std::ranges::find(layers.rbegin(), layers.rend(), childLevel - 1u, &AsepriteLayer::childLevel)};
+				if (parent == layers.rend() || !parent->isGroup)
+					return false;
+				layer.isVisible = layer.isVisible && parent->isVisible;
+				groupOpacity = states[static_cast<std::size_t> (layers.rend() - parent) - 1uz].opacity;
+			}
+			states.push_back({
+				.isDrawn = layer.isVisible && type == LayerType::normal,
+				.isBackground = (flags & LAYER_FLAG_BACKGROUND) != 0u,
+				.opacity = multiply(layer.opacity, groupOpacity),
+				.pixels = {},
+				.decodedData = nullptr,
+				.decodedPalette = 0u
+			});
+			layers.push_back(std::move(layer));
+			return true;
+		}
+
+		auto readTags(ByteReader& reader, const std::size_t frameCount, std::vector<AsepriteTag>& tags) noexcept -> bool {
+			const std::uint16_t count {reader.read16()};
+			reader.skip(8uz);
+			for (std::uint16_t i {0u}; i < count; ++i) {
+				const std::uint16_t from {reader.read16()};
+				const std::uint16_t to {reader.read16()};
+				const std::uint8_t direction {reader.read8()};
+				const std::uint16_t repeat {reader.read16()};
+				reader.skip(10uz);
+				vx::String name {reader.readString()};
+				if (reader.hasFailed() || from > to || to >= frameCount || direction > std::to_underlying(AsepriteDirection::pingPongReverse))
+					return false;
+				tags.push_back({
+					.name = std::move(name),
+					.from = from,
+					.to = to,
+					.direction = static_cast<AsepriteDirection> (direction),
+					.repeat = repeat
+				});
+			}
+			return true;
+		}
+
+		auto readSlice(ByteReader& reader, std::vector<AsepriteSlice>& slices) noexcept -> bool {
+			const std::uint32_t keyCount {reader.read32()};
+			const std::uint32_t flags {reader.read32()};
+			reader.skip(4uz);
+			AsepriteSlice slice {
+				.name = reader.readString(),
+				.hasCenter = (flags & SLICE_FLAG_CENTER) != 0u,
+				.hasPivot = (flags & SLICE_FLAG_PIVOT) != 0u,
+				.keys = {}
+			};
+			/* keys are at least 20 bytes, which bounds the count before anything is reserved */
+			if (reader.hasFailed() || keyCount > reader.getRemaining().size() / 20uz)
+				return false;
+			slice.keys.reserve(keyCount);
+			for (std::uint32_t i {0u}; i < keyCount; ++i) {
+				AsepriteSliceKey key {
+					.frame = reader.read32(),
+					.x = reader.readSigned32(),
+					.y = reader.readSigned32(),
+					.width = reader.read32(),
+					.height = reader.read32(),
+					.centerX = 0,
+					.centerY = 0,
+					.centerWidth = 0u,
+					.centerHeight = 0u,
+					.pivotX = 0,
+					.pivotY = 0
+				};
+				if (slice.hasCenter) {
+					key.centerX = reader.readSigned32();
+					key.centerY = reader.readSigned32();
+					key.centerWidth = reader.read32();
+					key.centerHeight = reader.read32();
+				}
+				if (slice.hasPivot) {
+					key.pivotX = reader.readSigned32();
+					key.pivotY = reader.readSigned32();
+				}
+				slice.keys.push_back(key);
+			}
+			if (reader.hasFailed())
+				return false;
+			slices.push_back(std::move(slice));
+			return true;
+		}
+
+		auto readPalette(ByteReader& reader, vx::render::Palette& palette) noexcept -> bool {
+			(void)reader.read32();
+			const std::uint32_t first {reader.read32()};
+			const std::uint32_t last {reader.read32()};
+			reader.skip(8uz);
+			if (first > last)
+				return false;
+			for (std::uint32_t i {first}; i <= last && !reader.hasFailed(); ++i) {
+				const std::uint16_t flags {reader.read16()};
+				const std::span<const std::byte> color {reader.readBytes(4uz)};
+				if ((flags & PALETTE_FLAG_NAME) != 0u)
+					reader.skip(reader.read16());
+				/* RGB sprites may have bigger palettes, which only matter to the editor */
+				if (i < palette.size() && !color.empty())
+					(void)std::memcpy(&palette[i], color.data(), color.size());
+			}
+			return !reader.hasFailed();
+		}
+
+		/* the chunk of files written before Aseprite 1.2, in the newer ones too for older readers */
+		auto readOldPalette(ByteReader& reader, vx::render::Palette& palette) noexcept -> bool {
+			const std::uint16_t packetCount {reader.read16()};
+			std::size_t index {0uz};
+			for (std::uint16_t i {0u}; i < packetCount && !reader.hasFailed(); ++i) {
+				index += reader.read8();
+				const std::uint32_t count {reader.read8()};
+				const std::span<const std::byte> colors {reader.readBytes((count == 0u ? 256uz : count) * 3uz)};
+				for (std::size_t color {0uz}; color < colors.size() && index < palette.size(); color += 3uz, ++index) {
+					palette[index] = OPAQUE
+						| static_cast<std::uint32_t> (colors[color])
+						| (static_cast<std::uint32_t> (colors[color + 1uz]) << 8u)
+						| (static_cast<std::uint32_t> (colors[color + 2uz]) << 16u);
+				}
+			}
+			return !reader.hasFailed();
+		}
+	}
+
+
+	auto Aseprite::open(const vx::StringSlice& path) noexcept -> std::optional<Aseprite> {
+		const std::optional<vx::io::MappedFile> file {vx::io::MappedFile::open(path)};
+		if (!file)
+			return std::nullopt;
+		return Aseprite::fromBytes(file->getBytes());
+	}
+
+	auto Aseprite::fromBytes(const std::span<const std::byte> bytes) noexcept -> std::optional<Aseprite> {
+		ByteReader header {bytes.first(std::min(bytes.size(), HEADER_SIZE))};
+		header.skip(4uz);
+		const std::uint16_t magic {header.read16()};
+		const std::uint16_t frameCount {header.read16()};
+		Aseprite aseprite {};
+		aseprite.m_width = header.read16();
+		aseprite.m_height = header.read16();
+		const std::uint16_t colorDepth {header.read16()};
+		const std::uint32_t flags {header.read32()};
+		header.skip(10uz);
+		const std::uint8_t transparentIndex {header.read8()};
+		if (header.hasFailed() || magic != FILE_MAGIC || frameCount == 0u || aseprite.m_width == 0u || aseprite.m_height == 0u)
+			return std::nullopt;
+		if (colorDepth != 32u && colorDepth != 16u && colorDepth != 8u)
+			return std::nullopt;
+		const std::size_t bytesPerPixel {colorDepth / 8uz};
+		const std::size_t canvasSize {static_cast<std::size_t> (aseprite.m_width) * aseprite.m_height};
+		aseprite.m_palette.fill(OPAQUE);
+
+		/* everything below is reused from one frame to the next */
+		std::vector<LayerState> layerStates {};
+		std::vector<Cel> cels {};
+		std::vector<std::size_t> frameCels {};
+		frameCels.reserve(frameCount + 1uz);
+		/* sorted by hash, a few entries per file that a map would allocate one node each for */
+		std::vector<std::pair<std::uint64_t, std::span<const std::byte>>> celDataByHash {};
+		std::vector<std::byte> inflated {};
+		std::vector<std::uint32_t> canvas (canvasSize);
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> imagesByHash {};
+		imagesByHash.reserve(frameCount);
+		aseprite.m_frames.reserve(frameCount);
+		bool hasPalette {false};
+		/* bumped when the palette changes, an indexed cel decoded before has to be decoded again */
+		std::uint32_t paletteVersion {0u};
+
+		std::size_t offset {HEADER_SIZE};
+		for (std::uint16_t frame {0u}; frame < frameCount; ++frame) {
+			ByteReader frameHeader {bytes.subspan(std::min(offset, bytes.size()))};
+			const std::uint32_t frameSize {frameHeader.read32()};
+			const std::uint16_t frameMagic {frameHeader.read16()};
+			const std::uint16_t oldChunkCount {frameHeader.read16()};
+			const std::uint16_t duration {frameHeader.read16()};
+			frameHeader.skip(2uz);
+			const std::uint32_t chunkCount {frameHeader.read32()};
+			if (frameHeader.hasFailed() || frameMagic != FRAME_MAGIC || frameSize < FRAME_HEADER_SIZE || frameSize > bytes.size() - offset)
+				return std::nullopt;
+			ByteReader chunks {bytes.subspan(offset + FRAME_HEADER_SIZE, frameSize - FRAME_HEADER_SIZE)};
+			offset += frameSize;
+
+			frameCels.push_back(cels.size());
+			for (std::uint32_t chunk {0u}; chunk < (chunkCount == 0u ? oldChunkCount : chunkCount); ++chunk) {
+				ByteReader chunkHeader {chunks.getRemaining()};
+				const std::uint32_t chunkSize {chunkHeader.read32()};
+				const auto type {static_cast<ChunkType> (chunkHeader.read16())};
+				if (chunkHeader.hasFailed() || chunkSize < CHUNK_HEADER_SIZE)
+					return std::nullopt;
+				const std::span<const std::byte> chunkBytes {chunks.readBytes(chunkSize)};
+				if (chunks.hasFailed())
+					return std::nullopt;
+				ByteReader reader {chunkBytes.subspan(CHUNK_HEADER_SIZE)};
+
+				bool isValid {true};
+				if (type == ChunkType::layer)
+					isValid = readLayer(reader, (flags & HEADER_FLAG_LAYER_OPACITY) != 0u, aseprite.m_layers, layerStates);
+				else if (type == ChunkType::tags)
+					isValid = readTags(reader, frameCount, aseprite.m_tags);
+				else if (type == ChunkType::slice)
+					isValid = readSlice(reader, aseprite.m_slices);
+				else if (type == ChunkType::palette) {
+					isValid = readPalette(reader, aseprite.m_palette);
+					hasPalette = true;
+					++paletteVersion;
+				}
+				else if (type == ChunkType::oldPalette && !hasPalette) {
+					isValid = readOldPalette(reader, aseprite.m_palette);
+					++paletteVersion;
+				}
+				if (!isValid)
+					return std::nullopt;
+				if (type != ChunkType::cel)
+					continue;
+
+				Cel cel {
+					.layer = reader.read16(),
+					.x = reader.readSigned16(),
+					.y = reader.readSigned16(),
+					.width = 0u,
+					.height = 0u,
+					.opacity = reader.read8(),
+					.zIndex = 0,
+					.data = {},
+					.isCompressed = false
+				};
+				const auto celType {static_cast<CelType> (reader.read16())};
+				cel.zIndex = reader.readSigned16();
+				reader.skip(5uz);
+				if (reader.hasFailed() || cel.layer >= aseprite.m_layers.size())
+					return std::nullopt;
+
+				if (celType == CelType::linked) {
+					const std::uint16_t linkedFrame {reader.read16()};
+					if (reader.hasFailed() || linkedFrame >= frame)
+						return std::nullopt;
+					const auto first {cels.begin() + static_cast<std::ptrdiff_t> (frameCels[linkedFrame])};
+					const auto last {cels.begin() + static_cast<std::ptrdiff_t> (frameCels[linkedFrame + 1uz])};
+					const auto linked {std::ranges::find(first, last, cel.layer, &Cel::layer)};
+					if (linked == last)
+						return std::nullopt;
+					const std::int16_t zIndex {cel.zIndex};
+					cel = *linked;
+					cel.zIndex = zIndex;
+					cels.push_back(cel);
+					continue;
+				}
+				if (celType != CelType::raw && celType != CelType::compressed)
+					continue;
+
+				cel.width = reader.read16();
+				cel.height = reader.read16();
+				const std::size_t size {static_cast<std::size_t> (cel.width) * cel.height * bytesPerPixel};
+				cel.isCompressed = celType == CelType::compressed;
+				cel.data = cel.isCompressed ? reader.getRemaining() : reader.readBytes(size);
+				/* deflate can't expand past about a thousand times, a larger size is corrupted */
+				if (reader.hasFailed() || (cel.isCompressed && size / 1032uz > cel.data.size()))
+					return std::nullopt;
+				/* a cel pasted again shares the bytes of the first one, so that it's decoded once */
+				if (cel.isCompressed || colorDepth != 32u) {
+					const std::uint64_t hash {hashBytes(cel.data)};
+					const auto [candidate, end] {std::ranges::equal_range(celDataByHash, hash, {}, &std::pair<std::uint64_t, std::span<const std::byte>>::first)};
+					const auto same {std::find_if(candidate, end, [&](const auto& entry) noexcept {
+						return std::ranges::equal(entry.second, cel.data);
+					})};
+					if (same != end)
+						cel.data = same->second;
+					else
+						celDataByHash.emplace(end, hash, cel.data);
+				}
+				cels.push_back(cel);
+			}
+
+			/* the layer index offset by the z-index is the order, ties go to the lower z-index */
+			const auto first {cels.begin() + static_cast<std::ptrdiff_t> (frameCels.back())};
+			std::ranges::stable_sort(first, cels.end(), [](const Cel& left, const Cel& right) noexcept {
+				const std::int64_t leftOrder {static_cast<std::int64_t> (left.layer) + left.zIndex};
+				const std::int64_t rightOrder {static_cast<std::int64_t> (right.layer) + right.zIndex};
+				return leftOrder != rightOrder ? leftOrder < rightOrder : left.zIndex < right.zIndex;
+			});
+
+			std::ranges::fill(canvas, 0u);
+			for (auto cel {first}; cel != cels.end(); ++cel) {
+				LayerState& layer {layerStates[cel->layer]};
+				const std::uint8_t opacity {multiply(cel->opacity, layer.opacity)};
+				if (!layer.isDrawn || opacity == 0u)
+					continue;
+				const std::int64_t left {std::max<std::int64_t> (cel->x, 0)};
+				const std::int64_t top {std::max<std::int64_t> (cel->y, 0)};
+				const std::int64_t right {std::min<std::int64_t> (static_cast<std::int64_t> (cel->x) + cel->width, aseprite.m_width)};
+				const std::int64_t bottom {std::min<std::int64_t> (static_cast<std::int64_t> (cel->y) + cel->height, aseprite.m_height)};
+				if (left >= right || top >= bottom)
+					continue;
+
+				/* RGBA cels are composited straight from the file, the others from the buffer of their layer */
+				const bool needsDecoding {cel->isCompressed || colorDepth != 32u};
+				const std::size_t count {static_cast<std::size_t> (cel->width) * cel->height};
+				const bool isDecoded {layer.decodedData == cel->data.data() && layer.decodedPalette == paletteVersion && layer.pixels.size() == count};
+				if (needsDecoding && !isDecoded) {
+					layer.pixels.resize(count);
+					std::span<const std::byte> data {cel->data};
+					if (cel->isCompressed) {
+						std::span<std::byte> output {std::as_writable_bytes(std::span{layer.pixels})};
+						if (colorDepth != 32u) {
+							inflated.resize(count * bytesPerPixel);
+							output = inflated;
+						}
+						if (vx::compression::inflate(cel->data, output, vx::compression::DeflateFormat::zlib) != output.size())
+							return std::nullopt;
+						data = output;
+					}
+					if (colorDepth != 32u) {
+						const bool hasTransparentIndex {colorDepth == 8u && !layer.isBackground};
+						convertCelPixels(
+							data,
+							colorDepth,
+							aseprite.m_palette,
+							hasTransparentIndex ? std::optional{transparentIndex} : std::nullopt,
+							layer.pixels.data(),
+							count
+						);
+					}
+					layer.decodedData = cel->data.data();
+					layer.decodedPalette = paletteVersion;
+				}
+				const std::byte* const pixels {needsDecoding ? reinterpret_cast<const std::byte*> (layer.pixels.data()) : cel->data.data()};
+
+				const CompositeRow composite {getCompositeRow(aseprite.m_layers[cel->layer].blendMode)};
+				for (std::int64_t y {top}; y < bottom; ++y) {
+					composite(
+						canvas.data() + static_cast<std::size_t> (y * aseprite.m_width + left),
+						pixels + static_cast<std::size_t> ((y - cel->y) * cel->width + (left - cel->x)) * 4uz,
+						static_cast<std::size_t> (right - left),
+						opacity
+					);
+				}
+			}
+
+			const std::uint64_t hash {hashBytes(std::as_bytes(std::span{canvas}))};
+			const auto [candidate, end] {std::ranges::equal_range(imagesByHash, hash, {}, &std::pair<std::uint64_t, std::uint32_t>::first)};
+			const auto same {std::find_if(candidate, end, [&](const auto& entry) noexcept {
+				return std::ranges::equal(aseprite.getImage(entry.second), canvas);
+			})};
+			std::uint32_t image {aseprite.m_imageCount};
+			if (same != end)
+				image = same->second;
+			else {
+				aseprite.m_pixels.insert(aseprite.m_pixels.end(), canvas.begin(), canvas.end());
+				imagesByHash.emplace(end, hash, aseprite.m_imageCount);
+				++aseprite.m_imageCount;
+			}
+			aseprite.m_frames.push_back({.image = image, .duration = duration});
+		}
+		return aseprite;
+	}
+
+	auto Aseprite::getSpriteName(const vx::StringSlice& prefix, const std::uint32_t image) noexcept -> vx::String {
+		std::array<char, 11uz> digits {};
+		digits[0] = '_';
+		const auto result {std::to_chars(digits.data() + 1, digits.data() + digits.size(), image)};
+		const std::size_t digitCount {static_cast<std::size_t> (result.ptr - digits.data())};
+		vx::String name {vx::String::from(prefix)};
+		const std::size_t prefixSize {name.getSize()};
+		name.resize(prefixSize + digitCount);
+		std::ranges::copy(std::span{digits}.first(digitCount), name.begin() + static_cast<std::ptrdiff_t> (prefixSize));
+		return name;
+	}
+
+	auto Aseprite::addToAtlas(AtlasBuilder& builder, const vx::StringSlice& prefix) const noexcept -> bool {
+		vx::render::Image image {m_width, m_height};
+		for (std::uint32_t i {0u}; i < m_imageCount; ++i) {
+			std::ranges::copy(this->getImage(i), image.getPixels().begin());
+			if (!builder.set(vx::StringSlice::from(Aseprite::getSpriteName(prefix, i)), image))
+				return false;
+		}
+		return true;
+	}
+
+	auto Aseprite::findTag(const vx::StringSlice& name) const noexcept -> const AsepriteTag* {
+		const auto tag {std::ranges::find_if(m_tags, [&name](const AsepriteTag& candidate) noexcept {
+			return std::ranges::equal(candidate.name, name);
+		})};
+		return tag == m_tags.end() ? nullptr : std::to_address(tag);
+	}
+
+	auto Aseprite::getFrameAt(const AsepriteTag& tag, std::uint64_t time) const noexcept -> std::uint32_t {
+		const std::uint32_t count {tag.to - tag.from + 1u};
+		const bool isPingPong {tag.direction == AsepriteDirection::pingPong || tag.direction == AsepriteDirection::pingPongReverse};
+		const bool isReversed {tag.direction == AsepriteDirection::reverse || tag.direction == AsepriteDirection::pingPongReverse};
+		/* a ping-pong cycle doesn't show its ends twice */
+		const std::uint32_t stepCount {isPingPong && count > 1u ? count * 2u - 2u : count};
+		const auto getFrame {[&](const std::uint32_t step) noexcept -> std::uint32_t {
+			const std::uint32_t position {step < count ? step : count * 2u - 2u - step};
+			return isReversed ? tag.to - position : tag.from + position;
+		}};
+
+		std::uint64_t cycleDuration {0u};
+		for (std::uint32_t step {0u}; step < stepCount; ++step)
+			cycleDuration += m_frames[getFrame(step)].duration;
+		if (cycleDuration == 0u)
+			return getFrame(0u);
+		if (tag.repeat != 0u && time / cycleDuration >= tag.repeat)
+			return getFrame(stepCount - 1u);
+		time %= cycleDuration;
+		for (std::uint32_t step {0u}; step < stepCount; ++step) {
+			const std::uint32_t frame {getFrame(step)};
+			if (time < m_frames[frame].duration)
+				return frame;
+			time -= m_frames[frame].duration;
+		}
+		return getFrame(stepCount - 1u);
+	}
+}
@@ -0,0 +1,71 @@
+#include "voxlet/assets/atlas.hpp"
+
+#include <algorithm>
+
+#include "voxlet/assets/binary.hpp"
+#include "voxlet/assets/hash.hpp"
+
+
+namespace vx::assets {
+	auto Atlas::open(const vx::StringSlice& path) noexcept -> std::optional<Atlas> {
+		std::optional<vx::io::MappedFile> file {vx::io::MappedFile::open(path, {.pattern = vx::io::AccessPattern::random})};
+		if (!file)
+			return std::nullopt;
+		std::optional<Atlas> atlas {Atlas::fromBytes(file->getBytes())};
+		if (atlas)
+			atlas->m_file = std::move(*file);
+		return atlas;
+	}
+
+	auto Atlas::fromBytes(const std::span<const std::byte> bytes) noexcept -> std::optional<Atlas> {
+		if (reinterpret_cast<std::uintptr_t> (bytes.data()) % alignof(AtlasEntry) != 0u)
+			return std::nullopt;
+		const auto header {internal::getArray<AtlasHeader> (bytes, 0u, 1u)};
+		if (!header || header->front().magic != ATLAS_MAGIC || header->front().version != ATLAS_VERSION)
+			return std::nullopt;
+		const AtlasHeader& infos {header->front()};
+		const auto pages {internal::getArray<AtlasPage> (bytes, infos.pagesOffset, infos.pageCount)};
+		const auto entries {internal::getArray<AtlasEntry> (bytes, infos.entriesOffset, infos.entryCount)};
+		const auto names {internal::getArray<char8_t> (bytes, infos.namesOffset, infos.namesSize)};
+		if (!pages || !entries || !names)
+			return std::nullopt;
+		for (const AtlasPage& page : *pages) {
+			if (!internal::getArray<std::uint32_t> (bytes, page.pixelsOffset, static_cast<std::uint64_t> (page.width) * page.height))
+				return std::nullopt;
+		}
+
+		Atlas atlas {};
+		atlas.m_bytes = bytes;
+		atlas.m_pages = *pages;
+		atlas.m_entries = *entries;
+		atlas.m_names = *names;
+		return atlas;
+	}
+
+
+	auto Atlas::find(const vx::StringSlice& name) const noexcept -> const AtlasEntry* {
+		const std::uint64_t hash {hashName(name)};
+		auto it {std::ranges::lower_bound(m_entries, hash, {}, &AtlasEntry::hash)};
+		for (; it != m_entries.end() && it->hash == hash; ++it) {
+			if (std::ranges::equal(this->getName(*it), name))
+				return std::to_address(it);
+		}
+		return nullptr;
+	}
+
+	auto Atlas::getName(const AtlasEntry& entry) const noexcept -> vx::StringSlice {
+		if (entry.nameOffset > m_names.size() || entry.nameSize > m_names.size() - entry.nameOffset)
+			return vx::StringSlice{};
+		return vx::StringSlice::from(m_names.data() + entry.nameOffset, entry.nameSize);
+	}
+
+	auto Atlas::getPagePixels(const std::uint32_t page) const noexcept -> std::span<const std::uint32_t> {
+		if (page >= m_pages.size())
+			return {};
+		const AtlasPage& infos {m_pages[page]};
+		return {
+			reinterpret_cast<const std::uint32_t*> (m_bytes.data() + infos.pixelsOffset),
+			static_cast<std::size_t> (infos.width) * infos.height
+		};
+	}
+}
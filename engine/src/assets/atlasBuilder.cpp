@@ -0,0 +1,360 @@
+#include "voxlet/assets/atlasBuilder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "voxlet/assets/binary.hpp"
+#include "voxlet/assets/hash.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::assets {
+	namespace {
+		struct TrimmedImage {
+			vx::render::Image image;
+			std::uint32_t offsetX;
+			std::uint32_t offsetY;
+		};
+
+		/* crops the fully transparent borders, a fully transparent image becomes empty */
+		auto trim(const vx::render::Image& image, const bool enabled) noexcept -> TrimmedImage {
+			std::uint32_t left {0u};
+			std::uint32_t top {0u};
+			std::uint32_t right {image.getWidth()};
+			std::uint32_t bottom {image.getHeight()};
+			if (enabled) {
+				const auto isOpaque {[&image](const std::uint32_t x, const std::uint32_t y) noexcept {
+					return (image.getPixel(x, y) >> 24u) != 0u;
+				}};
+				const auto isRowEmpty {[&](const std::uint32_t y) noexcept {
+					for (std::uint32_t x {left}; x < right; ++x) {
+						if (isOpaque(x, y))
+							return false;
+					}
+					return true;
+				}};
+				const auto isColumnEmpty {[&](const std::uint32_t x) noexcept {
+					for (std::uint32_t y {top}; y < bottom; ++y) {
+						if (isOpaque(x, y))
+							return false;
+					}
+					return true;
+				}};
+				while (top < bottom && isRowEmpty(top))
+					++top;
+				while (bottom > top && isRowEmpty(bottom - 1u))
+					--bottom;
+				while (left < right && isColumnEmpty(left))
+					++left;
+				while (right > left && isColumnEmpty(right - 1u))
+					--right;
+				if (top == bottom || left == right)
+					return TrimmedImage{vx::render::Image{}, 0u, 0u};
+			}
+
+			TrimmedImage trimmed {vx::render::Image{right - left, bottom - top}, left, top};
+			for (std::uint32_t y {top}; y < bottom; ++y)
+				vx::memory::memcpy(trimmed.image.getRow(y - top), image.getRow(y) + left, right - left);
+			return trimmed;
+		}
+
+		auto isSameImage(const vx::render::Image& lhs, const vx::render::Image& rhs) noexcept -> bool {
+			return lhs.getWidth() == rhs.getWidth()
+				&& lhs.getHeight() == rhs.getHeight()
+				&& std::ranges::equal(lhs.getPixels(), rhs.getPixels());
+		}
+	}
+
+
+	AtlasBuilder::AtlasBuilder() noexcept :
+		AtlasBuilder {Config{}}
+	{}
+
+	AtlasBuilder::AtlasBuilder(const Config& config) noexcept :
+		m_config {config},
+		m_sprites {},
+		m_spriteIndices {},
+		m_packers {},
+		m_pageImages {},
+		m_dirtyPages {}
+	{
+		/* entries store page coordinates on 16 bits */
+		assert(m_config.pageWidth != 0u && m_config.pageWidth <= 65536u);
+		assert(m_config.pageHeight != 0u && m_config.pageHeight <= 65536u);
+	}
+
+
+	auto AtlasBuilder::restore(const Atlas& atlas, const Config& config) noexcept -> std::optional<AtlasBuilder> {
+		AtlasBuilder builder {config};
+		for (std::uint32_t page {0u}; page < atlas.getPages().size(); ++page) {
+			if (atlas.getPages()[page].width != config.pageWidth || atlas.getPages()[page].height != config.pageHeight)
+				return std::nullopt;
+			(void)builder.addPage();
+			std::ranges::copy(atlas.getPagePixels(page), builder.m_pageImages[page].getPixels().begin());
+		}
+
+		for (const AtlasEntry& entry : atlas.getEntries()) {
+			if (entry.width != 0u && (entry.page >= builder.m_packers.size()
+				|| entry.x + entry.width > config.pageWidth
+				|| entry.y + entry.height > config.pageHeight
+			)) {
+				return std::nullopt;
+			}
+			Sprite sprite {
+				.name = vx::String::from(atlas.getName(entry)),
+				.hash = entry.hash,
+				.image = vx::render::Image{entry.width, entry.height},
+				.page = entry.page,
+				.rect = PackedRect{0u, 0u, 0u, 0u},
+				.offsetX = entry.offsetX,
+				.offsetY = entry.offsetY,
+				.sourceWidth = entry.sourceWidth,
+				.sourceHeight = entry.sourceHeight
+			};
+			if (entry.width != 0u) {
+				sprite.rect = PackedRect{
+					entry.x,
+					entry.y,
+					std::min(entry.width + config.padding, config.pageWidth - entry.x),
+					std::min(entry.height + config.padding, config.pageHeight - entry.y)
+				};
+				builder.m_packers[entry.page].occupy(sprite.rect);
+				const vx::render::Image& page {builder.m_pageImages[entry.page]};
+				for (std::uint32_t y {0u}; y < entry.height; ++y)
+					vx::memory::memcpy(sprite.image.getRow(y), page.getRow(entry.y + y) + entry.x, entry.width);
+			}
+			builder.m_spriteIndices.emplace(sprite.hash, builder.m_sprites.size());
+			builder.m_sprites.push_back(std::move(sprite));
+		}
+		builder.clearDirtyPages();
+		return builder;
+	}
+
+
+	auto AtlasBuilder::set(const vx::StringSlice& name, const vx::render::Image& image) noexcept -> bool {
+		TrimmedImage trimmed {trim(image, m_config.trim)};
+		assert(image.getWidth() <= 65535u && image.getHeight() <= 65535u);
+		if (trimmed.image.getWidth() + m_config.padding > m_config.pageWidth
+			|| trimmed.image.getHeight() + m_config.padding > m_config.pageHeight
+		) {
+			return false;
+		}
+
+		const std::uint64_t hash {hashName(name)};
+		const auto it {m_spriteIndices.find(hash)};
+		if (it == m_spriteIndices.end()) {
+			m_spriteIndices.emplace(hash, m_sprites.size());
+			m_sprites.push_back(Sprite{
+				.name = vx::String::from(name),
+				.hash = hash,
+				.image = std::move(trimmed.image),
+				.page = 0u,
+				.rect = PackedRect{0u, 0u, 0u, 0u},
+				.offsetX = trimmed.offsetX,
+				.offsetY = trimmed.offsetY,
+				.sourceWidth = image.getWidth(),
+				.sourceHeight = image.getHeight()
+			});
+			this->place(m_sprites.back());
+			return true;
+		}
+
+		/* another name with the same hash, which the atlas couldn't tell apart */
+		Sprite& sprite {m_sprites[it->second]};
+		if (!std::ranges::equal(sprite.name.slice(), name))
+			return false;
+		if (isSameImage(sprite.image, trimmed.image)
+			&& sprite.offsetX == trimmed.offsetX
+			&& sprite.offsetY == trimmed.offsetY
+			&& sprite.sourceWidth == image.getWidth()
+			&& sprite.sourceHeight == image.getHeight()
+		) {
+			return true;
+		}
+
+		this->erase(sprite);
+		const bool fits {trimmed.image.getWidth() + m_config.padding <= sprite.rect.width
+			&& trimmed.image.getHeight() + m_config.padding <= sprite.rect.height
+		};
+		sprite.image = std::move(trimmed.image);
+		sprite.offsetX = trimmed.offsetX;
+		sprite.offsetY = trimmed.offsetY;
+		sprite.sourceWidth = image.getWidth();
+		sprite.sourceHeight = image.getHeight();
+		if (fits) {
+			this->draw(sprite);
+			return true;
+		}
+		if (sprite.rect.width != 0u)
+			m_packers[sprite.page].release(sprite.rect);
+		this->place(sprite);
+		return true;
+	}
+
+	auto AtlasBuilder::remove(const vx::StringSlice& name) noexcept -> bool {
+		const auto it {m_spriteIndices.find(hashName(name))};
+		if (it == m_spriteIndices.end())
+			return false;
+		const std::size_t index {it->second};
+		Sprite& sprite {m_sprites[index]};
+		if (!std::ranges::equal(sprite.name.slice(), name))
+			return false;
+		this->erase(sprite);
+		if (sprite.rect.width != 0u)
+			m_packers[sprite.page].release(sprite.rect);
+		m_spriteIndices.erase(it);
+		if (index != m_sprites.size() - 1uz) {
+			sprite = std::move(m_sprites.back());
+			m_spriteIndices[sprite.hash] = index;
+		}
+		m_sprites.pop_back();
+		return true;
+	}
+
+	auto AtlasBuilder::repack() noexcept -> void {
+		m_packers.clear();
+		m_pageImages.clear();
+		m_dirtyPages.clear();
+
+		std::vector<std::size_t> order (m_sprites.size());
+		std::iota(order.begin(), order.end(), 0uz);
+		std::ranges::stable_sort(order, [this](const std::size_t lhs, const std::size_t rhs) noexcept {
+			const vx::render::Image& left {m_sprites[lhs].image};
+			const vx::render::Image& right {m_sprites[rhs].image};
+			const std::uint32_t leftSide {std::max(left.getWidth(), left.getHeight())};
+			const std::uint32_t rightSide {std::max(right.getWidth(), right.getHeight())};
+			if (leftSide != rightSide)
+				return leftSide > rightSide;
+			return left.getWidth() * left.getHeight() > right.getWidth() * right.getHeight();
+		});
+		for (const std::size_t index : order)
+			this->place(m_sprites[index]);
+	}
+
+
+	auto AtlasBuilder::write() const noexcept -> std::vector<std::byte> {
+		/* entries and names go in hash order, so the file only depends on the sprites and where they are */
+		std::vector<const Sprite*> sprites {};
+		sprites.reserve(m_sprites.size());
+		for (const Sprite& sprite : m_sprites)
+			sprites.push_back(&sprite);
+		std::ranges::sort(sprites, {}, &Sprite::hash);
+
+		std::vector<AtlasEntry> entries {};
+		entries.reserve(sprites.size());
+		std::uint32_t namesSize {0u};
+		for (const Sprite* const sprite : sprites) {
+			const auto pageWidth {static_cast<float> (m_config.pageWidth)};
+			const auto pageHeight {static_cast<float> (m_config.pageHeight)};
+			const vx::render::Image& image {sprite->image};
+			entries.push_back(AtlasEntry{
+				.hash = sprite->hash,
+				.nameOffset = namesSize,
+				.nameSize = static_cast<std::uint32_t> (sprite->name.getSize()),
+				.page = sprite->page,
+				.reserved = 0u,
+				.x = static_cast<std::uint16_t> (sprite->rect.x),
+				.y = static_cast<std::uint16_t> (sprite->rect.y),
+				.width = static_cast<std::uint16_t> (image.getWidth()),
+				.height = static_cast<std::uint16_t> (image.getHeight()),
+				.offsetX = static_cast<std::uint16_t> (sprite->offsetX),
+				.offsetY = static_cast<std::uint16_t> (sprite->offsetY),
+				.sourceWidth = static_cast<std::uint16_t> (sprite->sourceWidth),
+				.sourceHeight = static_cast<std::uint16_t> (sprite->sourceHeight),
+				.uv = {
+					static_cast<float> (sprite->rect.x) / pageWidth,
+					static_cast<float> (sprite->rect.y) / pageHeight,
+					static_cast<float> (sprite->rect.x + image.getWidth()) / pageWidth,
+					static_cast<float> (sprite->rect.y + image.getHeight()) / pageHeight
+				}
+			});
+			namesSize += static_cast<std::uint32_t> (sprite->name.getSize());
+		}
+
+		AtlasHeader header {
+			.magic = ATLAS_MAGIC,
+			.version = ATLAS_VERSION,
+			.pageCount = static_cast<std::uint32_t> (m_pageImages.size()),
+			.entryCount = static_cast<std::uint32_t> (entries.size()),
+			.pagesOffset = sizeof(AtlasHeader),
+			.entriesOffset = 0u,
+			.namesOffset = 0u,
+			.namesSize = namesSize
+		};
+		header.entriesOffset = vx::memory::alignUp(header.pagesOffset + m_pageImages.size() * sizeof(AtlasPage), alignof(AtlasEntry));
+		header.namesOffset = header.entriesOffset + entries.size() * sizeof(AtlasEntry);
+
+		std::vector<AtlasPage> pages {};
+		std::size_t size {static_cast<std::size_t> (header.namesOffset + namesSize)};
+		for (const vx::render::Image& image : m_pageImages) {
+			size = vx::memory::alignUp(size, ATLAS_PAGE_ALIGNMENT);
+			pages.push_back(AtlasPage{image.getWidth(), image.getHeight(), size});
+			size += image.getPixels().size_bytes();
+		}
+
+		std::vector<std::byte> bytes (size, std::byte{0});
+		internal::writeBytes(bytes, 0u, &header, sizeof(header));
+		internal::writeBytes(bytes, header.pagesOffset, pages.data(), pages.size() * sizeof(AtlasPage));
+		internal::writeBytes(bytes, header.entriesOffset, entries.data(), entries.size() * sizeof(AtlasEntry));
+		for (std::size_t i {0uz}; i < entries.size(); ++i) {
+			const vx::StringSlice name {sprites[i]->name.slice()};
+			internal::writeBytes(bytes, header.namesOffset + entries[i].nameOffset, std::to_address(name.begin()), entries[i].nameSize);
+		}
+		for (std::size_t page {0uz}; page < pages.size(); ++page)
+			internal::writeBytes(bytes, pages[page].pixelsOffset, m_pageImages[page].getPixels().data(), m_pageImages[page].getPixels().size_bytes());
+		return bytes;
+	}
+
+
+	auto AtlasBuilder::clearDirtyPages() noexcept -> void {
+		std::fill(m_dirtyPages.begin(), m_dirtyPages.end(), false);
+	}
+
+
+	auto AtlasBuilder::place(Sprite& sprite) noexcept -> void {
+		sprite.page = 0u;
+		sprite.rect = PackedRect{0u, 0u, 0u, 0u};
+		if (sprite.image.getWidth() == 0u)
+			return;
+		const std::uint32_t width {sprite.image.getWidth() + m_config.padding};
+		const std::uint32_t height {sprite.image.getHeight() + m_config.padding};
+		std::optional<PackedRect> rect {};
+		std::uint32_t page {0u};
+		for (; page < m_packers.size() && !rect; ++page)
+			rect = m_packers[page].insert(width, height);
+		if (rect)
+			--page;
+		else {
+			page = this->addPage();
+			rect = m_packers[page].insert(width, height);
+			assert(rect);
+		}
+		sprite.page = page;
+		sprite.rect = *rect;
+		this->draw(sprite);
+	}
+
+	auto AtlasBuilder::draw(const Sprite& sprite) noexcept -> void {
+		vx::render::Image& page {m_pageImages[sprite.page]};
+		for (std::uint32_t y {0u}; y < sprite.image.getHeight(); ++y)
+			vx::memory::memcpy(page.getRow(sprite.rect.y + y) + sprite.rect.x, sprite.image.getRow(y), sprite.image.getWidth());
+		m_dirtyPages[sprite.page] = true;
+	}
+
+	auto AtlasBuilder::erase(const Sprite& sprite) noexcept -> void {
+		if (sprite.rect.width == 0u)
+			return;
+		vx::render::Image& page {m_pageImages[sprite.page]};
+		for (std::uint32_t y {0u}; y < sprite.image.getHeight(); ++y)
+			vx::memory::memclear(page.getRow(sprite.rect.y + y) + sprite.rect.x, sprite.image.getWidth());
+		m_dirtyPages[sprite.page] = true;
+	}
+
+	auto AtlasBuilder::addPage() noexcept -> std::uint32_t {
+		m_packers.emplace_back(m_config.pageWidth, m_config.pageHeight);
+		m_pageImages.emplace_back(m_config.pageWidth, m_config.pageHeight, 0u);
+		m_dirtyPages.push_back(true);
+		return static_cast<std::uint32_t> (m_packers.size() - 1uz);
+	}
+}
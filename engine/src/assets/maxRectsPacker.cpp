@@ -0,0 +1,169 @@
+#include "voxlet/assets/maxRectsPacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+
+namespace vx::assets {
+	namespace {
+		auto overlaps(const PackedRect& lhs, const PackedRect& rhs) noexcept -> bool {
+			return lhs.x < rhs.x + rhs.width && rhs.x < lhs.x + lhs.width
+				&& lhs.y < rhs.y + rhs.height && rhs.y < lhs.y + lhs.height;
+		}
+
+		auto contains(const PackedRect& outer, const PackedRect& inner) noexcept -> bool {
+			return inner.x >= outer.x && inner.y >= outer.y
+				&& inner.x + inner.width <= outer.x + outer.width
+				&& inner.y + inner.height <= outer.y + outer.height;
+		}
+
+		/*
+		 * Two free rectangles that touch or overlap along x are both free over the rows they share, so the
+		 * span of both over these rows is free too. Empty when they share no row.
+		 */
+		auto joinX(const PackedRect& lhs, const PackedRect& rhs) noexcept -> PackedRect {
+			if (lhs.x > rhs.x + rhs.width || rhs.x > lhs.x + lhs.width)
+				return PackedRect{0u, 0u, 0u, 0u};
+			const std::uint32_t x {std::min(lhs.x, rhs.x)};
+			const std::uint32_t y {std::max(lhs.y, rhs.y)};
+			const std::uint32_t right {std::max(lhs.x + lhs.width, rhs.x + rhs.width)};
+			const std::uint32_t bottom {std::min(lhs.y + lhs.height, rhs.y + rhs.height)};
+			if (bottom <= y)
+				return PackedRect{0u, 0u, 0u, 0u};
+			return PackedRect{x, y, right - x, bottom - y};
+		}
+
+		auto transpose(const PackedRect& rect) noexcept -> PackedRect {
+			return PackedRect{rect.y, rect.x, rect.height, rect.width};
+		}
+	}
+
+
+	MaxRectsPacker::MaxRectsPacker(const std::uint32_t width, const std::uint32_t height) noexcept :
+		m_width {width},
+		m_height {height},
+		m_usedArea {0u},
+		m_freeRects {}
+	{
+		this->clear();
+	}
+
+
+	auto MaxRectsPacker::insert(const std::uint32_t width, const std::uint32_t height) noexcept -> std::optional<PackedRect> {
+		if (width == 0u || height == 0u)
+			return std::nullopt;
+
+		/* best short side fit, ties broken by the long side */
+		const PackedRect* best {nullptr};
+		std::uint32_t bestShortSide {std::numeric_limits<std::uint32_t>::max()};
+		std::uint32_t bestLongSide {std::numeric_limits<std::uint32_t>::max()};
+		for (const PackedRect& free : m_freeRects) {
+			if (free.width < width || free.height < height)
+				continue;
+			const std::uint32_t leftoverX {free.width - width};
+			const std::uint32_t leftoverY {free.height - height};
+			const std::uint32_t shortSide {std::min(leftoverX, leftoverY)};
+			const std::uint32_t longSide {std::max(leftoverX, leftoverY)};
+			if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+				best = &free;
+				bestShortSide = shortSide;
+				bestLongSide = longSide;
+			}
+		}
+		if (best == nullptr)
+			return std::nullopt;
+
+		const PackedRect rect {best->x, best->y, width, height};
+		this->occupy(rect);
+		return rect;
+	}
+
+	auto MaxRectsPacker::occupy(const PackedRect& rect) noexcept -> void {
+		m_usedArea += static_cast<std::uint64_t> (rect.width) * rect.height;
+		this->split(rect);
+		this->prune();
+	}
+
+	auto MaxRectsPacker::release(const PackedRect& rect) noexcept -> void {
+		m_usedArea -= static_cast<std::uint64_t> (rect.width) * rect.height;
+		this->merge(rect);
+		this->prune();
+	}
+
+	auto MaxRectsPacker::clear() noexcept -> void {
+		m_usedArea = 0u;
+		m_freeRects.clear();
+		if (m_width != 0u && m_height != 0u)
+			m_freeRects.push_back(PackedRect{0u, 0u, m_width, m_height});
+	}
+
+
+	auto MaxRectsPacker::split(const PackedRect& used) noexcept -> void {
+		/* the rectangles appended by the loop don't overlap `used` */
+		const std::size_t count {m_freeRects.size()};
+		for (std::size_t i {0uz}; i < count; ++i) {
+			const PackedRect free {m_freeRects[i]};
+			if (!overlaps(free, used))
+				continue;
+			if (used.x > free.x)
+				m_freeRects.push_back(PackedRect{free.x, free.y, used.x - free.x, free.height});
+			if (used.x + used.width < free.x + free.width) {
+				const std::uint32_t x {used.x + used.width};
+				m_freeRects.push_back(PackedRect{x, free.y, free.x + free.width - x, free.height});
+			}
+			if (used.y > free.y)
+				m_freeRects.push_back(PackedRect{free.x, free.y, free.width, used.y - free.y});
+			if (used.y + used.height < free.y + free.height) {
+				const std::uint32_t y {used.y + used.height};
+				m_freeRects.push_back(PackedRect{free.x, y, free.width, free.y + free.height - y});
+			}
+			m_freeRects[i].width = 0u;
+		}
+		std::erase_if(m_freeRects, [](const PackedRect& rect) noexcept {return rect.width == 0u;});
+	}
+
+	auto MaxRectsPacker::merge(const PackedRect& released) noexcept -> void {
+		/* the free rectangles before `released` are already maximal, a new one has to cover some of it */
+		const auto add {[this](const PackedRect& rect) noexcept -> bool {
+			if (rect.width == 0u)
+				return false;
+			for (const PackedRect& free : m_freeRects) {
+				if (contains(free, rect))
+					return false;
+			}
+			m_freeRects.push_back(rect);
+			return true;
+		}};
+
+		std::vector<PackedRect> pending {};
+		if (add(released))
+			pending.push_back(released);
+		while (!pending.empty()) {
+			const PackedRect rect {pending.back()};
+			pending.pop_back();
+			for (std::size_t i {0uz}; i < m_freeRects.size(); ++i) {
+				const PackedRect free {m_freeRects[i]};
+				for (const PackedRect& joined : {joinX(rect, free), transpose(joinX(transpose(rect), transpose(free)))}) {
+					if (add(joined))
+						pending.push_back(joined);
+				}
+			}
+		}
+	}
+
+	auto MaxRectsPacker::prune() noexcept -> void {
+		for (std::size_t i {0uz}; i < m_freeRects.size(); ++i) {
+			for (std::size_t j {i + 1uz}; j < m_freeRects.size(); ++j) {
+				if (contains(m_freeRects[j], m_freeRects[i])) {
+					m_freeRects.erase(m_freeRects.begin() + static_cast<std::ptrdiff_t> (i));
+					--i;
+					break;
+				}
+				if (contains(m_freeRects[i], m_freeRects[j])) {
+					m_freeRects.erase(m_freeRects.begin() + static_cast<std::ptrdiff_t> (j));
+					--j;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#include "voxlet/assets/pack.hpp"
+
+#include <algorithm>
+
+#include "voxlet/assets/binary.hpp"
+#include "voxlet/assets/hash.hpp"
+#include "voxlet/compression/lz.hpp"
+
+
+namespace vx::assets {
+	auto Pack::open(const vx::StringSlice& path) noexcept -> std::optional<Pack> {
+		std::optional<vx::io::MappedFile> file {vx::io::MappedFile::open(path, {.pattern = vx::io::AccessPattern::random})};
+		if (!file)
+			return std::nullopt;
+		std::optional<Pack> pack {Pack::fromBytes(file->getBytes())};
+		if (pack)
+			pack->m_file = std::move(*file);
+		return pack;
+	}
+
+	auto Pack::fromBytes(const std::span<const std::byte> bytes) noexcept -> std::optional<Pack> {
+		if (reinterpret_cast<std::uintptr_t> (bytes.data()) % alignof(PackEntry) != 0u)
+			return std::nullopt;
+		const auto header {internal::getArray<PackHeader> (bytes, 0u, 1u)};
+		if (!header || header->front().magic != PACK_MAGIC || header->front().version != PACK_VERSION)
+			return std::nullopt;
+		const PackHeader& infos {header->front()};
+		const auto entries {internal::getArray<PackEntry> (bytes, infos.entriesOffset, infos.entryCount)};
+		const auto paths {internal::getArray<char8_t> (bytes, infos.pathsOffset, infos.pathsSize)};
+		if (!entries || !paths)
+			return std::nullopt;
+		for (const PackEntry& entry : *entries) {
+			if (!internal::getArray<std::byte> (bytes, entry.offset, entry.size))
+				return std::nullopt;
+			if (entry.compression == PackCompression::none && entry.uncompressedSize != entry.size)
+				return std::nullopt;
+		}
+
+		Pack pack {};
+		pack.m_bytes = bytes;
+		pack.m_entries = *entries;
+		pack.m_paths = *paths;
+		return pack;
+	}
+
+
+	auto Pack::find(const vx::StringSlice& path) const noexcept -> const PackEntry* {
+		const std::uint64_t hash {hashName(path)};
+		auto it {std::ranges::lower_bound(m_entries, hash, {}, &PackEntry::hash)};
+		for (; it != m_entries.end() && it->hash == hash; ++it) {
+			if (std::ranges::equal(this->getPath(*it), path))
+				return std::to_address(it);
+		}
+		return nullptr;
+	}
+
+	auto Pack::getPath(const PackEntry& entry) const noexcept -> vx::StringSlice {
+		if (entry.pathOffset > m_paths.size() || entry.pathSize > m_paths.size() - entry.pathOffset)
+			return vx::StringSlice{};
+		return vx::StringSlice::from(m_paths.data() + entry.pathOffset, entry.pathSize);
+	}
+
+	auto Pack::getBlob(const PackEntry& entry) const noexcept -> std::span<const std::byte> {
+		return m_bytes.subspan(static_cast<std::size_t> (entry.offset), static_cast<std::size_t> (entry.size));
+	}
+
+	auto Pack::read(const PackEntry& entry, const std::span<std::byte> output) const noexcept -> bool {
+		if (output.size() != entry.uncompressedSize)
+			return false;
+		switch (entry.compression) {
+			case PackCompression::none:
+				std::ranges::copy(this->getBlob(entry), output.begin());
+				return true;
+			case PackCompression::lz:
+				return vx::compression::decompress(this->getBlob(entry), output);
+		}
+		return false;
+	}
+
+	auto Pack::prefetch(const PackEntry& entry) const noexcept -> void {
+		m_file.prefetch(static_cast<std::size_t> (entry.offset), static_cast<std::size_t> (entry.size));
+	}
+}
@@ -0,0 +1,96 @@
+#include "voxlet/assets/packBuilder.hpp"
+
+#include <algorithm>
+
+#include "voxlet/assets/binary.hpp"
+#include "voxlet/assets/hash.hpp"
+#include "voxlet/compression/lz.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::assets {
+	auto PackBuilder::add(
+		const vx::StringSlice& path,
+		const std::span<const std::byte> content,
+		const PackCompression compression
+	) noexcept -> bool {
+		const std::uint64_t hash {hashName(path)};
+		if (!m_hashes.insert(hash).second)
+			return false;
+		Blob blob {
+			.path = vx::String::from(path),
+			.hash = hash,
+			.compression = compression,
+			.data = {},
+			.uncompressedSize = content.size()
+		};
+		switch (compression) {
+			case PackCompression::none:
+				blob.data.assign(content.begin(), content.end());
+				break;
+			case PackCompression::lz:
+				blob.data = vx::compression::compress(content);
+				break;
+		}
+		/* what doesn't compress is stored as is, reading it is then free */
+		if (blob.data.size() >= content.size() && compression != PackCompression::none) {
+			blob.compression = PackCompression::none;
+			blob.data.assign(content.begin(), content.end());
+		}
+		m_blobs.push_back(std::move(blob));
+		return true;
+	}
+
+
+	auto PackBuilder::write() const noexcept -> std::vector<std::byte> {
+		/* entries, paths and blobs go in hash order, so the file doesn't depend on the order of `add` */
+		std::vector<const Blob*> blobs {};
+		blobs.reserve(m_blobs.size());
+		for (const Blob& blob : m_blobs)
+			blobs.push_back(&blob);
+		std::ranges::sort(blobs, {}, &Blob::hash);
+
+		std::uint32_t pathsSize {0u};
+		for (const Blob* const blob : blobs)
+			pathsSize += static_cast<std::uint32_t> (blob->path.getSize());
+		PackHeader header {
+			.magic = PACK_MAGIC,
+			.version = PACK_VERSION,
+			.entryCount = static_cast<std::uint32_t> (blobs.size()),
+			.reserved = 0u,
+			.entriesOffset = sizeof(PackHeader),
+			.pathsOffset = sizeof(PackHeader) + blobs.size() * sizeof(PackEntry),
+			.pathsSize = pathsSize
+		};
+
+		std::vector<PackEntry> entries {};
+		entries.reserve(blobs.size());
+		std::uint32_t pathOffset {0u};
+		std::size_t size {static_cast<std::size_t> (header.pathsOffset + pathsSize)};
+		for (const Blob* const blob : blobs) {
+			size = vx::memory::alignUp(size, PACK_BLOB_ALIGNMENT);
+			entries.push_back(PackEntry{
+				.hash = blob->hash,
+				.pathOffset = pathOffset,
+				.pathSize = static_cast<std::uint32_t> (blob->path.getSize()),
+				.compression = blob->compression,
+				.reserved = 0u,
+				.offset = size,
+				.size = blob->data.size(),
+				.uncompressedSize = blob->uncompressedSize
+			});
+			pathOffset += static_cast<std::uint32_t> (blob->path.getSize());
+			size += blob->data.size();
+		}
+
+		std::vector<std::byte> bytes (size, std::byte{0});
+		internal::writeBytes(bytes, 0u, &header, sizeof(header));
+		internal::writeBytes(bytes, header.entriesOffset, entries.data(), entries.size() * sizeof(PackEntry));
+		for (std::size_t i {0uz}; i < entries.size(); ++i) {
+			const vx::StringSlice path {blobs[i]->path.slice()};
+			internal::writeBytes(bytes, header.pathsOffset + entries[i].pathOffset, std::to_address(path.begin()), entries[i].pathSize);
+			internal::writeBytes(bytes, entries[i].offset, blobs[i]->data.data(), blobs[i]->data.size());
+		}
+		return bytes;
+	}
+}
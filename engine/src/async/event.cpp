@@ -0,0 +1,62 @@
+#include "voxlet/async/event.hpp"
+
+#include "voxlet/async/executor.hpp"
+
+
+namespace vx::async {
+	auto Event::Awaiter::await_suspend(const std::coroutine_handle<> handle) noexcept -> bool {
+		m_handle = handle;
+		const void* const setState {m_event};
+		void* oldState {m_event->m_state.load(std::memory_order::acquire)};
+		do {
+			if (oldState == setState)
+				return false;
+			m_next = static_cast<Awaiter*> (oldState);
+		} while (!m_event->m_state.compare_exchange_weak(oldState, this,
+			std::memory_order::release,
+			std::memory_order::acquire
+		));
+		return true;
+	}
+
+
+	Event::Event(const bool isSet) noexcept :
+		m_state {isSet ? static_cast<void*> (this) : nullptr}
+	{}
+
+
+	auto Event::set() noexcept -> void {
+		Awaiter* waiter {this->takeWaiters()};
+		while (waiter != nullptr) {
+			Awaiter* const next {waiter->m_next};
+			waiter->m_handle.resume();
+			waiter = next;
+		}
+	}
+
+	auto Event::set(vx::jobs::Scheduler& scheduler) noexcept -> void {
+		Awaiter* waiter {this->takeWaiters()};
+		while (waiter != nullptr) {
+			Awaiter* const next {waiter->m_next};
+			scheduler.submit(internal::makeResumeJob(waiter->m_handle));
+			waiter = next;
+		}
+	}
+
+	auto Event::reset() noexcept -> void {
+		void* oldState {this};
+		(void)m_state.compare_exchange_strong(oldState, nullptr, std::memory_order::acquire);
+	}
+
+	auto Event::isSet() const noexcept -> bool {
+		return m_state.load(std::memory_order::acquire) == static_cast<const void*> (this);
+	}
+
+
+	auto Event::takeWaiters() noexcept -> Awaiter* {
+		void* const oldState {m_state.exchange(this, std::memory_order::acq_rel)};
+		if (oldState == static_cast<void*> (this))
+			return nullptr;
+		return static_cast<Awaiter*> (oldState);
+	}
+}
@@ -0,0 +1,56 @@
+#include "voxlet/async/frameClock.hpp"
+
+#include "voxlet/async/executor.hpp"
+
+
+namespace vx::async {
+	auto FrameClock::Awaiter::await_suspend(const std::coroutine_handle<> handle) const noexcept -> void {
+		std::scoped_lock _ {m_clock->m_mutex};
+		m_clock->m_waiters.push_back(handle);
+	}
+
+	auto FrameClock::Awaiter::await_resume() const noexcept -> std::uint64_t {
+		return m_clock->getFrameIndex();
+	}
+
+
+	FrameClock::FrameClock() noexcept :
+		m_mutex {},
+		m_waiters {},
+		m_resumed {},
+		m_frameIndex {0u}
+	{}
+
+
+	auto FrameClock::tick() noexcept -> void {
+		this->takeWaiters();
+		for (const std::coroutine_handle<> handle : m_resumed)
+			handle.resume();
+		m_resumed.clear();
+	}
+
+	auto FrameClock::tick(vx::jobs::Scheduler& scheduler) noexcept -> void {
+		this->takeWaiters();
+		for (const std::coroutine_handle<> handle : m_resumed)
+			scheduler.submit(internal::makeResumeJob(handle));
+		m_resumed.clear();
+	}
+
+
+	auto FrameClock::getFrameIndex() const noexcept -> std::uint64_t {
+		return m_frameIndex.load(std::memory_order::acquire);
+	}
+
+	auto FrameClock::getWaiterCount() const noexcept -> std::size_t {
+		std::scoped_lock _ {m_mutex};
+		return m_waiters.size();
+	}
+
+
+	auto FrameClock::takeWaiters() noexcept -> void {
+		std::scoped_lock _ {m_mutex};
+		(void)m_frameIndex.fetch_add(1u, std::memory_order::acq_rel);
+		// coroutines resumed inline and awaiting the next frame again land in the fresh waiter list
+		std::swap(m_waiters, m_resumed);
+	}
+}
@@ -0,0 +1,149 @@
+#include "voxlet/async/framePool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+
+namespace vx::async {
+	namespace {
+		struct FreeBlock {
+			FreeBlock* next;
+		};
+
+		/* the free lists of a thread, handed over to the next thread started once it exits */
+		struct ThreadCache {
+			std::array<FreeBlock*, FramePool::SIZE_CLASS_COUNT> freeLists {};
+			/* blocks freed by other threads, pushed one by one and taken back all at once by the owner */
+			std::array<std::atomic<FreeBlock*>, FramePool::SIZE_CLASS_COUNT> remoteFreeLists {};
+		};
+
+		/* at the start of every slab, which are aligned to their size for a block to find its own */
+		struct alignas(FramePool::BLOCK_GRANULARITY) SlabHeader {
+			ThreadCache* owner;
+		};
+
+		struct Registry {
+			Registry(const Registry&) = delete;
+			auto operator=(const Registry&) -> Registry& = delete;
+
+			Registry() noexcept = default;
+			~Registry() {
+				for (void* const slab : slabs)
+					::operator delete(slab, std::align_val_t{FramePool::SLAB_SIZE});
+			}
+
+			std::mutex mutex {};
+			std::vector<void*> slabs {};
+			std::vector<std::unique_ptr<ThreadCache>> caches {};
+			/* caches of threads that exited */
+			std::vector<ThreadCache*> orphans {};
+		};
+
+		auto getRegistry() noexcept -> Registry& {
+			static Registry registry {};
+			return registry;
+		}
+
+		/* gives the cache of a thread back to the registry when the thread exits */
+		struct CacheOwner {
+			CacheOwner(const CacheOwner&) = delete;
+			auto operator=(const CacheOwner&) -> CacheOwner& = delete;
+
+			CacheOwner() noexcept = default;
+			~CacheOwner() {
+				if (cache == nullptr)
+					return;
+				Registry& registry {getRegistry()};
+				std::scoped_lock _ {registry.mutex};
+				registry.orphans.push_back(cache);
+				/* frames freed later by other thread-locals are sent back like those of another thread */
+				cache = nullptr;
+			}
+
+			ThreadCache* cache {nullptr};
+		};
+
+		thread_local CacheOwner cacheOwner {};
+
+		auto getThreadCache() noexcept -> ThreadCache& {
+			if (cacheOwner.cache != nullptr)
+				return *cacheOwner.cache;
+			Registry& registry {getRegistry()};
+			std::scoped_lock _ {registry.mutex};
+			if (!registry.orphans.empty()) {
+				cacheOwner.cache = registry.orphans.back();
+				registry.orphans.pop_back();
+			}
+			else
+				cacheOwner.cache = registry.caches.emplace_back(std::make_unique<ThreadCache> ()).get();
+			return *cacheOwner.cache;
+		}
+
+		auto refill(ThreadCache& cache, const std::size_t sizeClass) noexcept -> FreeBlock* {
+			void* const slab {::operator new(FramePool::SLAB_SIZE, std::align_val_t{FramePool::SLAB_SIZE})};
+			{
+				Registry& registry {getRegistry()};
+				std::scoped_lock _ {registry.mutex};
+				registry.slabs.push_back(slab);
+			}
+			new (slab) SlabHeader{&cache};
+
+			const std::size_t blockSize {(sizeClass + 1uz) * FramePool::BLOCK_GRANULARITY};
+			const std::size_t blockCount {(FramePool::SLAB_SIZE - sizeof(SlabHeader)) / blockSize};
+			auto* const bytes {static_cast<std::byte*> (slab) + sizeof(SlabHeader)};
+			FreeBlock* head {nullptr};
+			for (std::size_t i {blockCount}; i != 0uz; --i)
+				head = new (bytes + (i - 1uz) * blockSize) FreeBlock{head};
+			return head;
+		}
+	}
+
+
+	auto FramePool::allocate(const std::size_t size) noexcept -> void* {
+		if (size > MAX_BLOCK_SIZE)
+			return ::operator new(size);
+		const std::size_t sizeClass {getSizeClass(std::max(size, 1uz))};
+		ThreadCache& cache {getThreadCache()};
+		FreeBlock*& head {cache.freeLists[sizeClass]};
+		if (head == nullptr)
+			head = cache.remoteFreeLists[sizeClass].exchange(nullptr, std::memory_order::acquire);
+		if (head == nullptr)
+			head = refill(cache, sizeClass);
+		FreeBlock* const block {head};
+		head = block->next;
+		return block;
+	}
+
+	auto FramePool::deallocate(void* const ptr, const std::size_t size) noexcept -> void {
+		if (ptr == nullptr)
+			return;
+		if (size > MAX_BLOCK_SIZE) {
+			::operator delete(ptr);
+			return;
+		}
+		/* blocks go back to the thread owning their slab, for memory to be reused by the threads allocating it */
+		const std::size_t sizeClass {getSizeClass(std::max(size, 1uz))};
+		const auto* const slab {reinterpret_cast<const SlabHeader*> (reinterpret_cast<std::uintptr_t> (ptr) & ~(SLAB_SIZE - 1uz))};
+		ThreadCache* const owner {slab->owner};
+		if (owner == cacheOwner.cache) {
+			FreeBlock*& head {owner->freeLists[sizeClass]};
+			head = new (ptr) FreeBlock{head};
+			return;
+		}
+		std::atomic<FreeBlock*>& remoteHead {owner->remoteFreeLists[sizeClass]};
+		auto* const block {new (ptr) FreeBlock{remoteHead.load(std::memory_order::relaxed)}};
+		while (!remoteHead.compare_exchange_weak(block->next, block, std::memory_order::release, std::memory_order::relaxed)) {}
+	}
+
+	auto FramePool::getSlabCount() noexcept -> std::size_t {
+		Registry& registry {getRegistry()};
+		std::scoped_lock _ {registry.mutex};
+		return registry.slabs.size();
+	}
+}
@@ -0,0 +1,496 @@
+#include "voxlet/compression/deflate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <queue>
+
+#include <immintrin.h>
+
+
+namespace vx::compression {
+	namespace {
+		constexpr std::uint32_t ADLER_MODULO {65521u};
+		/* the most 32-byte strides before the sums of a lane could overflow 32 bits */
+		constexpr std::size_t ADLER_MAX_STRIDES {5552uz / 32uz};
+		/* reflected, as gzip and PNG use it */
+		constexpr std::uint32_t CRC_POLYNOMIAL {0xedb8'8320u};
+
+		/*
+		 * Slicing by 8: `CRC_TABLES[k][byte]` is the CRC of the byte followed by `k` zero bytes, so that 8 bytes
+		 * fold with 8 independent lookups instead of a chain of 8.
+		 */
+		constexpr auto CRC_TABLES {[] {
+			std::array<std::array<std::uint32_t, 256uz>, 8uz> tables {};
+			for (std::uint32_t byte {0u}; byte < 256u; ++byte) {
+				std::uint32_t crc {byte};
+				for (std::uint32_t bit {0u}; bit < 8u; ++bit)
+					crc = (crc >> 1u) ^ (CRC_POLYNOMIAL & (0u - (crc & 1u)));
+				tables[0][byte] = crc;
+			}
+			for (std::size_t k {1uz}; k < tables.size(); ++k) {
+				for (std::size_t byte {0uz}; byte < 256uz; ++byte)
+					tables[k][byte] = (tables[k - 1uz][byte] >> 8u) ^ tables[0][tables[k - 1uz][byte] & 0xffu];
+			}
+			return tables;
+		}()};
+
+		constexpr std::size_t BLOCK_SIZE {64uz * 1024uz};
+		constexpr std::size_t MAX_STORED_SIZE {65535uz};
+		constexpr std::size_t MIN_MATCH {4uz};
+		constexpr std::size_t MAX_MATCH {258uz};
+		constexpr std::size_t MAX_DISTANCE {32uz * 1024uz};
+		constexpr std::uint32_t HASH_BITS {15u};
+		constexpr std::uint32_t MAX_CODE_LENGTH {15u};
+		constexpr std::uint32_t MAX_CODE_LENGTH_CODE_LENGTH {7u};
+		constexpr std::uint32_t END_OF_BLOCK {256u};
+
+		constexpr std::array<std::uint16_t, 29uz> LENGTH_BASES {
+			3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 11u, 13u, 15u, 17u, 19u, 23u, 27u, 31u,
+			35u, 43u, 51u, 59u, 67u, 83u, 99u, 115u, 131u, 163u, 195u, 227u, 258u
+		};
+		constexpr std::array<std::uint8_t, 29uz> LENGTH_EXTRA_BITS {
+			0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u, 1u, 1u, 1u, 2u, 2u, 2u, 2u,
+			3u, 3u, 3u, 3u, 4u, 4u, 4u, 4u, 5u, 5u, 5u, 5u, 0u
+		};
+		constexpr std::array<std::uint16_t, 30uz> DISTANCE_BASES {
+			1u, 2u, 3u, 4u, 5u, 7u, 9u, 13u, 17u, 25u, 33u, 49u, 65u, 97u, 129u, 193u,
+			257u, 385u, 513u, 769u, 1025u, 1537u, 2049u, 3073u, 4097u, 6145u, 8193u, 12289u, 16385u, 24577u
+		};
+		constexpr std::array<std::uint8_t, 30uz> DISTANCE_EXTRA_BITS {
+			0u, 0u, 0u, 0u, 1u, 1u, 2u, 2u, 3u, 3u, 4u, 4u, 5u, 5u, 6u, 6u,
+			7u, 7u, 8u, 8u, 9u, 9u, 10u, 10u, 11u, 11u, 12u, 12u, 13u, 13u
+		};
+		constexpr std::array<std::uint8_t, 19uz> CODE_LENGTH_ORDER {
+			16u, 17u, 18u, 0u, 8u, 7u, 9u, 6u, 10u, 5u, 11u, 4u, 12u, 3u, 13u, 2u, 14u, 1u, 15u
+		};
+
+		auto sumLanes(const __m256i lanes) noexcept -> std::uint64_t {
+			alignas(32) std::array<std::uint32_t, 8uz> values;
+			_mm256_store_si256(reinterpret_cast<__m256i*> (values.data()), lanes);
+			std::uint64_t sum {0u};
+			for (const std::uint32_t value : values)
+				sum += value;
+			return sum;
+		}
+
+
+		[[gnu::always_inline]]
+		inline auto read32(const std::byte* const data) noexcept -> std::uint32_t {
+			std::uint32_t value;
+			(void)std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		[[gnu::always_inline]]
+		inline auto read64(const std::byte* const data) noexcept -> std::uint64_t {
+			std::uint64_t value;
+			(void)std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		[[gnu::always_inline]]
+		inline auto hash(const std::uint32_t sequence) noexcept -> std::uint32_t {
+			return (sequence * 2654435761u) >> (32u - HASH_BITS);
+		}
+
+		/* the length of the common prefix of `lhs` and `rhs`, reading up to `end` from `lhs` */
+		[[gnu::always_inline]]
+		inline auto countCommon(const std::byte* lhs, const std::byte* rhs, const std::byte* const end) noexcept
+			-> std::size_t
+		{
+			const std::byte* const start {lhs};
+			while (end - lhs >= 8) {
+				const std::uint64_t difference {read64(lhs) ^ read64(rhs)};
+				if (difference != 0u)
+					return static_cast<std::size_t> (lhs - start) + static_cast<std::size_t> (std::countr_zero(difference) / 8);
+				lhs += 8;
+				rhs += 8;
+			}
+			while (lhs < end && *lhs == *rhs) {
+				++lhs;
+				++rhs;
+			}
+			return static_cast<std::size_t> (lhs - start);
+		}
+
+		/* a literal when `length` is zero, a match of `length` bytes `value` bytes back otherwise */
+		struct Token {
+			std::uint16_t length;
+			std::uint16_t value;
+		};
+
+		/* a code-length symbol, with the repeat count of the runs 16 to 18 */
+		struct CodeLengthToken {
+			std::uint8_t symbol;
+			std::uint8_t extra;
+		};
+
+		auto getLengthSymbol(const std::size_t length) noexcept -> std::uint32_t {
+			const auto base {std::ranges::upper_bound(LENGTH_BASES, length) - 1};
+			return 257u + static_cast<std::uint32_t> (base - LENGTH_BASES.begin());
+		}
+
+		auto getDistanceSymbol(const std::size_t distance) noexcept -> std::uint32_t {
+			const auto base {std::ranges::upper_bound(DISTANCE_BASES, distance) - 1};
+			return static_cast<std::uint32_t> (base - DISTANCE_BASES.begin());
+		}
+
+		struct BitWriter {
+			std::vector<std::byte> bytes;
+			std::uint64_t buffer;
+			std::uint32_t count;
+
+			auto write(const std::uint32_t bits, const std::uint32_t bitCount) -> void {
+				buffer |= static_cast<std::uint64_t> (bits) << count;
+				count += bitCount;
+				for (; count >= 8u; count -= 8u) {
+					bytes.push_back(static_cast<std::byte> (buffer));
+					buffer >>= 8u;
+				}
+			}
+
+			/* pads the last byte with zeros */
+			auto align() -> void {
+				if (count != 0u)
+					write(0u, 8u - count);
+			}
+		};
+
+		/*
+		 * Huffman code lengths of at most `maxLength` bits for `frequencies`. Frequencies are halved until
+		 * the tree is shallow enough, which flattens the rare symbols first, down to a balanced tree.
+		 */
+		auto makeCodeLengths(const std::span<const std::uint32_t> frequencies, const std::uint32_t maxLength)
+			-> std::vector<std::uint8_t>
+		{
+			using Node = std::pair<std::uint64_t, std::uint32_t>;
+			std::vector<std::uint8_t> lengths (frequencies.size(), 0u);
+			std::vector<std::uint32_t> weights {frequencies.begin(), frequencies.end()};
+			std::vector<std::uint32_t> parents (frequencies.size() * 2uz);
+			std::vector<std::uint8_t> depths (frequencies.size() * 2uz);
+			while (true) {
+				std::priority_queue<Node, std::vector<Node>, std::greater<>> queue {};
+				for (std::uint32_t symbol {0u}; symbol < weights.size(); ++symbol) {
+					if (weights[symbol] != 0u)
+						queue.push({weights[symbol], symbol});
+				}
+				if (queue.empty())
+					return lengths;
+				if (queue.size() == 1uz) {
+					lengths[queue.top().second] = 1u;
+					return lengths;
+				}
+
+				/* parents are always created after their children, so depths are known from the root down */
+				auto nodeCount {static_cast<std::uint32_t> (weights.size())};
+				while (queue.size() > 1uz) {
+					const Node first {queue.top()};
+					queue.pop();
+					const Node second {queue.top()};
+					queue.pop();
+					parents[first.second] = nodeCount;
+					parents[second.second] = nodeCount;
+					queue.push({first.first + second.first, nodeCount++});
+				}
+				depths[nodeCount - 1u] = 0u;
+				std::uint32_t maxDepth {0u};
+				for (std::uint32_t node {nodeCount - 1u}; node-- != 0u;) {
+					if (node < weights.size() && weights[node] == 0u)
+						continue;
+					depths[node] = static_cast<std::uint8_t> (depths[parents[node]] + 1u);
+					maxDepth = std::max<std::uint32_t> (maxDepth, depths[node]);
+				}
+				if (maxDepth <= maxLength) {
+					for (std::size_t symbol {0uz}; symbol < weights.size(); ++symbol)
+						lengths[symbol] = weights[symbol] != 0u ? depths[symbol] : 0u;
+					return lengths;
+				}
+				for (std::uint32_t& weight : weights)
+					weight = weight != 0u ? (weight + 1u) / 2u : 0u;
+			}
+		}
+
+		/* the canonical codes of `lengths`, bit reversed as the stream holds them */
+		auto makeCodes(const std::span<const std::uint8_t> lengths) -> std::vector<std::uint16_t> {
+			std::array<std::uint32_t, MAX_CODE_LENGTH + 1u> counts {};
+			for (const std::uint8_t length : lengths)
+				++counts[length];
+			counts[0] = 0u;
+			std::array<std::uint32_t, MAX_CODE_LENGTH + 1u> nextCodes {};
+			std::uint32_t code {0u};
+			for (std::uint32_t length {1u}; length <= MAX_CODE_LENGTH; ++length) {
+				code = (code + counts[length - 1u]) << 1u;
+				nextCodes[length] = code;
+			}
+
+			std::vector<std::uint16_t> codes (lengths.size(), 0u);
+			for (std::size_t symbol {0uz}; symbol < lengths.size(); ++symbol) {
+				const std::uint32_t length {lengths[symbol]};
+				if (length == 0u)
+					continue;
+				std::uint32_t value {nextCodes[length]++};
+				std::uint32_t reversed {0u};
+				for (std::uint32_t i {0u}; i < length; ++i) {
+					reversed = (reversed << 1u) | (value & 1u);
+					value >>= 1u;
+				}
+				codes[symbol] = static_cast<std::uint16_t> (reversed);
+			}
+			return codes;
+		}
+
+		/* the runs of lengths as code-length symbols: 16 repeats the previous length, 17 and 18 repeat zeros */
+		auto encodeLengthRuns(const std::span<const std::uint8_t> lengths) -> std::vector<CodeLengthToken> {
+			std::vector<CodeLengthToken> tokens {};
+			for (std::size_t i {0uz}; i < lengths.size();) {
+				const std::uint8_t length {lengths[i]};
+				std::size_t run {1uz};
+				while (i + run < lengths.size() && lengths[i + run] == length)
+					++run;
+				i += run;
+
+				if (length == 0u) {
+					for (; run >= 11uz; run -= std::min(run, 138uz))
+						tokens.push_back({18u, static_cast<std::uint8_t> (std::min(run, 138uz) - 11uz)});
+					if (run >= 3uz) {
+						tokens.push_back({17u, static_cast<std::uint8_t> (run - 3uz)});
+						run = 0uz;
+					}
+				}
+				else {
+					tokens.push_back({length, 0u});
+					for (--run; run >= 3uz; run -= std::min(run, 6uz))
+						tokens.push_back({16u, static_cast<std::uint8_t> (std::min(run, 6uz) - 3uz)});
+				}
+				for (; run != 0uz; --run)
+					tokens.push_back({length, 0u});
+			}
+			return tokens;
+		}
+
+		auto writeStored(BitWriter& writer, const std::span<const std::byte> content, const bool isFinal) -> void {
+			std::size_t offset {0uz};
+			do {
+				const std::size_t size {std::min(content.size() - offset, MAX_STORED_SIZE)};
+				writer.write(isFinal && offset + size == content.size() ? 1u : 0u, 1u);
+				writer.write(0u, 2u);
+				writer.align();
+				writer.write(static_cast<std::uint32_t> (size), 16u);
+				writer.write(static_cast<std::uint32_t> (~size & 0xffffu), 16u);
+				writer.bytes.insert(writer.bytes.end(), content.begin() + static_cast<std::ptrdiff_t> (offset), content.begin() + static_cast<std::ptrdiff_t> (offset + size));
+				offset += size;
+			} while (offset != content.size());
+		}
+
+		auto writeBlock(
+			BitWriter& writer,
+			const std::span<const Token> tokens,
+			const std::span<const std::byte> content,
+			const bool isFinal
+		) -> void {
+			std::array<std::uint32_t, 286uz> litlenFrequencies {};
+			std::array<std::uint32_t, 30uz> distanceFrequencies {};
+			for (const Token& token : tokens) {
+				if (token.length == 0u)
+					++litlenFrequencies[token.value];
+				else {
+					++litlenFrequencies[getLengthSymbol(token.length)];
+					++distanceFrequencies[getDistanceSymbol(token.value)];
+				}
+			}
+			litlenFrequencies[END_OF_BLOCK] = 1u;
+			const std::vector<std::uint8_t> litlenLengths {makeCodeLengths(litlenFrequencies, MAX_CODE_LENGTH)};
+			std::vector<std::uint8_t> distanceLengths {makeCodeLengths(distanceFrequencies, MAX_CODE_LENGTH)};
+			/* some decoders reject a block without any distance code */
+			if (std::ranges::all_of(distanceLengths, [](const std::uint8_t length) {return length == 0u;}))
+				distanceLengths[0] = 1u;
+
+			std::size_t litlenCount {litlenLengths.size()};
+			while (litlenLengths[litlenCount - 1uz] == 0u)
+				--litlenCount;
+			std::size_t distanceCount {distanceLengths.size()};
+			while (distanceLengths[distanceCount - 1uz] == 0u)
+				--distanceCount;
+			std::vector<std::uint8_t> lengths {litlenLengths.begin(), litlenLengths.begin() + static_cast<std::ptrdiff_t> (litlenCount)};
+			lengths.insert(lengths.end(), distanceLengths.begin(), distanceLengths.begin() + static_cast<std::ptrdiff_t> (distanceCount));
+			const std::vector<CodeLengthToken> lengthTokens {encodeLengthRuns(lengths)};
+
+			std::array<std::uint32_t, 19uz> codeLengthFrequencies {};
+			for (const CodeLengthToken& token : lengthTokens)
+				++codeLengthFrequencies[token.symbol];
+			const std::vector<std::uint8_t> codeLengthLengths {makeCodeLengths(codeLengthFrequencies, MAX_CODE_LENGTH_CODE_LENGTH)};
+			std::size_t codeLengthCount {codeLengthLengths.size()};
+			while (codeLengthCount > 4uz && codeLengthLengths[CODE_LENGTH_ORDER[codeLengthCount - 1uz]] == 0u)
+				--codeLengthCount;
+
+			constexpr std::array<std::uint32_t, 19uz> RUN_EXTRA_BITS {0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 2u, 3u, 7u};
+			std::size_t bitCount {3uz + 14uz + codeLengthCount * 3uz + litlenLengths[END_OF_BLOCK]};
+			for (const CodeLengthToken& token : lengthTokens)
+				bitCount += codeLengthLengths[token.symbol] + RUN_EXTRA_BITS[token.symbol];
+			for (const Token& token : tokens) {
+				if (token.length == 0u) {
+					bitCount += litlenLengths[token.value];
+					continue;
+				}
+				const std::uint32_t lengthSymbol {getLengthSymbol(token.length)};
+				const std::uint32_t distanceSymbol {getDistanceSymbol(token.value)};
+				bitCount += litlenLengths[lengthSymbol] + LENGTH_EXTRA_BITS[lengthSymbol - 257u];
+				bitCount += distanceLengths[distanceSymbol] + DISTANCE_EXTRA_BITS[distanceSymbol];
+			}
+			if (bitCount / 8uz >= content.size() + 5uz * (content.size() / MAX_STORED_SIZE + 1uz)) {
+				writeStored(writer, content, isFinal);
+				return;
+			}
+
+			const std::vector<std::uint16_t> litlenCodes {makeCodes(litlenLengths)};
+			const std::vector<std::uint16_t> distanceCodes {makeCodes(distanceLengths)};
+			const std::vector<std::uint16_t> codeLengthCodes {makeCodes(codeLengthLengths)};
+			writer.write(isFinal ? 1u : 0u, 1u);
+			writer.write(2u, 2u);
+			writer.write(static_cast<std::uint32_t> (litlenCount - 257uz), 5u);
+			writer.write(static_cast<std::uint32_t> (distanceCount - 1uz), 5u);
+			writer.write(static_cast<std::uint32_t> (codeLengthCount - 4uz), 4u);
+			for (std::size_t i {0uz}; i < codeLengthCount; ++i)
+				writer.write(codeLengthLengths[CODE_LENGTH_ORDER[i]], 3u);
+			for (const CodeLengthToken& token : lengthTokens) {
+				writer.write(codeLengthCodes[token.symbol], codeLengthLengths[token.symbol]);
+				writer.write(token.extra, RUN_EXTRA_BITS[token.symbol]);
+			}
+
+			for (const Token& token : tokens) {
+				if (token.length == 0u) {
+					writer.write(litlenCodes[token.value], litlenLengths[token.value]);
+					continue;
+				}
+				const std::uint32_t lengthSymbol {getLengthSymbol(token.length)};
+				writer.write(litlenCodes[lengthSymbol], litlenLengths[lengthSymbol]);
+				writer.write(token.length - LENGTH_BASES[lengthSymbol - 257u], LENGTH_EXTRA_BITS[lengthSymbol - 257u]);
+				const std::uint32_t distanceSymbol {getDistanceSymbol(token.value)};
+				writer.write(distanceCodes[distanceSymbol], distanceLengths[distanceSymbol]);
+				writer.write(token.value - DISTANCE_BASES[distanceSymbol], DISTANCE_EXTRA_BITS[distanceSymbol]);
+			}
+			writer.write(litlenCodes[END_OF_BLOCK], litlenLengths[END_OF_BLOCK]);
+		}
+	}
+
+
+	auto adler32(const std::span<const std::byte> bytes, const std::uint32_t checksum) noexcept -> std::uint32_t {
+		std::uint32_t a {checksum & 0xffffu};
+		std::uint32_t b {checksum >> 16u};
+		const std::byte* data {bytes.data()};
+		std::size_t left {bytes.size()};
+
+		/*
+		 * Over a stride of 32 bytes, `a` grows by their sum and `b` by 32 times `a` before the stride plus
+		 * each byte weighted by how many bytes are left in the stride, 32 for the first down to 1.
+		 */
+		const __m256i weights {_mm256_setr_epi8(
+			32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+			16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+		)};
+		const __m256i ones {_mm256_set1_epi16(1)};
+		while (left >= 32uz) {
+			const std::size_t strides {std::min(left / 32uz, ADLER_MAX_STRIDES)};
+			__m256i sums {_mm256_setzero_si256()};
+			__m256i previousSums {_mm256_setzero_si256()};
+			__m256i weightedSums {_mm256_setzero_si256()};
+			for (std::size_t i {0uz}; i < strides; ++i) {
+				const __m256i values {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (data))};
+				previousSums = _mm256_add_epi32(previousSums, sums);
+				sums = _mm256_add_epi32(sums, _mm256_sad_epu8(values, _mm256_setzero_si256()));
+				weightedSums = _mm256_add_epi32(weightedSums, _mm256_madd_epi16(_mm256_maddubs_epi16(values, weights), ones));
+				data += 32;
+			}
+			left -= strides * 32uz;
+			const std::uint64_t newB {
+				b + static_cast<std::uint64_t> (a) * 32u * strides + 32u * sumLanes(previousSums) + sumLanes(weightedSums)
+			};
+			a = static_cast<std::uint32_t> ((a + sumLanes(sums)) % ADLER_MODULO);
+			b = static_cast<std::uint32_t> (newB % ADLER_MODULO);
+		}
+		for (; left != 0uz; --left) {
+			a += static_cast<std::uint32_t> (*data++);
+			b += a;
+		}
+		return ((b % ADLER_MODULO) << 16u) | (a % ADLER_MODULO);
+	}
+
+	auto crc32(const std::span<const std::byte> bytes, const std::uint32_t checksum) noexcept -> std::uint32_t {
+		std::uint32_t crc {~checksum};
+		const std::byte* data {bytes.data()};
+		std::size_t left {bytes.size()};
+		for (; left >= 8uz; left -= 8uz, data += 8) {
+			std::uint32_t low {};
+			std::uint32_t high {};
+			(void)std::memcpy(&low, data, sizeof(low));
+			(void)std::memcpy(&high, data + 4, sizeof(high));
+			low ^= crc;
+			crc = CRC_TABLES[7][low & 0xffu] ^ CRC_TABLES[6][(low >> 8u) & 0xffu]
+				^ CRC_TABLES[5][(low >> 16u) & 0xffu] ^ CRC_TABLES[4][low >> 24u]
+				^ CRC_TABLES[3][high & 0xffu] ^ CRC_TABLES[2][(high >> 8u) & 0xffu]
+				^ CRC_TABLES[1][(high >> 16u) & 0xffu] ^ CRC_TABLES[0][high >> 24u];
+		}
+		for (; left != 0uz; --left)
+			crc = (crc >> 8u) ^ CRC_TABLES[0][(crc ^ static_cast<std::uint32_t> (*data++)) & 0xffu];
+		return ~crc;
+	}
+
+
+	auto deflate(const std::span<const std::byte> input, const DeflateFormat format) noexcept -> std::vector<std::byte> {
+		BitWriter writer {};
+		if (format == DeflateFormat::zlib) {
+			/* deflate with a 32 KB window, the check bits make the header a multiple of 31 */
+			writer.write(0x78u, 8u);
+			writer.write(0x9cu, 8u);
+		}
+
+		const std::byte* const begin {input.data()};
+		const std::byte* const end {begin + input.size()};
+		/* positions plus one, zero is an empty slot */
+		std::vector<std::size_t> table (1uz << HASH_BITS, 0uz);
+		std::vector<Token> tokens {};
+		std::size_t position {0uz};
+		do {
+			const std::size_t blockStart {position};
+			const std::size_t blockEnd {std::min(blockStart + BLOCK_SIZE, input.size())};
+			tokens.clear();
+			while (position < blockEnd) {
+				std::size_t length {0uz};
+				std::size_t distance {0uz};
+				if (input.size() - position >= MIN_MATCH) {
+					const std::uint32_t sequence {read32(begin + position)};
+					std::size_t& slot {table[hash(sequence)]};
+					if (slot != 0uz && position - (slot - 1uz) <= MAX_DISTANCE && read32(begin + slot - 1uz) == sequence) {
+						distance = position - (slot - 1uz);
+						const std::byte* const matchEnd {begin + std::min(position + MAX_MATCH, input.size())};
+						length = MIN_MATCH + countCommon(begin + position + MIN_MATCH, begin + slot - 1uz + MIN_MATCH, matchEnd);
+					}
+					slot = position + 1uz;
+				}
+				if (length == 0uz) {
+					tokens.push_back({0u, static_cast<std::uint16_t> (input[position])});
+					++position;
+					continue;
+				}
+				tokens.push_back({static_cast<std::uint16_t> (length), static_cast<std::uint16_t> (distance)});
+				for (std::size_t next {position + 1uz}; next < position + length && end - (begin + next) >= static_cast<std::ptrdiff_t> (MIN_MATCH); ++next)
+					table[hash(read32(begin + next))] = next + 1uz;
+				position += length;
+			}
+			writeBlock(writer, tokens, input.subspan(blockStart, position - blockStart), position == input.size());
+		} while (position != input.size());
+
+		writer.align();
+		if (format == DeflateFormat::zlib) {
+			const std::uint32_t checksum {adler32(input)};
+			writer.write(checksum >> 24u, 8u);
+			writer.write((checksum >> 16u) & 0xffu, 8u);
+			writer.write((checksum >> 8u) & 0xffu, 8u);
+			writer.write(checksum & 0xffu, 8u);
+		}
+		return std::move(writer.bytes);
+	}
+}
@@ -0,0 +1,745 @@
+#include "voxlet/compression/deflate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "voxlet/memory.hpp"
+
+
+namespace vx::compression {
+	namespace {
+		constexpr std::uint32_t MAX_CODE_LENGTH {15u};
+		constexpr std::uint32_t LITLEN_TABLE_BITS {12u};
+		constexpr std::uint32_t DISTANCE_TABLE_BITS {9u};
+		constexpr std::uint32_t CODE_LENGTH_TABLE_BITS {7u};
+		constexpr std::size_t LITLEN_SYMBOL_COUNT {288uz};
+		constexpr std::size_t DISTANCE_SYMBOL_COUNT {32uz};
+		constexpr std::size_t CODE_LENGTH_SYMBOL_COUNT {19uz};
+		constexpr std::size_t END_OF_BLOCK {256uz};
+		constexpr std::size_t MAX_MATCH {258uz};
+		constexpr std::size_t WINDOW_SIZE {32uz * 1024uz};
+		constexpr std::size_t CHUNK_SIZE {256uz * 1024uz};
+		constexpr std::size_t WILD_COPY_SIZE {32uz};
+		/* the fast loop decodes a whole symbol, match included, without checking the bounds on the way */
+		constexpr std::size_t FAST_INPUT_MARGIN {8uz};
+		constexpr std::size_t FAST_OUTPUT_MARGIN {MAX_MATCH + WILD_COPY_SIZE};
+
+		constexpr std::array<std::uint16_t, 29uz> LENGTH_BASES {
+			3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 11u, 13u, 15u, 17u, 19u, 23u, 27u, 31u,
+			35u, 43u, 51u, 59u, 67u, 83u, 99u, 115u, 131u, 163u, 195u, 227u, 258u
+		};
+		constexpr std::array<std::uint8_t, 29uz> LENGTH_EXTRA_BITS {
+			0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u, 1u, 1u, 1u, 2u, 2u, 2u, 2u,
+			3u, 3u, 3u, 3u, 4u, 4u, 4u, 4u, 5u, 5u, 5u, 5u, 0u
+		};
+		constexpr std::array<std::uint16_t, 30uz> DISTANCE_BASES {
+			1u, 2u, 3u, 4u, 5u, 7u, 9u, 13u, 17u, 25u, 33u, 49u, 65u, 97u, 129u, 193u,
+			257u, 385u, 513u, 769u, 1025u, 1537u, 2049u, 3073u, 4097u, 6145u, 8193u, 12289u, 16385u, 24577u
+		};
+		constexpr std::array<std::uint8_t, 30uz> DISTANCE_EXTRA_BITS {
+			0u, 0u, 0u, 0u, 1u, 1u, 2u, 2u, 3u, 3u, 4u, 4u, 5u, 5u, 6u, 6u,
+			7u, 7u, 8u, 8u, 9u, 9u, 10u, 10u, 11u, 11u, 12u, 12u, 13u, 13u
+		};
+		constexpr std::array<std::uint8_t, CODE_LENGTH_SYMBOL_COUNT> CODE_LENGTH_ORDER {
+			16u, 17u, 18u, 0u, 8u, 7u, 9u, 6u, 10u, 5u, 11u, 4u, 12u, 3u, 13u, 2u, 14u, 1u, 15u
+		};
+
+		/*
+		 * A table entry packs the length of the code in bits 0-4, its kind in bits 5-7, the count of extra
+		 * bits that follow it in bits 8-11, and from bit 12 the literal, the two literals, the base length or
+		 * distance, or the symbol. An entry of zero is a code that isn't part of the set.
+		 */
+		constexpr std::uint32_t ENTRY_INVALID {0u};
+		constexpr std::uint32_t ENTRY_LITERAL {1u};
+		constexpr std::uint32_t ENTRY_LITERAL_PAIR {2u};
+		constexpr std::uint32_t ENTRY_LENGTH {3u};
+		constexpr std::uint32_t ENTRY_END {4u};
+		constexpr std::uint32_t ENTRY_SYMBOL {5u};
+		/* the code is longer than the table, which only holds its first bits */
+		constexpr std::uint32_t ENTRY_LONG_CODE {6u};
+
+		constexpr auto makeEntry(
+			const std::uint32_t codeLength,
+			const std::uint32_t kind,
+			const std::uint32_t extraBits,
+			const std::uint32_t value
+		) noexcept -> std::uint32_t {
+			return codeLength | (kind << 5u) | (extraBits << 8u) | (value << 12u);
+		}
+
+		constexpr auto getCodeLength(const std::uint32_t entry) noexcept -> std::uint32_t {return entry & 31u;}
+		constexpr auto getKind(const std::uint32_t entry) noexcept -> std::uint32_t {return (entry >> 5u) & 7u;}
+		constexpr auto getExtraBits(const std::uint32_t entry) noexcept -> std::uint32_t {return (entry >> 8u) & 15u;}
+		constexpr auto getValue(const std::uint32_t entry) noexcept -> std::uint32_t {return entry >> 12u;}
+
+		auto makeLitlenEntry(const std::uint32_t symbol, const std::uint32_t codeLength) noexcept -> std::uint32_t {
+			if (symbol < END_OF_BLOCK)
+				return makeEntry(codeLength, ENTRY_LITERAL, 0u, symbol);
+			if (symbol == END_OF_BLOCK)
+				return makeEntry(codeLength, ENTRY_END, 0u, 0u);
+			if (symbol - END_OF_BLOCK - 1u < LENGTH_BASES.size())
+				return makeEntry(codeLength, ENTRY_LENGTH, LENGTH_EXTRA_BITS[symbol - 257u], LENGTH_BASES[symbol - 257u]);
+			return ENTRY_INVALID;
+		}
+
+		auto makeDistanceEntry(const std::uint32_t symbol, const std::uint32_t codeLength) noexcept -> std::uint32_t {
+			if (symbol < DISTANCE_BASES.size())
+				return makeEntry(codeLength, ENTRY_SYMBOL, DISTANCE_EXTRA_BITS[symbol], DISTANCE_BASES[symbol]);
+			return ENTRY_INVALID;
+		}
+
+		auto makeCodeLengthEntry(const std::uint32_t symbol, const std::uint32_t codeLength) noexcept -> std::uint32_t {
+			return makeEntry(codeLength, ENTRY_SYMBOL, 0u, symbol);
+		}
+
+		template <std::uint32_t TABLE_BITS, std::size_t SYMBOL_COUNT>
+		struct Huffman {
+			std::array<std::uint32_t, 1uz << TABLE_BITS> entries;
+			/* the canonical form of the code, to decode the codes longer than the table */
+			std::array<std::uint16_t, MAX_CODE_LENGTH + 1u> counts;
+			std::array<std::uint16_t, SYMBOL_COUNT> symbols;
+		};
+
+		using LitlenHuffman = Huffman<LITLEN_TABLE_BITS, LITLEN_SYMBOL_COUNT>;
+		using DistanceHuffman = Huffman<DISTANCE_TABLE_BITS, DISTANCE_SYMBOL_COUNT>;
+		using CodeLengthHuffman = Huffman<CODE_LENGTH_TABLE_BITS, CODE_LENGTH_SYMBOL_COUNT>;
+
+		auto reverseBits(std::uint32_t code, const std::uint32_t length) noexcept -> std::uint32_t {
+			std::uint32_t reversed {0u};
+			for (std::uint32_t i {0u}; i < length; ++i) {
+				reversed = (reversed << 1u) | (code & 1u);
+				code >>= 1u;
+			}
+			return reversed;
+		}
+
+		/* false if `lengths` over-subscribe the code space, an incomplete code is fine until a missing code is read */
+		template <std::uint32_t TABLE_BITS, std::size_t SYMBOL_COUNT>
+		auto buildHuffman(
+			Huffman<TABLE_BITS, SYMBOL_COUNT>& huffman,
+			const std::span<const std::uint8_t> lengths,
+			auto (*const makeSymbolEntry)(std::uint32_t, std::uint32_t) noexcept -> std::uint32_t
+		) noexcept -> bool {
+			assert(lengths.size() <= SYMBOL_COUNT);
+			huffman.counts.fill(0u);
+			for (const std::uint8_t length : lengths)
+				++huffman.counts[length];
+			huffman.counts[0] = 0u;
+			std::int32_t left {1};
+			for (std::uint32_t length {1u}; length <= MAX_CODE_LENGTH; ++length) {
+				left = left * 2 - huffman.counts[length];
+				if (left < 0)
+					return false;
+			}
+
+			std::array<std::uint16_t, MAX_CODE_LENGTH + 1u> offsets {};
+			for (std::uint32_t length {1u}; length < MAX_CODE_LENGTH; ++length)
+				offsets[length + 1u] = static_cast<std::uint16_t> (offsets[length] + huffman.counts[length]);
+			for (std::size_t symbol {0uz}; symbol < lengths.size(); ++symbol) {
+				if (lengths[symbol] != 0u)
+					huffman.symbols[offsets[lengths[symbol]]++] = static_cast<std::uint16_t> (symbol);
+			}
+
+			/* a code of `length` bits fills every slot whose first `length` bits, read from the stream, are the code */
+			huffman.entries.fill(ENTRY_INVALID);
+			std::uint32_t code {0u};
+			std::size_t index {0uz};
+			for (std::uint32_t length {1u}; length <= MAX_CODE_LENGTH; ++length) {
+				for (std::uint32_t i {0u}; i < huffman.counts[length]; ++i) {
+					const std::uint32_t reversed {reverseBits(code++, length)};
+					const std::uint16_t symbol {huffman.symbols[index++]};
+					if (length > TABLE_BITS) {
+						huffman.entries[reversed & ((1u << TABLE_BITS) - 1u)] = makeEntry(0u, ENTRY_LONG_CODE, 0u, 0u);
+						continue;
+					}
+					const std::uint32_t entry {makeSymbolEntry(symbol, length)};
+					for (std::uint32_t slot {reversed}; slot < (1u << TABLE_BITS); slot += 1u << length)
+						huffman.entries[slot] = entry;
+				}
+				code <<= 1u;
+			}
+			return true;
+		}
+
+		/* merges the entries of two literals whose codes fit in the table together */
+		auto pairLiterals(LitlenHuffman& huffman) noexcept -> void {
+			const std::array<std::uint32_t, 1uz << LITLEN_TABLE_BITS> single {huffman.entries};
+			for (std::size_t slot {0uz}; slot < single.size(); ++slot) {
+				const std::uint32_t first {single[slot]};
+				if (getKind(first) != ENTRY_LITERAL)
+					continue;
+				const std::uint32_t second {single[slot >> getCodeLength(first)]};
+				const std::uint32_t codeLength {getCodeLength(first) + getCodeLength(second)};
+				if (getKind(second) == ENTRY_LITERAL && codeLength <= LITLEN_TABLE_BITS)
+					huffman.entries[slot] = makeEntry(codeLength, ENTRY_LITERAL_PAIR, 0u, getValue(first) | (getValue(second) << 8u));
+			}
+		}
+
+		/* bit by bit in canonical order, for codes longer than the table and literals split from their pair */
+		template <std::uint32_t TABLE_BITS, std::size_t SYMBOL_COUNT>
+		auto decodeCanonical(
+			const Huffman<TABLE_BITS, SYMBOL_COUNT>& huffman,
+			const std::uint64_t bits,
+			auto (*const makeSymbolEntry)(std::uint32_t, std::uint32_t) noexcept -> std::uint32_t
+		) noexcept -> std::uint32_t {
+			std::uint32_t code {0u};
+			std::uint32_t first {0u};
+			std::uint32_t index {0u};
+			for (std::uint32_t length {1u}; length <= MAX_CODE_LENGTH; ++length) {
+				code |= static_cast<std::uint32_t> (bits >> (length - 1u)) & 1u;
+				const std::uint32_t count {huffman.counts[length]};
+				if (code - first < count)
+					return makeSymbolEntry(huffman.symbols[index + code - first], length);
+				index += count;
+				first = (first + count) << 1u;
+				code <<= 1u;
+			}
+			return ENTRY_INVALID;
+		}
+
+
+		[[gnu::always_inline]]
+		inline auto read64(const std::byte* const data) noexcept -> std::uint64_t {
+			std::uint64_t value;
+			(void)std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		/* least significant bit first, the first bit of the stream is the lowest of `buffer` */
+		struct BitReader {
+			const std::byte* position;
+			const std::byte* end;
+			std::uint64_t buffer;
+			std::uint32_t count;
+			/* zero bytes shifted in past the end of the input, reading any of them is an error */
+			std::uint32_t overrunBytes;
+
+			/* at least 56 bits, `end - position` must be at least 8 */
+			[[gnu::always_inline]]
+			inline auto refillFast() noexcept -> void {
+				buffer |= read64(position) << count;
+				position += (63u - count) >> 3u;
+				count |= 56u;
+			}
+
+			[[gnu::always_inline]]
+			inline auto refill() noexcept -> void {
+				if (end - position >= 8) {
+					refillFast();
+					return;
+				}
+				while (count <= 56u) {
+					if (position != end)
+						buffer |= static_cast<std::uint64_t> (*position++) << count;
+					else
+						++overrunBytes;
+					count += 8u;
+				}
+			}
+
+			[[gnu::always_inline]]
+			inline auto peek(const std::uint32_t bitCount) const noexcept -> std::uint32_t {
+				return static_cast<std::uint32_t> (buffer & ((1ull << bitCount) - 1u));
+			}
+
+			[[gnu::always_inline]]
+			inline auto consume(const std::uint32_t bitCount) noexcept -> void {
+				buffer >>= bitCount;
+				count -= bitCount;
+			}
+
+			[[gnu::always_inline]]
+			inline auto isOverrun() const noexcept -> bool {
+				return count < overrunBytes * 8u;
+			}
+
+			/* drops the bits left in the current byte and gives the whole bytes in the buffer back to the input */
+			auto alignToInput() noexcept -> bool {
+				consume(count % 8u);
+				if (isOverrun())
+					return false;
+				position -= count / 8u - overrunBytes;
+				buffer = 0u;
+				count = 0u;
+				overrunBytes = 0u;
+				return true;
+			}
+		};
+
+		auto readZlibHeader(const std::span<const std::byte> input) noexcept -> bool {
+			if (input.size() < 2uz)
+				return false;
+			const auto method {static_cast<std::uint32_t> (input[0])};
+			const auto flags {static_cast<std::uint32_t> (input[1])};
+			/* deflate with a window of at most 32 KB, and no preset dictionary */
+			return (method & 15u) == 8u && (method >> 4u) <= 7u && (method * 256u + flags) % 31u == 0u && (flags & 0x20u) == 0u;
+		}
+
+		auto readZlibTrailer(BitReader& reader) noexcept -> std::optional<std::uint32_t> {
+			if (!reader.alignToInput() || reader.end - reader.position < 4)
+				return std::nullopt;
+			std::uint32_t checksum {0u};
+			for (std::size_t i {0uz}; i < 4uz; ++i)
+				checksum = (checksum << 8u) | static_cast<std::uint32_t> (reader.position[i]);
+			reader.position += 4;
+			return checksum;
+		}
+
+		/* copies 32 bytes at a time, may write up to 31 bytes past `destination + size` */
+		[[gnu::always_inline]]
+		inline auto wildCopy(std::byte* destination, const std::byte* source, const std::size_t size) noexcept -> void {
+			std::byte* const end {destination + size};
+			do {
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i*> (destination),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*> (source))
+				);
+				destination += WILD_COPY_SIZE;
+				source += WILD_COPY_SIZE;
+			} while (destination < end);
+		}
+
+		[[gnu::always_inline]]
+		inline auto copyMatch(
+			std::byte* const destination,
+			const std::size_t distance,
+			const std::size_t length,
+			const std::byte* const end
+		) noexcept -> void {
+			const std::byte* const match {destination - distance};
+			if (distance >= WILD_COPY_SIZE && length + WILD_COPY_SIZE <= static_cast<std::size_t> (end - destination))
+				wildCopy(destination, match, length);
+			else if (distance == 1uz)
+				(void)std::memset(destination, static_cast<int> (*match), length);
+			else {
+				/* the copied run doubles each time, so a short distance repeats its pattern without overlapping */
+				std::byte* output {destination};
+				std::size_t left {length};
+				while (left != 0uz) {
+					const std::size_t size {std::min(left, static_cast<std::size_t> (output - match))};
+					vx::memory::memcpy(output, match, size);
+					output += size;
+					left -= size;
+				}
+			}
+		}
+	}
+
+
+	namespace internal {
+		struct InflateState {
+			enum class Stage {
+				blockHeader,
+				stored,
+				huffman,
+				done,
+				failed
+			};
+
+			BitReader reader;
+			Stage stage;
+			bool isFinalBlock;
+			std::size_t storedLeft;
+			LitlenHuffman litlen;
+			DistanceHuffman distance;
+		};
+	}
+
+
+	namespace {
+		using Stage = internal::InflateState::Stage;
+
+		auto readFixedCodes(internal::InflateState& state) noexcept -> bool {
+			std::array<std::uint8_t, LITLEN_SYMBOL_COUNT> litlenLengths {};
+			std::fill_n(litlenLengths.begin(), 144uz, 8u);
+			std::fill_n(litlenLengths.begin() + 144, 112uz, 9u);
+			std::fill_n(litlenLengths.begin() + 256, 24uz, 7u);
+			std::fill_n(litlenLengths.begin() + 280, 8uz, 8u);
+			std::array<std::uint8_t, DISTANCE_SYMBOL_COUNT> distanceLengths {};
+			distanceLengths.fill(5u);
+			/* no two fixed literals fit together in the table, they take at least 8 bits each */
+			return buildHuffman(state.litlen, litlenLengths, makeLitlenEntry)
+				&& buildHuffman(state.distance, distanceLengths, makeDistanceEntry);
+		}
+
+		auto readDynamicCodes(internal::InflateState& state) noexcept -> bool {
+			BitReader& reader {state.reader};
+			reader.refill();
+			const std::uint32_t litlenCount {reader.peek(5u) + 257u};
+			reader.consume(5u);
+			const std::uint32_t distanceCount {reader.peek(5u) + 1u};
+			reader.consume(5u);
+			const std::uint32_t codeLengthCount {reader.peek(4u) + 4u};
+			reader.consume(4u);
+			if (litlenCount > 286u || distanceCount > 30u)
+				return false;
+
+			std::array<std::uint8_t, CODE_LENGTH_SYMBOL_COUNT> codeLengthLengths {};
+			for (std::uint32_t i {0u}; i < codeLengthCount; ++i) {
+				reader.refill();
+				codeLengthLengths[CODE_LENGTH_ORDER[i]] = static_cast<std::uint8_t> (reader.peek(3u));
+				reader.consume(3u);
+			}
+			CodeLengthHuffman codeLengths;
+			if (reader.isOverrun() || !buildHuffman(codeLengths, codeLengthLengths, makeCodeLengthEntry))
+				return false;
+
+			/* both sets of lengths are a single sequence, a run can go from one to the other */
+			std::array<std::uint8_t, 286uz + 30uz> lengths {};
+			const std::uint32_t lengthCount {litlenCount + distanceCount};
+			for (std::uint32_t i {0u}; i < lengthCount;) {
+				reader.refill();
+				const std::uint32_t entry {codeLengths.entries[reader.peek(CODE_LENGTH_TABLE_BITS)]};
+				if (getKind(entry) == ENTRY_INVALID)
+					return false;
+				reader.consume(getCodeLength(entry));
+				const std::uint32_t symbol {getValue(entry)};
+				if (symbol < 16u) {
+					lengths[i++] = static_cast<std::uint8_t> (symbol);
+					continue;
+				}
+				std::uint8_t length {0u};
+				std::uint32_t repeat;
+				if (symbol == 16u) {
+					if (i == 0u)
+						return false;
+					length = lengths[i - 1u];
+					repeat = 3u + reader.peek(2u);
+					reader.consume(2u);
+				}
+				else if (symbol == 17u) {
+					repeat = 3u + reader.peek(3u);
+					reader.consume(3u);
+				}
+				else {
+					repeat = 11u + reader.peek(7u);
+					reader.consume(7u);
+				}
+				if (repeat > lengthCount - i)
+					return false;
+				std::fill_n(lengths.begin() + i, repeat, length);
+				i += repeat;
+			}
+			if (reader.isOverrun() || lengths[END_OF_BLOCK] == 0u)
+				return false;
+
+			const std::span<const std::uint8_t> allLengths {lengths};
+			if (!buildHuffman(state.litlen, allLengths.first(litlenCount), makeLitlenEntry))
+				return false;
+			pairLiterals(state.litlen);
+			return buildHuffman(state.distance, allLengths.subspan(litlenCount, distanceCount), makeDistanceEntry);
+		}
+
+		auto readBlockHeader(internal::InflateState& state) noexcept -> bool {
+			BitReader& reader {state.reader};
+			reader.refill();
+			state.isFinalBlock = reader.peek(1u) != 0u;
+			reader.consume(1u);
+			const std::uint32_t type {reader.peek(2u)};
+			reader.consume(2u);
+			if (reader.isOverrun())
+				return false;
+
+			switch (type) {
+				case 0u: {
+					if (!reader.alignToInput() || reader.end - reader.position < 4)
+						return false;
+					const auto length {static_cast<std::uint32_t> (reader.position[0]) | (static_cast<std::uint32_t> (reader.position[1]) << 8u)};
+					const auto lengthComplement {static_cast<std::uint32_t> (reader.position[2]) | (static_cast<std::uint32_t> (reader.position[3]) << 8u)};
+					if (length != (~lengthComplement & 0xffffu))
+						return false;
+					reader.position += 4;
+					state.storedLeft = length;
+					state.stage = Stage::stored;
+					return true;
+				}
+				case 1u:
+					state.stage = Stage::huffman;
+					return readFixedCodes(state);
+				case 2u:
+					state.stage = Stage::huffman;
+					return readDynamicCodes(state);
+				default:
+					return false;
+			}
+		}
+
+		auto endBlock(internal::InflateState& state) noexcept -> void {
+			state.stage = state.isFinalBlock ? Stage::done : Stage::blockHeader;
+		}
+
+		/* false once `output` is full */
+		auto copyStored(internal::InflateState& state, std::byte*& output, std::byte* const outputEnd) noexcept -> bool {
+			BitReader& reader {state.reader};
+			const std::size_t size {std::min({
+				state.storedLeft,
+				static_cast<std::size_t> (outputEnd - output),
+				static_cast<std::size_t> (reader.end - reader.position)
+			})};
+			if (size != 0uz)
+				vx::memory::memcpy(output, reader.position, size);
+			output += size;
+			reader.position += size;
+			state.storedLeft -= size;
+			if (state.storedLeft == 0uz)
+				endBlock(state);
+			else if (reader.position == reader.end)
+				state.stage = Stage::failed;
+			else
+				return false;
+			return true;
+		}
+
+		enum class SymbolsResult {
+			endOfBlock,
+			outputFull,
+			malformed,
+			/* the fast loop is out of margin, the careful one takes over */
+			outOfMargin
+		};
+
+		/*
+		 * The fast loop refills once per symbol and writes without checking the bounds, a length with its
+		 * extra bits and distance with its extra bits take at most 48 bits. The careful loop checks both the
+		 * input and the output, and rewinds to the start of the symbol when the output is too short for it.
+		 */
+		template <bool IS_CAREFUL>
+		[[gnu::always_inline]]
+		inline auto decodeSymbols(
+			const internal::InflateState& state,
+			BitReader& reader,
+			std::byte* const outputBegin,
+			std::byte*& output,
+			std::byte* const outputEnd
+		) noexcept -> SymbolsResult {
+			std::byte* out {output};
+			SymbolsResult result;
+			while (true) {
+				if constexpr (IS_CAREFUL)
+					reader.refill();
+				else {
+					if (reader.end - reader.position < static_cast<std::ptrdiff_t> (FAST_INPUT_MARGIN)
+						|| outputEnd - out < static_cast<std::ptrdiff_t> (FAST_OUTPUT_MARGIN)
+					) {
+						result = SymbolsResult::outOfMargin;
+						break;
+					}
+					reader.refillFast();
+				}
+				const BitReader symbolStart {reader};
+				const auto room {static_cast<std::size_t> (outputEnd - out)};
+
+				std::uint32_t entry {state.litlen.entries[reader.peek(LITLEN_TABLE_BITS)]};
+				if (getKind(entry) == ENTRY_LITERAL_PAIR) {
+					if (!IS_CAREFUL || room >= 2uz) {
+						reader.consume(getCodeLength(entry));
+						if (IS_CAREFUL && reader.isOverrun()) {
+							result = SymbolsResult::malformed;
+							break;
+						}
+						out[0] = static_cast<std::byte> (getValue(entry));
+						out[1] = static_cast<std::byte> (getValue(entry) >> 8u);
+						out += 2;
+						continue;
+					}
+					entry = decodeCanonical(state.litlen, reader.buffer, makeLitlenEntry);
+				}
+				else if (getKind(entry) == ENTRY_LONG_CODE)
+					entry = decodeCanonical(state.litlen, reader.buffer, makeLitlenEntry);
+
+				const std::uint32_t kind {getKind(entry)};
+				if (kind == ENTRY_LITERAL) {
+					if (IS_CAREFUL && room == 0uz) {
+						result = SymbolsResult::outputFull;
+						break;
+					}
+					reader.consume(getCodeLength(entry));
+					if (IS_CAREFUL && reader.isOverrun()) {
+						result = SymbolsResult::malformed;
+						break;
+					}
+					*out++ = static_cast<std::byte> (getValue(entry));
+					continue;
+				}
+				if (kind == ENTRY_END) {
+					reader.consume(getCodeLength(entry));
+					result = IS_CAREFUL && reader.isOverrun() ? SymbolsResult::malformed : SymbolsResult::endOfBlock;
+					break;
+				}
+				if (kind != ENTRY_LENGTH) {
+					result = SymbolsResult::malformed;
+					break;
+				}
+
+				reader.consume(getCodeLength(entry));
+				const std::size_t length {getValue(entry) + reader.peek(getExtraBits(entry))};
+				reader.consume(getExtraBits(entry));
+				std::uint32_t distanceEntry {state.distance.entries[reader.peek(DISTANCE_TABLE_BITS)]};
+				if (getKind(distanceEntry) == ENTRY_LONG_CODE)
+					distanceEntry = decodeCanonical(state.distance, reader.buffer, makeDistanceEntry);
+				if (getKind(distanceEntry) != ENTRY_SYMBOL) {
+					result = SymbolsResult::malformed;
+					break;
+				}
+				reader.consume(getCodeLength(distanceEntry));
+				const std::size_t distance {getValue(distanceEntry) + reader.peek(getExtraBits(distanceEntry))};
+				reader.consume(getExtraBits(distanceEntry));
+
+				if (IS_CAREFUL && reader.isOverrun()) {
+					result = SymbolsResult::malformed;
+					break;
+				}
+				if (IS_CAREFUL && length > room) {
+					reader = symbolStart;
+					result = SymbolsResult::outputFull;
+					break;
+				}
+				if (distance > static_cast<std::size_t> (out - outputBegin)) {
+					result = SymbolsResult::malformed;
+					break;
+				}
+				copyMatch(out, distance, length, outputEnd);
+				out += length;
+			}
+			output = out;
+			return result;
+		}
+
+		/* decodes until the end of the stream, an error, or until `output` is too full to go on */
+		auto decode(
+			internal::InflateState& state,
+			std::byte* const outputBegin,
+			std::byte*& output,
+			std::byte* const outputEnd
+		) noexcept -> void {
+			while (true) {
+				switch (state.stage) {
+					case Stage::blockHeader:
+						if (!readBlockHeader(state))
+							state.stage = Stage::failed;
+						break;
+					case Stage::stored:
+						if (!copyStored(state, output, outputEnd))
+							return;
+						break;
+					case Stage::huffman: {
+						/* a local copy of the reader stays in registers */
+						BitReader reader {state.reader};
+						SymbolsResult result {decodeSymbols<false> (state, reader, outputBegin, output, outputEnd)};
+						if (result == SymbolsResult::outOfMargin)
+							result = decodeSymbols<true> (state, reader, outputBegin, output, outputEnd);
+						state.reader = reader;
+						if (result == SymbolsResult::outputFull)
+							return;
+						if (result == SymbolsResult::endOfBlock)
+							endBlock(state);
+						else
+							state.stage = Stage::failed;
+						break;
+					}
+					case Stage::done:
+					case Stage::failed:
+						return;
+				}
+			}
+		}
+
+		auto startStream(internal::InflateState& state, const std::span<const std::byte> input, const DeflateFormat format) noexcept
+			-> void
+		{
+			state.stage = Stage::blockHeader;
+			std::span<const std::byte> stream {input};
+			if (format == DeflateFormat::zlib) {
+				if (!readZlibHeader(input))
+					state.stage = Stage::failed;
+				else
+					stream = input.subspan(2uz);
+			}
+			state.reader = BitReader{
+				.position = stream.data(),
+				.end = stream.data() + stream.size(),
+				.buffer = 0u,
+				.count = 0u,
+				.overrunBytes = 0u
+			};
+		}
+	}
+
+
+	auto inflate(const std::span<const std::byte> input, const std::span<std::byte> output, const DeflateFormat format) noexcept
+		-> std::optional<std::size_t>
+	{
+		internal::InflateState state;
+		startStream(state, input, format);
+		std::byte* out {output.data()};
+		decode(state, output.data(), out, output.data() + output.size());
+		if (state.stage != Stage::done)
+			return std::nullopt;
+		const auto size {static_cast<std::size_t> (out - output.data())};
+		if (format == DeflateFormat::zlib && readZlibTrailer(state.reader) != adler32(output.first(size)))
+			return std::nullopt;
+		return size;
+	}
+
+
+	Inflater::Inflater(const std::span<const std::byte> input, const DeflateFormat format) noexcept :
+		m_state {std::make_unique<internal::InflateState> ()},
+		m_format {format},
+		m_buffer (WINDOW_SIZE + CHUNK_SIZE),
+		m_readOffset {0uz},
+		m_writeOffset {0uz},
+		m_checksum {1u}
+	{
+		startStream(*m_state, input, format);
+	}
+
+	Inflater::Inflater(Inflater&&) noexcept = default;
+	auto Inflater::operator=(Inflater&&) noexcept -> Inflater& = default;
+	Inflater::~Inflater() = default;
+
+
+	auto Inflater::read(const std::span<std::byte> output) noexcept -> std::size_t {
+		std::size_t written {0uz};
+		while (written < output.size()) {
+			if (m_readOffset != m_writeOffset) {
+				const std::size_t size {std::min(output.size() - written, m_writeOffset - m_readOffset)};
+				vx::memory::memcpy(output.data() + written, m_buffer.data() + m_readOffset, size);
+				m_readOffset += size;
+				written += size;
+				continue;
+			}
+			if (m_state->stage == Stage::done || m_state->stage == Stage::failed)
+				break;
+
+			/* everything decoded has been read, only the window has to stay */
+			if (m_writeOffset > WINDOW_SIZE) {
+				vx::memory::memmove(m_buffer.data(), m_buffer.data() + m_writeOffset - WINDOW_SIZE, WINDOW_SIZE);
+				m_readOffset = WINDOW_SIZE;
+				m_writeOffset = WINDOW_SIZE;
+			}
+			std::byte* const chunk {m_buffer.data() + m_writeOffset};
+			std::byte* out {chunk};
+			decode(*m_state, m_buffer.data(), out, m_buffer.data() + m_buffer.size());
+			const auto size {static_cast<std::size_t> (out - chunk)};
+			m_writeOffset += size;
+			if (m_format != DeflateFormat::zlib)
+				continue;
+			m_checksum = adler32({chunk, size}, m_checksum);
+			if (m_state->stage == Stage::done && readZlibTrailer(m_state->reader) != m_checksum)
+				m_state->stage = Stage::failed;
+		}
+		return written;
+	}
+
+	auto Inflater::isDone() const noexcept -> bool {
+		return m_state->stage == Stage::done && m_readOffset == m_writeOffset;
+	}
+
+	auto Inflater::hasFailed() const noexcept -> bool {
+		return m_state->stage == Stage::failed;
+	}
+}
@@ -0,0 +1,388 @@
+#include "voxlet/compression/lz.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "voxlet/jobs/parallelFor.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::compression {
+	namespace {
+		constexpr std::size_t MIN_MATCH {4uz};
+		/* the format ends with literals only, and no match starts in the last 12 bytes */
+		constexpr std::size_t LAST_LITERALS {5uz};
+		constexpr std::size_t MATCH_FIND_LIMIT {12uz};
+		constexpr std::size_t MAX_OFFSET {65535uz};
+		constexpr std::uint32_t HASH_BITS {14u};
+		constexpr std::size_t WILD_COPY_SIZE {32uz};
+		constexpr std::uint32_t STORED_BLOCK_BIT {0x8000'0000u};
+
+		[[gnu::always_inline]]
+		inline auto read32(const std::byte* const data) noexcept -> std::uint32_t {
+			std::uint32_t value;
+			(void)std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		[[gnu::always_inline]]
+		inline auto read64(const std::byte* const data) noexcept -> std::uint64_t {
+			std::uint64_t value;
+			(void)std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		[[gnu::always_inline]]
+		inline auto hash(const std::uint32_t sequence) noexcept -> std::uint32_t {
+			return (sequence * 2654435761u) >> (32u - HASH_BITS);
+		}
+
+		/* the length of the common prefix of `lhs` and `rhs`, reading up to `end` from `lhs` */
+		[[gnu::always_inline]]
+		inline auto countCommon(const std::byte* lhs, const std::byte* rhs, const std::byte* const end) noexcept
+			-> std::size_t
+		{
+			const std::byte* const start {lhs};
+			while (end - lhs >= 8) {
+				const std::uint64_t difference {read64(lhs) ^ read64(rhs)};
+				if (difference != 0u)
+					return static_cast<std::size_t> (lhs - start) + static_cast<std::size_t> (std::countr_zero(difference) / 8);
+				lhs += 8;
+				rhs += 8;
+			}
+			while (lhs < end && *lhs == *rhs) {
+				++lhs;
+				++rhs;
+			}
+			return static_cast<std::size_t> (lhs - start);
+		}
+
+		[[gnu::always_inline]]
+		inline auto writeLength(std::byte*& output, std::size_t length) noexcept -> void {
+			for (; length >= 255uz; length -= 255uz)
+				*output++ = std::byte{255};
+			*output++ = static_cast<std::byte> (length);
+		}
+
+		auto writeSequence(
+			std::byte*& output,
+			const std::byte* const literals,
+			const std::size_t literalCount,
+			const std::size_t offset,
+			const std::size_t matchLength
+		) noexcept -> void {
+			std::byte* const token {output++};
+			std::uint32_t tokenValue {static_cast<std::uint32_t> (std::min(literalCount, 15uz)) << 4u};
+			if (literalCount >= 15uz)
+				writeLength(output, literalCount - 15uz);
+			if (literalCount != 0uz)
+				vx::memory::memcpy(output, literals, literalCount);
+			output += literalCount;
+			if (matchLength != 0uz) {
+				*output++ = static_cast<std::byte> (offset & 0xffu);
+				*output++ = static_cast<std::byte> (offset >> 8u);
+				tokenValue |= static_cast<std::uint32_t> (std::min(matchLength - MIN_MATCH, 15uz));
+				if (matchLength - MIN_MATCH >= 15uz)
+					writeLength(output, matchLength - MIN_MATCH - 15uz);
+			}
+			*token = static_cast<std::byte> (tokenValue);
+		}
+
+		/* adds the 255-terminated length extension to `length`, false if the input ends first */
+		[[gnu::always_inline]]
+		inline auto readLength(const std::byte*& input, const std::byte* const end, std::size_t& length) noexcept -> bool {
+			std::uint8_t value;
+			do {
+				if (input == end)
+					return false;
+				value = static_cast<std::uint8_t> (*input++);
+				length += value;
+			} while (value == 255u);
+			return true;
+		}
+
+		/* copies 32 bytes at a time, may write up to 31 bytes past `destination + size` */
+		[[gnu::always_inline]]
+		inline auto wildCopy(std::byte* destination, const std::byte* source, const std::size_t size) noexcept -> void {
+			std::byte* const end {destination + size};
+			do {
+				_mm256_storeu_si256(
+					reinterpret_cast<__m256i*> (destination),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*> (source))
+				);
+				destination += WILD_COPY_SIZE;
+				source += WILD_COPY_SIZE;
+			} while (destination < end);
+		}
+
+		auto readFrame(const std::span<const std::byte> frame) noexcept -> std::optional<LzFrameHeader> {
+			if (frame.size() < sizeof(LzFrameHeader))
+				return std::nullopt;
+			LzFrameHeader header;
+			(void)std::memcpy(&header, frame.data(), sizeof(header));
+			if (header.magic != LZ_FRAME_MAGIC || header.blockSize != LZ_BLOCK_SIZE)
+				return std::nullopt;
+			const std::uint64_t blockCount {header.size / header.blockSize + (header.size % header.blockSize != 0u ? 1u : 0u)};
+			if (blockCount > (frame.size() - sizeof(LzFrameHeader)) / sizeof(std::uint32_t))
+				return std::nullopt;
+			return header;
+		}
+
+		/* where each block starts in the frame, with the end of the last one as the last element */
+		auto getBlockOffsets(const std::span<const std::byte> frame, const LzFrameHeader& header) noexcept
+			-> std::optional<std::vector<std::size_t>>
+		{
+			const auto blockCount {static_cast<std::size_t> (header.size / header.blockSize + (header.size % header.blockSize != 0u ? 1u : 0u))};
+			std::vector<std::size_t> offsets (blockCount + 1uz);
+			offsets[0] = sizeof(LzFrameHeader) + blockCount * sizeof(std::uint32_t);
+			for (std::size_t block {0uz}; block < blockCount; ++block) {
+				const std::uint32_t size {read32(frame.data() + sizeof(LzFrameHeader) + block * sizeof(std::uint32_t))};
+				offsets[block + 1uz] = offsets[block] + (size & ~STORED_BLOCK_BIT);
+			}
+			if (offsets.back() > frame.size())
+				return std::nullopt;
+			return offsets;
+		}
+
+		auto decompressFrameBlock(
+			const std::span<const std::byte> frame,
+			const LzFrameHeader& header,
+			const std::span<const std::size_t> offsets,
+			const std::size_t block,
+			const std::span<std::byte> output
+		) noexcept -> bool {
+			const std::uint32_t size {read32(frame.data() + sizeof(LzFrameHeader) + block * sizeof(std::uint32_t))};
+			const std::span<const std::byte> input {frame.subspan(offsets[block], offsets[block + 1uz] - offsets[block])};
+			const std::size_t expectedSize {std::min<std::size_t> (
+				header.blockSize,
+				static_cast<std::size_t> (header.size) - block * header.blockSize
+			)};
+			if (output.size() != expectedSize)
+				return false;
+			if ((size & STORED_BLOCK_BIT) != 0u) {
+				if (input.size() != expectedSize)
+					return false;
+				vx::memory::memcpy(output.data(), input.data(), expectedSize);
+				return true;
+			}
+			const std::optional<std::size_t> decompressedSize {decompressBlock(input, output)};
+			return decompressedSize == expectedSize;
+		}
+
+		/* `table` holds `1 << HASH_BITS` slots, cleared for each block so that `compress` allocates it once */
+		auto compressBlock(
+			const std::span<const std::byte> input,
+			const std::span<std::byte> output,
+			const std::span<std::uint32_t> table
+		) noexcept -> std::size_t {
+			assert(output.size() >= getBlockBound(input.size()));
+			const std::byte* const begin {input.data()};
+			const std::byte* const end {begin + input.size()};
+			std::byte* out {output.data()};
+			const std::byte* anchor {begin};
+
+			if (input.size() > MATCH_FIND_LIMIT) {
+				/* positions relative to `begin`, a stale or empty slot is caught by the comparison */
+				std::ranges::fill(table, 0u);
+				const std::byte* const matchLimit {end - LAST_LITERALS};
+				const std::byte* const searchLimit {end - MATCH_FIND_LIMIT};
+				const std::byte* ip {begin + 1};
+				while (ip < searchLimit) {
+					const std::uint32_t sequence {read32(ip)};
+					std::uint32_t& slot {table[hash(sequence)]};
+					const std::byte* match {begin + slot};
+					slot = static_cast<std::uint32_t> (ip - begin);
+					if (static_cast<std::size_t> (ip - match) > MAX_OFFSET || match >= ip || read32(match) != sequence) {
+						/* skips faster through data that doesn't compress */
+						ip += 1 + ((ip - anchor) >> 6);
+						continue;
+					}
+
+					while (ip > anchor && match > begin && ip[-1] == match[-1]) {
+						--ip;
+						--match;
+					}
+					const std::size_t length {MIN_MATCH + countCommon(ip + MIN_MATCH, match + MIN_MATCH, matchLimit)};
+					writeSequence(out, anchor, static_cast<std::size_t> (ip - anchor), static_cast<std::size_t> (ip - match), length);
+					ip += length;
+					anchor = ip;
+					if (ip < searchLimit)
+						table[hash(read32(ip - 2))] = static_cast<std::uint32_t> (ip - 2 - begin);
+				}
+			}
+
+			writeSequence(out, anchor, static_cast<std::size_t> (end - anchor), 0uz, 0uz);
+			return static_cast<std::size_t> (out - output.data());
+		}
+	}
+
+
+	auto compressBlock(const std::span<const std::byte> input, const std::span<std::byte> output) noexcept -> std::size_t {
+		std::vector<std::uint32_t> table (1uz << HASH_BITS);
+		return compressBlock(input, output, table);
+	}
+
+	auto decompressBlock(const std::span<const std::byte> input, const std::span<std::byte> output) noexcept
+		-> std::optional<std::size_t>
+	{
+		const std::byte* ip {input.data()};
+		const std::byte* const inputEnd {ip + input.size()};
+		std::byte* op {output.data()};
+		std::byte* const outputBegin {op};
+		std::byte* const outputEnd {op + output.size()};
+
+		while (true) {
+			if (ip == inputEnd)
+				return std::nullopt;
+			const auto token {static_cast<std::uint8_t> (*ip++)};
+
+			std::size_t literalCount {static_cast<std::size_t> (token >> 4u)};
+			if (literalCount == 15uz && !readLength(ip, inputEnd, literalCount))
+				return std::nullopt;
+			const auto inputLeft {static_cast<std::size_t> (inputEnd - ip)};
+			const auto outputLeft {static_cast<std::size_t> (outputEnd - op)};
+			if (literalCount > inputLeft || literalCount > outputLeft)
+				return std::nullopt;
+			if (literalCount + WILD_COPY_SIZE <= inputLeft && literalCount + WILD_COPY_SIZE <= outputLeft)
+				wildCopy(op, ip, literalCount);
+			else if (literalCount != 0uz)
+				vx::memory::memcpy(op, ip, literalCount);
+			ip += literalCount;
+			op += literalCount;
+			if (ip == inputEnd)
+				break;
+
+			if (inputEnd - ip < 2)
+				return std::nullopt;
+			const std::size_t offset {static_cast<std::size_t> (ip[0]) | (static_cast<std::size_t> (ip[1]) << 8u)};
+			ip += 2;
+			if (offset == 0uz || offset > static_cast<std::size_t> (op - outputBegin))
+				return std::nullopt;
+			std::size_t length {static_cast<std::size_t> (token & 15u)};
+			if (length == 15uz && !readLength(ip, inputEnd, length))
+				return std::nullopt;
+			length += MIN_MATCH;
+			if (length > static_cast<std::size_t> (outputEnd - op))
+				return std::nullopt;
+
+			const std::byte* match {op - offset};
+			if (offset >= WILD_COPY_SIZE && length + WILD_COPY_SIZE <= static_cast<std::size_t> (outputEnd - op))
+				wildCopy(op, match, length);
+			else {
+				/* the copied run doubles each time, so a short offset repeats its pattern without overlapping */
+				std::byte* destination {op};
+				std::size_t left {length};
+				while (left != 0uz) {
+					const std::size_t size {std::min(left, static_cast<std::size_t> (destination - match))};
+					vx::memory::memcpy(destination, match, size);
+					destination += size;
+					left -= size;
+				}
+			}
+			op += length;
+		}
+		return static_cast<std::size_t> (op - outputBegin);
+	}
+
+
+	auto compress(const std::span<const std::byte> input) noexcept -> std::vector<std::byte> {
+		const std::size_t blockCount {(input.size() + LZ_BLOCK_SIZE - 1uz) / LZ_BLOCK_SIZE};
+		const LzFrameHeader header {
+			.magic = LZ_FRAME_MAGIC,
+			.blockSize = static_cast<std::uint32_t> (LZ_BLOCK_SIZE),
+			.size = input.size()
+		};
+		std::vector<std::byte> frame (sizeof(LzFrameHeader) + blockCount * sizeof(std::uint32_t));
+		vx::memory::memcpy(frame.data(), reinterpret_cast<const std::byte*> (&header), sizeof(header));
+
+		std::vector<std::byte> scratch (getBlockBound(LZ_BLOCK_SIZE));
+		std::vector<std::uint32_t> table (1uz << HASH_BITS);
+		for (std::size_t block {0uz}; block < blockCount; ++block) {
+			const std::span<const std::byte> content {input.subspan(
+				block * LZ_BLOCK_SIZE,
+				std::min(LZ_BLOCK_SIZE, input.size() - block * LZ_BLOCK_SIZE)
+			)};
+			std::size_t size {compressBlock(content, scratch, table)};
+			std::span<const std::byte> stored {std::span{scratch}.first(size)};
+			std::uint32_t sizeField {static_cast<std::uint32_t> (size)};
+			if (size >= content.size()) {
+				stored = content;
+				sizeField = static_cast<std::uint32_t> (content.size()) | STORED_BLOCK_BIT;
+			}
+			(void)std::memcpy(frame.data() + sizeof(LzFrameHeader) + block * sizeof(std::uint32_t), &sizeField, sizeof(sizeField));
+			frame.insert(frame.end(), stored.begin(), stored.end());
+		}
+		return frame;
+	}
+
+	auto getDecompressedSize(const std::span<const std::byte> frame) noexcept -> std::optional<std::size_t> {
+		const std::optional<LzFrameHeader> header {readFrame(frame)};
+		if (!header)
+			return std::nullopt;
+		return static_cast<std::size_t> (header->size);
+	}
+
+	auto decompress(const std::span<const std::byte> frame, const std::span<std::byte> output) noexcept -> bool {
+		const std::optional<LzFrameHeader> header {readFrame(frame)};
+		if (!header || header->size != output.size())
+			return false;
+		const std::optional<std::vector<std::size_t>> offsets {getBlockOffsets(frame, *header)};
+		if (!offsets)
+			return false;
+		for (std::size_t block {0uz}; block < offsets->size() - 1uz; ++block) {
+			const std::size_t begin {block * header->blockSize};
+			const std::span<std::byte> content {output.subspan(begin, std::min<std::size_t> (header->blockSize, output.size() - begin))};
+			if (!decompressFrameBlock(frame, *header, *offsets, block, content))
+				return false;
+		}
+		return true;
+	}
+
+	auto decompress(
+		const std::span<const std::byte> frame,
+		const std::span<std::byte> output,
+		vx::jobs::Scheduler& scheduler
+	) noexcept -> bool {
+		const std::optional<LzFrameHeader> header {readFrame(frame)};
+		if (!header || header->size != output.size())
+			return false;
+		const std::optional<std::vector<std::size_t>> offsets {getBlockOffsets(frame, *header)};
+		if (!offsets)
+			return false;
+		std::atomic_bool isValid {true};
+		vx::jobs::parallelFor(scheduler, 0uz, offsets->size() - 1uz, [&](const std::size_t first, const std::size_t last) noexcept {
+			for (std::size_t block {first}; block < last; ++block) {
+				const std::size_t begin {block * header->blockSize};
+				const std::span<std::byte> content {output.subspan(begin, std::min<std::size_t> (header->blockSize, output.size() - begin))};
+				if (!decompressFrameBlock(frame, *header, *offsets, block, content))
+					isValid.store(false, std::memory_order::relaxed);
+			}
+		}, 1uz);
+		return isValid.load(std::memory_order::relaxed);
+	}
+
+	auto decompress(const std::span<const std::byte> frame, vx::containers::StringAccumulator& output) noexcept -> bool {
+		const std::optional<LzFrameHeader> header {readFrame(frame)};
+		if (!header)
+			return false;
+		const std::optional<std::vector<std::size_t>> offsets {getBlockOffsets(frame, *header)};
+		if (!offsets)
+			return false;
+		std::vector<std::byte> block (std::min<std::size_t> (header->blockSize, static_cast<std::size_t> (header->size)));
+		for (std::size_t index {0uz}; index < offsets->size() - 1uz; ++index) {
+			const std::size_t size {std::min<std::size_t> (
+				header->blockSize,
+				static_cast<std::size_t> (header->size) - index * header->blockSize
+			)};
+			if (!decompressFrameBlock(frame, *header, *offsets, index, std::span{block}.first(size)))
+				return false;
+			output.push(reinterpret_cast<const char8_t*> (block.data()), size);
+		}
+		return true;
+	}
+}
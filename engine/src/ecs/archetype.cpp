@@ -0,0 +1,201 @@
+#include "voxlet/ecs/archetype.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <numeric>
+
+#include "voxlet/memory.hpp"
+
+
+namespace vx::ecs {
+	namespace {
+		auto relocate(const ComponentInfos& infos, std::byte* const destination, std::byte* const source) noexcept
+			-> void
+		{
+			if (infos.relocate == nullptr)
+				vx::memory::memcpy(destination, source, infos.size);
+			else
+				infos.relocate(destination, source);
+		}
+	}
+
+
+	Archetype::Archetype(std::vector<ComponentId>&& signature, vx::memory::BlockPool& chunkPool) noexcept :
+		m_chunkPool {&chunkPool},
+		m_signature {std::move(signature)},
+		m_columns {},
+		m_chunks {},
+		m_chunkCapacity {0uz},
+		m_entitiesOffset {vx::memory::alignUp(sizeof(ColumnTicks) * m_signature.size(), alignof(Entity))},
+		m_entityCount {0uz},
+		m_addEdges {},
+		m_removeEdges {}
+	{
+		assert(std::ranges::is_sorted(m_signature));
+		assert(std::ranges::adjacent_find(m_signature) == m_signature.end());
+		assert(m_chunkPool->getBlockSize() == CHUNK_SIZE);
+
+		m_columns.reserve(m_signature.size());
+		for (const ComponentId id : m_signature)
+			m_columns.push_back(Column{id, getComponentInfos(id), 0uz, 0uz, 0uz});
+
+		/* the chunk header holds the per-column ticks, each row stores an added and a changed tick per component */
+		const std::size_t rowSize {std::accumulate(m_columns.begin(), m_columns.end(), sizeof(Entity),
+			[](const std::size_t size, const Column& column) noexcept {return size + column.infos.size + 2uz * sizeof(Tick);}
+		)};
+		/* start from the unpadded capacity and shrink until every column fits with its alignment padding */
+		for (m_chunkCapacity = (CHUNK_SIZE - m_entitiesOffset) / rowSize; m_chunkCapacity != 0uz; --m_chunkCapacity) {
+			std::size_t offset {m_entitiesOffset + sizeof(Entity) * m_chunkCapacity};
+			for (Column& column : m_columns) {
+				offset = vx::memory::alignUp(offset, MAX_COMPONENT_ALIGNMENT);
+				column.offset = offset;
+				offset += column.infos.size * m_chunkCapacity;
+			}
+			offset = vx::memory::alignUp(offset, alignof(Tick));
+			for (Column& column : m_columns) {
+				column.addedTicksOffset = offset;
+				column.changedTicksOffset = offset + sizeof(Tick) * m_chunkCapacity;
+				offset += 2uz * sizeof(Tick) * m_chunkCapacity;
+			}
+			if (offset <= CHUNK_SIZE)
+				break;
+		}
+		assert(m_chunkCapacity != 0uz);
+	}
+
+	Archetype::~Archetype() {
+		for (const Chunk& chunk : m_chunks) {
+			for (const Column& column : m_columns) {
+				if (column.infos.destroy == nullptr)
+					continue;
+				for (std::size_t row {0uz}; row < chunk.count; ++row)
+					column.infos.destroy(chunk.memory + column.offset + row * column.infos.size);
+			}
+			m_chunkPool->deallocate(chunk.memory);
+		}
+	}
+
+
+	auto Archetype::findColumn(const ComponentId id) const noexcept -> std::size_t {
+		const auto it {std::ranges::lower_bound(m_signature, id)};
+		if (it == m_signature.end() || *it != id)
+			return npos;
+		return static_cast<std::size_t> (it - m_signature.begin());
+	}
+
+
+	auto Archetype::markAdded(const Location location, const std::size_t column, const Tick tick) noexcept -> void {
+		this->getAddedTicks(location.chunk, column)[location.row] = tick;
+		this->getChangedTicks(location.chunk, column)[location.row] = tick;
+		ColumnTicks& ticks {this->getColumnTicks(location.chunk, column)};
+		ticks.added = getNewest(ticks.added, tick);
+		ticks.changed = getNewest(ticks.changed, tick);
+	}
+
+	auto Archetype::markChanged(const Location location, const std::size_t column, const Tick tick) noexcept -> void {
+		this->getChangedTicks(location.chunk, column)[location.row] = tick;
+		ColumnTicks& ticks {this->getColumnTicks(location.chunk, column)};
+		ticks.changed = getNewest(ticks.changed, tick);
+	}
+
+	auto Archetype::markChunkChanged(const std::size_t chunk, const std::size_t column, const Tick tick) noexcept -> void {
+		ColumnTicks& ticks {this->getColumnTicks(chunk, column)};
+		ticks.allChanged = getNewest(ticks.allChanged, tick);
+		ticks.changed = getNewest(ticks.changed, tick);
+	}
+
+
+	auto Archetype::allocateRow(const Entity entity) noexcept -> Location {
+		if (m_chunks.empty() || m_chunks.back().count == m_chunkCapacity) {
+			m_chunks.push_back(Chunk{static_cast<std::byte*> (m_chunkPool->allocate()), 0u});
+			std::uninitialized_fill_n(reinterpret_cast<ColumnTicks*> (m_chunks.back().memory), m_columns.size(), ColumnTicks{});
+		}
+		const Location location {
+			static_cast<std::uint32_t> (m_chunks.size() - 1uz),
+			m_chunks.back().count++
+		};
+		this->getEntities(location.chunk)[location.row] = entity;
+		++m_entityCount;
+		return location;
+	}
+
+	auto Archetype::removeRow(const Location location) noexcept -> Entity {
+		for (std::size_t i {0uz}; i < m_columns.size(); ++i) {
+			if (m_columns[i].infos.destroy != nullptr)
+				m_columns[i].infos.destroy(this->getComponent(location, i));
+		}
+		return this->fillHole(location);
+	}
+
+	auto Archetype::moveRow(const Location location, Archetype& destination, Location& destinationLocation)
+		noexcept
+		-> Entity
+	{
+		assert(&destination != this);
+		destinationLocation = destination.allocateRow(this->getEntities(location.chunk)[location.row]);
+		std::size_t destinationColumn {0uz};
+		for (std::size_t i {0uz}; i < m_columns.size(); ++i) {
+			const Column& column {m_columns[i]};
+			while (destinationColumn < destination.m_columns.size() && destination.m_columns[destinationColumn].id < column.id)
+				++destinationColumn;
+			if (destinationColumn < destination.m_columns.size() && destination.m_columns[destinationColumn].id == column.id) {
+				relocate(column.infos, destination.getComponent(destinationLocation, destinationColumn), this->getComponent(location, i));
+				this->copyTicks(location, i, destination, destinationLocation, destinationColumn);
+			}
+			else if (column.infos.destroy != nullptr)
+				column.infos.destroy(this->getComponent(location, i));
+		}
+		return this->fillHole(location);
+	}
+
+
+	auto Archetype::findAddEdge(const ComponentId id) const noexcept -> Archetype* {
+		const auto it {m_addEdges.find(id)};
+		return it == m_addEdges.end() ? nullptr : it->second;
+	}
+
+	auto Archetype::findRemoveEdge(const ComponentId id) const noexcept -> Archetype* {
+		const auto it {m_removeEdges.find(id)};
+		return it == m_removeEdges.end() ? nullptr : it->second;
+	}
+
+
+	auto Archetype::fillHole(const Location location) noexcept -> Entity {
+		Chunk& lastChunk {m_chunks.back()};
+		const Location last {static_cast<std::uint32_t> (m_chunks.size() - 1uz), lastChunk.count - 1u};
+		Entity moved {};
+		if (location.chunk != last.chunk || location.row != last.row) {
+			for (std::size_t i {0uz}; i < m_columns.size(); ++i) {
+				relocate(m_columns[i].infos, this->getComponent(location, i), this->getComponent(last, i));
+				this->copyTicks(last, i, *this, location, i);
+			}
+			moved = this->getEntities(last.chunk)[last.row];
+			this->getEntities(location.chunk)[location.row] = moved;
+		}
+
+		--m_entityCount;
+		if (--lastChunk.count == 0u) {
+			m_chunkPool->deallocate(lastChunk.memory);
+			m_chunks.pop_back();
+		}
+		return moved;
+	}
+
+	auto Archetype::copyTicks(
+		const Location source,
+		const std::size_t sourceColumn,
+		Archetype& destination,
+		const Location target,
+		const std::size_t targetColumn
+	) noexcept -> void {
+		/* a bulk write of the source chunk must survive the move, so the effective changed tick is carried */
+		const Tick added {this->getAddedTicks(source.chunk, sourceColumn)[source.row]};
+		const Tick changed {this->getChangedTick(source, sourceColumn)};
+		destination.getAddedTicks(target.chunk, targetColumn)[target.row] = added;
+		destination.getChangedTicks(target.chunk, targetColumn)[target.row] = changed;
+		ColumnTicks& ticks {destination.getColumnTicks(target.chunk, targetColumn)};
+		ticks.added = getNewest(ticks.added, added);
+		ticks.changed = getNewest(ticks.changed, changed);
+	}
+}
@@ -0,0 +1,79 @@
+#include "voxlet/ecs/commandBuffer.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace vx::ecs {
+	CommandBuffer::CommandBuffer() noexcept :
+		m_blockPool {BLOCK_SIZE, 16uz},
+		m_blocks {},
+		m_cursor {nullptr},
+		m_end {nullptr},
+		m_head {nullptr},
+		m_tail {nullptr},
+		m_commandCount {0uz}
+	{}
+
+	CommandBuffer::~CommandBuffer() {
+		this->clear();
+	}
+
+
+	auto CommandBuffer::despawn(const Entity entity) noexcept -> void {
+		this->push([entity](World& world) noexcept {
+			(void)world.despawn(entity);
+		});
+	}
+
+
+	auto CommandBuffer::apply(World& world) noexcept -> void {
+		/* commands may record more commands into this buffer, they are applied in the same pass */
+		for (Node* node {m_head}; node != nullptr; node = node->next)
+			node->apply(*node, world);
+		this->clear();
+	}
+
+	auto CommandBuffer::clear() noexcept -> void {
+		for (Node* node {m_head}; node != nullptr; node = node->next) {
+			if (node->destroy != nullptr)
+				node->destroy(*node);
+		}
+		this->release();
+	}
+
+
+	auto CommandBuffer::allocate(const std::size_t size, const std::size_t alignment) noexcept -> std::byte* {
+		assert(size <= BLOCK_SIZE);
+		auto address {vx::memory::alignUp(reinterpret_cast<std::uintptr_t> (m_cursor), alignment)};
+		if (m_cursor == nullptr || address + size > reinterpret_cast<std::uintptr_t> (m_end)) {
+			m_blocks.push_back(m_blockPool.allocate());
+			m_cursor = static_cast<std::byte*> (m_blocks.back());
+			m_end = m_cursor + BLOCK_SIZE;
+			address = reinterpret_cast<std::uintptr_t> (m_cursor);
+		}
+		auto* const memory {reinterpret_cast<std::byte*> (address)};
+		m_cursor = memory + size;
+		return memory;
+	}
+
+	auto CommandBuffer::append(Node& node) noexcept -> void {
+		if (m_tail == nullptr)
+			m_head = &node;
+		else
+			m_tail->next = &node;
+		m_tail = &node;
+		++m_commandCount;
+	}
+
+	auto CommandBuffer::release() noexcept -> void {
+		for (void* const block : m_blocks)
+			m_blockPool.deallocate(block);
+		m_blocks.clear();
+		m_cursor = nullptr;
+		m_end = nullptr;
+		m_head = nullptr;
+		m_tail = nullptr;
+		m_commandCount = 0uz;
+	}
+}
@@ -0,0 +1,35 @@
+#include "voxlet/ecs/component.hpp"
+
+#include <cassert>
+#include <deque>
+#include <mutex>
+
+
+namespace vx::ecs {
+	namespace {
+		struct ComponentRegistry {
+			std::mutex mutex {};
+			std::deque<ComponentInfos> components {};
+		};
+
+		auto getComponentRegistry() noexcept -> ComponentRegistry& {
+			static ComponentRegistry registry {};
+			return registry;
+		}
+	}
+
+
+	auto registerComponent(const ComponentInfos& infos) noexcept -> ComponentId {
+		ComponentRegistry& registry {getComponentRegistry()};
+		std::scoped_lock _ {registry.mutex};
+		registry.components.push_back(infos);
+		return static_cast<ComponentId> (registry.components.size() - 1uz);
+	}
+
+	auto getComponentInfos(const ComponentId id) noexcept -> ComponentInfos {
+		ComponentRegistry& registry {getComponentRegistry()};
+		std::scoped_lock _ {registry.mutex};
+		assert(id < registry.components.size());
+		return registry.components[id];
+	}
+}
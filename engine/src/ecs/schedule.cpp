@@ -0,0 +1,60 @@
+#include "voxlet/ecs/schedule.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <string_view>
+
+
+namespace vx::ecs {
+	Schedule::Schedule(World& world) noexcept :
+		m_world {&world},
+		m_graph {},
+		m_worldResource {m_graph.getResource(vx::StringSlice::from(u8"ecs.world"))},
+		m_componentResources {},
+		m_commandBuffers {},
+		m_scheduler {nullptr}
+	{}
+
+	Schedule::~Schedule() = default;
+
+
+	auto Schedule::removeSystem(const vx::StringSlice& name) noexcept -> bool {
+		return m_graph.removeStage(name);
+	}
+
+	auto Schedule::run(vx::jobs::Scheduler& scheduler) noexcept -> void {
+		m_scheduler = &scheduler;
+		while (m_commandBuffers.size() < scheduler.getThreadCount())
+			m_commandBuffers.push_back(std::make_unique<CommandBuffer> ());
+		m_graph.execute(scheduler);
+		this->flushCommands();
+		m_scheduler = nullptr;
+	}
+
+
+	auto Schedule::getComponentResource(const ComponentId id) noexcept -> vx::jobs::FrameGraph::Resource {
+		if (const auto it {m_componentResources.find(id)}; it != m_componentResources.end())
+			return it->second;
+
+		constexpr std::u8string_view PREFIX {u8"ecs.component."};
+		std::array<char, PREFIX.size() + 16uz> name {};
+		std::ranges::copy(PREFIX, name.begin());
+		const auto result {std::to_chars(name.data() + PREFIX.size(), name.data() + name.size(), id)};
+		const vx::jobs::FrameGraph::Resource resource {m_graph.getResource(vx::StringSlice::from(
+			reinterpret_cast<const char8_t*> (name.data()),
+			static_cast<std::size_t> (result.ptr - name.data())
+		))};
+		m_componentResources.emplace(id, resource);
+		return resource;
+	}
+
+	auto Schedule::getCommandBuffer() noexcept -> CommandBuffer& {
+		return *m_commandBuffers[m_scheduler->getCurrentThreadIndex()];
+	}
+
+	auto Schedule::flushCommands() noexcept -> void {
+		for (const auto& commandBuffer : m_commandBuffers)
+			commandBuffer->apply(*m_world);
+	}
+}
@@ -0,0 +1,168 @@
+#include "voxlet/ecs/world.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+
+
+namespace vx::ecs {
+	World::World() noexcept :
+		m_chunkPool {Archetype::CHUNK_SIZE},
+		m_entities {},
+		m_freeEntities {},
+		m_entityCount {0uz},
+		m_archetypes {},
+		m_archetypeLookup {},
+		m_emptyArchetype {nullptr},
+		m_tick {0u},
+		m_addObservers {},
+		m_removeObservers {},
+		m_nextObserverId {0u}
+	{
+		m_emptyArchetype = &this->getOrCreateArchetype({});
+	}
+
+	World::~World() = default;
+
+
+	auto World::despawn(const Entity entity) noexcept -> bool {
+		const EntityRecord* const current {this->getRecord(entity)};
+		if (current == nullptr)
+			return false;
+		/* archetypes are never destroyed, so the signature outlives any change made by the observers */
+		for (const ComponentId id : current->archetype->getSignature())
+			this->notify(m_removeObservers, id, entity);
+
+		EntityRecord& record {m_entities[entity.index]};
+		const Entity moved {record.archetype->removeRow(record.location)};
+		if (moved.isValid())
+			m_entities[moved.index].location = record.location;
+		record.archetype = nullptr;
+		++record.generation;
+		m_freeEntities.push_back(entity.index);
+		--m_entityCount;
+		return true;
+	}
+
+	auto World::isAlive(const Entity entity) const noexcept -> bool {
+		return this->getRecord(entity) != nullptr;
+	}
+
+
+	auto World::removeObserver(const ObserverId id) noexcept -> bool {
+		for (ObserverList* const observers : {&m_addObservers, &m_removeObservers}) {
+			for (std::vector<ObserverRecord>& list : *observers) {
+				const auto it {std::ranges::find(list, id, &ObserverRecord::id)};
+				if (it == list.end())
+					continue;
+				list.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	auto World::createEntity(Archetype& archetype) noexcept -> Entity {
+		Entity entity {};
+		if (m_freeEntities.empty()) {
+			entity.index = static_cast<std::uint32_t> (m_entities.size());
+			m_entities.push_back(EntityRecord{0u, nullptr, {}});
+		}
+		else {
+			entity.index = m_freeEntities.back();
+			m_freeEntities.pop_back();
+		}
+		EntityRecord& record {m_entities[entity.index]};
+		entity.generation = record.generation;
+		record.archetype = &archetype;
+		record.location = archetype.allocateRow(entity);
+		++m_entityCount;
+		return entity;
+	}
+
+	auto World::findArchetypeWith(Archetype& archetype, const ComponentId id) noexcept -> Archetype& {
+		if (archetype.has(id))
+			return archetype;
+		if (Archetype* const cached {archetype.findAddEdge(id)}; cached != nullptr)
+			return *cached;
+
+		std::vector<ComponentId> signature {archetype.getSignature().begin(), archetype.getSignature().end()};
+		signature.insert(std::ranges::upper_bound(signature, id), id);
+		Archetype& destination {this->getOrCreateArchetype(std::move(signature))};
+		archetype.setAddEdge(id, destination);
+		destination.setRemoveEdge(id, archetype);
+		return destination;
+	}
+
+	auto World::findArchetypeWithout(Archetype& archetype, const ComponentId id) noexcept -> Archetype& {
+		if (!archetype.has(id))
+			return archetype;
+		if (Archetype* const cached {archetype.findRemoveEdge(id)}; cached != nullptr)
+			return *cached;
+
+		std::vector<ComponentId> signature {archetype.getSignature().begin(), archetype.getSignature().end()};
+		signature.erase(std::ranges::find(signature, id));
+		Archetype& destination {this->getOrCreateArchetype(std::move(signature))};
+		archetype.setRemoveEdge(id, destination);
+		destination.setAddEdge(id, archetype);
+		return destination;
+	}
+
+	auto World::getOrCreateArchetype(std::vector<ComponentId>&& signature) noexcept -> Archetype& {
+		if (const auto it {m_archetypeLookup.find(signature)}; it != m_archetypeLookup.end())
+			return *it->second;
+		auto archetype {std::make_unique<Archetype> (std::vector<ComponentId> {signature}, m_chunkPool)};
+		Archetype& result {*archetype};
+		m_archetypeLookup.emplace(std::move(signature), &result);
+		m_archetypes.push_back(std::move(archetype));
+		return result;
+	}
+
+	auto World::moveEntity(const Entity entity, Archetype& destination) noexcept -> void {
+		EntityRecord& record {m_entities[entity.index]};
+		assert(record.archetype != &destination);
+		Archetype::Location destinationLocation {};
+		const Entity moved {record.archetype->moveRow(record.location, destination, destinationLocation)};
+		if (moved.isValid())
+			m_entities[moved.index].location = record.location;
+		record.archetype = &destination;
+		record.location = destinationLocation;
+	}
+
+	auto World::findComponent(const Entity entity, const ComponentId id) const noexcept -> std::byte* {
+		const EntityRecord* const record {this->getRecord(entity)};
+		if (record == nullptr)
+			return nullptr;
+		const std::size_t column {record->archetype->findColumn(id)};
+		if (column == Archetype::npos)
+			return nullptr;
+		return record->archetype->getComponent(record->location, column);
+	}
+
+	auto World::touchComponent(const Entity entity, const ComponentId id) noexcept -> std::byte* {
+		const EntityRecord* const record {this->getRecord(entity)};
+		if (record == nullptr)
+			return nullptr;
+		const std::size_t column {record->archetype->findColumn(id)};
+		if (column == Archetype::npos)
+			return nullptr;
+		record->archetype->markChanged(record->location, column, this->getWriteTick());
+		return record->archetype->getComponent(record->location, column);
+	}
+
+	auto World::addObserver(ObserverList& observers, const ComponentId id, Observer&& observer) noexcept -> ObserverId {
+		if (id >= observers.size())
+			observers.resize(id + 1uz);
+		const ObserverId observerId {m_nextObserverId++};
+		observers[id].push_back(ObserverRecord{observerId, std::move(observer)});
+		return observerId;
+	}
+
+	auto World::notify(const ObserverList& observers, const ComponentId id, const Entity entity) noexcept -> void {
+		if (id >= observers.size())
+			return;
+		for (const ObserverRecord& observer : observers[id])
+			observer.callback(*this, entity);
+	}
+}
@@ -0,0 +1,592 @@
+#include "voxlet/image/png.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <immintrin.h>
+
+#include "voxlet/compression/deflate.hpp"
+#include "voxlet/jobs/parallelFor.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::image {
+	namespace {
+		constexpr std::array<std::uint8_t, 8uz> SIGNATURE {137u, 80u, 78u, 71u, 13u, 10u, 26u, 10u};
+		/* 16384x16384, what's left is more likely a corrupted header than a texture */
+		constexpr std::uint64_t MAX_PIXEL_COUNT {1ull << 28u};
+		constexpr std::uint32_t OPAQUE {0xff00'0000u};
+
+		enum class Filter : std::uint8_t {
+			none,
+			sub,
+			up,
+			average,
+			paeth
+		};
+
+		struct Png {
+			PngInfo info;
+			std::uint32_t channelCount;
+			/* the distance between a byte and the same one of the previous pixel, as the filters see it */
+			std::size_t filterStride;
+			/* without the filter byte */
+			std::size_t rowSize;
+			/* alpha comes from `tRNS`, entries past the palette are opaque black */
+			vx::render::Palette palette;
+			bool hasColorKey;
+			std::array<std::uint16_t, 3uz> colorKey;
+			std::vector<std::span<const std::byte>> dataChunks;
+		};
+
+		auto read32(const std::byte* const data) noexcept -> std::uint32_t {
+			return (static_cast<std::uint32_t> (data[0]) << 24u)
+				| (static_cast<std::uint32_t> (data[1]) << 16u)
+				| (static_cast<std::uint32_t> (data[2]) << 8u)
+				| static_cast<std::uint32_t> (data[3]);
+		}
+
+		auto read16(const std::byte* const data) noexcept -> std::uint16_t {
+			return static_cast<std::uint16_t> ((static_cast<std::uint32_t> (data[0]) << 8u) | static_cast<std::uint32_t> (data[1]));
+		}
+
+		auto isChunk(const std::byte* const type, const char (&name)[5]) noexcept -> bool {
+			return std::memcmp(type, name, 4uz) == 0;
+		}
+
+		/* the CRC follows the data and covers it along with the type */
+		auto hasValidCrc(const std::byte* const chunk, const std::uint32_t size) noexcept -> bool {
+			return vx::compression::crc32({chunk + 4, size + 4uz}) == read32(chunk + 8 + size);
+		}
+
+		auto isValidDepth(const PngColorType colorType, const std::uint8_t bitDepth) noexcept -> bool {
+			switch (colorType) {
+				case PngColorType::gray:
+					return bitDepth == 1u || bitDepth == 2u || bitDepth == 4u || bitDepth == 8u || bitDepth == 16u;
+				case PngColorType::indexed:
+					return bitDepth == 1u || bitDepth == 2u || bitDepth == 4u || bitDepth == 8u;
+				case PngColorType::rgb:
+				case PngColorType::grayAlpha:
+				case PngColorType::rgba:
+					return bitDepth == 8u || bitDepth == 16u;
+			}
+			return false;
+		}
+
+		auto getChannelCount(const PngColorType colorType) noexcept -> std::uint32_t {
+			switch (colorType) {
+				case PngColorType::gray:
+				case PngColorType::indexed:
+					return 1u;
+				case PngColorType::grayAlpha:
+					return 2u;
+				case PngColorType::rgb:
+					return 3u;
+				case PngColorType::rgba:
+					return 4u;
+			}
+			return 0u;
+		}
+
+		auto readHeader(const std::span<const std::byte> file) noexcept -> std::optional<PngInfo> {
+			if (file.size() < SIGNATURE.size() + 12uz + 13uz || std::memcmp(file.data(), SIGNATURE.data(), SIGNATURE.size()) != 0)
+				return std::nullopt;
+			const std::byte* const chunk {file.data() + SIGNATURE.size()};
+			if (read32(chunk) != 13u || !isChunk(chunk + 4, "IHDR") || !hasValidCrc(chunk, 13u))
+				return std::nullopt;
+			const std::byte* const data {chunk + 8};
+			const PngInfo info {
+				.width = read32(data),
+				.height = read32(data + 4),
+				.colorType = static_cast<PngColorType> (data[9]),
+				.bitDepth = static_cast<std::uint8_t> (data[8])
+			};
+			const std::uint64_t pixelCount {static_cast<std::uint64_t> (info.width) * info.height};
+			if (info.width == 0u || info.height == 0u || pixelCount > MAX_PIXEL_COUNT)
+				return std::nullopt;
+			/* deflate, the filters of the specification, and no interlacing */
+			if (data[10] != std::byte{0} || data[11] != std::byte{0} || data[12] != std::byte{0})
+				return std::nullopt;
+			if (getChannelCount(info.colorType) == 0u || !isValidDepth(info.colorType, info.bitDepth))
+				return std::nullopt;
+			return info;
+		}
+
+		auto readChunks(const std::span<const std::byte> file) noexcept -> std::optional<Png> {
+			const std::optional<PngInfo> info {readHeader(file)};
+			if (!info)
+				return std::nullopt;
+			Png png {
+				.info = *info,
+				.channelCount = getChannelCount(info->colorType),
+				.filterStride = 0uz,
+				.rowSize = 0uz,
+				.palette = {},
+				.hasColorKey = false,
+				.colorKey = {},
+				.dataChunks = {}
+			};
+			const std::size_t bitsPerPixel {png.channelCount * info->bitDepth};
+			png.filterStride = std::max(1uz, bitsPerPixel / 8uz);
+			png.rowSize = (static_cast<std::size_t> (info->width) * bitsPerPixel + 7uz) / 8uz;
+			png.palette.fill(OPAQUE);
+
+			bool hasPalette {false};
+			bool hasEnd {false};
+			std::size_t offset {SIGNATURE.size()};
+			while (!hasEnd && file.size() - offset >= 12uz) {
+				const std::uint32_t size {read32(file.data() + offset)};
+				const std::byte* const chunk {file.data() + offset};
+				const std::byte* const type {chunk + 4};
+				if (size > file.size() - offset - 12uz)
+					return std::nullopt;
+				const std::span<const std::byte> data {file.subspan(offset + 8uz, size)};
+				offset += 12uz + size;
+
+				/* `readHeader` checked the header, the ancillary chunks skipped aren't worth a pass over their bytes */
+				if (isChunk(type, "IHDR"))
+					continue;
+				const bool isCritical {(static_cast<std::uint8_t> (type[0]) & 0x20u) == 0u};
+				if ((isCritical || isChunk(type, "tRNS")) && !hasValidCrc(chunk, size))
+					return std::nullopt;
+				if (isChunk(type, "IDAT"))
+					png.dataChunks.push_back(data);
+				else if (isChunk(type, "PLTE")) {
+					if (size % 3u != 0u || size / 3u > png.palette.size())
+						return std::nullopt;
+					for (std::size_t i {0uz}; i < size / 3u; ++i) {
+						png.palette[i] = OPAQUE
+							| static_cast<std::uint32_t> (data[i * 3uz])
+							| (static_cast<std::uint32_t> (data[i * 3uz + 1uz]) << 8u)
+							| (static_cast<std::uint32_t> (data[i * 3uz + 2uz]) << 16u);
+					}
+					hasPalette = true;
+				}
+				else if (isChunk(type, "tRNS")) {
+					if (info->colorType == PngColorType::indexed) {
+						if (size > png.palette.size())
+							return std::nullopt;
+						for (std::size_t i {0uz}; i < size; ++i)
+							png.palette[i] = (png.palette[i] & ~OPAQUE) | (static_cast<std::uint32_t> (data[i]) << 24u);
+					}
+					else if (info->colorType == PngColorType::gray || info->colorType == PngColorType::rgb) {
+						if (size != png.channelCount * 2u)
+							return std::nullopt;
+						for (std::size_t i {0uz}; i < png.channelCount; ++i)
+							png.colorKey[i] = read16(data.data() + i * 2uz);
+						png.hasColorKey = true;
+					}
+				}
+				else if (isChunk(type, "IEND"))
+					hasEnd = true;
+				/* an unknown critical chunk changes how the image reads, the ancillary ones can be skipped */
+				else if (isCritical)
+					return std::nullopt;
+			}
+			if (!hasEnd || png.dataChunks.empty() || (info->colorType == PngColorType::indexed && !hasPalette))
+				return std::nullopt;
+			return png;
+		}
+
+		/* the zlib stream, joined in `storage` when it's split over several chunks */
+		auto getImageData(const Png& png, std::vector<std::byte>& storage) -> std::span<const std::byte> {
+			if (png.dataChunks.size() == 1uz)
+				return png.dataChunks[0];
+			for (const std::span<const std::byte> chunk : png.dataChunks)
+				storage.insert(storage.end(), chunk.begin(), chunk.end());
+			return storage;
+		}
+
+
+		template <std::size_t STRIDE>
+		[[gnu::always_inline]]
+		inline auto loadPixel(const std::uint8_t* const data) noexcept -> __m128i {
+			std::uint32_t value {0u};
+			(void)std::memcpy(&value, data, STRIDE);
+			return _mm_cvtsi32_si128(static_cast<int> (value));
+		}
+
+		template <std::size_t STRIDE>
+		[[gnu::always_inline]]
+		inline auto storePixel(std::uint8_t* const data, const __m128i pixel) noexcept -> void {
+			const auto value {static_cast<std::uint32_t> (_mm_cvtsi128_si32(pixel))};
+			(void)std::memcpy(data, &value, STRIDE);
+		}
+
+		/* each pixel depends on the one before it, so the channels of one pixel are what's done at once */
+		template <std::size_t STRIDE>
+		auto unfilterSub(std::uint8_t* const row, const std::size_t size) noexcept -> void {
+			__m128i left {_mm_setzero_si128()};
+			for (std::size_t i {0uz}; i < size; i += STRIDE) {
+				left = _mm_add_epi8(loadPixel<STRIDE> (row + i), left);
+				storePixel<STRIDE> (row + i, left);
+			}
+		}
+
+		template <std::size_t STRIDE>
+		auto unfilterAverage(std::uint8_t* const row, const std::uint8_t* const previous, const std::size_t size) noexcept -> void {
+			const __m128i ones {_mm_set1_epi8(1)};
+			__m128i left {_mm_setzero_si128()};
+			for (std::size_t i {0uz}; i < size; i += STRIDE) {
+				const __m128i up {loadPixel<STRIDE> (previous + i)};
+				/* `avg_epu8` rounds up where the filter rounds down */
+				const __m128i average {_mm_sub_epi8(_mm_avg_epu8(left, up), _mm_and_si128(_mm_xor_si128(left, up), ones))};
+				left = _mm_add_epi8(loadPixel<STRIDE> (row + i), average);
+				storePixel<STRIDE> (row + i, left);
+			}
+		}
+
+		/*
+		 * With the prediction `p = a + b - c`, the distances to the left, up and upper left bytes are `|b - c|`,
+		 * `|a - c|` and `|a + b - 2c|`, computed on 16 bits. Ties favor the left byte, then the upper one.
+		 */
+		template <std::size_t STRIDE>
+		auto unfilterPaeth(std::uint8_t* const row, const std::uint8_t* const previous, const std::size_t size) noexcept -> void {
+			const __m128i zero {_mm_setzero_si128()};
+			__m128i left {zero};
+			__m128i upperLeft {zero};
+			for (std::size_t i {0uz}; i < size; i += STRIDE) {
+				const __m128i up {_mm_unpacklo_epi8(loadPixel<STRIDE> (previous + i), zero)};
+				const __m128i upMinusUpperLeft {_mm_sub_epi16(up, upperLeft)};
+				const __m128i leftMinusUpperLeft {_mm_sub_epi16(left, upperLeft)};
+				const __m128i leftDistance {_mm_abs_epi16(upMinusUpperLeft)};
+				const __m128i upDistance {_mm_abs_epi16(leftMinusUpperLeft)};
+				const __m128i upperLeftDistance {_mm_abs_epi16(_mm_add_epi16(upMinusUpperLeft, leftMinusUpperLeft))};
+				const __m128i smallest {_mm_min_epi16(upperLeftDistance, _mm_min_epi16(leftDistance, upDistance))};
+				__m128i predictor {_mm_blendv_epi8(upperLeft, up, _mm_cmpeq_epi16(upDistance, smallest))};
+				predictor = _mm_blendv_epi8(predictor, left, _mm_cmpeq_epi16(leftDistance, smallest));
+
+				const __m128i pixel {_mm_add_epi8(loadPixel<STRIDE> (row + i), _mm_packus_epi16(predictor, predictor))};
+				storePixel<STRIDE> (row + i, pixel);
+				left = _mm_unpacklo_epi8(pixel, zero);
+				upperLeft = up;
+			}
+		}
+
+		auto paethPredictor(const std::int32_t left, const std::int32_t up, const std::int32_t upperLeft) noexcept -> std::int32_t {
+			const std::int32_t leftDistance {std::abs(up - upperLeft)};
+			const std::int32_t upDistance {std::abs(left - upperLeft)};
+			const std::int32_t upperLeftDistance {std::abs(left + up - 2 * upperLeft)};
+			if (leftDistance <= upDistance && leftDistance <= upperLeftDistance)
+				return left;
+			return upDistance <= upperLeftDistance ? up : upperLeft;
+		}
+
+		/* 1, 2, 6 and 8 bytes pixels */
+		auto unfilterScalar(
+			const Filter filter,
+			std::uint8_t* const row,
+			const std::uint8_t* const previous,
+			const std::size_t size,
+			const std::size_t stride
+		) noexcept -> void {
+			const auto left {[row, stride](const std::size_t i) noexcept -> std::int32_t {return i >= stride ? row[i - stride] : 0;}};
+			const auto upperLeft {[previous, stride](const std::size_t i) noexcept -> std::int32_t {
+				return i >= stride ? previous[i - stride] : 0;
+			}};
+			for (std::size_t i {0uz}; i < size; ++i) {
+				std::int32_t predictor {0};
+				if (filter == Filter::sub)
+					predictor = left(i);
+				else if (filter == Filter::average)
+					predictor = (left(i) + previous[i]) / 2;
+				else if (filter == Filter::paeth)
+					predictor = paethPredictor(left(i), previous[i], upperLeft(i));
+				row[i] = static_cast<std::uint8_t> (row[i] + predictor);
+			}
+		}
+
+		auto unfilterUp(std::uint8_t* const row, const std::uint8_t* const previous, const std::size_t size) noexcept -> void {
+			std::size_t i {0uz};
+			for (; i + 32uz <= size; i += 32uz) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*> (row + i), _mm256_add_epi8(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*> (row + i)),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i*> (previous + i))
+				));
+			}
+			for (; i < size; ++i)
+				row[i] = static_cast<std::uint8_t> (row[i] + previous[i]);
+		}
+
+		/* `previous` is only read by `up`, `average` and `paeth`, it's a row of zeros above the first one */
+		auto unfilterRow(
+			const Png& png,
+			const Filter filter,
+			std::uint8_t* const row,
+			const std::uint8_t* const previous
+		) noexcept -> void {
+			const std::size_t size {png.rowSize};
+			if (filter == Filter::none)
+				return;
+			if (filter == Filter::up) {
+				unfilterUp(row, previous, size);
+				return;
+			}
+			if (png.filterStride == 4uz) {
+				if (filter == Filter::sub)
+					unfilterSub<4uz> (row, size);
+				else if (filter == Filter::average)
+					unfilterAverage<4uz> (row, previous, size);
+				else
+					unfilterPaeth<4uz> (row, previous, size);
+			}
+			else if (png.filterStride == 3uz) {
+				if (filter == Filter::sub)
+					unfilterSub<3uz> (row, size);
+				else if (filter == Filter::average)
+					unfilterAverage<3uz> (row, previous, size);
+				else
+					unfilterPaeth<3uz> (row, previous, size);
+			}
+			else
+				unfilterScalar(filter, row, previous, size, png.filterStride);
+		}
+
+
+		auto expandRgb(const std::uint8_t* const source, std::uint32_t* const destination, const std::size_t width) noexcept -> void {
+			const __m256i shuffle {_mm256_setr_epi8(
+				0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+				0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1
+			)};
+			const __m256i alpha {_mm256_set1_epi32(static_cast<int> (OPAQUE))};
+			std::size_t x {0uz};
+			/* each half loads 16 bytes for 12, which the 10 pixels left cover */
+			for (; x + 10uz <= width; x += 8uz) {
+				const __m256i pixels {_mm256_inserti128_si256(
+					_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*> (source + x * 3uz))),
+					_mm_loadu_si128(reinterpret_cast<const __m128i*> (source + x * 3uz + 12uz)),
+					1
+				)};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*> (destination + x), _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha));
+			}
+			for (; x < width; ++x) {
+				destination[x] = OPAQUE
+					| static_cast<std::uint32_t> (source[x * 3uz])
+					| (static_cast<std::uint32_t> (source[x * 3uz + 1uz]) << 8u)
+					| (static_cast<std::uint32_t> (source[x * 3uz + 2uz]) << 16u);
+			}
+		}
+
+		auto expandGray(const std::uint8_t* const source, std::uint32_t* const destination, const std::size_t width) noexcept -> void {
+			const __m256i shuffle {_mm256_setr_epi8(
+				0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1,
+				4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1
+			)};
+			const __m256i alpha {_mm256_set1_epi32(static_cast<int> (OPAQUE))};
+			std::size_t x {0uz};
+			for (; x + 8uz <= width; x += 8uz) {
+				const __m256i grays {_mm256_broadcastq_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*> (source + x)))};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*> (destination + x), _mm256_or_si256(_mm256_shuffle_epi8(grays, shuffle), alpha));
+			}
+			for (; x < width; ++x)
+				destination[x] = OPAQUE | (static_cast<std::uint32_t> (source[x]) * 0x01'0101u);
+		}
+
+		auto expandGrayAlpha(const std::uint8_t* const source, std::uint32_t* const destination, const std::size_t width) noexcept
+			-> void
+		{
+			const __m256i shuffle {_mm256_setr_epi8(
+				0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7,
+				8, 8, 8, 9, 10, 10, 10, 11, 12, 12, 12, 13, 14, 14, 14, 15
+			)};
+			std::size_t x {0uz};
+			for (; x + 8uz <= width; x += 8uz) {
+				const __m256i pixels {_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*> (source + x * 2uz)))};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*> (destination + x), _mm256_shuffle_epi8(pixels, shuffle));
+			}
+			for (; x < width; ++x) {
+				destination[x] = (static_cast<std::uint32_t> (source[x * 2uz]) * 0x01'0101u)
+					| (static_cast<std::uint32_t> (source[x * 2uz + 1uz]) << 24u);
+			}
+		}
+
+		auto expandPalette(
+			const std::uint8_t* const indices,
+			std::uint32_t* const destination,
+			const std::size_t width,
+			const vx::render::Palette& palette
+		) noexcept -> void {
+			const auto* const colors {reinterpret_cast<const int*> (palette.data())};
+			std::size_t x {0uz};
+			for (; x + 8uz <= width; x += 8uz) {
+				const __m256i offsets {_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*> (indices + x)))};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*> (destination + x), _mm256_i32gather_epi32(colors, offsets, 4));
+			}
+			for (; x < width; ++x)
+				destination[x] = palette[indices[x]];
+		}
+
+		/* one byte per sample, scaled to 8 bits for gray */
+		auto unpackSamples(
+			const std::uint8_t* const source,
+			std::uint8_t* const destination,
+			const std::size_t count,
+			const std::uint32_t bitDepth,
+			const bool scale
+		) noexcept -> void {
+			const std::uint32_t mask {(1u << bitDepth) - 1u};
+			const std::uint32_t factor {scale ? 255u / mask : 1u};
+			for (std::size_t i {0uz}; i < count; ++i) {
+				const std::size_t bit {i * bitDepth};
+				const std::uint32_t shift {8u - bitDepth - static_cast<std::uint32_t> (bit % 8uz)};
+				destination[i] = static_cast<std::uint8_t> (((source[bit / 8uz] >> shift) & mask) * factor);
+			}
+		}
+
+		/* keeps the high byte of each big-endian sample */
+		auto narrowSamples(const std::uint8_t* const source, std::uint8_t* const destination, const std::size_t count) noexcept
+			-> void
+		{
+			for (std::size_t i {0uz}; i < count; ++i)
+				destination[i] = source[i * 2uz];
+		}
+
+		auto getSample(const std::uint8_t* const row, const std::size_t index, const std::uint32_t bitDepth) noexcept
+			-> std::uint16_t
+		{
+			if (bitDepth == 16u)
+				return static_cast<std::uint16_t> ((row[index * 2uz] << 8u) | row[index * 2uz + 1uz]);
+			const std::size_t bit {index * bitDepth};
+			const std::uint32_t shift {8u - bitDepth - static_cast<std::uint32_t> (bit % 8uz)};
+			return static_cast<std::uint16_t> ((row[bit / 8uz] >> shift) & ((1u << bitDepth) - 1u));
+		}
+
+		/* `scratch` holds at least `width * 4` bytes */
+		auto convertRow(const Png& png, const std::uint8_t* const row, std::uint32_t* const destination, std::uint8_t* const scratch)
+			noexcept
+			-> void
+		{
+			const std::size_t width {png.info.width};
+			const std::uint32_t bitDepth {png.info.bitDepth};
+			const std::size_t sampleCount {width * png.channelCount};
+			const std::uint8_t* samples {row};
+			if (bitDepth == 16u) {
+				narrowSamples(row, scratch, sampleCount);
+				samples = scratch;
+			}
+			else if (bitDepth < 8u) {
+				unpackSamples(row, scratch, sampleCount, bitDepth, png.info.colorType == PngColorType::gray);
+				samples = scratch;
+			}
+
+			switch (png.info.colorType) {
+				case PngColorType::gray:
+					expandGray(samples, destination, width);
+					break;
+				case PngColorType::grayAlpha:
+					expandGrayAlpha(samples, destination, width);
+					break;
+				case PngColorType::rgb:
+					expandRgb(samples, destination, width);
+					break;
+				case PngColorType::rgba:
+					vx::memory::memcpy(reinterpret_cast<std::uint8_t*> (destination), samples, sampleCount);
+					break;
+				case PngColorType::indexed:
+					expandPalette(samples, destination, width, png.palette);
+					break;
+			}
+
+			/* compares the samples before they're narrowed down to 8 bits */
+			if (!png.hasColorKey)
+				return;
+			for (std::size_t x {0uz}; x < width; ++x) {
+				bool isKey {true};
+				for (std::size_t channel {0uz}; channel < png.channelCount; ++channel)
+					isKey = isKey && getSample(row, x * png.channelCount + channel, bitDepth) == png.colorKey[channel];
+				if (isKey)
+					destination[x] &= ~OPAQUE;
+			}
+		}
+	}
+
+
+	auto readPngInfo(const std::span<const std::byte> file) noexcept -> std::optional<PngInfo> {
+		return readHeader(file);
+	}
+
+	auto decodePng(const std::span<const std::byte> file, const std::span<std::uint32_t> pixels) noexcept -> bool {
+		const std::optional<Png> png {readChunks(file)};
+		if (!png || pixels.size() != static_cast<std::size_t> (png->info.width) * png->info.height)
+			return false;
+		std::vector<std::byte> joined {};
+		vx::compression::Inflater inflater {getImageData(*png, joined), vx::compression::DeflateFormat::zlib};
+
+		/* the filter byte and the row, for the current row and the one above it, zeros above the first */
+		const std::size_t stride {png->rowSize + 1uz};
+		std::vector<std::uint8_t> rows (stride * 2uz, 0u);
+		std::uint8_t* current {rows.data()};
+		std::uint8_t* previous {rows.data() + stride};
+		std::vector<std::uint8_t> scratch (static_cast<std::size_t> (png->info.width) * 4uz);
+		for (std::uint32_t y {0u}; y < png->info.height; ++y) {
+			if (inflater.read(std::as_writable_bytes(std::span{current, stride})) != stride || current[0] > std::to_underlying(Filter::paeth))
+				return false;
+			unfilterRow(*png, static_cast<Filter> (current[0]), current + 1, previous + 1);
+			convertRow(*png, current + 1, pixels.data() + static_cast<std::size_t> (y) * png->info.width, scratch.data());
+			std::swap(current, previous);
+		}
+		/* reading past the image checks the end of the stream and its checksum */
+		std::byte extra;
+		return inflater.read({&extra, 1uz}) == 0uz && inflater.isDone();
+	}
+
+	auto decodePng(
+		const std::span<const std::byte> file,
+		const std::span<std::uint32_t> pixels,
+		vx::jobs::Scheduler& scheduler
+	) noexcept -> bool {
+		const std::optional<Png> png {readChunks(file)};
+		if (!png || pixels.size() != static_cast<std::size_t> (png->info.width) * png->info.height)
+			return false;
+		std::vector<std::byte> joined {};
+		const std::size_t stride {png->rowSize + 1uz};
+		const std::size_t height {png->info.height};
+		std::vector<std::uint8_t> data (stride * height);
+		const std::optional<std::size_t> size {vx::compression::inflate(
+			getImageData(*png, joined),
+			std::as_writable_bytes(std::span{data}),
+			vx::compression::DeflateFormat::zlib
+		)};
+		if (size != data.size())
+			return false;
+
+		/* the rows that don't read the one above them start a run of their own */
+		std::vector<std::uint32_t> runStarts {};
+		for (std::size_t y {0uz}; y < height; ++y) {
+			const std::uint8_t filter {data[y * stride]};
+			if (filter > std::to_underlying(Filter::paeth))
+				return false;
+			if (y == 0uz || filter == std::to_underlying(Filter::none) || filter == std::to_underlying(Filter::sub))
+				runStarts.push_back(static_cast<std::uint32_t> (y));
+		}
+
+		const std::vector<std::uint8_t> zeros (png->rowSize, 0u);
+		vx::jobs::parallelFor(scheduler, 0uz, runStarts.size(), [&](const std::size_t first, const std::size_t last) noexcept {
+			std::vector<std::uint8_t> scratch (static_cast<std::size_t> (png->info.width) * 4uz);
+			for (std::size_t run {first}; run < last; ++run) {
+				const std::size_t end {run + 1uz < runStarts.size() ? runStarts[run + 1uz] : height};
+				for (std::size_t y {runStarts[run]}; y < end; ++y) {
+					std::uint8_t* const row {data.data() + y * stride};
+					const std::uint8_t* const previous {y == 0uz ? zeros.data() : row - stride + 1};
+					unfilterRow(*png, static_cast<Filter> (row[0]), row + 1, previous);
+					convertRow(*png, row + 1, pixels.data() + y * png->info.width, scratch.data());
+				}
+			}
+		});
+		return true;
+	}
+
+	auto decodePng(const std::span<const std::byte> file) noexcept -> std::optional<vx::render::Image> {
+		const std::optional<PngInfo> info {readPngInfo(file)};
+		if (!info)
+			return std::nullopt;
+		vx::render::Image image {info->width, info->height};
+		if (!decodePng(file, image.getPixels()))
+			return std::nullopt;
+		return image;
+	}
+}
@@ -0,0 +1,392 @@
+#include "voxlet/image/qoi.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#include <immintrin.h>
+
+#include "voxlet/jobs/parallelFor.hpp"
+
+
+namespace vx::image {
+	namespace {
+		constexpr std::array<std::uint8_t, 4uz> MAGIC {'V', 'X', 'Q', 'I'};
+		constexpr std::size_t HEADER_SIZE {16uz};
+		/* 16384x16384, what's left is more likely a corrupted header than a texture */
+		constexpr std::uint64_t MAX_PIXEL_COUNT {1ull << 28u};
+		/* enough bands for the workers on a small texture, few enough that restarting costs nothing */
+		constexpr std::uint32_t BAND_PIXEL_COUNT {1u << 16u};
+		/* the longest operation, a literal RGBA pixel */
+		constexpr std::size_t MAX_OPERATION_SIZE {5uz};
+		/* what every band starts from, the previous pixel of its first one */
+		constexpr std::uint32_t START_PIXEL {0xff00'0000u};
+
+		constexpr std::uint8_t OP_INDEX {0x00u};
+		constexpr std::uint8_t OP_DIFF {0x40u};
+		constexpr std::uint8_t OP_LUMA {0x80u};
+		constexpr std::uint8_t OP_RUN {0xc0u};
+		constexpr std::uint8_t OP_RGB {0xfeu};
+		constexpr std::uint8_t OP_RGBA {0xffu};
+		constexpr std::uint8_t OP_MASK {0xc0u};
+		/* 63 and 64 would collide with `OP_RGB` and `OP_RGBA` */
+		constexpr std::size_t MAX_RUN {62uz};
+
+		struct Qoi {
+			QoiInfo info;
+			std::vector<std::span<const std::byte>> bands;
+		};
+
+		using Index = std::array<std::uint32_t, 64uz>;
+
+		auto read32(const std::byte* const data) noexcept -> std::uint32_t {
+			std::uint32_t value;
+			(void)std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		auto write32(std::byte* const data, const std::uint32_t value) noexcept -> void {
+			(void)std::memcpy(data, &value, sizeof(value));
+		}
+
+		/*
+		 * `(r * 3 + g * 5 + b * 7 + a * 11) % 64` in a single multiplication: red and blue are spread to bits 0
+		 * and 16, green and alpha to bits 32 and 48, so that each lands in the top byte with its factor and
+		 * the products that don't never carry into it.
+		 */
+		auto hash(const std::uint32_t pixel) noexcept -> std::size_t {
+			const std::uint64_t value {pixel};
+			const std::uint64_t spread {((value & 0xff00'ff00u) << 24u) | (value & 0x00ff'00ffu)};
+			return static_cast<std::size_t> ((spread * 0x0300'0700'0500'0b00u) >> 56u) & 63uz;
+		}
+
+		/* adds each byte to its own, without carrying into the next one */
+		auto addBytes(const std::uint32_t pixel, const std::uint32_t delta) noexcept -> std::uint32_t {
+			return ((pixel & 0x7f7f'7f7fu) + (delta & 0x7f7f'7f7fu)) ^ ((pixel ^ delta) & 0x8080'8080u);
+		}
+
+		auto packDelta(const std::int32_t red, const std::int32_t green, const std::int32_t blue) noexcept -> std::uint32_t {
+			return static_cast<std::uint32_t> (static_cast<std::uint8_t> (red))
+				| (static_cast<std::uint32_t> (static_cast<std::uint8_t> (green)) << 8u)
+				| (static_cast<std::uint32_t> (static_cast<std::uint8_t> (blue)) << 16u);
+		}
+
+		constexpr auto DIFF_DELTAS {[]() {
+			std::array<std::uint32_t, 64uz> deltas {};
+			for (std::uint32_t op {0u}; op < 64u; ++op) {
+				const std::uint32_t red {static_cast<std::uint8_t> (((op >> 4u) & 3u) - 2u)};
+				const std::uint32_t green {static_cast<std::uint8_t> (((op >> 2u) & 3u) - 2u)};
+				const std::uint32_t blue {static_cast<std::uint8_t> ((op & 3u) - 2u)};
+				deltas[op] = red | (green << 8u) | (blue << 16u);
+			}
+			return deltas;
+		}()};
+
+		auto getBandHeight(const std::uint32_t width, const std::uint32_t height) noexcept -> std::uint32_t {
+			return std::clamp(BAND_PIXEL_COUNT / width, 1u, height);
+		}
+
+		/* the number of pixels from the first one equal to `pixel`, compared eight at a time */
+		auto getRunLength(const std::uint32_t* const pixels, const std::size_t count, const std::uint32_t pixel) noexcept
+			-> std::size_t
+		{
+			const __m256i target {_mm256_set1_epi32(static_cast<int> (pixel))};
+			std::size_t length {0uz};
+			for (; length + 8uz <= count; length += 8uz) {
+				const __m256i block {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (pixels + length))};
+				const auto mask {static_cast<std::uint32_t> (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, target))))};
+				if (mask != 0xffu)
+					return length + static_cast<std::size_t> (std::countr_one(mask));
+			}
+			while (length < count && pixels[length] == pixel)
+				++length;
+			return length;
+		}
+
+		/* `output` has room for `MAX_OPERATION_SIZE` bytes per pixel, returns the size of the band */
+		auto encodeBand(const std::uint32_t* const pixels, const std::size_t count, std::byte* const output) noexcept -> std::size_t {
+			Index index {};
+			std::uint32_t previous {START_PIXEL};
+			auto* out {reinterpret_cast<std::uint8_t*> (output)};
+			std::size_t i {0uz};
+			while (i < count) {
+				const std::uint32_t pixel {pixels[i]};
+				if (pixel == previous) {
+					std::size_t run {getRunLength(pixels + i, count - i, pixel)};
+					i += run;
+					for (; run > MAX_RUN; run -= MAX_RUN)
+						*out++ = static_cast<std::uint8_t> (OP_RUN | (MAX_RUN - 1uz));
+					*out++ = static_cast<std::uint8_t> (OP_RUN | (run - 1uz));
+					continue;
+				}
+				const std::uint32_t before {previous};
+				previous = pixel;
+				++i;
+
+				const std::size_t slot {hash(pixel)};
+				if (index[slot] == pixel) {
+					*out++ = static_cast<std::uint8_t> (OP_INDEX | slot);
+					continue;
+				}
+				index[slot] = pixel;
+				if ((pixel ^ before) >> 24u != 0u) {
+					*out = OP_RGBA;
+					(void)std::memcpy(out + 1, &pixel, sizeof(pixel));
+					out += 5;
+					continue;
+				}
+				/* the differences wrap around, as the decoder adds them */
+				const auto red {static_cast<std::int8_t> (pixel - before)};
+				const auto green {static_cast<std::int8_t> ((pixel >> 8u) - (before >> 8u))};
+				const auto blue {static_cast<std::int8_t> ((pixel >> 16u) - (before >> 16u))};
+				const std::int32_t redGreen {red - green};
+				const std::int32_t blueGreen {blue - green};
+				if (red >= -2 && red <= 1 && green >= -2 && green <= 1 && blue >= -2 && blue <= 1)
+					*out++ = static_cast<std::uint8_t> (OP_DIFF | ((red + 2) << 4) | ((green + 2) << 2) | (blue + 2));
+				else if (green >= -32 && green <= 31 && redGreen >= -8 && redGreen <= 7 && blueGreen >= -8 && blueGreen <= 7) {
+					*out++ = static_cast<std::uint8_t> (OP_LUMA | (green + 32));
+					*out++ = static_cast<std::uint8_t> (((redGreen + 8) << 4) | (blueGreen + 8));
+				}
+				else {
+					/* the alpha lands where the next operation starts and gets written over */
+					*out = OP_RGB;
+					(void)std::memcpy(out + 1, &pixel, sizeof(pixel));
+					out += 4;
+				}
+			}
+			return static_cast<std::size_t> (reinterpret_cast<std::byte*> (out) - output);
+		}
+
+		/* decodes the operations starting before `end`, reading the longest one from there has to be safe */
+		auto decodeOperations(
+			const std::uint8_t*& in,
+			const std::uint8_t* const end,
+			std::uint32_t* const pixels,
+			const std::size_t count,
+			std::size_t& i,
+			std::uint32_t& pixel,
+			Index& index
+		) noexcept -> bool {
+			while (i < count && in < end) {
+				const std::uint8_t op {*in++};
+				if (op == OP_RGB) {
+					std::uint32_t color;
+					(void)std::memcpy(&color, in, sizeof(color));
+					pixel = (color & 0x00ff'ffffu) | (pixel & 0xff00'0000u);
+					in += 3;
+				}
+				else if (op == OP_RGBA) {
+					(void)std::memcpy(&pixel, in, sizeof(pixel));
+					in += 4;
+				}
+				else if ((op & OP_MASK) == OP_INDEX) {
+					pixel = index[op];
+					pixels[i++] = pixel;
+					continue;
+				}
+				else if ((op & OP_MASK) == OP_DIFF)
+					pixel = addBytes(pixel, DIFF_DELTAS[op & 0x3fu]);
+				else if ((op & OP_MASK) == OP_LUMA) {
+					const std::int32_t green {static_cast<std::int32_t> (op & 0x3fu) - 32};
+					const std::uint8_t second {*in++};
+					const std::int32_t red {green - 8 + static_cast<std::int32_t> (second >> 4u)};
+					const std::int32_t blue {green - 8 + static_cast<std::int32_t> (second & 0x0fu)};
+					pixel = addBytes(pixel, packDelta(red, green, blue));
+				}
+				else {
+					const std::size_t run {(op & 0x3fuz) + 1uz};
+					if (run > count - i)
+						return false;
+					std::fill_n(pixels + i, run, pixel);
+					i += run;
+					continue;
+				}
+				index[hash(pixel)] = pixel;
+				pixels[i++] = pixel;
+			}
+			return true;
+		}
+
+		/* fails unless the band is exactly `count` pixels */
+		auto decodeBand(const std::span<const std::byte> band, std::uint32_t* const pixels, const std::size_t count) noexcept -> bool {
+			Index index {};
+			std::uint32_t pixel {START_PIXEL};
+			std::size_t i {0uz};
+			const auto* in {reinterpret_cast<const std::uint8_t*> (band.data())};
+			const std::uint8_t* const end {in + band.size()};
+			/* reads whole operations without checking the end of the band until the last few bytes */
+			if (band.size() >= MAX_OPERATION_SIZE && !decodeOperations(in, end - (MAX_OPERATION_SIZE - 1uz), pixels, count, i, pixel, index))
+				return false;
+			/* which are decoded from a copy padded with zeros, an operation reading them ends past the band */
+			std::array<std::uint8_t, MAX_OPERATION_SIZE * 2uz> tail {};
+			const auto tailSize {static_cast<std::size_t> (end - in)};
+			if (tailSize > MAX_OPERATION_SIZE)
+				return false;
+			if (tailSize != 0uz)
+				(void)std::memcpy(tail.data(), in, tailSize);
+			const std::uint8_t* tailIn {tail.data()};
+			if (!decodeOperations(tailIn, tail.data() + tailSize, pixels, count, i, pixel, index))
+				return false;
+			return i == count && tailIn == tail.data() + tailSize;
+		}
+
+		auto readQoi(const std::span<const std::byte> file) noexcept -> std::optional<Qoi> {
+			if (file.size() < HEADER_SIZE || std::memcmp(file.data(), MAGIC.data(), MAGIC.size()) != 0)
+				return std::nullopt;
+			Qoi qoi {
+				.info = {
+					.width = read32(file.data() + 4),
+					.height = read32(file.data() + 8),
+					.bandHeight = read32(file.data() + 12),
+					.bandCount = 0u
+				},
+				.bands = {}
+			};
+			const std::uint64_t pixelCount {static_cast<std::uint64_t> (qoi.info.width) * qoi.info.height};
+			if (pixelCount == 0u || pixelCount > MAX_PIXEL_COUNT || qoi.info.bandHeight == 0u)
+				return std::nullopt;
+			qoi.info.bandCount = (qoi.info.height - 1u) / qoi.info.bandHeight + 1u;
+			const std::size_t tableEnd {HEADER_SIZE + qoi.info.bandCount * 4uz};
+			if (file.size() < tableEnd)
+				return std::nullopt;
+
+			qoi.bands.reserve(qoi.info.bandCount);
+			std::size_t offset {tableEnd};
+			for (std::uint32_t band {0u}; band < qoi.info.bandCount; ++band) {
+				const std::size_t size {read32(file.data() + HEADER_SIZE + band * 4uz)};
+				if (size > file.size() - offset)
+					return std::nullopt;
+				qoi.bands.push_back(file.subspan(offset, size));
+				offset += size;
+			}
+			if (offset != file.size())
+				return std::nullopt;
+			return qoi;
+		}
+
+		/* the band's pixels, the last one can be shorter */
+		auto getBandPixels(const QoiInfo& info, const std::uint32_t band) noexcept -> std::pair<std::size_t, std::size_t> {
+			const std::size_t first {static_cast<std::size_t> (band) * info.bandHeight};
+			const std::size_t rowCount {std::min<std::size_t> (info.bandHeight, info.height - first)};
+			return {first * info.width, rowCount * info.width};
+		}
+
+		auto makeInfo(const vx::render::Image& image) noexcept -> std::optional<QoiInfo> {
+			const std::uint64_t pixelCount {static_cast<std::uint64_t> (image.getWidth()) * image.getHeight()};
+			if (pixelCount == 0u || pixelCount > MAX_PIXEL_COUNT)
+				return std::nullopt;
+			const std::uint32_t bandHeight {getBandHeight(image.getWidth(), image.getHeight())};
+			return QoiInfo{
+				.width = image.getWidth(),
+				.height = image.getHeight(),
+				.bandHeight = bandHeight,
+				.bandCount = (image.getHeight() - 1u) / bandHeight + 1u
+			};
+		}
+
+		/* room for the header and every band at its largest */
+		auto makeFile(const QoiInfo& info) noexcept -> std::vector<std::byte> {
+			const std::size_t tableEnd {HEADER_SIZE + info.bandCount * 4uz};
+			std::vector<std::byte> file (tableEnd + static_cast<std::size_t> (info.width) * info.height * MAX_OPERATION_SIZE);
+			(void)std::memcpy(file.data(), MAGIC.data(), MAGIC.size());
+			write32(file.data() + 4, info.width);
+			write32(file.data() + 8, info.height);
+			write32(file.data() + 12, info.bandHeight);
+			return file;
+		}
+	}
+
+
+	auto readQoiInfo(const std::span<const std::byte> file) noexcept -> std::optional<QoiInfo> {
+		const std::optional<Qoi> qoi {readQoi(file)};
+		if (!qoi)
+			return std::nullopt;
+		return qoi->info;
+	}
+
+	auto encodeQoi(const vx::render::Image& image) noexcept -> std::optional<std::vector<std::byte>> {
+		const std::optional<QoiInfo> info {makeInfo(image)};
+		if (!info)
+			return std::nullopt;
+		std::vector<std::byte> file {makeFile(*info)};
+		std::size_t offset {HEADER_SIZE + info->bandCount * 4uz};
+		for (std::uint32_t band {0u}; band < info->bandCount; ++band) {
+			const auto [first, count] {getBandPixels(*info, band)};
+			const std::size_t size {encodeBand(image.getPixels().data() + first, count, file.data() + offset)};
+			write32(file.data() + HEADER_SIZE + band * 4uz, static_cast<std::uint32_t> (size));
+			offset += size;
+		}
+		file.resize(offset);
+		file.shrink_to_fit();
+		return file;
+	}
+
+	auto encodeQoi(const vx::render::Image& image, vx::jobs::Scheduler& scheduler) noexcept -> std::optional<std::vector<std::byte>> {
+		const std::optional<QoiInfo> info {makeInfo(image)};
+		if (!info)
+			return std::nullopt;
+		std::vector<std::byte> file {makeFile(*info)};
+		const std::size_t tableEnd {HEADER_SIZE + info->bandCount * 4uz};
+		/* each band is encoded where it would be if all the ones before it were at their largest */
+		std::vector<std::size_t> sizes (info->bandCount);
+		vx::jobs::parallelFor(scheduler, 0u, info->bandCount, [&](const std::uint32_t firstBand, const std::uint32_t lastBand) noexcept {
+			for (std::uint32_t band {firstBand}; band < lastBand; ++band) {
+				const auto [first, count] {getBandPixels(*info, band)};
+				sizes[band] = encodeBand(image.getPixels().data() + first, count, file.data() + tableEnd + first * MAX_OPERATION_SIZE);
+			}
+		});
+		/* then moved back to back, never over a band that hasn't moved yet */
+		std::size_t offset {tableEnd};
+		for (std::uint32_t band {0u}; band < info->bandCount; ++band) {
+			const std::size_t first {getBandPixels(*info, band).first};
+			(void)std::memmove(file.data() + offset, file.data() + tableEnd + first * MAX_OPERATION_SIZE, sizes[band]);
+			write32(file.data() + HEADER_SIZE + band * 4uz, static_cast<std::uint32_t> (sizes[band]));
+			offset += sizes[band];
+		}
+		file.resize(offset);
+		file.shrink_to_fit();
+		return file;
+	}
+
+	auto decodeQoi(const std::span<const std::byte> file, const std::span<std::uint32_t> pixels) noexcept -> bool {
+		const std::optional<Qoi> qoi {readQoi(file)};
+		if (!qoi || pixels.size() != static_cast<std::size_t> (qoi->info.width) * qoi->info.height)
+			return false;
+		for (std::uint32_t band {0u}; band < qoi->info.bandCount; ++band) {
+			const auto [first, count] {getBandPixels(qoi->info, band)};
+			if (!decodeBand(qoi->bands[band], pixels.data() + first, count))
+				return false;
+		}
+		return true;
+	}
+
+	auto decodeQoi(
+		const std::span<const std::byte> file,
+		const std::span<std::uint32_t> pixels,
+		vx::jobs::Scheduler& scheduler
+	) noexcept -> bool {
+		const std::optional<Qoi> qoi {readQoi(file)};
+		if (!qoi || pixels.size() != static_cast<std::size_t> (qoi->info.width) * qoi->info.height)
+			return false;
+		std::vector<std::uint8_t> isValid (qoi->info.bandCount, 0u);
+		vx::jobs::parallelFor(scheduler, 0u, qoi->info.bandCount, [&](const std::uint32_t firstBand, const std::uint32_t lastBand) noexcept {
+			for (std::uint32_t band {firstBand}; band < lastBand; ++band) {
+				const auto [first, count] {getBandPixels(qoi->info, band)};
+				isValid[band] = decodeBand(qoi->bands[band], pixels.data() + first, count) ? 1u : 0u;
+			}
+		});
+		return std::ranges::all_of(isValid, [](const std::uint8_t value) noexcept {return value != 0u;});
+	}
+
+	auto decodeQoi(const std::span<const std::byte> file) noexcept -> std::optional<vx::render::Image> {
+		const std::optional<QoiInfo> info {readQoiInfo(file)};
+		if (!info)
+			return std::nullopt;
+		vx::render::Image image {info->width, info->height};
+		if (!decodeQoi(file, image.getPixels()))
+			return std::nullopt;
+		return image;
+	}
+}
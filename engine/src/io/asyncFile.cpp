@@ -0,0 +1,82 @@
+#include "voxlet/io/asyncFile.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "voxlet/async/executor.hpp"
+#include "voxlet/memory.hpp"
+
+
+namespace vx::io {
+	auto AsyncFile::ReadAwaiter::await_suspend(const std::coroutine_handle<> handle) noexcept -> void {
+		m_handle = handle;
+		m_operation.userData = this;
+		m_operation.completion = [](Operation& operation) noexcept {
+			auto* const awaiter {static_cast<ReadAwaiter*> (operation.userData)};
+			vx::jobs::Scheduler* const scheduler {awaiter->m_file->m_context->getScheduler()};
+			if (scheduler == nullptr)
+				return awaiter->m_handle.resume();
+			scheduler->submit(vx::async::internal::makeResumeJob(awaiter->m_handle));
+		};
+		m_file->m_context->queueRead(m_file->m_fd, m_file->m_fixedFile, m_infos, m_operation);
+	}
+
+
+	AsyncFile::AsyncFile(AsyncFile&& other) noexcept :
+		m_context {other.m_context},
+		m_fd {std::exchange(other.m_fd, -1)},
+		m_fixedFile {std::exchange(other.m_fixedFile, NO_FIXED_FILE)},
+		m_size {other.m_size}
+	{}
+
+	auto AsyncFile::operator=(AsyncFile&& other) noexcept -> AsyncFile& {
+		if (this == &other)
+			return *this;
+		this->close();
+		m_context = other.m_context;
+		m_fd = std::exchange(other.m_fd, -1);
+		m_fixedFile = std::exchange(other.m_fixedFile, NO_FIXED_FILE);
+		m_size = other.m_size;
+		return *this;
+	}
+
+	AsyncFile::~AsyncFile() {
+		this->close();
+	}
+
+
+	auto AsyncFile::open(IoContext& context, const vx::StringSlice& path) noexcept -> std::optional<AsyncFile> {
+		std::vector<char8_t> nullTerminatedPath(path.getSize() + 1uz, u8'\0');
+		vx::memory::memcpy(nullTerminatedPath.data(), std::to_address(path.begin()), path.getSize());
+
+		const int fd {::open(reinterpret_cast<const char*> (nullTerminatedPath.data()), O_RDONLY | O_CLOEXEC)};
+		if (fd < 0)
+			return std::nullopt;
+		struct stat infos {};
+		if (::fstat(fd, &infos) != 0) {
+			(void)::close(fd);
+			return std::nullopt;
+		}
+		return AsyncFile{context, fd, context.registerFile(fd), static_cast<std::uint64_t> (infos.st_size)};
+	}
+
+
+	auto AsyncFile::read(const ReadInfos& infos, const Callback callback, void* const userData) const noexcept
+		-> void
+	{
+		m_context->queueRead(m_fd, m_fixedFile, infos, callback, userData);
+	}
+
+
+	auto AsyncFile::close() noexcept -> void {
+		if (m_fixedFile != NO_FIXED_FILE)
+			m_context->unregisterFile(std::exchange(m_fixedFile, NO_FIXED_FILE));
+		if (m_fd >= 0)
+			(void)::close(std::exchange(m_fd, -1));
+	}
+}
@@ -0,0 +1,674 @@
+#include "voxlet/io/ioContext.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+	#define VOXLET_IO_HAS_IO_URING
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <sys/uio.h>
+#endif
+
+
+namespace vx::io {
+	namespace {
+		auto complete(Operation& operation, const std::int64_t result) noexcept -> void {
+			operation.result = result;
+			operation.completion(operation);
+		}
+
+		auto readFully(const int fd, const std::span<std::byte> buffer, std::uint64_t offset) noexcept -> std::int64_t {
+			std::size_t total {0uz};
+			while (total < buffer.size()) {
+				const ssize_t result {::pread(fd, buffer.data() + total, buffer.size() - total, static_cast<off_t> (offset))};
+				if (result < 0) {
+					if (errno == EINTR)
+						continue;
+					return -static_cast<std::int64_t> (errno);
+				}
+				if (result == 0)
+					break;
+				total += static_cast<std::size_t> (result);
+				offset += static_cast<std::uint64_t> (result);
+			}
+			return static_cast<std::int64_t> (total);
+		}
+	}
+
+
+#ifdef VOXLET_IO_HAS_IO_URING
+	struct IoContext::UringBackend {
+		/*
+		 * The length of an entry is 32 bits and the kernel caps a read a bit below 2 GB, a larger read is
+		 * split in parts under both limits so that it's only short at the end of the file, as with the pool.
+		 */
+		static constexpr std::size_t MAX_PART_SIZE {1uz << 30u};
+
+		/* the parts of a split read, completing it with the bytes they read or the first error */
+		struct SplitRead {
+			Operation* operation;
+			std::vector<Operation> parts;
+			std::size_t remaining;
+			std::int64_t total;
+			std::int64_t error;
+		};
+
+		struct QueuedRead {
+			int fd;
+			std::int32_t fixedFile;
+			ReadInfos infos;
+			Operation* operation;
+		};
+
+		UringBackend(const UringBackend&) = delete;
+		auto operator=(const UringBackend&) -> UringBackend& = delete;
+
+		UringBackend() noexcept = default;
+
+		~UringBackend() {
+			if (sqes != nullptr)
+				(void)::munmap(sqes, sqesSize);
+			if (cqRing != nullptr && cqRing != sqRing)
+				(void)::munmap(cqRing, cqRingSize);
+			if (sqRing != nullptr)
+				(void)::munmap(sqRing, sqRingSize);
+			if (ringFd >= 0)
+				(void)::close(ringFd);
+		}
+
+		static auto setup(const unsigned entries, io_uring_params& params) noexcept -> int {
+			return static_cast<int> (::syscall(__NR_io_uring_setup, entries, &params));
+		}
+
+		auto enter(const unsigned toSubmit, const unsigned minComplete, const unsigned flags) noexcept -> int {
+			while (true) {
+				const auto result {static_cast<int> (::syscall(__NR_io_uring_enter,
+					ringFd, toSubmit, minComplete, flags, nullptr, 0uz
+				))};
+				if (result >= 0 || errno != EINTR)
+					return result;
+			}
+		}
+
+		auto registerResource(const unsigned opcode, const void* const arg, const unsigned count) noexcept -> int {
+			return static_cast<int> (::syscall(__NR_io_uring_register, ringFd, opcode, arg, count));
+		}
+
+		[[nodiscard]]
+		static auto create(const Config& config) noexcept -> std::unique_ptr<UringBackend> {
+			auto backend {std::make_unique<UringBackend> ()};
+			io_uring_params params {};
+			backend->ringFd = setup(std::max(config.queueDepth, 1u), params);
+			// IORING_OP_READ appeared with Linux 5.6, fast poll is the closest feature flag to detect it
+			if (backend->ringFd < 0 || (params.features & IORING_FEAT_FAST_POLL) == 0u)
+				return nullptr;
+
+			backend->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			backend->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			const bool singleMmap {(params.features & IORING_FEAT_SINGLE_MMAP) != 0u};
+			if (singleMmap)
+				backend->sqRingSize = backend->cqRingSize = std::max(backend->sqRingSize, backend->cqRingSize);
+
+			backend->sqRing = ::mmap(nullptr, backend->sqRingSize, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, backend->ringFd, IORING_OFF_SQ_RING
+			);
+			if (backend->sqRing == MAP_FAILED) {
+				backend->sqRing = nullptr;
+				return nullptr;
+			}
+			if (singleMmap)
+				backend->cqRing = backend->sqRing;
+			else {
+				backend->cqRing = ::mmap(nullptr, backend->cqRingSize, PROT_READ | PROT_WRITE,
+					MAP_SHARED | MAP_POPULATE, backend->ringFd, IORING_OFF_CQ_RING
+				);
+				if (backend->cqRing == MAP_FAILED) {
+					backend->cqRing = nullptr;
+					return nullptr;
+				}
+			}
+			backend->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+			void* const sqes {::mmap(nullptr, backend->sqesSize, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, backend->ringFd, IORING_OFF_SQES
+			)};
+			if (sqes == MAP_FAILED)
+				return nullptr;
+			backend->sqes = static_cast<io_uring_sqe*> (sqes);
+
+			auto* const sq {static_cast<std::byte*> (backend->sqRing)};
+			auto* const cq {static_cast<std::byte*> (backend->cqRing)};
+			backend->sqHead = reinterpret_cast<unsigned*> (sq + params.sq_off.head);
+			backend->sqTail = reinterpret_cast<unsigned*> (sq + params.sq_off.tail);
+			backend->sqMask = *reinterpret_cast<unsigned*> (sq + params.sq_off.ring_mask);
+			backend->sqArray = reinterpret_cast<unsigned*> (sq + params.sq_off.array);
+			backend->sqEntries = params.sq_entries;
+			backend->cqHead = reinterpret_cast<unsigned*> (cq + params.cq_off.head);
+			backend->cqTail = reinterpret_cast<unsigned*> (cq + params.cq_off.tail);
+			backend->cqMask = *reinterpret_cast<unsigned*> (cq + params.cq_off.ring_mask);
+			backend->cqes = reinterpret_cast<io_uring_cqe*> (cq + params.cq_off.cqes);
+			backend->localTail = *backend->sqTail;
+
+			if (config.maxFixedFiles != 0u) {
+				const std::vector<std::int32_t> files(config.maxFixedFiles, -1);
+				if (backend->registerResource(IORING_REGISTER_FILES, files.data(), config.maxFixedFiles) >= 0) {
+					backend->freeFixedFiles.reserve(config.maxFixedFiles);
+					for (std::uint32_t i {config.maxFixedFiles}; i != 0u; --i)
+						backend->freeFixedFiles.push_back(static_cast<std::int32_t> (i - 1u));
+				}
+			}
+			return backend;
+		}
+
+
+		auto queueRead(const int fd, const std::int32_t fixedFile, const ReadInfos& infos, Operation& operation)
+			noexcept
+			-> void
+		{
+			if (infos.buffer.size() > MAX_PART_SIZE)
+				return this->queueSplitRead(fd, fixedFile, infos, operation);
+			std::scoped_lock _ {submitMutex};
+			(void)pending.fetch_add(1uz, std::memory_order::relaxed);
+			if (overflow.empty() && this->isFull())
+				(void)this->submitLocked();
+			/*
+			 * The kernel may not take the entries back until completions are reaped, which only the thread
+			 * calling `poll` or `wait` does and may be this one, so a read that doesn't fit waits for the next
+			 * submission instead of the ring.
+			 */
+			if (!overflow.empty() || this->isFull())
+				overflow.push_back(QueuedRead{fd, fixedFile, infos, &operation});
+			else
+				this->pushLocked(fd, fixedFile, infos, operation);
+		}
+
+		auto queueSplitRead(const int fd, const std::int32_t fixedFile, const ReadInfos& infos, Operation& operation)
+			noexcept
+			-> void
+		{
+			const std::size_t partCount {(infos.buffer.size() + MAX_PART_SIZE - 1uz) / MAX_PART_SIZE};
+			auto split {std::make_unique<SplitRead> (SplitRead{
+				.operation = &operation,
+				.parts = std::vector<Operation> (partCount),
+				.remaining = partCount,
+				.total = 0,
+				.error = 0
+			})};
+			for (std::size_t i {0uz}; i < partCount; ++i) {
+				Operation& part {split->parts[i]};
+				part.userData = split.get();
+				part.completion = [](Operation& part) noexcept {
+					auto* const split {static_cast<SplitRead*> (part.userData)};
+					if (part.result < 0 && split->error == 0)
+						split->error = part.result;
+					else if (part.result > 0)
+						split->total += part.result;
+					if (--split->remaining != 0uz)
+						return;
+					const std::unique_ptr<SplitRead> owner {split};
+					complete(*split->operation, split->error != 0 ? split->error : split->total);
+				};
+			}
+			SplitRead& parts {*split.release()};
+			for (std::size_t i {0uz}; i < partCount; ++i) {
+				const std::size_t offset {i * MAX_PART_SIZE};
+				const ReadInfos partInfos {
+					.buffer = infos.buffer.subspan(offset, std::min(MAX_PART_SIZE, infos.buffer.size() - offset)),
+					.offset = infos.offset + offset,
+					.registeredBuffer = infos.registeredBuffer
+				};
+				this->queueRead(fd, fixedFile, partInfos, parts.parts[i]);
+			}
+		}
+
+		auto isFull() const noexcept -> bool {
+			return localTail - std::atomic_ref{*sqHead}.load(std::memory_order::acquire) == sqEntries;
+		}
+
+		auto pushLocked(const int fd, const std::int32_t fixedFile, const ReadInfos& infos, Operation& operation) noexcept -> void {
+			const unsigned index {localTail & sqMask};
+			io_uring_sqe& sqe {sqes[index]};
+			std::memset(&sqe, 0, sizeof(sqe));
+			if (infos.registeredBuffer != NO_REGISTERED_BUFFER) {
+				sqe.opcode = IORING_OP_READ_FIXED;
+				sqe.buf_index = static_cast<std::uint16_t> (infos.registeredBuffer);
+			}
+			else
+				sqe.opcode = IORING_OP_READ;
+			if (fixedFile != NO_FIXED_FILE) {
+				sqe.fd = fixedFile;
+				sqe.flags = IOSQE_FIXED_FILE;
+			}
+			else
+				sqe.fd = fd;
+			sqe.addr = reinterpret_cast<std::uint64_t> (infos.buffer.data());
+			sqe.len = static_cast<std::uint32_t> (infos.buffer.size());
+			sqe.off = infos.offset;
+			sqe.user_data = reinterpret_cast<std::uint64_t> (&operation);
+
+			sqArray[index] = index;
+			++localTail;
+			std::atomic_ref{*sqTail}.store(localTail, std::memory_order::release);
+			++toSubmit;
+		}
+
+		/* moves the reads that waited into the ring as long as there is room, in the order they were queued */
+		auto drainOverflowLocked() noexcept -> void {
+			std::size_t count {0uz};
+			for (; count < overflow.size() && !this->isFull(); ++count) {
+				const QueuedRead& read {overflow[count]};
+				this->pushLocked(read.fd, read.fixedFile, read.infos, *read.operation);
+			}
+			(void)overflow.erase(overflow.begin(), overflow.begin() + static_cast<std::ptrdiff_t> (count));
+		}
+
+		auto submitLocked() noexcept -> std::size_t {
+			std::size_t total {0uz};
+			while (true) {
+				this->drainOverflowLocked();
+				if (toSubmit == 0u)
+					return total;
+				const int submitted {this->enter(toSubmit, 0u, 0u)};
+				if (submitted <= 0)
+					return total;
+				toSubmit -= static_cast<unsigned> (submitted);
+				total += static_cast<std::size_t> (submitted);
+				if (overflow.empty())
+					return total;
+			}
+		}
+
+		auto submit() noexcept -> std::size_t {
+			std::scoped_lock _ {submitMutex};
+			return this->submitLocked();
+		}
+
+		auto reap() noexcept -> std::size_t {
+			std::size_t count {0uz};
+			unsigned head {*cqHead};
+			while (head != std::atomic_ref{*cqTail}.load(std::memory_order::acquire)) {
+				const io_uring_cqe& cqe {cqes[head & cqMask]};
+				auto* const operation {reinterpret_cast<Operation*> (cqe.user_data)};
+				const std::int64_t result {cqe.res};
+				++head;
+				std::atomic_ref{*cqHead}.store(head, std::memory_order::release);
+				(void)pending.fetch_sub(1uz, std::memory_order::relaxed);
+				complete(*operation, result);
+				++count;
+			}
+			return count;
+		}
+
+		auto wait(std::size_t minCompletions) noexcept -> std::size_t {
+			(void)this->submit();
+			minCompletions = std::min(minCompletions, pending.load(std::memory_order::relaxed));
+			std::size_t count {this->reap()};
+			while (count < minCompletions) {
+				bool hasOverflow {false};
+				{
+					std::scoped_lock _ {submitMutex};
+					(void)this->submitLocked();
+					hasOverflow = !overflow.empty();
+				}
+				/* the reads still waiting aren't in flight, the kernel could never complete as many as asked */
+				const std::size_t wanted {hasOverflow ? 1uz : minCompletions - count};
+				(void)this->enter(0u, static_cast<unsigned> (wanted), IORING_ENTER_GETEVENTS);
+				count += this->reap();
+			}
+			return count;
+		}
+
+
+		auto registerFile(const int fd) noexcept -> std::int32_t {
+			std::scoped_lock _ {fileMutex};
+			if (freeFixedFiles.empty())
+				return NO_FIXED_FILE;
+			const std::int32_t slot {freeFixedFiles.back()};
+			io_uring_files_update update {};
+			update.offset = static_cast<std::uint32_t> (slot);
+			update.fds = reinterpret_cast<std::uint64_t> (&fd);
+			if (this->registerResource(IORING_REGISTER_FILES_UPDATE, &update, 1u) < 0)
+				return NO_FIXED_FILE;
+			freeFixedFiles.pop_back();
+			return slot;
+		}
+
+		auto unregisterFile(const std::int32_t slot) noexcept -> void {
+			std::scoped_lock _ {fileMutex};
+			const std::int32_t fd {-1};
+			io_uring_files_update update {};
+			update.offset = static_cast<std::uint32_t> (slot);
+			update.fds = reinterpret_cast<std::uint64_t> (&fd);
+			(void)this->registerResource(IORING_REGISTER_FILES_UPDATE, &update, 1u);
+			freeFixedFiles.push_back(slot);
+		}
+
+		auto registerBuffers(const std::span<const std::span<std::byte>> buffers) noexcept -> bool {
+			std::vector<iovec> iovecs {};
+			iovecs.reserve(buffers.size());
+			for (const std::span<std::byte> buffer : buffers)
+				iovecs.push_back(iovec{buffer.data(), buffer.size()});
+			if (hasRegisteredBuffers)
+				this->unregisterBuffers();
+			hasRegisteredBuffers = this->registerResource(IORING_REGISTER_BUFFERS,
+				iovecs.data(),
+				static_cast<unsigned> (iovecs.size())
+			) >= 0;
+			return hasRegisteredBuffers;
+		}
+
+		auto unregisterBuffers() noexcept -> void {
+			if (!hasRegisteredBuffers)
+				return;
+			(void)this->registerResource(IORING_UNREGISTER_BUFFERS, nullptr, 0u);
+			hasRegisteredBuffers = false;
+		}
+
+
+		int ringFd {-1};
+		void* sqRing {nullptr};
+		std::size_t sqRingSize {0uz};
+		void* cqRing {nullptr};
+		std::size_t cqRingSize {0uz};
+		io_uring_sqe* sqes {nullptr};
+		std::size_t sqesSize {0uz};
+		unsigned* sqHead {nullptr};
+		unsigned* sqTail {nullptr};
+		unsigned sqMask {0u};
+		unsigned* sqArray {nullptr};
+		unsigned sqEntries {0u};
+		unsigned* cqHead {nullptr};
+		unsigned* cqTail {nullptr};
+		unsigned cqMask {0u};
+		io_uring_cqe* cqes {nullptr};
+
+		std::mutex submitMutex {};
+		/* reads queued while the ring was full */
+		std::vector<QueuedRead> overflow {};
+		unsigned localTail {0u};
+		unsigned toSubmit {0u};
+		std::atomic<std::size_t> pending {0uz};
+
+		std::mutex fileMutex {};
+		std::vector<std::int32_t> freeFixedFiles {};
+		bool hasRegisteredBuffers {false};
+	};
+#else
+	struct IoContext::UringBackend {};
+#endif
+
+
+	struct IoContext::ThreadPoolBackend {
+		struct Request {
+			int fd;
+			std::span<std::byte> buffer;
+			std::uint64_t offset;
+			Operation* operation;
+		};
+
+		explicit ThreadPoolBackend(const std::size_t threadCount) noexcept {
+			threads.reserve(threadCount);
+			for (std::size_t i {0uz}; i < std::max(threadCount, 1uz); ++i)
+				threads.emplace_back([this]() noexcept {this->workerLoop();});
+		}
+
+		~ThreadPoolBackend() {
+			{
+				std::scoped_lock _ {mutex};
+				isStopping = true;
+			}
+			workAvailable.notify_all();
+			threads.clear();
+		}
+
+		auto queueRead(const int fd, const ReadInfos& infos, Operation& operation) noexcept -> void {
+			std::scoped_lock _ {mutex};
+			queued.push_back(Request{fd, infos.buffer, infos.offset, &operation});
+			++pending;
+		}
+
+		auto submit() noexcept -> std::size_t {
+			std::size_t count {0uz};
+			{
+				std::scoped_lock _ {mutex};
+				count = queued.size();
+				work.insert(work.end(), queued.begin(), queued.end());
+				queued.clear();
+			}
+			if (count != 0uz)
+				workAvailable.notify_all();
+			return count;
+		}
+
+		auto collect(std::size_t minCompletions) noexcept -> std::size_t {
+			(void)this->submit();
+			std::vector<std::pair<Operation*, std::int64_t>> ready {};
+			{
+				std::unique_lock lock {mutex};
+				minCompletions = std::min(minCompletions, pending);
+				completionAvailable.wait(lock, [&]() {return completed.size() >= minCompletions;});
+				std::swap(ready, completed);
+				pending -= ready.size();
+			}
+			for (const auto& [operation, result] : ready)
+				complete(*operation, result);
+			return ready.size();
+		}
+
+		auto workerLoop() noexcept -> void {
+			while (true) {
+				Request request {};
+				{
+					std::unique_lock lock {mutex};
+					workAvailable.wait(lock, [this]() {return isStopping || !work.empty();});
+					if (isStopping)
+						return;
+					request = work.front();
+					work.pop_front();
+				}
+				const std::int64_t result {readFully(request.fd, request.buffer, request.offset)};
+				{
+					std::scoped_lock _ {mutex};
+					completed.emplace_back(request.operation, result);
+				}
+				completionAvailable.notify_one();
+			}
+		}
+
+		std::mutex mutex {};
+		std::condition_variable workAvailable {};
+		std::condition_variable completionAvailable {};
+		std::vector<Request> queued {};
+		std::deque<Request> work {};
+		std::vector<std::pair<Operation*, std::int64_t>> completed {};
+		std::size_t pending {0uz};
+		bool isStopping {false};
+		std::vector<std::jthread> threads {};
+	};
+
+
+	IoContext::IoContext() noexcept :
+		IoContext(Config{})
+	{}
+
+	IoContext::IoContext(const Config& config) noexcept :
+		m_config {config},
+		m_backend {Backend::threadPool},
+		m_uring {},
+		m_threadPool {},
+		m_callbackMutex {},
+		m_callbackOperations {},
+		m_freeCallbackOperations {nullptr}
+	{
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_config.backend != Backend::threadPool) {
+			m_uring = UringBackend::create(m_config);
+			if (m_uring != nullptr)
+				m_backend = Backend::ioUring;
+		}
+	#endif
+		/* only an automatic choice falls back, asking for io_uring explicitly leaves the context invalid */
+		if (m_config.backend == Backend::ioUring && m_uring == nullptr)
+			m_backend = Backend::ioUring;
+		else if (m_backend == Backend::threadPool)
+			m_threadPool = std::make_unique<ThreadPoolBackend> (m_config.fallbackThreadCount);
+	}
+
+	IoContext::~IoContext() {
+		if (!this->isValid())
+			return;
+		while (this->getPendingCount() != 0uz)
+			(void)this->wait(this->getPendingCount());
+		this->unregisterBuffers();
+	}
+
+
+	auto IoContext::isValid() const noexcept -> bool {
+		return m_uring != nullptr || m_threadPool != nullptr;
+	}
+
+	auto IoContext::getBackend() const noexcept -> Backend {
+		return m_backend;
+	}
+
+	auto IoContext::getScheduler() const noexcept -> vx::jobs::Scheduler* {
+		return m_config.scheduler;
+	}
+
+	auto IoContext::getPendingCount() const noexcept -> std::size_t {
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			return m_uring->pending.load(std::memory_order::relaxed);
+	#endif
+		std::scoped_lock _ {m_threadPool->mutex};
+		return m_threadPool->pending;
+	}
+
+
+	auto IoContext::registerBuffers(const std::span<const std::span<std::byte>> buffers) noexcept -> bool {
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			return m_uring->registerBuffers(buffers);
+	#endif
+		(void)buffers;
+		return true;
+	}
+
+	auto IoContext::unregisterBuffers() noexcept -> void {
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			m_uring->unregisterBuffers();
+	#endif
+	}
+
+
+	auto IoContext::queueRead(const int fd, const std::int32_t fixedFile, const ReadInfos& infos, Operation& operation)
+		noexcept
+		-> void
+	{
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			return m_uring->queueRead(fd, fixedFile, infos, operation);
+	#endif
+		(void)fixedFile;
+		m_threadPool->queueRead(fd, infos, operation);
+	}
+
+	auto IoContext::queueRead(
+		const int fd,
+		const std::int32_t fixedFile,
+		const ReadInfos& infos,
+		const Callback callback,
+		void* const userData
+	) noexcept -> void {
+		CallbackOperation* const operation {this->acquireCallbackOperation()};
+		operation->callback = callback;
+		operation->userData = userData;
+		operation->operation.userData = this;
+		operation->operation.completion = [](Operation& base) noexcept {
+			auto* const context {static_cast<IoContext*> (base.userData)};
+			auto* const operation {reinterpret_cast<CallbackOperation*> (&base)};
+			operation->callback(operation->userData, base.result);
+			context->releaseCallbackOperation(operation);
+		};
+		this->queueRead(fd, fixedFile, infos, operation->operation);
+	}
+
+
+	auto IoContext::submit() noexcept -> std::size_t {
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			return m_uring->submit();
+	#endif
+		return m_threadPool->submit();
+	}
+
+	auto IoContext::poll() noexcept -> std::size_t {
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring) {
+			(void)m_uring->submit();
+			return m_uring->reap();
+		}
+	#endif
+		return m_threadPool->collect(0uz);
+	}
+
+	auto IoContext::wait(const std::size_t minCompletions) noexcept -> std::size_t {
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			return m_uring->wait(minCompletions);
+	#endif
+		return m_threadPool->collect(minCompletions);
+	}
+
+
+	auto IoContext::registerFile(const int fd) noexcept -> std::int32_t {
+		assert(this->isValid());
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			return m_uring->registerFile(fd);
+	#endif
+		(void)fd;
+		return NO_FIXED_FILE;
+	}
+
+	auto IoContext::unregisterFile(const std::int32_t fixedFile) noexcept -> void {
+		assert(fixedFile != NO_FIXED_FILE);
+	#ifdef VOXLET_IO_HAS_IO_URING
+		if (m_backend == Backend::ioUring)
+			m_uring->unregisterFile(fixedFile);
+	#endif
+		(void)fixedFile;
+	}
+
+
+	auto IoContext::acquireCallbackOperation() noexcept -> CallbackOperation* {
+		std::scoped_lock _ {m_callbackMutex};
+		if (m_freeCallbackOperations == nullptr)
+			return &m_callbackOperations.emplace_back();
+		CallbackOperation* const operation {m_freeCallbackOperations};
+		m_freeCallbackOperations = operation->nextFree;
+		return operation;
+	}
+
+	auto IoContext::releaseCallbackOperation(CallbackOperation* const operation) noexcept -> void {
+		std::scoped_lock _ {m_callbackMutex};
+		operation->nextFree = m_freeCallbackOperations;
+		m_freeCallbackOperations = operation;
+	}
+}
@@ -0,0 +1,140 @@
+#include "voxlet/io/mappedFile.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "voxlet/memory.hpp"
+
+
+namespace vx::io {
+	namespace {
+		auto openReadOnly(const vx::StringSlice& path) noexcept -> int {
+			std::vector<char8_t> nullTerminatedPath(path.getSize() + 1uz, u8'\0');
+			vx::memory::memcpy(nullTerminatedPath.data(), std::to_address(path.begin()), path.getSize());
+			return ::open(reinterpret_cast<const char*> (nullTerminatedPath.data()), O_RDONLY | O_CLOEXEC);
+		}
+
+		auto toAdvice(const AccessPattern pattern) noexcept -> int {
+			switch (pattern) {
+				case AccessPattern::sequential:
+					return MADV_SEQUENTIAL;
+				case AccessPattern::random:
+					return MADV_RANDOM;
+				case AccessPattern::normal:
+					break;
+			}
+			return MADV_NORMAL;
+		}
+
+		auto getPageSize() noexcept -> std::size_t {
+			static const std::size_t pageSize {static_cast<std::size_t> (::sysconf(_SC_PAGESIZE))};
+			return pageSize;
+		}
+	}
+
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept :
+		m_data {std::exchange(other.m_data, nullptr)},
+		m_size {std::exchange(other.m_size, 0uz)}
+	{}
+
+	auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+		if (this == &other)
+			return *this;
+		this->unmap();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0uz);
+		return *this;
+	}
+
+	MappedFile::~MappedFile() {
+		this->unmap();
+	}
+
+
+	auto MappedFile::open(const vx::StringSlice& path) noexcept -> std::optional<MappedFile> {
+		return MappedFile::open(path, Config{});
+	}
+
+	auto MappedFile::open(const vx::StringSlice& path, const Config& config) noexcept -> std::optional<MappedFile> {
+		const int fd {openReadOnly(path)};
+		if (fd < 0)
+			return std::nullopt;
+		struct stat infos {};
+		if (::fstat(fd, &infos) != 0) {
+			(void)::close(fd);
+			return std::nullopt;
+		}
+		const auto size {static_cast<size_type> (infos.st_size)};
+		if (size == 0uz) {
+			(void)::close(fd);
+			return MappedFile{};
+		}
+
+		void* const data {::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | (config.populate ? MAP_POPULATE : 0), fd, 0)};
+		(void)::close(fd);
+		if (data == MAP_FAILED)
+			return std::nullopt;
+
+		MappedFile file {static_cast<const std::byte*> (data), size};
+		file.advise(config.pattern);
+		if (config.hugePages) {
+		#ifdef MADV_HUGEPAGE
+			(void)::madvise(data, size, MADV_HUGEPAGE);
+		#endif
+		}
+		if (config.willNeed)
+			file.prefetch();
+		return file;
+	}
+
+
+	auto MappedFile::prefetch(const vx::StringSlice& path) noexcept -> bool {
+		const int fd {openReadOnly(path)};
+		if (fd < 0)
+			return false;
+		const bool isQueued {::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED) == 0};
+		(void)::close(fd);
+		return isQueued;
+	}
+
+	auto MappedFile::prefetch(const size_type offset, size_type size) const noexcept -> void {
+		if (offset >= m_size)
+			return;
+		size = std::min(size, m_size - offset);
+		/* madvise needs a page aligned address, the mapping itself always is */
+		const size_type alignedOffset {offset & ~(getPageSize() - 1uz)};
+		(void)::madvise(const_cast<std::byte*> (m_data + alignedOffset), size + offset - alignedOffset, MADV_WILLNEED);
+	}
+
+	auto MappedFile::advise(const AccessPattern pattern) const noexcept -> void {
+		if (m_data == nullptr)
+			return;
+		(void)::madvise(const_cast<std::byte*> (m_data), m_size, toAdvice(pattern));
+	}
+
+
+	auto MappedFile::getText() const noexcept -> vx::StringSlice {
+		return vx::StringSlice::from(reinterpret_cast<const char8_t*> (m_data), m_size);
+	}
+
+	auto MappedFile::getUncheckedText() const noexcept -> vx::containers::views::UncheckedStringSlice {
+		return this->getText().unchecked();
+	}
+
+
+	auto MappedFile::unmap() noexcept -> void {
+		if (m_data == nullptr)
+			return;
+		(void)::munmap(const_cast<std::byte*> (m_data), m_size);
+		m_data = nullptr;
+		m_size = 0uz;
+	}
+}
@@ -0,0 +1,225 @@
+#include "voxlet/jobs/frameGraph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+
+
+namespace vx::jobs {
+	FrameGraph::FrameGraph() noexcept :
+		m_resources {},
+		m_stages {},
+		m_nodes {},
+		m_runners {},
+		m_roots {},
+		m_timings {},
+		m_criticalPath {},
+		m_frameStart {},
+		m_frameDuration {0},
+		m_scheduler {nullptr},
+		m_frameCounter {nullptr},
+		m_compilationCount {0uz},
+		m_isDirty {true}
+	{}
+
+	FrameGraph::~FrameGraph() = default;
+
+
+	auto FrameGraph::getResource(const vx::StringSlice& name) noexcept -> Resource {
+		const auto it {std::ranges::find_if(m_resources, [&name](const vx::String& resource) {
+			return std::ranges::equal(resource, name);
+		})};
+		if (it != m_resources.end())
+			return static_cast<Resource> (it - m_resources.begin());
+		m_resources.push_back(vx::String::from(name));
+		return static_cast<Resource> (m_resources.size() - 1uz);
+	}
+
+	auto FrameGraph::addStage(StageInfos&& infos) noexcept -> StageId {
+		assert(this->findStage(infos.name.slice()) == npos);
+		m_stages.push_back(std::move(infos));
+		m_timings.clear();
+		m_isDirty = true;
+		return m_stages.size() - 1uz;
+	}
+
+	auto FrameGraph::removeStage(const vx::StringSlice& name) noexcept -> bool {
+		const StageId stage {this->findStage(name)};
+		if (stage == npos)
+			return false;
+		(void)m_stages.erase(m_stages.begin() + static_cast<std::ptrdiff_t> (stage));
+		m_timings.clear();
+		m_isDirty = true;
+		return true;
+	}
+
+	auto FrameGraph::findStage(const vx::StringSlice& name) const noexcept -> StageId {
+		const auto it {std::ranges::find_if(m_stages, [&name](const StageInfos& stage) {
+			return std::ranges::equal(stage.name, name);
+		})};
+		if (it == m_stages.end())
+			return npos;
+		return static_cast<StageId> (it - m_stages.begin());
+	}
+
+
+	auto FrameGraph::compile() noexcept -> void {
+		const std::size_t stageCount {m_stages.size()};
+		m_nodes = std::make_unique<Node[]> (stageCount);
+		m_runners.clear();
+		m_roots.clear();
+
+		struct ResourceState {
+			StageId lastWriter {npos};
+			std::vector<StageId> readersSinceWrite {};
+		};
+		std::vector<ResourceState> resourceStates(m_resources.size());
+
+		const auto addEdge {[this](const StageId from, const StageId to) {
+			std::vector<StageId>& dependencies {m_nodes[to].dependencies};
+			if (from == to || std::ranges::find(dependencies, from) != dependencies.end())
+				return;
+			dependencies.push_back(from);
+			m_nodes[from].successors.push_back(to);
+		}};
+
+		for (const auto stage : std::views::iota(0uz, stageCount)) {
+			const StageInfos& infos {m_stages[stage]};
+			for (const Resource resource : infos.reads) {
+				assert(resource < resourceStates.size());
+				ResourceState& state {resourceStates[resource]};
+				if (state.lastWriter != npos)
+					addEdge(state.lastWriter, stage);
+			}
+			for (const Resource resource : infos.writes) {
+				assert(resource < resourceStates.size());
+				ResourceState& state {resourceStates[resource]};
+				if (state.lastWriter != npos)
+					addEdge(state.lastWriter, stage);
+				for (const StageId reader : state.readersSinceWrite)
+					addEdge(reader, stage);
+			}
+
+			for (const Resource resource : infos.reads)
+				resourceStates[resource].readersSinceWrite.push_back(stage);
+			for (const Resource resource : infos.writes) {
+				resourceStates[resource].lastWriter = stage;
+				resourceStates[resource].readersSinceWrite.clear();
+			}
+
+			m_runners.push_back(StageRunner{this, stage});
+			if (m_nodes[stage].dependencies.empty())
+				m_roots.push_back(stage);
+		}
+
+		m_timings.clear();
+		m_timings.reserve(stageCount);
+		for (const StageInfos& infos : m_stages)
+			m_timings.push_back(StageTiming{infos.name.slice(), Duration{0}, Duration{0}, false});
+		m_criticalPath.clear();
+		++m_compilationCount;
+		m_isDirty = false;
+	}
+
+	auto FrameGraph::execute(Scheduler& scheduler) noexcept -> void {
+		if (m_isDirty)
+			this->compile();
+		const std::size_t stageCount {m_stages.size()};
+		if (stageCount == 0uz)
+			return;
+
+		for (const auto stage : std::views::iota(0uz, stageCount)) {
+			m_nodes[stage].remainingDependencies.store(
+				m_nodes[stage].dependencies.size(),
+				std::memory_order::relaxed
+			);
+		}
+
+		Counter frameCounter {stageCount};
+		m_scheduler = &scheduler;
+		m_frameCounter = &frameCounter;
+		m_frameStart = std::chrono::steady_clock::now();
+		for (const StageId root : m_roots)
+			scheduler.submit(Job::from(m_runners[root], &frameCounter));
+		scheduler.wait(frameCounter);
+		m_frameDuration = std::chrono::duration_cast<Duration> (std::chrono::steady_clock::now() - m_frameStart);
+		m_scheduler = nullptr;
+		m_frameCounter = nullptr;
+
+		this->computeCriticalPath();
+	}
+
+
+	auto FrameGraph::isDirty() const noexcept -> bool {
+		return m_isDirty;
+	}
+
+	auto FrameGraph::getStageCount() const noexcept -> std::size_t {
+		return m_stages.size();
+	}
+
+	auto FrameGraph::getCompilationCount() const noexcept -> std::size_t {
+		return m_compilationCount;
+	}
+
+	auto FrameGraph::getDependencies(const StageId stage) const noexcept -> std::span<const StageId> {
+		assert(!m_isDirty && stage < m_stages.size());
+		return m_nodes[stage].dependencies;
+	}
+
+	auto FrameGraph::getTimings() const noexcept -> std::span<const StageTiming> {
+		return m_timings;
+	}
+
+	auto FrameGraph::getCriticalPath() const noexcept -> std::span<const StageId> {
+		return m_criticalPath;
+	}
+
+	auto FrameGraph::getFrameDuration() const noexcept -> Duration {
+		return m_frameDuration;
+	}
+
+
+	auto FrameGraph::runStage(const StageId stage) noexcept -> void {
+		const auto start {std::chrono::steady_clock::now()};
+		if (m_stages[stage].function)
+			m_stages[stage].function();
+		const auto end {std::chrono::steady_clock::now()};
+
+		StageTiming& timing {m_timings[stage]};
+		timing.start = std::chrono::duration_cast<Duration> (start - m_frameStart);
+		timing.duration = std::chrono::duration_cast<Duration> (end - start);
+
+		for (const StageId successor : m_nodes[stage].successors) {
+			if (m_nodes[successor].remainingDependencies.fetch_sub(1uz, std::memory_order::acq_rel) == 1uz)
+				m_scheduler->submit(Job::from(m_runners[successor], m_frameCounter));
+		}
+	}
+
+	auto FrameGraph::computeCriticalPath() noexcept -> void {
+		const std::size_t stageCount {m_stages.size()};
+		std::vector<Duration> longestFinish(stageCount, Duration{0});
+		std::vector<StageId> predecessor(stageCount, npos);
+
+		// stages only depend on previously declared stages, so declaration order is a topological order
+		for (const auto stage : std::views::iota(0uz, stageCount)) {
+			for (const StageId dependency : m_nodes[stage].dependencies) {
+				if (longestFinish[dependency] > longestFinish[stage] || predecessor[stage] == npos) {
+					longestFinish[stage] = longestFinish[dependency];
+					predecessor[stage] = dependency;
+				}
+			}
+			longestFinish[stage] += m_timings[stage].duration;
+			m_timings[stage].isOnCriticalPath = false;
+		}
+
+		m_criticalPath.clear();
+		StageId stage {static_cast<StageId> (std::ranges::max_element(longestFinish) - longestFinish.begin())};
+		while (stage != npos) {
+			m_criticalPath.push_back(stage);
+			m_timings[stage].isOnCriticalPath = true;
+			stage = predecessor[stage];
+		}
+		std::ranges::reverse(m_criticalPath);
+	}
+}
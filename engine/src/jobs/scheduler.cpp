@@ -0,0 +1,224 @@
+#include "voxlet/jobs/scheduler.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+#ifdef __linux__
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+#include <immintrin.h>
+
+
+namespace vx::jobs {
+	namespace {
+		thread_local const Scheduler* currentScheduler {nullptr};
+		thread_local std::size_t currentThreadIndex {0uz};
+
+		auto pinCurrentThread(const std::size_t core) noexcept -> void {
+		#ifdef __linux__
+			cpu_set_t set {};
+			CPU_ZERO(&set);
+			CPU_SET(core % std::max(std::thread::hardware_concurrency(), 1u), &set);
+			(void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+		#else
+			(void)core;
+		#endif
+		}
+	}
+
+
+	Scheduler::Scheduler() noexcept :
+		Scheduler(Config{})
+	{}
+
+	Scheduler::Scheduler(const Config& config) noexcept :
+		m_config {config},
+		m_workers {},
+		m_injectionMutex {},
+		m_injectionQueue {},
+		m_injectionSize {0uz},
+		m_wakeEpoch {0u},
+		m_sleepingCount {0uz},
+		m_running {true}
+	{
+		if (m_config.workerCount == npos) {
+			const std::size_t hardwareThreads {std::max(std::thread::hardware_concurrency(), 1u)};
+			m_config.workerCount = hardwareThreads - 1uz;
+		}
+
+		/* workers look at each other's deques, so every worker must exist before the first thread starts */
+		m_workers.resize(m_config.workerCount);
+		for (auto& worker : m_workers)
+			worker = std::make_unique<Worker> ();
+		for (const auto i : std::views::iota(0uz, m_config.workerCount)) {
+			m_workers[i]->thread = std::jthread{[this, i]() noexcept {
+				this->workerLoop(i + 1uz);
+			}};
+		}
+	}
+
+	Scheduler::~Scheduler() {
+		m_running.store(false, std::memory_order::release);
+		(void)m_wakeEpoch.fetch_add(1u, std::memory_order::acq_rel);
+		m_wakeEpoch.notify_all();
+		for (auto& worker : m_workers)
+			worker->thread.join();
+	}
+
+
+	auto Scheduler::submit(const Job& job) noexcept -> void {
+		const std::size_t index {this->getCurrentThreadIndex()};
+		if (index != 0uz)
+			m_workers[index - 1uz]->deque.push(job);
+		else {
+			std::scoped_lock _ {m_injectionMutex};
+			m_injectionQueue.push_back(job);
+			(void)m_injectionSize.fetch_add(1uz, std::memory_order::release);
+		}
+		this->wakeUp(1uz);
+	}
+
+	auto Scheduler::submit(std::span<const Job> jobs) noexcept -> void {
+		if (jobs.empty())
+			return;
+		const std::size_t index {this->getCurrentThreadIndex()};
+		if (index != 0uz) {
+			for (const Job& job : jobs)
+				m_workers[index - 1uz]->deque.push(job);
+		}
+		else {
+			std::scoped_lock _ {m_injectionMutex};
+			m_injectionQueue.insert(m_injectionQueue.end(), jobs.begin(), jobs.end());
+			(void)m_injectionSize.fetch_add(jobs.size(), std::memory_order::release);
+		}
+		this->wakeUp(jobs.size());
+	}
+
+
+	auto Scheduler::wait(const Counter& counter) noexcept -> void {
+		std::size_t failedAttempts {0uz};
+		while (!counter.isDone()) {
+			if (this->tryRunOne()) {
+				failedAttempts = 0uz;
+				continue;
+			}
+			// the owner of the counter never sleeps: the last job of the counter might not wake it up
+			if (++failedAttempts < m_config.spinCount || m_config.sleepPolicy == SleepPolicy::spin)
+				_mm_pause();
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	auto Scheduler::tryRunOne() noexcept -> bool {
+		const std::optional<Job> job {this->findJob(this->getCurrentThreadIndex())};
+		if (!job)
+			return false;
+		(*job)();
+		return true;
+	}
+
+
+	auto Scheduler::getCurrentThreadIndex() const noexcept -> std::size_t {
+		if (currentScheduler != this)
+			return 0uz;
+		return currentThreadIndex;
+	}
+
+	auto Scheduler::getWorkerCount() const noexcept -> std::size_t {
+		return m_workers.size();
+	}
+
+	auto Scheduler::getThreadCount() const noexcept -> std::size_t {
+		return m_workers.size() + 1uz;
+	}
+
+	auto Scheduler::getConfig() const noexcept -> const Config& {
+		return m_config;
+	}
+
+
+	auto Scheduler::workerLoop(const std::size_t index) noexcept -> void {
+		currentScheduler = this;
+		currentThreadIndex = index;
+		if (m_config.pinning == ThreadPinning::pinned)
+			pinCurrentThread(index);
+
+		std::size_t failedAttempts {0uz};
+		while (m_running.load(std::memory_order::acquire)) {
+			const std::optional<Job> job {this->findJob(index)};
+			if (!job) {
+				this->idle(failedAttempts);
+				continue;
+			}
+			failedAttempts = 0uz;
+			(*job)();
+		}
+
+		currentScheduler = nullptr;
+		currentThreadIndex = 0uz;
+	}
+
+	auto Scheduler::findJob(const std::size_t index) noexcept -> std::optional<Job> {
+		if (index != 0uz) {
+			if (std::optional<Job> job {m_workers[index - 1uz]->deque.pop()})
+				return job;
+		}
+
+		if (m_injectionSize.load(std::memory_order::acquire) != 0uz) {
+			std::scoped_lock _ {m_injectionMutex};
+			if (!m_injectionQueue.empty()) {
+				const Job job {m_injectionQueue.front()};
+				m_injectionQueue.pop_front();
+				(void)m_injectionSize.fetch_sub(1uz, std::memory_order::release);
+				return job;
+			}
+		}
+
+		const std::size_t workerCount {m_workers.size()};
+		for (const auto offset : std::views::iota(0uz, workerCount)) {
+			const std::size_t victim {(index + offset) % workerCount};
+			if (victim + 1uz == index)
+				continue;
+			if (std::optional<Job> job {m_workers[victim]->deque.steal()})
+				return job;
+		}
+		return std::nullopt;
+	}
+
+	auto Scheduler::idle(std::size_t& failedAttempts) noexcept -> void {
+		++failedAttempts;
+		if (failedAttempts < m_config.spinCount || m_config.sleepPolicy == SleepPolicy::spin) {
+			_mm_pause();
+			return;
+		}
+		if (m_config.sleepPolicy == SleepPolicy::yield) {
+			std::this_thread::yield();
+			return;
+		}
+
+		const std::uint32_t epoch {m_wakeEpoch.load(std::memory_order::acquire)};
+		(void)m_sleepingCount.fetch_add(1uz, std::memory_order::seq_cst);
+		std::atomic_thread_fence(std::memory_order::seq_cst);
+		const bool hasWork {m_injectionSize.load(std::memory_order::seq_cst) != 0uz
+			|| std::ranges::any_of(m_workers, [](const auto& worker) {return !worker->deque.isEmpty();})
+		};
+		if (!hasWork && m_running.load(std::memory_order::acquire))
+			m_wakeEpoch.wait(epoch, std::memory_order::acquire);
+		(void)m_sleepingCount.fetch_sub(1uz, std::memory_order::seq_cst);
+		failedAttempts = 0uz;
+	}
+
+	auto Scheduler::wakeUp(const std::size_t count) noexcept -> void {
+		std::atomic_thread_fence(std::memory_order::seq_cst);
+		if (m_sleepingCount.load(std::memory_order::seq_cst) == 0uz)
+			return;
+		(void)m_wakeEpoch.fetch_add(1u, std::memory_order::acq_rel);
+		if (count == 1uz)
+			m_wakeEpoch.notify_one();
+		else
+			m_wakeEpoch.notify_all();
+	}
+}
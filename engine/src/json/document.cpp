@@ -0,0 +1,639 @@
+#include "voxlet/json/document.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include <immintrin.h>
+
+
+namespace vx::json {
+	namespace {
+		constexpr std::size_t BLOCK_SIZE {64uz};
+		/* offsets are 32 bits, with room for the padded last block */
+		constexpr std::size_t MAX_TEXT_SIZE {std::numeric_limits<std::uint32_t>::max() - BLOCK_SIZE};
+
+		struct BlockMasks {
+			std::uint64_t quote;
+			std::uint64_t backslash;
+			/* `{}[]:,` */
+			std::uint64_t structural;
+			std::uint64_t whitespace;
+			/* below 0x20, which can't appear unescaped in a string */
+			std::uint64_t control;
+		};
+
+		auto isWhitespace(const char8_t character) noexcept -> bool {
+			return character == u8' ' || character == u8'\t' || character == u8'\n' || character == u8'\r';
+		}
+
+		auto isDigit(const char8_t character) noexcept -> bool {
+			return character >= u8'0' && character <= u8'9';
+		}
+
+		auto toMask(const __m256i low, const __m256i high) noexcept -> std::uint64_t {
+			return static_cast<std::uint64_t> (static_cast<std::uint32_t> (_mm256_movemask_epi8(low)))
+				| (static_cast<std::uint64_t> (static_cast<std::uint32_t> (_mm256_movemask_epi8(high))) << 32u);
+		}
+
+		auto classifyBlock(const char8_t* const block) noexcept -> BlockMasks {
+			const __m256i low {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (block))};
+			const __m256i high {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (block + 32))};
+			const auto equal {[&](const char8_t character) noexcept -> std::uint64_t {
+				const __m256i broadcast {_mm256_set1_epi8(static_cast<char> (character))};
+				return toMask(_mm256_cmpeq_epi8(low, broadcast), _mm256_cmpeq_epi8(high, broadcast));
+			}};
+			/* `[` and `]` are `{` and `}` without the 0x20 bit */
+			const __m256i caseBit {_mm256_set1_epi8(0x20)};
+			const __m256i foldedLow {_mm256_or_si256(low, caseBit)};
+			const __m256i foldedHigh {_mm256_or_si256(high, caseBit)};
+			const auto equalFolded {[&](const char8_t character) noexcept -> std::uint64_t {
+				const __m256i broadcast {_mm256_set1_epi8(static_cast<char> (character))};
+				return toMask(_mm256_cmpeq_epi8(foldedLow, broadcast), _mm256_cmpeq_epi8(foldedHigh, broadcast));
+			}};
+			/* the whitespace character with each low nibble, a byte of the high half maps to zero */
+			const __m256i whitespaceTable {_mm256_setr_epi8(
+				' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1,
+				' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1
+			)};
+			const __m256i controlLimit {_mm256_set1_epi8(0x1f)};
+			return {
+				.quote = equal(u8'"'),
+				.backslash = equal(u8'\\'),
+				.structural = equalFolded(u8'{') | equalFolded(u8'}') | equal(u8',') | equal(u8':'),
+				.whitespace = toMask(
+					_mm256_cmpeq_epi8(_mm256_shuffle_epi8(whitespaceTable, low), low),
+					_mm256_cmpeq_epi8(_mm256_shuffle_epi8(whitespaceTable, high), high)
+				),
+				.control = toMask(
+					_mm256_cmpeq_epi8(_mm256_max_epu8(low, controlLimit), controlLimit),
+					_mm256_cmpeq_epi8(_mm256_max_epu8(high, controlLimit), controlLimit)
+				)
+			};
+		}
+
+		/* each bit is the parity of the bits up to it */
+		auto prefixXor(std::uint64_t bits) noexcept -> std::uint64_t {
+			for (std::uint32_t shift {1u}; shift < 64u; shift *= 2u)
+				bits ^= bits << shift;
+			return bits;
+		}
+
+		/*
+		 * The offsets of the structural characters, the quotes and the first character of the other values,
+		 * written to `indices` which has room for one per byte of `text` and a block more, their count.
+		 */
+		auto indexText(const char8_t* const text, const std::size_t size, std::uint32_t* const indices) noexcept -> std::optional<std::size_t> {
+			std::size_t count {0uz};
+			/* carried from one block to the next, as a bit 0 or all bits */
+			std::uint64_t isEscaped {0u};
+			std::uint64_t inString {0u};
+			std::uint64_t followsValue {0u};
+			std::array<char8_t, BLOCK_SIZE> padded {};
+			for (std::size_t offset {0uz}; offset < size; offset += BLOCK_SIZE) {
+				const char8_t* block {text + offset};
+				/* the last block is padded with spaces */
+				if (size - offset < BLOCK_SIZE) {
+					padded.fill(u8' ');
+					(void)std::memcpy(padded.data(), block, size - offset);
+					block = padded.data();
+				}
+				const BlockMasks masks {classifyBlock(block)};
+
+				/* backslashes are rare, each one escapes the next character which is then not an escape itself */
+				std::uint64_t escaped {isEscaped};
+				std::uint64_t backslashes {masks.backslash & ~isEscaped};
+				isEscaped = 0u;
+				while (backslashes != 0u) {
+					const auto bit {static_cast<std::uint32_t> (std::countr_zero(backslashes))};
+					if (bit == 63u) {
+						isEscaped = 1u;
+						break;
+					}
+					escaped |= 2ull << bit;
+					backslashes &= ~(3ull << bit);
+				}
+
+				/* from an opening quote included to the closing one excluded */
+				const std::uint64_t quotes {masks.quote & ~escaped};
+				const std::uint64_t strings {prefixXor(quotes) ^ inString};
+				inString = 0u - (strings >> 63u);
+				if ((masks.control & strings) != 0u)
+					return std::nullopt;
+				const std::uint64_t values {~(masks.structural | masks.whitespace | quotes | strings)};
+				const std::uint64_t valueStarts {values & ~((values << 1u) | followsValue)};
+				followsValue = values >> 63u;
+				std::uint64_t indexed {(masks.structural & ~strings) | quotes | valueStarts};
+
+				/* written 8 at a time whether they're there or not, so that the branch follows the count rather than each bit */
+				const auto indexedCount {static_cast<std::size_t> (std::popcount(indexed))};
+				for (std::size_t written {0uz}; written < indexedCount; written += 8uz) {
+					for (std::size_t i {0uz}; i < 8uz; ++i) {
+						indices[count + written + i] = static_cast<std::uint32_t> (offset + static_cast<std::size_t> (std::countr_zero(indexed)));
+						indexed &= indexed - 1u;
+					}
+				}
+				count += indexedCount;
+			}
+			if (inString != 0u)
+				return std::nullopt;
+			return count;
+		}
+
+		auto appendUtf8(char8_t* const out, const std::uint32_t codePoint) noexcept -> std::size_t {
+			if (codePoint < 0x80u) {
+				out[0] = static_cast<char8_t> (codePoint);
+				return 1uz;
+			}
+			if (codePoint < 0x800u) {
+				out[0] = static_cast<char8_t> (0xc0u | (codePoint >> 6u));
+				out[1] = static_cast<char8_t> (0x80u | (codePoint & 0x3fu));
+				return 2uz;
+			}
+			if (codePoint < 0x1'0000u) {
+				out[0] = static_cast<char8_t> (0xe0u | (codePoint >> 12u));
+				out[1] = static_cast<char8_t> (0x80u | ((codePoint >> 6u) & 0x3fu));
+				out[2] = static_cast<char8_t> (0x80u | (codePoint & 0x3fu));
+				return 3uz;
+			}
+			out[0] = static_cast<char8_t> (0xf0u | (codePoint >> 18u));
+			out[1] = static_cast<char8_t> (0x80u | ((codePoint >> 12u) & 0x3fu));
+			out[2] = static_cast<char8_t> (0x80u | ((codePoint >> 6u) & 0x3fu));
+			out[3] = static_cast<char8_t> (0x80u | (codePoint & 0x3fu));
+			return 4uz;
+		}
+
+		/* the 4 hexadecimal digits after `\u` */
+		auto readCodeUnit(const char8_t* const begin, const char8_t* const end) noexcept -> std::optional<std::uint32_t> {
+			if (end - begin < 4)
+				return std::nullopt;
+			std::uint32_t value {0u};
+			const auto result {std::from_chars(reinterpret_cast<const char*> (begin), reinterpret_cast<const char*> (begin + 4), value, 16)};
+			if (result.ec != std::errc{} || result.ptr != reinterpret_cast<const char*> (begin + 4) || begin[0] == u8'+' || begin[0] == u8'-')
+				return std::nullopt;
+			return value;
+		}
+
+		/*
+		 * Decodes the escape sequences of a string to `out`, which has room for its raw size since a sequence is
+		 * never shorter than what it decodes to. With a null `out` the sequences are only checked.
+		 */
+		auto decodeString(const char8_t* begin, const char8_t* const end, char8_t* out) noexcept -> std::optional<std::size_t> {
+			std::size_t size {0uz};
+			std::array<char8_t, 4uz> scratch {};
+			while (begin != end) {
+				const auto* const backslash {static_cast<const char8_t*> (std::memchr(begin, '\\', static_cast<std::size_t> (end - begin)))};
+				const char8_t* const plainEnd {backslash == nullptr ? end : backslash};
+				if (out != nullptr && plainEnd != begin)
+					(void)std::memcpy(out + size, begin, static_cast<std::size_t> (plainEnd - begin));
+				size += static_cast<std::size_t> (plainEnd - begin);
+				if (backslash == nullptr)
+					break;
+				if (end - backslash < 2)
+					return std::nullopt;
+
+				char8_t* const destination {out != nullptr ? out + size : scratch.data()};
+				begin = backslash + 2;
+				switch (backslash[1]) {
+					case u8'"':
+					case u8'\\':
+					case u8'/':
+						destination[0] = backslash[1];
+						++size;
+						continue;
+					case u8'b':
+						destination[0] = u8'\b';
+						++size;
+						continue;
+					case u8'f':
+						destination[0] = u8'\f';
+						++size;
+						continue;
+					case u8'n':
+						destination[0] = u8'\n';
+						++size;
+						continue;
+					case u8'r':
+						destination[0] = u8'\r';
+						++size;
+						continue;
+					case u8't':
+						destination[0] = u8'\t';
+						++size;
+						continue;
+					case u8'u':
+						break;
+					default:
+						return std::nullopt;
+				}
+
+				const std::optional<std::uint32_t> unit {readCodeUnit(begin, end)};
+				if (!unit || (*unit >= 0xdc00u && *unit <= 0xdfffu))
+					return std::nullopt;
+				begin += 4;
+				std::uint32_t codePoint {*unit};
+				/* a high surrogate must be followed by the low one */
+				if (*unit >= 0xd800u && *unit <= 0xdbffu) {
+					if (end - begin < 6 || begin[0] != u8'\\' || begin[1] != u8'u')
+						return std::nullopt;
+					const std::optional<std::uint32_t> low {readCodeUnit(begin + 2, end)};
+					if (!low || *low < 0xdc00u || *low > 0xdfffu)
+						return std::nullopt;
+					begin += 6;
+					codePoint = 0x1'0000u + ((*unit - 0xd800u) << 10u) + (*low - 0xdc00u);
+				}
+				size += appendUtf8(destination, codePoint);
+			}
+			return size;
+		}
+
+		constexpr std::array<std::uint64_t, 9> POWERS_OF_10 {1u, 10u, 100u, 1'000u, 10'000u, 100'000u, 1'000'000u, 10'000'000u, 100'000'000u};
+
+		/* how many of the 8 bytes loaded little endian are digits before the first one that isn't */
+		auto countDigits(const std::uint64_t chunk) noexcept -> std::uint32_t {
+			constexpr std::uint64_t HIGH_NIBBLES {0xf0f0'f0f0'f0f0'f0f0u};
+			constexpr std::uint64_t ZEROES {0x3030'3030'3030'3030u};
+			/* a digit is 0x3? and stays so when 6 is added, carries only start past a byte that isn't a digit */
+			const std::uint64_t nonDigits {((chunk & HIGH_NIBBLES) ^ ZEROES) | (((chunk + 0x0606'0606'0606'0606u) & HIGH_NIBBLES) ^ ZEROES)};
+			return static_cast<std::uint32_t> (std::countr_zero(nonDigits)) / 8u;
+		}
+
+		/* the value of the first `count` digits of `chunk`, pairs of digits then pairs of pairs are merged by multiplications */
+		auto parseDigits(const std::uint64_t chunk, const std::uint32_t count) noexcept -> std::uint64_t {
+			/* the digits are moved to the top, the bytes shifted in are leading zeroes */
+			std::uint64_t digits {(chunk - 0x3030'3030'3030'3030u) << (64u - 8u * count)};
+			digits = (digits * 10u + (digits >> 8u)) & 0x00ff'00ff'00ff'00ffu;
+			digits = (digits * 100u + (digits >> 16u)) & 0x0000'ffff'0000'ffffu;
+			return (digits * 10'000u + (digits >> 32u)) & 0xffff'ffffu;
+		}
+
+		/* writes the number starting at `begin` to `node`, returns where it ends, `nullptr` if it isn't JSON */
+		auto parseNumber(const char8_t* const begin, const char8_t* const end, internal::Node& node) noexcept -> const char8_t* {
+			const char8_t* position {begin};
+			const bool isNegative {position != end && *position == u8'-'};
+			if (isNegative)
+				++position;
+			if (position == end || !isDigit(*position))
+				return nullptr;
+			std::uint64_t magnitude {0u};
+			/* a leading zero is the whole integer part, a digit after it ends the number where it can't end */
+			const char8_t* const digits {position};
+			if (*position == u8'0')
+				++position;
+			else {
+				/* 8 at a time while there's room to load them, so that the length of a number isn't a branch per digit */
+				while (end - position >= 8) {
+					std::uint64_t chunk {};
+					(void)std::memcpy(&chunk, position, sizeof(chunk));
+					const std::uint32_t count {countDigits(chunk)};
+					if (count == 0u)
+						break;
+					magnitude = magnitude * POWERS_OF_10[count] + parseDigits(chunk, count);
+					position += count;
+					if (count < 8u)
+						break;
+				}
+				for (; position != end && isDigit(*position); ++position)
+					magnitude = magnitude * 10u + static_cast<std::uint64_t> (*position - u8'0');
+			}
+			/* 19 digits always fit in 64 bits, and more never fit in `std::int64_t` */
+			const bool fits {position - digits <= 19};
+
+			bool isInteger {true};
+			if (position != end && *position == u8'.') {
+				++position;
+				if (position == end || !isDigit(*position))
+					return nullptr;
+				while (position != end && isDigit(*position))
+					++position;
+				isInteger = false;
+			}
+			if (position != end && (*position == u8'e' || *position == u8'E')) {
+				++position;
+				if (position != end && (*position == u8'+' || *position == u8'-'))
+					++position;
+				if (position == end || !isDigit(*position))
+					return nullptr;
+				while (position != end && isDigit(*position))
+					++position;
+				isInteger = false;
+			}
+
+			const std::uint64_t limit {isNegative ? 1ull << 63u : static_cast<std::uint64_t> (std::numeric_limits<std::int64_t>::max())};
+			/* `-0` is kept as a double, the only one of the two with a sign */
+			if (isInteger && fits && magnitude <= limit && (!isNegative || magnitude != 0u)) {
+				node = {.payload = isNegative ? 0u - magnitude : magnitude, .size = 0u, .type = Type::number, .flag = true};
+				return position;
+			}
+			/* magnitudes past a double are rejected rather than rounded to infinity */
+			double value {};
+			const auto result {std::from_chars(reinterpret_cast<const char*> (begin), reinterpret_cast<const char*> (position), value)};
+			if (result.ec != std::errc{})
+				return nullptr;
+			node = {.payload = std::bit_cast<std::uint64_t> (value), .size = 0u, .type = Type::number, .flag = false};
+			return position;
+		}
+
+		auto parseScalar(const char8_t* const begin, const char8_t* const end, internal::Node& node) noexcept -> const char8_t* {
+			const auto matches {[&](const std::u8string_view literal) noexcept -> bool {
+				return static_cast<std::size_t> (end - begin) >= literal.size() && std::memcmp(begin, literal.data(), literal.size()) == 0;
+			}};
+			switch (*begin) {
+				case u8't':
+					node = {.payload = 1u, .size = 0u, .type = Type::boolean, .flag = false};
+					return matches(u8"true") ? begin + 4 : nullptr;
+				case u8'f':
+					node = {.payload = 0u, .size = 0u, .type = Type::boolean, .flag = false};
+					return matches(u8"false") ? begin + 5 : nullptr;
+				case u8'n':
+					node = {.payload = 0u, .size = 0u, .type = Type::null, .flag = false};
+					return matches(u8"null") ? begin + 4 : nullptr;
+				default:
+					return parseNumber(begin, end, node);
+			}
+		}
+
+		/* checks the grammar on the offsets of the first pass and writes the tape */
+		auto parseTape(
+			const char8_t* const text,
+			const std::size_t size,
+			const std::span<const std::uint32_t> indices,
+			std::vector<internal::Node>& nodes
+		) noexcept -> bool {
+			const char8_t* const end {text + size};
+			/* the containers the next value goes into */
+			std::vector<std::uint32_t> containers {};
+			std::size_t next {0uz};
+
+			/* a string goes from its opening quote to the closing one, the next offset */
+			const auto parseString {[&](const std::uint32_t open) noexcept -> bool {
+				if (next == indices.size())
+					return false;
+				const std::uint32_t close {indices[next++]};
+				const char8_t* const begin {text + open + 1u};
+				const std::size_t length {close - open - 1u};
+				const bool hasEscapes {length != 0uz && std::memchr(begin, '\\', length) != nullptr};
+				if (hasEscapes && !decodeString(begin, begin + length, nullptr))
+					return false;
+				nodes.push_back({.payload = open + 1u, .size = static_cast<std::uint32_t> (length), .type = Type::string, .flag = hasEscapes});
+				return true;
+			}};
+			/* `"key":` where a member starts */
+			const auto parseKey {[&]() noexcept -> bool {
+				if (next == indices.size() || text[indices[next]] != u8'"')
+					return false;
+				if (!parseString(indices[next++]))
+					return false;
+				return next != indices.size() && text[indices[next++]] == u8':';
+			}};
+
+			bool isExpectingValue {true};
+			while (true) {
+				if (isExpectingValue) {
+					if (next == indices.size())
+						return false;
+					const std::uint32_t position {indices[next++]};
+					if (!containers.empty())
+						++nodes[containers.back()].size;
+					const char8_t character {text[position]};
+					isExpectingValue = false;
+
+					if (character == u8'{' || character == u8'[') {
+						const bool isObject {character == u8'{'};
+						containers.push_back(static_cast<std::uint32_t> (nodes.size()));
+						nodes.push_back({.payload = 0u, .size = 0u, .type = isObject ? Type::object : Type::array, .flag = false});
+						if (next != indices.size() && text[indices[next]] == (isObject ? u8'}' : u8']')) {
+							++next;
+							nodes.back().payload = nodes.size();
+							containers.pop_back();
+						}
+						else if (isObject && !parseKey())
+							return false;
+						else
+							isExpectingValue = true;
+						continue;
+					}
+					if (character == u8'"') {
+						if (!parseString(position))
+							return false;
+						continue;
+					}
+					internal::Node node {};
+					const char8_t* const valueEnd {parseScalar(text + position, end, node)};
+					/* the value has to end right before whitespace or the next offset */
+					const bool isTerminated {valueEnd != nullptr && (
+						valueEnd == end
+						|| isWhitespace(*valueEnd)
+						|| (next != indices.size() && valueEnd == text + indices[next])
+					)};
+					if (!isTerminated)
+						return false;
+					nodes.push_back(node);
+					continue;
+				}
+
+				if (containers.empty())
+					return next == indices.size();
+				if (next == indices.size())
+					return false;
+				const char8_t character {text[indices[next++]]};
+				internal::Node& container {nodes[containers.back()]};
+				const bool isObject {container.type == Type::object};
+				if (character == u8',') {
+					if (isObject && !parseKey())
+						return false;
+					isExpectingValue = true;
+				}
+				else if (character == (isObject ? u8'}' : u8']')) {
+					container.payload = nodes.size();
+					containers.pop_back();
+				}
+				else
+					return false;
+			}
+		}
+	}
+
+
+	auto Value::getType() const noexcept -> Type {
+		const internal::Node* const node {this->getNode()};
+		return node == nullptr ? Type::null : node->type;
+	}
+
+	auto Value::asBoolean() const noexcept -> std::optional<bool> {
+		const internal::Node* const node {this->getNode()};
+		if (node == nullptr || node->type != Type::boolean)
+			return std::nullopt;
+		return node->payload != 0u;
+	}
+
+	auto Value::asNumber() const noexcept -> std::optional<double> {
+		const internal::Node* const node {this->getNode()};
+		if (node == nullptr || node->type != Type::number)
+			return std::nullopt;
+		if (node->flag)
+			return static_cast<double> (std::bit_cast<std::int64_t> (node->payload));
+		return std::bit_cast<double> (node->payload);
+	}
+
+	auto Value::asInteger() const noexcept -> std::optional<std::int64_t> {
+		const internal::Node* const node {this->getNode()};
+		if (node == nullptr || node->type != Type::number || !node->flag)
+			return std::nullopt;
+		return std::bit_cast<std::int64_t> (node->payload);
+	}
+
+	auto Value::asString() const noexcept -> std::optional<vx::containers::views::UncheckedStringSlice> {
+		const internal::Node* const node {this->getNode()};
+		if (node == nullptr || node->type != Type::string)
+			return std::nullopt;
+		return m_document->m_text.slice(node->payload, node->payload + node->size);
+	}
+
+	auto Value::hasEscapes() const noexcept -> bool {
+		const internal::Node* const node {this->getNode()};
+		return node != nullptr && node->type == Type::string && node->flag;
+	}
+
+	auto Value::unescape() const noexcept -> std::optional<vx::String> {
+		const std::optional<vx::containers::views::UncheckedStringSlice> raw {this->asString()};
+		if (!raw)
+			return std::nullopt;
+		if (!this->hasEscapes())
+			return vx::String::from(*raw);
+		/* checked while parsing */
+		std::vector<char8_t> decoded (raw->getSize());
+		const std::size_t size {*decodeString(raw->begin(), raw->end(), decoded.data())};
+		vx::String string {};
+		string.resize(size);
+		std::ranges::copy(std::span{decoded}.first(size), string.begin());
+		return string;
+	}
+
+	auto Value::getSize() const noexcept -> std::size_t {
+		const internal::Node* const node {this->getNode()};
+		if (node == nullptr || (node->type != Type::array && node->type != Type::object))
+			return 0uz;
+		return node->size;
+	}
+
+	auto Value::operator[](const vx::StringSlice& key) const noexcept -> Value {
+		for (const Member member : this->getMembers()) {
+			if (!member.value.m_document->m_nodes[member.value.m_node - 1u].flag) {
+				if (std::ranges::equal(member.key, key))
+					return member.value;
+				continue;
+			}
+			/* escaped keys are rare enough to be decoded to compare them */
+			const Value keyValue {m_document, member.value.m_node - 1u};
+			const std::optional<vx::String> decoded {keyValue.unescape()};
+			if (decoded && std::ranges::equal(*decoded, key))
+				return member.value;
+		}
+		return {};
+	}
+
+	auto Value::operator[](const std::size_t index) const noexcept -> Value {
+		if (index >= this->getSize() || this->getType() != Type::array)
+			return {};
+		std::uint32_t node {m_node + 1u};
+		for (std::size_t i {0uz}; i < index; ++i)
+			node = m_document->getNext(node);
+		return {m_document, node};
+	}
+
+	auto Value::getElements() const noexcept -> Elements {
+		const internal::Node* const node {this->getNode()};
+		if (node == nullptr || node->type != Type::array)
+			return {nullptr, 0u, 0u};
+		return {m_document, m_node + 1u, static_cast<std::uint32_t> (node->payload)};
+	}
+
+	auto Value::getMembers() const noexcept -> Members {
+		const internal::Node* const node {this->getNode()};
+		if (node == nullptr || node->type != Type::object)
+			return {nullptr, 0u, 0u};
+		return {m_document, m_node + 1u, static_cast<std::uint32_t> (node->payload)};
+	}
+
+	auto Value::getNode() const noexcept -> const internal::Node* {
+		if (m_document == nullptr)
+			return nullptr;
+		return &m_document->m_nodes[m_node];
+	}
+
+
+	auto Elements::Iterator::operator*() const noexcept -> Value {
+		return {m_document, m_node};
+	}
+
+	auto Elements::Iterator::operator++() noexcept -> Iterator& {
+		m_node = m_document->getNext(m_node);
+		return *this;
+	}
+
+	auto Elements::Iterator::operator++(int) noexcept -> Iterator {
+		const Iterator previous {*this};
+		++*this;
+		return previous;
+	}
+
+
+	auto Members::Iterator::operator*() const noexcept -> Member {
+		const internal::Node& key {m_document->m_nodes[m_node]};
+		return {
+			.key = m_document->m_text.slice(key.payload, key.payload + key.size),
+			.value = {m_document, m_node + 1u}
+		};
+	}
+
+	auto Members::Iterator::operator++() noexcept -> Iterator& {
+		m_node = m_document->getNext(m_node + 1u);
+		return *this;
+	}
+
+	auto Members::Iterator::operator++(int) noexcept -> Iterator {
+		const Iterator previous {*this};
+		++*this;
+		return previous;
+	}
+
+
+	auto Document::parse(const vx::StringSlice& text) noexcept -> std::optional<Document> {
+		const std::size_t size {text.getSize()};
+		if (size == 0uz || size > MAX_TEXT_SIZE)
+			return std::nullopt;
+		const char8_t* const data {std::to_address(text.unchecked().begin())};
+		/* left uninitialised so that only the pages the offsets reach are touched */
+		const auto indices {std::make_unique_for_overwrite<std::uint32_t[]> (size + BLOCK_SIZE)};
+		const std::optional<std::size_t> count {indexText(data, size, indices.get())};
+		if (!count)
+			return std::nullopt;
+
+		Document document {};
+		document.m_text = text.unchecked();
+		/* most documents have a few offsets per value, for the quotes, commas and colons */
+		document.m_nodes.reserve(*count / 2uz + 1uz);
+		if (!parseTape(data, size, {indices.get(), *count}, document.m_nodes))
+			return std::nullopt;
+		return document;
+	}
+
+	auto Document::getRoot() const noexcept -> Value {
+		return {this, 0u};
+	}
+
+	auto Document::getNext(const std::uint32_t node) const noexcept -> std::uint32_t {
+		const internal::Node& current {m_nodes[node]};
+		if (current.type == Type::array || current.type == Type::object)
+			return static_cast<std::uint32_t> (current.payload);
+		return node + 1u;
+	}
+}
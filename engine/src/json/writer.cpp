@@ -0,0 +1,30 @@
+#include "voxlet/json/writer.hpp"
+
+#include <bit>
+
+#include <immintrin.h>
+
+
+namespace vx::json::internal {
+	auto findEscape(const char8_t* const text, const std::size_t size) noexcept -> std::size_t {
+		const __m256i quote {_mm256_set1_epi8('"')};
+		const __m256i backslash {_mm256_set1_epi8('\\')};
+		const __m256i controlLimit {_mm256_set1_epi8(0x1f)};
+		std::size_t offset {0uz};
+		for (; offset + 32uz <= size; offset += 32uz) {
+			const __m256i characters {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (text + offset))};
+			const __m256i isEscaped {_mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(characters, quote), _mm256_cmpeq_epi8(characters, backslash)),
+				_mm256_cmpeq_epi8(_mm256_max_epu8(characters, controlLimit), controlLimit)
+			)};
+			const auto mask {static_cast<std::uint32_t> (_mm256_movemask_epi8(isEscaped))};
+			if (mask != 0u)
+				return offset + static_cast<std::size_t> (std::countr_zero(mask));
+		}
+		for (; offset < size; ++offset) {
+			if (text[offset] == u8'"' || text[offset] == u8'\\' || text[offset] < 0x20u)
+				return offset;
+		}
+		return size;
+	}
+}
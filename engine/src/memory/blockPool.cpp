@@ -0,0 +1,47 @@
+#include "voxlet/memory/blockPool.hpp"
+
+#include <bit>
+#include <cassert>
+#include <new>
+
+
+namespace vx::memory {
+	BlockPool::BlockPool(const std::size_t blockSize, const std::size_t blocksPerSlab) noexcept :
+		m_blockSize {blockSize},
+		m_blocksPerSlab {blocksPerSlab},
+		m_usedCount {0uz},
+		m_freeBlocks {nullptr},
+		m_slabs {}
+	{
+		assert(std::has_single_bit(m_blockSize) && m_blockSize >= sizeof(FreeBlock));
+		assert(m_blocksPerSlab != 0uz);
+	}
+
+	BlockPool::~BlockPool() {
+		for (void* const slab : m_slabs)
+			::operator delete(slab, std::align_val_t{m_blockSize});
+	}
+
+
+	auto BlockPool::allocate() noexcept -> void* {
+		if (m_freeBlocks == nullptr) {
+			void* const slab {::operator new(m_blockSize * m_blocksPerSlab, std::align_val_t{m_blockSize})};
+			m_slabs.push_back(slab);
+			auto* const bytes {static_cast<std::byte*> (slab)};
+			for (std::size_t i {m_blocksPerSlab}; i != 0uz; --i)
+				m_freeBlocks = new (bytes + (i - 1uz) * m_blockSize) FreeBlock{m_freeBlocks};
+		}
+		FreeBlock* const block {m_freeBlocks};
+		m_freeBlocks = block->next;
+		++m_usedCount;
+		return block;
+	}
+
+	auto BlockPool::deallocate(void* const block) noexcept -> void {
+		if (block == nullptr)
+			return;
+		assert(m_usedCount != 0uz);
+		m_freeBlocks = new (block) FreeBlock{m_freeBlocks};
+		--m_usedCount;
+	}
+}
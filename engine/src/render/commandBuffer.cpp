@@ -0,0 +1,217 @@
+#include "voxlet/render/commandBuffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+#include "voxlet/memory.hpp"
+
+
+namespace vx::render {
+	namespace {
+		auto applyState(const RenderState& renderState, GlStateCache& state) noexcept -> void {
+			state.useProgram(renderState.program);
+			state.bindVertexArray(renderState.vertexArray);
+			for (GLuint unit {0u}; const TextureBinding& binding : renderState.textures) {
+				if (binding.target != 0u)
+					state.bindTextureUnit(unit, binding.target, binding.texture);
+				++unit;
+			}
+			state.setEnabled(GL_DEPTH_TEST, renderState.depthTest);
+			state.setEnabled(GL_BLEND, renderState.blend);
+			if (renderState.blend)
+				state.blendFunc(renderState.blendSource, renderState.blendDestination);
+		}
+	}
+
+
+	CommandBuffer::CommandBuffer() noexcept :
+		m_blockPool {BLOCK_SIZE, 16uz},
+		m_blocks {},
+		m_cursor {nullptr},
+		m_end {nullptr},
+		m_entries {},
+		m_scratch {},
+		m_sorted {true}
+	{}
+
+	CommandBuffer::~CommandBuffer() {
+		this->clear();
+	}
+
+
+	auto CommandBuffer::draw(const std::uint64_t key, const DrawCommand& command) noexcept -> void {
+		this->record(key, CommandType::draw, command);
+	}
+
+	auto CommandBuffer::drawIndexed(const std::uint64_t key, const DrawIndexedCommand& command) noexcept -> void {
+		this->record(key, CommandType::drawIndexed, command);
+	}
+
+	auto CommandBuffer::clearFramebuffer(const std::uint64_t key, const ClearCommand& command) noexcept -> void {
+		this->record(key, CommandType::clear, command);
+	}
+
+	auto CommandBuffer::setViewport(const std::uint64_t key, const ViewportCommand& command) noexcept -> void {
+		this->record(key, CommandType::viewport, command);
+	}
+
+
+	auto CommandBuffer::sort() noexcept -> void {
+		if (m_sorted)
+			return;
+		m_scratch.resize(m_entries.size());
+		radixSort(m_entries, m_scratch);
+		m_sorted = true;
+	}
+
+	auto CommandBuffer::clear() noexcept -> void {
+		for (void* const block : m_blocks)
+			m_blockPool.deallocate(block);
+		m_blocks.clear();
+		m_cursor = nullptr;
+		m_end = nullptr;
+		m_entries.clear();
+		m_sorted = true;
+	}
+
+
+	template <typename T>
+	requires std::is_trivially_copyable_v<T>
+	auto CommandBuffer::record(const std::uint64_t key, const CommandType type, const T& command) noexcept -> void {
+		constexpr std::size_t PAYLOAD_OFFSET {vx::memory::alignUp(sizeof(Header), alignof(T))};
+		static_assert(PAYLOAD_OFFSET + sizeof(T) <= BLOCK_SIZE, "Command is too big for a command buffer block");
+
+		std::byte* const memory {this->allocate(PAYLOAD_OFFSET + sizeof(T), std::max(alignof(Header), alignof(T)))};
+		(void)std::construct_at(reinterpret_cast<Header*> (memory), Header{type});
+		(void)std::construct_at(reinterpret_cast<T*> (memory + PAYLOAD_OFFSET), command);
+		if (!m_entries.empty() && key < m_entries.back().key)
+			m_sorted = false;
+		m_entries.push_back(SortEntry{key, reinterpret_cast<std::uintptr_t> (memory)});
+	}
+
+	template <typename T>
+	auto CommandBuffer::getPayload(const Header& header) noexcept -> const T& {
+		const auto* const payload {reinterpret_cast<const std::byte*> (&header) + vx::memory::alignUp(sizeof(Header), alignof(T))};
+		return *reinterpret_cast<const T*> (payload);
+	}
+
+	auto CommandBuffer::allocate(const std::size_t size, const std::size_t alignment) noexcept -> std::byte* {
+		assert(size <= BLOCK_SIZE);
+		auto address {vx::memory::alignUp(reinterpret_cast<std::uintptr_t> (m_cursor), alignment)};
+		if (m_cursor == nullptr || address + size > reinterpret_cast<std::uintptr_t> (m_end)) {
+			m_blocks.push_back(m_blockPool.allocate());
+			m_cursor = static_cast<std::byte*> (m_blocks.back());
+			m_end = m_cursor + BLOCK_SIZE;
+			address = reinterpret_cast<std::uintptr_t> (m_cursor);
+		}
+		auto* const memory {reinterpret_cast<std::byte*> (address)};
+		m_cursor = memory + size;
+		return memory;
+	}
+
+
+	CommandQueue::CommandQueue() noexcept :
+		m_entries {},
+		m_runs {}
+	{}
+
+
+	auto CommandQueue::merge(const std::span<CommandBuffer* const> buffers) noexcept -> void {
+		/* k-way merge with a min-heap of the runs, ties go to the first buffer to keep the merge stable */
+		const auto greater {[](const Run& lhs, const Run& rhs) noexcept {
+			if (lhs.current->key != rhs.current->key)
+				return lhs.current->key > rhs.current->key;
+			return lhs.index > rhs.index;
+		}};
+
+		m_entries.clear();
+		m_runs.clear();
+		std::size_t count {0uz};
+		for (std::size_t i {0uz}; i < buffers.size(); ++i) {
+			assert(buffers[i]->isSorted());
+			const auto entries {buffers[i]->getEntries()};
+			count += entries.size();
+			if (!entries.empty())
+				m_runs.push_back(Run{entries.data(), entries.data() + entries.size(), i});
+		}
+		m_entries.reserve(count);
+		std::ranges::make_heap(m_runs, greater);
+
+		while (!m_runs.empty()) {
+			std::ranges::pop_heap(m_runs, greater);
+			Run& run {m_runs.back()};
+			/* copy the whole stretch which sorts before the next run */
+			const SortEntry* end {run.current + 1};
+			if (m_runs.size() == 1uz)
+				end = run.end;
+			else {
+				const Run& next {m_runs.front()};
+				const std::uint64_t limit {next.current->key};
+				const bool inclusive {run.index < next.index};
+				while (end != run.end && (end->key < limit || (inclusive && end->key == limit)))
+					++end;
+			}
+			m_entries.insert(m_entries.end(), run.current, end);
+			run.current = end;
+			if (run.current == run.end)
+				m_runs.pop_back();
+			else
+				std::ranges::push_heap(m_runs, greater);
+		}
+	}
+
+	auto CommandQueue::execute(GlStateCache& state) noexcept -> void {
+		using Header = CommandBuffer::Header;
+		for (const SortEntry& entry : m_entries) {
+			const Header& header {*reinterpret_cast<const Header*> (entry.value)};
+			switch (header.type) {
+				case CommandType::draw: {
+					const auto& command {CommandBuffer::getPayload<DrawCommand> (header)};
+					applyState(command.state, state);
+					glDrawArraysInstancedBaseInstance(
+						command.mode,
+						command.first,
+						command.count,
+						command.instanceCount,
+						command.baseInstance
+					);
+					break;
+				}
+				case CommandType::drawIndexed: {
+					const auto& command {CommandBuffer::getPayload<DrawIndexedCommand> (header)};
+					applyState(command.state, state);
+					glDrawElementsInstancedBaseVertexBaseInstance(
+						command.mode,
+						command.count,
+						command.indexType,
+						reinterpret_cast<const void*> (command.indexOffset),
+						command.instanceCount,
+						command.baseVertex,
+						command.baseInstance
+					);
+					break;
+				}
+				case CommandType::clear: {
+					const auto& command {CommandBuffer::getPayload<ClearCommand> (header)};
+					if ((command.mask & GL_COLOR_BUFFER_BIT) != 0u)
+						glClearColor(command.color[0], command.color[1], command.color[2], command.color[3]);
+					if ((command.mask & GL_DEPTH_BUFFER_BIT) != 0u)
+						glClearDepthf(command.depth);
+					glClear(command.mask);
+					break;
+				}
+				case CommandType::viewport: {
+					const auto& command {CommandBuffer::getPayload<ViewportCommand> (header)};
+					state.viewport(command.x, command.y, command.width, command.height);
+					break;
+				}
+			}
+		}
+	}
+
+	auto CommandQueue::submit(const std::span<CommandBuffer* const> buffers, GlStateCache& state) noexcept -> void {
+		this->merge(buffers);
+		this->execute(state);
+	}
+}
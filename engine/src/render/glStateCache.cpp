@@ -0,0 +1,155 @@
+#include "voxlet/render/glStateCache.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace vx::render {
+	namespace {
+		template <std::size_t N>
+		auto findIndex(const std::array<GLenum, N>& values, const GLenum value) noexcept -> std::size_t {
+			return static_cast<std::size_t> (std::ranges::find(values, value) - values.begin());
+		}
+	}
+
+
+	GlStateCache::GlStateCache() noexcept :
+		m_stats {0uz, 0uz},
+		m_program {},
+		m_vertexArray {},
+		m_activeTexture {},
+		m_buffers {},
+		m_textures {},
+		m_capabilities {},
+		m_blendFunc {},
+		m_viewport {}
+	{
+		this->invalidate();
+	}
+
+
+	template <typename T>
+	auto GlStateCache::update(T& current, const T& value) noexcept -> bool {
+		if (current == value) {
+			++m_stats.elidedCount;
+			return false;
+		}
+		++m_stats.issuedCount;
+		current = value;
+		return true;
+	}
+
+
+	auto GlStateCache::useProgram(const GLuint program) noexcept -> void {
+		if (this->update(m_program, program))
+			glUseProgram(program);
+	}
+
+	auto GlStateCache::bindVertexArray(const GLuint array) noexcept -> void {
+		if (!this->update(m_vertexArray, array))
+			return;
+		glBindVertexArray(array);
+		/* the element array binding belongs to the vertex array */
+		m_buffers[findIndex(BUFFER_TARGETS, GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+	}
+
+	auto GlStateCache::bindBuffer(const GLenum target, const GLuint buffer) noexcept -> void {
+		const std::size_t index {findIndex(BUFFER_TARGETS, target)};
+		if (index == BUFFER_TARGETS.size()) {
+			++m_stats.issuedCount;
+			glBindBuffer(target, buffer);
+		}
+		else if (this->update(m_buffers[index], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	auto GlStateCache::activeTexture(const GLenum unit) noexcept -> void {
+		assert(unit >= GL_TEXTURE0 && unit < GL_TEXTURE0 + TEXTURE_UNIT_COUNT);
+		if (this->update(m_activeTexture, unit))
+			glActiveTexture(unit);
+	}
+
+	auto GlStateCache::bindTexture(const GLenum target, const GLuint texture) noexcept -> void {
+		const std::size_t index {findIndex(TEXTURE_TARGETS, target)};
+		/* an unknown unit could be any of them */
+		if (index == TEXTURE_TARGETS.size() || m_activeTexture == UNKNOWN) {
+			++m_stats.issuedCount;
+			glBindTexture(target, texture);
+			if (index != TEXTURE_TARGETS.size()) {
+				for (auto& unit : m_textures)
+					unit[index] = UNKNOWN;
+			}
+		}
+		else if (this->update(m_textures[m_activeTexture - GL_TEXTURE0][index], texture))
+			glBindTexture(target, texture);
+	}
+
+	auto GlStateCache::bindTextureUnit(const GLuint unit, const GLenum target, const GLuint texture) noexcept -> void {
+		assert(unit < TEXTURE_UNIT_COUNT);
+		const std::size_t index {findIndex(TEXTURE_TARGETS, target)};
+		if (index != TEXTURE_TARGETS.size() && m_textures[unit][index] == texture) {
+			++m_stats.elidedCount;
+			return;
+		}
+		this->activeTexture(GL_TEXTURE0 + unit);
+		this->bindTexture(target, texture);
+	}
+
+	auto GlStateCache::setEnabled(const GLenum capability, const bool enabled) noexcept -> void {
+		const std::size_t index {findIndex(CAPABILITIES, capability)};
+		if (index == CAPABILITIES.size())
+			++m_stats.issuedCount;
+		else if (!this->update(m_capabilities[index], static_cast<GLuint> (enabled)))
+			return;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	auto GlStateCache::blendFunc(const GLenum source, const GLenum destination) noexcept -> void {
+		if (this->update(m_blendFunc, std::array{source, destination}))
+			glBlendFunc(source, destination);
+	}
+
+	auto GlStateCache::viewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height) noexcept -> void {
+		if (this->update(m_viewport, std::array{x, y, width, height}))
+			glViewport(x, y, width, height);
+	}
+
+
+	auto GlStateCache::forgetProgram(const GLuint program) noexcept -> void {
+		/* a deleted program stays in use until another one replaces it, but its name may be reused */
+		if (m_program == program)
+			m_program = UNKNOWN;
+	}
+
+	auto GlStateCache::forgetVertexArray(const GLuint array) noexcept -> void {
+		if (m_vertexArray != array)
+			return;
+		m_vertexArray = 0u;
+		m_buffers[findIndex(BUFFER_TARGETS, GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+	}
+
+	auto GlStateCache::forgetBuffer(const GLuint buffer) noexcept -> void {
+		std::ranges::replace(m_buffers, buffer, 0u);
+	}
+
+	auto GlStateCache::forgetTexture(const GLuint texture) noexcept -> void {
+		for (auto& unit : m_textures)
+			std::ranges::replace(unit, texture, 0u);
+	}
+
+	auto GlStateCache::invalidate() noexcept -> void {
+		m_program = UNKNOWN;
+		m_vertexArray = UNKNOWN;
+		m_activeTexture = UNKNOWN;
+		m_buffers.fill(UNKNOWN);
+		for (auto& unit : m_textures)
+			unit.fill(UNKNOWN);
+		m_capabilities.fill(UNKNOWN);
+		m_blendFunc.fill(UNKNOWN);
+		m_viewport = {0, 0, -1, -1};
+	}
+}
@@ -0,0 +1,359 @@
+#include "voxlet/render/glStub.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <type_traits>
+
+
+namespace vx::render {
+	struct GlStubFunctions {
+		static inline GlStub* s_active {nullptr};
+
+		template <typename T>
+		static auto toArgument(const T value) noexcept -> std::uint64_t {
+			if constexpr (std::is_pointer_v<T>)
+				return reinterpret_cast<std::uintptr_t> (value);
+			else if constexpr (std::is_floating_point_v<T>)
+				return std::bit_cast<std::uint32_t> (static_cast<float> (value));
+			else
+				return static_cast<std::uint64_t> (value);
+		}
+
+		template <typename... Args>
+		static auto record(const std::string_view name, const Args... args) noexcept -> GlStub& {
+			assert(s_active != nullptr);
+			if (s_active->m_recording) {
+				const std::array<std::uint64_t, sizeof...(Args)> arguments {toArgument(args)...};
+				s_active->record(name, arguments);
+			}
+			return *s_active;
+		}
+
+		static auto findBoundBuffer(GlStub& stub, const GLenum target) noexcept -> std::vector<std::byte>& {
+			return stub.m_buffers[stub.getBoundBuffer(target)];
+		}
+
+
+		static auto APIENTRY getString(const GLenum name) -> const GLubyte* {
+			switch (name) {
+				case GL_VENDOR: return reinterpret_cast<const GLubyte*> ("voxlet");
+				case GL_RENDERER: return reinterpret_cast<const GLubyte*> ("voxlet gl stub");
+				case GL_VERSION: return reinterpret_cast<const GLubyte*> ("4.6.0 voxlet gl stub");
+				case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*> ("4.60");
+				default: return nullptr;
+			}
+		}
+
+		static auto APIENTRY getStringi(const GLenum name, const GLuint) -> const GLubyte* {
+			/* glad refuses a context without extensions */
+			return name == GL_EXTENSIONS ? reinterpret_cast<const GLubyte*> ("GL_VOXLET_gl_stub") : nullptr;
+		}
+
+		static auto APIENTRY getIntegerv(const GLenum name, GLint* const data) -> void {
+			switch (name) {
+				case GL_NUM_EXTENSIONS: *data = 1; break;
+				case GL_MAJOR_VERSION: *data = 4; break;
+				case GL_MINOR_VERSION: *data = 6; break;
+				default: *data = 0; break;
+			}
+		}
+
+
+		static auto APIENTRY genBuffers(const GLsizei count, GLuint* const buffers) -> void {
+			GlStub& stub {record("glGenBuffers", count, buffers)};
+			for (GLsizei i {0}; i < count; ++i) {
+				buffers[i] = stub.createName();
+				(void)stub.m_buffers[buffers[i]];
+			}
+		}
+
+		static auto APIENTRY deleteBuffers(const GLsizei count, const GLuint* const buffers) -> void {
+			GlStub& stub {record("glDeleteBuffers", count, buffers)};
+			for (GLsizei i {0}; i < count; ++i)
+				(void)stub.m_buffers.erase(buffers[i]);
+		}
+
+		static auto APIENTRY bindBuffer(const GLenum target, const GLuint buffer) -> void {
+			record("glBindBuffer", target, buffer).m_boundBuffers[target] = buffer;
+		}
+
+		static auto APIENTRY bufferData(const GLenum target, const GLsizeiptr size, const void* const data, const GLenum usage)
+			-> void
+		{
+			std::vector<std::byte>& buffer {findBoundBuffer(record("glBufferData", target, size, data, usage), target)};
+			buffer.assign(static_cast<std::size_t> (size), std::byte{0});
+			if (data != nullptr)
+				std::ranges::copy_n(static_cast<const std::byte*> (data), size, buffer.begin());
+		}
+
+		static auto APIENTRY bufferSubData(const GLenum target, const GLintptr offset, const GLsizeiptr size, const void* const data)
+			-> void
+		{
+			std::vector<std::byte>& buffer {findBoundBuffer(record("glBufferSubData", target, offset, size, data), target)};
+			assert(static_cast<std::size_t> (offset + size) <= buffer.size());
+			std::ranges::copy_n(static_cast<const std::byte*> (data), size, buffer.begin() + offset);
+		}
+
+
+		static auto APIENTRY bufferStorage(const GLenum target, const GLsizeiptr size, const void* const data, const GLbitfield flags)
+			-> void
+		{
+			std::vector<std::byte>& buffer {findBoundBuffer(record("glBufferStorage", target, size, data, flags), target)};
+			/* the storage is immutable, so mapped pointers stay valid */
+			buffer.assign(static_cast<std::size_t> (size), std::byte{0});
+			if (data != nullptr)
+				std::ranges::copy_n(static_cast<const std::byte*> (data), size, buffer.begin());
+		}
+
+		static auto APIENTRY mapBufferRange(const GLenum target, const GLintptr offset, const GLsizeiptr length, const GLbitfield access)
+			-> void*
+		{
+			std::vector<std::byte>& buffer {findBoundBuffer(record("glMapBufferRange", target, offset, length, access), target)};
+			if (static_cast<std::size_t> (offset + length) > buffer.size())
+				return nullptr;
+			return buffer.data() + offset;
+		}
+
+		static auto APIENTRY unmapBuffer(const GLenum target) -> GLboolean {
+			(void)record("glUnmapBuffer", target);
+			return GL_TRUE;
+		}
+
+
+		static auto APIENTRY fenceSync(const GLenum condition, const GLbitfield flags) -> GLsync {
+			GlStub& stub {record("glFenceSync", condition, flags)};
+			const std::uintptr_t fence {stub.createName()};
+			stub.m_fences.emplace(fence, stub.m_fenceCount++);
+			return reinterpret_cast<GLsync> (fence);
+		}
+
+		static auto APIENTRY clientWaitSync(const GLsync sync, const GLbitfield flags, const GLuint64 timeout) -> GLenum {
+			GlStub& stub {record("glClientWaitSync", sync, flags, timeout)};
+			const auto it {stub.m_fences.find(reinterpret_cast<std::uintptr_t> (sync))};
+			if (it == stub.m_fences.end())
+				return GL_WAIT_FAILED;
+			if (stub.m_fenceCount - it->second > stub.m_fenceLatency)
+				return GL_ALREADY_SIGNALED;
+			if (timeout == 0u)
+				return GL_TIMEOUT_EXPIRED;
+			/* the wait lasts until the GPU reached the fence */
+			++stub.m_stallCount;
+			it->second = stub.m_fenceCount - stub.m_fenceLatency - 1uz;
+			return GL_CONDITION_SATISFIED;
+		}
+
+		static auto APIENTRY deleteSync(const GLsync sync) -> void {
+			(void)record("glDeleteSync", sync).m_fences.erase(reinterpret_cast<std::uintptr_t> (sync));
+		}
+
+
+		static auto APIENTRY genVertexArrays(const GLsizei count, GLuint* const arrays) -> void {
+			GlStub& stub {record("glGenVertexArrays", count, arrays)};
+			for (GLsizei i {0}; i < count; ++i)
+				arrays[i] = stub.createName();
+		}
+
+		static auto APIENTRY deleteVertexArrays(const GLsizei count, const GLuint* const arrays) -> void {
+			(void)record("glDeleteVertexArrays", count, arrays);
+		}
+
+		static auto APIENTRY bindVertexArray(const GLuint array) -> void {
+			(void)record("glBindVertexArray", array);
+		}
+
+		static auto APIENTRY enableVertexAttribArray(const GLuint index) -> void {
+			(void)record("glEnableVertexAttribArray", index);
+		}
+
+		static auto APIENTRY vertexAttribPointer(
+			const GLuint index,
+			const GLint size,
+			const GLenum type,
+			const GLboolean normalized,
+			const GLsizei stride,
+			const void* const pointer
+		) -> void {
+			(void)record("glVertexAttribPointer", index, size, type, normalized, stride, pointer);
+		}
+
+		static auto APIENTRY vertexAttribDivisor(const GLuint index, const GLuint divisor) -> void {
+			(void)record("glVertexAttribDivisor", index, divisor);
+		}
+
+
+		static auto APIENTRY useProgram(const GLuint program) -> void {
+			(void)record("glUseProgram", program);
+		}
+
+		static auto APIENTRY activeTexture(const GLenum texture) -> void {
+			(void)record("glActiveTexture", texture);
+		}
+
+		static auto APIENTRY bindTexture(const GLenum target, const GLuint texture) -> void {
+			(void)record("glBindTexture", target, texture);
+		}
+
+		static auto APIENTRY enable(const GLenum capability) -> void {
+			(void)record("glEnable", capability);
+		}
+
+		static auto APIENTRY disable(const GLenum capability) -> void {
+			(void)record("glDisable", capability);
+		}
+
+		static auto APIENTRY blendFunc(const GLenum source, const GLenum destination) -> void {
+			(void)record("glBlendFunc", source, destination);
+		}
+
+		static auto APIENTRY viewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height) -> void {
+			(void)record("glViewport", x, y, width, height);
+		}
+
+		static auto APIENTRY clearColor(const GLfloat red, const GLfloat green, const GLfloat blue, const GLfloat alpha) -> void {
+			(void)record("glClearColor", red, green, blue, alpha);
+		}
+
+		static auto APIENTRY clearDepthf(const GLfloat depth) -> void {
+			(void)record("glClearDepthf", depth);
+		}
+
+		static auto APIENTRY clear(const GLbitfield mask) -> void {
+			(void)record("glClear", mask);
+		}
+
+		static auto APIENTRY drawArrays(const GLenum mode, const GLint first, const GLsizei count) -> void {
+			(void)record("glDrawArrays", mode, first, count);
+		}
+
+		static auto APIENTRY drawArraysInstancedBaseInstance(
+			const GLenum mode,
+			const GLint first,
+			const GLsizei count,
+			const GLsizei instanceCount,
+			const GLuint baseInstance
+		) -> void {
+			(void)record("glDrawArraysInstancedBaseInstance", mode, first, count, instanceCount, baseInstance);
+		}
+
+		static auto APIENTRY drawElementsInstancedBaseVertexBaseInstance(
+			const GLenum mode,
+			const GLsizei count,
+			const GLenum type,
+			const void* const indices,
+			const GLsizei instanceCount,
+			const GLint baseVertex,
+			const GLuint baseInstance
+		) -> void {
+			(void)record(
+				"glDrawElementsInstancedBaseVertexBaseInstance",
+				mode,
+				count,
+				type,
+				indices,
+				instanceCount,
+				baseVertex,
+				baseInstance
+			);
+		}
+
+
+		static auto getProc(const char* const name) -> void* {
+			struct Proc {
+				std::string_view name;
+				void* function;
+			};
+			static const std::array PROCS {
+				Proc{"glGetString", reinterpret_cast<void*> (&getString)},
+				Proc{"glGetStringi", reinterpret_cast<void*> (&getStringi)},
+				Proc{"glGetIntegerv", reinterpret_cast<void*> (&getIntegerv)},
+				Proc{"glGenBuffers", reinterpret_cast<void*> (&genBuffers)},
+				Proc{"glDeleteBuffers", reinterpret_cast<void*> (&deleteBuffers)},
+				Proc{"glBindBuffer", reinterpret_cast<void*> (&bindBuffer)},
+				Proc{"glBufferData", reinterpret_cast<void*> (&bufferData)},
+				Proc{"glBufferSubData", reinterpret_cast<void*> (&bufferSubData)},
+				Proc{"glBufferStorage", reinterpret_cast<void*> (&bufferStorage)},
+				Proc{"glMapBufferRange", reinterpret_cast<void*> (&mapBufferRange)},
+				Proc{"glUnmapBuffer", reinterpret_cast<void*> (&unmapBuffer)},
+				Proc{"glFenceSync", reinterpret_cast<void*> (&fenceSync)},
+				Proc{"glClientWaitSync", reinterpret_cast<void*> (&clientWaitSync)},
+				Proc{"glDeleteSync", reinterpret_cast<void*> (&deleteSync)},
+				Proc{"glGenVertexArrays", reinterpret_cast<void*> (&genVertexArrays)},
+				Proc{"glDeleteVertexArrays", reinterpret_cast<void*> (&deleteVertexArrays)},
+				Proc{"glBindVertexArray", reinterpret_cast<void*> (&bindVertexArray)},
+				Proc{"glEnableVertexAttribArray", reinterpret_cast<void*> (&enableVertexAttribArray)},
+				Proc{"glVertexAttribPointer", reinterpret_cast<void*> (&vertexAttribPointer)},
+				Proc{"glVertexAttribDivisor", reinterpret_cast<void*> (&vertexAttribDivisor)},
+				Proc{"glUseProgram", reinterpret_cast<void*> (&useProgram)},
+				Proc{"glActiveTexture", reinterpret_cast<void*> (&activeTexture)},
+				Proc{"glBindTexture", reinterpret_cast<void*> (&bindTexture)},
+				Proc{"glEnable", reinterpret_cast<void*> (&enable)},
+				Proc{"glDisable", reinterpret_cast<void*> (&disable)},
+				Proc{"glBlendFunc", reinterpret_cast<void*> (&blendFunc)},
+				Proc{"glViewport", reinterpret_cast<void*> (&viewport)},
+				Proc{"glClearColor", reinterpret_cast<void*> (&clearColor)},
+				Proc{"glClearDepthf", reinterpret_cast<void*> (&clearDepthf)},
+				Proc{"glClear", reinterpret_cast<void*> (&clear)},
+				Proc{"glDrawArrays", reinterpret_cast<void*> (&drawArrays)},
+				Proc{"glDrawArraysInstancedBaseInstance", reinterpret_cast<void*> (&drawArraysInstancedBaseInstance)},
+				Proc{
+					"glDrawElementsInstancedBaseVertexBaseInstance",
+					reinterpret_cast<void*> (&drawElementsInstancedBaseVertexBaseInstance)
+				},
+			};
+			const auto it {std::ranges::find(PROCS, std::string_view{name}, &Proc::name)};
+			return it == PROCS.end() ? nullptr : it->function;
+		}
+	};
+
+
+	GlStub::GlStub() noexcept :
+		m_calls {},
+		m_recording {true},
+		m_nextName {1u},
+		m_buffers {},
+		m_boundBuffers {},
+		m_fences {},
+		m_fenceCount {0uz},
+		m_fenceLatency {1uz},
+		m_stallCount {0uz}
+	{
+		assert(GlStubFunctions::s_active == nullptr);
+		GlStubFunctions::s_active = this;
+	}
+
+	GlStub::~GlStub() {
+		GlStubFunctions::s_active = nullptr;
+	}
+
+
+	auto GlStub::getLoadProc() noexcept -> GLADloadproc {
+		return +[](const char* const name) -> void* {return GlStubFunctions::getProc(name);};
+	}
+
+	auto GlStub::load() noexcept -> bool {
+		return gladLoadGLLoader(GlStub::getLoadProc()) != 0;
+	}
+
+
+	auto GlStub::getCallCount(const std::string_view name) const noexcept -> std::size_t {
+		return static_cast<std::size_t> (std::ranges::count(m_calls, name, &Call::name));
+	}
+
+	auto GlStub::getBufferData(const GLuint buffer) const noexcept -> std::span<const std::byte> {
+		const auto it {m_buffers.find(buffer)};
+		return it == m_buffers.end() ? std::span<const std::byte> {} : std::span<const std::byte> {it->second};
+	}
+
+	auto GlStub::getBoundBuffer(const GLenum target) const noexcept -> GLuint {
+		const auto it {m_boundBuffers.find(target)};
+		return it == m_boundBuffers.end() ? 0u : it->second;
+	}
+
+
+	auto GlStub::record(const std::string_view name, const std::span<const std::uint64_t> arguments) noexcept -> void {
+		Call call {name, {}};
+		std::ranges::copy(arguments, call.arguments.begin());
+		m_calls.push_back(call);
+	}
+}
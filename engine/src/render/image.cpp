@@ -0,0 +1,36 @@
+#include "voxlet/render/image.hpp"
+
+#include <algorithm>
+
+
+namespace vx::render {
+	Image::Image() noexcept :
+		m_width {0u},
+		m_height {0u},
+		m_pixels {}
+	{}
+
+	Image::Image(const std::uint32_t width, const std::uint32_t height, const std::uint32_t color) noexcept :
+		m_width {width},
+		m_height {height},
+		m_pixels (static_cast<std::size_t> (width) * height, color)
+	{}
+
+
+	auto Image::fill(const std::uint32_t color) noexcept -> void {
+		std::ranges::fill(m_pixels, color);
+	}
+
+
+	IndexedImage::IndexedImage() noexcept :
+		m_width {0u},
+		m_height {0u},
+		m_indices (PADDING, 0u)
+	{}
+
+	IndexedImage::IndexedImage(const std::uint32_t width, const std::uint32_t height, const std::uint8_t index) noexcept :
+		m_width {width},
+		m_height {height},
+		m_indices (static_cast<std::size_t> (width) * height + PADDING, index)
+	{}
+}
@@ -0,0 +1,498 @@
+#include "voxlet/render/softwareRenderer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <immintrin.h>
+
+#include "voxlet/jobs/parallelFor.hpp"
+
+
+namespace vx::render {
+	namespace {
+		constexpr std::uint32_t WHITE {0xffff'ffffu};
+		constexpr std::uint32_t LAYER_BIT {0x8000'0000u};
+
+		/* a run of pixels of one row, `u` is the 16.16 texture coordinate of the first one */
+		struct Span {
+			std::uint32_t* destination;
+			std::size_t count;
+			std::int32_t u;
+			std::int32_t du;
+			std::int32_t maxU;
+			std::uint32_t color;
+		};
+
+		struct Kernels {
+			auto (*fill)(const Span& span) noexcept -> void;
+			auto (*blit)(const Span& span, const std::uint32_t* row) noexcept -> void;
+			auto (*blitIndexed)(const Span& span, const std::uint8_t* row, const std::uint32_t* palette) noexcept -> void;
+		};
+
+
+		/* x * y / 255 rounded to nearest, exact for 8-bit operands */
+		[[gnu::always_inline]]
+		inline auto mul255(const std::uint32_t x, const std::uint32_t y) noexcept -> std::uint32_t {
+			const std::uint32_t t {x * y + 128u};
+			return (t + (t >> 8u)) >> 8u;
+		}
+
+		[[gnu::always_inline]]
+		inline auto modulate(const std::uint32_t texel, const std::uint32_t color) noexcept -> std::uint32_t {
+			std::uint32_t result {0u};
+			for (std::uint32_t shift {0u}; shift < 32u; shift += 8u)
+				result |= mul255((texel >> shift) & 0xffu, (color >> shift) & 0xffu) << shift;
+			return result;
+		}
+
+		/* lerps the colors by the source alpha, and the alpha towards opaque, which is "over" for alpha */
+		[[gnu::always_inline]]
+		inline auto blend(const std::uint32_t source, const std::uint32_t destination) noexcept -> std::uint32_t {
+			const std::uint32_t alpha {source >> 24u};
+			if (alpha == 0xffu)
+				return source;
+			if (alpha == 0u)
+				return destination;
+			const std::uint32_t opaque {source | 0xff00'0000u};
+			std::uint32_t result {0u};
+			for (std::uint32_t shift {0u}; shift < 32u; shift += 8u) {
+				const std::uint32_t t {((opaque >> shift) & 0xffu) * alpha + ((destination >> shift) & 0xffu) * (255u - alpha) + 128u};
+				result |= ((t + (t >> 8u)) >> 8u) << shift;
+			}
+			return result;
+		}
+
+		[[gnu::always_inline]]
+		inline auto getTexelIndex(const std::int32_t u, const std::int32_t maxU) noexcept -> std::int32_t {
+			return std::clamp(u >> 16, 0, maxU);
+		}
+
+
+		auto fillScalar(const Span& span) noexcept -> void {
+			for (std::size_t i {0uz}; i < span.count; ++i)
+				span.destination[i] = blend(span.color, span.destination[i]);
+		}
+
+		auto blitScalar(const Span& span, const std::uint32_t* const row) noexcept -> void {
+			std::int32_t u {span.u};
+			for (std::size_t i {0uz}; i < span.count; ++i, u += span.du) {
+				const std::uint32_t texel {modulate(row[getTexelIndex(u, span.maxU)], span.color)};
+				span.destination[i] = blend(texel, span.destination[i]);
+			}
+		}
+
+		auto blitIndexedScalar(const Span& span, const std::uint8_t* const row, const std::uint32_t* const palette) noexcept
+			-> void
+		{
+			std::int32_t u {span.u};
+			for (std::size_t i {0uz}; i < span.count; ++i, u += span.du) {
+				const std::uint32_t texel {modulate(palette[row[getTexelIndex(u, span.maxU)]], span.color)};
+				span.destination[i] = blend(texel, span.destination[i]);
+			}
+		}
+
+
+		/* the vector kernels round exactly like the scalar ones, so both backends draw the same pixels */
+		[[gnu::always_inline]]
+		inline auto mul255x16(const __m256i x, const __m256i y) noexcept -> __m256i {
+			const __m256i t {_mm256_add_epi16(_mm256_mullo_epi16(x, y), _mm256_set1_epi16(128))};
+			return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+		}
+
+		[[gnu::always_inline]]
+		inline auto modulate8(const __m256i texels, const __m256i color) noexcept -> __m256i {
+			const __m256i zero {_mm256_setzero_si256()};
+			const __m256i low {mul255x16(_mm256_unpacklo_epi8(texels, zero), color)};
+			const __m256i high {mul255x16(_mm256_unpackhi_epi8(texels, zero), color)};
+			return _mm256_packus_epi16(low, high);
+		}
+
+		[[gnu::always_inline]]
+		inline auto blend8(const __m256i source, const __m256i destination) noexcept -> __m256i {
+			const __m256i alpha {_mm256_srli_epi32(source, 24)};
+			const __m256i opaqueMask {_mm256_cmpeq_epi32(alpha, _mm256_set1_epi32(0xff))};
+			if (_mm256_movemask_epi8(opaqueMask) == -1)
+				return source;
+			if (_mm256_testz_si256(alpha, alpha))
+				return destination;
+
+			/* spreads the alpha of each pixel to its 4 channels, once widened to 16 bits */
+			const __m256i spreadLow {_mm256_setr_epi8(
+				3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7, -1,
+				3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7, -1
+			)};
+			const __m256i spreadHigh {_mm256_setr_epi8(
+				11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1,
+				11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1
+			)};
+			const __m256i zero {_mm256_setzero_si256()};
+			const __m256i max {_mm256_set1_epi16(255)};
+			const __m256i opaque {_mm256_or_si256(source, _mm256_set1_epi32(static_cast<int> (0xff00'0000u)))};
+
+			const auto lerp {[&](const __m256i from, const __m256i to, const __m256i factor) noexcept {
+				const __m256i t {_mm256_add_epi16(
+					_mm256_add_epi16(_mm256_mullo_epi16(to, factor), _mm256_mullo_epi16(from, _mm256_sub_epi16(max, factor))),
+					_mm256_set1_epi16(128)
+				)};
+				return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+			}};
+			const __m256i low {lerp(
+				_mm256_unpacklo_epi8(destination, zero),
+				_mm256_unpacklo_epi8(opaque, zero),
+				_mm256_shuffle_epi8(source, spreadLow)
+			)};
+			const __m256i high {lerp(
+				_mm256_unpackhi_epi8(destination, zero),
+				_mm256_unpackhi_epi8(opaque, zero),
+				_mm256_shuffle_epi8(source, spreadHigh)
+			)};
+			return _mm256_packus_epi16(low, high);
+		}
+
+		[[gnu::always_inline]]
+		inline auto spreadColor(const std::uint32_t color) noexcept -> __m256i {
+			const auto channel {[color](const std::uint32_t shift) noexcept {
+				return static_cast<short> ((color >> shift) & 0xffu);
+			}};
+			return _mm256_setr_epi16(
+				channel(0u), channel(8u), channel(16u), channel(24u), channel(0u), channel(8u), channel(16u), channel(24u),
+				channel(0u), channel(8u), channel(16u), channel(24u), channel(0u), channel(8u), channel(16u), channel(24u)
+			);
+		}
+
+		/* shared loop of the vector blits, `fetch` gathers 8 texels from clamped texel indices */
+		template <typename Fetch>
+		[[gnu::always_inline]]
+		inline auto blitAvx2(const Span& span, Fetch&& fetch) noexcept -> std::int32_t {
+			const bool modulated {span.color != WHITE};
+			const __m256i color {spreadColor(span.color)};
+			const __m256i step {_mm256_set1_epi32(span.du * 8)};
+			const __m256i maxU {_mm256_set1_epi32(span.maxU)};
+			const __m256i zero {_mm256_setzero_si256()};
+			__m256i u {_mm256_add_epi32(
+				_mm256_set1_epi32(span.u),
+				_mm256_mullo_epi32(_mm256_set1_epi32(span.du), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))
+			)};
+
+			std::size_t i {0uz};
+			for (; i + 8uz <= span.count; i += 8uz) {
+				const __m256i indices {_mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(u, 16), zero), maxU)};
+				__m256i texels {fetch(indices)};
+				if (modulated)
+					texels = modulate8(texels, color);
+				auto* const destination {reinterpret_cast<__m256i*> (span.destination + i)};
+				_mm256_storeu_si256(destination, blend8(texels, _mm256_loadu_si256(destination)));
+				u = _mm256_add_epi32(u, step);
+			}
+			return static_cast<std::int32_t> (i);
+		}
+
+		auto fillAvx2(const Span& span) noexcept -> void {
+			const __m256i color {_mm256_set1_epi32(static_cast<int> (span.color))};
+			std::size_t i {0uz};
+			for (; i + 8uz <= span.count; i += 8uz) {
+				auto* const destination {reinterpret_cast<__m256i*> (span.destination + i)};
+				_mm256_storeu_si256(destination, blend8(color, _mm256_loadu_si256(destination)));
+			}
+			fillScalar(Span{span.destination + i, span.count - i, span.u, span.du, span.maxU, span.color});
+		}
+
+		auto blitAvx2(const Span& span, const std::uint32_t* const row) noexcept -> void {
+			const std::int32_t done {blitAvx2(span, [row](const __m256i indices) noexcept {
+				return _mm256_i32gather_epi32(reinterpret_cast<const int*> (row), indices, 4);
+			})};
+			blitScalar(Span{
+				span.destination + done,
+				span.count - static_cast<std::size_t> (done),
+				span.u + done * span.du,
+				span.du,
+				span.maxU,
+				span.color
+			}, row);
+		}
+
+		auto blitIndexedAvx2(const Span& span, const std::uint8_t* const row, const std::uint32_t* const palette) noexcept
+			-> void
+		{
+			/* reads up to 3 bytes past the last index, hence the padding of `IndexedImage` */
+			const std::int32_t done {blitAvx2(span, [row, palette](const __m256i indices) noexcept {
+				const __m256i words {_mm256_i32gather_epi32(reinterpret_cast<const int*> (row), indices, 1)};
+				const __m256i colors {_mm256_and_si256(words, _mm256_set1_epi32(0xff))};
+				return _mm256_i32gather_epi32(reinterpret_cast<const int*> (palette), colors, 4);
+			})};
+			blitIndexedScalar(Span{
+				span.destination + done,
+				span.count - static_cast<std::size_t> (done),
+				span.u + done * span.du,
+				span.du,
+				span.maxU,
+				span.color
+			}, row, palette);
+		}
+
+
+		constexpr Kernels SCALAR_KERNELS {&fillScalar, &blitScalar, &blitIndexedScalar};
+		constexpr Kernels AVX2_KERNELS {&fillAvx2, &blitAvx2, &blitIndexedAvx2};
+
+		auto toFixed(const double value) noexcept -> std::int32_t {
+			return static_cast<std::int32_t> (std::floor(value * 65536.0));
+		}
+
+		auto divideFloor(const std::int64_t dividend, const std::int64_t divisor) noexcept -> std::int64_t {
+			return dividend / divisor - (dividend % divisor != 0 && (dividend < 0) != (divisor < 0) ? 1 : 0);
+		}
+	}
+
+
+	SoftwareRenderer::SoftwareRenderer(vx::jobs::Scheduler& scheduler) noexcept :
+		SoftwareRenderer {scheduler, Config{}}
+	{}
+
+	SoftwareRenderer::SoftwareRenderer(vx::jobs::Scheduler& scheduler, const Config& config) noexcept :
+		m_scheduler {&scheduler},
+		m_config {config},
+		m_textures {},
+		m_threadBuffers {},
+		m_entries {},
+		m_scratch {},
+		m_quads {},
+		m_bins {}
+	{
+		assert(m_config.tileSize != 0u);
+		m_threadBuffers.reserve(m_scheduler->getThreadCount());
+		for (std::size_t i {0uz}; i < m_scheduler->getThreadCount(); ++i)
+			m_threadBuffers.push_back(std::make_unique<ThreadBuffer> ());
+	}
+
+
+	auto SoftwareRenderer::registerTexture(const Image& image) noexcept -> GLuint {
+		m_textures.push_back(Texture{image.getPixels().data(), nullptr, nullptr, image.getWidth(), image.getHeight()});
+		return static_cast<GLuint> (m_textures.size());
+	}
+
+	auto SoftwareRenderer::registerTexture(const IndexedImage& image, const Palette& palette) noexcept -> GLuint {
+		m_textures.push_back(Texture{nullptr, image.getRow(0u), palette.data(), image.getWidth(), image.getHeight()});
+		return static_cast<GLuint> (m_textures.size());
+	}
+
+
+	auto SoftwareRenderer::acquireBuffer() noexcept -> std::pair<ThreadBuffer&, std::unique_lock<std::mutex>> {
+		const std::size_t thread {m_scheduler->getCurrentThreadIndex()};
+		ThreadBuffer& buffer {*m_threadBuffers[thread]};
+		/* the workers never share theirs, the index 0 goes to every other thread */
+		if (thread == 0uz)
+			return {buffer, std::unique_lock{buffer.mutex}};
+		return {buffer, std::unique_lock<std::mutex> {}};
+	}
+
+	auto SoftwareRenderer::submit(const Sprite& sprite) noexcept -> void {
+		auto [buffer, lock] {this->acquireBuffer()};
+		buffer.keys.push_back(SortEntry{makeSpriteKey(sprite), buffer.sprites.size()});
+		buffer.sprites.push_back(sprite);
+	}
+
+	auto SoftwareRenderer::submit(const std::span<const Sprite> sprites) noexcept -> void {
+		auto [buffer, lock] {this->acquireBuffer()};
+		buffer.keys.reserve(buffer.keys.size() + sprites.size());
+		for (const Sprite& sprite : sprites)
+			buffer.keys.push_back(SortEntry{makeSpriteKey(sprite), buffer.sprites.size() + (&sprite - sprites.data())});
+		buffer.sprites.insert(buffer.sprites.end(), sprites.begin(), sprites.end());
+	}
+
+	auto SoftwareRenderer::submit(const TileLayer& layer) noexcept -> void {
+		assert(layer.tileSize != 0u && layer.scale != 0u);
+		assert(layer.tiles.size() >= static_cast<std::size_t> (layer.columns) * layer.rows);
+		auto [buffer, lock] {this->acquireBuffer()};
+		/* the lowest key of its layer */
+		buffer.keys.push_back(SortEntry{static_cast<std::uint64_t> (layer.layer) << 56u, buffer.layers.size() | LAYER_BIT});
+		buffer.layers.push_back(layer);
+	}
+
+
+	auto SoftwareRenderer::build() noexcept -> void {
+		/* the value of an entry packs the thread buffer in its high half and the sprite or layer in the low one */
+		m_entries.clear();
+		for (std::size_t thread {0uz}; thread < m_threadBuffers.size(); ++thread) {
+			for (const SortEntry& entry : m_threadBuffers[thread]->keys)
+				m_entries.push_back(SortEntry{entry.key, static_cast<std::uint64_t> (thread) << 32u | entry.value});
+		}
+		m_scratch.resize(m_entries.size());
+		radixSort(m_entries, m_scratch);
+	}
+
+	auto SoftwareRenderer::draw(Image& target) noexcept -> void {
+		const auto width {static_cast<std::int32_t> (target.getWidth())};
+		const auto height {static_cast<std::int32_t> (target.getHeight())};
+		m_quads.clear();
+		for (const SortEntry& entry : m_entries) {
+			const ThreadBuffer& buffer {*m_threadBuffers[entry.value >> 32u]};
+			const auto index {static_cast<std::uint32_t> (entry.value)};
+			if ((index & LAYER_BIT) != 0u)
+				this->addTileLayer(buffer.layers[index & ~LAYER_BIT], width, height);
+			else
+				this->addSprite(buffer.sprites[index]);
+		}
+
+		/* bins the quads by tile, in drawing order */
+		const std::uint32_t tileSize {m_config.tileSize};
+		const std::uint32_t tileColumns {(target.getWidth() + tileSize - 1u) / tileSize};
+		const std::uint32_t tileRows {(target.getHeight() + tileSize - 1u) / tileSize};
+		m_bins.resize(static_cast<std::size_t> (tileColumns) * tileRows);
+		for (auto& bin : m_bins)
+			bin.clear();
+		for (std::uint32_t i {0u}; i < m_quads.size(); ++i) {
+			const Quad& quad {m_quads[i]};
+			if (quad.x1 <= 0 || quad.y1 <= 0 || quad.x0 >= width || quad.y0 >= height)
+				continue;
+			const auto firstColumn {static_cast<std::uint32_t> (std::max(quad.x0, 0)) / tileSize};
+			const auto lastColumn {static_cast<std::uint32_t> (std::min(quad.x1, width) - 1) / tileSize};
+			const auto firstRow {static_cast<std::uint32_t> (std::max(quad.y0, 0)) / tileSize};
+			const auto lastRow {static_cast<std::uint32_t> (std::min(quad.y1, height) - 1) / tileSize};
+			for (std::uint32_t row {firstRow}; row <= lastRow; ++row) {
+				for (std::uint32_t column {firstColumn}; column <= lastColumn; ++column)
+					m_bins[static_cast<std::size_t> (row) * tileColumns + column].push_back(i);
+			}
+		}
+
+		vx::jobs::parallelFor(*m_scheduler, 0uz, m_bins.size(), [&](const std::size_t first, const std::size_t last) noexcept {
+			for (std::size_t tile {first}; tile < last; ++tile)
+				this->drawTile(target, tile, tileColumns);
+		}, 1uz);
+		this->clear();
+	}
+
+	auto SoftwareRenderer::clear() noexcept -> void {
+		for (const auto& buffer : m_threadBuffers) {
+			buffer->keys.clear();
+			buffer->sprites.clear();
+			buffer->layers.clear();
+		}
+		m_entries.clear();
+	}
+
+
+	auto SoftwareRenderer::getSubmittedCount() const noexcept -> std::size_t {
+		std::size_t count {0uz};
+		for (const auto& buffer : m_threadBuffers)
+			count += buffer->keys.size();
+		return count;
+	}
+
+
+	auto SoftwareRenderer::addSprite(const Sprite& sprite) noexcept -> void {
+		Quad quad {
+			.x0 = static_cast<std::int32_t> (std::lround(sprite.x)),
+			.y0 = static_cast<std::int32_t> (std::lround(sprite.y)),
+			.x1 = static_cast<std::int32_t> (std::lround(sprite.x + sprite.width)),
+			.y1 = static_cast<std::int32_t> (std::lround(sprite.y + sprite.height)),
+			.u = 0,
+			.v = 0,
+			.du = 0,
+			.dv = 0,
+			.color = sprite.color,
+			.texture = sprite.texture
+		};
+		if (quad.x1 <= quad.x0 || quad.y1 <= quad.y0)
+			return;
+		if (sprite.texture != 0u) {
+			assert(sprite.texture <= m_textures.size());
+			const Texture& texture {m_textures[sprite.texture - 1u]};
+			/* sampled at pixel centers, so that integer scales repeat each texel exactly */
+			const auto width {static_cast<double> (texture.width)};
+			const auto height {static_cast<double> (texture.height)};
+			const double du {(sprite.u1 - sprite.u0) * width / (quad.x1 - quad.x0)};
+			const double dv {(sprite.v1 - sprite.v0) * height / (quad.y1 - quad.y0)};
+			quad.du = toFixed(du);
+			quad.dv = toFixed(dv);
+			quad.u = toFixed(sprite.u0 * width + du * 0.5);
+			quad.v = toFixed(sprite.v0 * height + dv * 0.5);
+		}
+		m_quads.push_back(quad);
+	}
+
+	auto SoftwareRenderer::addTileLayer(const TileLayer& layer, const std::int32_t width, const std::int32_t height) noexcept
+		-> void
+	{
+		assert(layer.tileset != 0u && layer.tileset <= m_textures.size());
+		const Texture& tileset {m_textures[layer.tileset - 1u]};
+		const std::uint32_t tilesPerRow {tileset.width / layer.tileSize};
+		if (tilesPerRow == 0u)
+			return;
+
+		/* only the cells overlapping the target */
+		const std::int64_t cellSize {static_cast<std::int64_t> (layer.tileSize) * layer.scale};
+		const auto firstColumn {std::max(divideFloor(-layer.x, cellSize), std::int64_t{0})};
+		const auto lastColumn {std::min(divideFloor(width - layer.x + cellSize - 1, cellSize), std::int64_t{layer.columns})};
+		const auto firstRow {std::max(divideFloor(-layer.y, cellSize), std::int64_t{0})};
+		const auto lastRow {std::min(divideFloor(height - layer.y + cellSize - 1, cellSize), std::int64_t{layer.rows})};
+
+		const std::int32_t step {65536 / static_cast<std::int32_t> (layer.scale)};
+		for (std::int64_t row {firstRow}; row < lastRow; ++row) {
+			for (std::int64_t column {firstColumn}; column < lastColumn; ++column) {
+				const std::uint16_t tile {layer.tiles[static_cast<std::size_t> (row * layer.columns + column)]};
+				if (tile == 0u)
+					continue;
+				const std::uint32_t texelX {(tile - 1u) % tilesPerRow * layer.tileSize};
+				const std::uint32_t texelY {(tile - 1u) / tilesPerRow * layer.tileSize};
+				const auto x {static_cast<std::int32_t> (layer.x + column * cellSize)};
+				const auto y {static_cast<std::int32_t> (layer.y + row * cellSize)};
+				m_quads.push_back(Quad{
+					.x0 = x,
+					.y0 = y,
+					.x1 = x + static_cast<std::int32_t> (cellSize),
+					.y1 = y + static_cast<std::int32_t> (cellSize),
+					.u = static_cast<std::int32_t> (texelX << 16u) + step / 2,
+					.v = static_cast<std::int32_t> (texelY << 16u) + step / 2,
+					.du = step,
+					.dv = step,
+					.color = layer.color,
+					.texture = layer.tileset
+				});
+			}
+		}
+	}
+
+	auto SoftwareRenderer::drawTile(Image& target, const std::size_t tile, const std::uint32_t tileColumns) const noexcept
+		-> void
+	{
+		const Kernels& kernels {m_config.backend == RasterBackend::avx2 ? AVX2_KERNELS : SCALAR_KERNELS};
+		const auto tileX {static_cast<std::int32_t> (tile % tileColumns * m_config.tileSize)};
+		const auto tileY {static_cast<std::int32_t> (tile / tileColumns * m_config.tileSize)};
+		const std::int32_t tileRight {std::min(tileX + static_cast<std::int32_t> (m_config.tileSize), static_cast<std::int32_t> (target.getWidth()))};
+		const std::int32_t tileBottom {std::min(tileY + static_cast<std::int32_t> (m_config.tileSize), static_cast<std::int32_t> (target.getHeight()))};
+
+		for (const std::uint32_t index : m_bins[tile]) {
+			const Quad& quad {m_quads[index]};
+			const std::int32_t x0 {std::max(quad.x0, tileX)};
+			const std::int32_t x1 {std::min(quad.x1, tileRight)};
+			const std::int32_t y0 {std::max(quad.y0, tileY)};
+			const std::int32_t y1 {std::min(quad.y1, tileBottom)};
+			if (x0 >= x1 || y0 >= y1)
+				continue;
+
+			const Texture* const texture {quad.texture == 0u ? nullptr : &m_textures[quad.texture - 1u]};
+			Span span {
+				.destination = nullptr,
+				.count = static_cast<std::size_t> (x1 - x0),
+				.u = quad.u + (x0 - quad.x0) * quad.du,
+				.du = quad.du,
+				.maxU = texture == nullptr ? 0 : static_cast<std::int32_t> (texture->width) - 1,
+				.color = quad.color
+			};
+			for (std::int32_t y {y0}; y < y1; ++y) {
+				span.destination = target.getRow(static_cast<std::uint32_t> (y)) + x0;
+				if (texture == nullptr) {
+					kernels.fill(span);
+					continue;
+				}
+				const std::int32_t v {quad.v + (y - quad.y0) * quad.dv};
+				const auto texelY {static_cast<std::size_t> (getTexelIndex(v, static_cast<std::int32_t> (texture->height) - 1))};
+				if (texture->pixels != nullptr)
+					kernels.blit(span, texture->pixels + texelY * texture->width);
+				else
+					kernels.blitIndexed(span, texture->indices + texelY * texture->width, texture->palette);
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#include "voxlet/render/sortKey.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+
+namespace vx::render {
+	auto radixSort(std::span<SortEntry> entries, std::span<SortEntry> scratch) noexcept -> void {
+		assert(scratch.size() >= entries.size());
+		constexpr std::size_t PASS_COUNT {sizeof(std::uint64_t)};
+		constexpr std::size_t BUCKET_COUNT {256uz};
+		if (entries.size() < 2uz)
+			return;
+
+		/* one read of the keys builds the histograms of every pass */
+		std::array<std::array<std::uint32_t, BUCKET_COUNT>, PASS_COUNT> histograms {};
+		for (const SortEntry& entry : entries) {
+			for (std::size_t pass {0uz}; pass < PASS_COUNT; ++pass)
+				++histograms[pass][(entry.key >> (pass * 8uz)) & 0xff];
+		}
+
+		SortEntry* source {entries.data()};
+		SortEntry* destination {scratch.data()};
+		for (std::size_t pass {0uz}; pass < PASS_COUNT; ++pass) {
+			std::array<std::uint32_t, BUCKET_COUNT>& histogram {histograms[pass]};
+			const std::size_t shift {pass * 8uz};
+			if (histogram[(source[0].key >> shift) & 0xff] == entries.size())
+				continue;
+
+			std::uint32_t offset {0u};
+			for (std::uint32_t& count : histogram)
+				offset += std::exchange(count, offset);
+			for (std::size_t i {0uz}; i < entries.size(); ++i)
+				destination[histogram[(source[i].key >> shift) & 0xff]++] = source[i];
+			std::swap(source, destination);
+		}
+
+		if (source != entries.data())
+			std::ranges::copy(std::span{source, entries.size()}, entries.begin());
+	}
+}
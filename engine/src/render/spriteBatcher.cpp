@@ -0,0 +1,196 @@
+#include "voxlet/render/spriteBatcher.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+
+#include "voxlet/memory.hpp"
+
+
+namespace vx::render {
+	auto makeSpriteKey(const Sprite& sprite) noexcept -> std::uint64_t {
+		constexpr std::uint64_t DEPTH_MAX {(1u << 24u) - 1u};
+		const auto depth {static_cast<std::uint64_t> (std::clamp(sprite.depth, 0.f, 1.f) * static_cast<float> (DEPTH_MAX))};
+		return static_cast<std::uint64_t> (sprite.layer) << 56u
+			| static_cast<std::uint64_t> (sprite.program & 0xfffu) << 44u
+			| static_cast<std::uint64_t> (sprite.texture & 0xf'ffffu) << 24u
+			| depth;
+	}
+
+
+	SpriteBatcher::SpriteBatcher(vx::jobs::Scheduler& scheduler) noexcept :
+		m_scheduler {&scheduler},
+		m_threadBuffers {},
+		m_entries {},
+		m_scratch {},
+		m_instances {},
+		m_batches {},
+		m_vertexArray {0u},
+		m_stream {}
+	{
+		m_threadBuffers.reserve(m_scheduler->getThreadCount());
+		for (std::size_t i {0uz}; i < m_scheduler->getThreadCount(); ++i)
+			m_threadBuffers.push_back(std::make_unique<ThreadBuffer> ());
+	}
+
+	SpriteBatcher::~SpriteBatcher() {
+		if (m_vertexArray != 0u)
+			glDeleteVertexArrays(1, &m_vertexArray);
+	}
+
+
+	auto SpriteBatcher::acquireBuffer() noexcept -> std::pair<ThreadBuffer&, std::unique_lock<std::mutex>> {
+		const std::size_t thread {m_scheduler->getCurrentThreadIndex()};
+		ThreadBuffer& buffer {*m_threadBuffers[thread]};
+		/* the workers never share theirs, the index 0 goes to every other thread */
+		if (thread == 0uz)
+			return {buffer, std::unique_lock{buffer.mutex}};
+		return {buffer, std::unique_lock<std::mutex> {}};
+	}
+
+	auto SpriteBatcher::submit(const Sprite& sprite) noexcept -> void {
+		auto [buffer, lock] {this->acquireBuffer()};
+		buffer.keys.push_back(SortEntry{makeSpriteKey(sprite), buffer.sprites.size()});
+		buffer.sprites.push_back(sprite);
+	}
+
+	auto SpriteBatcher::submit(const std::span<const Sprite> sprites) noexcept -> void {
+		auto [buffer, lock] {this->acquireBuffer()};
+		buffer.keys.reserve(buffer.keys.size() + sprites.size());
+		for (const Sprite& sprite : sprites)
+			buffer.keys.push_back(SortEntry{makeSpriteKey(sprite), buffer.sprites.size() + (&sprite - sprites.data())});
+		buffer.sprites.insert(buffer.sprites.end(), sprites.begin(), sprites.end());
+	}
+
+
+	auto SpriteBatcher::build() noexcept -> void {
+		/* the value of an entry packs the thread buffer in its high half and the sprite in the low one */
+		m_entries.clear();
+		for (std::size_t thread {0uz}; thread < m_threadBuffers.size(); ++thread) {
+			for (const SortEntry& entry : m_threadBuffers[thread]->keys)
+				m_entries.push_back(SortEntry{entry.key, static_cast<std::uint64_t> (thread) << 32u | entry.value});
+		}
+		m_scratch.resize(m_entries.size());
+		radixSort(m_entries, m_scratch);
+
+		m_instances.resize(m_entries.size());
+		m_batches.clear();
+		for (std::size_t i {0uz}; i < m_entries.size(); ++i) {
+			const std::uint64_t value {m_entries[i].value};
+			const Sprite& sprite {m_threadBuffers[value >> 32u]->sprites[value & 0xffff'ffffu]};
+			m_instances[i] = SpriteInstance{
+				{sprite.x, sprite.y, sprite.width, sprite.height},
+				{sprite.u0, sprite.v0, sprite.u1, sprite.v1},
+				sprite.color,
+				sprite.depth
+			};
+			if (m_batches.empty() || m_batches.back().program != sprite.program || m_batches.back().texture != sprite.texture)
+				m_batches.push_back(Batch{sprite.program, sprite.texture, static_cast<std::uint32_t> (i), 0u});
+			++m_batches.back().count;
+		}
+	}
+
+	auto SpriteBatcher::draw() noexcept -> void {
+		GlStateCache state {};
+		this->draw(state);
+	}
+
+	auto SpriteBatcher::draw(GlStateCache& state) noexcept -> void {
+		if (m_instances.empty()) {
+			this->clear();
+			return;
+		}
+		if (!m_stream || m_stream->getFrameSize() < (m_instances.size() + 1uz) * sizeof(SpriteInstance)) {
+			if (!this->createObjects(m_instances.size(), state)) {
+				this->clear();
+				return;
+			}
+		}
+
+		const std::size_t size {m_instances.size() * sizeof(SpriteInstance)};
+		m_stream->beginFrame();
+		const auto allocation {m_stream->allocate(size, sizeof(SpriteInstance))};
+		assert(allocation);
+		vx::memory::memcpy(reinterpret_cast<SpriteInstance*> (allocation->data), m_instances.data(), m_instances.size());
+		const auto baseInstance {static_cast<GLuint> (allocation->offset / sizeof(SpriteInstance))};
+		state.bindVertexArray(m_vertexArray);
+
+		state.activeTexture(GL_TEXTURE0);
+		for (const Batch& batch : m_batches) {
+			state.useProgram(batch.program);
+			state.bindTexture(GL_TEXTURE_2D, batch.texture);
+			glDrawArraysInstancedBaseInstance(
+				GL_TRIANGLE_STRIP,
+				0,
+				4,
+				static_cast<GLsizei> (batch.count),
+				baseInstance + batch.first
+			);
+		}
+		m_stream->endFrame();
+		this->clear();
+	}
+
+	auto SpriteBatcher::clear() noexcept -> void {
+		for (const auto& buffer : m_threadBuffers) {
+			buffer->keys.clear();
+			buffer->sprites.clear();
+		}
+		m_instances.clear();
+		m_batches.clear();
+	}
+
+
+	auto SpriteBatcher::getSubmittedCount() const noexcept -> std::size_t {
+		std::size_t count {0uz};
+		for (const auto& buffer : m_threadBuffers)
+			count += buffer->sprites.size();
+		return count;
+	}
+
+
+	auto SpriteBatcher::createObjects(const std::size_t instanceCount, GlStateCache& state) noexcept -> bool {
+		constexpr std::size_t MIN_FRAME_INSTANCE_COUNT {1uz << 16uz};
+		/* one more instance leaves room for aligning the region to whole instances */
+		m_stream.reset();
+		m_stream = StreamingBuffer::create(StreamingBuffer::Config{
+			.frameSize = std::bit_ceil(std::max(instanceCount + 1uz, MIN_FRAME_INSTANCE_COUNT)) * sizeof(SpriteInstance)
+		});
+		if (!m_stream)
+			return false;
+
+		if (m_vertexArray == 0u)
+			glGenVertexArrays(1, &m_vertexArray);
+		state.bindVertexArray(m_vertexArray);
+		/* `create` bound the buffer behind the cache, which can only skip this if it already is the one bound */
+		state.bindBuffer(GL_ARRAY_BUFFER, m_stream->getBuffer());
+
+		struct Attribute {
+			GLint size;
+			GLenum type;
+			GLboolean normalized;
+			std::size_t offset;
+		};
+		constexpr Attribute ATTRIBUTES[] {
+			{4, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, rect)},
+			{4, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, uv)},
+			{4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(SpriteInstance, color)},
+			{1, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, depth)},
+		};
+		for (GLuint index {0u}; const Attribute& attribute : ATTRIBUTES) {
+			glEnableVertexAttribArray(index);
+			glVertexAttribPointer(
+				index,
+				attribute.size,
+				attribute.type,
+				attribute.normalized,
+				static_cast<GLsizei> (sizeof(SpriteInstance)),
+				reinterpret_cast<const void*> (attribute.offset)
+			);
+			glVertexAttribDivisor(index, 1u);
+			++index;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,128 @@
+#include "voxlet/render/streamingBuffer.hpp"
+
+#include <cassert>
+#include <utility>
+
+
+namespace vx::render {
+	namespace {
+		constexpr GLbitfield MAPPING_FLAGS {GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+		constexpr GLuint64 WAIT_TIMEOUT {1'000'000u};
+	}
+
+
+	StreamingBuffer::StreamingBuffer(StreamingBuffer&& other) noexcept :
+		m_config {other.m_config},
+		m_buffer {std::exchange(other.m_buffer, 0u)},
+		m_mapping {std::exchange(other.m_mapping, nullptr)},
+		m_fences {std::move(other.m_fences)},
+		m_frame {other.m_frame},
+		m_cursor {other.m_cursor},
+		m_stallCount {other.m_stallCount}
+	{
+		other.m_fences.clear();
+	}
+
+	auto StreamingBuffer::operator=(StreamingBuffer&& other) noexcept -> StreamingBuffer& {
+		if (this == &other)
+			return *this;
+		this->release();
+		m_config = other.m_config;
+		m_buffer = std::exchange(other.m_buffer, 0u);
+		m_mapping = std::exchange(other.m_mapping, nullptr);
+		m_fences = std::exchange(other.m_fences, {});
+		m_frame = other.m_frame;
+		m_cursor = other.m_cursor;
+		m_stallCount = other.m_stallCount;
+		return *this;
+	}
+
+	StreamingBuffer::~StreamingBuffer() {
+		this->release();
+	}
+
+
+	auto StreamingBuffer::create(const Config& config) noexcept -> std::optional<StreamingBuffer> {
+		assert(config.frameSize != 0uz && config.frameCount != 0uz);
+		if (glBufferStorage == nullptr || glMapBufferRange == nullptr || glFenceSync == nullptr)
+			return std::nullopt;
+
+		const auto size {static_cast<GLsizeiptr> (config.frameSize * config.frameCount)};
+		GLuint buffer {0u};
+		glGenBuffers(1, &buffer);
+		glBindBuffer(config.target, buffer);
+		glBufferStorage(config.target, size, nullptr, MAPPING_FLAGS);
+		void* const mapping {glMapBufferRange(config.target, 0, size, MAPPING_FLAGS)};
+		if (mapping == nullptr) {
+			glDeleteBuffers(1, &buffer);
+			return std::nullopt;
+		}
+		return StreamingBuffer{config, buffer, static_cast<std::byte*> (mapping)};
+	}
+
+
+	auto StreamingBuffer::beginFrame() noexcept -> void {
+		m_cursor = 0uz;
+		GLsync& fence {m_fences[m_frame]};
+		if (fence == nullptr)
+			return;
+
+		/* poll first, the region is usually free already */
+		GLenum status {glClientWaitSync(fence, 0u, 0u)};
+		if (status == GL_TIMEOUT_EXPIRED) {
+			++m_stallCount;
+			do {
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+			} while (status == GL_TIMEOUT_EXPIRED);
+		}
+		assert(status != GL_WAIT_FAILED);
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	auto StreamingBuffer::allocate(const std::size_t size, const std::size_t alignment) noexcept
+		-> std::optional<Allocation>
+	{
+		assert(alignment != 0uz);
+		const std::size_t regionOffset {m_frame * m_config.frameSize};
+		/* align the offset from the start of the buffer, regions don't start at multiples of `alignment` */
+		const std::size_t offset {(regionOffset + m_cursor + alignment - 1uz) / alignment * alignment};
+		if (offset + size > regionOffset + m_config.frameSize)
+			return std::nullopt;
+		m_cursor = offset + size - regionOffset;
+		return Allocation{m_mapping + offset, offset, size};
+	}
+
+	auto StreamingBuffer::endFrame() noexcept -> void {
+		assert(m_fences[m_frame] == nullptr);
+		m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0u);
+		m_frame = (m_frame + 1uz) % m_config.frameCount;
+	}
+
+
+	StreamingBuffer::StreamingBuffer(const Config& config, const GLuint buffer, std::byte* const mapping) noexcept :
+		m_config {config},
+		m_buffer {buffer},
+		m_mapping {mapping},
+		m_fences (config.frameCount, nullptr),
+		m_frame {0uz},
+		m_cursor {0uz},
+		m_stallCount {0uz}
+	{}
+
+
+	auto StreamingBuffer::release() noexcept -> void {
+		for (const GLsync fence : m_fences) {
+			if (fence != nullptr)
+				glDeleteSync(fence);
+		}
+		m_fences.clear();
+		if (m_buffer == 0u)
+			return;
+		glBindBuffer(m_config.target, m_buffer);
+		(void)glUnmapBuffer(m_config.target);
+		glDeleteBuffers(1, &m_buffer);
+		m_buffer = 0u;
+		m_mapping = nullptr;
+	}
+}
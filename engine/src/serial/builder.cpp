@@ -0,0 +1,120 @@
+#include "voxlet/serial/builder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+
+namespace vx::serial::internal {
+	Builder::Builder() noexcept {
+		m_bytes.resize(sizeof(SerialHeader));
+	}
+
+
+	auto Builder::beginTable(std::span<const std::uint16_t> offsets, const std::uint16_t size) noexcept -> std::size_t {
+		/* fields that weren't written at the end can go, readers take them for fields they don't know of */
+		while (!offsets.empty() && offsets.back() == 0u)
+			offsets = offsets.first(offsets.size() - 1uz);
+		std::array<std::uint16_t, 2uz + MAX_FIELD_COUNT> vtable {};
+		const std::size_t vtableSize {VTABLE_HEADER_SIZE + offsets.size() * sizeof(std::uint16_t)};
+		vtable[0] = static_cast<std::uint16_t> (vtableSize);
+		vtable[1] = size;
+		std::ranges::copy(offsets, vtable.begin() + 2);
+
+		/* tables of a same schema mostly share their vtable, the one reused has to be within reach */
+		const std::size_t tableEstimate {m_bytes.size() + vtableSize + alignof(std::uint64_t)};
+		auto found {std::ranges::find_if(m_vtables, [&] (const std::size_t position) {
+			return tableEstimate - position <= static_cast<std::size_t> (std::numeric_limits<std::int32_t>::max())
+				&& std::memcmp(m_bytes.data() + position, vtable.data(), vtableSize) == 0;
+		})};
+		std::size_t vtablePosition {};
+		if (found != m_vtables.end())
+			vtablePosition = *found;
+		else {
+			this->align(alignof(std::uint16_t));
+			vtablePosition = m_bytes.size();
+			m_bytes.resize(vtablePosition + vtableSize);
+			std::memcpy(m_bytes.data() + vtablePosition, vtable.data(), vtableSize);
+			m_vtables.push_back(vtablePosition);
+		}
+
+		this->align(alignof(std::uint64_t));
+		const std::size_t table {m_bytes.size()};
+		m_bytes.resize(table + size);
+		const auto offset {static_cast<std::int32_t> (
+			static_cast<std::ptrdiff_t> (vtablePosition) - static_cast<std::ptrdiff_t> (table)
+		)};
+		std::memcpy(m_bytes.data() + table, &offset, sizeof(offset));
+		return table;
+	}
+
+	auto Builder::write(const std::size_t position, const void* const data, const std::size_t size) noexcept -> void {
+		std::memcpy(m_bytes.data() + position, data, size);
+	}
+
+	auto Builder::writeString(const char8_t* const data, const std::size_t size) noexcept -> std::size_t {
+		this->align(alignof(std::uint32_t));
+		const std::size_t position {m_bytes.size()};
+		const auto stringSize {static_cast<std::uint32_t> (size)};
+		m_bytes.resize(position + REFERENCE_SIZE + size + 1uz);
+		std::memcpy(m_bytes.data() + position, &stringSize, sizeof(stringSize));
+		if (size != 0uz)
+			std::memcpy(m_bytes.data() + position + REFERENCE_SIZE, data, size);
+		return position;
+	}
+
+	auto Builder::writeScalars(
+		const void* const data,
+		const std::size_t count,
+		const std::size_t elementSize,
+		const std::size_t alignment
+	) noexcept -> std::size_t {
+		/* the elements are aligned, the size right before them */
+		const std::size_t elementAlignment {std::max(alignment, alignof(std::uint32_t))};
+		const std::size_t elements {(m_bytes.size() + REFERENCE_SIZE + elementAlignment - 1uz) & ~(elementAlignment - 1uz)};
+		const std::size_t position {elements - REFERENCE_SIZE};
+		const auto vectorSize {static_cast<std::uint32_t> (count)};
+		m_bytes.resize(elements + count * elementSize);
+		std::memcpy(m_bytes.data() + position, &vectorSize, sizeof(vectorSize));
+		if (count != 0uz)
+			std::memcpy(m_bytes.data() + elements, data, count * elementSize);
+		return position;
+	}
+
+	auto Builder::writeReferences(const std::size_t count) noexcept -> std::size_t {
+		this->align(alignof(std::uint32_t));
+		const std::size_t position {m_bytes.size()};
+		const auto vectorSize {static_cast<std::uint32_t> (count)};
+		m_bytes.resize(position + REFERENCE_SIZE + count * REFERENCE_SIZE);
+		std::memcpy(m_bytes.data() + position, &vectorSize, sizeof(vectorSize));
+		return position;
+	}
+
+	auto Builder::link(const std::size_t reference, const std::size_t target) noexcept -> void {
+		/* truncated past 4 GB, which `finish` turns down anyway */
+		const auto offset {static_cast<std::uint32_t> (target - reference)};
+		std::memcpy(m_bytes.data() + reference, &offset, sizeof(offset));
+	}
+
+	auto Builder::finish(const std::size_t root) noexcept -> std::optional<std::vector<std::byte>> {
+		this->align(alignof(std::uint64_t));
+		if (m_bytes.size() > std::numeric_limits<std::uint32_t>::max())
+			return std::nullopt;
+		const SerialHeader header {
+			.magic = SERIAL_MAGIC,
+			.version = SERIAL_VERSION,
+			.root = static_cast<std::uint32_t> (root),
+			.size = static_cast<std::uint32_t> (m_bytes.size())
+		};
+		std::memcpy(m_bytes.data(), &header, sizeof(header));
+		m_vtables.clear();
+		return std::move(m_bytes);
+	}
+
+
+	auto Builder::align(const std::size_t alignment) noexcept -> void {
+		m_bytes.resize((m_bytes.size() + alignment - 1uz) & ~(alignment - 1uz));
+	}
+}
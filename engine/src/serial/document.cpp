@@ -0,0 +1,108 @@
+#include "voxlet/serial/document.hpp"
+
+#include <cstring>
+
+
+namespace vx::serial::internal {
+	auto findRoot(const std::span<const std::byte> bytes) noexcept -> std::optional<std::size_t> {
+		if (reinterpret_cast<std::uintptr_t> (bytes.data()) % alignof(std::uint64_t) != 0u || bytes.size() < sizeof(SerialHeader))
+			return std::nullopt;
+		SerialHeader header {};
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		if (header.magic != SERIAL_MAGIC || header.version != SERIAL_VERSION || header.size != bytes.size())
+			return std::nullopt;
+		if (header.root < sizeof(SerialHeader) || header.root >= bytes.size())
+			return std::nullopt;
+		return header.root;
+	}
+
+
+	auto Verifier::enterTable(const std::size_t table) noexcept -> bool {
+		if (m_depth == MAX_DEPTH || !this->charge(sizeof(std::int32_t)))
+			return false;
+		if (table > m_bytes.size() || m_bytes.size() - table < sizeof(std::int32_t))
+			return false;
+		const std::ptrdiff_t vtable {static_cast<std::ptrdiff_t> (table) + load<std::int32_t> (m_bytes.data() + table)};
+		if (vtable < 0 || static_cast<std::size_t> (vtable) > m_bytes.size()
+			|| m_bytes.size() - static_cast<std::size_t> (vtable) < VTABLE_HEADER_SIZE)
+			return false;
+		const std::byte* const vtableData {m_bytes.data() + vtable};
+		const std::size_t vtableSize {load<std::uint16_t> (vtableData)};
+		const std::size_t tableSize {load<std::uint16_t> (vtableData + sizeof(std::uint16_t))};
+		if (vtableSize < VTABLE_HEADER_SIZE || vtableSize % sizeof(std::uint16_t) != 0uz
+			|| m_bytes.size() - static_cast<std::size_t> (vtable) < vtableSize)
+			return false;
+		if (tableSize < sizeof(std::int32_t) || m_bytes.size() - table < tableSize)
+			return false;
+		++m_depth;
+		return true;
+	}
+
+	auto Verifier::leaveTable() noexcept -> void {
+		--m_depth;
+	}
+
+	auto Verifier::checkField(const std::size_t table, const std::size_t index, const std::size_t size) const noexcept
+		-> std::optional<std::size_t>
+	{
+		const std::byte* const field {findField(m_bytes.data() + table, index)};
+		if (field == nullptr)
+			return 0uz;
+		const std::byte* const vtable {m_bytes.data() + table + load<std::int32_t> (m_bytes.data() + table)};
+		const std::size_t tableSize {load<std::uint16_t> (vtable + sizeof(std::uint16_t))};
+		const auto offset {static_cast<std::size_t> (field - (m_bytes.data() + table))};
+		/* the offset to the vtable can't be a field */
+		if (offset < sizeof(std::int32_t) || offset > tableSize || tableSize - offset < size)
+			return std::nullopt;
+		return table + offset;
+	}
+
+	auto Verifier::checkBooleans(const std::size_t position, const std::size_t count) noexcept -> bool {
+		if (!this->charge(count))
+			return false;
+		for (std::size_t i {0uz}; i < count; ++i) {
+			if (static_cast<std::uint8_t> (m_bytes[position + i]) > 1u)
+				return false;
+		}
+		return true;
+	}
+
+	auto Verifier::follow(const std::size_t reference) const noexcept -> std::optional<std::size_t> {
+		if (reference > m_bytes.size() || m_bytes.size() - reference < REFERENCE_SIZE)
+			return std::nullopt;
+		const std::size_t offset {load<std::uint32_t> (m_bytes.data() + reference)};
+		/* only forward, so that references can't loop */
+		if (offset == 0uz || offset >= m_bytes.size() - reference)
+			return std::nullopt;
+		return reference + offset;
+	}
+
+	auto Verifier::checkString(const std::size_t string) noexcept -> bool {
+		const std::optional<std::size_t> size {this->checkVector(string, 1uz, 1uz)};
+		if (!size || m_bytes.size() - string - REFERENCE_SIZE == *size)
+			return false;
+		return m_bytes[string + REFERENCE_SIZE + *size] == std::byte{0};
+	}
+
+	auto Verifier::checkVector(const std::size_t vector, const std::size_t elementSize, const std::size_t alignment) noexcept
+		-> std::optional<std::size_t>
+	{
+		if (vector > m_bytes.size() || m_bytes.size() - vector < REFERENCE_SIZE)
+			return std::nullopt;
+		const std::size_t elements {vector + REFERENCE_SIZE};
+		if (elements % alignment != 0uz)
+			return std::nullopt;
+		const std::size_t size {load<std::uint32_t> (m_bytes.data() + vector)};
+		if (size > (m_bytes.size() - elements) / elementSize || !this->charge(size * elementSize))
+			return std::nullopt;
+		return size;
+	}
+
+
+	auto Verifier::charge(const std::size_t size) noexcept -> bool {
+		if (size > m_budget)
+			return false;
+		m_budget -= size;
+		return true;
+	}
+}
@@ -0,0 +1,194 @@
+#include "voxlet/world/tilemap.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "voxlet/jobs/parallelFor.hpp"
+
+
+namespace vx::world {
+	namespace {
+		/* inverse of `mortonEncode` for a tile of a chunk */
+		constexpr auto mortonDecode(const std::uint32_t index) noexcept -> std::array<std::uint32_t, 2> {
+			const auto compact {[](std::uint32_t value) noexcept {
+				value &= 0x5555'5555u;
+				value = (value | value >> 1u) & 0x3333'3333u;
+				value = (value | value >> 2u) & 0x0f0f'0f0fu;
+				value = (value | value >> 4u) & 0x00ff'00ffu;
+				return (value | value >> 8u) & 0xffffu;
+			}};
+			return {compact(index), compact(index >> 1u)};
+		}
+
+		[[gnu::always_inline]]
+		inline auto getLocalIndex(const std::int32_t x, const std::int32_t y) noexcept -> std::uint32_t {
+			return mortonEncode(static_cast<std::uint32_t> (x) & (CHUNK_SIZE - 1u), static_cast<std::uint32_t> (y) & (CHUNK_SIZE - 1u));
+		}
+	}
+
+
+	Tilemap::Tilemap() noexcept :
+		Tilemap {Config{}}
+	{}
+
+	Tilemap::Tilemap(const Config& config) noexcept :
+		m_config {config},
+		m_chunks {},
+		m_chunkHandles {},
+		m_dirtyChunks {}
+	{
+		assert(m_config.tilesetColumns != 0u && m_config.tilesetRows != 0u);
+		assert(m_config.evictMargin >= m_config.loadMargin);
+	}
+
+
+	auto Tilemap::getTile(const std::int32_t x, const std::int32_t y) const noexcept -> TileId {
+		const Chunk* const chunk {this->getChunk(getChunkCoord(x, y))};
+		if (chunk == nullptr)
+			return 0u;
+		return chunk->tiles[getLocalIndex(x, y)];
+	}
+
+	auto Tilemap::setTile(const std::int32_t x, const std::int32_t y, const TileId tile) noexcept -> void {
+		const ChunkHandle handle {this->findOrLoad(getChunkCoord(x, y))};
+		Chunk& chunk {m_chunks[handle]};
+		TileId& cell {chunk.tiles[getLocalIndex(x, y)]};
+		if (cell == tile)
+			return;
+		cell = tile;
+		this->markDirty(chunk, handle);
+	}
+
+
+	auto Tilemap::loadChunk(const ChunkCoord coord) noexcept -> Chunk& {
+		return m_chunks[this->findOrLoad(coord)];
+	}
+
+	auto Tilemap::loadChunk(const ChunkCoord coord, const std::span<const TileId, CHUNK_AREA> tiles) noexcept -> Chunk& {
+		const ChunkHandle handle {this->findOrLoad(coord)};
+		Chunk& chunk {m_chunks[handle]};
+		for (std::uint32_t y {0u}; y < CHUNK_SIZE; ++y) {
+			for (std::uint32_t x {0u}; x < CHUNK_SIZE; ++x)
+				chunk.tiles[mortonEncode(x, y)] = tiles[y * CHUNK_SIZE + x];
+		}
+		this->markDirty(chunk, handle);
+		return chunk;
+	}
+
+	auto Tilemap::evictChunk(const ChunkCoord coord) noexcept -> bool {
+		const auto it {m_chunkHandles.find(coord)};
+		if (it == m_chunkHandles.end())
+			return false;
+		if (m_chunks[it->second].dirty)
+			std::erase(m_dirtyChunks, it->second);
+		m_chunks.erase(it->second);
+		m_chunkHandles.erase(it);
+		return true;
+	}
+
+
+	auto Tilemap::rebuildMeshes() noexcept -> std::size_t {
+		for (const ChunkHandle handle : m_dirtyChunks) {
+			Chunk& chunk {m_chunks[handle]};
+			this->rebuildMesh(chunk);
+			chunk.dirty = false;
+		}
+		const std::size_t count {m_dirtyChunks.size()};
+		m_dirtyChunks.clear();
+		return count;
+	}
+
+	auto Tilemap::rebuildMeshes(vx::jobs::Scheduler& scheduler) noexcept -> std::size_t {
+		/* chunks are independent, and looking handles up doesn't write to the slot map */
+		vx::jobs::parallelFor(scheduler, 0uz, m_dirtyChunks.size(), [this](const std::size_t first, const std::size_t last) noexcept {
+			for (std::size_t i {first}; i < last; ++i) {
+				Chunk& chunk {m_chunks[m_dirtyChunks[i]]};
+				this->rebuildMesh(chunk);
+				chunk.dirty = false;
+			}
+		}, 1uz);
+		const std::size_t count {m_dirtyChunks.size()};
+		m_dirtyChunks.clear();
+		return count;
+	}
+
+
+	auto Tilemap::getChunk(const ChunkCoord coord) noexcept -> Chunk* {
+		const auto it {m_chunkHandles.find(coord)};
+		return it == m_chunkHandles.end() ? nullptr : m_chunks.get(it->second);
+	}
+
+	auto Tilemap::getChunk(const ChunkCoord coord) const noexcept -> const Chunk* {
+		const auto it {m_chunkHandles.find(coord)};
+		return it == m_chunkHandles.end() ? nullptr : m_chunks.get(it->second);
+	}
+
+
+	auto Tilemap::findOrLoad(const ChunkCoord coord) noexcept -> ChunkHandle {
+		const auto it {m_chunkHandles.find(coord)};
+		if (it != m_chunkHandles.end())
+			return it->second;
+		/* an empty chunk has an empty mesh, so it starts clean */
+		const ChunkHandle handle {m_chunks.insert(Chunk{coord, {}, {}, false})};
+		m_chunkHandles.emplace(coord, handle);
+		return handle;
+	}
+
+	auto Tilemap::markDirty(Chunk& chunk, const ChunkHandle handle) noexcept -> void {
+		if (chunk.dirty)
+			return;
+		chunk.dirty = true;
+		m_dirtyChunks.push_back(handle);
+	}
+
+	auto Tilemap::rebuildMesh(Chunk& chunk) const noexcept -> void {
+		const float originX {static_cast<float> (chunk.coord.x) * static_cast<float> (CHUNK_SIZE) * m_config.tileSize};
+		const float originY {static_cast<float> (chunk.coord.y) * static_cast<float> (CHUNK_SIZE) * m_config.tileSize};
+		const float tileWidth {1.f / static_cast<float> (m_config.tilesetColumns)};
+		const float tileHeight {1.f / static_cast<float> (m_config.tilesetRows)};
+
+		chunk.mesh.clear();
+		for (std::uint32_t i {0u}; i < CHUNK_AREA; ++i) {
+			const TileId tile {chunk.tiles[i]};
+			if (tile == 0u)
+				continue;
+			const auto [x, y] {mortonDecode(i)};
+			const std::uint32_t column {(tile - 1u) % m_config.tilesetColumns};
+			const std::uint32_t row {(tile - 1u) / m_config.tilesetColumns};
+			assert(row < m_config.tilesetRows);
+			const float u {static_cast<float> (column) * tileWidth};
+			const float v {static_cast<float> (row) * tileHeight};
+			chunk.mesh.push_back(vx::render::SpriteInstance{
+				{
+					originX + static_cast<float> (x) * m_config.tileSize,
+					originY + static_cast<float> (y) * m_config.tileSize,
+					m_config.tileSize,
+					m_config.tileSize
+				},
+				{u, v, u + tileWidth, v + tileHeight},
+				0xffff'ffffu,
+				m_config.depth
+			});
+		}
+	}
+
+	auto Tilemap::getChunkRange(const TileRect& view, const std::uint32_t margin) noexcept -> std::array<ChunkCoord, 2> {
+		const ChunkCoord first {getChunkCoord(view.x, view.y)};
+		const ChunkCoord last {getChunkCoord(
+			static_cast<std::int32_t> (view.x + static_cast<std::int64_t> (std::max(view.width, 1u)) - 1),
+			static_cast<std::int32_t> (view.y + static_cast<std::int64_t> (std::max(view.height, 1u)) - 1)
+		)};
+		const auto signedMargin {static_cast<std::int32_t> (margin)};
+		return {
+			ChunkCoord{first.x - signedMargin, first.y - signedMargin},
+			ChunkCoord{last.x + signedMargin, last.y + signedMargin}
+		};
+	}
+
+	auto Tilemap::toRowMajor(const Chunk& chunk, const std::span<TileId, CHUNK_AREA> tiles) noexcept -> void {
+		for (std::uint32_t y {0u}; y < CHUNK_SIZE; ++y) {
+			for (std::uint32_t x {0u}; x < CHUNK_SIZE; ++x)
+				tiles[y * CHUNK_SIZE + x] = chunk.tiles[mortonEncode(x, y)];
+		}
+	}
+}
@@ -0,0 +1,519 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/assets/aseprite.hpp>
+#include <voxlet/assets/atlasBuilder.hpp>
+#include <voxlet/compression/deflate.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	using vx::testing::toSlice;
+
+	auto append16(std::vector<std::byte>& bytes, const std::uint32_t value) -> void {
+		bytes.push_back(static_cast<std::byte> (value));
+		bytes.push_back(static_cast<std::byte> (value >> 8u));
+	}
+
+	auto append32(std::vector<std::byte>& bytes, const std::uint32_t value) -> void {
+		append16(bytes, value);
+		append16(bytes, value >> 16u);
+	}
+
+	auto appendString(std::vector<std::byte>& bytes, const std::string& string) -> void {
+		append16(bytes, static_cast<std::uint32_t> (string.size()));
+		for (const char character : string)
+			bytes.push_back(static_cast<std::byte> (character));
+	}
+
+	struct Chunk {
+		std::uint16_t type;
+		std::vector<std::byte> data;
+	};
+
+	struct LayerDesc {
+		std::string name;
+		bool isVisible {true};
+		bool isGroup {false};
+		std::uint16_t childLevel {0u};
+		vx::assets::AsepriteBlendMode blendMode {vx::assets::AsepriteBlendMode::normal};
+		std::uint8_t opacity {255u};
+		bool isBackground {false};
+	};
+
+	auto makeLayer(const LayerDesc& layer) -> Chunk {
+		Chunk chunk {.type = 0x2004u, .data = {}};
+		append16(chunk.data, (layer.isVisible ? 1u : 0u) | 2u | (layer.isBackground ? 8u : 0u));
+		append16(chunk.data, layer.isGroup ? 1u : 0u);
+		append16(chunk.data, layer.childLevel);
+		append32(chunk.data, 0u);
+		append16(chunk.data, static_cast<std::uint32_t> (layer.blendMode));
+		chunk.data.push_back(static_cast<std::byte> (layer.opacity));
+		chunk.data.insert(chunk.data.end(), 3uz, std::byte{0});
+		appendString(chunk.data, layer.name);
+		return chunk;
+	}
+
+	struct CelDesc {
+		std::uint16_t layer;
+		std::int16_t x;
+		std::int16_t y;
+		std::uint16_t width;
+		std::uint16_t height;
+		/* `bytesPerPixel` bytes per pixel, as in the file */
+		std::vector<std::byte> pixels;
+		std::uint8_t opacity {255u};
+		std::int16_t zIndex {0};
+		bool isCompressed {false};
+	};
+
+	auto makeCel(const CelDesc& cel) -> Chunk {
+		Chunk chunk {.type = 0x2005u, .data = {}};
+		append16(chunk.data, cel.layer);
+		append16(chunk.data, static_cast<std::uint16_t> (cel.x));
+		append16(chunk.data, static_cast<std::uint16_t> (cel.y));
+		chunk.data.push_back(static_cast<std::byte> (cel.opacity));
+		append16(chunk.data, cel.isCompressed ? 2u : 0u);
+		append16(chunk.data, static_cast<std::uint16_t> (cel.zIndex));
+		chunk.data.insert(chunk.data.end(), 5uz, std::byte{0});
+		append16(chunk.data, cel.width);
+		append16(chunk.data, cel.height);
+		if (cel.isCompressed) {
+			const std::vector<std::byte> stream {vx::compression::deflate(cel.pixels, vx::compression::DeflateFormat::zlib)};
+			chunk.data.insert(chunk.data.end(), stream.begin(), stream.end());
+		}
+		else
+			chunk.data.insert(chunk.data.end(), cel.pixels.begin(), cel.pixels.end());
+		return chunk;
+	}
+
+	auto makeLinkedCel(const std::uint16_t layer, const std::uint16_t frame) -> Chunk {
+		Chunk chunk {.type = 0x2005u, .data = {}};
+		append16(chunk.data, layer);
+		append32(chunk.data, 0u);
+		chunk.data.push_back(std::byte{255});
+		append16(chunk.data, 1u);
+		append16(chunk.data, 0u);
+		chunk.data.insert(chunk.data.end(), 5uz, std::byte{0});
+		append16(chunk.data, frame);
+		return chunk;
+	}
+
+	struct TagDesc {
+		std::string name;
+		std::uint16_t from;
+		std::uint16_t to;
+		vx::assets::AsepriteDirection direction;
+		std::uint16_t repeat;
+	};
+
+	auto makeTags(const std::vector<TagDesc>& tags) -> Chunk {
+		Chunk chunk {.type = 0x2018u, .data = {}};
+		append16(chunk.data, static_cast<std::uint32_t> (tags.size()));
+		chunk.data.insert(chunk.data.end(), 8uz, std::byte{0});
+		for (const TagDesc& tag : tags) {
+			append16(chunk.data, tag.from);
+			append16(chunk.data, tag.to);
+			chunk.data.push_back(static_cast<std::byte> (tag.direction));
+			append16(chunk.data, tag.repeat);
+			chunk.data.insert(chunk.data.end(), 10uz, std::byte{0});
+			appendString(chunk.data, tag.name);
+		}
+		return chunk;
+	}
+
+	/* RGBA colors starting at index 0, the second one named */
+	auto makePalette(const std::vector<std::uint32_t>& colors) -> Chunk {
+		Chunk chunk {.type = 0x2019u, .data = {}};
+		append32(chunk.data, static_cast<std::uint32_t> (colors.size()));
+		append32(chunk.data, 0u);
+		append32(chunk.data, static_cast<std::uint32_t> (colors.size() - 1uz));
+		chunk.data.insert(chunk.data.end(), 8uz, std::byte{0});
+		for (std::size_t i {0uz}; i < colors.size(); ++i) {
+			append16(chunk.data, i == 1uz ? 1u : 0u);
+			append32(chunk.data, colors[i]);
+			if (i == 1uz)
+				appendString(chunk.data, "skin");
+		}
+		return chunk;
+	}
+
+	struct Frame {
+		std::uint16_t duration {100u};
+		std::vector<Chunk> chunks;
+	};
+
+	auto makeFile(
+		const std::uint16_t width,
+		const std::uint16_t height,
+		const std::uint16_t colorDepth,
+		const std::vector<Frame>& frames,
+		const std::uint8_t transparentIndex = 0u
+	) -> std::vector<std::byte> {
+		std::vector<std::byte> file {};
+		append32(file, 0u);
+		append16(file, 0xa5e0u);
+		append16(file, static_cast<std::uint32_t> (frames.size()));
+		append16(file, width);
+		append16(file, height);
+		append16(file, colorDepth);
+		/* layer opacity is valid */
+		append32(file, 1u);
+		append16(file, 100u);
+		append32(file, 0u);
+		append32(file, 0u);
+		file.push_back(static_cast<std::byte> (transparentIndex));
+		file.resize(128uz, std::byte{0});
+
+		for (const Frame& frame : frames) {
+			std::vector<std::byte> bytes {};
+			for (const Chunk& chunk : frame.chunks) {
+				append32(bytes, static_cast<std::uint32_t> (chunk.data.size() + 6uz));
+				append16(bytes, chunk.type);
+				bytes.insert(bytes.end(), chunk.data.begin(), chunk.data.end());
+			}
+			append32(file, static_cast<std::uint32_t> (bytes.size() + 16uz));
+			append16(file, 0xf1fau);
+			append16(file, static_cast<std::uint32_t> (std::min(frame.chunks.size(), 0xffffuz)));
+			append16(file, frame.duration);
+			append16(file, 0u);
+			append32(file, static_cast<std::uint32_t> (frame.chunks.size()));
+			file.insert(file.end(), bytes.begin(), bytes.end());
+		}
+		const auto size {static_cast<std::uint32_t> (file.size())};
+		for (std::size_t i {0uz}; i < 4uz; ++i)
+			file[i] = static_cast<std::byte> (size >> (i * 8uz));
+		return file;
+	}
+
+	auto fillPixels(const std::size_t count, const std::uint32_t color) -> std::vector<std::byte> {
+		std::vector<std::byte> bytes {};
+		for (std::size_t i {0uz}; i < count; ++i)
+			append32(bytes, color);
+		return bytes;
+	}
+
+	auto getChannel(const std::uint32_t pixel, const std::uint32_t channel) -> std::int32_t {
+		return static_cast<std::int32_t> ((pixel >> (channel * 8u)) & 0xffu);
+	}
+
+	/* compositing rounds in floats, a channel may be one off the exact value */
+	auto isClose(const std::uint32_t pixel, const std::uint32_t expected) -> bool {
+		for (std::uint32_t channel {0u}; channel < 4u; ++channel) {
+			if (std::abs(getChannel(pixel, channel) - getChannel(expected, channel)) > 1)
+				return false;
+		}
+		return true;
+	}
+}
+
+
+TEST_CASE("aseprite - layers", "[assets]") {
+	const bool isCompressed {GENERATE(false, true)};
+	const std::vector<Frame> frames {{
+		.duration = 80u,
+		.chunks = [&] {
+			std::vector<Chunk> chunks {};
+			chunks.push_back(makeLayer({.name = "base"}));
+			chunks.push_back(makeLayer({.name = "half", .opacity = 128u}));
+			chunks.push_back(makeLayer({.name = "hidden", .isVisible = false}));
+			chunks.push_back(makeLayer({.name = "group", .isVisible = false, .isGroup = true}));
+			chunks.push_back(makeLayer({.name = "in hidden group", .childLevel = 1u}));
+			chunks.push_back(makeLayer({.name = "shaded", .blendMode = vx::assets::AsepriteBlendMode::multiply}));
+			/* a 13x9 opaque red square in the canvas of 16x12, partly outside of it */
+			chunks.push_back(makeCel({.layer = 0u, .x = -3, .y = 3, .width = 16u, .height = 9u, .pixels = fillPixels(144uz, 0xff00'00ffu), .isCompressed = isCompressed}));
+			/* a green square over the red one at half opacity, and translucent where there's nothing below */
+			chunks.push_back(makeCel({.layer = 1u, .x = 8, .y = 0, .width = 8u, .height = 6u, .pixels = fillPixels(48uz, 0xff00'ff00u), .isCompressed = isCompressed}));
+			chunks.push_back(makeCel({.layer = 2u, .x = 0, .y = 0, .width = 16u, .height = 12u, .pixels = fillPixels(192uz, 0xffff'ffffu)}));
+			chunks.push_back(makeCel({.layer = 4u, .x = 0, .y = 0, .width = 16u, .height = 12u, .pixels = fillPixels(192uz, 0xffff'ffffu)}));
+			/* gray multiplied over the red square in the bottom right corner */
+			chunks.push_back(makeCel({.layer = 5u, .x = 12, .y = 10, .width = 4u, .height = 2u, .pixels = fillPixels(8uz, 0xff80'8080u)}));
+			return chunks;
+		}()
+	}};
+	const std::vector<std::byte> file {makeFile(16u, 12u, 32u, frames)};
+	const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(file)};
+	REQUIRE(aseprite);
+	REQUIRE(aseprite->getWidth() == 16u);
+	REQUIRE(aseprite->getHeight() == 12u);
+	REQUIRE(aseprite->getFrames().size() == 1uz);
+	REQUIRE(aseprite->getFrames()[0].duration == 80u);
+	REQUIRE(aseprite->getImageCount() == 1u);
+
+	REQUIRE(aseprite->getLayers().size() == 6uz);
+	REQUIRE(std::ranges::equal(aseprite->getLayers()[1].name, vx::StringSlice::from(u8"half")));
+	REQUIRE(aseprite->getLayers()[1].opacity == 128u);
+	REQUIRE(aseprite->getLayers()[3].isGroup);
+	REQUIRE(!aseprite->getLayers()[4].isVisible);
+	REQUIRE(aseprite->getLayers()[5].blendMode == vx::assets::AsepriteBlendMode::multiply);
+
+	const std::span<const std::uint32_t> image {aseprite->getImage(0u)};
+	const auto at {[&](const std::uint32_t x, const std::uint32_t y) {return image[y * 16u + x];}};
+	REQUIRE(at(0u, 0u) == 0u);
+	REQUIRE(at(0u, 3u) == 0xff00'00ffu);
+	REQUIRE(at(7u, 3u) == 0xff00'00ffu);
+	REQUIRE(isClose(at(13u, 3u), 0x8000'ff00u));
+	REQUIRE(at(13u, 9u) == 0u);
+	REQUIRE(isClose(at(8u, 4u), 0xff00'8080u));
+	REQUIRE(isClose(at(8u, 1u), 0x8000'ff00u));
+	REQUIRE(isClose(at(12u, 10u), 0xff00'0080u));
+	REQUIRE(at(14u, 10u) == 0xff80'8080u);
+}
+
+TEST_CASE("aseprite - frames", "[assets]") {
+	/* the same pose in frames 0, 2 and 3, linked then pasted again, with a different one in frame 1 */
+	const auto makePose {[](const std::uint32_t color) {
+		return makeCel({.layer = 0u, .x = 2, .y = 1, .width = 3u, .height = 2u, .pixels = fillPixels(6uz, color)});
+	}};
+	std::vector<Frame> frames {
+		{.duration = 100u, .chunks = {}},
+		{.duration = 50u, .chunks = {makePose(0xff11'2233u)}},
+		{.duration = 100u, .chunks = {makeLinkedCel(0u, 0u)}},
+		{.duration = 200u, .chunks = {makePose(0xffaa'bbccu)}}
+	};
+	frames[0].chunks.push_back(makeLayer({.name = "body"}));
+	frames[0].chunks.push_back(makePose(0xffaa'bbccu));
+	frames[0].chunks.push_back(makeTags({
+		{.name = "idle", .from = 0u, .to = 3u, .direction = vx::assets::AsepriteDirection::forward, .repeat = 0u},
+		{.name = "back", .from = 1u, .to = 3u, .direction = vx::assets::AsepriteDirection::reverse, .repeat = 2u},
+		{.name = "bounce", .from = 0u, .to = 2u, .direction = vx::assets::AsepriteDirection::pingPong, .repeat = 1u}
+	}));
+	const std::vector<std::byte> file {makeFile(8u, 4u, 32u, frames)};
+	const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(file)};
+	REQUIRE(aseprite);
+
+	const std::span<const vx::assets::AsepriteFrame> timeline {aseprite->getFrames()};
+	REQUIRE(timeline.size() == 4uz);
+	REQUIRE(aseprite->getImageCount() == 2u);
+	REQUIRE(timeline[0].image == 0u);
+	REQUIRE(timeline[1].image == 1u);
+	REQUIRE(timeline[2].image == 0u);
+	REQUIRE(timeline[3].image == 0u);
+	REQUIRE(timeline[3].duration == 200u);
+	REQUIRE(aseprite->getImage(0u)[1uz * 8uz + 2uz] == 0xffaa'bbccu);
+	REQUIRE(aseprite->getImage(1u)[2uz * 8uz + 4uz] == 0xff11'2233u);
+	REQUIRE(aseprite->getImage(1u)[3uz * 8uz + 4uz] == 0u);
+
+	REQUIRE(aseprite->findTag(vx::StringSlice::from(u8"run")) == nullptr);
+	const vx::assets::AsepriteTag* const idle {aseprite->findTag(vx::StringSlice::from(u8"idle"))};
+	REQUIRE(idle);
+	REQUIRE(aseprite->getFrameAt(*idle, 0u) == 0u);
+	REQUIRE(aseprite->getFrameAt(*idle, 99u) == 0u);
+	REQUIRE(aseprite->getFrameAt(*idle, 100u) == 1u);
+	REQUIRE(aseprite->getFrameAt(*idle, 150u) == 2u);
+	REQUIRE(aseprite->getFrameAt(*idle, 449u) == 3u);
+	REQUIRE(aseprite->getFrameAt(*idle, 450u + 120u) == 1u);
+
+	const vx::assets::AsepriteTag* const back {aseprite->findTag(vx::StringSlice::from(u8"back"))};
+	REQUIRE(back);
+	REQUIRE(back->repeat == 2u);
+	REQUIRE(aseprite->getFrameAt(*back, 0u) == 3u);
+	REQUIRE(aseprite->getFrameAt(*back, 250u) == 2u);
+	REQUIRE(aseprite->getFrameAt(*back, 320u) == 1u);
+	REQUIRE(aseprite->getFrameAt(*back, 350u) == 3u);
+	REQUIRE(aseprite->getFrameAt(*back, 700u) == 1u);
+	REQUIRE(aseprite->getFrameAt(*back, 100'000u) == 1u);
+
+	/* 0, 1, 2, then 1 on the way back */
+	const vx::assets::AsepriteTag* const bounce {aseprite->findTag(vx::StringSlice::from(u8"bounce"))};
+	REQUIRE(bounce);
+	REQUIRE(aseprite->getFrameAt(*bounce, 120u) == 1u);
+	REQUIRE(aseprite->getFrameAt(*bounce, 200u) == 2u);
+	REQUIRE(aseprite->getFrameAt(*bounce, 260u) == 1u);
+	REQUIRE(aseprite->getFrameAt(*bounce, 300u) == 1u);
+	REQUIRE(aseprite->getFrameAt(*bounce, 349u) == 1u);
+	REQUIRE(aseprite->getFrameAt(*bounce, 350u) == 1u);
+
+	vx::assets::AtlasBuilder builder {};
+	REQUIRE(aseprite->addToAtlas(builder, toSlice("hero")));
+	REQUIRE(builder.getSpriteCount() == 2uz);
+	REQUIRE(std::ranges::equal(vx::assets::Aseprite::getSpriteName(toSlice("hero"), 1u), toSlice("hero_1")));
+	REQUIRE(std::ranges::equal(vx::assets::Aseprite::getSpriteName(toSlice("a/b"), 4'000'000'000u), toSlice("a/b_4000000000")));
+}
+
+TEST_CASE("aseprite - color modes", "[assets]") {
+	SECTION("indexed") {
+		std::vector<std::byte> indices {};
+		for (std::size_t i {0uz}; i < 12uz; ++i)
+			indices.push_back(static_cast<std::byte> (i % 3uz));
+		const std::vector<Frame> frames {{.duration = 100u, .chunks = {
+			makePalette({0xff00'0000u, 0xff30'60c0u, 0x80ff'ffffu}),
+			makeLayer({.name = "background", .isBackground = true}),
+			makeLayer({.name = "layer"}),
+			makeCel({.layer = 0u, .x = 0, .y = 0, .width = 4u, .height = 3u, .pixels = indices}),
+			makeCel({.layer = 1u, .x = 0, .y = 0, .width = 4u, .height = 3u, .pixels = indices, .isCompressed = true})
+		}}};
+		const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(makeFile(4u, 3u, 8u, frames, 1u))};
+		REQUIRE(aseprite);
+		REQUIRE(aseprite->getPalette()[1] == 0xff30'60c0u);
+		REQUIRE(aseprite->getPalette()[3] == 0xff00'0000u);
+		/* the transparent index is opaque on the background layer, and shows it through the other one */
+		const std::span<const std::uint32_t> image {aseprite->getImage(0u)};
+		REQUIRE(image[0] == 0xff00'0000u);
+		REQUIRE(image[1] == 0xff30'60c0u);
+		REQUIRE(isClose(image[2], 0xc0ff'ffffu));
+	}
+
+	SECTION("grayscale") {
+		std::vector<std::byte> pixels {};
+		for (const std::uint32_t value : {0x00u, 0xff40u, 0x80ffu, 0xffffu})
+			append16(pixels, value);
+		const std::vector<Frame> frames {{.duration = 100u, .chunks = {
+			makeLayer({.name = "layer"}),
+			makeCel({.layer = 0u, .x = 0, .y = 0, .width = 2u, .height = 2u, .pixels = pixels})
+		}}};
+		const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(makeFile(2u, 2u, 16u, frames))};
+		REQUIRE(aseprite);
+		const std::span<const std::uint32_t> image {aseprite->getImage(0u)};
+		REQUIRE(image[0] == 0u);
+		REQUIRE(image[1] == 0xff40'4040u);
+		REQUIRE(image[2] == 0x80ff'ffffu);
+		REQUIRE(image[3] == 0xffff'ffffu);
+	}
+}
+
+TEST_CASE("aseprite - slices", "[assets]") {
+	Chunk slice {.type = 0x2022u, .data = {}};
+	append32(slice.data, 2u);
+	append32(slice.data, 3u);
+	append32(slice.data, 0u);
+	appendString(slice.data, "hitbox");
+	for (const std::uint32_t frame : {0u, 1u}) {
+		for (const std::uint32_t value : {frame, 0xffff'fffeu, 3u, 10u + frame, 12u, 2u, 2u, 6u, 8u, 5u, 0xffff'ffffu})
+			append32(slice.data, value);
+	}
+	const std::vector<Frame> frames {
+		{.duration = 100u, .chunks = {makeLayer({.name = "layer"}), std::move(slice)}},
+		{.duration = 100u, .chunks = {}}
+	};
+	const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(makeFile(16u, 16u, 32u, frames))};
+	REQUIRE(aseprite);
+	REQUIRE(aseprite->getSlices().size() == 1uz);
+	const vx::assets::AsepriteSlice& hitbox {aseprite->getSlices()[0]};
+	REQUIRE(std::ranges::equal(hitbox.name, toSlice("hitbox")));
+	REQUIRE(hitbox.hasCenter);
+	REQUIRE(hitbox.hasPivot);
+	REQUIRE(hitbox.keys.size() == 2uz);
+	REQUIRE(hitbox.keys[1].frame == 1u);
+	REQUIRE(hitbox.keys[1].x == -2);
+	REQUIRE(hitbox.keys[1].y == 3);
+	REQUIRE(hitbox.keys[1].width == 11u);
+	REQUIRE(hitbox.keys[1].centerWidth == 6u);
+	REQUIRE(hitbox.keys[1].pivotX == 5);
+	REQUIRE(hitbox.keys[1].pivotY == -1);
+	/* two frames with nothing drawn */
+	REQUIRE(aseprite->getImageCount() == 1u);
+}
+
+TEST_CASE("aseprite - blend modes", "[assets]") {
+	using vx::assets::AsepriteBlendMode;
+	struct Case {
+		AsepriteBlendMode mode;
+		std::uint32_t expected;
+	};
+	/* 0x40c080 under 0x808080 */
+	const Case testCase {GENERATE(
+		Case{AsepriteBlendMode::normal, 0xff80'8080u},
+		Case{AsepriteBlendMode::multiply, 0xff40'6020u},
+		Case{AsepriteBlendMode::screen, 0xffc0'e0a0u},
+		Case{AsepriteBlendMode::darken, 0xff80'8040u},
+		Case{AsepriteBlendMode::lighten, 0xff80'c080u},
+		Case{AsepriteBlendMode::difference, 0xff00'4040u},
+		Case{AsepriteBlendMode::addition, 0xffff'ffc0u},
+		Case{AsepriteBlendMode::subtract, 0xff00'4000u},
+		/* a gray of about a half leaves the backdrop as it is */
+		Case{AsepriteBlendMode::overlay, 0xff80'c040u},
+		Case{AsepriteBlendMode::softLight, 0xff80'c040u},
+		Case{AsepriteBlendMode::hardLight, 0xff80'c041u},
+		Case{AsepriteBlendMode::colorDodge, 0xffff'ff81u},
+		Case{AsepriteBlendMode::colorBurn, 0xff02'8100u},
+		Case{AsepriteBlendMode::exclusion, 0xff80'7f80u},
+		Case{AsepriteBlendMode::divide, 0xffff'ff80u},
+		/* not supported, drawn as normal */
+		Case{AsepriteBlendMode::hue, 0xff80'8080u}
+	)};
+	/* wider than a register, the last pixels go through the tail */
+	const std::vector<Frame> frames {{.duration = 100u, .chunks = {
+		makeLayer({.name = "backdrop"}),
+		makeLayer({.name = "blended", .blendMode = testCase.mode}),
+		makeCel({.layer = 0u, .x = 0, .y = 0, .width = 11u, .height = 1u, .pixels = fillPixels(11uz, 0xff80'c040u)}),
+		makeCel({.layer = 1u, .x = 0, .y = 0, .width = 11u, .height = 1u, .pixels = fillPixels(11uz, 0xff80'8080u)})
+	}}};
+	const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(makeFile(11u, 1u, 32u, frames))};
+	REQUIRE(aseprite);
+	for (const std::uint32_t pixel : aseprite->getImage(0u))
+		REQUIRE(isClose(pixel, testCase.expected));
+}
+
+TEST_CASE("aseprite - z-index", "[assets]") {
+	/* the cel of the upper layer goes below the other one */
+	const std::vector<Frame> frames {{.duration = 100u, .chunks = {
+		makeLayer({.name = "bottom"}),
+		makeLayer({.name = "top"}),
+		makeCel({.layer = 0u, .x = 0, .y = 0, .width = 1u, .height = 1u, .pixels = fillPixels(1uz, 0xff00'00ffu)}),
+		makeCel({.layer = 1u, .x = 0, .y = 0, .width = 1u, .height = 1u, .pixels = fillPixels(1uz, 0xffff'0000u), .zIndex = -1})
+	}}};
+	const std::optional<vx::assets::Aseprite> aseprite {vx::assets::Aseprite::fromBytes(makeFile(1u, 1u, 32u, frames))};
+	REQUIRE(aseprite);
+	REQUIRE(aseprite->getImage(0u)[0] == 0xff00'00ffu);
+}
+
+TEST_CASE("aseprite - malformed files", "[assets]") {
+	const auto makeValid {[](std::vector<Chunk> extra = {}) {
+		std::vector<Frame> frames {
+			{.duration = 100u, .chunks = {
+				makeLayer({.name = "layer"}),
+				makeCel({.layer = 0u, .x = 1, .y = 1, .width = 2u, .height = 2u, .pixels = fillPixels(4uz, 0xff12'3456u), .isCompressed = true})
+			}},
+			{.duration = 100u, .chunks = {makeLinkedCel(0u, 0u)}}
+		};
+		for (Chunk& chunk : extra)
+			frames[1].chunks.push_back(std::move(chunk));
+		return makeFile(4u, 4u, 32u, frames);
+	}};
+	const std::vector<std::byte> file {makeValid()};
+	REQUIRE(vx::assets::Aseprite::fromBytes(file));
+
+	SECTION("header") {
+		std::vector<std::byte> bytes {file};
+		bytes[4] = std::byte{0};
+		REQUIRE(!vx::assets::Aseprite::fromBytes(bytes));
+		bytes = file;
+		bytes[12] = std::byte{24};
+		REQUIRE(!vx::assets::Aseprite::fromBytes(bytes));
+		bytes = file;
+		bytes[6] = std::byte{0};
+		REQUIRE(!vx::assets::Aseprite::fromBytes(bytes));
+	}
+
+	SECTION("truncated") {
+		for (std::size_t size {0uz}; size < file.size(); ++size)
+			REQUIRE(!vx::assets::Aseprite::fromBytes(std::span{file}.first(size)));
+	}
+
+	SECTION("invalid references") {
+		REQUIRE(!vx::assets::Aseprite::fromBytes(makeValid({makeLinkedCel(0u, 1u)})));
+		REQUIRE(!vx::assets::Aseprite::fromBytes(makeValid({makeLinkedCel(3u, 0u)})));
+		REQUIRE(!vx::assets::Aseprite::fromBytes(makeValid({makeTags({{.name = "run", .from = 1u, .to = 2u, .direction = {}, .repeat = 0u}})})));
+		REQUIRE(!vx::assets::Aseprite::fromBytes(makeValid({makeLayer({.name = "orphan", .childLevel = 2u})})));
+		REQUIRE(!vx::assets::Aseprite::fromBytes(makeValid({
+			makeCel({.layer = 0u, .x = 0, .y = 0, .width = 3u, .height = 3u, .pixels = fillPixels(4uz, 0u), .isCompressed = true})
+		})));
+	}
+
+	SECTION("fuzzed") {
+		std::mt19937 random {11u};
+		for (std::size_t i {0uz}; i < 2000uz; ++i) {
+			std::vector<std::byte> bytes {file};
+			for (std::size_t j {0uz}; j < 1uz + i % 3uz; ++j)
+				bytes[random() % bytes.size()] = static_cast<std::byte> (random());
+			/* must be safe, the result doesn't matter */
+			(void)vx::assets::Aseprite::fromBytes(bytes);
+		}
+	}
+}
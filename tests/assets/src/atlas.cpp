@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <voxlet/assets/atlas.hpp>
+#include <voxlet/assets/atlasBuilder.hpp>
+#include <voxlet/assets/hash.hpp>
+#include <voxlet/assets/maxRectsPacker.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	using vx::testing::toSlice;
+
+	auto overlaps(const vx::assets::PackedRect& lhs, const vx::assets::PackedRect& rhs) noexcept -> bool {
+		return lhs.x < rhs.x + rhs.width && rhs.x < lhs.x + lhs.width
+			&& lhs.y < rhs.y + rhs.height && rhs.y < lhs.y + lhs.height;
+	}
+
+	/* opaque rectangle of a color unique to `seed` inside a transparent border */
+	auto makeSprite(
+		const std::uint32_t width,
+		const std::uint32_t height,
+		const std::uint32_t border,
+		const std::uint32_t seed
+	) noexcept -> vx::render::Image {
+		vx::render::Image image {width + 2u * border, height + 2u * border, 0u};
+		for (std::uint32_t y {0u}; y < height; ++y) {
+			for (std::uint32_t x {0u}; x < width; ++x)
+				image.getRow(y + border)[x + border] = 0xff00'0000u | (seed << 12u) | (y << 6u) | x;
+		}
+		return image;
+	}
+
+	/* checks that the atlas holds `image` for `name` */
+	auto hasSprite(const vx::assets::Atlas& atlas, const std::string& name, const vx::render::Image& image) noexcept -> bool {
+		const vx::assets::AtlasEntry* const entry {atlas.find(toSlice(name))};
+		if (entry == nullptr || entry->sourceWidth != image.getWidth() || entry->sourceHeight != image.getHeight())
+			return false;
+		const std::span<const std::uint32_t> pixels {atlas.getPagePixels(entry->page)};
+		const std::uint32_t pageWidth {atlas.getPages()[entry->page].width};
+		for (std::uint32_t y {0u}; y < image.getHeight(); ++y) {
+			for (std::uint32_t x {0u}; x < image.getWidth(); ++x) {
+				const bool inside {x >= entry->offsetX && x < entry->offsetX + entry->width
+					&& y >= entry->offsetY && y < entry->offsetY + entry->height
+				};
+				const std::uint32_t pixel {inside
+					? pixels[(entry->y + y - entry->offsetY) * pageWidth + entry->x + x - entry->offsetX]
+					: 0u
+				};
+				if (pixel != image.getPixel(x, y))
+					return false;
+			}
+		}
+		return true;
+	}
+}
+
+
+TEST_CASE("atlas - name hash", "[assets]") {
+	static_assert(vx::assets::hashName(vx::StringSlice{}) == 0xcbf2'9ce4'8422'2325u);
+	REQUIRE(vx::assets::hashName(toSlice("a")) == 0xaf63'dc4c'8601'ec8cu);
+	REQUIRE(vx::assets::hashName(toSlice("foobar")) == 0x8594'4171'f739'67e8u);
+}
+
+
+TEST_CASE("atlas - max rects packer", "[assets]") {
+	vx::assets::MaxRectsPacker packer {256u, 256u};
+	std::vector<vx::assets::PackedRect> rects {};
+	std::mt19937 random {7u};
+	std::uniform_int_distribution<std::uint32_t> side {4u, 40u};
+	std::uint64_t area {0u};
+	while (true) {
+		const std::uint32_t width {side(random)};
+		const std::uint32_t height {side(random)};
+		const std::optional<vx::assets::PackedRect> rect {packer.insert(width, height)};
+		if (!rect)
+			break;
+		REQUIRE(rect->width == width);
+		REQUIRE(rect->height == height);
+		REQUIRE(rect->x + rect->width <= 256u);
+		REQUIRE(rect->y + rect->height <= 256u);
+		for (const vx::assets::PackedRect& other : rects)
+			REQUIRE_FALSE(overlaps(*rect, other));
+		rects.push_back(*rect);
+		area += width * height;
+	}
+	REQUIRE(packer.getUsedArea() == area);
+	/* best short side fit keeps the waste low on random rectangles */
+	REQUIRE(area * 10u >= 256u * 256u * 7u);
+	for (const vx::assets::PackedRect& free : packer.getFreeRects()) {
+		for (const vx::assets::PackedRect& rect : rects)
+			REQUIRE_FALSE(overlaps(free, rect));
+	}
+
+	/* released space is found again */
+	packer.release(rects[3]);
+	const std::optional<vx::assets::PackedRect> reused {packer.insert(rects[3].width, rects[3].height)};
+	REQUIRE(reused.has_value());
+	REQUIRE(packer.getUsedArea() == area);
+	rects[3] = *reused;
+
+	/* neighbours released in any order join back, down to the whole area once nothing is left */
+	std::ranges::shuffle(rects, random);
+	for (const vx::assets::PackedRect& rect : rects)
+		packer.release(rect);
+	REQUIRE(packer.getUsedArea() == 0u);
+	REQUIRE(std::ranges::equal(packer.getFreeRects(), std::array{vx::assets::PackedRect{0u, 0u, 256u, 256u}}));
+
+	packer.clear();
+	for (std::size_t i {0uz}; i < 16uz; ++i)
+		REQUIRE(packer.insert(64u, 64u).has_value());
+	packer.release({64u, 64u, 64u, 64u});
+	packer.release({128u, 64u, 64u, 64u});
+	REQUIRE(packer.insert(128u, 64u) == vx::assets::PackedRect{64u, 64u, 128u, 64u});
+	packer.clear();
+	REQUIRE(packer.getUsedArea() == 0u);
+	REQUIRE(packer.insert(256u, 256u) == vx::assets::PackedRect{0u, 0u, 256u, 256u});
+	REQUIRE_FALSE(packer.insert(1u, 1u).has_value());
+}
+
+
+TEST_CASE("atlas - write and load", "[assets]") {
+	vx::assets::AtlasBuilder builder {{.pageWidth = 64u, .pageHeight = 64u, .padding = 1u, .trim = true}};
+	std::vector<std::string> names {};
+	std::vector<vx::render::Image> images {};
+	for (std::uint32_t i {0u}; i < 60u; ++i) {
+		names.push_back("sprite_" + std::to_string(i));
+		images.push_back(makeSprite(8u + i % 13u, 6u + i % 17u, i % 4u, i));
+		REQUIRE(builder.set(toSlice(names.back()), images.back()));
+	}
+	names.push_back("empty");
+	images.emplace_back(5u, 5u, 0u);
+	REQUIRE(builder.set(toSlice(names.back()), images.back()));
+	REQUIRE_FALSE(builder.set(toSlice("huge"), makeSprite(100u, 10u, 0u, 0u)));
+	REQUIRE(builder.getSpriteCount() == 61uz);
+	REQUIRE(builder.getPages().size() > 1uz);
+
+	const std::vector<std::byte> bytes {builder.write()};
+	const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+	REQUIRE(atlas.has_value());
+	REQUIRE(atlas->getPages().size() == builder.getPages().size());
+	REQUIRE(atlas->getEntries().size() == 61uz);
+	for (const vx::assets::AtlasPage& page : atlas->getPages())
+		REQUIRE(page.pixelsOffset % vx::assets::ATLAS_PAGE_ALIGNMENT == 0u);
+	for (std::size_t i {0uz}; i < names.size(); ++i)
+		REQUIRE(hasSprite(*atlas, names[i], images[i]));
+	REQUIRE(atlas->find(toSlice("missing")) == nullptr);
+
+	/* trimming keeps only the opaque pixels */
+	const vx::assets::AtlasEntry* const entry {atlas->find(toSlice("sprite_3"))};
+	REQUIRE(entry != nullptr);
+	REQUIRE(entry->offsetX == 3u);
+	REQUIRE(entry->offsetY == 3u);
+	REQUIRE(entry->width == 11u);
+	REQUIRE(entry->height == 9u);
+	REQUIRE(entry->uv[0] == static_cast<float> (entry->x) / 64.f);
+	REQUIRE(entry->uv[3] == static_cast<float> (entry->y + entry->height) / 64.f);
+	REQUIRE(atlas->find(toSlice("empty"))->width == 0u);
+
+	std::vector<std::byte> corrupted {bytes};
+	corrupted[0] = std::byte{0};
+	REQUIRE_FALSE(vx::assets::Atlas::fromBytes(corrupted).has_value());
+	REQUIRE_FALSE(vx::assets::Atlas::fromBytes(std::span{bytes}.first(vx::assets::ATLAS_PAGE_ALIGNMENT)).has_value());
+
+	const std::vector<std::byte> empty {vx::assets::AtlasBuilder{}.write()};
+	const std::optional<vx::assets::Atlas> emptyAtlas {vx::assets::Atlas::fromBytes(empty)};
+	REQUIRE(emptyAtlas.has_value());
+	REQUIRE(emptyAtlas->getPages().empty());
+	REQUIRE(emptyAtlas->find(toSlice("sprite_0")) == nullptr);
+}
+
+
+TEST_CASE("atlas - incremental edits", "[assets]") {
+	vx::assets::AtlasBuilder builder {{.pageWidth = 48u, .pageHeight = 48u, .padding = 1u, .trim = true}};
+	std::vector<std::string> names {};
+	std::vector<vx::render::Image> images {};
+	for (std::uint32_t i {0u}; i < 20u; ++i) {
+		names.push_back("sprite_" + std::to_string(i));
+		images.push_back(makeSprite(10u + i % 5u, 10u + i % 3u, 1u, i));
+		REQUIRE(builder.set(toSlice(names[i]), images[i]));
+	}
+	REQUIRE(builder.getPages().size() >= 2uz);
+	const std::vector<std::byte> before {builder.write()};
+	const std::optional<vx::assets::Atlas> previous {vx::assets::Atlas::fromBytes(before)};
+	REQUIRE(previous.has_value());
+	const vx::assets::AtlasEntry placed {*previous->find(toSlice(names[2]))};
+	builder.clearDirtyPages();
+
+	SECTION("unchanged") {
+		REQUIRE(builder.set(toSlice(names[2]), makeSprite(10u + 2u, 10u + 2u, 1u, 2u)));
+		for (std::uint32_t page {0u}; page < builder.getPages().size(); ++page)
+			REQUIRE_FALSE(builder.isPageDirty(page));
+		REQUIRE(builder.write() == before);
+	}
+
+	SECTION("in place") {
+		images[2] = makeSprite(9u, 11u, 4u, 100u);
+		REQUIRE(builder.set(toSlice(names[2]), images[2]));
+		for (std::uint32_t page {0u}; page < builder.getPages().size(); ++page)
+			REQUIRE(builder.isPageDirty(page) == (page == placed.page));
+		const std::vector<std::byte> bytes {builder.write()};
+		const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+		REQUIRE(atlas->find(toSlice(names[2]))->x == placed.x);
+		REQUIRE(atlas->find(toSlice(names[2]))->y == placed.y);
+		for (std::size_t i {0uz}; i < names.size(); ++i)
+			REQUIRE(hasSprite(*atlas, names[i], images[i]));
+	}
+
+	SECTION("moved") {
+		images[2] = makeSprite(30u, 20u, 0u, 101u);
+		REQUIRE(builder.set(toSlice(names[2]), images[2]));
+		const std::vector<std::byte> bytes {builder.write()};
+		const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+		for (std::size_t i {0uz}; i < names.size(); ++i) {
+			REQUIRE(hasSprite(*atlas, names[i], images[i]));
+			if (i == 2uz)
+				continue;
+			/* the other sprites stay where they were */
+			const vx::assets::AtlasEntry* const entry {atlas->find(toSlice(names[i]))};
+			const vx::assets::AtlasEntry* const old {previous->find(toSlice(names[i]))};
+			REQUIRE(entry->page == old->page);
+			REQUIRE(entry->x == old->x);
+			REQUIRE(entry->y == old->y);
+		}
+	}
+
+	SECTION("removed") {
+		REQUIRE(builder.remove(toSlice(names[2])));
+		REQUIRE_FALSE(builder.remove(toSlice(names[2])));
+		REQUIRE(builder.isPageDirty(placed.page));
+		const std::vector<std::byte> bytes {builder.write()};
+		const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+		REQUIRE(atlas->getEntries().size() == 19uz);
+		REQUIRE(atlas->find(toSlice(names[2])) == nullptr);
+		for (std::size_t i {0uz}; i < names.size(); ++i) {
+			if (i != 2uz)
+				REQUIRE(hasSprite(*atlas, names[i], images[i]));
+		}
+	}
+
+	SECTION("restored") {
+		std::optional<vx::assets::AtlasBuilder> restored {vx::assets::AtlasBuilder::restore(
+			*previous, {.pageWidth = 48u, .pageHeight = 48u, .padding = 1u, .trim = true}
+		)};
+		REQUIRE(restored.has_value());
+		REQUIRE(restored->getSpriteCount() == 20uz);
+		REQUIRE(restored->write() == before);
+		REQUIRE(restored->set(toSlice(names[0]), makeSprite(10u, 10u, 1u, 0u)));
+		for (std::uint32_t page {0u}; page < restored->getPages().size(); ++page)
+			REQUIRE_FALSE(restored->isPageDirty(page));
+		images.push_back(makeSprite(12u, 12u, 0u, 200u));
+		names.push_back("added");
+		REQUIRE(restored->set(toSlice(names.back()), images.back()));
+		const std::vector<std::byte> bytes {restored->write()};
+		const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+		for (std::size_t i {0uz}; i < names.size(); ++i)
+			REQUIRE(hasSprite(*atlas, names[i], images[i]));
+		REQUIRE_FALSE(vx::assets::AtlasBuilder::restore(*previous, {.pageWidth = 64u, .pageHeight = 48u}).has_value());
+	}
+
+	SECTION("repacked") {
+		builder.repack();
+		const std::vector<std::byte> bytes {builder.write()};
+		const std::optional<vx::assets::Atlas> atlas {vx::assets::Atlas::fromBytes(bytes)};
+		for (std::size_t i {0uz}; i < names.size(); ++i)
+			REQUIRE(hasSprite(*atlas, names[i], images[i]));
+	}
+}
@@ -0,0 +1,145 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <voxlet/assets/pack.hpp>
+#include <voxlet/assets/packBuilder.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	using vx::testing::toSlice;
+
+	auto toBytes(const std::string& string) noexcept -> std::span<const std::byte> {
+		return std::as_bytes(std::span{string});
+	}
+
+	auto makeContent(const std::size_t index) -> std::string {
+		std::string content {};
+		for (std::size_t i {0uz}; i < index * 37uz % 9000uz; ++i)
+			content.push_back(static_cast<char> ('a' + (i * index) % 26uz));
+		return content;
+	}
+}
+
+
+TEST_CASE("pack - write and load", "[assets]") {
+	vx::assets::PackBuilder builder {};
+	std::vector<std::string> paths {};
+	std::vector<std::string> contents {};
+	for (std::size_t i {0uz}; i < 300uz; ++i) {
+		paths.push_back("textures/tile_" + std::to_string(i) + ".png");
+		contents.push_back(makeContent(i));
+		REQUIRE(builder.add(toSlice(paths[i]), toBytes(contents[i]), vx::assets::PackCompression::none));
+	}
+	REQUIRE_FALSE(builder.add(toSlice(paths[12]), toBytes(contents[0]), vx::assets::PackCompression::none));
+	REQUIRE(builder.getBlobCount() == 300uz);
+
+	const std::vector<std::byte> bytes {builder.write()};
+	const std::optional<vx::assets::Pack> pack {vx::assets::Pack::fromBytes(bytes)};
+	REQUIRE(pack.has_value());
+	REQUIRE(pack->getEntries().size() == 300uz);
+	REQUIRE(std::ranges::is_sorted(pack->getEntries(), {}, &vx::assets::PackEntry::hash));
+	for (std::size_t i {0uz}; i < paths.size(); ++i) {
+		const vx::assets::PackEntry* const entry {pack->find(toSlice(paths[i]))};
+		REQUIRE(entry != nullptr);
+		REQUIRE(std::ranges::equal(pack->getPath(*entry), toSlice(paths[i])));
+		REQUIRE(entry->offset % vx::assets::PACK_BLOB_ALIGNMENT == 0u);
+		REQUIRE(std::ranges::equal(pack->getBlob(*entry), toBytes(contents[i])));
+		/* the blob is read in place */
+		REQUIRE(pack->getBlob(*entry).data() == bytes.data() + entry->offset);
+
+		std::vector<std::byte> output (contents[i].size());
+		REQUIRE(pack->read(*entry, output));
+		REQUIRE(std::ranges::equal(output, toBytes(contents[i])));
+		output.push_back(std::byte{0});
+		REQUIRE_FALSE(pack->read(*entry, output));
+	}
+	REQUIRE(pack->find(toSlice("textures/tile_300.png")) == nullptr);
+	REQUIRE(pack->find(toSlice("")) == nullptr);
+
+	/* the order of `add` doesn't change the file */
+	vx::assets::PackBuilder reversed {};
+	for (std::size_t i {paths.size()}; i-- != 0uz;)
+		REQUIRE(reversed.add(toSlice(paths[i]), toBytes(contents[i]), vx::assets::PackCompression::none));
+	REQUIRE(reversed.write() == bytes);
+
+	const std::vector<std::byte> empty {vx::assets::PackBuilder{}.write()};
+	const std::optional<vx::assets::Pack> emptyPack {vx::assets::Pack::fromBytes(empty)};
+	REQUIRE(emptyPack.has_value());
+	REQUIRE(emptyPack->getEntries().empty());
+	REQUIRE(emptyPack->find(toSlice(paths[0])) == nullptr);
+}
+
+
+TEST_CASE("pack - invalid data", "[assets]") {
+	vx::assets::PackBuilder builder {};
+	const std::string content {makeContent(100uz)};
+	REQUIRE(builder.add(toSlice("a"), toBytes(content), vx::assets::PackCompression::none));
+	const std::vector<std::byte> bytes {builder.write()};
+	REQUIRE(vx::assets::Pack::fromBytes(bytes).has_value());
+
+	std::vector<std::byte> corrupted {bytes};
+	corrupted[4] = std::byte{2};
+	REQUIRE_FALSE(vx::assets::Pack::fromBytes(corrupted).has_value());
+	/* truncated in the blob */
+	REQUIRE_FALSE(vx::assets::Pack::fromBytes(std::span{bytes}.first(bytes.size() - 1uz)).has_value());
+	REQUIRE_FALSE(vx::assets::Pack::fromBytes(std::span{bytes}.first(sizeof(vx::assets::PackHeader) - 1uz)).has_value());
+}
+
+
+TEST_CASE("pack - open", "[assets]") {
+	vx::assets::PackBuilder builder {};
+	const std::string content {makeContent(42uz)};
+	REQUIRE(builder.add(toSlice("sounds/step.wav"), toBytes(content), vx::assets::PackCompression::none));
+	REQUIRE(builder.add(toSlice("empty"), {}, vx::assets::PackCompression::none));
+	const std::vector<std::byte> bytes {builder.write()};
+	const auto path {std::filesystem::temp_directory_path() / "voxlet-pack-test.pack"};
+	std::ofstream {path, std::ios::binary | std::ios::trunc}.write(reinterpret_cast<const char*> (bytes.data()), static_cast<std::streamsize> (bytes.size()));
+
+	{
+		const std::string pathString {path.string()};
+		const std::optional<vx::assets::Pack> pack {vx::assets::Pack::open(toSlice(pathString))};
+		REQUIRE(pack.has_value());
+		const vx::assets::PackEntry* const entry {pack->find(toSlice("sounds/step.wav"))};
+		REQUIRE(entry != nullptr);
+		pack->prefetch(*entry);
+		REQUIRE(std::ranges::equal(pack->getBlob(*entry), toBytes(content)));
+		REQUIRE(pack->find(toSlice("empty"))->size == 0u);
+		REQUIRE(pack->getBlob(*pack->find(toSlice("empty"))).empty());
+	}
+	REQUIRE_FALSE(vx::assets::Pack::open(toSlice("/nonexistent/voxlet.pack")).has_value());
+	std::filesystem::remove(path);
+}
+
+
+TEST_CASE("pack - compression", "[assets]") {
+	vx::assets::PackBuilder builder {};
+	std::string text {};
+	for (std::size_t i {0uz}; i < 5000uz; ++i)
+		text += "tile_" + std::to_string(i % 50uz) + " ";
+	const std::string noise {makeContent(300uz)};
+	REQUIRE(builder.add(toSlice("levels/1.txt"), toBytes(text), vx::assets::PackCompression::lz));
+	/* too short to compress */
+	REQUIRE(builder.add(toSlice("tiny"), toBytes("ab"), vx::assets::PackCompression::lz));
+	REQUIRE(builder.add(toSlice("empty"), {}, vx::assets::PackCompression::lz));
+	REQUIRE(builder.add(toSlice("raw"), toBytes(noise), vx::assets::PackCompression::none));
+	const std::vector<std::byte> bytes {builder.write()};
+	const std::optional<vx::assets::Pack> pack {vx::assets::Pack::fromBytes(bytes)};
+	REQUIRE(pack.has_value());
+
+	const vx::assets::PackEntry* const entry {pack->find(toSlice("levels/1.txt"))};
+	REQUIRE(entry->compression == vx::assets::PackCompression::lz);
+	REQUIRE(entry->uncompressedSize == text.size());
+	REQUIRE(entry->size < text.size() / 4uz);
+	std::vector<std::byte> output (text.size());
+	REQUIRE(pack->read(*entry, output));
+	REQUIRE(std::ranges::equal(output, toBytes(text)));
+
+	REQUIRE(pack->find(toSlice("tiny"))->compression == vx::assets::PackCompression::none);
+	REQUIRE(pack->find(toSlice("empty"))->compression == vx::assets::PackCompression::none);
+	REQUIRE(pack->find(toSlice("raw"))->compression == vx::assets::PackCompression::none);
+}
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/async/event.hpp>
+#include <voxlet/async/executor.hpp>
+#include <voxlet/async/frameClock.hpp>
+#include <voxlet/async/framePool.hpp>
+#include <voxlet/async/task.hpp>
+#include <voxlet/async/whenAll.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+
+
+namespace {
+	auto square(const int value) -> vx::async::Task<int> {
+		co_return value * value;
+	}
+
+	auto sumOfSquares(const int count) -> vx::async::Task<int> {
+		int sum {0};
+		for (int i {0}; i < count; ++i)
+			sum += co_await square(i);
+		co_return sum;
+	}
+
+	auto squareOnScheduler(vx::jobs::Scheduler& scheduler, const int value) -> vx::async::Task<int> {
+		co_await vx::async::schedule(scheduler);
+		co_return co_await square(value);
+	}
+
+	auto touch(vx::jobs::Scheduler& scheduler, std::atomic<int>& counter) -> vx::async::Task<> {
+		co_await vx::async::schedule(scheduler);
+		++counter;
+	}
+
+	auto moveOnly(const int value) -> vx::async::Task<std::unique_ptr<int>> {
+		co_return std::make_unique<int> (value);
+	}
+
+	auto largest(std::vector<int>& values) -> vx::async::Task<int&> {
+		co_return *std::ranges::max_element(values);
+	}
+
+	auto doubleLargest(std::vector<int>& values) -> vx::async::Task<> {
+		int& value {co_await largest(values)};
+		value *= 2;
+	}
+}
+
+
+TEST_CASE("task", "[async]") {
+	const std::size_t workerCount {GENERATE(0uz, 2uz)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+
+	SECTION("lazy start") {
+		bool started {false};
+		auto task {[](bool& started) -> vx::async::Task<> {
+			started = true;
+			co_return;
+		}(started)};
+		REQUIRE(task.isValid());
+		REQUIRE(!task.isDone());
+		REQUIRE(!started);
+		vx::async::syncWait(scheduler, std::move(task));
+		REQUIRE(started);
+	}
+
+	SECTION("nested tasks") {
+		REQUIRE(vx::async::syncWait(scheduler, sumOfSquares(10)) == 285);
+		REQUIRE(*vx::async::syncWait(scheduler, moveOnly(42)) == 42);
+	}
+
+	SECTION("reference result") {
+		std::vector<int> values {3, 9, 4};
+		int& value {vx::async::syncWait(scheduler, largest(values))};
+		REQUIRE(&value == &values[1]);
+		vx::async::syncWait(scheduler, doubleLargest(values));
+		REQUIRE(values[1] == 18);
+	}
+
+	SECTION("scheduler hop") {
+		REQUIRE(vx::async::syncWait(scheduler, squareOnScheduler(scheduler, 7)) == 49);
+	}
+
+	SECTION("when all") {
+		auto [a, b, c] {vx::async::syncWait(scheduler, vx::async::whenAll(
+			squareOnScheduler(scheduler, 2),
+			square(3),
+			squareOnScheduler(scheduler, 4)
+		))};
+		REQUIRE(a == 4);
+		REQUIRE(b == 9);
+		REQUIRE(c == 16);
+
+		std::atomic<int> counter {0};
+		std::vector<vx::async::Task<>> tasks {};
+		for (int i {0}; i < 100; ++i)
+			tasks.push_back(touch(scheduler, counter));
+		const auto results {vx::async::syncWait(scheduler, vx::async::whenAll(std::move(tasks)))};
+		REQUIRE(results.size() == 100uz);
+		REQUIRE(counter == 100);
+	}
+
+	SECTION("when any") {
+		vx::async::Event never {};
+		std::vector<vx::async::Task<int>> tasks {};
+		tasks.push_back([](vx::async::Event& event) -> vx::async::Task<int> {
+			co_await event;
+			co_return 1;
+		}(never));
+		tasks.push_back(squareOnScheduler(scheduler, 5));
+		const auto result {vx::async::syncWait(scheduler, vx::async::whenAny(std::move(tasks)))};
+		REQUIRE(result.index == 1uz);
+		REQUIRE(result.value == 25);
+		never.set();
+	}
+}
+
+
+TEST_CASE("event", "[async]") {
+	vx::async::Event event {};
+	int resumed {0};
+	const auto waiter {[](vx::async::Event& event, int& resumed) -> vx::async::Task<> {
+		co_await event;
+		++resumed;
+	}};
+
+	vx::async::spawn(waiter(event, resumed));
+	vx::async::spawn(waiter(event, resumed));
+	REQUIRE(!event.isSet());
+	REQUIRE(resumed == 0);
+	event.set();
+	REQUIRE(event.isSet());
+	REQUIRE(resumed == 2);
+
+	vx::async::spawn(waiter(event, resumed));
+	REQUIRE(resumed == 3);
+	event.reset();
+	REQUIRE(!event.isSet());
+
+	vx::jobs::Scheduler scheduler {{.workerCount = 0uz}};
+	vx::async::spawn(waiter(event, resumed));
+	event.set(scheduler);
+	while (resumed != 4)
+		(void)scheduler.tryRunOne();
+}
+
+
+TEST_CASE("frame-clock", "[async]") {
+	vx::async::FrameClock clock {};
+	std::vector<std::uint64_t> frames {};
+	vx::async::spawn([](vx::async::FrameClock& clock, std::vector<std::uint64_t>& frames) -> vx::async::Task<> {
+		for (int i {0}; i < 3; ++i)
+			frames.push_back(co_await clock.nextFrame());
+	}(clock, frames));
+
+	REQUIRE(frames.empty());
+	REQUIRE(clock.getWaiterCount() == 1uz);
+	for (std::uint64_t frame {1u}; frame <= 4u; ++frame) {
+		clock.tick();
+		REQUIRE(clock.getFrameIndex() == frame);
+	}
+	REQUIRE(frames == std::vector<std::uint64_t> {1u, 2u, 3u});
+	REQUIRE(clock.getWaiterCount() == 0uz);
+}
+
+
+TEST_CASE("frame-pool", "[async]") {
+	REQUIRE(vx::async::FramePool::getSizeClass(1uz) == 0uz);
+	REQUIRE(vx::async::FramePool::getSizeClass(64uz) == 0uz);
+	REQUIRE(vx::async::FramePool::getSizeClass(65uz) == 1uz);
+
+	void* const first {vx::async::FramePool::allocate(100uz)};
+	vx::async::FramePool::deallocate(first, 100uz);
+	void* const second {vx::async::FramePool::allocate(120uz)};
+	REQUIRE(first == second);
+	vx::async::FramePool::deallocate(second, 120uz);
+
+	vx::jobs::Scheduler scheduler {{.workerCount = 0uz}};
+	(void)vx::async::syncWait(scheduler, sumOfSquares(4));
+	const std::size_t slabCount {vx::async::FramePool::getSlabCount()};
+	for (int i {0}; i < 1000; ++i)
+		(void)vx::async::syncWait(scheduler, sumOfSquares(4));
+	REQUIRE(vx::async::FramePool::getSlabCount() == slabCount);
+}
+
+
+TEST_CASE("frame-pool - other threads", "[async]") {
+	/* frames made on a thread and destroyed on another, then threads that come and go */
+	const auto allocateAll = [] (std::vector<void*>& blocks) {
+		for (void*& block : blocks)
+			block = vx::async::FramePool::allocate(200uz);
+	};
+	const auto deallocateAll = [] (std::vector<void*>& blocks) {
+		for (void* const block : blocks)
+			vx::async::FramePool::deallocate(block, 200uz);
+	};
+
+	std::vector<void*> blocks (2000uz);
+	allocateAll(blocks);
+	std::thread{deallocateAll, std::ref(blocks)}.join();
+	const std::size_t slabCount {vx::async::FramePool::getSlabCount()};
+	for (int i {0}; i < 50; ++i) {
+		allocateAll(blocks);
+		std::thread{deallocateAll, std::ref(blocks)}.join();
+	}
+	REQUIRE(vx::async::FramePool::getSlabCount() == slabCount);
+
+	std::thread{[&] {
+		allocateAll(blocks);
+		deallocateAll(blocks);
+	}}.join();
+	const std::size_t threadSlabCount {vx::async::FramePool::getSlabCount()};
+	for (int i {0}; i < 20; ++i) {
+		std::thread{[&] {
+			allocateAll(blocks);
+			deallocateAll(blocks);
+		}}.join();
+	}
+	REQUIRE(vx::async::FramePool::getSlabCount() == threadSlabCount);
+}
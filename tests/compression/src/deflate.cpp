@@ -0,0 +1,215 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/compression/deflate.hpp>
+#include <voxlet/testing/content.hpp>
+
+
+namespace {
+	using vx::testing::Content;
+	using vx::testing::makeContent;
+
+	auto toBytes(const std::string& string) -> std::vector<std::byte> {
+		const std::span<const std::byte> bytes {std::as_bytes(std::span{string})};
+		return {bytes.begin(), bytes.end()};
+	}
+
+	template <std::size_t N>
+	auto toBytes(const std::uint8_t (&values)[N]) -> std::vector<std::byte> {
+		std::vector<std::byte> bytes (N);
+		for (std::size_t i {0uz}; i < N; ++i)
+			bytes[i] = static_cast<std::byte> (values[i]);
+		return bytes;
+	}
+
+	auto referenceAdler32(const std::span<const std::byte> bytes) noexcept -> std::uint32_t {
+		std::uint32_t a {1u};
+		std::uint32_t b {0u};
+		for (const std::byte byte : bytes) {
+			a = (a + static_cast<std::uint32_t> (byte)) % 65521u;
+			b = (b + a) % 65521u;
+		}
+		return (b << 16u) | a;
+	}
+}
+
+
+TEST_CASE("deflate - adler32", "[compression]") {
+	REQUIRE(vx::compression::adler32({}) == 1u);
+	REQUIRE(vx::compression::adler32(toBytes("Wikipedia")) == 0x11e6'0398u);
+
+	const std::size_t size {GENERATE(1uz, 31uz, 32uz, 33uz, 5552uz, 100'000uz)};
+	std::vector<std::byte> bytes (size);
+	/* all 0xff is the worst case for the lanes of the sums */
+	for (std::size_t i {0uz}; i < size; ++i)
+		bytes[i] = i % 3uz == 0uz ? std::byte{0xff} : static_cast<std::byte> (i * 7uz);
+	REQUIRE(vx::compression::adler32(bytes) == referenceAdler32(bytes));
+	const std::vector<std::byte> full (size, std::byte{0xff});
+	REQUIRE(vx::compression::adler32(full) == referenceAdler32(full));
+
+	/* the checksum carries over from one part to the next */
+	const std::size_t split {size / 3uz};
+	const std::span<const std::byte> span {bytes};
+	REQUIRE(vx::compression::adler32(span.subspan(split), vx::compression::adler32(span.first(split))) == referenceAdler32(bytes));
+}
+
+
+TEST_CASE("deflate - crc32", "[compression]") {
+	REQUIRE(vx::compression::crc32({}) == 0u);
+	REQUIRE(vx::compression::crc32(toBytes("123456789")) == 0xcbf4'3926u);
+	REQUIRE(vx::compression::crc32(toBytes("The quick brown fox jumps over the lazy dog")) == 0x414f'a339u);
+
+	/* the checksum carries over from one part to the next, whatever the parts are cut at */
+	const std::vector<std::byte> bytes {makeContent(Content::random, 1000uz)};
+	const std::span<const std::byte> span {bytes};
+	const std::uint32_t whole {vx::compression::crc32(bytes)};
+	const std::size_t split {GENERATE(0uz, 1uz, 7uz, 8uz, 9uz, 333uz, 1000uz)};
+	REQUIRE(vx::compression::crc32(span.subspan(split), vx::compression::crc32(span.first(split))) == whole);
+}
+
+
+TEST_CASE("deflate - reference streams", "[compression]") {
+	/* written by zlib at level 9, a dynamic block */
+	const std::vector<std::byte> dynamic {toBytes({
+		0x78, 0xda, 0x75, 0x92, 0x31, 0x0a, 0xc3, 0x30, 0x10, 0x04, 0xbf, 0xe2, 0x27, 0xdc, 0x9e, 0x2c,
+		0xc9, 0x26, 0x8f, 0x09, 0x29, 0x5c, 0x18, 0x5c, 0x04, 0xc7, 0x4d, 0x7e, 0x1f, 0x0c, 0xd2, 0x11,
+		0x56, 0x6c, 0x77, 0x30, 0x30, 0x2c, 0xc7, 0x5c, 0xfb, 0xb1, 0x3d, 0x6d, 0xfa, 0xbc, 0xcf, 0xfd,
+		0xba, 0x8f, 0xe3, 0xf5, 0xdd, 0xce, 0xc9, 0x1e, 0xd3, 0x75, 0x03, 0x74, 0x80, 0x06, 0xd0, 0x80,
+		0x77, 0xe0, 0x0d, 0x78, 0x03, 0xa9, 0x83, 0x44, 0xaa, 0xb9, 0x83, 0x99, 0x54, 0xb9, 0x83, 0x4c,
+		0xaa, 0xd2, 0x41, 0x21, 0x55, 0xcc, 0xad, 0xa4, 0x8a, 0xb9, 0x0b, 0xa9, 0x62, 0xee, 0x4a, 0xaa,
+		0x98, 0x0b, 0x23, 0x57, 0xec, 0x05, 0x48, 0x16, 0x83, 0xe1, 0x64, 0x2b, 0xfc, 0x47, 0xf0, 0x62,
+		0x76, 0x81, 0xff, 0x68, 0xbc, 0x38, 0x91, 0x2a, 0xf1, 0x1f, 0x9d, 0x07, 0x67, 0x52, 0x65, 0xfe,
+		0x23, 0x78, 0x6e, 0x25, 0x95, 0xf1, 0x1f, 0x87, 0x1e, 0x56, 0xd5, 0x43, 0xfc, 0x71, 0x08, 0x22,
+		0xfe, 0x38, 0x14, 0x11, 0x7f, 0x1c, 0x92, 0x30, 0x95, 0x04, 0x54, 0x12, 0xae, 0x92, 0x48, 0x2a,
+		0x89, 0x59, 0x25, 0x91, 0x55, 0x11, 0x45, 0x05, 0x51, 0x55, 0x0f, 0x8b, 0xea, 0x61, 0x55, 0x3d,
+		0xc0, 0x54, 0x10, 0x80, 0x2a, 0x02, 0xae, 0x92, 0xf8, 0x93, 0xfd, 0x00, 0xfd, 0x9c, 0x53, 0xab
+	})};
+	std::string text {};
+	for (std::size_t i {0uz}; i < 40uz; ++i)
+		text += "tile_" + std::to_string(i % 7uz) + " sprite_" + std::to_string(i % 13uz) + " layer " + std::to_string(i % 3uz) + "; ";
+	std::vector<std::byte> output (text.size());
+	REQUIRE(vx::compression::inflate(dynamic, output, vx::compression::DeflateFormat::zlib) == text.size());
+	REQUIRE(output == toBytes(text));
+
+	/* raw, a fixed block */
+	const std::vector<std::byte> fixed {toBytes({0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57, 0xc8, 0x40, 0x27, 0x15, 0x01})};
+	std::vector<std::byte> hello (64uz);
+	REQUIRE(vx::compression::inflate(fixed, hello, vx::compression::DeflateFormat::raw) == 24uz);
+	hello.resize(24uz);
+	REQUIRE(hello == toBytes("hello hello hello hello!"));
+
+	/* a final stored block */
+	const std::vector<std::byte> stored {toBytes({0x01, 0x06, 0x00, 0xf9, 0xff, 'v', 'o', 'x', 'l', 'e', 't'})};
+	std::vector<std::byte> voxlet (6uz);
+	REQUIRE(vx::compression::inflate(stored, voxlet, vx::compression::DeflateFormat::raw) == 6uz);
+	REQUIRE(voxlet == toBytes("voxlet"));
+
+	const std::vector<std::byte> empty {toBytes({0x78, 0x9c, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01})};
+	REQUIRE(vx::compression::inflate(empty, {}, vx::compression::DeflateFormat::zlib) == 0uz);
+}
+
+
+TEST_CASE("deflate - round trip", "[compression]") {
+	const Content content {GENERATE(Content::zeros, Content::text, Content::pattern, Content::random, Content::skewed)};
+	const std::size_t size {GENERATE(0uz, 1uz, 100uz, 4096uz, 70'000uz, 300'000uz)};
+	const auto format {GENERATE(vx::compression::DeflateFormat::raw, vx::compression::DeflateFormat::zlib)};
+	const std::vector<std::byte> input {makeContent(content, size)};
+
+	const std::vector<std::byte> stream {vx::compression::deflate(input, format)};
+	if (size >= 4096uz && content != Content::random && content != Content::skewed)
+		REQUIRE(stream.size() < size / 4uz);
+	/* random blocks are stored as is, a 64 KB block takes two stored ones of at most 65535 bytes */
+	if (content == Content::random)
+		REQUIRE(stream.size() <= size + 10uz * (size / 65'536uz + 1uz) + 6uz);
+
+	std::vector<std::byte> output (size);
+	REQUIRE(vx::compression::inflate(stream, output, format) == size);
+	REQUIRE(output == input);
+	/* exact sized outputs take the careful loop at the end, bigger ones stay in the fast one */
+	std::vector<std::byte> bigOutput (size + 1000uz);
+	REQUIRE(vx::compression::inflate(stream, bigOutput, format) == size);
+	REQUIRE(std::ranges::equal(std::span{bigOutput}.first(size), input));
+	if (size != 0uz) {
+		output.pop_back();
+		REQUIRE_FALSE(vx::compression::inflate(stream, output, format).has_value());
+	}
+}
+
+
+TEST_CASE("deflate - streaming", "[compression]") {
+	const Content content {GENERATE(Content::text, Content::random, Content::skewed)};
+	const std::size_t chunkSize {GENERATE(1uz, 1000uz, 65'536uz, 1'000'000uz)};
+	const std::vector<std::byte> input {makeContent(content, 700'000uz)};
+	const std::vector<std::byte> stream {vx::compression::deflate(input, vx::compression::DeflateFormat::zlib)};
+
+	vx::compression::Inflater inflater {stream, vx::compression::DeflateFormat::zlib};
+	std::vector<std::byte> output {};
+	std::vector<std::byte> chunk (chunkSize);
+	while (true) {
+		const std::size_t size {inflater.read(chunk)};
+		output.insert(output.end(), chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t> (size));
+		if (size < chunk.size())
+			break;
+		REQUIRE_FALSE(inflater.hasFailed());
+	}
+	REQUIRE(inflater.isDone());
+	REQUIRE_FALSE(inflater.hasFailed());
+	REQUIRE(output == input);
+	REQUIRE(inflater.read(chunk) == 0uz);
+
+	/* the checksum is only known at the end */
+	std::vector<std::byte> corrupted {stream};
+	corrupted.back() ^= std::byte{1};
+	vx::compression::Inflater corruptedInflater {corrupted, vx::compression::DeflateFormat::zlib};
+	std::vector<std::byte> whole (input.size() + 1uz);
+	REQUIRE(corruptedInflater.read(whole) == input.size());
+	REQUIRE(corruptedInflater.hasFailed());
+	REQUIRE_FALSE(corruptedInflater.isDone());
+}
+
+
+TEST_CASE("deflate - malformed streams", "[compression]") {
+	const std::vector<std::byte> input {makeContent(Content::text, 20'000uz)};
+	const std::vector<std::byte> stream {vx::compression::deflate(input, vx::compression::DeflateFormat::raw)};
+	std::vector<std::byte> output (input.size());
+
+	/* every outcome is fine as long as nothing is read or written out of bounds */
+	std::mt19937 random {3u};
+	for (std::size_t i {0uz}; i < 2000uz; ++i) {
+		std::vector<std::byte> corrupted {stream};
+		for (std::size_t j {0uz}; j < 1uz + i % 4uz; ++j)
+			corrupted[random() % corrupted.size()] = static_cast<std::byte> (random());
+		corrupted.resize(corrupted.size() - i % 3uz);
+		(void)vx::compression::inflate(corrupted, output, vx::compression::DeflateFormat::raw);
+		vx::compression::Inflater inflater {corrupted, vx::compression::DeflateFormat::raw};
+		(void)inflater.read(output);
+	}
+	REQUIRE_FALSE(vx::compression::inflate({}, output, vx::compression::DeflateFormat::raw).has_value());
+	REQUIRE_FALSE(vx::compression::inflate(std::span{stream}.first(stream.size() / 2uz), output, vx::compression::DeflateFormat::raw).has_value());
+	REQUIRE_FALSE(vx::compression::inflate(std::span{stream}.first(stream.size() - 1uz), output, vx::compression::DeflateFormat::raw).has_value());
+
+	/* a fixed block with a literal, then a match two bytes back */
+	const std::vector<std::byte> badDistance {toBytes({0x4b, 0x04, 0x42, 0x00})};
+	REQUIRE_FALSE(vx::compression::inflate(badDistance, output, vx::compression::DeflateFormat::raw).has_value());
+	/* block type 3 */
+	REQUIRE_FALSE(vx::compression::inflate(toBytes({0x07, 0x00}), output, vx::compression::DeflateFormat::raw).has_value());
+	/* a stored block whose length doesn't match its complement */
+	REQUIRE_FALSE(vx::compression::inflate(toBytes({0x01, 0x01, 0x00, 0xff, 0xff, 'a'}), output, vx::compression::DeflateFormat::raw).has_value());
+
+	const std::vector<std::byte> zlibStream {vx::compression::deflate(input, vx::compression::DeflateFormat::zlib)};
+	REQUIRE(vx::compression::inflate(zlibStream, output, vx::compression::DeflateFormat::zlib) == input.size());
+	std::vector<std::byte> badHeader {zlibStream};
+	badHeader[1] ^= std::byte{1};
+	REQUIRE_FALSE(vx::compression::inflate(badHeader, output, vx::compression::DeflateFormat::zlib).has_value());
+	vx::compression::Inflater headerInflater {badHeader, vx::compression::DeflateFormat::zlib};
+	REQUIRE(headerInflater.read(output) == 0uz);
+	REQUIRE(headerInflater.hasFailed());
+	std::vector<std::byte> badChecksum {zlibStream};
+	badChecksum.back() ^= std::byte{1};
+	REQUIRE_FALSE(vx::compression::inflate(badChecksum, output, vx::compression::DeflateFormat::zlib).has_value());
+	REQUIRE_FALSE(vx::compression::inflate(std::span{zlibStream}.first(zlibStream.size() - 1uz), output, vx::compression::DeflateFormat::zlib).has_value());
+}
@@ -0,0 +1,97 @@
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/compression/lz.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/testing/content.hpp>
+
+
+namespace {
+	using vx::testing::Content;
+	using vx::testing::makeContent;
+}
+
+
+TEST_CASE("lz - block round trip", "[compression]") {
+	const Content content {GENERATE(Content::zeros, Content::text, Content::pattern, Content::random, Content::mixed)};
+	const std::size_t size {GENERATE(0uz, 1uz, 12uz, 13uz, 100uz, 4096uz, vx::compression::LZ_BLOCK_SIZE)};
+	const std::vector<std::byte> input {makeContent(content, size)};
+
+	std::vector<std::byte> compressed (vx::compression::getBlockBound(size));
+	compressed.resize(vx::compression::compressBlock(input, compressed));
+	if (size >= 4096uz && content != Content::random && content != Content::mixed)
+		REQUIRE(compressed.size() < size / 2uz);
+
+	std::vector<std::byte> output (size);
+	REQUIRE(vx::compression::decompressBlock(compressed, output) == size);
+	REQUIRE(output == input);
+	/* exact sized outputs take the careful copies, bigger ones the wild ones */
+	std::vector<std::byte> bigOutput (size + 100uz);
+	REQUIRE(vx::compression::decompressBlock(compressed, bigOutput) == size);
+	REQUIRE(std::ranges::equal(std::span{bigOutput}.first(size), input));
+	if (size != 0uz) {
+		output.pop_back();
+		REQUIRE_FALSE(vx::compression::decompressBlock(compressed, output).has_value());
+	}
+}
+
+
+TEST_CASE("lz - malformed blocks", "[compression]") {
+	const std::vector<std::byte> input {makeContent(Content::mixed, 20'000uz)};
+	std::vector<std::byte> compressed (vx::compression::getBlockBound(input.size()));
+	compressed.resize(vx::compression::compressBlock(input, compressed));
+	std::vector<std::byte> output (input.size());
+
+	/* every outcome is fine as long as nothing is read or written out of bounds */
+	std::mt19937 random {3u};
+	for (std::size_t i {0uz}; i < 2000uz; ++i) {
+		std::vector<std::byte> corrupted {compressed};
+		for (std::size_t j {0uz}; j < 1uz + i % 4uz; ++j)
+			corrupted[random() % corrupted.size()] = static_cast<std::byte> (random());
+		corrupted.resize(corrupted.size() - i % 3uz);
+		(void)vx::compression::decompressBlock(corrupted, output);
+	}
+	REQUIRE_FALSE(vx::compression::decompressBlock({}, output).has_value());
+	REQUIRE_FALSE(vx::compression::decompressBlock(std::span{compressed}.first(compressed.size() / 2uz), output).has_value());
+	/* a match before the start of the output */
+	const std::byte badOffset[] {std::byte{0x10}, std::byte{'a'}, std::byte{0x02}, std::byte{0x00}, std::byte{0x00}};
+	REQUIRE_FALSE(vx::compression::decompressBlock(badOffset, output).has_value());
+}
+
+
+TEST_CASE("lz - frames", "[compression]") {
+	const Content content {GENERATE(Content::text, Content::random, Content::mixed)};
+	const std::size_t size {GENERATE(0uz, 1000uz, vx::compression::LZ_BLOCK_SIZE, 5uz * vx::compression::LZ_BLOCK_SIZE + 123uz)};
+	const std::vector<std::byte> input {makeContent(content, size)};
+	const std::vector<std::byte> frame {vx::compression::compress(input)};
+	REQUIRE(vx::compression::getDecompressedSize(frame) == size);
+	/* random blocks are stored as is */
+	if (content == Content::random)
+		REQUIRE(frame.size() <= size + sizeof(vx::compression::LzFrameHeader) + (size / vx::compression::LZ_BLOCK_SIZE + 1uz) * 4uz);
+
+	std::vector<std::byte> output (size);
+	REQUIRE(vx::compression::decompress(frame, output));
+	REQUIRE(output == input);
+
+	vx::jobs::Scheduler scheduler {};
+	std::vector<std::byte> parallelOutput (size);
+	REQUIRE(vx::compression::decompress(frame, parallelOutput, scheduler));
+	REQUIRE(parallelOutput == input);
+
+	vx::containers::StringAccumulator accumulator {};
+	REQUIRE(vx::compression::decompress(frame, accumulator));
+	REQUIRE(accumulator.getSize() == size);
+	const vx::String string {accumulator.toString()};
+	REQUIRE(std::ranges::equal(string.slice(), input, {}, {}, [](const std::byte byte) {return static_cast<char8_t> (byte);}));
+
+	std::vector<std::byte> wrongSize (size + 1uz);
+	REQUIRE_FALSE(vx::compression::decompress(frame, wrongSize));
+	REQUIRE_FALSE(vx::compression::decompress(std::span{frame}.first(frame.size() - 1uz), output));
+	std::vector<std::byte> corrupted {frame};
+	corrupted[0] = std::byte{0};
+	REQUIRE_FALSE(vx::compression::getDecompressedSize(corrupted).has_value());
+	REQUIRE_FALSE(vx::compression::decompress(corrupted, output));
+}
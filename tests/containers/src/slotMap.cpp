@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <voxlet/containers/slotMap.hpp>
+#include <voxlet/containers/string.hpp>
+
+
+namespace {
+	/* counts live objects, and is relocated through its move constructor */
+	struct Tracked {
+		static inline int s_liveCount {0};
+		std::unique_ptr<int> value;
+
+		explicit Tracked(int value) noexcept : value {std::make_unique<int> (value)} {++s_liveCount;}
+		Tracked(Tracked&& other) noexcept : value {std::move(other.value)} {++s_liveCount;}
+		~Tracked() {--s_liveCount;}
+	};
+
+	template <typename T>
+	struct CountingAllocator {
+		using value_type = T;
+
+		std::size_t* allocations;
+
+		CountingAllocator(std::size_t& allocations) noexcept : allocations {&allocations} {}
+		template <typename U>
+		CountingAllocator(const CountingAllocator<U>& other) noexcept : allocations {other.allocations} {}
+
+		auto allocate(const std::size_t count) -> T* {
+			++*allocations;
+			return std::allocator<T> {}.allocate(count);
+		}
+		auto deallocate(T* const pointer, const std::size_t count) noexcept -> void {
+			std::allocator<T> {}.deallocate(pointer, count);
+		}
+
+		auto operator==(const CountingAllocator&) const noexcept -> bool = default;
+	};
+}
+
+
+TEST_CASE("slot-map", "[containers]") {
+	vx::SlotMap<int> map {};
+	REQUIRE(map.empty());
+	REQUIRE(!map.contains(vx::SlotMap<int>::Handle{}));
+
+	std::vector<vx::SlotMap<int>::Handle> handles {};
+	for (int i {0}; i < 1000; ++i)
+		handles.push_back(map.insert(i));
+	REQUIRE(map.size() == 1000uz);
+	for (int i {0}; i < 1000; ++i)
+		REQUIRE(map[handles[i]] == i);
+
+	SECTION("erase") {
+		REQUIRE(map.erase(handles[10]));
+		REQUIRE(!map.erase(handles[10]));
+		REQUIRE(!map.contains(handles[10]));
+		REQUIRE(map.get(handles[10]) == nullptr);
+		/* the last value filled the hole */
+		REQUIRE(map.getValues()[10] == 999);
+		REQUIRE(map.getHandle(10uz) == handles[999]);
+		REQUIRE(map[handles[999]] == 999);
+
+		/* the slot is reused with a new generation, the old handle stays dead */
+		const auto handle {map.insert(-1)};
+		REQUIRE(handle.index == handles[10].index);
+		REQUIRE(handle != handles[10]);
+		REQUIRE(!map.contains(handles[10]));
+		REQUIRE(map[handle] == -1);
+		REQUIRE(vx::SlotMap<int>::Handle::fromBits(handle.toBits()) == handle);
+	}
+
+	SECTION("iteration") {
+		for (std::size_t i {0uz}; i < 1000uz; i += 2uz)
+			REQUIRE(map.erase(handles[i]));
+		int sum {0};
+		for (const int value : map)
+			sum += value;
+		REQUIRE(sum == 250'000);
+		for (std::size_t i {0uz}; i < map.size(); ++i)
+			REQUIRE(map[map.getHandle(i)] == map.getValues()[i]);
+
+		std::unordered_set<vx::SlotMap<int>::Handle> unique {};
+		for (std::size_t i {0uz}; i < map.size(); ++i)
+			unique.insert(map.getHandle(i));
+		REQUIRE(unique.size() == 500uz);
+	}
+
+	SECTION("clear") {
+		map.clear();
+		REQUIRE(map.empty());
+		for (const auto handle : handles)
+			REQUIRE(!map.contains(handle));
+		(void)map.insert(3);
+		REQUIRE(map.size() == 1uz);
+	}
+}
+
+
+TEST_CASE("slot-map relocation", "[containers]") {
+	static_assert(!vx::memory::IS_TRIVIALLY_RELOCATABLE<Tracked>);
+	static_assert(vx::memory::IS_TRIVIALLY_RELOCATABLE<vx::String>);
+	{
+		vx::SlotMap<Tracked> map {};
+		std::vector<vx::SlotMap<Tracked>::Handle> handles {};
+		for (int i {0}; i < 100; ++i)
+			handles.push_back(map.emplace(i));
+		REQUIRE(Tracked::s_liveCount == 100);
+		REQUIRE(map.erase(handles[0]));
+		REQUIRE(Tracked::s_liveCount == 99);
+		REQUIRE(*map[handles[99]].value == 99);
+
+		vx::SlotMap<Tracked> moved {std::move(map)};
+		REQUIRE(*moved[handles[50]].value == 50);
+		REQUIRE(map.empty());
+		auto& self {moved};
+		moved = std::move(self);
+		REQUIRE(*moved[handles[50]].value == 50);
+		REQUIRE(Tracked::s_liveCount == 99);
+	}
+	REQUIRE(Tracked::s_liveCount == 0);
+
+	vx::SlotMap<vx::String> strings {};
+	const auto hello {strings.insert(vx::String::from(u8"hello"))};
+	const auto sentence {strings.insert(vx::String::from(u8"a string too long for the small buffer"))};
+	strings.reserve(1000uz);
+	REQUIRE(strings.erase(hello));
+	REQUIRE(std::ranges::equal(strings[sentence], vx::StringSlice::from(u8"a string too long for the small buffer")));
+}
+
+
+TEST_CASE("slot-map insert of its own value", "[containers]") {
+	/* the copy is made while the map grows, from a value in the storage that goes */
+	vx::SlotMap<std::vector<int>> map {};
+	const auto first {map.insert(std::vector<int> (100uz, 7))};
+	while (map.size() != map.capacity())
+		(void)map.insert(std::vector<int> {});
+	const auto copy {map.insert(map[first])};
+	REQUIRE(map.size() == 17uz);
+	REQUIRE(map[copy] == std::vector<int> (100uz, 7));
+	REQUIRE(map[first] == map[copy]);
+}
+
+
+TEST_CASE("slot-map allocator", "[containers]") {
+	std::size_t allocations {0uz};
+	vx::SlotMap<int, CountingAllocator<int>> map {CountingAllocator<int> {allocations}};
+	map.reserve(100uz);
+	const std::size_t afterReserve {allocations};
+	REQUIRE(afterReserve >= 1uz);
+	for (int i {0}; i < 100; ++i)
+		(void)map.insert(i);
+	/* only the slot table may still grow */
+	REQUIRE(map.getCapacity() == 100uz);
+	REQUIRE(map.getAllocator().allocations == &allocations);
+}
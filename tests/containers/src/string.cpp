@@ -208,3 +208,46 @@ TEST_CASE("string-accumulator", "[string][containers]") {
 	const auto accumulatorString {accumulator.toString()};
 	REQUIRE(std::ranges::equal(accumulatorString, stringContent));
 }
+
+TEST_CASE("string-accumulator segments", "[string][containers]") {
+	const bool hasInnerStorage {GENERATE(true, false)};
+	const auto check {[]<bool inner>() {
+		using Accumulator = vx::containers::BasicStringAccumulator<16uz, inner>;
+		const std::u8string text {u8"the quick brown fox jumps over the lazy dog"};
+
+		Accumulator accumulator;
+		REQUIRE(accumulator.isEmpty());
+		accumulator += u8"the quick ";
+		REQUIRE(accumulator.getSize() == 10uz);
+		accumulator.push(text.data() + 10, text.size() - 10uz);
+
+		std::u8string streamed {};
+		std::size_t segmentCount {0uz};
+		accumulator.forEachSegment([&](const std::span<const char8_t> segment) {
+			REQUIRE(segment.size() <= 16uz);
+			streamed.append(segment.begin(), segment.end());
+			++segmentCount;
+		});
+		REQUIRE(streamed == text);
+		REQUIRE(segmentCount == 3uz);
+
+		Accumulator moved {std::move(accumulator)};
+		REQUIRE(accumulator.isEmpty());
+		moved += u8"!";
+		REQUIRE(std::ranges::equal(moved.toString(), text + u8"!"));
+		accumulator += u8"again";
+		REQUIRE(std::ranges::equal(accumulator.toString(), std::u8string_view{u8"again"}));
+		accumulator = std::move(moved);
+		REQUIRE(std::ranges::equal(accumulator.toString(), text + u8"!"));
+
+		/* the segments are kept and filled again */
+		accumulator.clear();
+		REQUIRE(accumulator.isEmpty());
+		accumulator.push(text.data(), text.size());
+		REQUIRE(std::ranges::equal(accumulator.toString(), text));
+	}};
+	if (hasInnerStorage)
+		check.template operator()<true> ();
+	else
+		check.template operator()<false> ();
+}
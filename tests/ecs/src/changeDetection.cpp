@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <voxlet/ecs/query.hpp>
+#include <voxlet/ecs/tick.hpp>
+#include <voxlet/ecs/world.hpp>
+
+
+namespace {
+	struct Position {
+		float x;
+	};
+
+	struct Velocity {
+		float x;
+	};
+
+	struct Tag {};
+
+	template <typename... Ts>
+	auto collect(vx::ecs::Query<Ts...>& query) -> std::vector<vx::ecs::Entity> {
+		std::vector<vx::ecs::Entity> entities {};
+		query.forEach([&entities](const vx::ecs::Entity entity, Ts&...) noexcept {entities.push_back(entity);});
+		std::ranges::sort(entities, {}, &vx::ecs::Entity::index);
+		return entities;
+	}
+}
+
+
+TEST_CASE("ticks", "[ecs]") {
+	REQUIRE(vx::ecs::isNewer(2u, 1u));
+	REQUIRE(!vx::ecs::isNewer(1u, 1u));
+	REQUIRE(!vx::ecs::isNewer(1u, 2u));
+	REQUIRE(vx::ecs::isNewer(3u, 0xffff'fffeu));
+	REQUIRE(vx::ecs::getNewest(3u, 0xffff'fffeu) == 3u);
+}
+
+
+TEST_CASE("change-detection", "[ecs]") {
+	vx::ecs::World world {};
+	std::vector<vx::ecs::Entity> entities {};
+	for (int i {0}; i < 5000; ++i)
+		entities.push_back(world.spawn(Position{static_cast<float> (i)}, Velocity{1.f}));
+
+	SECTION("changed") {
+		auto query {world.query<const Position> ()};
+		(void)query.changed<Position> ();
+		REQUIRE(collect(query).size() == entities.size());
+		REQUIRE(collect(query).empty());
+
+		world.get<Position> (entities[10])->x = -1.f;
+		world.get<Position> (entities[4000])->x = -1.f;
+		(void)std::as_const(world).get<Velocity> (entities[20]);
+		REQUIRE(collect(query) == std::vector{entities[10], entities[4000]});
+		REQUIRE(collect(query).empty());
+
+		/* span iteration skips the untouched chunks but hands out every row of a changed one */
+		(void)world.add(entities[30], Position{3.f});
+		std::size_t visited {0uz};
+		bool sawChanged {false};
+		query.forEachChunk([&](const std::span<const vx::ecs::Entity> chunk, const std::span<const Position>) noexcept {
+			visited += chunk.size();
+			sawChanged |= std::ranges::find(chunk, entities[30]) != chunk.end();
+		});
+		REQUIRE(sawChanged);
+		REQUIRE(visited < entities.size());
+	}
+
+	SECTION("added") {
+		auto query {world.query<const Tag> ()};
+		(void)query.added<Tag> ();
+		REQUIRE(collect(query).empty());
+
+		(void)world.add(entities[7], Tag{});
+		(void)world.add(entities[8], Tag{});
+		REQUIRE(collect(query) == std::vector{entities[7], entities[8]});
+		(void)world.add(entities[7], Tag{});
+		REQUIRE(collect(query).empty());
+
+		auto changed {world.query<const Tag> ()};
+		(void)changed.changed<Tag> ();
+		REQUIRE(collect(changed).size() == 2uz);
+	}
+
+	SECTION("query writes") {
+		auto writer {world.query<Position, const Velocity> ()};
+		(void)writer.changed<Velocity> ();
+		const auto move {[](Position& position, const Velocity& velocity) noexcept {position.x += velocity.x;}};
+		writer.forEach(move);
+		auto reader {world.query<const Position> ()};
+		(void)reader.changed<Position> ();
+		REQUIRE(collect(reader).size() == entities.size());
+
+		world.get<Velocity> (entities[42])->x = 2.f;
+		writer.forEach(move);
+		REQUIRE(std::as_const(world).get<Position> (entities[42])->x == 45.f);
+		REQUIRE(std::as_const(world).get<Position> (entities[43])->x == 44.f);
+		REQUIRE(collect(reader) == std::vector{entities[42]});
+
+		/* a query doesn't see its own writes */
+		auto mover {world.query<Position> ()};
+		(void)mover.changed<Position> ();
+		REQUIRE(collect(mover).size() == entities.size());
+		REQUIRE(collect(mover).empty());
+		REQUIRE(collect(reader).size() == entities.size());
+	}
+
+	SECTION("structural changes keep the ticks") {
+		auto query {world.query<const Position> ()};
+		(void)query.changed<Position> ();
+		REQUIRE(collect(query).size() == entities.size());
+
+		world.get<Position> (entities.back())->x = 0.f;
+		world.get<Position> (entities[100])->x = 0.f;
+		/* the last row fills the hole of the despawned entity */
+		REQUIRE(world.despawn(entities[0]));
+		/* moved to another archetype */
+		REQUIRE(world.add(entities[100], Tag{}));
+		REQUIRE(collect(query) == std::vector{entities[100], entities.back()});
+	}
+}
+
+
+TEST_CASE("observers", "[ecs]") {
+	vx::ecs::World world {};
+	std::vector<vx::ecs::Entity> added {};
+	std::vector<vx::ecs::Entity> removed {};
+	const auto onAdd {world.onAdd<Velocity> ([&added](vx::ecs::World& world, const vx::ecs::Entity entity) {
+		REQUIRE(world.has<Velocity> (entity));
+		added.push_back(entity);
+	})};
+	(void)world.onRemove<Velocity> ([&removed](vx::ecs::World& world, const vx::ecs::Entity entity) {
+		REQUIRE(world.has<Velocity> (entity));
+		removed.push_back(entity);
+		(void)world.spawn(Tag{});
+	});
+
+	const vx::ecs::Entity first {world.spawn(Position{0.f}, Velocity{1.f})};
+	const vx::ecs::Entity second {world.spawn(Position{0.f})};
+	REQUIRE(world.add(second, Velocity{2.f}));
+	REQUIRE(world.add(second, Velocity{3.f}));
+	REQUIRE(added == std::vector{first, second});
+
+	REQUIRE(world.remove<Velocity> (second));
+	REQUIRE(world.despawn(first));
+	REQUIRE(!world.remove<Velocity> (second));
+	REQUIRE(removed == std::vector{second, first});
+	REQUIRE(world.query<const Tag> ().getEntityCount() == 2uz);
+	REQUIRE(world.isAlive(second));
+	REQUIRE(std::as_const(world).get<Position> (second) != nullptr);
+
+	REQUIRE(world.removeObserver(onAdd));
+	REQUIRE(!world.removeObserver(onAdd));
+	(void)world.spawn(Velocity{0.f});
+	REQUIRE(added.size() == 2uz);
+}
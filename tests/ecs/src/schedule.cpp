@@ -0,0 +1,126 @@
+#include <atomic>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/ecs/commandBuffer.hpp>
+#include <voxlet/ecs/schedule.hpp>
+#include <voxlet/ecs/world.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+
+
+namespace {
+	struct Position {
+		float x;
+	};
+
+	struct Velocity {
+		float x;
+	};
+
+	struct Health {
+		int value;
+	};
+
+	struct Dead {};
+}
+
+
+TEST_CASE("command-buffer", "[ecs]") {
+	vx::ecs::World world {};
+	vx::ecs::CommandBuffer commands {};
+	const vx::ecs::Entity entity {world.spawn(Position{1.f})};
+
+	for (int i {0}; i < 1000; ++i)
+		commands.spawn(Position{static_cast<float> (i)}, Velocity{1.f});
+	commands.add(entity, Velocity{2.f});
+	commands.remove<Position> (entity);
+	REQUIRE(commands.getCommandCount() == 1002uz);
+	REQUIRE(world.getEntityCount() == 1uz);
+
+	commands.apply(world);
+	REQUIRE(commands.isEmpty());
+	REQUIRE(world.getEntityCount() == 1001uz);
+	REQUIRE(!world.has<Position> (entity));
+	REQUIRE(world.get<Velocity> (entity)->x == 2.f);
+
+	commands.despawn(entity);
+	commands.push([](vx::ecs::World& world) noexcept {(void)world.spawn(Health{3});});
+	commands.apply(world);
+	REQUIRE(!world.isAlive(entity));
+	REQUIRE(world.query<const Health> ().getEntityCount() == 1uz);
+}
+
+
+TEST_CASE("schedule", "[ecs]") {
+	const std::size_t workerCount {GENERATE(0uz, 3uz)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+	vx::ecs::World world {};
+	constexpr int COUNT {20'000};
+	for (int i {0}; i < COUNT; ++i)
+		(void)world.spawn(Position{0.f}, Velocity{1.f}, Health{i % 10});
+
+	vx::ecs::Schedule schedule {world};
+	std::atomic<int> exclusiveRuns {0};
+	std::atomic<bool> sawPartialUpdate {false};
+
+	const auto move {schedule.addSystem(vx::StringSlice::from(u8"move"),
+		[](const std::span<Position> positions, const std::span<const Velocity> velocities) noexcept {
+			for (std::size_t i {0uz}; i < positions.size(); ++i)
+				positions[i].x += velocities[i].x;
+		}
+	)};
+	const auto damage {schedule.addSystem(vx::StringSlice::from(u8"damage"),
+		[](vx::ecs::CommandBuffer& commands, const std::span<const vx::ecs::Entity> entities, const std::span<Health> healths) noexcept {
+			for (std::size_t i {0uz}; i < healths.size(); ++i) {
+				if (--healths[i].value == 0)
+					commands.add(entities[i], Dead{});
+			}
+		}
+	)};
+	const auto check {schedule.addSystem(vx::StringSlice::from(u8"check"),
+		[&sawPartialUpdate](const std::span<const Position> positions) noexcept {
+			for (const Position& position : positions) {
+				if (position.x != positions.front().x)
+					sawPartialUpdate = true;
+			}
+		}
+	)};
+	const auto reap {schedule.addSystem(vx::StringSlice::from(u8"reap"), [&exclusiveRuns](vx::ecs::World& world) noexcept {
+		++exclusiveRuns;
+		std::vector<vx::ecs::Entity> dead {};
+		world.query<const Dead> ().forEach([&dead](const vx::ecs::Entity entity, const Dead&) noexcept {
+			dead.push_back(entity);
+		});
+		for (const vx::ecs::Entity entity : dead)
+			(void)world.despawn(entity);
+	})};
+
+	schedule.run(scheduler);
+	REQUIRE(exclusiveRuns == 1);
+	REQUIRE(!sawPartialUpdate);
+
+	const vx::jobs::FrameGraph& graph {schedule.getFrameGraph()};
+	REQUIRE(graph.getDependencies(move).empty());
+	REQUIRE(graph.getDependencies(damage).empty());
+	REQUIRE(graph.getDependencies(check).size() == 1uz);
+	REQUIRE(graph.getDependencies(check)[0] == move);
+	REQUIRE(graph.getDependencies(reap).size() == 3uz);
+
+	/* entities with 1 health got a Dead component when the commands were flushed before `reap` */
+	REQUIRE(world.getEntityCount() == static_cast<std::size_t> (COUNT - COUNT / 10));
+	float positionSum {0.f};
+	world.query<const Position> ().forEach([&positionSum](const Position& position) noexcept {positionSum += position.x;});
+	REQUIRE(positionSum == static_cast<float> (COUNT - COUNT / 10));
+
+	schedule.run(scheduler);
+	REQUIRE(exclusiveRuns == 2);
+	REQUIRE(world.getEntityCount() == static_cast<std::size_t> (COUNT - 2 * (COUNT / 10)));
+	REQUIRE(world.query<const Dead> ().getEntityCount() == 0uz);
+
+	REQUIRE(schedule.removeSystem(vx::StringSlice::from(u8"reap")));
+	schedule.run(scheduler);
+	REQUIRE(world.query<const Dead> ().getEntityCount() == static_cast<std::size_t> (COUNT / 10));
+}
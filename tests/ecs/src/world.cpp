@@ -0,0 +1,191 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/ecs/query.hpp>
+#include <voxlet/ecs/world.hpp>
+#include <voxlet/memory/blockPool.hpp>
+
+
+namespace {
+	struct Position {
+		float x;
+		float y;
+	};
+
+	struct Velocity {
+		float x;
+		float y;
+	};
+
+	struct Name {
+		std::unique_ptr<std::string> value;
+	};
+
+	struct Label {
+		std::string value;
+	};
+
+	struct alignas(64) Wide {
+		float values[16];
+	};
+
+	struct Tracked {
+		static inline int aliveCount {0};
+
+		Tracked() noexcept {++aliveCount;}
+		Tracked(Tracked&&) noexcept {++aliveCount;}
+		~Tracked() {--aliveCount;}
+	};
+}
+
+
+TEST_CASE("block-pool", "[ecs]") {
+	vx::memory::BlockPool pool {4096uz, 4uz};
+	std::vector<void*> blocks {};
+	for (std::size_t i {0uz}; i < 10uz; ++i) {
+		blocks.push_back(pool.allocate());
+		REQUIRE(reinterpret_cast<std::uintptr_t> (blocks.back()) % 4096uz == 0uz);
+	}
+	REQUIRE(pool.getUsedCount() == 10uz);
+	REQUIRE(pool.getSlabCount() == 3uz);
+	REQUIRE(std::set<void*> (blocks.begin(), blocks.end()).size() == blocks.size());
+
+	pool.deallocate(blocks.back());
+	REQUIRE(pool.allocate() == blocks.back());
+	for (void* const block : blocks)
+		pool.deallocate(block);
+	REQUIRE(pool.getUsedCount() == 0uz);
+	REQUIRE(pool.getSlabCount() == 3uz);
+}
+
+
+TEST_CASE("world", "[ecs]") {
+	vx::ecs::World world {};
+
+	SECTION("spawn and despawn") {
+		const vx::ecs::Entity a {world.spawn(Position{1.f, 2.f}, Velocity{3.f, 4.f})};
+		const vx::ecs::Entity b {world.spawn(Position{5.f, 6.f})};
+		const vx::ecs::Entity c {world.spawn()};
+		REQUIRE(world.getEntityCount() == 3uz);
+		REQUIRE(world.isAlive(a));
+		REQUIRE(world.has<Velocity> (a));
+		REQUIRE(!world.has<Velocity> (b));
+		REQUIRE(world.get<Position> (b)->x == 5.f);
+		REQUIRE(world.get<Position> (c) == nullptr);
+
+		REQUIRE(world.despawn(a));
+		REQUIRE(!world.despawn(a));
+		REQUIRE(!world.isAlive(a));
+		REQUIRE(world.get<Position> (a) == nullptr);
+		const vx::ecs::Entity d {world.spawn(Velocity{})};
+		REQUIRE(d.index == a.index);
+		REQUIRE(d != a);
+		REQUIRE(!world.isAlive(a));
+		REQUIRE(world.getEntityCount() == 3uz);
+	}
+
+	SECTION("add and remove") {
+		const vx::ecs::Entity entity {world.spawn(Position{1.f, 1.f})};
+		REQUIRE(world.add(entity, Velocity{2.f, 3.f}));
+		REQUIRE(world.get<Position> (entity)->x == 1.f);
+		REQUIRE(world.get<Velocity> (entity)->y == 3.f);
+		REQUIRE(world.add(entity, Velocity{4.f, 5.f}));
+		REQUIRE(world.get<Velocity> (entity)->x == 4.f);
+
+		REQUIRE(world.remove<Position> (entity));
+		REQUIRE(!world.remove<Position> (entity));
+		REQUIRE(!world.has<Position> (entity));
+		REQUIRE(world.get<Velocity> (entity)->y == 5.f);
+		REQUIRE(world.getArchetypes().size() == 4uz);
+	}
+
+	SECTION("add a stored component") {
+		const std::string text {"a label longer than the small string buffer"};
+		const vx::ecs::Entity entity {world.spawn(Label{text})};
+		/* replaces the component with a copy of itself */
+		REQUIRE(world.add(entity, *world.get<Label> (entity)));
+		REQUIRE(world.get<Label> (entity)->value == text);
+
+		/* the copy of a component of another entity, from the archetype this one moves to */
+		const vx::ecs::Entity other {world.spawn(Position{})};
+		REQUIRE(world.add(other, *world.get<Label> (entity)));
+		REQUIRE(world.get<Label> (other)->value == text);
+		REQUIRE(world.get<Label> (entity)->value == text);
+	}
+
+	SECTION("dense storage across chunks") {
+		constexpr std::size_t COUNT {10'000uz};
+		std::vector<vx::ecs::Entity> entities {};
+		for (std::size_t i {0uz}; i < COUNT; ++i)
+			entities.push_back(world.spawn(Position{static_cast<float> (i), 0.f}, Wide{}));
+		const auto& archetype {*world.getArchetypes().back()};
+		REQUIRE(archetype.getChunks().size() > 1uz);
+		REQUIRE(archetype.getChunkCapacity() * (sizeof(Position) + sizeof(Wide) + sizeof(vx::ecs::Entity)) <= vx::ecs::Archetype::CHUNK_SIZE);
+
+		for (std::size_t i {0uz}; i < COUNT; i += 2uz)
+			REQUIRE(world.despawn(entities[i]));
+		REQUIRE(archetype.getEntityCount() == COUNT / 2uz);
+		for (std::size_t i {1uz}; i < COUNT; i += 2uz)
+			REQUIRE(world.get<Position> (entities[i])->x == static_cast<float> (i));
+		for (std::size_t chunk {0uz}; chunk + 1uz < archetype.getChunks().size(); ++chunk)
+			REQUIRE(archetype.getChunks()[chunk].count == archetype.getChunkCapacity());
+		REQUIRE(reinterpret_cast<std::uintptr_t> (archetype.getColumn(0uz, archetype.findColumn(vx::ecs::getComponentId<Wide> ()))) % 64uz == 0uz);
+	}
+
+	SECTION("non-trivial components") {
+		{
+			vx::ecs::World scoped {};
+			std::vector<vx::ecs::Entity> entities {};
+			for (int i {0}; i < 1000; ++i)
+				entities.push_back(scoped.spawn(Tracked{}, Name{std::make_unique<std::string> (std::to_string(i))}));
+			REQUIRE(Tracked::aliveCount == 1000);
+			for (int i {0}; i < 1000; i += 3)
+				REQUIRE(scoped.despawn(entities[static_cast<std::size_t> (i)]));
+			for (int i {1}; i < 1000; i += 3)
+				REQUIRE(scoped.remove<Tracked> (entities[static_cast<std::size_t> (i)]));
+			REQUIRE(Tracked::aliveCount == 333);
+			for (int i {2}; i < 1000; i += 3)
+				REQUIRE(*scoped.get<Name> (entities[static_cast<std::size_t> (i)])->value == std::to_string(i));
+		}
+		REQUIRE(Tracked::aliveCount == 0);
+	}
+
+	SECTION("queries") {
+		for (int i {0}; i < 5000; ++i) {
+			const vx::ecs::Entity entity {world.spawn(Position{0.f, 0.f}, Velocity{1.f, static_cast<float> (i)})};
+			if (i % 2 == 0)
+				(void)world.add(entity, Wide{});
+		}
+		(void)world.spawn(Position{});
+
+		auto query {world.query<Position, const Velocity> ()};
+		REQUIRE(query.getEntityCount() == 5000uz);
+		REQUIRE(query.getMatches().size() == 2uz);
+		query.forEachChunk([](std::span<Position> positions, std::span<const Velocity> velocities) noexcept {
+			for (std::size_t i {0uz}; i < positions.size(); ++i) {
+				positions[i].x += velocities[i].x;
+				positions[i].y += velocities[i].y;
+			}
+		});
+
+		float sum {0.f};
+		std::size_t count {0uz};
+		query.forEach([&](const vx::ecs::Entity entity, Position& position, const Velocity& velocity) noexcept {
+			REQUIRE(world.isAlive(entity));
+			REQUIRE(position.y == velocity.y);
+			sum += position.x;
+			++count;
+		});
+		REQUIRE(count == 5000uz);
+		REQUIRE(sum == 5000.f);
+
+		(void)world.spawn(Position{}, Velocity{}, Name{});
+		REQUIRE(query.getEntityCount() == 5001uz);
+		REQUIRE(world.query<Position> ().getEntityCount() == 5002uz);
+	}
+}
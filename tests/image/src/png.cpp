@@ -0,0 +1,360 @@
+#include <array>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/image/png.hpp>
+#include <voxlet/testing/png.hpp>
+
+
+namespace {
+	struct Source {
+		vx::image::PngInfo info;
+		/* one value per sample, of `bitDepth` bits */
+		std::vector<std::uint16_t> samples;
+		std::vector<std::array<std::uint8_t, 3uz>> palette;
+		std::vector<std::uint8_t> paletteAlpha;
+		std::vector<std::uint16_t> colorKey;
+	};
+
+	auto getChannelCount(const vx::image::PngColorType colorType) -> std::uint32_t {
+		switch (colorType) {
+			case vx::image::PngColorType::gray:
+			case vx::image::PngColorType::indexed:
+				return 1u;
+			case vx::image::PngColorType::grayAlpha:
+				return 2u;
+			case vx::image::PngColorType::rgb:
+				return 3u;
+			case vx::image::PngColorType::rgba:
+				return 4u;
+		}
+		return 0u;
+	}
+
+	auto makeSource(const vx::image::PngInfo& info, const bool hasTransparency) -> Source {
+		const std::uint32_t channelCount {getChannelCount(info.colorType)};
+		Source source {.info = info, .samples = {}, .palette = {}, .paletteAlpha = {}, .colorKey = {}};
+		std::mt19937 random {info.width * 31u + info.height};
+		std::uint32_t maximum {(1u << info.bitDepth) - 1u};
+		if (info.colorType == vx::image::PngColorType::indexed) {
+			const std::uint32_t paletteSize {std::min(maximum + 1u, 200u)};
+			for (std::uint32_t i {0u}; i < paletteSize; ++i) {
+				source.palette.push_back({
+					static_cast<std::uint8_t> (random()),
+					static_cast<std::uint8_t> (random()),
+					static_cast<std::uint8_t> (random())
+				});
+			}
+			if (hasTransparency) {
+				for (std::uint32_t i {0u}; i < paletteSize / 2u; ++i)
+					source.paletteAlpha.push_back(static_cast<std::uint8_t> (random()));
+			}
+			maximum = paletteSize - 1u;
+		}
+		/* a few runs of the same pixel so that deflate finds matches, and the filters something to predict */
+		const std::size_t sampleCount {static_cast<std::size_t> (info.width) * info.height * channelCount};
+		for (std::size_t i {0uz}; i < sampleCount; ++i) {
+			if (i >= channelCount && random() % 3u == 0u)
+				source.samples.push_back(source.samples[i - channelCount]);
+			else
+				source.samples.push_back(static_cast<std::uint16_t> (random() % (maximum + 1u)));
+		}
+		/* color types with alpha have no color key */
+		const bool hasColorKey {info.colorType == vx::image::PngColorType::gray || info.colorType == vx::image::PngColorType::rgb};
+		if (hasTransparency && hasColorKey)
+			source.colorKey.assign(source.samples.begin(), source.samples.begin() + channelCount);
+		return source;
+	}
+
+	/* rows packed at `bitDepth`, each filtered with `filters[y % filters.size()]` */
+	auto filterRows(const Source& source, const std::vector<std::uint8_t>& filters) -> std::vector<std::uint8_t> {
+		const std::uint32_t channelCount {getChannelCount(source.info.colorType)};
+		const std::size_t bitsPerPixel {channelCount * source.info.bitDepth};
+		const std::size_t rowSize {(source.info.width * bitsPerPixel + 7uz) / 8uz};
+		const std::size_t stride {std::max(1uz, bitsPerPixel / 8uz)};
+		const std::size_t samplesPerRow {static_cast<std::size_t> (source.info.width) * channelCount};
+
+		std::vector<std::uint8_t> rows (rowSize * source.info.height, 0u);
+		for (std::size_t y {0uz}; y < source.info.height; ++y) {
+			std::uint8_t* const row {rows.data() + y * rowSize};
+			for (std::size_t i {0uz}; i < samplesPerRow; ++i) {
+				const std::uint16_t sample {source.samples[y * samplesPerRow + i]};
+				if (source.info.bitDepth == 16u) {
+					row[i * 2uz] = static_cast<std::uint8_t> (sample >> 8u);
+					row[i * 2uz + 1uz] = static_cast<std::uint8_t> (sample);
+					continue;
+				}
+				const std::size_t bit {i * source.info.bitDepth};
+				row[bit / 8uz] |= static_cast<std::uint8_t> (sample << (8uz - source.info.bitDepth - bit % 8uz));
+			}
+		}
+
+		return vx::testing::filterRows(rows, rowSize, stride, filters);
+	}
+
+	/* writes the CRC of every chunk again, for a file changed on purpose to fail for that change only */
+	auto rewriteCrcs(std::vector<std::byte>& file) -> void {
+		const auto read32 {[&](const std::size_t offset) {
+			std::uint32_t value {0u};
+			for (std::size_t i {0uz}; i < 4uz; ++i)
+				value = (value << 8u) | static_cast<std::uint32_t> (file[offset + i]);
+			return value;
+		}};
+		std::size_t offset {8uz};
+		while (file.size() - offset >= 12uz) {
+			const std::uint32_t size {read32(offset)};
+			if (size > file.size() - offset - 12uz)
+				return;
+			const std::uint32_t crc {vx::testing::crc32({reinterpret_cast<const std::uint8_t*> (file.data()) + offset + 4uz, size + 4uz})};
+			for (std::size_t i {0uz}; i < 4uz; ++i)
+				file[offset + 8uz + size + i] = static_cast<std::byte> (crc >> (24uz - i * 8uz));
+			offset += 12uz + size;
+		}
+	}
+
+	/* `dataChunkCount` splits the zlib stream over that many `IDAT` chunks */
+	auto encodePng(const Source& source, const std::vector<std::uint8_t>& filters, const std::size_t dataChunkCount = 1uz)
+		-> std::vector<std::byte>
+	{
+		std::vector<std::byte> file {vx::testing::beginPng(source.info)};
+		/* an ancillary chunk the decoder doesn't know of */
+		vx::testing::appendPngChunk(file, "tEXt", std::vector<std::uint8_t> {'v', 'o', 'x', 0u, 'l', 'e', 't'});
+
+		if (!source.palette.empty()) {
+			std::vector<std::uint8_t> palette {};
+			for (const std::array<std::uint8_t, 3uz>& color : source.palette)
+				palette.insert(palette.end(), color.begin(), color.end());
+			vx::testing::appendPngChunk(file, "PLTE", palette);
+		}
+		if (!source.paletteAlpha.empty())
+			vx::testing::appendPngChunk(file, "tRNS", source.paletteAlpha);
+		if (!source.colorKey.empty()) {
+			std::vector<std::uint8_t> key {};
+			for (const std::uint16_t value : source.colorKey) {
+				key.push_back(static_cast<std::uint8_t> (value >> 8u));
+				key.push_back(static_cast<std::uint8_t> (value));
+			}
+			vx::testing::appendPngChunk(file, "tRNS", key);
+		}
+
+		vx::testing::endPng(file, filterRows(source, filters), dataChunkCount);
+		return file;
+	}
+
+	auto getExpectedPixels(const Source& source) -> std::vector<std::uint32_t> {
+		const std::uint32_t channelCount {getChannelCount(source.info.colorType)};
+		const std::uint32_t depth {source.info.bitDepth};
+		const auto toByte {[&](const std::uint16_t sample) -> std::uint32_t {
+			if (depth == 16u)
+				return sample >> 8u;
+			return sample * 255u / ((1u << depth) - 1u);
+		}};
+
+		std::vector<std::uint32_t> pixels {};
+		for (std::size_t i {0uz}; i < source.samples.size(); i += channelCount) {
+			const std::uint16_t* const samples {source.samples.data() + i};
+			std::uint32_t pixel {0u};
+			switch (source.info.colorType) {
+				case vx::image::PngColorType::gray:
+					pixel = toByte(samples[0]) * 0x01'0101u | 0xff00'0000u;
+					break;
+				case vx::image::PngColorType::grayAlpha:
+					pixel = toByte(samples[0]) * 0x01'0101u | (toByte(samples[1]) << 24u);
+					break;
+				case vx::image::PngColorType::rgb:
+					pixel = toByte(samples[0]) | (toByte(samples[1]) << 8u) | (toByte(samples[2]) << 16u) | 0xff00'0000u;
+					break;
+				case vx::image::PngColorType::rgba:
+					pixel = toByte(samples[0]) | (toByte(samples[1]) << 8u) | (toByte(samples[2]) << 16u) | (toByte(samples[3]) << 24u);
+					break;
+				case vx::image::PngColorType::indexed: {
+					const std::array<std::uint8_t, 3uz>& color {source.palette[samples[0]]};
+					const std::uint32_t alpha {samples[0] < source.paletteAlpha.size() ? source.paletteAlpha[samples[0]] : 0xffu};
+					pixel = color[0] | (color[1] << 8u) | (color[2] << 16u) | (alpha << 24u);
+					break;
+				}
+			}
+			if (!source.colorKey.empty() && std::equal(source.colorKey.begin(), source.colorKey.end(), samples))
+				pixel &= 0x00ff'ffffu;
+			pixels.push_back(pixel);
+		}
+		return pixels;
+	}
+
+	const std::vector<std::uint8_t> ALL_FILTERS {0u, 1u, 2u, 3u, 4u};
+}
+
+
+TEST_CASE("png - color types and bit depths", "[image]") {
+	using vx::image::PngColorType;
+	const auto [colorType, bitDepth] {GENERATE(
+		std::pair{PngColorType::gray, 1u}, std::pair{PngColorType::gray, 2u}, std::pair{PngColorType::gray, 4u},
+		std::pair{PngColorType::gray, 8u}, std::pair{PngColorType::gray, 16u},
+		std::pair{PngColorType::rgb, 8u}, std::pair{PngColorType::rgb, 16u},
+		std::pair{PngColorType::indexed, 1u}, std::pair{PngColorType::indexed, 2u},
+		std::pair{PngColorType::indexed, 4u}, std::pair{PngColorType::indexed, 8u},
+		std::pair{PngColorType::grayAlpha, 8u}, std::pair{PngColorType::grayAlpha, 16u},
+		std::pair{PngColorType::rgba, 8u}, std::pair{PngColorType::rgba, 16u}
+	)};
+	/* widths around the SIMD strides and the bytes of packed samples */
+	const std::uint32_t width {GENERATE(1u, 3u, 7u, 8u, 10u, 13u, 37u, 64u)};
+	const bool hasTransparency {GENERATE(false, true)};
+	const vx::image::PngInfo info {.width = width, .height = 11u, .colorType = colorType, .bitDepth = static_cast<std::uint8_t> (bitDepth)};
+	const Source source {makeSource(info, hasTransparency)};
+	const std::vector<std::byte> file {encodePng(source, ALL_FILTERS)};
+	const std::vector<std::uint32_t> expected {getExpectedPixels(source)};
+
+	const std::optional<vx::image::PngInfo> readInfo {vx::image::readPngInfo(file)};
+	REQUIRE(readInfo);
+	REQUIRE(readInfo->width == width);
+	REQUIRE(readInfo->height == 11u);
+	REQUIRE(readInfo->colorType == colorType);
+	REQUIRE(readInfo->bitDepth == bitDepth);
+
+	std::vector<std::uint32_t> pixels (expected.size(), 0u);
+	REQUIRE(vx::image::decodePng(file, pixels));
+	REQUIRE(pixels == expected);
+
+	const std::optional<vx::render::Image> image {vx::image::decodePng(file)};
+	REQUIRE(image);
+	REQUIRE(image->getWidth() == width);
+	REQUIRE(image->getHeight() == 11u);
+	REQUIRE(std::ranges::equal(image->getPixels(), expected));
+}
+
+TEST_CASE("png - filters", "[image]") {
+	using vx::image::PngColorType;
+	/* a single filter for the whole image, then a mix with long runs of rows that depend on the ones above */
+	const std::vector<std::uint8_t> filters {GENERATE(
+		std::vector<std::uint8_t> {0u}, std::vector<std::uint8_t> {1u}, std::vector<std::uint8_t> {2u},
+		std::vector<std::uint8_t> {3u}, std::vector<std::uint8_t> {4u},
+		std::vector<std::uint8_t> {1u, 2u, 3u, 4u, 4u, 2u, 3u},
+		std::vector<std::uint8_t> {0u, 4u, 4u, 4u, 4u, 4u, 4u, 4u, 4u, 4u, 3u, 2u}
+	)};
+	const PngColorType colorType {GENERATE(PngColorType::rgba, PngColorType::rgb, PngColorType::grayAlpha, PngColorType::indexed)};
+	const std::uint8_t bitDepth {static_cast<std::uint8_t> (GENERATE(8u, 16u))};
+	if (colorType == PngColorType::indexed && bitDepth == 16u)
+		return;
+	const std::size_t dataChunkCount {GENERATE(1uz, 5uz)};
+	const std::size_t workerCount {GENERATE(1uz, 4uz)};
+
+	const vx::image::PngInfo info {.width = 83u, .height = 97u, .colorType = colorType, .bitDepth = bitDepth};
+	const Source source {makeSource(info, false)};
+	const std::vector<std::byte> file {encodePng(source, filters, dataChunkCount)};
+	const std::vector<std::uint32_t> expected {getExpectedPixels(source)};
+
+	std::vector<std::uint32_t> pixels (expected.size(), 0u);
+	REQUIRE(vx::image::decodePng(file, pixels));
+	REQUIRE(pixels == expected);
+
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+	std::vector<std::uint32_t> parallelPixels (expected.size(), 0u);
+	REQUIRE(vx::image::decodePng(file, parallelPixels, scheduler));
+	REQUIRE(parallelPixels == expected);
+}
+
+TEST_CASE("png - malformed files", "[image]") {
+	const vx::image::PngInfo info {.width = 20u, .height = 20u, .colorType = vx::image::PngColorType::rgba, .bitDepth = 8u};
+	const Source source {makeSource(info, false)};
+	const std::vector<std::byte> file {encodePng(source, ALL_FILTERS)};
+	vx::jobs::Scheduler scheduler {{.workerCount = 2uz}};
+	std::vector<std::uint32_t> pixels (400uz);
+	const auto isRejected {[&](const std::span<const std::byte> bytes) -> bool {
+		return !vx::image::decodePng(bytes, pixels) && !vx::image::decodePng(bytes, pixels, scheduler) && !vx::image::decodePng(bytes);
+	}};
+	REQUIRE(vx::image::decodePng(file, pixels));
+
+	SECTION("signature") {
+		std::vector<std::byte> bytes {file};
+		bytes[1] = std::byte{'Q'};
+		REQUIRE(!vx::image::readPngInfo(bytes));
+		REQUIRE(isRejected(bytes));
+	}
+
+	SECTION("pixels of the wrong size") {
+		std::vector<std::uint32_t> smaller (399uz);
+		REQUIRE(!vx::image::decodePng(file, smaller));
+		REQUIRE(!vx::image::decodePng(file, smaller, scheduler));
+	}
+
+	SECTION("truncated") {
+		for (std::size_t size {0uz}; size < file.size(); size += 7uz)
+			REQUIRE(isRejected(std::span{file}.first(size)));
+	}
+
+	SECTION("interlaced") {
+		std::vector<std::byte> bytes {file};
+		bytes[8uz + 8uz + 12uz] = std::byte{1};
+		rewriteCrcs(bytes);
+		REQUIRE(!vx::image::readPngInfo(bytes));
+		REQUIRE(isRejected(bytes));
+	}
+
+	SECTION("invalid bit depth") {
+		std::vector<std::byte> bytes {file};
+		bytes[8uz + 8uz + 8uz] = std::byte{4};
+		rewriteCrcs(bytes);
+		REQUIRE(!vx::image::readPngInfo(bytes));
+		REQUIRE(isRejected(bytes));
+	}
+
+	SECTION("chunk CRCs") {
+		std::vector<std::byte> header {file};
+		header[8uz + 8uz + 3uz] = std::byte{21};
+		REQUIRE(!vx::image::readPngInfo(header));
+		REQUIRE(isRejected(header));
+
+		/* the last byte of the image data, before the CRC of its chunk and `IEND` */
+		std::vector<std::byte> data {file};
+		data[data.size() - 17uz] ^= std::byte{1};
+		REQUIRE(isRejected(data));
+
+		/* the ancillary chunks that are skipped aren't checked */
+		std::vector<std::byte> text {file};
+		text[33uz + 8uz] = std::byte{'V'};
+		REQUIRE(vx::image::decodePng(text, pixels));
+	}
+
+	SECTION("invalid filter") {
+		std::vector<std::uint8_t> filters {ALL_FILTERS};
+		filters.push_back(5u);
+		REQUIRE(isRejected(encodePng(source, filters)));
+	}
+
+	SECTION("indexed without palette") {
+		const vx::image::PngInfo indexedInfo {.width = 20u, .height = 20u, .colorType = vx::image::PngColorType::indexed, .bitDepth = 8u};
+		Source indexed {makeSource(indexedInfo, false)};
+		REQUIRE(vx::image::decodePng(encodePng(indexed, ALL_FILTERS), pixels));
+		indexed.palette.clear();
+		REQUIRE(isRejected(encodePng(indexed, ALL_FILTERS)));
+	}
+
+	SECTION("more rows than the header") {
+		Source taller {source};
+		taller.info.height = 21u;
+		taller.samples.resize(taller.samples.size() + 80uz, 0u);
+		std::vector<std::byte> bytes {encodePng(taller, ALL_FILTERS)};
+		/* the header of the taller image, with the height of the first one */
+		bytes[8uz + 8uz + 7uz] = std::byte{20};
+		rewriteCrcs(bytes);
+		REQUIRE(isRejected(bytes));
+	}
+
+	SECTION("fuzzed") {
+		std::mt19937 random {7u};
+		for (std::size_t i {0uz}; i < 500uz; ++i) {
+			std::vector<std::byte> bytes {file};
+			for (std::size_t j {0uz}; j < 1uz + i % 4uz; ++j)
+				bytes[33uz + random() % (bytes.size() - 33uz)] = static_cast<std::byte> (random());
+			/* past the CRCs, for the decoder to see the changed bytes */
+			rewriteCrcs(bytes);
+			/* must be safe, the result doesn't matter */
+			(void)vx::image::decodePng(bytes, pixels);
+			(void)vx::image::decodePng(bytes, pixels, scheduler);
+		}
+	}
+}
@@ -0,0 +1,222 @@
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/image/qoi.hpp>
+
+
+namespace {
+	enum class Content {
+		/* literal pixels mostly */
+		noise,
+		/* small differences from one pixel to the next */
+		gradient,
+		/* runs longer than an operation, on a background that comes back through the index */
+		sprites
+	};
+
+	auto makeImage(const std::uint32_t width, const std::uint32_t height, const Content content) -> vx::render::Image {
+		vx::render::Image image {width, height};
+		std::mt19937 random {width * 31u + height};
+		for (std::uint32_t y {0u}; y < height; ++y) {
+			for (std::uint32_t x {0u}; x < width; ++x) {
+				std::uint32_t pixel {0u};
+				if (content == Content::noise)
+					pixel = static_cast<std::uint32_t> (random());
+				else if (content == Content::gradient)
+					pixel = 0xff00'0000u | ((x * 3u + random() % 3u) & 0xffu) | (((y * 5u) & 0xffu) << 8u) | (((x + y) & 0xffu) << 16u);
+				else if ((x / 16u + y / 16u) % 3u == 0u)
+					pixel = (x % 16u == 0u ? 0x8000'0000u : 0xff00'0000u) | (random() % 4u == 0u ? 0x0020'4080u : 0x0010'2030u);
+				image.getRow(y)[x] = pixel;
+			}
+		}
+		return image;
+	}
+
+	auto toBytes(const std::vector<std::uint32_t>& values) -> std::vector<std::byte> {
+		std::vector<std::byte> bytes {};
+		for (const std::uint32_t value : values) {
+			for (std::uint32_t shift {0u}; shift < 32u; shift += 8u)
+				bytes.push_back(static_cast<std::byte> (value >> shift));
+		}
+		return bytes;
+	}
+
+	/* a file of one band, with the header of a `width`x1 image */
+	auto makeFile(const std::uint32_t width, const std::vector<std::uint8_t>& operations) -> std::vector<std::byte> {
+		std::vector<std::byte> file {static_cast<std::byte> ('V'), static_cast<std::byte> ('X'), static_cast<std::byte> ('Q'), static_cast<std::byte> ('I')};
+		const std::vector<std::byte> header {toBytes({width, 1u, 1u, static_cast<std::uint32_t> (operations.size())})};
+		file.insert(file.end(), header.begin(), header.end());
+		for (const std::uint8_t operation : operations)
+			file.push_back(static_cast<std::byte> (operation));
+		return file;
+	}
+}
+
+
+TEST_CASE("qoi - round trip", "[image]") {
+	const Content content {GENERATE(Content::noise, Content::gradient, Content::sprites)};
+	const auto [width, height] {GENERATE(
+		std::pair{1u, 1u},
+		std::pair{7u, 3u},
+		std::pair{1u, 300u},
+		std::pair{300u, 1u},
+		std::pair{700u, 500u},
+		std::pair{70'000u, 2u}
+	)};
+	const vx::render::Image image {makeImage(width, height, content)};
+	vx::jobs::Scheduler scheduler {{.workerCount = 3uz}};
+
+	const std::optional<std::vector<std::byte>> file {vx::image::encodeQoi(image)};
+	REQUIRE(file);
+	const std::optional<std::vector<std::byte>> parallelFile {vx::image::encodeQoi(image, scheduler)};
+	REQUIRE(parallelFile);
+	REQUIRE(*parallelFile == *file);
+
+	const std::optional<vx::image::QoiInfo> info {vx::image::readQoiInfo(*file)};
+	REQUIRE(info);
+	REQUIRE(info->width == width);
+	REQUIRE(info->height == height);
+	REQUIRE(info->bandCount == (height - 1u) / info->bandHeight + 1u);
+
+	std::vector<std::uint32_t> pixels (image.getPixels().size(), 0x1234'5678u);
+	REQUIRE(vx::image::decodeQoi(*file, pixels));
+	REQUIRE(std::ranges::equal(pixels, image.getPixels()));
+	std::ranges::fill(pixels, 0x1234'5678u);
+	REQUIRE(vx::image::decodeQoi(*file, pixels, scheduler));
+	REQUIRE(std::ranges::equal(pixels, image.getPixels()));
+	const std::optional<vx::render::Image> decoded {vx::image::decodeQoi(*file)};
+	REQUIRE(decoded);
+	REQUIRE(std::ranges::equal(decoded->getPixels(), image.getPixels()));
+
+	if (content == Content::sprites && image.getPixels().size() > 10'000uz)
+		REQUIRE(file->size() < image.getPixels().size_bytes() / 4uz);
+}
+
+TEST_CASE("qoi - operations", "[image]") {
+	vx::render::Image image {6u, 1u};
+	const std::array<std::uint32_t, 6uz> pixels {
+		/* the pixel before the first one */
+		0xff00'0000u,
+		0xff00'0001u,
+		/* green +20, red 4 above it and blue 4 below */
+		0xff10'1419u,
+		0x8010'1419u,
+		0xff00'0001u,
+		0xff10'1419u
+	};
+	std::ranges::copy(pixels, image.getPixels().begin());
+	const std::optional<std::vector<std::byte>> file {vx::image::encodeQoi(image)};
+	REQUIRE(file);
+	const std::vector<std::uint8_t> operations {
+		0xc0u,
+		0x7au,
+		0xb4u, 0xc4u,
+		0xffu, 0x19u, 0x14u, 0x10u, 0x80u,
+		/* `(r * 3 + g * 5 + b * 7 + a * 11) % 64` */
+		0x38u,
+		0x14u
+	};
+	REQUIRE(*file == makeFile(6u, operations));
+
+	SECTION("literal RGB") {
+		std::vector<std::uint32_t> decoded (2uz);
+		REQUIRE(vx::image::decodeQoi(makeFile(2u, {0xfeu, 0x01u, 0x02u, 0x03u, 0xc0u}), decoded));
+		REQUIRE(decoded == std::vector<std::uint32_t>{0xff03'0201u, 0xff03'0201u});
+	}
+
+	SECTION("long runs") {
+		vx::render::Image flat {130u, 1u, 0xff00'0000u};
+		REQUIRE(*vx::image::encodeQoi(flat) == makeFile(130u, {0xfdu, 0xfdu, 0xc5u}));
+	}
+}
+
+TEST_CASE("qoi - malformed files", "[image]") {
+	const vx::render::Image image {makeImage(300u, 400u, Content::gradient)};
+	const std::vector<std::byte> file {*vx::image::encodeQoi(image)};
+	vx::jobs::Scheduler scheduler {{.workerCount = 2uz}};
+	std::vector<std::uint32_t> pixels (image.getPixels().size());
+	const auto isRejected {[&](const std::span<const std::byte> bytes) -> bool {
+		return !vx::image::decodeQoi(bytes, pixels) && !vx::image::decodeQoi(bytes, pixels, scheduler) && !vx::image::decodeQoi(bytes);
+	}};
+	REQUIRE(vx::image::readQoiInfo(file)->bandCount > 1u);
+
+	SECTION("empty image") {
+		REQUIRE(!vx::image::encodeQoi(vx::render::Image{}));
+		REQUIRE(!vx::image::encodeQoi(vx::render::Image{}, scheduler));
+		REQUIRE(isRejected(makeFile(0u, {})));
+	}
+
+	SECTION("magic") {
+		std::vector<std::byte> bytes {file};
+		bytes[3] = std::byte{'O'};
+		REQUIRE(!vx::image::readQoiInfo(bytes));
+		REQUIRE(isRejected(bytes));
+	}
+
+	SECTION("pixels of the wrong size") {
+		std::vector<std::uint32_t> smaller (pixels.size() - 1uz);
+		REQUIRE(!vx::image::decodeQoi(file, smaller));
+		REQUIRE(!vx::image::decodeQoi(file, smaller, scheduler));
+	}
+
+	SECTION("truncated") {
+		for (std::size_t size {0uz}; size < file.size(); size += 97uz)
+			REQUIRE(isRejected(std::span{file}.first(size)));
+		REQUIRE(isRejected(std::span{file}.first(file.size() - 1uz)));
+	}
+
+	SECTION("band sizes") {
+		std::vector<std::byte> bytes {file};
+		std::uint32_t size;
+		(void)std::memcpy(&size, bytes.data() + 16, sizeof(size));
+		++size;
+		(void)std::memcpy(bytes.data() + 16, &size, sizeof(size));
+		REQUIRE(!vx::image::readQoiInfo(bytes));
+		bytes.push_back(std::byte{0});
+		REQUIRE(vx::image::readQoiInfo(bytes));
+		REQUIRE(isRejected(bytes));
+	}
+
+	SECTION("zero band height") {
+		std::vector<std::byte> bytes {file};
+		bytes[12] = bytes[13] = bytes[14] = bytes[15] = std::byte{0};
+		REQUIRE(!vx::image::readQoiInfo(bytes));
+	}
+
+	SECTION("too many pixels") {
+		REQUIRE(isRejected(makeFile(1u << 29u, {0xfdu})));
+	}
+
+	SECTION("run past the band") {
+		std::vector<std::uint32_t> decoded (3uz);
+		REQUIRE(vx::image::decodeQoi(makeFile(3u, {0xc2u}), decoded));
+		REQUIRE(!vx::image::decodeQoi(makeFile(3u, {0xc3u}), decoded));
+		REQUIRE(!vx::image::decodeQoi(makeFile(3u, {0xc1u}), decoded));
+	}
+
+	SECTION("operation past the band") {
+		std::vector<std::uint32_t> decoded (1uz);
+		REQUIRE(vx::image::decodeQoi(makeFile(1u, {0xffu, 1u, 2u, 3u, 4u}), decoded));
+		REQUIRE(!vx::image::decodeQoi(makeFile(1u, {0xffu, 1u, 2u, 3u}), decoded));
+		REQUIRE(!vx::image::decodeQoi(makeFile(1u, {0x80u}), decoded));
+		REQUIRE(!vx::image::decodeQoi(makeFile(1u, {0xc0u, 0xc0u}), decoded));
+	}
+
+	SECTION("fuzzed") {
+		std::mt19937 random {11u};
+		for (std::size_t i {0uz}; i < 500uz; ++i) {
+			std::vector<std::byte> bytes {file};
+			const std::size_t tableEnd {16uz + vx::image::readQoiInfo(file)->bandCount * 4uz};
+			for (std::size_t j {0uz}; j < 1uz + i % 4uz; ++j)
+				bytes[tableEnd + random() % (bytes.size() - tableEnd)] = static_cast<std::byte> (random());
+			/* must be safe, the result doesn't matter */
+			(void)vx::image::decodeQoi(bytes, pixels);
+			(void)vx::image::decodeQoi(bytes, pixels, scheduler);
+		}
+	}
+}
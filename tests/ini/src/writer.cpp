@@ -0,0 +1,135 @@
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <voxlet/ini/writer.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto toStdString(const vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output) -> std::u8string {
+		std::u8string string {};
+		output.forEachSegment([&](const std::span<const char8_t> segment) {
+			string.append(segment.begin(), segment.end());
+		});
+		return string;
+	}
+}
+
+
+TEST_CASE("ini - writer", "[ini]") {
+	vx::containers::StringAccumulator output {};
+	vx::ini::Writer writer {output};
+	writer.writeComment(vx::StringSlice::from(u8"generated by the engine\ndo not edit"));
+	writer.writeSection(vx::StringSlice::from(u8"window"));
+	writer.write(vx::StringSlice::from(u8"width"), 1280);
+	writer.write(vx::StringSlice::from(u8"height"), 720u);
+	writer.write(vx::StringSlice::from(u8"fullscreen"), false);
+	writer.write(vx::StringSlice::from(u8"scale"), 1.5);
+	writer.writeSection(vx::StringSlice::from(u8"player"));
+	writer.write(vx::StringSlice::from(u8"name"), u8"Ada Lovelace");
+	writer.write(vx::StringSlice::from(u8"greeting"), u8" hello; \"world\"\n");
+	writer.write(vx::StringSlice::from(u8"nickname"), u8"");
+	writer.write(vx::StringSlice::from(u8"tag"), u8"#1");
+
+	REQUIRE(toStdString(output) == std::u8string_view{
+		u8"; generated by the engine\n"
+		u8"; do not edit\n"
+		u8"\n"
+		u8"[window]\n"
+		u8"width = 1280\n"
+		u8"height = 720\n"
+		u8"fullscreen = false\n"
+		u8"scale = 1.5\n"
+		u8"\n"
+		u8"[player]\n"
+		u8"name = Ada Lovelace\n"
+		u8"greeting = \" hello; \\\"world\\\"\\n\"\n"
+		u8"nickname = \"\"\n"
+		u8"tag = \"#1\"\n"
+	});
+}
+
+TEST_CASE("ini - writer quoting", "[ini]") {
+	vx::containers::StringAccumulator output {};
+	vx::ini::Writer writer {output};
+	/* each would end the header early, comment out the rest of it or leave it unclosed on its line */
+	writer.writeSection(vx::StringSlice::from(u8"a]b"));
+	writer.writeSection(vx::StringSlice::from(u8"two\nlines"));
+	writer.writeSection(vx::StringSlice::from(u8"[nested]"));
+	writer.writeSection(vx::StringSlice::from(u8"audio; music"));
+	writer.writeSection(vx::StringSlice::from(u8"key bindings"));
+	/* each would split at the wrong `=`, read as a comment or a section, or spread over two lines */
+	writer.write(vx::StringSlice::from(u8"a=b"), 1);
+	writer.write(vx::StringSlice::from(u8"; volume"), true);
+	writer.write(vx::StringSlice::from(u8"#tag"), 2);
+	writer.write(vx::StringSlice::from(u8"[jump]"), u8"space");
+	writer.write(vx::StringSlice::from(u8"move\nleft"), u8"a");
+	writer.write(vx::StringSlice::from(u8" padded"), 3);
+	writer.write(vx::StringSlice::from(u8"quoted\"key"), 4);
+	writer.write(vx::StringSlice::from(u8"move right"), u8"d");
+	writer.write(vx::StringSlice::from(u8"up"), u8"a=b]");
+
+	REQUIRE(toStdString(output) == std::u8string_view{
+		u8"[\"a]b\"]\n"
+		u8"\n"
+		u8"[\"two\\nlines\"]\n"
+		u8"\n"
+		u8"[\"[nested]\"]\n"
+		u8"\n"
+		u8"[\"audio; music\"]\n"
+		u8"\n"
+		u8"[key bindings]\n"
+		u8"\"a=b\" = 1\n"
+		u8"\"; volume\" = true\n"
+		u8"\"#tag\" = 2\n"
+		u8"\"[jump]\" = space\n"
+		u8"\"move\\nleft\" = a\n"
+		u8"\" padded\" = 3\n"
+		u8"\"quoted\\\"key\" = 4\n"
+		u8"move right = d\n"
+		u8"up = a=b]\n"
+	});
+}
+
+TEST_CASE("ini - writer streaming", "[ini]") {
+	const auto writeSettings {[](auto& writer, const auto& afterEach) {
+		for (std::size_t i {0uz}; i < 40uz; ++i) {
+			const std::string section {"section with a name longer than a segment " + std::to_string(i)};
+			writer.writeSection(vx::testing::toSlice(section));
+			writer.writeComment(vx::StringSlice::from(u8"a comment spread\nover more than one segment of the output"));
+			writer.write(vx::StringSlice::from(u8"a key longer than the segments = quoted"), i);
+			writer.write(vx::StringSlice::from(u8"value"), u8"a value that takes a few segments; and is quoted");
+			writer.write(vx::StringSlice::from(u8"ratio"), static_cast<double> (i) / 7.0);
+			afterEach();
+		}
+	}};
+
+	vx::containers::StringAccumulator whole {};
+	vx::ini::Writer wholeWriter {whole};
+	writeSettings(wholeWriter, [] {});
+
+	/* what saving to a file would do, the segments written out whenever enough of them are filled */
+	vx::containers::BasicStringAccumulator<16uz, false> output {};
+	vx::ini::BasicWriter<16uz, false> writer {output};
+	std::u8string streamed {};
+	std::size_t flushCount {0uz};
+	const auto flush {[&] {
+		streamed += toStdString(output);
+		output.clear();
+		++flushCount;
+	}};
+	writeSettings(writer, [&] {
+		if (output.getSize() >= 256uz)
+			flush();
+	});
+	flush();
+
+	REQUIRE(flushCount > 10uz);
+	REQUIRE(streamed == toStdString(whole));
+	REQUIRE(streamed.starts_with(u8"[section with a name longer than a segment 0]\n; a comment spread\n"));
+}
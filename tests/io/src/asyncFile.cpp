@@ -0,0 +1,204 @@
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/async/executor.hpp>
+#include <voxlet/async/task.hpp>
+#include <voxlet/containers/string.hpp>
+#include <voxlet/io/asyncFile.hpp>
+#include <voxlet/io/ioContext.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	/* unique to the process and the call, for test runs in parallel not to share files */
+	auto makeTestFile(const std::size_t size) -> std::filesystem::path {
+		static std::size_t counter {0uz};
+		const auto name {"voxlet-io-test-" + std::to_string(::getpid()) + "-" + std::to_string(counter++) + ".bin"};
+		const auto path {std::filesystem::temp_directory_path() / name};
+		std::ofstream stream {path, std::ios::binary | std::ios::trunc};
+		for (std::size_t i {0uz}; i < size; ++i)
+			stream.put(static_cast<char> (i % 251uz));
+		return path;
+	}
+
+	auto isPatternValid(const std::span<const std::byte> data, const std::size_t offset) noexcept -> bool {
+		for (std::size_t i {0uz}; i < data.size(); ++i) {
+			if (data[i] != static_cast<std::byte> ((offset + i) % 251uz))
+				return false;
+		}
+		return true;
+	}
+
+	auto readAt(const vx::io::AsyncFile& file, std::span<std::byte> buffer, const std::uint64_t offset)
+		-> vx::async::Task<std::int64_t>
+	{
+		co_return co_await file.read({.buffer = buffer, .offset = offset});
+	}
+}
+
+
+TEST_CASE("async-file", "[io]") {
+	const vx::io::Backend backend {GENERATE(vx::io::Backend::automatic, vx::io::Backend::threadPool)};
+	constexpr std::size_t FILE_SIZE {64uz * 1024uz};
+	const auto path {makeTestFile(FILE_SIZE)};
+	const auto pathString {path.string()};
+	const auto pathSlice {vx::testing::toSlice(pathString)};
+
+	vx::io::IoContext context {{.backend = backend}};
+	if (backend == vx::io::Backend::threadPool)
+		REQUIRE(context.getBackend() == vx::io::Backend::threadPool);
+
+	auto file {vx::io::AsyncFile::open(context, pathSlice)};
+	REQUIRE(file.has_value());
+	REQUIRE(file->getSize() == FILE_SIZE);
+	REQUIRE(!vx::io::AsyncFile::open(context, vx::StringSlice::from(u8"/this/file/does/not/exist")).has_value());
+
+	SECTION("callbacks") {
+		constexpr std::size_t READ_COUNT {16uz};
+		constexpr std::size_t READ_SIZE {1000uz};
+		std::vector<std::array<std::byte, READ_SIZE>> buffers(READ_COUNT);
+		std::array<std::int64_t, READ_COUNT> results {};
+		for (std::size_t i {0uz}; i < READ_COUNT; ++i) {
+			file->read({.buffer = buffers[i], .offset = i * 3001uz}, [](void* userData, std::int64_t result) noexcept {
+				*static_cast<std::int64_t*> (userData) = result;
+			}, &results[i]);
+		}
+		REQUIRE(context.getPendingCount() == READ_COUNT);
+		std::size_t completed {0uz};
+		while (completed != READ_COUNT)
+			completed += context.wait();
+		REQUIRE(context.getPendingCount() == 0uz);
+		for (std::size_t i {0uz}; i < READ_COUNT; ++i) {
+			REQUIRE(results[i] == static_cast<std::int64_t> (READ_SIZE));
+			REQUIRE(isPatternValid(buffers[i], i * 3001uz));
+		}
+	}
+
+	SECTION("more reads than the queue depth") {
+		/* queued from the thread that waits, the reads past the ring wait for the next submission */
+		vx::io::IoContext smallContext {{.backend = backend, .queueDepth = 2u}};
+		auto smallFile {vx::io::AsyncFile::open(smallContext, pathSlice)};
+		REQUIRE(smallFile.has_value());
+		constexpr std::size_t READ_COUNT {40uz};
+		std::vector<std::array<std::byte, 100uz>> buffers(READ_COUNT);
+		std::array<std::int64_t, READ_COUNT> results {};
+		for (std::size_t i {0uz}; i < READ_COUNT; ++i) {
+			smallFile->read({.buffer = buffers[i], .offset = i * 1000uz}, [](void* userData, std::int64_t result) noexcept {
+				*static_cast<std::int64_t*> (userData) = result;
+			}, &results[i]);
+		}
+		REQUIRE(smallContext.getPendingCount() == READ_COUNT);
+		REQUIRE(smallContext.wait(READ_COUNT) == READ_COUNT);
+		REQUIRE(smallContext.getPendingCount() == 0uz);
+		for (std::size_t i {0uz}; i < READ_COUNT; ++i) {
+			REQUIRE(results[i] == 100);
+			REQUIRE(isPatternValid(buffers[i], i * 1000uz));
+		}
+	}
+
+	SECTION("short read at end of file") {
+		std::array<std::byte, 256uz> buffer {};
+		std::int64_t result {0};
+		file->read({.buffer = buffer, .offset = FILE_SIZE - 100uz}, [](void* userData, std::int64_t result) noexcept {
+			*static_cast<std::int64_t*> (userData) = result;
+		}, &result);
+		REQUIRE(context.wait() == 1uz);
+		REQUIRE(result == 100);
+		REQUIRE(isPatternValid(std::span{buffer}.first(100uz), FILE_SIZE - 100uz));
+	}
+
+	SECTION("registered buffers") {
+		std::vector<std::byte> storage(8192uz);
+		const std::array<std::span<std::byte>, 2uz> buffers {
+			std::span{storage}.first(4096uz),
+			std::span{storage}.last(4096uz)
+		};
+		REQUIRE(context.registerBuffers(buffers));
+		std::array<std::int64_t, 2uz> results {};
+		for (std::uint32_t i {0u}; i < 2u; ++i) {
+			file->read({.buffer = buffers[i], .offset = i * 4096u, .registeredBuffer = i}, [](void* userData, std::int64_t result) noexcept {
+				*static_cast<std::int64_t*> (userData) = result;
+			}, &results[i]);
+		}
+		std::size_t completed {0uz};
+		while (completed != 2uz)
+			completed += context.wait(2uz);
+		REQUIRE(results[0] == 4096);
+		REQUIRE(results[1] == 4096);
+		REQUIRE(isPatternValid(storage, 0uz));
+		context.unregisterBuffers();
+	}
+
+	SECTION("self move") {
+		auto& alias {*file};
+		*file = std::move(alias);
+		std::array<std::byte, 64uz> buffer {};
+		std::int64_t result {0};
+		file->read({.buffer = buffer, .offset = 0u}, [](void* userData, std::int64_t result) noexcept {
+			*static_cast<std::int64_t*> (userData) = result;
+		}, &result);
+		REQUIRE(context.wait() == 1uz);
+		REQUIRE(result == 64);
+		REQUIRE(isPatternValid(buffer, 0uz));
+	}
+
+	SECTION("coroutines") {
+		const auto reader {[](const vx::io::AsyncFile& file, std::span<std::byte> buffer, std::int64_t& result, bool& isDone)
+			-> vx::async::Task<>
+		{
+			result = co_await readAt(file, buffer, 4096u);
+			isDone = true;
+		}};
+
+		std::array<std::byte, 512uz> buffer {};
+		std::int64_t result {0};
+		bool isDone {false};
+		vx::async::spawn(reader(*file, buffer, result, isDone));
+		REQUIRE(!isDone);
+		while (!isDone)
+			(void)context.wait();
+		REQUIRE(result == 512);
+		REQUIRE(isPatternValid(buffer, 4096uz));
+
+		vx::jobs::Scheduler scheduler {{.workerCount = 0uz}};
+		vx::io::IoContext scheduledContext {{.backend = backend, .scheduler = &scheduler}};
+		auto scheduledFile {vx::io::AsyncFile::open(scheduledContext, pathSlice)};
+		REQUIRE(scheduledFile.has_value());
+		isDone = false;
+		vx::async::spawn(reader(*scheduledFile, buffer, result, isDone));
+		REQUIRE(scheduledContext.wait() == 1uz);
+		REQUIRE(!isDone);
+		while (!isDone)
+			(void)scheduler.tryRunOne();
+		REQUIRE(result == 512);
+	}
+
+	file.reset();
+	std::filesystem::remove(path);
+}
+
+
+TEST_CASE("io-context-backend", "[io]") {
+	/* past the most entries a ring can have, io_uring can't be set up */
+	constexpr std::uint32_t QUEUE_DEPTH {1u << 20u};
+
+	vx::io::IoContext automatic {{.backend = vx::io::Backend::automatic, .queueDepth = QUEUE_DEPTH}};
+	REQUIRE(automatic.isValid());
+	REQUIRE(automatic.getBackend() == vx::io::Backend::threadPool);
+
+	vx::io::IoContext uring {{.backend = vx::io::Backend::ioUring, .queueDepth = QUEUE_DEPTH}};
+	REQUIRE(!uring.isValid());
+	REQUIRE(uring.getBackend() == vx::io::Backend::ioUring);
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/io/mappedFile.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	using vx::testing::toSlice;
+
+	/* unique to the process and the call, for test runs in parallel not to share files */
+	auto writeFile(const std::string& content) -> std::filesystem::path {
+		static std::size_t counter {0uz};
+		const auto name {"voxlet-mapped-file-test-" + std::to_string(::getpid()) + "-" + std::to_string(counter++) + ".txt"};
+		const auto path {std::filesystem::temp_directory_path() / name};
+		std::ofstream {path, std::ios::binary | std::ios::trunc} << content;
+		return path;
+	}
+}
+
+
+TEST_CASE("mapped-file", "[io]") {
+	const std::string content {GENERATE(std::string{"[window]\nwidth = 1280\nheight = 720\n"}, std::string(100'000uz, 'v'))};
+	const auto path {writeFile(content)};
+	const auto pathString {path.string()};
+	const vx::io::AccessPattern pattern {GENERATE(vx::io::AccessPattern::normal, vx::io::AccessPattern::sequential)};
+
+	REQUIRE(vx::io::MappedFile::prefetch(toSlice(pathString)));
+	auto file {vx::io::MappedFile::open(toSlice(pathString), {.pattern = pattern, .willNeed = true, .hugePages = true})};
+	REQUIRE(file.has_value());
+	REQUIRE(file->getSize() == content.size());
+
+	SECTION("views") {
+		const auto bytes {file->getBytes()};
+		REQUIRE(bytes.size() == content.size());
+		REQUIRE(std::ranges::equal(bytes, content, {}, {}, [](const char c) {return static_cast<std::byte> (c);}));
+
+		const auto text {file->getText()};
+		REQUIRE(text.getSize() == content.size());
+		REQUIRE(text[0uz] == static_cast<char8_t> (content[0uz]));
+		REQUIRE(text[content.size() - 1uz] == static_cast<char8_t> (content.back()));
+
+		const auto unchecked {file->getUncheckedText()};
+		REQUIRE(unchecked.getSize() == content.size());
+		REQUIRE(std::ranges::equal(unchecked, content, {}, {}, [](const char c) {return static_cast<char8_t> (c);}));
+	}
+
+	SECTION("prefetch and advise") {
+		file->prefetch(content.size() / 2uz);
+		file->prefetch(content.size() + 10uz);
+		file->advise(vx::io::AccessPattern::random);
+		REQUIRE(file->getText()[content.size() / 2uz] == static_cast<char8_t> (content[content.size() / 2uz]));
+	}
+
+	SECTION("move") {
+		const std::byte* const data {file->getData()};
+		vx::io::MappedFile moved {std::move(*file)};
+		REQUIRE(file->isEmpty());
+		REQUIRE(file->getData() == nullptr);
+		REQUIRE(moved.getData() == data);
+		*file = std::move(moved);
+		REQUIRE(file->getData() == data);
+		auto& alias {*file};
+		*file = std::move(alias);
+		REQUIRE(file->getData() == data);
+		REQUIRE(file->getSize() == content.size());
+	}
+
+	file.reset();
+	std::filesystem::remove(path);
+}
+
+
+TEST_CASE("mapped-file - edge cases", "[io]") {
+	REQUIRE(!vx::io::MappedFile::open(vx::StringSlice::from(u8"/this/file/does/not/exist")).has_value());
+	REQUIRE(!vx::io::MappedFile::prefetch(vx::StringSlice::from(u8"/this/file/does/not/exist")));
+
+	const auto path {writeFile("")};
+	const auto pathString {path.string()};
+	const auto file {vx::io::MappedFile::open(toSlice(pathString))};
+	REQUIRE(file.has_value());
+	REQUIRE(file->isEmpty());
+	REQUIRE(file->getBytes().empty());
+	REQUIRE(file->getText().isEmpty());
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/jobs/frameGraph.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+
+
+TEST_CASE("frame-graph", "[jobs]") {
+	const std::size_t workerCount {GENERATE(0uz, 3uz)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+	vx::jobs::FrameGraph graph {};
+
+	const auto input {graph.getResource(vx::StringSlice::from(u8"input"))};
+	const auto world {graph.getResource(vx::StringSlice::from(u8"world"))};
+	const auto animations {graph.getResource(vx::StringSlice::from(u8"animations"))};
+	const auto sprites {graph.getResource(vx::StringSlice::from(u8"sprites"))};
+	const auto audio {graph.getResource(vx::StringSlice::from(u8"audio"))};
+	REQUIRE(graph.getResource(vx::StringSlice::from(u8"world")) == world);
+
+	std::vector<int> order {};
+	std::atomic<int> clock {0};
+	std::vector<int> finishedAt(6uz, -1);
+	const auto stage {[&](const std::size_t index) {
+		return [&, index]() {
+			std::this_thread::sleep_for(std::chrono::microseconds{100});
+			finishedAt[index] = clock++;
+		};
+	}};
+
+	(void)graph.addStage({vx::String::from(u8"input"), {}, {input}, stage(0uz)});
+	(void)graph.addStage({vx::String::from(u8"simulation"), {input}, {world}, stage(1uz)});
+	(void)graph.addStage({vx::String::from(u8"animation"), {world}, {animations}, stage(2uz)});
+	(void)graph.addStage({vx::String::from(u8"culling"), {world}, {}, stage(3uz)});
+	(void)graph.addStage({vx::String::from(u8"sprite batching"), {world, animations}, {sprites}, stage(4uz)});
+	(void)graph.addStage({vx::String::from(u8"audio mix"), {}, {audio}, stage(5uz)});
+	REQUIRE(graph.isDirty());
+
+	SECTION("dependencies") {
+		graph.compile();
+		REQUIRE(!graph.isDirty());
+		REQUIRE(graph.getDependencies(0uz).empty());
+		REQUIRE(std::ranges::equal(graph.getDependencies(1uz), std::vector{0uz}));
+		REQUIRE(std::ranges::equal(graph.getDependencies(2uz), std::vector{1uz}));
+		REQUIRE(std::ranges::equal(graph.getDependencies(3uz), std::vector{1uz}));
+		REQUIRE(std::ranges::is_permutation(graph.getDependencies(4uz), std::vector{1uz, 2uz}));
+		REQUIRE(graph.getDependencies(5uz).empty());
+	}
+
+	SECTION("write after read") {
+		(void)graph.addStage({vx::String::from(u8"world cleanup"), {}, {world}, stage(0uz)});
+		graph.compile();
+		REQUIRE(std::ranges::is_permutation(graph.getDependencies(6uz), std::vector{1uz, 2uz, 3uz, 4uz}));
+	}
+
+	SECTION("execution") {
+		for (int frame {0}; frame < 3; ++frame) {
+			graph.execute(scheduler);
+			REQUIRE(finishedAt[0] < finishedAt[1]);
+			REQUIRE(finishedAt[1] < finishedAt[2]);
+			REQUIRE(finishedAt[1] < finishedAt[3]);
+			REQUIRE(finishedAt[2] < finishedAt[4]);
+			REQUIRE(finishedAt[5] >= 0);
+		}
+		REQUIRE(graph.getCompilationCount() == 1uz);
+
+		const auto timings {graph.getTimings()};
+		REQUIRE(timings.size() == 6uz);
+		REQUIRE(std::ranges::equal(timings[4].name, vx::StringSlice::from(u8"sprite batching")));
+		for (const auto& timing : timings)
+			REQUIRE(timing.duration.count() > 0);
+
+		const auto criticalPath {graph.getCriticalPath()};
+		REQUIRE(criticalPath.size() >= 3uz);
+		REQUIRE(criticalPath.front() == 0uz);
+		REQUIRE(timings[criticalPath.front()].isOnCriticalPath);
+		REQUIRE(graph.getFrameDuration() >= timings[criticalPath.back()].start);
+	}
+
+	SECTION("rebuild on change") {
+		graph.execute(scheduler);
+		graph.execute(scheduler);
+		REQUIRE(graph.getCompilationCount() == 1uz);
+		REQUIRE(graph.removeStage(vx::StringSlice::from(u8"culling")));
+		REQUIRE(!graph.removeStage(vx::StringSlice::from(u8"culling")));
+		REQUIRE(graph.isDirty());
+		graph.execute(scheduler);
+		REQUIRE(graph.getCompilationCount() == 2uz);
+		REQUIRE(graph.getStageCount() == 5uz);
+		REQUIRE(graph.findStage(vx::StringSlice::from(u8"audio mix")) == 4uz);
+	}
+}
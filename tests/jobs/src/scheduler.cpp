@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/containers/string.hpp>
+#include <voxlet/jobs/parallelFor.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/jobs/workStealingDeque.hpp>
+
+
+TEST_CASE("work-stealing-deque", "[jobs]") {
+	vx::jobs::WorkStealingDeque<int> deque {4uz};
+
+	SECTION("owner is LIFO") {
+		for (const int i : std::views::iota(0, 100))
+			deque.push(i);
+		REQUIRE(deque.size() == 100uz);
+		REQUIRE(deque.capacity() >= 100uz);
+		for (const int i : std::views::iota(0, 100) | std::views::reverse)
+			REQUIRE(deque.pop() == i);
+		REQUIRE(!deque.pop());
+		REQUIRE(deque.empty());
+	}
+
+	SECTION("thieves are FIFO") {
+		for (const int i : std::views::iota(0, 10))
+			deque.push(i);
+		for (const int i : std::views::iota(0, 10))
+			REQUIRE(deque.steal() == i);
+		REQUIRE(!deque.steal());
+	}
+
+	SECTION("concurrent steal") {
+		constexpr int COUNT {100'000};
+		std::atomic<long long> stolenSum {0};
+		std::atomic<bool> done {false};
+		std::vector<std::jthread> thieves {};
+		for (int i {0}; i < 3; ++i) {
+			thieves.emplace_back([&]() {
+				while (!done.load() || !deque.empty()) {
+					if (const auto value {deque.steal()})
+						stolenSum += *value;
+				}
+			});
+		}
+
+		long long poppedSum {0};
+		for (const int i : std::views::iota(0, COUNT)) {
+			deque.push(i);
+			if (i % 3 == 0) {
+				if (const auto value {deque.pop()})
+					poppedSum += *value;
+			}
+		}
+		while (const auto value {deque.pop()})
+			poppedSum += *value;
+		done = true;
+		thieves.clear();
+
+		REQUIRE(poppedSum + stolenSum.load() == static_cast<long long> (COUNT) * (COUNT - 1) / 2);
+	}
+}
+
+
+TEST_CASE("scheduler", "[jobs]") {
+	const std::size_t workerCount {GENERATE(0uz, 1uz, 3uz)};
+	const auto sleepPolicy {GENERATE(vx::jobs::SleepPolicy::spin, vx::jobs::SleepPolicy::sleep)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount, .sleepPolicy = sleepPolicy}};
+	REQUIRE(scheduler.getWorkerCount() == workerCount);
+	REQUIRE(scheduler.getThreadCount() == workerCount + 1uz);
+
+	SECTION("counter") {
+		std::atomic<std::size_t> executed {0uz};
+		auto job {[&executed]() noexcept {++executed;}};
+		vx::jobs::Counter counter {};
+		for (int i {0}; i < 1000; ++i)
+			scheduler.submit(job, counter);
+		scheduler.wait(counter);
+		REQUIRE(counter.isDone());
+		REQUIRE(executed == 1000uz);
+	}
+
+	SECTION("nested jobs") {
+		std::atomic<std::size_t> executed {0uz};
+		std::atomic<bool> validIndices {true};
+		vx::jobs::Counter childCounter {};
+		auto child {[&executed]() noexcept {++executed;}};
+		auto parent {[&]() noexcept {
+			if (scheduler.getCurrentThreadIndex() >= scheduler.getThreadCount())
+				validIndices = false;
+			for (int i {0}; i < 10; ++i)
+				scheduler.submit(child, childCounter);
+		}};
+		vx::jobs::Counter parentCounter {};
+		for (int i {0}; i < 10; ++i)
+			scheduler.submit(parent, parentCounter);
+		scheduler.wait(parentCounter);
+		scheduler.wait(childCounter);
+		REQUIRE(executed == 100uz);
+		REQUIRE(validIndices);
+	}
+
+	SECTION("parallel-for over span") {
+		std::vector<std::uint32_t> values(100'000uz);
+		std::iota(values.begin(), values.end(), 0u);
+		vx::jobs::parallelFor(scheduler, values, [](std::span<std::uint32_t> chunk) noexcept {
+			for (auto& value : chunk)
+				value *= 2u;
+		});
+		for (const auto i : std::views::iota(0u, 100'000u))
+			REQUIRE(values[i] == 2u * i);
+	}
+
+	SECTION("parallel-for over elements") {
+		std::vector<std::uint64_t> values(12'345uz, 1u);
+		vx::jobs::parallelFor(scheduler, values, [](std::uint64_t& value) noexcept {++value;}, 7uz);
+		REQUIRE(std::ranges::all_of(values, [](const auto value) {return value == 2u;}));
+	}
+
+	SECTION("parallel-for over vx ranges") {
+		vx::String string {};
+		string.resize(10'000uz);
+		vx::jobs::parallelFor(scheduler, string, [](char8_t& c) noexcept {c = u8'a';}, 64uz);
+
+		std::atomic<std::size_t> count {0uz};
+		vx::jobs::parallelFor(scheduler, string.slice(), [&count](std::span<const char8_t> chunk) noexcept {
+			count += static_cast<std::size_t> (std::ranges::count(chunk, u8'a'));
+		}, 64uz);
+		REQUIRE(count == 10'000uz);
+	}
+
+	SECTION("parallel-for over indices") {
+		std::vector<std::atomic<std::uint8_t>> touched(1'000uz);
+		vx::jobs::parallelFor(scheduler, 0, 1'000, [&touched](const int begin, const int end) noexcept {
+			for (const int i : std::views::iota(begin, end))
+				++touched[static_cast<std::size_t> (i)];
+		}, 10uz);
+		REQUIRE(std::ranges::all_of(touched, [](const auto& value) {return value == 1u;}));
+	}
+}
+
+
+TEST_CASE("grain-size", "[jobs]") {
+	REQUIRE(vx::jobs::computeGrainSize(0uz, 4uz) == 1uz);
+	REQUIRE(vx::jobs::computeGrainSize(1600uz, 4uz) == 100uz);
+	REQUIRE(vx::jobs::computeGrainSize(1600uz, 4uz, 512uz) == 512uz);
+	REQUIRE(vx::jobs::computeGrainSize(1601uz, 4uz) == 101uz);
+}
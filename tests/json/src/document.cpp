@@ -0,0 +1,388 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/json/document.hpp>
+
+
+namespace {
+	auto parse(const std::u8string_view text) -> std::optional<vx::json::Document> {
+		return vx::json::Document::parse(vx::StringSlice::from(text.data(), text.size()));
+	}
+
+	auto toView(const vx::containers::views::UncheckedStringSlice& slice) -> std::u8string_view {
+		return {slice.begin(), slice.size()};
+	}
+
+	/* what a generated text should parse to, strings without escapes */
+	struct Expected {
+		vx::json::Type type;
+		double number;
+		std::u8string string;
+		std::vector<std::pair<std::u8string, Expected>> children;
+	};
+
+	class Generator final {
+		public:
+			explicit Generator(const std::uint32_t seed) : m_random {seed} {}
+
+			auto generate(std::u8string& text, const std::uint32_t depth) -> Expected {
+				this->pushWhitespace(text);
+				Expected expected {.type = vx::json::Type::null, .number = 0.0, .string = {}, .children = {}};
+				const std::uint32_t kind {static_cast<std::uint32_t> (m_random() % (depth < 4u ? 7u : 4u))};
+				if (kind == 0u) {
+					text += u8"null";
+				}
+				else if (kind == 1u) {
+					const bool value {m_random() % 2u == 0u};
+					text += value ? u8"true" : u8"false";
+					expected = {.type = vx::json::Type::boolean, .number = value ? 1.0 : 0.0, .string = {}, .children = {}};
+				}
+				else if (kind == 2u) {
+					const std::int64_t value {static_cast<std::int64_t> (m_random() % 2'000'001u) - 1'000'000};
+					const bool isFraction {m_random() % 3u == 0u};
+					const std::string digits {isFraction ? std::to_string(value) + ".25" : std::to_string(value)};
+					text.append(digits.begin(), digits.end());
+					const double number {isFraction ? static_cast<double> (value) + (value < 0 ? -0.25 : 0.25) : static_cast<double> (value)};
+					expected = {.type = vx::json::Type::number, .number = number, .string = {}, .children = {}};
+				}
+				else if (kind == 3u) {
+					expected = {.type = vx::json::Type::string, .number = 0.0, .string = this->makeString(), .children = {}};
+					this->pushString(text, expected.string);
+				}
+				else {
+					const bool isObject {kind >= 5u};
+					expected.type = isObject ? vx::json::Type::object : vx::json::Type::array;
+					text += isObject ? u8'{' : u8'[';
+					const std::uint32_t count {static_cast<std::uint32_t> (m_random() % 6u)};
+					for (std::uint32_t i {0u}; i < count; ++i) {
+						if (i != 0u)
+							text += u8',';
+						std::u8string key {};
+						if (isObject) {
+							key = this->makeString();
+							this->pushWhitespace(text);
+							this->pushString(text, key);
+							this->pushWhitespace(text);
+							text += u8':';
+						}
+						expected.children.emplace_back(key, this->generate(text, depth + 1u));
+					}
+					this->pushWhitespace(text);
+					text += isObject ? u8'}' : u8']';
+				}
+				this->pushWhitespace(text);
+				return expected;
+			}
+
+		private:
+			auto pushWhitespace(std::u8string& text) -> void {
+				constexpr std::u8string_view WHITESPACE {u8" \t\n\r"};
+				for (std::uint32_t count {static_cast<std::uint32_t> (m_random() % 4u)}; count > 0u; --count)
+					text += WHITESPACE[m_random() % WHITESPACE.size()];
+			}
+
+			/* long enough to cross the 64 bytes blocks at times, with structural characters inside */
+			auto makeString() -> std::u8string {
+				constexpr std::u8string_view CHARACTERS {u8"abcXYZ019 {}[]:,é"};
+				std::u8string string {};
+				for (std::uint32_t size {static_cast<std::uint32_t> (m_random() % 80u)}; size > 0u; --size) {
+					const std::size_t character {m_random() % (CHARACTERS.size() - 1uz)};
+					/* the two bytes of `é` together */
+					if (character == CHARACTERS.size() - 2uz)
+						string += CHARACTERS.substr(character);
+					else
+						string += CHARACTERS[character];
+				}
+				return string;
+			}
+
+			auto pushString(std::u8string& text, const std::u8string_view string) -> void {
+				text += u8'"';
+				text += string;
+				text += u8'"';
+			}
+
+			std::mt19937 m_random;
+	};
+
+	auto matches(const vx::json::Value& value, const Expected& expected) -> bool {
+		if (value.getType() != expected.type)
+			return false;
+		switch (expected.type) {
+			case vx::json::Type::null:
+				return value.isValid();
+			case vx::json::Type::boolean:
+				return value.asBoolean() == (expected.number != 0.0);
+			case vx::json::Type::number:
+				return value.asNumber() == expected.number;
+			case vx::json::Type::string:
+				return toView(*value.asString()) == expected.string;
+			case vx::json::Type::array: {
+				if (value.getSize() != expected.children.size())
+					return false;
+				std::size_t i {0uz};
+				for (const vx::json::Value element : value.getElements()) {
+					if (!matches(element, expected.children[i].second) || !matches(value[i], expected.children[i].second))
+						return false;
+					++i;
+				}
+				return i == expected.children.size();
+			}
+			case vx::json::Type::object: {
+				if (value.getSize() != expected.children.size())
+					return false;
+				std::size_t i {0uz};
+				for (const vx::json::Member member : value.getMembers()) {
+					if (toView(member.key) != expected.children[i].first || !matches(member.value, expected.children[i].second))
+						return false;
+					++i;
+				}
+				return i == expected.children.size();
+			}
+		}
+		return false;
+	}
+}
+
+
+TEST_CASE("json - values", "[json]") {
+	SECTION("scalars") {
+		REQUIRE(parse(u8"true")->getRoot().asBoolean() == true);
+		REQUIRE(parse(u8" false\n")->getRoot().asBoolean() == false);
+		REQUIRE(parse(u8"null")->getRoot().getType() == vx::json::Type::null);
+		REQUIRE(parse(u8"null")->getRoot().isValid());
+		REQUIRE(parse(u8"0")->getRoot().asInteger() == 0);
+		REQUIRE(parse(u8"-12")->getRoot().asInteger() == -12);
+		REQUIRE(parse(u8"-12")->getRoot().asNumber() == -12.0);
+		REQUIRE(parse(u8"3.25")->getRoot().asNumber() == 3.25);
+		REQUIRE(!parse(u8"3.25")->getRoot().asInteger());
+		REQUIRE(parse(u8"1e3")->getRoot().asNumber() == 1000.0);
+		REQUIRE(parse(u8"-0.5E-2")->getRoot().asNumber() == -0.005);
+		REQUIRE(std::signbit(*parse(u8"-0")->getRoot().asNumber()));
+		REQUIRE(parse(u8"9223372036854775807")->getRoot().asInteger() == std::numeric_limits<std::int64_t>::max());
+		REQUIRE(parse(u8"-9223372036854775808")->getRoot().asInteger() == std::numeric_limits<std::int64_t>::min());
+		REQUIRE(!parse(u8"9223372036854775808")->getRoot().asInteger());
+		REQUIRE(parse(u8"9223372036854775808")->getRoot().asNumber() == 9223372036854775808.0);
+		REQUIRE(parse(u8"123456789012345678901234567890")->getRoot().asNumber() == 123456789012345678901234567890.0);
+		/* with room after them, digits are read 8 at a time */
+		const std::optional<vx::json::Document> integers {parse(u8"[12345678, 123456789, 9223372036854775807 , 10000000000000000000, 7,0, 1234567.5]       ")};
+		REQUIRE(integers->getRoot()[0uz].asInteger() == 12'345'678);
+		REQUIRE(integers->getRoot()[1uz].asInteger() == 123'456'789);
+		REQUIRE(integers->getRoot()[2uz].asInteger() == std::numeric_limits<std::int64_t>::max());
+		REQUIRE(!integers->getRoot()[3uz].asInteger());
+		REQUIRE(integers->getRoot()[3uz].asNumber() == 1e19);
+		REQUIRE(integers->getRoot()[4uz].asInteger() == 7);
+		REQUIRE(integers->getRoot()[5uz].asInteger() == 0);
+		REQUIRE(integers->getRoot()[6uz].asNumber() == 1234567.5);
+		REQUIRE(toView(*parse(u8"\"text\"")->getRoot().asString()) == u8"text");
+		REQUIRE(toView(*parse(u8"\"\"")->getRoot().asString()).empty());
+	}
+
+	SECTION("types") {
+		const std::u8string text {u8R"({"a": null, "b": true, "c": 1, "d": "", "e": [], "f": {}})"};
+		const std::optional<vx::json::Document> document {parse(text)};
+		REQUIRE(document);
+		const vx::json::Value root {document->getRoot()};
+		REQUIRE(root[vx::StringSlice::from(u8"a")].getType() == vx::json::Type::null);
+		REQUIRE(root[vx::StringSlice::from(u8"b")].getType() == vx::json::Type::boolean);
+		REQUIRE(root[vx::StringSlice::from(u8"c")].getType() == vx::json::Type::number);
+		REQUIRE(root[vx::StringSlice::from(u8"d")].getType() == vx::json::Type::string);
+		REQUIRE(root[vx::StringSlice::from(u8"e")].getType() == vx::json::Type::array);
+		REQUIRE(root[vx::StringSlice::from(u8"f")].getType() == vx::json::Type::object);
+		REQUIRE(root[vx::StringSlice::from(u8"e")].getSize() == 0uz);
+		REQUIRE(root[vx::StringSlice::from(u8"f")].getMembers().begin() == root[vx::StringSlice::from(u8"f")].getMembers().end());
+		REQUIRE(!root[vx::StringSlice::from(u8"c")].asString());
+		REQUIRE(!root[vx::StringSlice::from(u8"d")].asNumber());
+		REQUIRE(!root[vx::StringSlice::from(u8"a")].asBoolean());
+	}
+
+	SECTION("strings point into the text") {
+		const std::u8string text {u8R"(["first", {"key": "second"}])"};
+		const std::optional<vx::json::Document> document {parse(text)};
+		REQUIRE(document);
+		const auto first {*document->getRoot()[0uz].asString()};
+		REQUIRE(first.begin() == text.data() + 2);
+		REQUIRE(first.size() == 5uz);
+		const auto second {*document->getRoot()[1uz][vx::StringSlice::from(u8"key")].asString()};
+		REQUIRE(second.begin() == text.data() + 19);
+	}
+}
+
+TEST_CASE("json - lookups", "[json]") {
+	const std::u8string text {u8R"({
+		"name": "cave",
+		"size": [64, 48],
+		"layers": [
+			{"name": "ground", "tiles": [1, 2, 3, {"nested": [[], [[]]]}], "visible": true},
+			{"name": "props", "tiles": [], "visible": false}
+		],
+		"properties": {"gravity": -9.81, "music": "drips.ogg"}
+	})"};
+	const std::optional<vx::json::Document> document {parse(text)};
+	REQUIRE(document);
+	const vx::json::Value root {document->getRoot()};
+
+	REQUIRE(root.getSize() == 4uz);
+	REQUIRE(toView(*root[vx::StringSlice::from(u8"name")].asString()) == u8"cave");
+	REQUIRE(root[vx::StringSlice::from(u8"size")][1uz].asInteger() == 48);
+	const vx::json::Value layers {root[vx::StringSlice::from(u8"layers")]};
+	REQUIRE(layers.getSize() == 2uz);
+	/* skips the whole first layer */
+	REQUIRE(toView(*layers[1uz][vx::StringSlice::from(u8"name")].asString()) == u8"props");
+	REQUIRE(layers[0uz][vx::StringSlice::from(u8"visible")].asBoolean() == true);
+	REQUIRE(layers[0uz][vx::StringSlice::from(u8"tiles")][3uz][vx::StringSlice::from(u8"nested")][1uz][0uz].getSize() == 0uz);
+	REQUIRE(root[vx::StringSlice::from(u8"properties")][vx::StringSlice::from(u8"gravity")].asNumber() == -9.81);
+
+	std::vector<std::u8string_view> keys {};
+	for (const vx::json::Member member : root.getMembers())
+		keys.push_back(toView(member.key));
+	REQUIRE(keys == std::vector<std::u8string_view>{u8"name", u8"size", u8"layers", u8"properties"});
+	std::vector<std::int64_t> tiles {};
+	for (const vx::json::Value tile : layers[0uz][vx::StringSlice::from(u8"tiles")].getElements()) {
+		if (tile.asInteger())
+			tiles.push_back(*tile.asInteger());
+	}
+	REQUIRE(tiles == std::vector<std::int64_t>{1, 2, 3});
+
+	SECTION("missing values") {
+		REQUIRE(!root[vx::StringSlice::from(u8"missing")].isValid());
+		REQUIRE(!root[vx::StringSlice::from(u8"missing")][0uz][vx::StringSlice::from(u8"deeper")].isValid());
+		REQUIRE(!root[vx::StringSlice::from(u8"size")][2uz].isValid());
+		REQUIRE(!root[vx::StringSlice::from(u8"size")][vx::StringSlice::from(u8"name")].isValid());
+		REQUIRE(!root[0uz].isValid());
+		REQUIRE(!root[vx::StringSlice::from(u8"name")][0uz].isValid());
+		REQUIRE(root[vx::StringSlice::from(u8"missing")].getType() == vx::json::Type::null);
+		REQUIRE(root[vx::StringSlice::from(u8"missing")].getSize() == 0uz);
+		REQUIRE(root[vx::StringSlice::from(u8"name")].getElements().begin() == root[vx::StringSlice::from(u8"name")].getElements().end());
+		REQUIRE(!vx::json::Value{}.asNumber());
+	}
+}
+
+TEST_CASE("json - escapes", "[json]") {
+	const std::u8string text {u8R"({"quote\"d": "a\"b\\c\/d\b\f\n\r\t", "unicode": "\u00e9\u4e2d\ud83d\ude00\u0041", "plain": "x"})"};
+	const std::optional<vx::json::Document> document {parse(text)};
+	REQUIRE(document);
+	const vx::json::Value root {document->getRoot()};
+
+	const vx::json::Value quoted {root[vx::StringSlice::from(u8"quote\"d")]};
+	REQUIRE(quoted.hasEscapes());
+	REQUIRE(toView(*quoted.asString()) == u8R"(a\"b\\c\/d\b\f\n\r\t)");
+	const std::optional<vx::String> decoded {quoted.unescape()};
+	REQUIRE(decoded);
+	REQUIRE(std::ranges::equal(*decoded, std::u8string_view{u8"a\"b\\c/d\b\f\n\r\t"}));
+
+	const std::optional<vx::String> unicode {root[vx::StringSlice::from(u8"unicode")].unescape()};
+	REQUIRE(unicode);
+	REQUIRE(std::ranges::equal(*unicode, std::u8string_view{u8"é中😀A"}));
+
+	const vx::json::Value plain {root[vx::StringSlice::from(u8"plain")]};
+	REQUIRE(!plain.hasEscapes());
+	REQUIRE(std::ranges::equal(*plain.unescape(), std::u8string_view{u8"x"}));
+	REQUIRE(!root.unescape());
+
+	SECTION("backslashes across blocks") {
+		for (std::size_t padding {0uz}; padding < 70uz; ++padding) {
+			for (std::size_t backslashes {1uz}; backslashes <= 4uz; ++backslashes) {
+				/* an odd run of backslashes escapes the quote after it, wherever the block boundary falls */
+				std::u8string string (padding, u8'a');
+				string.append(backslashes * 2uz, u8'\\');
+				string += u8"\\\"";
+				const std::u8string json {u8"[\"" + string + u8"\", 1]"};
+				const std::optional<vx::json::Document> padded {parse(json)};
+				REQUIRE(padded);
+				REQUIRE(toView(*padded->getRoot()[0uz].asString()) == string);
+				REQUIRE(padded->getRoot()[1uz].asInteger() == 1);
+				REQUIRE(padded->getRoot()[0uz].unescape()->getSize() == padding + backslashes + 1uz);
+			}
+		}
+	}
+}
+
+TEST_CASE("json - generated documents", "[json]") {
+	const std::uint32_t seed {GENERATE(range(0u, 200u))};
+	Generator generator {seed};
+	std::u8string text {};
+	const Expected expected {generator.generate(text, 0u)};
+	const std::optional<vx::json::Document> document {parse(text)};
+	REQUIRE(document);
+	REQUIRE(matches(document->getRoot(), expected));
+}
+
+TEST_CASE("json - invalid documents", "[json]") {
+	const std::u8string text {GENERATE(as<std::u8string>{},
+		u8"",
+		u8"   ",
+		u8"{",
+		u8"[",
+		u8"]",
+		u8"[1,]",
+		u8"[,1]",
+		u8"[1 2]",
+		u8"[1]]",
+		u8"1 2",
+		u8"{\"a\" 1}",
+		u8"{\"a\":}",
+		u8"{\"a\":1,}",
+		u8"{1:2}",
+		u8"{\"a\":1 \"b\":2}",
+		u8"[\"a\"\"b\"]",
+		u8"[\"a\"1]",
+		u8"01",
+		u8"-01",
+		u8"1.",
+		u8".5",
+		u8"-",
+		u8"+1",
+		u8"1e",
+		u8"1e+",
+		u8"1x",
+		u8"0x10",
+		u8"1e400",
+		u8"inf",
+		u8"NaN",
+		u8"tru",
+		u8"truex",
+		u8"nul",
+		u8"True",
+		u8"\"abc",
+		u8"\"a\\x\"",
+		u8"\"a\\\"",
+		u8"\"\\u12G4\"",
+		u8"\"\\u12\"",
+		u8"\"\\ud800\"",
+		u8"\"\\ud800\\u0041\"",
+		u8"\"\\udc00\"",
+		u8"\"a\tb\"",
+		u8"\"a\nb\"",
+		u8"\\\"a\""
+	)};
+	REQUIRE(!parse(text));
+}
+
+TEST_CASE("json - fuzzed documents", "[json]") {
+	Generator generator {99u};
+	std::u8string text {};
+	(void)generator.generate(text, 0u);
+	const std::u8string source {u8"[" + text + u8", {\"escaped\": \"\\u00e9\\n\"}, -1.5e3]"};
+	REQUIRE(parse(source));
+	std::mt19937 random {5u};
+	for (std::size_t i {0uz}; i < 2000uz; ++i) {
+		std::u8string bytes {source};
+		for (std::size_t j {0uz}; j < 1uz + i % 3uz; ++j)
+			bytes[random() % bytes.size()] = static_cast<char8_t> (u8" \"\\{}[]:,0e-tu\t"[random() % 16u]);
+		/* must be safe, walking whatever parsed */
+		const std::optional<vx::json::Document> document {parse(bytes)};
+		if (document) {
+			for (const vx::json::Value value : document->getRoot().getElements())
+				(void)value.unescape();
+		}
+	}
+}
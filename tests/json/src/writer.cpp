@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/json/document.hpp>
+#include <voxlet/json/writer.hpp>
+
+
+namespace {
+	template <std::size_t bufferSize, bool hasInnerStorage>
+	auto toStdString(const vx::containers::BasicStringAccumulator<bufferSize, hasInnerStorage>& output) -> std::u8string {
+		std::u8string string {};
+		output.forEachSegment([&](const std::span<const char8_t> segment) {
+			string.append(segment.begin(), segment.end());
+		});
+		return string;
+	}
+
+	auto toSlice(const std::u8string_view string) -> vx::StringSlice {
+		return vx::StringSlice::from(string.data(), string.size());
+	}
+
+	template <typename Writer>
+	auto writeSprite(Writer& writer) -> void {
+		writer.beginObject();
+		writer.writeKey(u8"name");
+		writer.write(u8"crate");
+		writer.writeKey(u8"size");
+		writer.beginArray();
+		writer.write(16);
+		writer.write(-48);
+		writer.endArray();
+		writer.writeKey(u8"ratio");
+		writer.write(0.5);
+		writer.writeKey(u8"solid");
+		writer.write(true);
+		writer.writeKey(u8"loot");
+		writer.writeNull();
+		writer.writeKey(u8"tags");
+		writer.beginArray();
+		writer.endArray();
+		writer.writeKey(u8"frames");
+		writer.beginArray();
+		writer.beginObject();
+		writer.writeKey(u8"duration");
+		writer.write(100u);
+		writer.endObject();
+		writer.beginObject();
+		writer.endObject();
+		writer.endArray();
+		writer.endObject();
+	}
+}
+
+
+TEST_CASE("json - writer layout", "[json]") {
+	SECTION("compact") {
+		vx::containers::StringAccumulator output {};
+		vx::json::Writer writer {output};
+		REQUIRE(!writer.isComplete());
+		writeSprite(writer);
+		REQUIRE(writer.isComplete());
+		REQUIRE(toStdString(output) == std::u8string_view{
+			u8R"({"name":"crate","size":[16,-48],"ratio":0.5,"solid":true,"loot":null,"tags":[],"frames":[{"duration":100},{}]})"
+		});
+	}
+
+	SECTION("pretty") {
+		vx::containers::StringAccumulator output {};
+		vx::json::Writer writer {output, vx::json::Style::pretty};
+		writeSprite(writer);
+		REQUIRE(toStdString(output) == std::u8string_view{
+			u8"{\n"
+			u8"\t\"name\": \"crate\",\n"
+			u8"\t\"size\": [\n"
+			u8"\t\t16,\n"
+			u8"\t\t-48\n"
+			u8"\t],\n"
+			u8"\t\"ratio\": 0.5,\n"
+			u8"\t\"solid\": true,\n"
+			u8"\t\"loot\": null,\n"
+			u8"\t\"tags\": [],\n"
+			u8"\t\"frames\": [\n"
+			u8"\t\t{\n"
+			u8"\t\t\t\"duration\": 100\n"
+			u8"\t\t},\n"
+			u8"\t\t{}\n"
+			u8"\t]\n"
+			u8"}"
+		});
+	}
+
+	SECTION("scalar root") {
+		vx::containers::StringAccumulator output {};
+		vx::json::Writer writer {output, vx::json::Style::pretty};
+		writer.write(std::numeric_limits<double>::quiet_NaN());
+		REQUIRE(writer.isComplete());
+		REQUIRE(toStdString(output) == std::u8string_view{u8"null"});
+	}
+}
+
+TEST_CASE("json - writer values", "[json]") {
+	SECTION("escapes") {
+		vx::containers::StringAccumulator output {};
+		vx::json::Writer writer {output};
+		writer.write(u8"a \"quoted\" C:\\path\n\t\x01\x1f caf\u00e9");
+		REQUIRE(toStdString(output) == std::u8string_view{u8R"("a \"quoted\" C:\\path\n\t\u0001\u001f café")"});
+	}
+
+	SECTION("escapes at every offset") {
+		/* around and across the 32 bytes scanned at a time */
+		for (std::size_t offset {0uz}; offset < 80uz; ++offset) {
+			for (const char8_t special : {u8'"', u8'\\', u8'\n', u8'\x1b'}) {
+				std::u8string text (80uz, u8'x');
+				text[offset] = special;
+				vx::containers::StringAccumulator output {};
+				vx::json::Writer writer {output};
+				writer.write(toSlice(text));
+				const std::u8string written {toStdString(output)};
+				const std::optional<vx::json::Document> document {vx::json::Document::parse(toSlice(written))};
+				REQUIRE(document);
+				const std::optional<vx::String> unescaped {document->getRoot().unescape()};
+				REQUIRE(unescaped);
+				REQUIRE(std::ranges::equal(*unescaped, text));
+			}
+		}
+	}
+
+	SECTION("numbers") {
+		vx::containers::StringAccumulator output {};
+		vx::json::Writer writer {output};
+		std::mt19937_64 random {7u};
+		std::vector<double> numbers {0.1, -0.0, 1e300, -2.2250738585072014e-308, 123456789.0, 5e-324};
+		for (std::size_t i {0uz}; i < 1000uz; ++i)
+			numbers.push_back(std::bit_cast<double> (random()));
+		std::erase_if(numbers, [](const double number) {return !std::isfinite(number);});
+
+		writer.beginArray();
+		writer.write(std::numeric_limits<std::int64_t>::min());
+		writer.write(std::numeric_limits<std::int64_t>::max());
+		writer.write(std::numeric_limits<std::uint64_t>::max());
+		writer.write(static_cast<std::int8_t> (-7));
+		writer.write(std::numeric_limits<double>::infinity());
+		for (const double number : numbers)
+			writer.write(number);
+		writer.endArray();
+
+		const std::u8string written {toStdString(output)};
+		const std::optional<vx::json::Document> document {vx::json::Document::parse(toSlice(written))};
+		REQUIRE(document);
+		const vx::json::Value root {document->getRoot()};
+		REQUIRE(root[0uz].asInteger() == std::numeric_limits<std::int64_t>::min());
+		REQUIRE(root[1uz].asInteger() == std::numeric_limits<std::int64_t>::max());
+		REQUIRE(root[2uz].asNumber() == static_cast<double> (std::numeric_limits<std::uint64_t>::max()));
+		REQUIRE(root[3uz].asInteger() == -7);
+		REQUIRE(root[4uz].getType() == vx::json::Type::null);
+		/* the shortest text reads back to the same bits */
+		for (std::size_t i {0uz}; i < numbers.size(); ++i)
+			REQUIRE(std::bit_cast<std::uint64_t> (*root[i + 5uz].asNumber()) == std::bit_cast<std::uint64_t> (numbers[i]));
+	}
+}
+
+TEST_CASE("json - writer streaming", "[json]") {
+	const vx::json::Style style {GENERATE(vx::json::Style::compact, vx::json::Style::pretty)};
+	const auto writeLevel {[](auto& writer, const auto& onObject) {
+		writer.beginObject();
+		writer.writeKey(u8"objects");
+		writer.beginArray();
+		for (std::uint32_t i {0u}; i < 2000u; ++i) {
+			writer.beginObject();
+			writer.writeKey(u8"id");
+			writer.write(i);
+			writer.writeKey(u8"name");
+			writer.write(u8"torch \"lit\"");
+			writer.writeKey(u8"x");
+			writer.write(static_cast<double> (i) * 0.25);
+			writer.endObject();
+			onObject();
+		}
+		writer.endArray();
+		writer.endObject();
+	}};
+
+	vx::containers::StringAccumulator whole {};
+	vx::json::Writer wholeWriter {whole, style};
+	writeLevel(wholeWriter, [] {});
+
+	/* what saving to a file would do, the segments written out whenever enough of them are filled */
+	vx::containers::BasicStringAccumulator<64uz, false> output {};
+	vx::json::BasicWriter<64uz, false> writer {output, style};
+	std::u8string streamed {};
+	std::size_t flushCount {0uz};
+	const auto flush {[&] {
+		output.forEachSegment([&](const std::span<const char8_t> segment) {
+			streamed.append(segment.begin(), segment.end());
+		});
+		output.clear();
+		++flushCount;
+	}};
+	writeLevel(writer, [&] {
+		if (output.getSize() >= 1024uz)
+			flush();
+	});
+	flush();
+
+	REQUIRE(writer.isComplete());
+	REQUIRE(flushCount > 10uz);
+	REQUIRE(streamed == toStdString(whole));
+	REQUIRE(vx::json::Document::parse(toSlice(streamed)));
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/jobs/parallelFor.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/render/commandBuffer.hpp>
+#include <voxlet/render/glStateCache.hpp>
+#include <voxlet/render/glStub.hpp>
+
+
+namespace {
+	auto makeDraw(const GLuint program, const GLuint texture, const GLint first) noexcept -> vx::render::DrawCommand {
+		return vx::render::DrawCommand{
+			.state = vx::render::RenderState{
+				.program = program,
+				.vertexArray = 1u,
+				.textures = {{{GL_TEXTURE_2D, texture}, {0u, 0u}, {0u, 0u}, {0u, 0u}}},
+				.blendSource = GL_ONE,
+				.blendDestination = GL_ONE_MINUS_SRC_ALPHA,
+				.blend = false,
+				.depthTest = true
+			},
+			.mode = GL_TRIANGLES,
+			.first = first,
+			.count = 6,
+			.instanceCount = 1,
+			.baseInstance = 0u
+		};
+	}
+
+	auto getFirst(const vx::render::SortEntry& entry) noexcept -> GLint {
+		/* skips the header, which is padded to the alignment of the command */
+		return reinterpret_cast<const vx::render::DrawCommand*> (entry.value + alignof(vx::render::DrawCommand))->first;
+	}
+}
+
+
+TEST_CASE("render-command-buffer", "[render]") {
+	vx::render::CommandBuffer buffer {};
+	REQUIRE(buffer.empty());
+	REQUIRE(buffer.isSorted());
+
+	buffer.draw(3u, makeDraw(1u, 1u, 0));
+	buffer.draw(1u, makeDraw(1u, 1u, 1));
+	buffer.draw(3u, makeDraw(1u, 1u, 2));
+	buffer.draw(2u, makeDraw(1u, 1u, 3));
+	REQUIRE(buffer.size() == 4uz);
+	REQUIRE(!buffer.isSorted());
+	buffer.sort();
+	REQUIRE(buffer.isSorted());
+
+	const auto entries {buffer.getEntries()};
+	REQUIRE(std::ranges::is_sorted(entries, {}, &vx::render::SortEntry::key));
+	std::vector<GLint> order {};
+	for (const auto& entry : entries)
+		order.push_back(getFirst(entry));
+	REQUIRE(order == std::vector<GLint> {1, 3, 0, 2});
+
+	/* more commands than a block holds */
+	buffer.clear();
+	REQUIRE(buffer.empty());
+	constexpr std::size_t COUNT {10'000uz};
+	for (std::size_t i {0uz}; i < COUNT; ++i)
+		buffer.draw(i, makeDraw(1u, 1u, static_cast<GLint> (i)));
+	REQUIRE(buffer.isSorted());
+	for (std::size_t i {0uz}; i < COUNT; ++i)
+		REQUIRE(getFirst(buffer.getEntries()[i]) == static_cast<GLint> (i));
+}
+
+
+TEST_CASE("render-command-queue-merge", "[render]") {
+	const std::size_t workerCount {GENERATE(0uz, 3uz)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+	std::vector<std::unique_ptr<vx::render::CommandBuffer>> buffers {};
+	std::vector<vx::render::CommandBuffer*> pointers {};
+	for (std::size_t i {0uz}; i < scheduler.getThreadCount(); ++i) {
+		buffers.push_back(std::make_unique<vx::render::CommandBuffer> ());
+		pointers.push_back(buffers.back().get());
+	}
+
+	/* few distinct keys, so that ties are common */
+	constexpr std::size_t COUNT {20'000uz};
+	vx::jobs::parallelFor(scheduler, 0uz, COUNT, [&buffers, &scheduler](const std::size_t first, const std::size_t last) noexcept {
+		vx::render::CommandBuffer& buffer {*buffers[scheduler.getCurrentThreadIndex()]};
+		for (std::size_t i {first}; i < last; ++i)
+			buffer.draw((i * 2'654'435'761uz) % 64uz, makeDraw(1u, 1u, static_cast<GLint> (i)));
+	});
+	vx::jobs::parallelFor(scheduler, 0uz, buffers.size(), [&buffers](const std::size_t first, const std::size_t last) noexcept {
+		for (std::size_t i {first}; i < last; ++i)
+			buffers[i]->sort();
+	}, 1uz);
+
+	std::vector<vx::render::SortEntry> expected {};
+	for (const auto& buffer : buffers)
+		expected.insert(expected.end(), buffer->getEntries().begin(), buffer->getEntries().end());
+	std::ranges::stable_sort(expected, {}, &vx::render::SortEntry::key);
+
+	vx::render::CommandQueue queue {};
+	queue.merge(pointers);
+	const auto entries {queue.getEntries()};
+	REQUIRE(entries.size() == COUNT);
+	for (std::size_t i {0uz}; i < COUNT; ++i) {
+		REQUIRE(entries[i].key == expected[i].key);
+		REQUIRE(entries[i].value == expected[i].value);
+	}
+
+	/* merging reuses the queue */
+	for (auto& buffer : buffers)
+		buffer->clear();
+	buffers.front()->draw(7u, makeDraw(1u, 1u, 0));
+	queue.merge(pointers);
+	REQUIRE(queue.getEntries().size() == 1uz);
+	REQUIRE(queue.getEntries()[0].key == 7u);
+}
+
+
+TEST_CASE("render-command-queue-execute", "[render]") {
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	vx::render::GlStateCache state {};
+
+	vx::render::CommandBuffer opaque {};
+	vx::render::CommandBuffer setup {};
+	opaque.draw(10u, makeDraw(2u, 5u, 2));
+	opaque.draw(10u, makeDraw(2u, 6u, 3));
+	opaque.draw(5u, makeDraw(1u, 5u, 1));
+	opaque.drawIndexed(20u, vx::render::DrawIndexedCommand{
+		.state = makeDraw(2u, 6u, 0).state,
+		.mode = GL_TRIANGLES,
+		.count = 36,
+		.indexType = GL_UNSIGNED_SHORT,
+		.indexOffset = 128uz,
+		.instanceCount = 4,
+		.baseVertex = 8,
+		.baseInstance = 2u
+	});
+	setup.setViewport(0u, vx::render::ViewportCommand{0, 0, 320, 180});
+	setup.clearFramebuffer(0u, vx::render::ClearCommand{
+		.color = {0.f, 0.f, 0.f, 1.f},
+		.depth = 1.f,
+		.mask = GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT
+	});
+	opaque.sort();
+	setup.sort();
+
+	vx::render::CommandQueue queue {};
+	const std::array<vx::render::CommandBuffer*, 2> buffers {&opaque, &setup};
+	state.beginFrame();
+	queue.submit(buffers, state);
+
+	std::vector<std::string_view> draws {};
+	for (const auto& call : stub.getCalls()) {
+		if (call.name.starts_with("glDraw") || call.name == "glClear" || call.name == "glViewport")
+			draws.push_back(call.name);
+	}
+	REQUIRE(draws == std::vector<std::string_view> {
+		"glViewport",
+		"glClear",
+		"glDrawArraysInstancedBaseInstance",
+		"glDrawArraysInstancedBaseInstance",
+		"glDrawArraysInstancedBaseInstance",
+		"glDrawElementsInstancedBaseVertexBaseInstance"
+	});
+	REQUIRE(stub.getCallCount("glUseProgram") == 2uz);
+	REQUIRE(stub.getCallCount("glBindVertexArray") == 1uz);
+	REQUIRE(stub.getCallCount("glBindTexture") == 2uz);
+	REQUIRE(stub.getCallCount("glActiveTexture") == 1uz);
+	REQUIRE(stub.getCallCount("glEnable") == 1uz);
+	REQUIRE(stub.getCallCount("glDisable") == 1uz);
+	REQUIRE(stub.getCallCount("glBlendFunc") == 0uz);
+	REQUIRE(state.getStats().elidedCount > 0uz);
+
+	const auto& indexed {stub.getCalls().back()};
+	REQUIRE(indexed.name == "glDrawElementsInstancedBaseVertexBaseInstance");
+	REQUIRE(indexed.arguments[1] == 36u);
+	REQUIRE(indexed.arguments[3] == 128u);
+	REQUIRE(indexed.arguments[4] == 4u);
+	REQUIRE(indexed.arguments[5] == 8u);
+	REQUIRE(indexed.arguments[6] == 2u);
+}
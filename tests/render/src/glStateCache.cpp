@@ -0,0 +1,245 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <voxlet/render/glStateCache.hpp>
+#include <voxlet/render/glStub.hpp>
+
+
+namespace {
+	/* the state a draw sees, rebuilt from a recording */
+	struct State {
+		std::uint64_t program;
+		std::uint64_t vertexArray;
+		std::uint64_t activeTexture;
+		std::map<std::pair<std::uint64_t, std::uint64_t>, std::uint64_t> textures;
+		std::map<std::uint64_t, std::uint64_t> buffers;
+		std::map<std::uint64_t, std::uint64_t> elementBuffers;
+		std::map<std::uint64_t, bool> capabilities;
+		std::array<std::uint64_t, 2> blendFunc;
+		std::array<std::uint64_t, 4> viewport;
+
+		auto operator==(const State&) const -> bool = default;
+	};
+
+	auto simulate(const std::span<const vx::render::GlStub::Call> calls) -> std::vector<State> {
+		std::vector<State> draws {};
+		State state {};
+		for (const auto& call : calls) {
+			const auto& arguments {call.arguments};
+			if (call.name == "glUseProgram")
+				state.program = arguments[0];
+			else if (call.name == "glBindVertexArray")
+				state.vertexArray = arguments[0];
+			else if (call.name == "glBindBuffer" && arguments[0] == GL_ELEMENT_ARRAY_BUFFER)
+				state.elementBuffers[state.vertexArray] = arguments[1];
+			else if (call.name == "glBindBuffer")
+				state.buffers[arguments[0]] = arguments[1];
+			else if (call.name == "glActiveTexture")
+				state.activeTexture = arguments[0];
+			else if (call.name == "glBindTexture")
+				state.textures[{state.activeTexture, arguments[0]}] = arguments[1];
+			else if (call.name == "glEnable" || call.name == "glDisable")
+				state.capabilities[arguments[0]] = call.name == "glEnable";
+			else if (call.name == "glBlendFunc")
+				state.blendFunc = {arguments[0], arguments[1]};
+			else if (call.name == "glViewport")
+				state.viewport = {arguments[0], arguments[1], arguments[2], arguments[3]};
+			else if (call.name == "glDrawArrays")
+				draws.push_back(state);
+		}
+		return draws;
+	}
+
+	auto replay(const std::span<const vx::render::GlStub::Call> calls, vx::render::GlStateCache& cache) -> void {
+		for (const auto& call : calls) {
+			const auto& arguments {call.arguments};
+			const auto name {[&arguments](const std::size_t index) {return static_cast<GLuint> (arguments[index]);}};
+			const auto integer {[&arguments](const std::size_t index) {return static_cast<GLint> (arguments[index]);}};
+			if (call.name == "glUseProgram")
+				cache.useProgram(name(0uz));
+			else if (call.name == "glBindVertexArray")
+				cache.bindVertexArray(name(0uz));
+			else if (call.name == "glBindBuffer")
+				cache.bindBuffer(name(0uz), name(1uz));
+			else if (call.name == "glActiveTexture")
+				cache.activeTexture(name(0uz));
+			else if (call.name == "glBindTexture")
+				cache.bindTexture(name(0uz), name(1uz));
+			else if (call.name == "glEnable" || call.name == "glDisable")
+				cache.setEnabled(name(0uz), call.name == "glEnable");
+			else if (call.name == "glBlendFunc")
+				cache.blendFunc(name(0uz), name(1uz));
+			else if (call.name == "glViewport")
+				cache.viewport(integer(0uz), integer(1uz), integer(2uz), integer(3uz));
+			else if (call.name == "glDrawArrays")
+				glDrawArrays(name(0uz), integer(1uz), integer(2uz));
+		}
+	}
+
+	/* a frame from an engine which sets everything a draw needs before each draw */
+	auto drawNaiveFrame(std::mt19937& random, const std::size_t drawCount) -> void {
+		glViewport(0, 0, 1920, 1080);
+		for (std::size_t i {0uz}; i < drawCount; ++i) {
+			const bool blend {random() % 8u == 0u};
+			if (blend)
+				glEnable(GL_BLEND);
+			else
+				glDisable(GL_BLEND);
+			glEnable(GL_DEPTH_TEST);
+			glBlendFunc(GL_SRC_ALPHA, blend ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+			glUseProgram(static_cast<GLuint> (1u + random() % 3u));
+			glBindVertexArray(static_cast<GLuint> (1u + random() % 2u));
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLuint> (10u + random() % 2u));
+			glBindBuffer(GL_UNIFORM_BUFFER, 20u);
+			for (GLenum unit {0u}; unit < 2u; ++unit) {
+				glActiveTexture(GL_TEXTURE0 + unit);
+				glBindTexture(GL_TEXTURE_2D, static_cast<GLuint> (100u + unit * 10u + random() % 4u));
+			}
+			glActiveTexture(GL_TEXTURE0);
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+		}
+	}
+}
+
+
+TEST_CASE("gl-state-cache", "[render]") {
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	vx::render::GlStateCache cache {};
+
+	SECTION("elision") {
+		cache.useProgram(3u);
+		cache.useProgram(3u);
+		cache.useProgram(0u);
+		cache.useProgram(0u);
+		REQUIRE(stub.getCallCount("glUseProgram") == 2uz);
+		REQUIRE(cache.getStats().issuedCount == 2uz);
+		REQUIRE(cache.getStats().elidedCount == 2uz);
+
+		cache.setEnabled(GL_BLEND, true);
+		cache.setEnabled(GL_BLEND, true);
+		cache.setEnabled(GL_BLEND, false);
+		REQUIRE(stub.getCallCount("glEnable") == 1uz);
+		REQUIRE(stub.getCallCount("glDisable") == 1uz);
+		cache.viewport(0, 0, 640, 480);
+		cache.viewport(0, 0, 640, 480);
+		cache.blendFunc(GL_ONE, GL_ZERO);
+		cache.blendFunc(GL_ONE, GL_ONE);
+		REQUIRE(stub.getCallCount("glViewport") == 1uz);
+		REQUIRE(stub.getCallCount("glBlendFunc") == 2uz);
+
+		cache.beginFrame();
+		REQUIRE(cache.getStats().issuedCount == 0uz);
+		REQUIRE(cache.getStats().elidedCount == 0uz);
+		cache.useProgram(0u);
+		REQUIRE(cache.getStats().elidedCount == 1uz);
+
+		/* untracked capabilities are always forwarded */
+		cache.setEnabled(GL_DEBUG_OUTPUT, true);
+		cache.setEnabled(GL_DEBUG_OUTPUT, true);
+		REQUIRE(stub.getCallCount("glEnable") == 3uz);
+	}
+
+	SECTION("textures") {
+		/* the unit isn't known yet */
+		cache.bindTexture(GL_TEXTURE_2D, 5u);
+		cache.bindTexture(GL_TEXTURE_2D, 5u);
+		REQUIRE(stub.getCallCount("glBindTexture") == 2uz);
+
+		cache.activeTexture(GL_TEXTURE0);
+		cache.bindTexture(GL_TEXTURE_2D, 5u);
+		cache.bindTexture(GL_TEXTURE_2D, 5u);
+		cache.bindTexture(GL_TEXTURE_2D_ARRAY, 5u);
+		cache.activeTexture(GL_TEXTURE1);
+		cache.bindTexture(GL_TEXTURE_2D, 5u);
+		cache.activeTexture(GL_TEXTURE0);
+		cache.bindTexture(GL_TEXTURE_2D, 5u);
+		REQUIRE(stub.getCallCount("glBindTexture") == 5uz);
+		REQUIRE(stub.getCallCount("glActiveTexture") == 3uz);
+
+		/* deleting a texture unbinds it from every unit */
+		cache.forgetTexture(5u);
+		cache.bindTexture(GL_TEXTURE_2D, 0u);
+		cache.bindTexture(GL_TEXTURE_2D, 5u);
+		REQUIRE(stub.getCallCount("glBindTexture") == 6uz);
+	}
+
+	SECTION("buffers") {
+		cache.bindVertexArray(1u);
+		cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 7u);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 7u);
+		cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 7u);
+		REQUIRE(stub.getCallCount("glBindBuffer") == 2uz);
+
+		/* the element array binding follows the vertex array, the others don't */
+		cache.bindVertexArray(2u);
+		cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 7u);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 7u);
+		REQUIRE(stub.getCallCount("glBindBuffer") == 3uz);
+
+		cache.forgetBuffer(7u);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 0u);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 7u);
+		REQUIRE(stub.getCallCount("glBindBuffer") == 4uz);
+
+		cache.forgetVertexArray(2u);
+		cache.bindVertexArray(0u);
+		REQUIRE(stub.getCallCount("glBindVertexArray") == 2uz);
+
+		cache.invalidate();
+		cache.bindVertexArray(0u);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 7u);
+		REQUIRE(stub.getCallCount("glBindVertexArray") == 3uz);
+		REQUIRE(stub.getCallCount("glBindBuffer") == 5uz);
+	}
+}
+
+
+TEST_CASE("gl-state-cache-replay", "[render]") {
+	constexpr std::size_t FRAME_COUNT {3uz};
+	constexpr std::size_t DRAW_COUNT {500uz};
+
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+
+	/* capture naive frames, then replay them through the cache */
+	std::mt19937 random {42u};
+	std::vector<std::vector<vx::render::GlStub::Call>> frames {};
+	for (std::size_t i {0uz}; i < FRAME_COUNT; ++i) {
+		stub.clearCalls();
+		drawNaiveFrame(random, DRAW_COUNT);
+		frames.emplace_back(stub.getCalls().begin(), stub.getCalls().end());
+	}
+
+	vx::render::GlStateCache cache {};
+	std::vector<vx::render::GlStub::Call> captured {};
+	std::vector<vx::render::GlStub::Call> replayed {};
+	for (const auto& frame : frames) {
+		stub.clearCalls();
+		cache.beginFrame();
+		replay(frame, cache);
+
+		const std::size_t drawCount {stub.getCallCount("glDrawArrays")};
+		REQUIRE(drawCount == DRAW_COUNT);
+		REQUIRE(cache.getStats().issuedCount == stub.getCalls().size() - drawCount);
+		REQUIRE(cache.getStats().issuedCount + cache.getStats().elidedCount == frame.size() - drawCount);
+		REQUIRE(cache.getStats().elidedCount > cache.getStats().issuedCount);
+
+		captured.insert(captured.end(), frame.begin(), frame.end());
+		replayed.insert(replayed.end(), stub.getCalls().begin(), stub.getCalls().end());
+	}
+
+	/* every draw sees the state it was captured with */
+	const auto expected {simulate(captured)};
+	const auto actual {simulate(replayed)};
+	REQUIRE(expected.size() == FRAME_COUNT * DRAW_COUNT);
+	REQUIRE(actual == expected);
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/render/image.hpp>
+#include <voxlet/render/softwareRenderer.hpp>
+
+
+namespace {
+	auto makeSprite(
+		const float x,
+		const float y,
+		const float width,
+		const float height,
+		const GLuint texture,
+		const std::uint32_t color = 0xffff'ffffu,
+		const std::uint8_t layer = 0u
+	) noexcept -> vx::render::Sprite {
+		return vx::render::Sprite{
+			.x = x,
+			.y = y,
+			.width = width,
+			.height = height,
+			.u0 = 0.f,
+			.v0 = 0.f,
+			.u1 = 1.f,
+			.v1 = 1.f,
+			.color = color,
+			.depth = 0.f,
+			.program = 0u,
+			.texture = texture,
+			.layer = layer
+		};
+	}
+
+	auto makeChecker(const std::uint32_t size) noexcept -> vx::render::Image {
+		vx::render::Image image {size, size};
+		for (std::uint32_t y {0u}; y < size; ++y) {
+			for (std::uint32_t x {0u}; x < size; ++x)
+				image.getRow(y)[x] = 0xff00'0000u | y << 8u | x;
+		}
+		return image;
+	}
+}
+
+
+TEST_CASE("software-renderer - integer scaled blit", "[render]") {
+	const auto backend {GENERATE(vx::render::RasterBackend::scalar, vx::render::RasterBackend::avx2)};
+	vx::jobs::Scheduler scheduler {{.workerCount = 0uz}};
+	vx::render::SoftwareRenderer renderer {scheduler, {.backend = backend, .tileSize = 16u}};
+	const vx::render::Image checker {makeChecker(16u)};
+	const GLuint texture {renderer.registerTexture(checker)};
+	REQUIRE(texture == 1u);
+
+	vx::render::Image target {100u, 80u, 0xff20'2020u};
+	renderer.submit(makeSprite(3.f, 5.f, 48.f, 48.f, texture));
+	REQUIRE(renderer.getSubmittedCount() == 1uz);
+	renderer.build();
+	renderer.draw(target);
+	REQUIRE(renderer.getSubmittedCount() == 0uz);
+
+	for (std::uint32_t y {0u}; y < target.getHeight(); ++y) {
+		for (std::uint32_t x {0u}; x < target.getWidth(); ++x) {
+			const bool inside {x >= 3u && x < 51u && y >= 5u && y < 53u};
+			const std::uint32_t expected {inside ? checker.getPixel((x - 3u) / 3u, (y - 5u) / 3u) : 0xff20'2020u};
+			REQUIRE(target.getPixel(x, y) == expected);
+		}
+	}
+
+	/* a flipped sprite mirrors the texels */
+	vx::render::Sprite flipped {makeSprite(0.f, 0.f, 32.f, 16.f, texture)};
+	flipped.u0 = 1.f;
+	flipped.u1 = 0.f;
+	renderer.submit(flipped);
+	renderer.build();
+	renderer.draw(target);
+	for (std::uint32_t x {0u}; x < 32u; ++x)
+		REQUIRE(target.getPixel(x, 7u) == checker.getPixel(15u - x / 2u, 7u));
+}
+
+
+TEST_CASE("software-renderer - blending and palettes", "[render]") {
+	const auto backend {GENERATE(vx::render::RasterBackend::scalar, vx::render::RasterBackend::avx2)};
+	vx::jobs::Scheduler scheduler {{.workerCount = 0uz}};
+	vx::render::SoftwareRenderer renderer {scheduler, {.backend = backend, .tileSize = 64u}};
+
+	vx::render::Palette palette {};
+	for (std::size_t i {0uz}; i < palette.size(); ++i)
+		palette[i] = 0xff00'0000u | static_cast<std::uint32_t> (i) << 16u | static_cast<std::uint32_t> (255uz - i);
+	palette[0] = 0u;
+	vx::render::IndexedImage indexed {20u, 1u};
+	for (std::uint32_t x {0u}; x < 20u; ++x)
+		indexed.getIndices()[x] = static_cast<std::uint8_t> (x * 10u);
+	const GLuint texture {renderer.registerTexture(indexed, palette)};
+
+	vx::render::Image target {40u, 4u, 0xff00'ff00u};
+	/* half transparent red over green, then the palette on the next row, then a modulated fill */
+	renderer.submit(makeSprite(0.f, 0.f, 40.f, 1.f, 0u, 0x8000'00ffu));
+	renderer.submit(makeSprite(0.f, 1.f, 20.f, 1.f, texture));
+	renderer.submit(makeSprite(0.f, 2.f, 40.f, 1.f, 0u, 0x0000'00ffu));
+	renderer.submit(makeSprite(0.f, 3.f, 40.f, 1.f, texture, 0x80ff'ffffu));
+	renderer.build();
+	renderer.draw(target);
+
+	for (std::uint32_t x {0u}; x < 40u; ++x)
+		REQUIRE(target.getPixel(x, 0u) == 0xff00'7f80u);
+	REQUIRE(target.getPixel(0u, 1u) == 0xff00'ff00u);
+	for (std::uint32_t x {1u}; x < 20u; ++x)
+		REQUIRE(target.getPixel(x, 1u) == palette[x * 10u]);
+	REQUIRE(target.getPixel(25u, 1u) == 0xff00'ff00u);
+	for (std::uint32_t x {0u}; x < 40u; ++x)
+		REQUIRE(target.getPixel(x, 2u) == 0xff00'ff00u);
+	/* palette 20 at half alpha over green: red 235 * 128 / 255, green 255 * 127 / 255, blue 20 * 128 / 255 */
+	REQUIRE(target.getPixel(4u, 3u) == 0xff0a'7f76u);
+}
+
+
+TEST_CASE("software-renderer - tile layers", "[render]") {
+	const auto backend {GENERATE(vx::render::RasterBackend::scalar, vx::render::RasterBackend::avx2)};
+	vx::jobs::Scheduler scheduler {{.workerCount = 0uz}};
+	vx::render::SoftwareRenderer renderer {scheduler, {.backend = backend, .tileSize = 32u}};
+	/* a 2x2 tileset of 8x8 tiles */
+	const vx::render::Image tileset {makeChecker(16u)};
+	const GLuint texture {renderer.registerTexture(tileset)};
+
+	const std::vector<std::uint16_t> tiles {1u, 2u, 0u, 3u, 4u, 1u};
+	vx::render::Image target {64u, 48u, 0u};
+	renderer.submit(makeSprite(0.f, 0.f, 64.f, 48.f, 0u, 0xff00'00ffu, 0u));
+	renderer.submit(vx::render::TileLayer{
+		.tileset = texture,
+		.tileSize = 8u,
+		.columns = 3u,
+		.rows = 2u,
+		.tiles = tiles,
+		.x = -4,
+		.y = 2,
+		.scale = 2u,
+		.color = 0xffff'ffffu,
+		.layer = 1u
+	});
+	renderer.build();
+	renderer.draw(target);
+
+	for (std::uint32_t y {0u}; y < target.getHeight(); ++y) {
+		for (std::uint32_t x {0u}; x < target.getWidth(); ++x) {
+			const std::int32_t cellX {(static_cast<std::int32_t> (x) + 4) / 16};
+			const std::int32_t cellY {(static_cast<std::int32_t> (y) - 2) / 16};
+			std::uint32_t expected {0xff00'00ffu};
+			if (y >= 2u && cellX < 3 && cellY < 2) {
+				const std::uint16_t tile {tiles[static_cast<std::size_t> (cellY * 3 + cellX)]};
+				if (tile != 0u) {
+					const std::uint32_t texelX {(tile - 1u) % 2u * 8u + (x + 4u) % 16u / 2u};
+					const std::uint32_t texelY {(tile - 1u) / 2u * 8u + (y - 2u) % 16u / 2u};
+					expected = tileset.getPixel(texelX, texelY);
+				}
+			}
+			REQUIRE(target.getPixel(x, y) == expected);
+		}
+	}
+}
+
+
+TEST_CASE("software-renderer - backends", "[render]") {
+	const std::size_t workerCount {GENERATE(0uz, 3uz)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+	vx::render::SoftwareRenderer scalar {scheduler, {.backend = vx::render::RasterBackend::scalar, .tileSize = 64u}};
+	vx::render::SoftwareRenderer avx2 {scheduler, {.backend = vx::render::RasterBackend::avx2, .tileSize = 32u}};
+
+	std::mt19937 random {42u};
+	vx::render::Image texture {makeChecker(32u)};
+	for (std::uint32_t& pixel : texture.getPixels())
+		pixel = static_cast<std::uint32_t> (random());
+	vx::render::IndexedImage indexed {13u, 7u};
+	for (std::uint8_t& index : indexed.getIndices())
+		index = static_cast<std::uint8_t> (random());
+	vx::render::Palette palette {};
+	for (std::uint32_t& color : palette)
+		color = static_cast<std::uint32_t> (random());
+	REQUIRE(scalar.registerTexture(texture) == avx2.registerTexture(texture));
+	REQUIRE(scalar.registerTexture(indexed, palette) == avx2.registerTexture(indexed, palette));
+
+	std::vector<vx::render::Sprite> sprites {};
+	std::uniform_real_distribution<float> position {-40.f, 200.f};
+	std::uniform_real_distribution<float> size {1.f, 90.f};
+	std::uniform_real_distribution<float> coordinate {0.f, 1.f};
+	for (std::size_t i {0uz}; i < 500uz; ++i) {
+		vx::render::Sprite sprite {makeSprite(
+			position(random),
+			position(random),
+			size(random),
+			size(random),
+			static_cast<GLuint> (random() % 3u),
+			static_cast<std::uint32_t> (random()),
+			static_cast<std::uint8_t> (random() % 4u)
+		)};
+		sprite.u0 = coordinate(random);
+		sprite.v0 = coordinate(random);
+		sprite.u1 = coordinate(random);
+		sprite.v1 = coordinate(random);
+		sprite.depth = coordinate(random);
+		sprites.push_back(sprite);
+	}
+
+	vx::render::Image scalarTarget {203u, 157u, 0xff40'4040u};
+	vx::render::Image avx2Target {203u, 157u, 0xff40'4040u};
+	scalar.submit(sprites);
+	avx2.submit(sprites);
+	scalar.build();
+	avx2.build();
+	scalar.draw(scalarTarget);
+	avx2.draw(avx2Target);
+	REQUIRE(std::ranges::equal(scalarTarget.getPixels(), avx2Target.getPixels()));
+	REQUIRE(!std::ranges::all_of(avx2Target.getPixels(), [](const std::uint32_t pixel) {return pixel == 0xff40'4040u;}));
+}
+
+TEST_CASE("software-renderer - threads outside the scheduler", "[render]") {
+	vx::jobs::Scheduler scheduler {{.workerCount = 2uz}};
+	vx::render::SoftwareRenderer renderer {scheduler};
+	constexpr std::size_t THREAD_COUNT {4uz};
+	constexpr std::size_t COUNT {4000uz};
+	{
+		std::vector<std::jthread> threads {};
+		for (std::size_t thread {0uz}; thread < THREAD_COUNT; ++thread) {
+			threads.emplace_back([&renderer, thread]() noexcept {
+				for (std::size_t i {thread}; i < COUNT; i += THREAD_COUNT)
+					renderer.submit(makeSprite(static_cast<float> (i % 64uz), 0.f, 1.f, 1.f, 0u));
+			});
+		}
+	}
+	REQUIRE(renderer.getSubmittedCount() == COUNT);
+	renderer.clear();
+	REQUIRE(renderer.getSubmittedCount() == 0uz);
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/jobs/parallelFor.hpp>
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/render/glStub.hpp>
+#include <voxlet/render/sortKey.hpp>
+#include <voxlet/render/spriteBatcher.hpp>
+
+
+namespace {
+	auto makeSprite(const std::size_t index) noexcept -> vx::render::Sprite {
+		return vx::render::Sprite{
+			.x = static_cast<float> (index),
+			.y = 0.f,
+			.width = 16.f,
+			.height = 16.f,
+			.u0 = 0.f,
+			.v0 = 0.f,
+			.u1 = 1.f,
+			.v1 = 1.f,
+			.color = 0xffff'ffffu,
+			.depth = static_cast<float> (index % 97uz) / 97.f,
+			.program = static_cast<GLuint> (1uz + index % 2uz),
+			.texture = static_cast<GLuint> (10uz + index % 3uz),
+			.layer = static_cast<std::uint8_t> (index % 4uz == 0uz ? 1u : 0u)
+		};
+	}
+}
+
+
+TEST_CASE("radix-sort", "[render]") {
+	const std::size_t count {GENERATE(0uz, 1uz, 1000uz, 100'000uz)};
+	const std::uint64_t mask {GENERATE(0xffuz, 0xffff'0000'0000'ffffuz, ~0uz)};
+	std::mt19937_64 random {42u};
+	std::vector<vx::render::SortEntry> entries {};
+	for (std::size_t i {0uz}; i < count; ++i)
+		entries.push_back(vx::render::SortEntry{random() & mask, i});
+	std::vector<vx::render::SortEntry> expected {entries};
+	std::ranges::stable_sort(expected, {}, &vx::render::SortEntry::key);
+
+	std::vector<vx::render::SortEntry> scratch (count);
+	vx::render::radixSort(entries, scratch);
+	for (std::size_t i {0uz}; i < count; ++i) {
+		REQUIRE(entries[i].key == expected[i].key);
+		REQUIRE(entries[i].value == expected[i].value);
+	}
+}
+
+
+TEST_CASE("sprite-batcher", "[render]") {
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	REQUIRE(GLVersion.major == 4);
+	REQUIRE(GLVersion.minor == 6);
+
+	const std::size_t workerCount {GENERATE(0uz, 3uz)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+	vx::render::SpriteBatcher batcher {scheduler};
+	constexpr std::size_t COUNT {10'000uz};
+
+	vx::jobs::parallelFor(scheduler, 0uz, COUNT, [&batcher](const std::size_t first, const std::size_t last) noexcept {
+		for (std::size_t i {first}; i < last; ++i)
+			batcher.submit(makeSprite(i));
+	});
+	REQUIRE(batcher.getSubmittedCount() == COUNT);
+
+	batcher.build();
+	const auto instances {batcher.getInstances()};
+	const auto batches {batcher.getBatches()};
+	REQUIRE(instances.size() == COUNT);
+	/* layer 1 only holds the first program: 3 textures, then 2 programs with 3 textures on layer 0 */
+	REQUIRE(batches.size() == 9uz);
+
+	std::vector<bool> seen (COUNT, false);
+	std::uint32_t expectedFirst {0u};
+	for (const auto& batch : batches) {
+		REQUIRE(batch.first == expectedFirst);
+		expectedFirst += batch.count;
+		for (std::uint32_t i {batch.first}; i < batch.first + batch.count; ++i) {
+			const auto index {static_cast<std::size_t> (instances[i].rect[0])};
+			const vx::render::Sprite sprite {makeSprite(index)};
+			REQUIRE(sprite.program == batch.program);
+			REQUIRE(sprite.texture == batch.texture);
+			REQUIRE(!seen[index]);
+			seen[index] = true;
+			if (i != batch.first)
+				REQUIRE(instances[i - 1u].depth <= instances[i].depth);
+		}
+	}
+	REQUIRE(expectedFirst == COUNT);
+
+	std::vector<vx::render::SpriteInstance> uploaded {instances.begin(), instances.end()};
+	stub.clearCalls();
+	batcher.draw();
+	REQUIRE(stub.getCallCount("glDrawArraysInstancedBaseInstance") == batches.size());
+	REQUIRE(stub.getCallCount("glBufferData") == 0uz);
+	REQUIRE(stub.getCallCount("glBufferStorage") == 1uz);
+	REQUIRE(stub.getCallCount("glUseProgram") <= batches.size());
+	REQUIRE(stub.getCallCount("glVertexAttribDivisor") == 4uz);
+	const auto findBaseInstance = [&stub]() noexcept -> std::size_t {
+		for (const auto& call : stub.getCalls()) {
+			if (call.name == "glDrawArraysInstancedBaseInstance")
+				return static_cast<std::size_t> (call.arguments[4]);
+		}
+		return 0uz;
+	};
+	const auto data {stub.getBufferData(stub.getBoundBuffer(GL_ARRAY_BUFFER))};
+	const std::size_t offset {findBaseInstance() * sizeof(vx::render::SpriteInstance)};
+	REQUIRE(offset + uploaded.size() * sizeof(vx::render::SpriteInstance) <= data.size());
+	REQUIRE(std::memcmp(data.data() + offset, uploaded.data(), uploaded.size() * sizeof(vx::render::SpriteInstance)) == 0);
+	REQUIRE(batcher.getSubmittedCount() == 0uz);
+
+	/* the GL objects are only created once, the next frame is written to the next region */
+	batcher.submit(makeSprite(0uz));
+	batcher.build();
+	const vx::render::SpriteInstance single {batcher.getInstances()[0]};
+	stub.clearCalls();
+	batcher.draw();
+	REQUIRE(stub.getCallCount("glGenBuffers") == 0uz);
+	REQUIRE(stub.getCallCount("glBufferStorage") == 0uz);
+	REQUIRE(stub.getCallCount("glDrawArraysInstancedBaseInstance") == 1uz);
+	const std::size_t nextOffset {findBaseInstance() * sizeof(vx::render::SpriteInstance)};
+	REQUIRE(nextOffset >= offset + uploaded.size() * sizeof(vx::render::SpriteInstance));
+	REQUIRE(std::memcmp(data.data() + nextOffset, &single, sizeof(single)) == 0);
+}
+
+TEST_CASE("sprite-batcher - threads outside the scheduler", "[render]") {
+	/* they all get the index 0 of the scheduler and share its buffer */
+	vx::jobs::Scheduler scheduler {{.workerCount = 2uz}};
+	vx::render::SpriteBatcher batcher {scheduler};
+	constexpr std::size_t THREAD_COUNT {4uz};
+	constexpr std::size_t COUNT {4000uz};
+	{
+		std::vector<std::jthread> threads {};
+		for (std::size_t thread {0uz}; thread < THREAD_COUNT; ++thread) {
+			threads.emplace_back([&batcher, thread]() noexcept {
+				for (std::size_t i {thread}; i < COUNT; i += THREAD_COUNT)
+					batcher.submit(makeSprite(i));
+			});
+		}
+	}
+	REQUIRE(batcher.getSubmittedCount() == COUNT);
+
+	batcher.build();
+	std::vector<bool> seen (COUNT, false);
+	for (const vx::render::SpriteInstance& instance : batcher.getInstances()) {
+		const auto index {static_cast<std::size_t> (instance.rect[0])};
+		REQUIRE(!seen[index]);
+		seen[index] = true;
+	}
+	REQUIRE(std::ranges::all_of(seen, std::identity{}));
+	batcher.clear();
+}
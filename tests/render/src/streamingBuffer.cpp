@@ -0,0 +1,126 @@
+#include <cstddef>
+#include <cstring>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/render/glStub.hpp>
+#include <voxlet/render/streamingBuffer.hpp>
+
+
+TEST_CASE("streaming-buffer-allocate", "[render]") {
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+
+	auto stream {vx::render::StreamingBuffer::create(vx::render::StreamingBuffer::Config{.frameSize = 1000uz})};
+	REQUIRE(stream);
+	REQUIRE(stream->getBuffer() != 0u);
+	REQUIRE(stub.getBoundBuffer(GL_ARRAY_BUFFER) == stream->getBuffer());
+	REQUIRE(stub.getBufferData(stream->getBuffer()).size() == 3000uz);
+
+	stream->beginFrame();
+	const auto first {stream->allocate(10uz)};
+	REQUIRE(first);
+	REQUIRE(first->offset == 0uz);
+	const auto second {stream->allocate(40uz, 40uz)};
+	REQUIRE(second);
+	REQUIRE(second->offset == 40uz);
+	REQUIRE(second->data == first->data + 40);
+	REQUIRE(stream->getUsedSize() == 80uz);
+	REQUIRE(!stream->allocate(1000uz));
+	const auto last {stream->allocate(920uz)};
+	REQUIRE(last);
+	REQUIRE(!stream->allocate(1uz));
+	stream->endFrame();
+
+	/* the second region starts at 1000, which is no multiple of 40 */
+	stream->beginFrame();
+	REQUIRE(stream->getFrameIndex() == 1uz);
+	REQUIRE(stream->getUsedSize() == 0uz);
+	const auto aligned {stream->allocate(40uz, 40uz)};
+	REQUIRE(aligned);
+	REQUIRE(aligned->offset == 1000uz);
+	const auto next {stream->allocate(1uz, 40uz)};
+	REQUIRE(next);
+	REQUIRE(next->offset == 1040uz);
+
+	std::memset(aligned->data, 0x5a, aligned->size);
+	const auto data {stub.getBufferData(stream->getBuffer())};
+	REQUIRE(data[1000uz] == std::byte{0x5a});
+	REQUIRE(data[1039uz] == std::byte{0x5a});
+	REQUIRE(data[999uz] == std::byte{0x00});
+	stream->endFrame();
+}
+
+TEST_CASE("streaming-buffer-fences", "[render]") {
+	const std::size_t frameCount {GENERATE(1uz, 2uz, 3uz)};
+	const std::size_t latency {GENERATE(0uz, 1uz, 2uz, 5uz)};
+	constexpr std::size_t FRAME_COUNT {32uz};
+
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+	stub.setFenceLatency(latency);
+	{
+		auto stream {vx::render::StreamingBuffer::create(vx::render::StreamingBuffer::Config{
+			.frameSize = 64uz,
+			.frameCount = frameCount
+		})};
+		REQUIRE(stream);
+
+		for (std::size_t frame {0uz}; frame < FRAME_COUNT; ++frame) {
+			stream->beginFrame();
+			REQUIRE(stream->getFrameIndex() == frame % frameCount);
+			const auto allocation {stream->allocate(64uz)};
+			REQUIRE(allocation);
+			REQUIRE(allocation->offset == frame % frameCount * 64uz);
+			stream->endFrame();
+			REQUIRE(stub.getLiveFenceCount() <= frameCount);
+		}
+
+		/* the CPU only waits when the GPU lags by as many frames as there are regions */
+		if (latency < frameCount)
+			REQUIRE(stream->getStallCount() == 0uz);
+		else
+			REQUIRE(stream->getStallCount() == FRAME_COUNT - frameCount);
+		REQUIRE(stream->getStallCount() == stub.getStallCount());
+
+		auto moved {std::move(*stream)};
+		stream.reset();
+		REQUIRE(stub.getLiveFenceCount() == frameCount);
+		REQUIRE(moved.getBuffer() != 0u);
+	}
+	REQUIRE(stub.getLiveFenceCount() == 0uz);
+	REQUIRE(stub.getCallCount("glDeleteBuffers") == 1uz);
+	REQUIRE(stub.getCallCount("glUnmapBuffer") == 1uz);
+}
+
+TEST_CASE("streaming-buffer-move", "[render]") {
+	vx::render::GlStub stub {};
+	REQUIRE(stub.load());
+
+	auto first {vx::render::StreamingBuffer::create(vx::render::StreamingBuffer::Config{.frameSize = 100uz})};
+	auto second {vx::render::StreamingBuffer::create(vx::render::StreamingBuffer::Config{.frameSize = 200uz})};
+	REQUIRE(first);
+	REQUIRE(second);
+	const GLuint firstBuffer {first->getBuffer()};
+	const GLuint secondBuffer {second->getBuffer()};
+	first->beginFrame();
+	first->endFrame();
+	REQUIRE(stub.getLiveFenceCount() == 1uz);
+
+	/* the buffer and the fences of the one assigned to are released */
+	*first = std::move(*second);
+	REQUIRE(first->getBuffer() == secondBuffer);
+	REQUIRE(first->getFrameSize() == 200uz);
+	REQUIRE(second->getBuffer() == 0u);
+	REQUIRE(stub.getBufferData(firstBuffer).empty());
+	REQUIRE(stub.getLiveFenceCount() == 0uz);
+
+	auto& self {*first};
+	*first = std::move(self);
+	REQUIRE(first->getBuffer() == secondBuffer);
+	REQUIRE(stub.getBufferData(secondBuffer).size() == 600uz);
+	first->beginFrame();
+	REQUIRE(first->allocate(10uz));
+	first->endFrame();
+}
@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <voxlet/serial/builder.hpp>
+#include <voxlet/serial/document.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+namespace {
+	enum class Kind : std::uint8_t {
+		crate,
+		torch,
+		door
+	};
+
+	struct Property {
+		std::u8string name {};
+		std::int32_t value {0};
+	};
+
+	struct Object {
+		std::uint32_t id {0u};
+		vx::String name {};
+		Kind kind {Kind::crate};
+		std::array<float, 2> position {};
+		bool isVisible {true};
+		std::vector<Property> properties {};
+	};
+
+	struct Level {
+		std::u8string name {};
+		std::uint16_t width {256u};
+		std::uint16_t height {256u};
+		double gravity {9.81};
+		std::vector<std::uint32_t> tiles {};
+		std::vector<Object> objects {};
+		std::vector<vx::String> tags {};
+		Object player {};
+	};
+
+	/* `Level` as an older build wrote it, then as a newer one will */
+	struct OldLevel {
+		std::u8string name {};
+		std::uint16_t width {256u};
+	};
+
+	struct NewLevel {
+		std::u8string name {};
+		std::uint16_t width {256u};
+		std::uint16_t height {256u};
+		double gravity {9.81};
+		std::vector<std::uint32_t> tiles {};
+		std::vector<Object> objects {};
+		std::vector<vx::String> tags {};
+		Object player {};
+		std::int64_t seed {-1};
+		std::vector<double> weights {};
+	};
+
+	struct Holder {
+		std::vector<vx::String> names {};
+	};
+
+	struct Holders {
+		std::vector<Holder> holders {};
+	};
+
+	struct Node {
+		std::vector<Node> children {};
+		std::int32_t value {0};
+	};
+
+	auto makeLevel() -> Level {
+		Level level {};
+		level.name = u8"caves";
+		level.width = 64u;
+		level.gravity = -0.0;
+		for (std::uint32_t i {0u}; i < 1000u; ++i)
+			level.tiles.push_back(i * 7u % 31u);
+		for (std::uint32_t i {0u}; i < 50u; ++i) {
+			Object object {};
+			object.id = i;
+			object.name = vx::String::from(u8"object with a name long enough to be stored out of line");
+			object.kind = static_cast<Kind> (i % 3u);
+			object.position = {static_cast<float> (i) * 0.5f, -static_cast<float> (i)};
+			object.isVisible = i % 4u != 0u;
+			if (i % 5u == 0u)
+				object.properties.push_back({.name = u8"health", .value = static_cast<std::int32_t> (i)});
+			level.objects.push_back(std::move(object));
+		}
+		level.tags.push_back(vx::String::from(u8"dark"));
+		level.tags.push_back(vx::String::from(u8""));
+		level.tags.push_back(vx::String::from(u8"underground"));
+		level.player.id = 7u;
+		level.player.name = vx::String::from(u8"player");
+		return level;
+	}
+
+	auto toString(const vx::StringSlice& slice) -> std::u8string_view {
+		return {slice.unchecked().begin(), slice.size()};
+	}
+
+	/* the bytes copied to storage aligned like a mapping would be */
+	auto align(const std::vector<std::byte>& bytes) -> std::vector<std::uint64_t> {
+		std::vector<std::uint64_t> aligned ((bytes.size() + 7uz) / 8uz);
+		std::memcpy(aligned.data(), bytes.data(), bytes.size());
+		return aligned;
+	}
+
+	auto asBytes(const std::vector<std::uint64_t>& aligned, const std::size_t size) -> std::span<const std::byte> {
+		return std::as_bytes(std::span{aligned}).first(size);
+	}
+}
+
+
+TEST_CASE("serial - reflection", "[serial]") {
+	STATIC_REQUIRE(vx::serial::FIELD_COUNT<Property> == 2uz);
+	STATIC_REQUIRE(vx::serial::FIELD_COUNT<Object> == 6uz);
+	STATIC_REQUIRE(vx::serial::FIELD_COUNT<Level> == 8uz);
+	STATIC_REQUIRE(vx::serial::FIELD_COUNT<Node> == 2uz);
+	STATIC_REQUIRE(vx::serial::getFieldIndex<&Level::name> () == 0uz);
+	STATIC_REQUIRE(vx::serial::getFieldIndex<&Level::player> () == 7uz);
+	STATIC_REQUIRE(vx::serial::getFieldIndex<&Object::position> () == 3uz);
+	STATIC_REQUIRE(std::same_as<vx::serial::FieldType<Level, 4uz>, std::vector<std::uint32_t>>);
+	STATIC_REQUIRE(vx::serial::Scalar<std::array<float, 2>>);
+	STATIC_REQUIRE(vx::serial::Schema<Object>);
+	STATIC_REQUIRE_FALSE(vx::serial::Schema<std::array<float, 2>>);
+	STATIC_REQUIRE_FALSE(vx::serial::Schema<vx::String>);
+
+	Property property {.name = u8"health", .value = 3};
+	auto fields {vx::serial::getFields(property)};
+	std::get<1> (fields) = 12;
+	REQUIRE(property.value == 12);
+	REQUIRE(std::get<0> (fields) == u8"health");
+}
+
+
+TEST_CASE("serial - write and read in place", "[serial]") {
+	const Level level {makeLevel()};
+	const std::optional<std::vector<std::byte>> bytes {vx::serial::serialize(level)};
+	REQUIRE(bytes);
+	REQUIRE(bytes->size() % 8uz == 0uz);
+	const std::vector<std::uint64_t> aligned {align(*bytes)};
+	const auto document {vx::serial::Document<Level>::fromBytes(asBytes(aligned, bytes->size()))};
+	REQUIRE(document);
+
+	const vx::serial::Table<Level> root {document->getRoot()};
+	REQUIRE(root.isValid());
+	REQUIRE(toString(root.get<&Level::name> ()) == u8"caves");
+	REQUIRE(root.get<&Level::width> () == 64u);
+	REQUIRE(root.get<&Level::height> () == 256u);
+	REQUIRE_FALSE(root.has<&Level::height> ());
+	REQUIRE(root.has<&Level::gravity> ());
+	REQUIRE(std::signbit(root.get<&Level::gravity> ()));
+
+	const std::span<const std::uint32_t> tiles {root.get<&Level::tiles> ()};
+	REQUIRE(std::ranges::equal(tiles, level.tiles));
+	REQUIRE(reinterpret_cast<std::uintptr_t> (tiles.data()) % alignof(std::uint32_t) == 0u);
+
+	const vx::serial::Vector<Object> objects {root.get<&Level::objects> ()};
+	REQUIRE(objects.getSize() == level.objects.size());
+	std::size_t index {0uz};
+	for (const vx::serial::Table<Object> object : objects) {
+		const Object& expected {level.objects[index++]};
+		REQUIRE(object.get<&Object::id> () == expected.id);
+		REQUIRE(std::ranges::equal(object.get<&Object::name> (), expected.name));
+		REQUIRE(object.get<&Object::kind> () == expected.kind);
+		REQUIRE(object.get<&Object::position> () == expected.position);
+		REQUIRE(object.get<&Object::isVisible> () == expected.isVisible);
+		REQUIRE(object.get<&Object::properties> ().getSize() == expected.properties.size());
+	}
+	REQUIRE(objects[5uz].get<&Object::properties> ()[0uz].get<&Property::value> () == 5);
+	REQUIRE(toString(objects[5uz].get<&Object::properties> ()[0uz].get<&Property::name> ()) == u8"health");
+
+	const vx::serial::Vector<vx::String> tags {root.get<&Level::tags> ()};
+	REQUIRE(tags.getSize() == 3uz);
+	REQUIRE(toString(tags[0uz]) == u8"dark");
+	REQUIRE(tags[1uz].isEmpty());
+	REQUIRE(toString(tags[2uz]) == u8"underground");
+	REQUIRE(root.get<&Level::player> ().get<&Object::id> () == 7u);
+
+	const Level unpacked {root.unpack()};
+	REQUIRE(unpacked.name == level.name);
+	REQUIRE(unpacked.width == level.width);
+	REQUIRE(unpacked.tiles == level.tiles);
+	REQUIRE(unpacked.objects.size() == level.objects.size());
+	for (std::size_t i {0uz}; i < level.objects.size(); ++i) {
+		REQUIRE(std::ranges::equal(unpacked.objects[i].name, level.objects[i].name));
+		REQUIRE(unpacked.objects[i].position == level.objects[i].position);
+		REQUIRE(unpacked.objects[i].properties.size() == level.objects[i].properties.size());
+	}
+	REQUIRE(unpacked.tags.size() == 3uz);
+	REQUIRE(std::ranges::equal(unpacked.tags[2uz], level.tags[2uz]));
+	REQUIRE(std::ranges::equal(unpacked.player.name, level.player.name));
+}
+
+
+TEST_CASE("serial - defaults and shared vtables", "[serial]") {
+	const std::optional<std::vector<std::byte>> empty {vx::serial::serialize(Level{})};
+	REQUIRE(empty);
+	const std::vector<std::uint64_t> aligned {align(*empty)};
+	const auto document {vx::serial::Document<Level>::fromBytes(asBytes(aligned, empty->size()))};
+	REQUIRE(document);
+	const vx::serial::Table<Level> root {document->getRoot()};
+	REQUIRE_FALSE(root.has<&Level::gravity> ());
+	REQUIRE(root.get<&Level::gravity> () == 9.81);
+	REQUIRE(root.get<&Level::tiles> ().empty());
+	REQUIRE(root.get<&Level::tags> ().isEmpty());
+	REQUIRE(root.get<&Level::player> ().get<&Object::isVisible> ());
+
+	/* tables of the same shape share a vtable, so each object costs about its own fields */
+	Level small {};
+	Level large {};
+	for (std::uint32_t i {0u}; i < 10u; ++i)
+		small.objects.push_back({.id = i + 1u, .position = {1.f, 2.f}});
+	for (std::uint32_t i {0u}; i < 1010u; ++i)
+		large.objects.push_back({.id = i + 1u, .position = {1.f, 2.f}});
+	const std::size_t smallSize {vx::serial::serialize(small)->size()};
+	const std::size_t largeSize {vx::serial::serialize(large)->size()};
+	REQUIRE(largeSize - smallSize <= 1000uz * (16uz + 2uz * sizeof(std::uint32_t)));
+
+	/* an invalid table reads defaults too */
+	const vx::serial::Table<Object> invalid {};
+	REQUIRE_FALSE(invalid.isValid());
+	REQUIRE(invalid.get<&Object::kind> () == Kind::crate);
+	REQUIRE(invalid.get<&Object::name> ().isEmpty());
+}
+
+
+TEST_CASE("serial - schema evolution", "[serial]") {
+	SECTION("old buffer, new schema") {
+		const OldLevel old {.name = u8"forest", .width = 12u};
+		const std::optional<std::vector<std::byte>> bytes {vx::serial::serialize(old)};
+		REQUIRE(bytes);
+		const std::vector<std::uint64_t> aligned {align(*bytes)};
+		const auto document {vx::serial::Document<NewLevel>::fromBytes(asBytes(aligned, bytes->size()))};
+		REQUIRE(document);
+		const vx::serial::Table<NewLevel> root {document->getRoot()};
+		REQUIRE(toString(root.get<&NewLevel::name> ()) == u8"forest");
+		REQUIRE(root.get<&NewLevel::width> () == 12u);
+		REQUIRE(root.get<&NewLevel::seed> () == -1);
+		REQUIRE(root.get<&NewLevel::weights> ().empty());
+		REQUIRE_FALSE(root.get<&NewLevel::player> ().isValid());
+		REQUIRE(root.unpack().seed == -1);
+	}
+
+	SECTION("new buffer, old schema") {
+		NewLevel level {.name = u8"desert", .width = 99u, .seed = 1234};
+		level.weights = {0.5, 0.25};
+		level.objects.push_back({.id = 3u});
+		const std::optional<std::vector<std::byte>> bytes {vx::serial::serialize(level)};
+		REQUIRE(bytes);
+		const std::vector<std::uint64_t> aligned {align(*bytes)};
+		const auto document {vx::serial::Document<OldLevel>::fromBytes(asBytes(aligned, bytes->size()))};
+		REQUIRE(document);
+		const OldLevel old {document->getRoot().unpack()};
+		REQUIRE(old.name == u8"desert");
+		REQUIRE(old.width == 99u);
+
+		const auto current {vx::serial::Document<NewLevel>::fromBytes(asBytes(aligned, bytes->size()))};
+		REQUIRE(current);
+		REQUIRE(current->getRoot().get<&NewLevel::seed> () == 1234);
+		REQUIRE(std::ranges::equal(current->getRoot().get<&NewLevel::weights> (), level.weights));
+	}
+}
+
+
+TEST_CASE("serial - recursive schema and file", "[serial]") {
+	Node root {.value = 1};
+	Node* node {&root};
+	for (std::int32_t depth {2}; depth < 40; ++depth) {
+		node->children.push_back({.value = depth});
+		node->children.push_back({.value = -depth});
+		node = &node->children.front();
+	}
+	const std::optional<std::vector<std::byte>> bytes {vx::serial::serialize(root)};
+	REQUIRE(bytes);
+
+	const auto path {std::filesystem::temp_directory_path() / "voxlet-serial-test.bin"};
+	std::ofstream {path, std::ios::binary | std::ios::trunc}.write(reinterpret_cast<const char*> (bytes->data()), static_cast<std::streamsize> (bytes->size()));
+	const std::string pathString {path.string()};
+	{
+		const auto document {vx::serial::Document<Node>::open(
+			vx::testing::toSlice(pathString)
+		)};
+		REQUIRE(document);
+		vx::serial::Table<Node> table {document->getRoot()};
+		std::int32_t depth {1};
+		while (!table.get<&Node::children> ().isEmpty()) {
+			REQUIRE(table.get<&Node::value> () == depth);
+			REQUIRE(table.get<&Node::children> ()[1uz].get<&Node::value> () == -(depth + 1));
+			table = table.get<&Node::children> ()[0uz];
+			++depth;
+		}
+		REQUIRE(depth == 39);
+	}
+	std::filesystem::remove(path);
+
+	/* deeper than a buffer is allowed to nest */
+	Node deep {};
+	node = &deep;
+	for (std::size_t depth {0uz}; depth < 100uz; ++depth) {
+		node->children.push_back({.value = 1});
+		node = &node->children.front();
+	}
+	const std::optional<std::vector<std::byte>> deepBytes {vx::serial::serialize(deep)};
+	const std::vector<std::uint64_t> aligned {align(*deepBytes)};
+	REQUIRE_FALSE(vx::serial::Document<Node>::fromBytes(asBytes(aligned, deepBytes->size())));
+}
+
+
+TEST_CASE("serial - malformed buffers", "[serial]") {
+	const std::optional<std::vector<std::byte>> bytes {vx::serial::serialize(makeLevel())};
+	REQUIRE(bytes);
+	std::vector<std::uint64_t> aligned {align(*bytes)};
+	const std::span<const std::byte> view {asBytes(aligned, bytes->size())};
+
+	REQUIRE_FALSE(vx::serial::Document<Level>::fromBytes(view.first(view.size() - 8uz)));
+	REQUIRE_FALSE(vx::serial::Document<Level>::fromBytes(view.subspan(8uz)));
+	REQUIRE_FALSE(vx::serial::Document<Level>::fromBytes({}));
+
+	/* any byte changed either turns the buffer down, or reads within it */
+	std::mt19937 random {5u};
+	auto* const data {reinterpret_cast<std::byte*> (aligned.data())};
+	for (std::size_t i {0uz}; i < 4000uz; ++i) {
+		const std::size_t position {random() % bytes->size()};
+		const std::byte previous {data[position]};
+		data[position] = static_cast<std::byte> (random());
+		const auto document {vx::serial::Document<Level>::fromBytes(view)};
+		if (document)
+			(void)document->getRoot().unpack();
+		data[position] = previous;
+	}
+	REQUIRE(vx::serial::Document<Level>::fromBytes(view));
+}
+
+
+TEST_CASE("serial - shared vectors", "[serial]") {
+	/* every holder is made to refer to the names of the last one, each checked once per holder */
+	constexpr std::size_t COUNT {4000uz};
+	Holders value {};
+	value.holders.resize(COUNT);
+	for (std::size_t i {0uz}; i < COUNT; ++i)
+		value.holders.back().names.push_back(vx::String::from(u8"name"));
+	for (std::size_t i {0uz}; i + 1uz < COUNT; ++i)
+		value.holders[i].names.push_back(vx::String::from(u8"x"));
+	const std::optional<std::vector<std::byte>> bytes {vx::serial::serialize(value)};
+	REQUIRE(bytes);
+	std::vector<std::uint64_t> aligned {align(*bytes)};
+	const std::span<const std::byte> view {asBytes(aligned, bytes->size())};
+	REQUIRE(vx::serial::Document<Holders>::fromBytes(view));
+
+	namespace internal = vx::serial::internal;
+	auto* const data {reinterpret_cast<std::byte*> (aligned.data())};
+	const vx::serial::SerialHeader header {internal::load<vx::serial::SerialHeader> (data)};
+	const std::byte* const holders {internal::follow(internal::findField(data + header.root, 0uz))};
+	const auto getNames = [&] (const std::size_t index) {
+		return internal::findField(internal::follow(holders + internal::REFERENCE_SIZE * (index + 1uz)), 0uz);
+	};
+	const std::byte* const shared {internal::follow(getNames(COUNT - 1uz))};
+	for (std::size_t i {0uz}; i + 1uz < COUNT; ++i) {
+		std::byte* const reference {data + (getNames(i) - data)};
+		const auto offset {static_cast<std::uint32_t> (shared - reference)};
+		std::memcpy(reference, &offset, sizeof(offset));
+	}
+	REQUIRE_FALSE(vx::serial::Document<Holders>::fromBytes(view));
+}
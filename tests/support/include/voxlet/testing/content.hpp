@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/* bytes for the compressors to round trip, seeded with their size for a failure to be reproduced */
+namespace vx::testing {
+	enum class Content {
+		zeros,
+		text,
+		/* short offsets, down to runs of one byte */
+		pattern,
+		random,
+		/* runs of 1000 random bytes and 1000 same bytes in turn */
+		mixed,
+		/* few common bytes and many rare ones, so that some codes are longer than the lookup tables */
+		skewed
+	};
+
+	inline auto makeContent(const Content content, const std::size_t size) -> std::vector<std::byte> {
+		std::vector<std::byte> bytes (size);
+		std::mt19937 random {static_cast<std::uint32_t> (size)};
+		std::geometric_distribution<std::uint32_t> skew {0.3};
+		const std::string words[] {"voxel ", "sprite ", "chunk ", "the ", "tile ", "render ", "asset "};
+		std::size_t position {0uz};
+		for (std::size_t i {0uz}; i < size; ++i) {
+			switch (content) {
+				case Content::zeros:
+					break;
+				case Content::text:
+					if (position == 0uz)
+						position = random() % std::size(words) * 16uz + 1uz;
+					bytes[i] = static_cast<std::byte> (words[position / 16uz][position % 16uz - 1uz]);
+					position = position % 16uz == words[position / 16uz].size() ? 0uz : position + 1uz;
+					break;
+				case Content::pattern:
+					bytes[i] = static_cast<std::byte> (i % (1uz + i / 4096uz % 7uz));
+					break;
+				case Content::random:
+					bytes[i] = static_cast<std::byte> (random());
+					break;
+				case Content::mixed:
+					bytes[i] = (i / 1000uz) % 2uz == 0uz ? static_cast<std::byte> (random()) : static_cast<std::byte> (i / 1000uz);
+					break;
+				case Content::skewed:
+					bytes[i] = static_cast<std::byte> (skew(random) * 7u);
+					break;
+			}
+		}
+		return bytes;
+	}
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <voxlet/assets/atlasBuilder.hpp>
+#include <voxlet/compression/deflate.hpp>
+#include <voxlet/image/png.hpp>
+#include <voxlet/render/image.hpp>
+#include <voxlet/testing/strings.hpp>
+
+
+/* PNG files for the tests and benchmarks to decode, the engine has no encoder to write them */
+namespace vx::testing {
+	/* bit by bit, for the files not to depend on the CRC the decoder checks them with */
+	inline auto crc32(const std::span<const std::uint8_t> bytes) -> std::uint32_t {
+		std::uint32_t crc {0xffff'ffffu};
+		for (const std::uint8_t byte : bytes) {
+			crc ^= byte;
+			for (std::uint32_t bit {0u}; bit < 8u; ++bit)
+				crc = (crc >> 1u) ^ (0xedb8'8320u & (0u - (crc & 1u)));
+		}
+		return ~crc;
+	}
+
+	inline auto getPaethPredictor(const std::int32_t left, const std::int32_t up, const std::int32_t upperLeft) -> std::int32_t {
+		const std::int32_t prediction {left + up - upperLeft};
+		const std::int32_t leftDistance {std::abs(prediction - left)};
+		const std::int32_t upDistance {std::abs(prediction - up)};
+		const std::int32_t upperLeftDistance {std::abs(prediction - upperLeft)};
+		if (leftDistance <= upDistance && leftDistance <= upperLeftDistance)
+			return left;
+		return upDistance <= upperLeftDistance ? up : upperLeft;
+	}
+
+	inline auto appendPngChunk(std::vector<std::byte>& file, const char (&type)[5], const std::span<const std::uint8_t> data)
+		-> void
+	{
+		std::vector<std::uint8_t> chunk {};
+		const auto append32 {[](std::vector<std::uint8_t>& bytes, const std::uint32_t value) {
+			for (std::uint32_t shift {24u}; shift <= 24u; shift -= 8u)
+				bytes.push_back(static_cast<std::uint8_t> (value >> shift));
+		}};
+		append32(chunk, static_cast<std::uint32_t> (data.size()));
+		chunk.insert(chunk.end(), type, type + 4);
+		chunk.insert(chunk.end(), data.begin(), data.end());
+		append32(chunk, crc32(std::span{chunk}.subspan(4uz)));
+		for (const std::uint8_t byte : chunk)
+			file.push_back(static_cast<std::byte> (byte));
+	}
+
+	/* the signature and the `IHDR` chunk */
+	inline auto beginPng(const vx::image::PngInfo& info) -> std::vector<std::byte> {
+		std::vector<std::byte> file {};
+		for (const std::uint32_t byte : {137u, 80u, 78u, 71u, 13u, 10u, 26u, 10u})
+			file.push_back(static_cast<std::byte> (byte));
+		const std::uint8_t header[] {
+			static_cast<std::uint8_t> (info.width >> 24u), static_cast<std::uint8_t> (info.width >> 16u),
+			static_cast<std::uint8_t> (info.width >> 8u), static_cast<std::uint8_t> (info.width),
+			static_cast<std::uint8_t> (info.height >> 24u), static_cast<std::uint8_t> (info.height >> 16u),
+			static_cast<std::uint8_t> (info.height >> 8u), static_cast<std::uint8_t> (info.height),
+			info.bitDepth, static_cast<std::uint8_t> (info.colorType), 0u, 0u, 0u
+		};
+		appendPngChunk(file, "IHDR", header);
+		return file;
+	}
+
+	/*
+	 * Rows of `rowSize` bytes, each filtered with `filters[y % filters.size()]` and `stride` the bytes of a
+	 * pixel rounded up to one. An invalid filter is written as `None`.
+	 */
+	inline auto filterRows(
+		const std::span<const std::uint8_t> rows,
+		const std::size_t rowSize,
+		const std::size_t stride,
+		const std::span<const std::uint8_t> filters
+	) -> std::vector<std::uint8_t> {
+		std::vector<std::uint8_t> filtered {};
+		filtered.reserve(rows.size() + rows.size() / rowSize);
+		for (std::size_t y {0uz}; y < rows.size() / rowSize; ++y) {
+			const std::uint8_t filter {filters[y % filters.size()]};
+			filtered.push_back(filter);
+			for (std::size_t i {0uz}; i < rowSize; ++i) {
+				const std::int32_t left {i >= stride ? rows[y * rowSize + i - stride] : 0};
+				const std::int32_t up {y > 0uz ? rows[(y - 1uz) * rowSize + i] : 0};
+				const std::int32_t upperLeft {y > 0uz && i >= stride ? rows[(y - 1uz) * rowSize + i - stride] : 0};
+				const std::int32_t predictors[] {0, left, up, (left + up) / 2, getPaethPredictor(left, up, upperLeft), 0};
+				filtered.push_back(static_cast<std::uint8_t> (rows[y * rowSize + i] - predictors[std::min(filter, std::uint8_t{5u})]));
+			}
+		}
+		return filtered;
+	}
+
+	/* the filtered rows, their zlib stream split over `dataChunkCount` `IDAT` chunks, then `IEND` */
+	inline auto endPng(std::vector<std::byte>& file, const std::span<const std::uint8_t> filtered, const std::size_t dataChunkCount = 1uz)
+		-> void
+	{
+		const std::vector<std::byte> stream {vx::compression::deflate(std::as_bytes(filtered), vx::compression::DeflateFormat::zlib)};
+		const std::span<const std::uint8_t> data {reinterpret_cast<const std::uint8_t*> (stream.data()), stream.size()};
+		const std::size_t chunkSize {data.size() / dataChunkCount + 1uz};
+		for (std::size_t offset {0uz}; offset < data.size(); offset += chunkSize)
+			appendPngChunk(file, "IDAT", data.subspan(offset, std::min(chunkSize, data.size() - offset)));
+		appendPngChunk(file, "IEND", {});
+	}
+
+	/* an RGBA8 PNG of the image, its rows filtered as `filterRows` does */
+	inline auto encodePng(const vx::render::Image& image, const std::span<const std::uint8_t> filters) -> std::vector<std::byte> {
+		std::vector<std::byte> file {beginPng({
+			.width = image.getWidth(),
+			.height = image.getHeight(),
+			.colorType = vx::image::PngColorType::rgba,
+			.bitDepth = 8u
+		})};
+		const auto pixels {image.getPixels()};
+		const std::span<const std::uint8_t> rows {reinterpret_cast<const std::uint8_t*> (pixels.data()), pixels.size_bytes()};
+		endPng(file, filterRows(rows, image.getWidth() * 4uz, 4uz, filters));
+		return file;
+	}
+
+	/* a 2048x2048 atlas page of shaded sprites, the engine has no sprite sheets of its own to read */
+	inline auto makeSpriteSheet() -> vx::render::Image {
+		vx::assets::AtlasBuilder builder {};
+		std::mt19937 random {42u};
+		std::uniform_int_distribution<std::uint32_t> side {8u, 48u};
+		for (std::size_t i {0uz}; builder.getPages().size() < 2uz; ++i) {
+			const std::uint32_t width {side(random)};
+			const std::uint32_t height {side(random)};
+			vx::render::Image sprite {width, height, 0u};
+			const std::uint32_t color {static_cast<std::uint32_t> (random()) & 0x007f'7f7fu};
+			for (std::uint32_t y {1u}; y + 1u < height; ++y) {
+				for (std::uint32_t x {1u}; x + 1u < width; ++x) {
+					const bool isOutline {x == 1u || y == 1u || x + 2u == width || y + 2u == height};
+					const std::uint32_t shade {(y * 2u + static_cast<std::uint32_t> (random() % 4u)) * 0x0001'0101u};
+					sprite.getRow(y)[x] = isOutline ? 0xff00'0000u : (color + shade) | 0xff00'0000u;
+				}
+			}
+			const std::string name {"sprite_" + std::to_string(i)};
+			(void)builder.set(vx::testing::toSlice(name), sprite);
+		}
+		vx::render::Image page {builder.getPages()[0].getWidth(), builder.getPages()[0].getHeight()};
+		std::ranges::copy(builder.getPages()[0].getPixels(), page.getPixels().begin());
+		return page;
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+#include <voxlet/containers/views/stringSlice.hpp>
+
+
+namespace vx::testing {
+	inline auto toSlice(const std::string& string) noexcept -> vx::StringSlice {
+		return vx::StringSlice::from(reinterpret_cast<const char8_t*> (string.data()), string.size());
+	}
+}
@@ -0,0 +1,159 @@
+#include <array>
+#include <map>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+
+#include <voxlet/jobs/scheduler.hpp>
+#include <voxlet/world/tilemap.hpp>
+
+
+TEST_CASE("tilemap - morton order", "[world]") {
+	std::set<std::uint32_t> indices {};
+	for (std::uint32_t y {0u}; y < vx::world::CHUNK_SIZE; ++y) {
+		for (std::uint32_t x {0u}; x < vx::world::CHUNK_SIZE; ++x)
+			indices.insert(vx::world::mortonEncode(x, y));
+	}
+	REQUIRE(indices.size() == vx::world::CHUNK_AREA);
+	REQUIRE(*indices.rbegin() == vx::world::CHUNK_AREA - 1u);
+	/* each 2x2 block is contiguous */
+	REQUIRE(vx::world::mortonEncode(0u, 0u) == 0u);
+	REQUIRE(vx::world::mortonEncode(1u, 0u) == 1u);
+	REQUIRE(vx::world::mortonEncode(0u, 1u) == 2u);
+	REQUIRE(vx::world::mortonEncode(1u, 1u) == 3u);
+	REQUIRE(vx::world::mortonEncode(2u, 0u) == 4u);
+	REQUIRE(vx::world::mortonEncode(5u, 3u) == 0b011011u);
+}
+
+
+TEST_CASE("tilemap - edits", "[world]") {
+	vx::world::Tilemap tilemap {{.tileSize = 8.f, .tilesetColumns = 4u, .tilesetRows = 4u, .depth = 0.5f}};
+	std::map<std::pair<std::int32_t, std::int32_t>, vx::world::TileId> expected {};
+	std::mt19937 random {42u};
+	std::uniform_int_distribution<std::int32_t> coordinate {-70, 70};
+	for (std::size_t i {0uz}; i < 5000uz; ++i) {
+		const std::int32_t x {coordinate(random)};
+		const std::int32_t y {coordinate(random)};
+		const auto tile {static_cast<vx::world::TileId> (random() % 17u)};
+		tilemap.setTile(x, y, tile);
+		expected[{x, y}] = tile;
+	}
+	for (const auto& [position, tile] : expected)
+		REQUIRE(tilemap.getTile(position.first, position.second) == tile);
+	REQUIRE(tilemap.getTile(1000, -1000) == 0u);
+	/* -70 and 70 fall in chunks -3 and 2 */
+	REQUIRE(tilemap.getChunks().size() == 36uz);
+	REQUIRE(tilemap.getChunk(vx::world::ChunkCoord{-3, 2}) != nullptr);
+	REQUIRE(tilemap.getChunk(vx::world::ChunkCoord{3, 0}) == nullptr);
+
+	std::size_t visited {0uz};
+	tilemap.forEachTile(vx::world::TileRect{-5, -7, 40u, 9u}, [&](const std::int32_t x, const std::int32_t y, const vx::world::TileId tile) noexcept {
+		++visited;
+		const auto it {expected.find({x, y})};
+		REQUIRE(tile == (it == expected.end() ? 0u : it->second));
+	});
+	REQUIRE(visited == 40uz * 9uz);
+
+	REQUIRE(tilemap.getDirtyCount() == 36uz);
+	REQUIRE(tilemap.rebuildMeshes() == 36uz);
+	REQUIRE(tilemap.getDirtyCount() == 0uz);
+	std::size_t instanceCount {0uz};
+	for (const vx::world::Chunk& chunk : tilemap.getChunks()) {
+		REQUIRE(!chunk.dirty);
+		instanceCount += chunk.mesh.size();
+		for (const auto& instance : chunk.mesh) {
+			const auto x {static_cast<std::int32_t> (instance.rect[0] / 8.f)};
+			const auto y {static_cast<std::int32_t> (instance.rect[1] / 8.f)};
+			const vx::world::TileId tile {tilemap.getTile(x, y)};
+			REQUIRE(tile != 0u);
+			REQUIRE(vx::world::Tilemap::getChunkCoord(x, y) == chunk.coord);
+			REQUIRE(instance.rect[2] == 8.f);
+			REQUIRE(instance.uv[0] == static_cast<float> ((tile - 1u) % 4u) * 0.25f);
+			REQUIRE(instance.uv[1] == static_cast<float> ((tile - 1u) / 4u) * 0.25f);
+			REQUIRE(instance.uv[2] == instance.uv[0] + 0.25f);
+			REQUIRE(instance.depth == 0.5f);
+		}
+	}
+	REQUIRE(instanceCount == static_cast<std::size_t> (std::ranges::count_if(expected, [](const auto& entry) {
+		return entry.second != 0u;
+	})));
+
+	/* only the edited chunk is rebuilt, and writing the same tile doesn't dirty it */
+	tilemap.setTile(-70, 70, expected[{-70, 70}]);
+	REQUIRE(tilemap.getDirtyCount() == 0uz);
+	tilemap.setTile(-70, 70, 16u);
+	tilemap.setTile(-69, 70, 16u);
+	REQUIRE(tilemap.getDirtyCount() == 1uz);
+	REQUIRE(tilemap.getChunk(vx::world::ChunkCoord{-3, 2})->dirty);
+	REQUIRE(tilemap.rebuildMeshes() == 1uz);
+
+	/* evicting a dirty chunk drops it from the rebuild list */
+	tilemap.setTile(0, 0, 3u);
+	REQUIRE(tilemap.evictChunk(vx::world::ChunkCoord{0, 0}));
+	REQUIRE(!tilemap.evictChunk(vx::world::ChunkCoord{0, 0}));
+	REQUIRE(tilemap.getDirtyCount() == 0uz);
+	REQUIRE(tilemap.getTile(0, 0) == 0u);
+	REQUIRE(tilemap.getChunks().size() == 35uz);
+}
+
+
+TEST_CASE("tilemap - streaming", "[world]") {
+	const std::size_t workerCount {GENERATE(0uz, 3uz)};
+	vx::jobs::Scheduler scheduler {{.workerCount = workerCount}};
+	vx::world::Tilemap tilemap {{.loadMargin = 1u, .evictMargin = 2u}};
+
+	/* the world is generated from the coordinates, and saved tiles win over generated ones */
+	std::map<std::tuple<std::int32_t, std::int32_t>, std::array<vx::world::TileId, vx::world::CHUNK_AREA>> saved {};
+	const auto load {[&saved](const vx::world::ChunkCoord coord, const std::span<vx::world::TileId, vx::world::CHUNK_AREA> tiles) noexcept {
+		const auto it {saved.find({coord.x, coord.y})};
+		for (std::uint32_t i {0u}; i < vx::world::CHUNK_AREA; ++i) {
+			tiles[i] = it != saved.end()
+				? it->second[i]
+				: static_cast<vx::world::TileId> ((static_cast<std::uint32_t> (coord.x * 7 + coord.y * 13) + i) % 5u);
+		}
+	}};
+	std::size_t evictedCount {0uz};
+	const auto evict {[&](const vx::world::ChunkCoord coord, const std::span<const vx::world::TileId, vx::world::CHUNK_AREA> tiles) noexcept {
+		++evictedCount;
+		std::ranges::copy(tiles, saved[{coord.x, coord.y}].begin());
+	}};
+
+	/* a 2x2 chunk view at the origin loads a 4x4 square */
+	const vx::world::StreamStats first {tilemap.stream(vx::world::TileRect{0, 0, 64u, 64u}, load, evict)};
+	REQUIRE(first.loadedCount == 16uz);
+	REQUIRE(first.evictedCount == 0uz);
+	REQUIRE(tilemap.getTile(33, 2) == static_cast<vx::world::TileId> ((7u + 2u * 32u + 1u) % 5u));
+	REQUIRE(tilemap.getTile(-1, -1) == static_cast<vx::world::TileId> ((static_cast<std::uint32_t> (-7 - 13) + vx::world::CHUNK_AREA - 1u) % 5u));
+	REQUIRE(tilemap.rebuildMeshes(scheduler) == 16uz);
+
+	/* nothing happens while the view stays put */
+	const vx::world::StreamStats still {tilemap.stream(vx::world::TileRect{0, 0, 64u, 64u}, load, evict)};
+	REQUIRE(still.loadedCount == 0uz);
+	REQUIRE(still.evictedCount == 0uz);
+
+	/* an edit survives the round trip through eviction */
+	tilemap.setTile(-20, 5, 4u);
+	const vx::world::StreamStats right {tilemap.stream(vx::world::TileRect{128, 0, 64u, 64u}, load, evict)};
+	/* the view now covers chunks 4 and 5: 3 to 6 are loaded and 2 stays within the eviction margin */
+	REQUIRE(right.loadedCount == 16uz);
+	REQUIRE(right.evictedCount == 12uz);
+	REQUIRE(evictedCount == 12uz);
+	REQUIRE(tilemap.getChunks().size() == 20uz);
+	REQUIRE(tilemap.getChunk(vx::world::ChunkCoord{-1, 0}) == nullptr);
+	REQUIRE(tilemap.getChunk(vx::world::ChunkCoord{2, 0}) != nullptr);
+	REQUIRE(tilemap.getDirtyCount() == 16uz);
+
+	/* back at the origin, chunk 3 is still loaded and dirty while the dirty chunks 4 to 6 were evicted */
+	const vx::world::StreamStats back {tilemap.stream(vx::world::TileRect{0, 0, 64u, 64u}, load, evict)};
+	REQUIRE(back.loadedCount == 12uz);
+	REQUIRE(back.evictedCount == 12uz);
+	REQUIRE(tilemap.getTile(-20, 5) == 4u);
+	REQUIRE(tilemap.rebuildMeshes(scheduler) == 16uz);
+	REQUIRE(tilemap.getDirtyCount() == 0uz);
+	for (const vx::world::Chunk& chunk : tilemap.getChunks())
+		REQUIRE(!chunk.dirty);
+}
@@ -0,0 +1,136 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <print>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <voxlet/assets/atlas.hpp>
+#include <voxlet/assets/atlasBuilder.hpp>
+#include <voxlet/io/mappedFile.hpp>
+#include <voxlet/render/image.hpp>
+
+
+/*
+ * voxlet-atlas <output> <image.pam>...
+ * Packs the images into the atlas `output`, each named after its file name without extension. When
+ * `output` already exists its packing is reused: only new, changed and removed sprites are touched.
+ * Images are binary PAM files (P7) with an RGB_ALPHA tuple type and a MAXVAL of 255.
+ */
+namespace {
+	auto toSlice(const std::string_view string) noexcept -> vx::StringSlice {
+		return vx::StringSlice::from(reinterpret_cast<const char8_t*> (string.data()), string.size());
+	}
+
+	auto getSpriteName(const std::string_view path) noexcept -> std::string_view {
+		std::string_view name {path.substr(path.find_last_of('/') + 1uz)};
+		return name.substr(0uz, name.find_last_of('.'));
+	}
+
+	auto loadPam(const std::string_view path) noexcept -> std::optional<vx::render::Image> {
+		const std::optional<vx::io::MappedFile> file {vx::io::MappedFile::open(toSlice(path))};
+		if (!file)
+			return std::nullopt;
+		const std::string_view text {reinterpret_cast<const char*> (file->getData()), file->getSize()};
+		const std::size_t headerEnd {text.find("ENDHDR\n")};
+		if (!text.starts_with("P7\n") || headerEnd == std::string_view::npos)
+			return std::nullopt;
+
+		std::uint32_t width {0u};
+		std::uint32_t height {0u};
+		std::uint32_t depth {0u};
+		std::uint32_t maxValue {0u};
+		std::string_view header {text.substr(3uz, headerEnd - 3uz)};
+		while (!header.empty()) {
+			const std::size_t lineEnd {header.find('\n')};
+			const std::string_view line {header.substr(0uz, lineEnd)};
+			header.remove_prefix(lineEnd == std::string_view::npos ? header.size() : lineEnd + 1uz);
+			const auto readValue {[line](const std::string_view key, std::uint32_t& value) noexcept {
+				if (line.starts_with(key))
+					value = static_cast<std::uint32_t> (std::strtoul(line.data() + key.size(), nullptr, 10));
+			}};
+			readValue("WIDTH ", width);
+			readValue("HEIGHT ", height);
+			readValue("DEPTH ", depth);
+			readValue("MAXVAL ", maxValue);
+		}
+		const std::size_t pixelsOffset {headerEnd + 7uz};
+		const std::size_t size {static_cast<std::size_t> (width) * height * 4uz};
+		if (depth != 4u || maxValue != 255u || text.size() - pixelsOffset < size)
+			return std::nullopt;
+
+		/* RGBA bytes are the pixels, red in the lowest byte */
+		vx::render::Image image {width, height};
+		std::memcpy(image.getPixels().data(), file->getData() + pixelsOffset, size);
+		return image;
+	}
+
+	auto writeFile(const std::string_view path, const std::vector<std::byte>& bytes) noexcept -> bool {
+		const std::string nullTerminatedPath {path};
+		std::FILE* const file {std::fopen(nullTerminatedPath.c_str(), "wb")};
+		if (file == nullptr)
+			return false;
+		const bool written {std::fwrite(bytes.data(), 1uz, bytes.size(), file) == bytes.size()};
+		return std::fclose(file) == 0 && written;
+	}
+}
+
+
+auto main(int argc, char **argv) -> int {
+	if (argc < 2) {
+		std::println(stderr, "usage: {} <output> <image.pam>...", argv[0]);
+		return EXIT_FAILURE;
+	}
+	const std::string_view output {argv[1]};
+
+	std::optional<vx::assets::Atlas> previous {vx::assets::Atlas::open(toSlice(output))};
+	std::optional<vx::assets::AtlasBuilder> builder {};
+	if (previous)
+		builder = vx::assets::AtlasBuilder::restore(*previous, {});
+	if (!builder) {
+		previous.reset();
+		builder.emplace();
+	}
+
+	std::set<std::string_view> names {};
+	for (int i {2}; i < argc; ++i) {
+		const std::string_view path {argv[i]};
+		const std::optional<vx::render::Image> image {loadPam(path)};
+		if (!image) {
+			std::println(stderr, "can't read '{}' as an RGBA PAM image", path);
+			return EXIT_FAILURE;
+		}
+		const std::string_view name {getSpriteName(path)};
+		if (!names.insert(name).second) {
+			std::println(stderr, "two images are named '{}'", name);
+			return EXIT_FAILURE;
+		}
+		if (!builder->set(toSlice(name), *image)) {
+			std::println(stderr, "'{}' doesn't fit in an atlas page", path);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* the previous atlas may hold sprites whose image was removed */
+	if (previous) {
+		for (const vx::assets::AtlasEntry& entry : previous->getEntries()) {
+			const vx::StringSlice name {previous->getName(entry)};
+			if (!names.contains(std::string_view{reinterpret_cast<const char*> (std::to_address(name.begin())), name.getSize()}))
+				(void)builder->remove(name);
+		}
+		previous.reset();
+	}
+
+	std::size_t dirtyCount {0uz};
+	for (std::uint32_t page {0u}; page < builder->getPages().size(); ++page)
+		dirtyCount += builder->isPageDirty(page) ? 1uz : 0uz;
+	if (!writeFile(output, builder->write())) {
+		std::println(stderr, "can't write '{}'", output);
+		return EXIT_FAILURE;
+	}
+	std::println("{} sprites in {} pages, {} pages changed", builder->getSpriteCount(), builder->getPages().size(), dirtyCount);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <voxlet/assets/packBuilder.hpp>
+#include <voxlet/io/mappedFile.hpp>
+
+
+/*
+ * voxlet-pack [--compress] <output> <directory>
+ * Packs every regular file under `directory` into the pack `output`, each one found by its path relative
+ * to `directory` with `/` separators. With `--compress`, files are stored LZ compressed when it makes
+ * them smaller.
+ */
+namespace {
+	auto toSlice(const std::string& string) noexcept -> vx::StringSlice {
+		return vx::StringSlice::from(reinterpret_cast<const char8_t*> (string.data()), string.size());
+	}
+
+	auto writeFile(const std::string& path, const std::vector<std::byte>& bytes) noexcept -> bool {
+		std::FILE* const file {std::fopen(path.c_str(), "wb")};
+		if (file == nullptr)
+			return false;
+		const bool written {std::fwrite(bytes.data(), 1uz, bytes.size(), file) == bytes.size()};
+		return std::fclose(file) == 0 && written;
+	}
+}
+
+
+auto main(int argc, char **argv) -> int {
+	const bool compress {argc == 4 && std::string_view{argv[1]} == "--compress"};
+	if (argc != (compress ? 4 : 3)) {
+		std::println(stderr, "usage: {} [--compress] <output> <directory>", argv[0]);
+		return EXIT_FAILURE;
+	}
+	const std::string output {argv[compress ? 2 : 1]};
+	const std::filesystem::path root {argv[compress ? 3 : 2]};
+	const vx::assets::PackCompression compression {compress ? vx::assets::PackCompression::lz : vx::assets::PackCompression::none};
+
+	std::error_code error {};
+	std::vector<std::filesystem::path> files {};
+	auto it {std::filesystem::recursive_directory_iterator{root, error}};
+	for (; !error && it != std::filesystem::end(it); it.increment(error)) {
+		if (it->is_regular_file())
+			files.push_back(it->path());
+	}
+	if (error) {
+		std::println(stderr, "can't list '{}': {}", root.string(), error.message());
+		return EXIT_FAILURE;
+	}
+	std::ranges::sort(files);
+
+	vx::assets::PackBuilder builder {};
+	std::size_t size {0uz};
+	for (const std::filesystem::path& file : files) {
+		const std::string path {file.string()};
+		const std::string name {file.lexically_relative(root).generic_string()};
+		const std::optional<vx::io::MappedFile> content {vx::io::MappedFile::open(toSlice(path))};
+		if (!content) {
+			std::println(stderr, "can't read '{}'", path);
+			return EXIT_FAILURE;
+		}
+		if (!builder.add(toSlice(name), content->getBytes(), compression)) {
+			std::println(stderr, "'{}' collides with another path", name);
+			return EXIT_FAILURE;
+		}
+		size += content->getSize();
+	}
+
+	const std::vector<std::byte> bytes {builder.write()};
+	if (!writeFile(output, bytes)) {
+		std::println(stderr, "can't write '{}'", output);
+		return EXIT_FAILURE;
+	}
+	std::println("{} files, {} bytes packed in {} bytes", builder.getBlobCount(), size, bytes.size());
+	return EXIT_SUCCESS;
+}